@@ -22,14 +22,19 @@
 
 list (APPEND MAIN_SOURCE_FILES
       src/opm/common/data/SimulationDataContainer.cpp
+      src/opm/common/OpmLog/AsyncLog.cpp
       src/opm/common/OpmLog/CounterLog.cpp
       src/opm/common/OpmLog/EclipsePRTLog.cpp
       src/opm/common/OpmLog/LogBackend.cpp
       src/opm/common/OpmLog/Logger.cpp
       src/opm/common/OpmLog/LogUtil.cpp
+      src/opm/common/OpmLog/MemoryUsage.cpp
+      src/opm/common/OpmLog/Metrics.cpp
       src/opm/common/OpmLog/OpmLog.cpp
+      src/opm/common/OpmLog/PhaseTimer.cpp
       src/opm/common/OpmLog/StreamLog.cpp
       src/opm/common/OpmLog/TimerLog.cpp
+      src/opm/common/utility/FirstTouch.cpp
       src/opm/common/utility/numeric/MonotCubicInterpolator.cpp
       src/opm/common/utility/parameters/Parameter.cpp
       src/opm/common/utility/parameters/ParameterGroup.cpp
@@ -40,6 +45,7 @@ if(ENABLE_ECL_INPUT)
   list(APPEND MAIN_SOURCE_FILES
     src/opm/json/JsonObject.cpp
     src/opm/parser/eclipse/Deck/Deck.cpp
+    src/opm/parser/eclipse/Deck/DeckCache.cpp
     src/opm/parser/eclipse/Deck/DeckItem.cpp
     src/opm/parser/eclipse/Deck/DeckKeyword.cpp
     src/opm/parser/eclipse/Deck/DeckRecord.cpp
@@ -53,6 +59,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/EclipseConfig.cpp
     src/opm/parser/eclipse/EclipseState/EclipseState.cpp
     src/opm/parser/eclipse/EclipseState/EndpointScaling.cpp
+    src/opm/parser/eclipse/EclipseState/GridPartition.cpp
     src/opm/parser/eclipse/EclipseState/Edit/EDITNNC.cpp
     src/opm/parser/eclipse/EclipseState/Grid/Box.cpp
     src/opm/parser/eclipse/EclipseState/Grid/BoxManager.cpp
@@ -67,6 +74,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.cpp
     src/opm/parser/eclipse/EclipseState/Grid/NNC.cpp
     src/opm/parser/eclipse/EclipseState/Grid/PinchMode.cpp
+    src/opm/parser/eclipse/EclipseState/Grid/RegionIndex.cpp
     src/opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.cpp
     src/opm/parser/eclipse/EclipseState/Grid/setKeywordBox.cpp
     src/opm/parser/eclipse/EclipseState/Grid/TransMult.cpp
@@ -97,8 +105,10 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/Tuning.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Well.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellEconProductionLimits.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/WellEconEvaluator.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellInjectionProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/WellPropertyPool.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.cpp
@@ -113,6 +123,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Tables/PolyInjTables.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableColumn.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableContainer.cpp
+    src/opm/parser/eclipse/EclipseState/Tables/TableEvaluator.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableIndex.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableManager.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableSchema.cpp
@@ -120,21 +131,29 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/UDQConfig.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQExpression.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/UDQEvaluator.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.cpp
+    src/opm/parser/eclipse/Parser/DeckServer.cpp
     src/opm/parser/eclipse/Parser/ParseContext.cpp
+    src/opm/parser/eclipse/Parser/ParseProfile.cpp
+    src/opm/parser/eclipse/Parser/KeywordBundle.cpp
     src/opm/parser/eclipse/Parser/Parser.cpp
     src/opm/parser/eclipse/Parser/ParserEnums.cpp
     src/opm/parser/eclipse/Parser/ParserItem.cpp
     src/opm/parser/eclipse/Parser/ParserKeyword.cpp
     src/opm/parser/eclipse/Parser/ParserRecord.cpp
+    src/opm/parser/eclipse/Parser/SectionIndex.cpp
     src/opm/parser/eclipse/RawDeck/RawKeyword.cpp
     src/opm/parser/eclipse/RawDeck/RawRecord.cpp
     src/opm/parser/eclipse/RawDeck/StarToken.cpp
     src/opm/parser/eclipse/Units/Dimension.cpp
     src/opm/parser/eclipse/Units/UnitSystem.cpp
+    src/opm/parser/eclipse/Utility/Fingerprint.cpp
     src/opm/parser/eclipse/Utility/Functional.cpp
     src/opm/parser/eclipse/Utility/Stringview.cpp
+    src/opm/parser/eclipse/Utility/Symbol.cpp
   )
 
   if(NOT cjson_FOUND)
@@ -147,6 +166,9 @@ if(ENABLE_ECL_OUTPUT)
           src/opm/output/eclipse/AggregateGroupData.cpp
           src/opm/output/eclipse/AggregateMSWData.cpp
           src/opm/output/eclipse/AggregateWellData.cpp
+          src/opm/output/eclipse/ArrayReader.cpp
+          src/opm/output/eclipse/ArrayWriter.cpp
+          src/opm/output/eclipse/ColumnarSummary.cpp
           src/opm/output/eclipse/CreateDoubHead.cpp
           src/opm/output/eclipse/CreateInteHead.cpp
           src/opm/output/eclipse/CreateLogiHead.cpp
@@ -162,6 +184,7 @@ if(ENABLE_ECL_OUTPUT)
           src/opm/output/eclipse/RestartIO.cpp
           src/opm/output/eclipse/Summary.cpp
           src/opm/output/eclipse/Tables.cpp
+          src/opm/output/eclipse/UnformattedArray.cpp
           src/opm/output/eclipse/RegionCache.cpp
           src/opm/output/eclipse/RestartValue.cpp
           src/opm/output/data/Solution.cpp
@@ -172,10 +195,13 @@ list (APPEND TEST_SOURCE_FILES
       tests/test_calculateCellVol.cpp
       tests/test_cmp.cpp
       tests/test_cubic.cpp
+      tests/test_FirstTouch.cpp
       tests/test_messagelimiter.cpp
       tests/test_nonuniformtablelinear.cpp
       tests/test_OpmLog.cpp
+      tests/test_ParallelChunks.cpp
       tests/test_param.cpp
+      tests/test_rootfinders.cpp
       tests/test_SimulationDataContainer.cpp
       tests/test_sparsevector.cpp
       tests/test_uniformtablelinear.cpp
@@ -193,6 +219,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/ConnectionTests.cpp
     tests/parser/COMPSEGUnits.cpp
     tests/parser/CopyRegTests.cpp
+    tests/parser/DeckServerTests.cpp
     tests/parser/DeckTests.cpp
     tests/parser/DynamicStateTests.cpp
     tests/parser/DynamicVectorTests.cpp
@@ -204,6 +231,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/FaultTests.cpp
     tests/parser/FunctionalTests.cpp
     tests/parser/GeomodifierTests.cpp
+    tests/parser/GridPartitionTests.cpp
     tests/parser/GridPropertyTests.cpp
     tests/parser/GroupTests.cpp
     tests/parser/InitConfigTest.cpp
@@ -220,6 +248,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/RunspecTests.cpp
     tests/parser/SatfuncPropertyInitializersTests.cpp
     tests/parser/ScheduleTests.cpp
+    tests/parser/SectionIndexTests.cpp
     tests/parser/SectionTests.cpp
     tests/parser/SimpleTableTests.cpp
     tests/parser/SimulationConfigTest.cpp
@@ -246,9 +275,13 @@ endif()
 if(ENABLE_ECL_OUTPUT)
   list (APPEND TEST_SOURCE_FILES
           tests/test_AggregateWellData.cpp
+          tests/test_ArrayReader.cpp
+          tests/test_ArrayWriter.cpp
           #The unit tests are not finished yet, will be added in a separate pullrequest soon
           #tests/test_AggregateMSWData.cpp
           tests/test_CharArrayNullTerm.cpp
+          tests/test_ColumnarSummary.cpp
+          tests/test_EclipseGridInspector.cpp
           tests/test_EclipseIO.cpp
           tests/test_DoubHEAD.cpp
           tests/test_InteHEAD.cpp
@@ -261,6 +294,7 @@ if(ENABLE_ECL_OUTPUT)
           tests/test_Summary.cpp
           tests/test_Tables.cpp
           tests/test_Wells.cpp
+          tests/test_UnformattedArray.cpp
           tests/test_WindowedArray.cpp
           tests/test_writenumwells.cpp
           tests/test_serialize_ICON.cpp
@@ -292,6 +326,7 @@ list (APPEND EXAMPLE_SOURCE_FILES
 )
 if(ENABLE_ECL_INPUT)
   list (APPEND EXAMPLE_SOURCE_FILES
+    examples/opmd.cpp
     examples/opmi.cpp
     examples/opmpack.cpp
   )
@@ -303,6 +338,7 @@ list (APPEND PROGRAM_SOURCE_FILES
 )
 if(ENABLE_ECL_INPUT)
   list (APPEND PROGRAM_SOURCE_FILES
+    examples/opmd.cpp
     examples/opmi.cpp
     examples/opmpack.cpp
   )
@@ -312,16 +348,22 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/ErrorMacros.hpp
       opm/common/Exceptions.hpp
       opm/common/data/SimulationDataContainer.hpp
+      opm/common/OpmLog/AsyncLog.hpp
       opm/common/OpmLog/CounterLog.hpp
       opm/common/OpmLog/EclipsePRTLog.hpp
       opm/common/OpmLog/LogBackend.hpp
       opm/common/OpmLog/Logger.hpp
       opm/common/OpmLog/LogUtil.hpp
+      opm/common/OpmLog/MemoryUsage.hpp
+      opm/common/OpmLog/Metrics.hpp
       opm/common/OpmLog/MessageFormatter.hpp
       opm/common/OpmLog/MessageLimiter.hpp
       opm/common/OpmLog/OpmLog.hpp
+      opm/common/OpmLog/PhaseTimer.hpp
       opm/common/OpmLog/StreamLog.hpp
       opm/common/OpmLog/TimerLog.hpp
+      opm/common/utility/FirstTouch.hpp
+      opm/common/utility/ParallelChunks.hpp
       opm/common/utility/numeric/cmp.hpp
       opm/common/utility/platform_dependent/disable_warnings.h
       opm/common/utility/platform_dependent/reenable_warnings.h
@@ -346,7 +388,9 @@ if(ENABLE_ECL_INPUT)
   list(APPEND PUBLIC_HEADER_FILES
        opm/json/JsonObject.hpp
        opm/parser/eclipse/Utility/Stringview.hpp
+       opm/parser/eclipse/Utility/Symbol.hpp
        opm/parser/eclipse/Utility/Functional.hpp
+       opm/parser/eclipse/Utility/Fingerprint.hpp
        opm/parser/eclipse/Utility/Typetools.hpp
        opm/parser/eclipse/Utility/String.hpp
        opm/parser/eclipse/Generator/KeywordGenerator.hpp
@@ -355,13 +399,18 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/Units/Units.hpp
        opm/parser/eclipse/Units/Dimension.hpp
        opm/parser/eclipse/Parser/ParserItem.hpp
+       opm/parser/eclipse/Parser/DeckServer.hpp
+       opm/parser/eclipse/Parser/DeckVisitor.hpp
+       opm/parser/eclipse/Parser/KeywordBundle.hpp
        opm/parser/eclipse/Parser/Parser.hpp
        opm/parser/eclipse/Parser/ParserRecord.hpp
        opm/parser/eclipse/Parser/ParserKeyword.hpp
        opm/parser/eclipse/Parser/InputErrorAction.hpp
        opm/parser/eclipse/Parser/ParserEnums.hpp
        opm/parser/eclipse/Parser/ParseContext.hpp
+       opm/parser/eclipse/Parser/ParseProfile.hpp
        opm/parser/eclipse/Parser/ParserConst.hpp
+       opm/parser/eclipse/Parser/SectionIndex.hpp
        opm/parser/eclipse/EclipseState/InitConfig/InitConfig.hpp
        opm/parser/eclipse/EclipseState/InitConfig/Equil.hpp
        opm/parser/eclipse/EclipseState/Util/Value.hpp
@@ -378,6 +427,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Grid/Fault.hpp
        opm/parser/eclipse/EclipseState/Grid/Box.hpp
        opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp
+       opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp
        opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp
        opm/parser/eclipse/EclipseState/Grid/NNC.hpp
        opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp
@@ -413,6 +463,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Tables/Aqudims.hpp
        opm/parser/eclipse/EclipseState/Tables/JFunc.hpp
        opm/parser/eclipse/EclipseState/Tables/TableIndex.hpp
+       opm/parser/eclipse/EclipseState/Tables/TableEvaluator.hpp
        opm/parser/eclipse/EclipseState/Tables/PvtgTable.hpp
        opm/parser/eclipse/EclipseState/Tables/Tabdims.hpp
        opm/parser/eclipse/EclipseState/Tables/TableSchema.hpp
@@ -449,6 +500,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Tables/SgofTable.hpp
        opm/parser/eclipse/EclipseState/EclipseState.hpp
        opm/parser/eclipse/EclipseState/EclipseConfig.hpp
+       opm/parser/eclipse/EclipseState/GridPartition.hpp
        opm/parser/eclipse/EclipseState/Aquancon.hpp
        opm/parser/eclipse/EclipseState/AquiferCT.hpp
        opm/parser/eclipse/EclipseState/Aquifetp.hpp
@@ -457,6 +509,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/Actions.hpp
        opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp
        opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp
+       opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp
        opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp
        opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp
        opm/parser/eclipse/EclipseState/Schedule/Well.hpp
@@ -465,7 +518,9 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp
        opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellEconProductionLimits.hpp
+       opm/parser/eclipse/EclipseState/Schedule/WellEconEvaluator.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.hpp
+       opm/parser/eclipse/EclipseState/Schedule/WellPropertyPool.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.hpp
        opm/parser/eclipse/EclipseState/Schedule/Tuning.hpp
        opm/parser/eclipse/EclipseState/Schedule/Group.hpp
@@ -492,6 +547,8 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/UDQ.hpp
        opm/parser/eclipse/EclipseState/UDQConfig.hpp
        opm/parser/eclipse/EclipseState/Schedule/UDQExpression.hpp
+       opm/parser/eclipse/EclipseState/Schedule/UDQEvaluator.hpp
+       opm/parser/eclipse/Deck/DeckCache.hpp
        opm/parser/eclipse/Deck/DeckItem.hpp
        opm/parser/eclipse/Deck/Deck.hpp
        opm/parser/eclipse/Deck/Section.hpp
@@ -516,7 +573,10 @@ if(ENABLE_ECL_OUTPUT)
         opm/output/eclipse/AggregateConnectionData.hpp
         opm/output/eclipse/AggregateMSWData.hpp
         opm/output/eclipse/AggregateWellData.hpp
+        opm/output/eclipse/ArrayReader.hpp
+        opm/output/eclipse/ArrayWriter.hpp
         opm/output/eclipse/CharArrayNullTerm.hpp
+        opm/output/eclipse/ColumnarSummary.hpp
         opm/output/eclipse/DoubHEAD.hpp
         opm/output/eclipse/EclipseGridInspector.hpp
         opm/output/eclipse/EclipseIO.hpp
@@ -530,6 +590,7 @@ if(ENABLE_ECL_OUTPUT)
         opm/output/eclipse/RestartValue.hpp
         opm/output/eclipse/Summary.hpp
         opm/output/eclipse/Tables.hpp
+        opm/output/eclipse/UnformattedArray.hpp
         opm/output/eclipse/WindowedArray.hpp
         opm/output/eclipse/WriteRestartHelpers.hpp
         opm/output/OutputWriter.hpp
@@ -18,11 +18,15 @@ set(genkw_SOURCES src/opm/json/JsonObject.cpp
                   src/opm/parser/eclipse/Units/Dimension.cpp
                   src/opm/parser/eclipse/Units/UnitSystem.cpp
                   src/opm/parser/eclipse/Utility/Stringview.cpp
+                  src/opm/parser/eclipse/Utility/Fingerprint.cpp
+                  src/opm/parser/eclipse/Utility/Symbol.cpp
                   src/opm/common/OpmLog/OpmLog.cpp
                   src/opm/common/OpmLog/Logger.cpp
                   src/opm/common/OpmLog/StreamLog.cpp
                   src/opm/common/OpmLog/LogBackend.cpp
                   src/opm/common/OpmLog/LogUtil.cpp
+                  src/opm/common/OpmLog/MemoryUsage.cpp
+                  src/opm/common/OpmLog/Metrics.cpp
 )
 if(NOT cjson_FOUND)
   list(APPEND genkw_SOURCES external/cjson/cJSON.c)
@@ -0,0 +1,152 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <numeric>
+
+#include "Benchmark.hpp"
+
+namespace Opm {
+namespace bench {
+
+    double Result::min() const {
+        return *std::min_element(this->seconds.begin(), this->seconds.end());
+    }
+
+    double Result::max() const {
+        return *std::max_element(this->seconds.begin(), this->seconds.end());
+    }
+
+    double Result::mean() const {
+        return std::accumulate(this->seconds.begin(), this->seconds.end(), 0.0) / this->seconds.size();
+    }
+
+    double Result::median() const {
+        auto sorted = this->seconds;
+        std::sort(sorted.begin(), sorted.end());
+
+        const auto n = sorted.size();
+        if (n % 2 == 1)
+            return sorted[n / 2];
+
+        return 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+
+
+    Runner::Runner(std::size_t repetitions_arg, const std::string& filter_arg) :
+        repetitions(std::max<std::size_t>(repetitions_arg, 1)),
+        filter(filter_arg)
+    {}
+
+
+    void Runner::set_context(const std::string& key, std::size_t value) {
+        this->context[key] = value;
+    }
+
+
+    bool Runner::enabled(const std::string& name) const {
+        return this->filter.empty() || name.find(this->filter) != std::string::npos;
+    }
+
+
+    void Runner::run(const std::string& name,
+                     std::size_t size,
+                     const std::function<void()>& setup,
+                     const std::function<void()>& fn) {
+        if (!this->enabled(name))
+            return;
+
+        Result result;
+        result.name = name;
+        result.size = size;
+        for (std::size_t rep = 0; rep < this->repetitions; rep++) {
+            if (setup)
+                setup();
+
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto stop = std::chrono::steady_clock::now();
+            result.seconds.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+
+        this->results.push_back(result);
+    }
+
+
+    void Runner::run(const std::string& name,
+                     std::size_t size,
+                     const std::function<void()>& fn) {
+        this->run(name, size, nullptr, fn);
+    }
+
+
+    void Runner::print(std::ostream& os) const {
+        os << std::left << std::setw(32) << "benchmark"
+           << std::right << std::setw(12) << "size"
+           << std::setw(14) << "min [s]"
+           << std::setw(14) << "median [s]"
+           << std::setw(14) << "max [s]" << std::endl;
+
+        for (const auto& result : this->results)
+            os << std::left << std::setw(32) << result.name
+               << std::right << std::setw(12) << result.size
+               << std::setw(14) << std::setprecision(6) << result.min()
+               << std::setw(14) << std::setprecision(6) << result.median()
+               << std::setw(14) << std::setprecision(6) << result.max() << std::endl;
+    }
+
+
+    void Runner::write_json(std::ostream& os) const {
+        os << "{" << std::endl;
+        os << "  \"context\": {";
+        {
+            bool first = true;
+            for (const auto& pair : this->context) {
+                os << (first ? "" : ",") << std::endl << "    \"" << pair.first << "\": " << pair.second;
+                first = false;
+            }
+            os << (first ? "" : ",") << std::endl << "    \"repetitions\": " << this->repetitions << std::endl;
+        }
+        os << "  }," << std::endl;
+
+        os << "  \"benchmarks\": [";
+        os << std::setprecision(9);
+        for (std::size_t index = 0; index < this->results.size(); index++) {
+            const auto& result = this->results[index];
+            os << (index == 0 ? "" : ",") << std::endl
+               << "    {\"name\": \"" << result.name << "\""
+               << ", \"size\": " << result.size
+               << ", \"min\": " << result.min()
+               << ", \"median\": " << result.median()
+               << ", \"mean\": " << result.mean()
+               << ", \"max\": " << result.max()
+               << ", \"seconds\": [";
+
+            for (std::size_t rep = 0; rep < result.seconds.size(); rep++)
+                os << (rep == 0 ? "" : ", ") << result.seconds[rep];
+
+            os << "]}";
+        }
+        os << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+}
+}
@@ -0,0 +1,88 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BENCHMARK_HPP
+#define OPM_BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Opm {
+namespace bench {
+
+    /*
+      Minimal benchmark harness. Every benchmark is run a fixed number of
+      times, and the wall clock time of each repetition is recorded. The
+      optional setup function is called before every repetition and is not
+      included in the time. The results can be written as a human readable
+      table and as JSON; the JSON also holds the parameters of the
+      synthetic case, so results from different releases can be compared
+      when the parameters are equal.
+    */
+    struct Result {
+        std::string name;
+        std::size_t size;
+        std::vector<double> seconds;
+
+        double min() const;
+        double max() const;
+        double mean() const;
+        double median() const;
+    };
+
+
+    class Runner {
+    public:
+        Runner(std::size_t repetitions, const std::string& filter);
+
+        void set_context(const std::string& key, std::size_t value);
+
+        /*
+          The size argument is the natural size of the problem - cells,
+          wells, vectors ... - and is only reported.
+        */
+        void run(const std::string& name,
+                 std::size_t size,
+                 const std::function<void()>& setup,
+                 const std::function<void()>& fn);
+
+        void run(const std::string& name,
+                 std::size_t size,
+                 const std::function<void()>& fn);
+
+        bool enabled(const std::string& name) const;
+
+        void print(std::ostream& os) const;
+        void write_json(std::ostream& os) const;
+
+    private:
+        std::size_t repetitions;
+        std::string filter;
+        std::map<std::string, std::size_t> context;
+        std::vector<Result> results;
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DeckGenerator.hpp"
+
+namespace Opm {
+namespace bench {
+
+namespace {
+
+    const std::vector<std::string> well_vectors = {"WOPR", "WWPR", "WGPR", "WBHP", "WWCT", "WGOR",
+                                                   "WOPT", "WWPT", "WGPT", "WWIR", "WWIT", "WLPR"};
+
+    const double dx = 50;
+    const double dy = 50;
+    const double dz = 5;
+    const double top = 2000;
+
+    /*
+      Writes the values with a fixed number of values per line; the
+      uniform random numbers are generated directly from the raw
+      std::mt19937 output, which unlike the std distributions is fully
+      specified by the standard.
+    */
+    class ValueWriter {
+    public:
+        explicit ValueWriter(std::ostream& os_arg) :
+            os(os_arg)
+        {}
+
+        void operator()(double value) {
+            this->os << value << ((++this->count % 8 == 0) ? "\n" : " ");
+        }
+
+        void end() {
+            this->os << "\n/\n\n";
+            this->count = 0;
+        }
+
+    private:
+        std::ostream& os;
+        std::size_t count = 0;
+    };
+
+    double uniform(std::mt19937& gen, double min, double max) {
+        return min + (max - min) * (gen() / 4294967296.0);
+    }
+
+    std::string well_name(std::size_t well) {
+        return ((well % 2 == 0) ? "P" : "I") + std::to_string(well + 1);
+    }
+
+    std::string group_name(std::size_t well) {
+        return "G" + std::to_string(well / 10 + 1);
+    }
+
+}
+
+
+    std::size_t CaseParameters::summary_vectors() const {
+        return std::min(this->well_keywords, well_vectors.size()) * this->wells;
+    }
+
+
+    void write_grdecl(std::ostream& os, const CaseParameters& param) {
+        ValueWriter writer(os);
+        std::mt19937 gen(42);
+
+        os << "SPECGRID\n" << param.nx << " " << param.ny << " " << param.nz << " 1 F /\n\n";
+
+        os << "COORD\n";
+        for (std::size_t j = 0; j <= param.ny; j++) {
+            for (std::size_t i = 0; i <= param.nx; i++) {
+                for (const double z : {top, top + param.nz * dz}) {
+                    writer(i * dx);
+                    writer(j * dy);
+                    writer(z);
+                }
+            }
+        }
+        writer.end();
+
+        os << "ZCORN\n";
+        for (std::size_t k = 0; k < param.nz; k++) {
+            for (std::size_t side = 0; side < 2; side++) {
+                const double z = top + (k + side) * dz;
+                for (std::size_t n = 0; n < 4 * param.nx * param.ny; n++)
+                    writer(z);
+            }
+        }
+        writer.end();
+
+        os << "PORO\n";
+        for (std::size_t g = 0; g < param.cells(); g++)
+            writer(uniform(gen, 0.1, 0.3));
+        writer.end();
+
+        os << "PERMX\n";
+        for (std::size_t g = 0; g < param.cells(); g++)
+            writer(uniform(gen, 10, 1000));
+        writer.end();
+
+        os << "COPY\n"
+           << "  PERMX PERMY /\n"
+           << "  PERMX PERMZ /\n"
+           << "/\n\n"
+           << "MULTIPLY\n"
+           << "  PERMZ 0.1 /\n"
+           << "/\n\n";
+    }
+
+
+    void write_deck(std::ostream& os, const CaseParameters& param, const std::string& grid_include) {
+        if (param.wells > param.nx * param.ny)
+            throw std::invalid_argument("More wells than grid columns in the benchmark case");
+
+        os << "RUNSPEC\n\n"
+           << "OIL\nWATER\nGAS\nDISGAS\nUNIFOUT\n\n"
+           << "DIMENS\n" << param.nx << " " << param.ny << " " << param.nz << " /\n\n"
+           << "START\n 1 JAN 2000 /\n\n"
+           << "WELLDIMS\n" << param.wells << " " << param.nz << " " << param.wells / 10 + 1 << " 10 /\n\n";
+
+        os << "GRID\n\n"
+           << "INCLUDE\n'" << grid_include << "' /\n\n";
+
+        os << "SUMMARY\n\n"
+           << "FOPR\nFOPT\nFWPR\nFWIR\nFGPR\n\n"
+           << "GOPR\n/\nGWPR\n/\n\n";
+        for (std::size_t index = 0; index < std::min(param.well_keywords, well_vectors.size()); index++)
+            os << well_vectors[index] << "\n/\n";
+
+        os << "\nSCHEDULE\n\n";
+
+        const std::size_t stride = (param.nx * param.ny) / std::max<std::size_t>(param.wells, 1);
+        os << "WELSPECS\n";
+        for (std::size_t well = 0; well < param.wells; well++) {
+            const std::size_t column = well * stride;
+            os << "  '" << well_name(well) << "' '" << group_name(well) << "' "
+               << column % param.nx + 1 << " " << column / param.nx + 1 << " 1* 'OIL' /\n";
+        }
+        os << "/\n\n";
+
+        os << "COMPDAT\n";
+        for (std::size_t well = 0; well < param.wells; well++)
+            os << "  '" << well_name(well) << "' 2* 1 " << param.nz << " 'OPEN' 2* 0.2 /\n";
+        os << "/\n\n";
+
+        if (param.restart)
+            os << "RPTRST\n 'BASIC=2' /\n\n";
+
+        if (param.rft)
+            os << "WRFTPLT\n  '*' 'REPT' /\n/\n\n";
+
+        for (std::size_t step = 0; step < param.steps; step++) {
+            const double rate = 1000 + 10 * step;
+
+            os << "WCONPROD\n";
+            for (std::size_t well = 0; well < param.wells; well += 2)
+                os << "  '" << well_name(well) << "' 'OPEN' 'ORAT' " << rate << " 4* 100 /\n";
+            os << "/\n\n";
+
+            if (param.wells > 1) {
+                os << "WCONINJE\n";
+                for (std::size_t well = 1; well < param.wells; well += 2)
+                    os << "  '" << well_name(well) << "' 'WATER' 'OPEN' 'RATE' " << rate << " 1* 500 /\n";
+                os << "/\n\n";
+            }
+
+            os << "TSTEP\n 30 /\n\n";
+        }
+    }
+
+
+    std::string write_case(const std::string& directory, const CaseParameters& param) {
+        const std::string grid_file = "CASE.GRDECL";
+        const std::string data_file = directory + "/CASE.DATA";
+        {
+            std::ofstream os(directory + "/" + grid_file);
+            write_grdecl(os, param);
+        }
+        {
+            std::ofstream os(data_file);
+            write_deck(os, param, grid_file);
+        }
+        return data_file;
+    }
+
+}
+}
@@ -0,0 +1,70 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECK_GENERATOR_HPP
+#define OPM_DECK_GENERATOR_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace Opm {
+namespace bench {
+
+    /*
+      Parameters of the synthetic benchmark case. The case is a regular
+      corner point grid of nx x ny x nz cells, where the cell properties
+      are written out explicitly, and a schedule with 'wells' vertical
+      wells perforated in all layers, alternating between producers and
+      water injectors, and 'steps' report steps where the controls of all
+      the wells are updated. The SUMMARY section requests the first
+      'well_keywords' well vectors of a fixed list for all the wells.
+      With 'restart' a restart file is requested for every report step,
+      and with 'rft' RFT output for all the wells at every report step.
+
+      The generated files depend only on the parameters, i.e. the same
+      parameters give byte identical input on all platforms.
+    */
+    struct CaseParameters {
+        std::size_t nx = 100;
+        std::size_t ny = 100;
+        std::size_t nz = 20;
+        std::size_t wells = 200;
+        std::size_t steps = 50;
+        std::size_t well_keywords = 8;
+        bool restart = false;
+        bool rft = false;
+
+        std::size_t cells() const { return nx * ny * nz; }
+        std::size_t summary_vectors() const;
+    };
+
+    void write_grdecl(std::ostream& os, const CaseParameters& param);
+    void write_deck(std::ostream& os, const CaseParameters& param, const std::string& grid_include);
+
+    /*
+      Writes CASE.DATA and the included CASE.GRDECL to the directory and
+      returns the path of the data file.
+    */
+    std::string write_case(const std::string& directory, const CaseParameters& param);
+
+}
+}
+
+#endif
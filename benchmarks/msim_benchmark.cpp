@@ -0,0 +1,219 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <getopt.h>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/common/OpmLog/PhaseTimer.hpp>
+#include <opm/msim/msim.hpp>
+#include <opm/output/data/Solution.hpp>
+#include <opm/output/data/Wells.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+#include "DeckGenerator.hpp"
+
+using namespace Opm;
+
+namespace {
+
+void print_help_and_exit() {
+    const char * help_text = R"(
+The msim_benchmark program generates a synthetic case and runs it through
+the output of the mock simulator msim: the summary evaluation and output,
+the restart output and the RFT output of every ministep, with solution and
+well rates which are simple functions of time. The time and the number of
+bytes written in each phase are printed, and written as JSON with -j.
+
+    -x <nx>     Number of cells in the x direction (100).
+    -y <ny>     Number of cells in the y direction (100).
+    -z <nz>     Number of cells in the z direction (20).
+    -w <wells>  Number of wells (200).
+    -s <steps>  Number of report steps (50).
+    -k <count>  Number of well summary keywords (8).
+    -m <count>  Number of ministeps per report step (default: msim's own).
+    -n          No restart output.
+    -r          No RFT output.
+    -d <dir>    Directory for the case and the output (msim_benchmark).
+    -j <file>   Write the results as JSON to this file.
+)";
+    std::cerr << help_text << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+
+void fill(std::vector<double>& values, double value) {
+    for (std::size_t index = 0; index < values.size(); index++)
+        values[index] = value + 1e-6 * index;
+}
+
+
+void write_json(std::ostream& os, const bench::CaseParameters& param, std::size_t ministeps) {
+    os << "{\n"
+       << "  \"parameters\": {\n"
+       << "    \"nx\": " << param.nx << ",\n"
+       << "    \"ny\": " << param.ny << ",\n"
+       << "    \"nz\": " << param.nz << ",\n"
+       << "    \"wells\": " << param.wells << ",\n"
+       << "    \"steps\": " << param.steps << ",\n"
+       << "    \"summary_vectors\": " << param.summary_vectors() << ",\n"
+       << "    \"ministeps\": " << ministeps << ",\n"
+       << "    \"restart\": " << (param.restart ? "true" : "false") << ",\n"
+       << "    \"rft\": " << (param.rft ? "true" : "false") << "\n"
+       << "  },\n"
+       << "  \"phases\": ";
+    PhaseTimer::writeJSON(os);
+    os << "\n}\n";
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    bench::CaseParameters param;
+    param.restart = true;
+    param.rft = true;
+    std::size_t ministeps = 0;
+    std::string directory = "msim_benchmark";
+    std::string json_file;
+
+    while (true) {
+        int c = getopt(argc, argv, "x:y:z:w:s:k:m:nrd:j:h");
+        if (c == -1)
+            break;
+
+        switch (c) {
+        case 'x':
+            param.nx = std::stoul(optarg);
+            break;
+        case 'y':
+            param.ny = std::stoul(optarg);
+            break;
+        case 'z':
+            param.nz = std::stoul(optarg);
+            break;
+        case 'w':
+            param.wells = std::stoul(optarg);
+            break;
+        case 's':
+            param.steps = std::stoul(optarg);
+            break;
+        case 'k':
+            param.well_keywords = std::stoul(optarg);
+            break;
+        case 'm':
+            ministeps = std::stoul(optarg);
+            break;
+        case 'n':
+            param.restart = false;
+            break;
+        case 'r':
+            param.rft = false;
+            break;
+        case 'd':
+            directory = optarg;
+            break;
+        case 'j':
+            json_file = optarg;
+            break;
+        default:
+            print_help_and_exit();
+        }
+    }
+
+    if (!json_file.empty())
+        json_file = boost::filesystem::absolute(json_file).string();
+
+    boost::filesystem::create_directories(directory);
+    const auto data_file = bench::write_case(directory, param);
+    boost::filesystem::current_path(directory);
+
+    PhaseTimer::enable();
+    std::unique_ptr<msim> sim;
+    {
+        PhaseTimer::Scope phase("msim::setup");
+        sim.reset(new msim(boost::filesystem::path(data_file).filename().string()));
+    }
+
+    /*
+      The fields are functions of time only, the well rates the time in
+      days plus the position of the well; the values are not physical,
+      only the amount of output matters.
+    */
+    const double day = 86400;
+    sim->solution("PRESSURE", UnitSystem::measure::pressure, [](const EclipseState&, const Schedule&, size_t, double seconds, std::vector<double>& values) {
+        fill(values, 1e7 + seconds);
+    });
+    sim->solution("SWAT", UnitSystem::measure::identity, [day](const EclipseState&, const Schedule&, size_t, double seconds, std::vector<double>& values) {
+        fill(values, 0.2 + 1e-5 * seconds / day);
+    });
+    sim->solution("SGAS", UnitSystem::measure::identity, [day](const EclipseState&, const Schedule&, size_t, double seconds, std::vector<double>& values) {
+        fill(values, 0.1 + 1e-5 * seconds / day);
+    });
+    sim->solution("RS", UnitSystem::measure::gas_oil_ratio, [](const EclipseState&, const Schedule&, size_t, double, std::vector<double>& values) {
+        fill(values, 100);
+    });
+
+    std::vector<std::string> producers;
+    std::vector<std::string> injectors;
+    for (std::size_t well = 0; well < param.wells; well++) {
+        if (well % 2 == 0)
+            producers.push_back("P" + std::to_string(well + 1));
+        else
+            injectors.push_back("I" + std::to_string(well + 1));
+    }
+
+    const auto producer_rates = [day, &producers](const EclipseState&, const Schedule&, const data::Solution&, size_t, double seconds, double* rates) {
+        for (std::size_t index = 0; index < producers.size(); index++)
+            rates[index] = seconds / day + index;
+    };
+    const auto injector_rates = [day, &injectors](const EclipseState&, const Schedule&, const data::Solution&, size_t, double seconds, double* rates) {
+        for (std::size_t index = 0; index < injectors.size(); index++)
+            rates[index] = seconds / day + index;
+    };
+    sim->well_rate(producers, data::Rates::opt::oil, producer_rates);
+    sim->well_rate(producers, data::Rates::opt::wat, producer_rates);
+    sim->well_rate(producers, data::Rates::opt::gas, producer_rates);
+    sim->well_rate(injectors, data::Rates::opt::wat, injector_rates);
+
+    if (ministeps > 0)
+        sim->ministeps(ministeps);
+
+    {
+        PhaseTimer::Scope phase("msim::run");
+        sim->run();
+    }
+
+    PhaseTimer::writeTree(std::cout);
+    if (!json_file.empty()) {
+        std::ofstream os(json_file);
+        write_json(os, param, ministeps);
+    }
+
+    return 0;
+}
@@ -0,0 +1,333 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <getopt.h>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/output/data/Cells.hpp>
+#include <opm/output/data/Solution.hpp>
+#include <opm/output/data/Wells.hpp>
+#include <opm/output/eclipse/RestartIO.hpp>
+#include <opm/output/eclipse/RestartValue.hpp>
+#include <opm/output/eclipse/Summary.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+#include "Benchmark.hpp"
+#include "DeckGenerator.hpp"
+
+using namespace Opm;
+
+namespace {
+
+void print_help_and_exit() {
+    const char * help_text = R"(
+The opm_benchmarks program generates a synthetic case and times the parser,
+EclipseState and Schedule construction, the EclipseGrid geometry and the
+summary and restart output for it, and the evaluation of a VFPPROD table
+for every well.
+
+Options:
+
+   -x NX -y NY -z NZ   Grid dimensions, default 100 x 100 x 20.
+   -w WELLS            Number of wells, default 200.
+   -s STEPS            Number of report steps, default 50.
+   -k KEYWORDS         Number of well summary keywords, default 8.
+   -r REPETITIONS      Repetitions of every benchmark, default 5.
+   -f FILTER           Only run the benchmarks whose name contains FILTER.
+   -d DIRECTORY        Directory for the generated case and the output
+                       files, default 'opm_benchmarks'.
+   -j FILE             Write the results as JSON to FILE.
+
+)";
+    std::cerr << help_text << std::endl;
+    exit(1);
+}
+
+
+data::Wells make_wells(const Schedule& schedule, const EclipseGrid& grid, std::size_t report_step) {
+    using rt = data::Rates::opt;
+    data::Wells wells;
+
+    for (const auto* sched_well : schedule.getWells(report_step)) {
+        data::Well well;
+        well.rates.set(rt::wat, -1.0);
+        well.rates.set(rt::oil, -2.0);
+        well.rates.set(rt::gas, -3.0);
+        well.bhp = 1.0e7;
+        well.thp = 1.0e6;
+        well.temperature = 300;
+        well.control = 0;
+
+        for (const auto& conn : sched_well->getConnections(report_step)) {
+            data::Connection dconn;
+            dconn.index = grid.getGlobalIndex(conn.getI(), conn.getJ(), conn.getK());
+            dconn.rates = well.rates;
+            dconn.pressure = 1.0e7;
+            dconn.reservoir_rate = 1.0;
+            dconn.cell_pressure = 1.0e7;
+            dconn.cell_saturation_water = 0.2;
+            dconn.cell_saturation_gas = 0.1;
+            dconn.effective_Kh = 100;
+            well.connections.push_back(dconn);
+        }
+
+        wells.emplace(sched_well->name(), well);
+    }
+
+    wells.index_connections();
+    return wells;
+}
+
+
+data::Solution make_solution(std::size_t num_cells) {
+    using measure = UnitSystem::measure;
+
+    data::Solution sol;
+    sol.insert("PRESSURE", measure::pressure, std::vector<double>(num_cells, 2.0e7), data::TargetType::RESTART_SOLUTION);
+    sol.insert("SWAT", measure::identity, std::vector<double>(num_cells, 0.2), data::TargetType::RESTART_SOLUTION);
+    sol.insert("SGAS", measure::identity, std::vector<double>(num_cells, 0.1), data::TargetType::RESTART_SOLUTION);
+    sol.insert("RS", measure::gas_oil_ratio, std::vector<double>(num_cells, 100), data::TargetType::RESTART_SOLUTION);
+    return sol;
+}
+
+
+std::vector<double> make_axis(std::size_t size, double first, double last) {
+    std::vector<double> axis(size);
+    for (std::size_t index = 0; index < size; index++)
+        axis[index] = first + (last - first) * index / (size - 1);
+    return axis;
+}
+
+
+/*
+  A VFPPROD table of the size found in field cases, with a smooth
+  nonlinear body.
+*/
+VFPProdTable make_vfpprod_table() {
+    const auto flo = make_axis(20, 1.0e-4, 0.1);
+    const auto thp = make_axis(8, 1.0e6, 5.0e6);
+    const auto wfr = make_axis(10, 0, 1);
+    const auto gfr = make_axis(10, 50, 500);
+    const auto alq = make_axis(4, 0, 1000);
+
+    VFPProdTable::array_type data(VFPProdTable::extents{{ 8, 10, 10, 4, 20 }});
+    for (std::size_t t = 0; t < thp.size(); t++)
+        for (std::size_t w = 0; w < wfr.size(); w++)
+            for (std::size_t g = 0; g < gfr.size(); g++)
+                for (std::size_t a = 0; a < alq.size(); a++)
+                    for (std::size_t f = 0; f < flo.size(); f++)
+                        data[t][w][g][a][f] = thp[t] * (1 + wfr[w]) + 1.0e5 * std::sqrt(gfr[g]) - alq[a] + 1.0e9 * flo[f] * flo[f];
+
+    return VFPProdTable(1, 2000, VFPProdTable::FLO_LIQ, VFPProdTable::WFR_WCT, VFPProdTable::GFR_GOR,
+                        VFPProdTable::ALQ_GRAT, flo, thp, wfr, gfr, alq, data);
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    bench::CaseParameters param;
+    std::size_t repetitions = 5;
+    std::string filter;
+    std::string directory = "opm_benchmarks";
+    std::string json_file;
+
+    while (true) {
+        int c = getopt(argc, argv, "x:y:z:w:s:k:r:f:d:j:h");
+        if (c == -1)
+            break;
+
+        switch (c) {
+        case 'x':
+            param.nx = std::stoul(optarg);
+            break;
+        case 'y':
+            param.ny = std::stoul(optarg);
+            break;
+        case 'z':
+            param.nz = std::stoul(optarg);
+            break;
+        case 'w':
+            param.wells = std::stoul(optarg);
+            break;
+        case 's':
+            param.steps = std::stoul(optarg);
+            break;
+        case 'k':
+            param.well_keywords = std::stoul(optarg);
+            break;
+        case 'r':
+            repetitions = std::stoul(optarg);
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        case 'd':
+            directory = optarg;
+            break;
+        case 'j':
+            json_file = optarg;
+            break;
+        default:
+            print_help_and_exit();
+        }
+    }
+
+    if (!json_file.empty())
+        json_file = boost::filesystem::absolute(json_file).string();
+
+    boost::filesystem::create_directories(directory);
+    const auto data_file = bench::write_case(directory, param);
+    boost::filesystem::current_path(directory);
+
+    bench::Runner runner(repetitions, filter);
+    runner.set_context("nx", param.nx);
+    runner.set_context("ny", param.ny);
+    runner.set_context("nz", param.nz);
+    runner.set_context("wells", param.wells);
+    runner.set_context("steps", param.steps);
+    runner.set_context("summary_vectors", param.summary_vectors());
+
+    /*
+      The objects built by one benchmark are the input to the next, they
+      are therefore always built once up front, whether or not the
+      benchmark itself is enabled.
+    */
+    ParseContext parse_context;
+    const std::string case_file = boost::filesystem::path(data_file).filename().string();
+    auto deck = Parser().parseFile(case_file, parse_context);
+    runner.run("Parser::parseFile", param.cells(), [&]() {
+        Parser().parseFile(case_file, parse_context);
+    });
+
+    EclipseState es(deck, parse_context);
+    runner.run("EclipseState", param.cells(), [&]() {
+        EclipseState tmp(deck, parse_context);
+    });
+
+    const auto& grid = es.getInputGrid();
+    Schedule schedule(deck, grid, es.get3DProperties(), es.runspec(), parse_context);
+    runner.run("Schedule", param.wells * param.steps, [&]() {
+        Schedule tmp(deck, grid, es.get3DProperties(), es.runspec(), parse_context);
+    });
+
+    {
+        std::unique_ptr<EclipseGrid> fresh_grid;
+        runner.run("EclipseGrid::geometry", param.cells(),
+                   [&]() { fresh_grid.reset(new EclipseGrid(deck)); },
+                   [&]() {
+                       fresh_grid->getCellVolumes();
+                       fresh_grid->getCellCenters();
+                       fresh_grid->getCellDimensions();
+                   });
+    }
+
+    SummaryConfig summary_config(deck, schedule, es.getTableManager(), parse_context);
+    const auto wells = make_wells(schedule, grid, param.steps);
+    std::unique_ptr<out::Summary> summary;
+    runner.run("Summary::add_timestep", param.summary_vectors() * param.steps,
+               [&]() { summary.reset(new out::Summary(es, summary_config, grid, schedule, "BENCH")); },
+               [&]() {
+                   for (std::size_t step = 1; step <= param.steps; step++)
+                       summary->add_timestep(step, step * 30 * 86400.0, es, schedule, wells, {});
+                   summary->write();
+               });
+
+    if (!summary) {
+        summary.reset(new out::Summary(es, summary_config, grid, schedule, "BENCH"));
+        summary->add_timestep(1, 30 * 86400.0, es, schedule, wells, {});
+    }
+
+    const std::size_t num_active = grid.getNumActive();
+    const RestartValue restart_value(make_solution(num_active), wells);
+    const int report_step = static_cast<int>(param.steps);
+    es.getIOConfig().setEclCompatibleRST(false);
+    runner.run("RestartIO::save", num_active, [&]() {
+        RestartIO::save("BENCH.UNRST", report_step, report_step * 30 * 86400.0, restart_value,
+                        es, grid, schedule, summary->get_restart_vectors());
+    });
+
+    const std::vector<RestartKey> solution_keys = {{"PRESSURE", UnitSystem::measure::pressure},
+                                                   {"SWAT", UnitSystem::measure::identity},
+                                                   {"SGAS", UnitSystem::measure::identity},
+                                                   {"RS", UnitSystem::measure::gas_oil_ratio}};
+    if (runner.enabled("RestartIO::load") && !runner.enabled("RestartIO::save"))
+        RestartIO::save("BENCH.UNRST", report_step, report_step * 30 * 86400.0, restart_value,
+                        es, grid, schedule, summary->get_restart_vectors());
+
+    runner.run("RestartIO::load", num_active, [&]() {
+        RestartIO::load("BENCH.UNRST", report_step, solution_keys, es, grid, schedule);
+    });
+
+    {
+        /*
+          One bhp evaluation per well and Newton iteration; the well
+          states are spread over the whole table.
+        */
+        const VFPProdEvaluator vfp(make_vfpprod_table());
+        const std::size_t iterations = 1000;
+        const std::size_t num_wells = param.wells;
+        std::vector<double> thp(num_wells), wfr(num_wells), gfr(num_wells), alq(num_wells), flo(num_wells);
+        for (std::size_t well = 0; well < num_wells; well++) {
+            const double w = (well + 0.5) / num_wells;
+            thp[well] = 1.0e6 + 4.0e6 * w;
+            wfr[well] = 1 - w;
+            gfr[well] = 50 + 450 * w * w;
+            alq[well] = 1000 * (1 - w * w);
+            flo[well] = 0.1 * w;
+        }
+
+        std::vector<double> bhp(num_wells);
+        runner.run("VFPProdEvaluator::bhp", num_wells * iterations, [&]() {
+            for (std::size_t iter = 0; iter < iterations; iter++)
+                vfp.evaluate(num_wells, thp.data(), wfr.data(), gfr.data(), alq.data(), flo.data(), bhp.data());
+        });
+
+        std::vector<VFPEvaluation> result(num_wells);
+        runner.run("VFPProdEvaluator::derivatives", num_wells * iterations, [&]() {
+            for (std::size_t iter = 0; iter < iterations; iter++)
+                vfp.evaluate(num_wells, thp.data(), wfr.data(), gfr.data(), alq.data(), flo.data(), result.data());
+        });
+    }
+
+    runner.print(std::cout);
+    if (!json_file.empty()) {
+        std::ofstream os(json_file);
+        runner.write_json(os);
+    }
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Parser/DeckServer.hpp>
+#include <opm/parser/eclipse/Parser/InputErrorAction.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+
+
+namespace {
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+std::string handle_request(Opm::DeckServer& server, const std::string& line) {
+    std::istringstream request(line);
+    std::string command;
+    request >> command;
+
+    std::string path;
+    std::getline(request >> std::ws, path);
+
+    std::ostringstream reply;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        if (command == "deck" && !path.empty()) {
+            const auto deck = server.deck(path);
+            reply << "ok keywords=" << deck->size() << " ms=" << elapsed_ms(start);
+        } else if (command == "state" && !path.empty()) {
+            const auto state = server.eclipseState(path);
+            reply << "ok active_cells=" << state->getInputGrid().getNumActive() << " ms=" << elapsed_ms(start);
+        } else if (command == "stats") {
+            const auto stats = server.statistics();
+            reply << "ok hits=" << stats.hits
+                  << " misses=" << stats.misses
+                  << " evictions=" << stats.evictions
+                  << " decks=" << stats.decks
+                  << " bytes=" << stats.bytes;
+        } else if (command == "clear") {
+            server.clear();
+            reply << "ok";
+        } else
+            reply << "error unknown request: " << line;
+    } catch (const std::exception& e) {
+        reply << "error " << e.what();
+    }
+
+    return reply.str() + "\n";
+}
+
+
+/* One request per line, one reply line per request. */
+void serve_client(Opm::DeckServer& server, int fd) {
+    std::string buffer;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof chunk)) > 0) {
+        buffer.append(chunk, n);
+
+        std::string::size_type eol;
+        while ((eol = buffer.find('\n')) != std::string::npos) {
+            const auto reply = handle_request(server, buffer.substr(0, eol));
+            buffer.erase(0, eol + 1);
+            if (::write(fd, reply.data(), reply.size()) < 0) {
+                ::close(fd);
+                return;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+
+void print_help_and_exit() {
+    const char * help_text = R"(
+The opmd program keeps the parser and the recently parsed decks in
+memory, and answers requests from local clients on a unix socket. A
+repeated request for a deck whose input files are unchanged is answered
+from memory; the deck and include caches are used when parsing. The
+requests are single lines:
+
+   deck  /path/to/CASE.DATA     parse the deck
+   state /path/to/CASE.DATA     build the EclipseState of the deck
+   stats                        hits, misses and memory of the held decks
+   clear                        drop all the held decks
+
+Options:
+
+   -s socket     the socket path, default /tmp/opmd.socket
+   -m megabytes  the memory budget of the held decks, default 4096
+
+
+   opmd -s /tmp/qc.socket -m 8192 &
+   echo "deck /path/to/CASE.DATA" | nc -U /tmp/qc.socket
+
+)";
+    std::cerr << help_text << std::endl;
+    exit(1);
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    std::string socket_path = "/tmp/opmd.socket";
+    std::size_t budget_mb = 4096;
+
+    while (true) {
+        int c;
+        c = getopt(argc, argv, "s:m:h");
+        if (c == -1)
+            break;
+
+        switch(c) {
+        case 's':
+            socket_path = optarg;
+            break;
+        case 'm':
+            budget_mb = std::strtoul(optarg, nullptr, 10);
+            break;
+        default:
+            print_help_and_exit();
+        }
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof address.sun_path) {
+        std::cerr << "Socket path too long: " << socket_path << std::endl;
+        return 1;
+    }
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof address.sun_path - 1);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socket_path.c_str());
+    if (listener < 0
+        || ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0
+        || ::listen(listener, 16) != 0) {
+        std::perror("opmd");
+        return 1;
+    }
+
+    Opm::ParseContext parseContext(Opm::InputError::WARN);
+    Opm::DeckServer server(budget_mb << 20, parseContext);
+
+    while (true) {
+        const int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+        std::thread(serve_client, std::ref(server), client).detach();
+    }
+}
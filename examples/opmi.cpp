@@ -18,7 +18,10 @@
 */
 
 #include <iostream>
+#include <memory>
 
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -44,7 +47,14 @@ inline void loadDeck( const char * deck_file) {
 
 
 int main(int argc, char** argv) {
-    for (int iarg = 1; iarg < argc; iarg++)
+    Opm::PhaseTimer::enable();
+    Opm::OpmLog::addMessageType( Opm::PhaseTimerLog::PhaseReport, "phases" );
+    Opm::OpmLog::addBackend( "PHASES", std::make_shared<Opm::PhaseTimerLog>( std::cout ) );
+
+    for (int iarg = 1; iarg < argc; iarg++) {
+        Opm::PhaseTimer::reset();
         loadDeck( argv[iarg] );
+        Opm::OpmLog::addMessage( Opm::PhaseTimerLog::PhaseReport, argv[iarg] );
+    }
 }
 
@@ -25,6 +25,7 @@
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/InputErrorAction.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 
 
 inline void pack_deck( const char * deck_file, std::ostream& os) {
@@ -32,7 +33,9 @@ inline void pack_deck( const char * deck_file, std::ostream& os) {
     Opm::Parser parser;
 
     auto deck = parser.parseFile(deck_file, parseContext);
-    os << deck;
+    Opm::DeckOutput out( os, 10 );
+    out.compress_repeats = true;
+    deck.write( out );
 
 }
 
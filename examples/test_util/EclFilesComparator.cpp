@@ -260,6 +260,37 @@ Deviation ECLFilesComparator::calculateDeviations(double val1, double val2) {
 
 
 
+bool ECLFilesComparator::calculateDeviations(const double* values1, const double* values2, size_t size,
+                                             double absTolerance, double relTolerance, bool allowNegativeValues,
+                                             std::vector<double>& absDev, std::vector<double>& relDev) {
+    for (size_t index = 0; index < size; index++) {
+        double val1 = values1[index];
+        double val2 = values2[index];
+        if (!allowNegativeValues) {
+            if (val1 < 0) {
+                if (-val1 > absTolerance)
+                    return false;
+                val1 = 0;
+            }
+            if (val2 < 0) {
+                if (-val2 > absTolerance)
+                    return false;
+                val2 = 0;
+            }
+        }
+        const Deviation dev = calculateDeviations(val1, val2);
+        if (dev.abs > absTolerance && dev.rel > relTolerance)
+            return false;
+        if (dev.abs != -1)
+            absDev.push_back(dev.abs);
+        if (dev.rel != -1)
+            relDev.push_back(dev.rel);
+    }
+    return true;
+}
+
+
+
 double ECLFilesComparator::median(std::vector<double> vec) {
     if (vec.empty()) {
         return 0;
@@ -21,6 +21,7 @@
 #define ECLFILESCOMPARATOR_HPP
 
 #include "Deviation.hpp"
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <string>
@@ -54,6 +55,7 @@ class ECLFilesComparator {
         std::vector<std::string> keywords1, keywords2;
         bool throwOnError = true; //!< Throw on first error
         bool analysis = false; //!< Perform full error analysis
+        size_t numThreads = 1; //!< Threads used for the deviations of large keywords
         std::map<std::string, std::vector<Deviation>> deviations;
         mutable size_t num_errors = 0;
 
@@ -96,6 +98,9 @@ class ECLFilesComparator {
         //! \brief Set whether to perform a full error analysis.
         void doAnalysis(bool analize) { analysis = analize; }
 
+        //! \brief Set the number of threads used to compute the deviations of large keywords.
+        void setThreads(size_t threads) { numThreads = std::max<size_t>(threads, 1); }
+
         //! \brief Returns the number of errors encountered in the performed comparisons.
         size_t getNoErrors() const { return num_errors; }
 
@@ -114,6 +119,11 @@ class ECLFilesComparator {
         //! \brief Calculate deviations for two values.
         //! \details Using absolute values of the input arguments: If one of the values are non-zero, the Deviation::abs returned is the difference between the two input values. In addition, if both values are non-zero, the Deviation::rel returned is the absolute deviation divided by the largest value.
         static Deviation calculateDeviations(double val1, double val2);
+        //! \brief Calculate deviations for two arrays of values.
+        //! \details The deviations of the element pairs, as calculateDeviations(), are appended to absDev and relDev where they are defined. If allowNegativeValues is false, negative values which are within the absolute tolerance are treated as zero. Returns false if any element pair exceeds both tolerances or has a negative value outside the absolute tolerance; the values appended are then incomplete.
+        static bool calculateDeviations(const double* values1, const double* values2, size_t size,
+                                        double absTolerance, double relTolerance, bool allowNegativeValues,
+                                        std::vector<double>& absDev, std::vector<double>& relDev);
         //! \brief Calculate median of a vector.
         //! \details Returning the median of the input vector, i.e. the middle value of the sorted vector if the number of elements is odd or the mean of the two middle values if the number of elements are even.
         static double median(std::vector<double> vec);
@@ -22,6 +22,7 @@
 #include <cmath>
 #include <iostream>
 #include <set>
+#include <thread>
 
 #include <ert/ecl/ecl_file.h>
 #include <ert/ecl/ecl_grid.h>
@@ -118,8 +119,46 @@ void ECLRegressionTest::doubleComparisonForOccurrence(const std::string& keyword
     ecl_kw_get_data_as_double(ecl_kw2, values2.data());
 
     auto it = std::find(keywordDisallowNegatives.begin(), keywordDisallowNegatives.end(), keyword);
+    const bool allowNegativeValues = (it == keywordDisallowNegatives.end());
+
+    /*
+      The deviations are first computed without any reporting, split
+      over the threads for large keywords. Only when a cell violates
+      the tolerances is the keyword compared again cell by cell, which
+      reports the offending cells and records them for the analysis.
+    */
+    const size_t minChunk = 1 << 16;
+    const size_t numChunks = std::max<size_t>(1, std::min(numThreads, values1.size() / minChunk));
+    const size_t chunkSize = (values1.size() + numChunks - 1) / numChunks;
+    std::vector<std::vector<double>> absChunks(numChunks), relChunks(numChunks);
+    std::vector<char> withinTolerance(numChunks, 1);
+    auto compareChunk = [&](size_t chunk) {
+        const size_t begin = std::min(chunk * chunkSize, values1.size());
+        const size_t end = std::min(begin + chunkSize, values1.size());
+        absChunks[chunk].reserve(end - begin);
+        relChunks[chunk].reserve(end - begin);
+        withinTolerance[chunk] = calculateDeviations(values1.data() + begin, values2.data() + begin, end - begin,
+                                                     getAbsTolerance(), getRelTolerance(), allowNegativeValues,
+                                                     absChunks[chunk], relChunks[chunk]);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t chunk = 1; chunk < numChunks; chunk++)
+        workers.emplace_back(compareChunk, chunk);
+    compareChunk(0);
+    for (auto& worker : workers)
+        worker.join();
+
+    if (std::find(withinTolerance.begin(), withinTolerance.end(), 0) == withinTolerance.end()) {
+        for (size_t chunk = 0; chunk < numChunks; chunk++) {
+            absDeviation.insert(absDeviation.end(), absChunks[chunk].begin(), absChunks[chunk].end());
+            relDeviation.insert(relDeviation.end(), relChunks[chunk].begin(), relChunks[chunk].end());
+        }
+        return;
+    }
+
     for (size_t cell = 0; cell < values1.size(); cell++) {
-        deviationsForCell(values1[cell], values2[cell], keyword, occurrence1, occurrence2, cell, it == keywordDisallowNegatives.end());
+        deviationsForCell(values1[cell], values2[cell], keyword, occurrence1, occurrence2, values1.size(), cell, allowNegativeValues);
     }
 }
 
@@ -28,6 +28,7 @@
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_file.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <getopt.h>
@@ -46,6 +47,7 @@ static void printHelp() {
         << "-i Execute integration test (regression test is default).\n"
         << "   The integration test compares SGAS, SWAT and PRESSURE in unified restart files, so this option can not be used in combination with -t.\n"
         << "-I Same as -i, but throws an exception when the number of keywords in the two cases differ. Can not be used in combination with -t.\n"
+        << "-j int Sets the number of threads used to compare the values of large keywords in the regression test.\n"
         << "-k Specify specific keyword to compare (capitalized), for example -k PRESSURE.\n"
         << "-K Will not allow different amount of keywords in the two files. Throws an exception if the amount are different.\n"
         << "-l Only do comparison for the last occurrence. This option is only for the regression test, and can therefore not be used in combination with -i or -I.\n"
@@ -140,8 +142,9 @@ int main(int argc, char** argv) {
     const char* mainVariable     = nullptr;
     int c                        = 0;
     int spikeLimit               = -1;
+    int numThreads               = 1;
 
-    while ((c = getopt(argc, argv, "hiIk:alnpPt:VRgs:m:vKx")) != -1) {
+    while ((c = getopt(argc, argv, "hiIj:k:alnpPt:VRgs:m:vKx")) != -1) {
         switch (c) {
             case 'a':
               analysis = true;
@@ -160,6 +163,9 @@ int main(int argc, char** argv) {
                 integrationTest = true;
                 checkNumKeywords = true;
                 break;
+            case 'j':
+                numThreads = atoi(optarg);
+                break;
             case 'k':
                 specificKeyword = true;
                 keyword = optarg;
@@ -203,7 +209,7 @@ int main(int argc, char** argv) {
                 acceptExtraKeywords = true;
                 break;
             case '?':
-                if (optopt == 'k' || optopt == 'm' || optopt == 's') {
+                if (optopt == 'j' || optopt == 'k' || optopt == 'm' || optopt == 's') {
                     std::cerr << "Option " << optopt << " requires a keyword as argument, see manual (-h) for more information." << std::endl;
                     return EXIT_FAILURE;
                 }
@@ -350,6 +356,7 @@ int main(int argc, char** argv) {
             comparator.throwOnErrors(throwOnError);
             comparator.doAnalysis(analysis);
             comparator.setAcceptExtraKeywords(acceptExtraKeywords);
+            comparator.setThreads(std::max(numThreads, 1));
             if (printKeywords) {
                 comparator.printKeywords();
                 return 0;
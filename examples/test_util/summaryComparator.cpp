@@ -49,6 +49,8 @@ SummaryComparator::SummaryComparator(const std::string& basename1,
         this->keysShort = this->keys2;
         this->keysLong = this->keys1;
     }
+    for (int ivar = 0; ivar < stringlist_get_size(keysLong); ivar++)
+        keysLongSet.insert(stringlist_iget(keysLong, ivar));
 }
 
 
@@ -88,14 +90,15 @@ void SummaryComparator::setTimeVecs(std::vector<double> &timeVec1,
 void SummaryComparator::getDataVecs(std::vector<double> &dataVec1,
                                     std::vector<double> &dataVec2,
                                     const char* keyword){
+    const int params_index1 = ecl_sum_get_general_var_params_index( ecl_sum1 , keyword );
     dataVec1.reserve(ecl_sum_get_data_length(ecl_sum1));
     for (int time_index = 0; time_index < ecl_sum_get_data_length(ecl_sum1); time_index++){
-        dataVec1.push_back(ecl_sum_iget(ecl_sum1, time_index, ecl_sum_get_general_var_params_index( ecl_sum1 , keyword )));
+        dataVec1.push_back(ecl_sum_iget(ecl_sum1, time_index, params_index1));
     }
+    const int params_index2 = ecl_sum_get_general_var_params_index( ecl_sum2 , keyword );
     dataVec2.reserve(ecl_sum_get_data_length(ecl_sum2));
     for (int time_index = 0; time_index < ecl_sum_get_data_length(ecl_sum2); time_index++){
-
-        dataVec2.push_back(ecl_sum_iget(ecl_sum2, time_index, ecl_sum_get_general_var_params_index( ecl_sum2 , keyword )));
+        dataVec2.push_back(ecl_sum_iget(ecl_sum2, time_index, params_index2));
     }
 }
 
@@ -133,27 +136,20 @@ void SummaryComparator::chooseReference(const std::vector<double>& timeVec1,
 
 
 void SummaryComparator::getDeviation(size_t refIndex, size_t &checkIndex, Deviation &dev){
+    while((*referenceVec)[refIndex] > (*checkVec)[checkIndex] && checkIndex + 1 < checkVec->size()){
+        checkIndex++;
+    }
     if((*referenceVec)[refIndex] == (*checkVec)[checkIndex]){
         dev = SummaryComparator::calculateDeviations((*referenceDataVec)[refIndex], (*checkDataVec)[checkIndex]);
-        checkIndex++;
-        return;
     }
-    else if((*referenceVec)[refIndex]<(*checkVec)[checkIndex]){
+    else{
         double value = SummaryComparator::unitStep((*checkDataVec)[checkIndex]);
         /*Must be a little careful here. Flow writes out old value first,
           than changes value. Say there should be a change in production rate from A to B at timestep 300.
           Then the data of time step 300 is A and the next timestep will have value B. Must use the upper limit. */
         dev = SummaryComparator::calculateDeviations((*referenceDataVec)[refIndex], value);
-        checkIndex++;
-        return;
-    }
-    else{
-        checkIndex++;
-        getDeviation(refIndex, checkIndex , dev);
-    }
-    if(checkIndex == checkVec->size() -1 ){
-        return;
     }
+    checkIndex++;
 }
 
 
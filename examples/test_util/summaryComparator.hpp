@@ -26,6 +26,7 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <set>
 #include <string>
 
 
@@ -61,6 +62,7 @@ class SummaryComparator {
         stringlist_type* keys2                 = nullptr; //!< For storing all the keywords of file2
         stringlist_type * keysShort            = nullptr; //!< For keeping track of the file with most/fewest keywords
         stringlist_type * keysLong             = nullptr; //!< For keeping track of the file with most/fewest keywords
+        std::set<std::string> keysLongSet; //!< The keywords of #keysLong, for lookup.
         const std::vector<double> * referenceVec     = nullptr; //!< For storing the values of each time step for the file containing the fewer time steps.
         const std::vector<double> * referenceDataVec = nullptr; //!< For storing the data corresponding to each time step for the file containing the fewer time steps.
         const std::vector<double> * checkVec         = nullptr; //!< For storing the values of each time step for the file containing the more time steps.
@@ -75,7 +77,7 @@ class SummaryComparator {
         //! \param[in] refIndex Index in reference data
         //! \param[in] checkindex Index in data to be checked.
         //! \param[out] dev Holds the result from the comparison on return.
-        //! \details Uses the #referenceVec as basis, and checks its values against the values in #checkDataVec. The function is reccursive, and will update the iterative index j of the #checkVec until #checkVec[j] >= #referenceVec[i]. \n When #referenceVec and #checkVec have the same time value (i.e. #referenceVec[i] == #checkVec[j]) a direct comparison is used, \n when this is not the case, when #referenceVec[i] do not excist as an element in #checkVec, a value is generated, either by the principle of unit step or by interpolation.
+        //! \details Uses the #referenceVec as basis, and checks its values against the values in #checkDataVec. The iterative index j of the #checkVec is advanced until #checkVec[j] >= #referenceVec[i], or to the last element of #checkVec. \n When #referenceVec and #checkVec have the same time value (i.e. #referenceVec[i] == #checkVec[j]) a direct comparison is used, \n when this is not the case, when #referenceVec[i] do not excist as an element in #checkVec, a value is generated, either by the principle of unit step or by interpolation.
         void getDeviation(size_t refIndex, size_t &checkIndex, Deviation &dev);
 
         //! \brief Figure out which data file contains the most / less timesteps and assign member variable pointers accordingly.
@@ -108,6 +110,9 @@ class SummaryComparator {
                              const std::vector<double> &dataVec1,
                              const std::vector<double> &dataVec2);
 
+        //! \brief Returns true if the keyword is one of the keywords of #keysLong.
+        bool inKeysLong(const char* keyword) const { return keysLongSet.count(keyword) > 0; }
+
         //! \brief Returns the relative tolerance.
         double getRelTolerance(){return this->relativeTolerance;}
 
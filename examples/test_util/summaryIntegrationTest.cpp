@@ -55,26 +55,19 @@ void SummaryIntegrationTest::getIntegrationTest(){
                 continue;
             }
         }
-        for (int jvar = 0; jvar < stringlist_get_size(keysLong); jvar++){
-
-            if (strcmp(keyword, stringlist_iget(keysLong, jvar)) == 0){ //When the keywords are equal, proceed in comparing summary files.
-                /*	if(!checkUnits(keyword)){
-                    OPM_THROW(std::runtime_error, "For keyword " << keyword << " the unit of the two files is not equal. Not possible to compare.");
-                    } //Comparing the unit of the two vectors.*/
-                checkForKeyword(timeVec1, timeVec2, keyword);
-                if(findVectorWithGreatestErrorRatio){
-                    WellProductionVolume volume = getSpecificWellVolume(timeVec1,timeVec2, keyword);
-                    findGreatestErrorRatio(volume,greatestRatio, keyword, keywordWithGreatestErrorRatio);
-                }
-                break;
-            }
-            //will only enter here if no keyword match
-            if(jvar == stringlist_get_size(keysLong)-1){
-                if(!allowDifferentAmountOfKeywords){
-                    OPM_THROW(std::invalid_argument, "No match on keyword");
-                }
+        if (inKeysLong(keyword)){ //When the keywords are equal, proceed in comparing summary files.
+            /*	if(!checkUnits(keyword)){
+                OPM_THROW(std::runtime_error, "For keyword " << keyword << " the unit of the two files is not equal. Not possible to compare.");
+                } //Comparing the unit of the two vectors.*/
+            checkForKeyword(timeVec1, timeVec2, keyword);
+            if(findVectorWithGreatestErrorRatio){
+                WellProductionVolume volume = getSpecificWellVolume(timeVec1,timeVec2, keyword);
+                findGreatestErrorRatio(volume,greatestRatio, keyword, keywordWithGreatestErrorRatio);
             }
         }
+        else if(!allowDifferentAmountOfKeywords){
+            OPM_THROW(std::invalid_argument, "No match on keyword");
+        }
         ivar++;
     }
     if(findVectorWithGreatestErrorRatio){
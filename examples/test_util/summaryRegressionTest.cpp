@@ -58,19 +58,13 @@ void SummaryRegressionTest::getRegressionTest(){
     while(ivar < stringlist_get_size(keysShort)){
         const char* keyword = stringlist_iget(keysShort, ivar);
         std::string keywordString(keyword);
-        for (int jvar = 0; jvar < stringlist_get_size(keysLong); jvar++){
-            if (strcmp(keyword, stringlist_iget(keysLong, jvar)) == 0){ //When the keywords are equal, proceed in comparing summary files.
-                if (isRestartFile && keywordString.substr(3,1)=="T"){
-                    break;
-                }
-                throwAtEnd |= !checkForKeyword(timeVec1, timeVec2, keyword);
-                break;
-            }
-            //will only enter here if no keyword match
-            if(jvar == stringlist_get_size(keysLong)-1){
-                std::cout << "Could not find keyword: " << stringlist_iget(keysShort, ivar) << std::endl;
-                OPM_THROW(std::runtime_error, "No match on keyword");
-            }
+        if (!inKeysLong(keyword)){
+            std::cout << "Could not find keyword: " << keyword << std::endl;
+            OPM_THROW(std::runtime_error, "No match on keyword");
+        }
+        //When the keywords are equal, proceed in comparing summary files.
+        if (!(isRestartFile && keywordString.substr(3,1)=="T")){
+            throwAtEnd |= !checkForKeyword(timeVec1, timeVec2, keyword);
         }
         ivar++;
     }
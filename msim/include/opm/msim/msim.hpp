@@ -4,12 +4,14 @@
 #include <functional>
 #include <string>
 #include <map>
+#include <vector>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
@@ -26,11 +28,30 @@ public:
     using well_rate_function = double(const EclipseState&, const Schedule&, const data::Solution&, size_t report_step, double seconds_elapsed);
     using solution_function = void(const EclipseState&, const Schedule&, data::Solution&, size_t report_step, double seconds_elapsed);
 
+    /*
+      Batched callbacks: a well_rates_function fills in one rate for all
+      the wells it was registered for, rates[i] being the rate of the
+      i'th well, and a field_function the values of one solution field
+      for all the active cells. The field is inserted by msim, so the
+      callback writes directly into the solution.
+    */
+    using well_rates_function = void(const EclipseState&, const Schedule&, const data::Solution&, size_t report_step, double seconds_elapsed, double* rates);
+    using field_function = void(const EclipseState&, const Schedule&, size_t report_step, double seconds_elapsed, std::vector<double>& values);
+
     msim(const std::string& deck_file);
     msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context);
 
     void well_rate(const std::string& well, data::Rates::opt rate, std::function<well_rate_function> func);
+    void well_rate(const std::vector<std::string>& wells, data::Rates::opt rate, std::function<well_rates_function> func);
     void solution(const std::string& field, std::function<solution_function> func);
+    void solution(const std::string& field, UnitSystem::measure dim, std::function<field_function> func);
+
+    /*
+      Split every report step in this number of equal ministeps; by
+      default the ministeps are at most one week and at most half the
+      report step.
+    */
+    void ministeps(std::size_t count);
     void run();
 private:
 
@@ -46,6 +67,22 @@ private:
 
     std::map<std::string, std::map<data::Rates::opt, std::function<well_rate_function>>> well_rates;
     std::map<std::string, std::function<solution_function>> solutions;
+
+    struct batched_well_rates {
+        std::vector<std::string> wells;
+        data::Rates::opt rate;
+        std::function<well_rates_function> func;
+    };
+
+    struct field {
+        std::string name;
+        UnitSystem::measure dim;
+        std::function<field_function> func;
+    };
+
+    std::vector<batched_well_rates> batched_rates;
+    std::vector<field> fields;
+    std::size_t num_ministeps = 0;
 };
 }
 
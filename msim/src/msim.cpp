@@ -52,7 +52,11 @@ void msim::run() {
 
     io.writeInitial();
     for (size_t report_step = 1; report_step < this->schedule.size(); report_step++) {
-        double time_step = std::min(week, 0.5*this->schedule.stepLength(report_step - 1));
+        const double step_length = this->schedule.stepLength(report_step - 1);
+        double time_step = std::min(week, 0.5*step_length);
+        if (this->num_ministeps > 0)
+            time_step = step_length / this->num_ministeps;
+
         run_step(sol, well_data, report_step, time_step, io);
     }
 }
@@ -70,7 +74,8 @@ void msim::run_step(data::Solution& sol, data::Wells& well_data, size_t report_s
 
     while (seconds_elapsed < end_time) {
         double time_step = dt;
-        if ((seconds_elapsed + time_step) > end_time)
+        // Round off must not leave a tiny extra ministep at the end.
+        if ((seconds_elapsed + time_step * (1 + 1e-6)) >= end_time)
             time_step = end_time - seconds_elapsed;
 
         this->simulate(sol, well_data, report_step, seconds_elapsed, time_step);
@@ -90,7 +95,7 @@ void msim::run_step(data::Solution& sol, data::Wells& well_data, size_t report_s
 void msim::output(size_t report_step, bool substep, double seconds_elapsed, const data::Solution& sol, const data::Wells& well_data, EclipseIO& io) const {
     RestartValue value(sol, well_data);
     io.writeTimeStep(report_step,
-                     false,
+                     substep,
                      seconds_elapsed,
                      value,
                      {},
@@ -100,20 +105,56 @@ void msim::output(size_t report_step, bool substep, double seconds_elapsed, cons
 
 
 void msim::simulate(data::Solution& sol, data::Wells& well_data, size_t report_step, double seconds_elapsed, double time_step) const {
-    for (const auto& sol_pair : this->solutions) {
-        auto func = sol_pair.second;
-        func(this->state, this->schedule, sol, report_step, seconds_elapsed + time_step);
+    const double time = seconds_elapsed + time_step;
+    const auto& grid = this->state.getInputGrid();
+
+    for (const auto& sol_pair : this->solutions)
+        sol_pair.second(this->state, this->schedule, sol, report_step, time);
+
+    for (const auto& field : this->fields) {
+        if (!sol.has(field.name))
+            sol.insert(field.name, field.dim, std::vector<double>(grid.getNumActive()), data::TargetType::RESTART_SOLUTION);
+
+        field.func(this->state, this->schedule, report_step, time, sol.data(field.name));
     }
 
     for (const auto& well_pair : this->well_rates) {
-        const std::string& well_name = well_pair.first;
-        data::Well& well = well_data[well_name];
-        for (const auto& rate_pair : well_pair.second) {
-            auto rate = rate_pair.first;
-            auto func = rate_pair.second;
+        data::Well& well = well_data[well_pair.first];
+        for (const auto& rate_pair : well_pair.second)
+            well.rates.set(rate_pair.first, rate_pair.second(this->state, this->schedule, sol, report_step, time));
+    }
+
+    std::vector<double> rates;
+    for (const auto& batch : this->batched_rates) {
+        rates.assign(batch.wells.size(), 0);
+        batch.func(this->state, this->schedule, sol, report_step, time, rates.data());
+        for (size_t index = 0; index < batch.wells.size(); index++)
+            well_data[batch.wells[index]].rates.set(batch.rate, rates[index]);
+    }
 
-            well.rates.set(rate, func(this->state, this->schedule, sol, report_step, seconds_elapsed + time_step));
+    /*
+      One connection per open grid cell of the wells, with the pressure
+      of the cell; this is what the RFT output needs.
+    */
+    const std::vector<double>* pressure = sol.has("PRESSURE") ? &sol.data("PRESSURE") : nullptr;
+    for (auto& well_pair : well_data) {
+        if (!this->schedule.hasWell(well_pair.first))
+            continue;
+
+        data::Well& well = well_pair.second;
+        const auto& connections = this->schedule.getWell(well_pair.first)->getConnections(report_step);
+        well.connections.clear();
+        for (const auto& connection : connections) {
+            const size_t global_index = grid.getGlobalIndex(connection.getI(), connection.getJ(), connection.getK());
+            data::Connection conn_data {};
+            conn_data.index = global_index;
+            if (pressure && grid.cellActive(global_index)) {
+                conn_data.cell_pressure = (*pressure)[grid.activeIndex(global_index)];
+                conn_data.pressure = conn_data.cell_pressure;
+            }
+            well.connections.push_back(conn_data);
         }
+        well.index_connections();
     }
 }
 
@@ -128,6 +169,21 @@ void msim::solution(const std::string& field, std::function<solution_function> f
 }
 
 
+void msim::well_rate(const std::vector<std::string>& wells, data::Rates::opt rate, std::function<well_rates_function> func) {
+    this->batched_rates.push_back({wells, rate, func});
+}
+
+
+void msim::solution(const std::string& field, UnitSystem::measure dim, std::function<field_function> func) {
+    this->fields.push_back({field, dim, func});
+}
+
+
+void msim::ministeps(std::size_t count) {
+    this->num_ministeps = count;
+}
+
+
 }
 
 
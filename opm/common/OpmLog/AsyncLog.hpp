@@ -0,0 +1,102 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ASYNCLOG_HPP
+#define OPM_ASYNCLOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opm/common/OpmLog/LogBackend.hpp>
+
+namespace Opm {
+
+/*!
+ * \brief Log backend which hands the messages over to another backend on
+ *        a background thread.
+ *
+ * The calling thread only copies the message into a slot of a bounded
+ * lock-free queue, the formatting and the I/O of the wrapped backend are
+ * done by the background thread. The slots keep the capacity of their
+ * strings, so for messages of ordinary length enqueueing does not
+ * allocate. When the queue is full the calling thread waits for a free
+ * slot; no message is dropped. The background thread sleeps while the
+ * queue is empty.
+ *
+ * The message mask and the message limiter of the AsyncLog are applied
+ * before a message is enqueued, so a message which is masked out or over
+ * its tag limit costs nothing more. The message formatter should be set
+ * on the wrapped backend, which must not have a limiter of its own and
+ * must not be used directly while wrapped.
+ *
+ * The messages are passed on in the order they were enqueued. flush()
+ * waits until every message enqueued before the call has been passed on,
+ * and the destructor passes on all the remaining messages.
+ */
+class AsyncLog : public LogBackend
+{
+public:
+    explicit AsyncLog(std::shared_ptr<LogBackend> sink, std::size_t capacity = 1024);
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    void flush();
+
+    std::shared_ptr<LogBackend> sink() const;
+
+protected:
+    void addMessageUnconditionally(int64_t messageFlag, const std::string& message) override;
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        int64_t flag;
+        std::string message;
+    };
+
+    void run();
+
+    std::shared_ptr<LogBackend> m_sink;
+    std::size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+
+    std::atomic<std::size_t> m_enqueue_pos;
+    std::atomic<std::size_t> m_dequeue_pos;
+    std::atomic<bool> m_stop;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_drained;
+    std::atomic<bool> m_sleeping;
+    std::atomic<std::size_t> m_flush_waiters;
+
+    std::thread m_thread;
+};
+
+} // namespace Opm
+
+#endif
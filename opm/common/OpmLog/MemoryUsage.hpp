@@ -0,0 +1,100 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_MEMORYUSAGE_HPP
+#define OPM_MEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Estimated memory use of the large input and output data structures,
+  as a tree of named parts with sizes in bytes. The classes return
+  their breakdown from memory_usage(); the estimates add the size of
+  the objects to the capacity of the containers they own. Memory held
+  by libecl, allocator overhead and the bookkeeping of the nodes of the
+  associative containers are not counted, and data shared between
+  objects - e.g. grid properties after COPY - is counted for every
+  owner.
+
+  The breakdown can be logged after each phase of the input
+  processing; the reporting is disabled by default, in which case
+  log() does nothing and the breakdown is not computed:
+
+     MemoryUsage::enable();
+     ...
+     if (MemoryUsage::enabled())
+         MemoryUsage::log(deck.memory_usage());
+
+  The report goes to OpmLog as a Note message.
+*/
+
+struct MemoryUsage {
+    std::string name;
+    std::size_t bytes = 0;
+    std::vector<MemoryUsage> children;
+
+    MemoryUsage() = default;
+    explicit MemoryUsage(const std::string& name, std::size_t bytes = 0);
+
+    /* The bytes of this part and all the parts below it. */
+    std::size_t total() const;
+
+    /* Returns nullptr if there is no child with this name. */
+    const MemoryUsage* child(const std::string& name) const;
+
+    /* Appends a child; returns a reference to it. */
+    MemoryUsage& add(MemoryUsage child);
+    MemoryUsage& add(const std::string& name, std::size_t bytes);
+
+    /*
+      Adds the bytes of a part to the child with the same name, and its
+      children recursively, or appends it if there is no such child;
+      used to sum up many similar objects, e.g. all the wells.
+    */
+    MemoryUsage& accumulate(const MemoryUsage& part);
+
+    /* Orders the children, recursively, with the largest total first. */
+    void sort();
+
+    void write(std::ostream& os) const;
+
+    static void enable(bool on = true);
+    static bool enabled();
+    static void log(const MemoryUsage& usage);
+
+    /* The heap storage of a container or string. */
+    template <typename T>
+    static std::size_t heap(const std::vector<T>& values) {
+        return values.capacity() * sizeof(T);
+    }
+
+    static std::size_t heap(const std::vector<bool>& values);
+    static std::size_t heap(const std::string& value);
+    static std::size_t heap(const std::vector<std::string>& values);
+    static std::size_t heap(const std::set<std::string>& values);
+};
+
+} // namespace Opm
+
+#endif
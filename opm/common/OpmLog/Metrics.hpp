@@ -0,0 +1,128 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_METRICS_HPP
+#define OPM_METRICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <opm/common/OpmLog/StreamLog.hpp>
+
+namespace Opm {
+
+/*
+  Process wide counters, gauges and histograms for services which parse
+  and write many cases over a long time. Unlike the PhaseTimer tree,
+  which is reported once per run, the metrics are flat, keep growing
+  until reset() and are meant to be pulled periodically by an exporter:
+
+     Metrics::enable();
+     ...
+     const auto snapshot = Metrics::snapshot();
+     Metrics::writePrometheus(std::cout);
+
+  While enabled, every PhaseTimer::Scope adds its duration to the
+  histogram "<phase> seconds", PhaseTimer::count() adds to the counter
+  of the same name, the output queue of EclipseIO is reported as the
+  gauge "output queue" and MemoryUsage::log() reports the total of the
+  breakdown as the gauge "memory <name>". The metrics are disabled by
+  default, in which case the calls are a single atomic load.
+
+  Counters and histograms are kept per thread, like the PhaseTimer
+  phases, so updates only take the uncontended lock of the calling
+  thread; a snapshot merges the threads. A gauge is a single value
+  with the maximum it has had, e.g. the high water mark of a queue.
+*/
+
+class Metrics {
+public:
+    struct Gauge {
+        double value = 0;
+        double max = 0;
+    };
+
+    /*
+      The buckets have fixed upper bounds, the powers of four from 2^-20
+      to 2^40, which covers both seconds and bytes; counts[i] is the
+      number of values in (bounds[i-1], bounds[i]], and the last count
+      is for the values above the last bound.
+    */
+    struct Histogram {
+        std::vector<double> bounds;
+        std::vector<std::uint64_t> counts;
+        std::uint64_t count = 0;
+        double sum = 0;
+    };
+
+    struct Snapshot {
+        std::map<std::string, int64_t> counters;
+        std::map<std::string, Gauge> gauges;
+        std::map<std::string, Histogram> histograms;
+    };
+
+    static void enable(bool on = true);
+    static bool enabled();
+
+    static void count(const std::string& name, int64_t increment = 1);
+    static void gauge(const std::string& name, double value);
+    static void observe(const std::string& name, double value);
+
+    static Snapshot snapshot();
+    static void reset();
+
+    /*
+      The Prometheus text format; the names are prefixed with "opm_"
+      and all characters other than letters and digits replaced with
+      '_', histograms are written with cumulative buckets.
+    */
+    static void writePrometheus(std::ostream& os);
+};
+
+
+/*
+  Log backend which writes the metrics in the Prometheus text format
+  when it receives a MetricsReport message, e.g. to a file scraped by
+  the node exporter. The message type must be registered with the
+  logger before use:
+
+     OpmLog::addMessageType(MetricsLog::MetricsReport, "metrics");
+     OpmLog::addBackend("METRICS", std::make_shared<MetricsLog>("opm.prom"));
+     ...
+     OpmLog::addMessage(MetricsLog::MetricsReport, "");
+*/
+
+class MetricsLog : public StreamLog {
+public:
+    static const int64_t MetricsReport = 32768;
+
+    explicit MetricsLog(const std::string& logFile);
+    explicit MetricsLog(std::ostream& os);
+
+protected:
+    void addMessageUnconditionally(int64_t messageFlag,
+                                   const std::string& message) override;
+};
+
+} // namespace Opm
+
+#endif
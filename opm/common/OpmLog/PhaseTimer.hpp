@@ -0,0 +1,134 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PHASETIMER_HPP
+#define OPM_PHASETIMER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <opm/common/OpmLog/StreamLog.hpp>
+
+namespace Opm {
+
+/*
+  Hierarchical timers and counters for the named phases of the input
+  processing and the output, e.g. parsing, grid construction and
+  restart output. A phase is timed by a PhaseTimer::Scope object living
+  for the duration of the phase; scopes opened while another scope is
+  alive on the same thread become children of that phase. Counters
+  are attached to the innermost open phase of the calling thread.
+
+  The timings are aggregated per thread by phase path, so repeated
+  phases only cost a lookup among the children of the current phase
+  and no global synchronisation. The instrumentation is disabled by
+  default, in which case a Scope is a single atomic load. When the
+  trace is enabled every completed scope is recorded in addition, and
+  can be written in the Chrome trace event format for chrome://tracing
+  or the Perfetto UI.
+
+  The report merges the threads: the phases of all threads are merged
+  by path, i.e. phases run on worker threads appear at the top level
+  and their times add up to the CPU time spent in them.
+*/
+
+class PhaseTimer {
+public:
+    struct Node {
+        std::string name;
+        std::size_t calls = 0;
+        double seconds = 0;
+        std::map<std::string, int64_t> counters;
+        std::vector<Node> children;
+
+        /* Returns nullptr if there is no child with this name. */
+        const Node* child(const std::string& name) const;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(const std::string& name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        bool active;
+
+        /* The histogram of the phase when the Metrics are enabled. */
+        std::string metric;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static void enable(bool on = true);
+    static bool enabled();
+    static void enableTrace(bool on = true);
+
+    static void count(const std::string& name, int64_t increment = 1);
+
+    /*
+      The unnamed root of the merged phase tree; the counters added
+      outside of any phase are attached to the root.
+    */
+    static Node report();
+
+    /*
+      Zeroes all timings, counters and recorded trace events; scopes
+      which are open while reset() is called are still completed.
+    */
+    static void reset();
+
+    static void writeTree(std::ostream& os);
+    static void writeJSON(std::ostream& os);
+    static void writeChromeTrace(std::ostream& os);
+};
+
+
+/*
+  Log backend which writes the phase tree when it receives a
+  PhaseReport message; the message text is written as the heading of
+  the report. The PhaseReport message type must be registered with the
+  logger before use:
+
+     OpmLog::addMessageType(PhaseTimerLog::PhaseReport, "phases");
+     OpmLog::addBackend("PHASES", std::make_shared<PhaseTimerLog>(std::cout));
+     ...
+     OpmLog::addMessage(PhaseTimerLog::PhaseReport, "Input processing");
+*/
+
+class PhaseTimerLog : public StreamLog {
+public:
+    static const int64_t PhaseReport = 16384;
+
+    explicit PhaseTimerLog(const std::string& logFile);
+    explicit PhaseTimerLog(std::ostream& os);
+
+protected:
+    void addMessageUnconditionally(int64_t messageFlag,
+                                   const std::string& message) override;
+};
+
+} // namespace Opm
+
+#endif
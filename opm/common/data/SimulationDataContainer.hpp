@@ -100,6 +100,17 @@ namespace Opm {
         /// values in @values.
         void setCellDataComponent( const std::string& key , size_t component , const std::vector<int>& cells , const std::vector<double>& values);
 
+        /// Will set component nr @component of the field @key in all
+        /// the cells; @values has one element per cell.
+        void setCellDataComponent( const std::string& key , size_t component , const std::vector<double>& values);
+
+        /// The values of component nr @component of the field @key in
+        /// all the cells, as one contiguous vector. The cell data is
+        /// stored with the components of a cell next to each other, this
+        /// gathers one component in a single strided pass, e.g. to pass
+        /// the water saturation on as a field of its own.
+        std::vector<double> getCellDataComponent( const std::string& key , size_t component ) const;
+
         // Direct explicit field access for certain default fields.
         // These methods are all deprecated, and will eventually be moved to
         // concrete subclasses.
@@ -0,0 +1,90 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_FIRST_TOUCH_HPP
+#define OPM_FIRST_TOUCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+/*
+  The pages of an array are placed on the NUMA node of the thread which
+  writes them first. The large per cell arrays - the grid properties,
+  the grid geometry and the SimulationDataContainer fields - are
+  created through make(), which lets every OpenMP thread write its own
+  part of the array first, so that a simulator which works on the same
+  parts of the cells on the same threads finds its data on the local
+  node.
+
+  The arrays are still plain std::vector: the vector is zero filled by
+  the calling thread as usual, then, on Linux, the whole pages inside it
+  are handed back to the kernel with madvise(MADV_DONTNEED), which for
+  the anonymous memory of the heap means they read as zero again and
+  are placed on the next write. With huge pages enabled the range is
+  also marked MADV_HUGEPAGE for transparent huge pages.
+
+  The policy is disabled by default, make() is then the same as the
+  std::vector constructor. The partition is the offsets of the parts,
+  starting with zero and ending with the number of cells, the part
+  number i goes to OpenMP thread number i; an array with k values per
+  cell is split at k times the offsets. Arrays of any other size, and
+  all arrays without a partition, are split in equal contiguous parts
+  like an OpenMP loop with the static schedule.
+
+     FirstTouch::setPartition( offsets );
+     FirstTouch::enable();
+     EclipseState es( deck, parseContext );
+*/
+
+class FirstTouch {
+public:
+    static void enable(bool on = true);
+    static bool enabled();
+    static void enableHugePages(bool on = true);
+    static void setPartition(const std::vector<std::size_t>& offsets);
+
+    template <typename T>
+    static std::vector<T> make(std::size_t size, const T& value = T()) {
+        static_assert(std::is_arithmetic<T>::value, "FirstTouch::make() is for arrays of numbers");
+
+        if (!enabled() || size * sizeof(T) < min_bytes)
+            return std::vector<T>(size, value);
+
+        std::vector<T> data(size);
+        releasePages(data.data(), size * sizeof(T));
+        forEachPart(size, [&data, &value](std::size_t begin, std::size_t end) {
+            std::fill(data.begin() + begin, data.begin() + end, value);
+        });
+        return data;
+    }
+
+private:
+    static const std::size_t min_bytes = 1 << 21;
+
+    static void releasePages(void* data, std::size_t bytes);
+    static void forEachPart(std::size_t size, const std::function<void(std::size_t, std::size_t)>& op);
+};
+
+} // namespace Opm
+
+#endif
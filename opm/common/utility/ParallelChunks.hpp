@@ -0,0 +1,113 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PARALLEL_CHUNKS_HPP
+#define OPM_PARALLEL_CHUNKS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Splits the positions [0, size) in contiguous ranges [first, last), at
+  most one per hardware thread and with at least minPerChunk positions
+  in each. Work which is too small to pay for starting the threads is a
+  single range.
+*/
+inline std::vector< std::pair< std::size_t, std::size_t > >
+chunkRanges( std::size_t size, std::size_t minPerChunk ) {
+    const std::size_t numThreads =
+        std::max( std::size_t{ 1 }, std::size_t{ std::thread::hardware_concurrency() } );
+
+    const std::size_t numChunks = std::min( numThreads,
+        (size + minPerChunk - 1) / std::max( std::size_t{ 1 }, minPerChunk ) );
+
+    if( numChunks < 2 )
+        return { { 0, size } };
+
+    const std::size_t chunkSize = (size + numChunks - 1) / numChunks;
+
+    std::vector< std::pair< std::size_t, std::size_t > > ranges;
+    for( std::size_t first = 0; first < size; first += chunkSize )
+        ranges.emplace_back( first, std::min( size, first + chunkSize ) );
+
+    return ranges;
+}
+
+/*
+  Calls op( chunk, first, last ) for every range of ranges, the first
+  one on the calling thread and the others concurrently on threads of
+  their own; chunk is the position of the range. The ranges must be
+  independent of each other. Returns when all the ranges are done, and
+  then rethrows the exception of the first range which failed.
+*/
+template< class Op >
+void forEachChunk( const std::vector< std::pair< std::size_t, std::size_t > >& ranges, Op&& op ) {
+    if( ranges.empty() )
+        return;
+
+    std::vector< std::future< void > > chunks;
+    for( std::size_t chunk = 1; chunk < ranges.size(); ++chunk ) {
+        const auto range = ranges[ chunk ];
+        chunks.push_back( std::async( std::launch::async, [&op, chunk, range]() {
+            op( chunk, range.first, range.second );
+        } ) );
+    }
+
+    std::exception_ptr error;
+    try {
+        op( std::size_t{ 0 }, ranges[ 0 ].first, ranges[ 0 ].second );
+    } catch( ... ) {
+        error = std::current_exception();
+    }
+
+    for( auto& chunk : chunks ) {
+        try {
+            chunk.get();
+        } catch( ... ) {
+            if( !error )
+                error = std::current_exception();
+        }
+    }
+
+    if( error )
+        std::rethrow_exception( error );
+}
+
+/*
+  Calls op( pos ) for every position in [0, size), in the ranges of
+  chunkRanges( size, minPerChunk ).
+*/
+template< class Op >
+void forEachPosition( std::size_t size, std::size_t minPerChunk, Op&& op ) {
+    forEachChunk( chunkRanges( size, minPerChunk ),
+                  [&op]( std::size_t, std::size_t first, std::size_t last ) {
+        for( std::size_t pos = first; pos < last; ++pos )
+            op( pos );
+    } );
+}
+
+}
+
+#endif
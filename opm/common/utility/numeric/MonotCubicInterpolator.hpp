@@ -3,6 +3,7 @@
 #ifndef _MONOTCUBICINTERPOLATOR_H
 #define _MONOTCUBICINTERPOLATOR_H
 
+#include <cstddef>
 #include <vector>
 #include <map>
 #include <string>
@@ -227,6 +228,32 @@ class MonotCubicInterpolator {
    */
    double evaluate(double x, double & errorestimate_output ) const ;
 
+   /**
+      @param x array of n x values
+      @param f output array of n function values
+      @param n number of values
+
+      Evaluates f(x) for all the x values in one call, with the same
+      interpolation and extrapolation as evaluate(double).
+
+      The data points and derivatives are copied into contiguous arrays
+      once per call, and the interval search starts from the interval of
+      the previous x value. Input sorted in increasing order, which is
+      typical when tabulating a function, is then evaluated without any
+      binary search. Unsorted input is evaluated correctly, but falls
+      back to a binary search whenever x decreases.
+   */
+   void evaluate(const double* x, double* f, std::size_t n) const;
+
+   /**
+      @param x x values
+
+      Vector version of evaluate(const double*, double*, std::size_t).
+
+      @return f(x) for all the given x values
+   */
+   std::vector<double> evaluate(const std::vector<double>& x) const;
+
    /**
       Minimum x-value, returns both x and f in a pair.
 
@@ -71,6 +71,23 @@ namespace Opm
         /// @return f'(x)
         double derivative(const double x) const;
 
+        /// @brief Evaluate the values at an array of x values.
+        ///        Gives the same values as operator() for every x, but
+        ///        the interval search starts from the interval of the
+        ///        previous x, which avoids the binary search for
+        ///        increasing x values.
+        /// @param x array of domain values
+        /// @param y array of num values, f(x)
+        /// @param num the number of values
+        void evaluate(const double* x, double* y, int num) const;
+
+        /// @brief Evaluate the derivatives at an array of x values,
+        ///        as evaluate() for derivative().
+        /// @param x array of domain values
+        /// @param dy array of num values, f'(x)
+        /// @param num the number of values
+        void derivative(const double* x, double* dy, int num) const;
+
         /// @brief Evaluate the inverse at y. Requires T to be a double.
         /// @param y a range value
         /// @return f^{-1}(y)
@@ -175,6 +192,33 @@ namespace Opm
         return Opm::linearInterpolationDerivative(x_values_, y_values_, x);
     }
 
+    template<typename T>
+    inline void
+    NonuniformTableLinear<T>
+    ::evaluate(const double* x, double* y, int num) const
+    {
+        int ix1 = 0;
+        for (int i = 0; i < num; ++i) {
+            ix1 = Opm::tableIndex(x_values_, x[i], ix1);
+            const int ix2 = ix1 + 1;
+            y[i] = (y_values_[ix2] - y_values_[ix1])/(x_values_[ix2] - x_values_[ix1])*(x[i] - x_values_[ix1])
+                + y_values_[ix1];
+        }
+    }
+
+    template<typename T>
+    inline void
+    NonuniformTableLinear<T>
+    ::derivative(const double* x, double* dy, int num) const
+    {
+        int ix1 = 0;
+        for (int i = 0; i < num; ++i) {
+            ix1 = Opm::tableIndex(x_values_, x[i], ix1);
+            const int ix2 = ix1 + 1;
+            dy[i] = (y_values_[ix2] - y_values_[ix1])/(x_values_[ix2] - x_values_[ix1]);
+        }
+    }
+
     template<typename T>
     inline double
     NonuniformTableLinear<T>
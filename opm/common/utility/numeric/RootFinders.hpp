@@ -42,6 +42,7 @@
 #include <limits>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace Opm
 {
@@ -280,6 +281,125 @@ namespace Opm
         }
 
 
+        /// Iteration statistics of one call to solveBatch().
+        struct BatchStatistics
+        {
+            int lanes = 0;
+            int rounds = 0;            // batched evaluations in the iteration
+            int max_iterations = 0;    // most iterations of any lane
+            long total_iterations = 0;
+            int bracketing_failures = 0;
+            int iteration_failures = 0;
+        };
+
+
+        /// The method of solve(f, a, b, ...) applied to n equations at
+        /// once. Lane i solves for the zero in [a[i], b[i]], and the
+        /// result is stored in x[i]. The functor evaluates all lanes in
+        /// one call,
+        ///
+        ///     f(n, xs, fs)   sets fs[i] to the value of equation i at xs[i],
+        ///
+        /// so it can be a vectorised loop. The lanes iterate in
+        /// lock-step; a converged lane is still evaluated, at its
+        /// result, until all the lanes have converged. Failures are
+        /// handled by the ErrorPolicy per lane, as in solve().
+        template <class BatchFunctor>
+        inline static void solveBatch(const BatchFunctor& f,
+                                      const int n,
+                                      const double* a,
+                                      const double* b,
+                                      const int max_iter,
+                                      const double tolerance,
+                                      double* x,
+                                      BatchStatistics& stats)
+        {
+            using namespace std;
+            const double macheps = numeric_limits<double>::epsilon();
+
+            stats = BatchStatistics();
+            stats.lanes = n;
+
+            vector<double> x0(a, a + n), x1(b, b + n);
+            vector<double> f0(n), f1(n), xnew(n), fnew(n);
+            vector<double> eps(n), epsF(n);
+            vector<int> iterations(n, 0);
+            vector<char> active(n, 1);
+
+            f(n, x0.data(), f0.data());
+            f(n, x1.data(), f1.data());
+
+            int num_active = 0;
+            for (int i = 0; i < n; ++i) {
+                eps[i] = tolerance + macheps*max(max(fabs(a[i]), fabs(b[i])), 1.0);
+                epsF[i] = tolerance + macheps*max(fabs(f0[i]), 1.0);
+                if (fabs(f0[i]) < epsF[i]) {
+                    x[i] = x0[i];
+                } else if (fabs(f1[i]) < epsF[i]) {
+                    x[i] = x1[i];
+                } else if (f0[i]*f1[i] > 0.0) {
+                    ++stats.bracketing_failures;
+                    x[i] = ErrorPolicy::handleBracketingFailure(a[i], b[i], f0[i], f1[i]);
+                } else {
+                    ++num_active;
+                    continue;
+                }
+                active[i] = 0;
+            }
+
+            while (num_active > 0) {
+                for (int i = 0; i < n; ++i) {
+                    if (active[i] && !(fabs(x1[i] - x0[i]) >= 1e-9*eps[i])) {
+                        x[i] = 0.5*(x0[i] + x1[i]);
+                        active[i] = 0;
+                        --num_active;
+                    }
+                    xnew[i] = active[i] ? regulaFalsiStep(x0[i], x1[i], f0[i], f1[i]) : x[i];
+                }
+                if (num_active == 0) {
+                    break;
+                }
+
+                f(n, xnew.data(), fnew.data());
+                ++stats.rounds;
+
+                for (int i = 0; i < n; ++i) {
+                    if (!active[i]) {
+                        continue;
+                    }
+                    ++iterations[i];
+                    if (iterations[i] > max_iter) {
+                        ++stats.iteration_failures;
+                        x[i] = ErrorPolicy::handleTooManyIterations(x0[i], x1[i], max_iter);
+                        active[i] = 0;
+                        --num_active;
+                        continue;
+                    }
+                    if (fabs(fnew[i]) < epsF[i]) {
+                        x[i] = xnew[i];
+                        active[i] = 0;
+                        --num_active;
+                        continue;
+                    }
+                    // The 'Pegasus' update, as in solve().
+                    if ((fnew[i] > 0.0) == (f0[i] > 0.0)) {
+                        x0[i] = x1[i];
+                        f0[i] = f1[i];
+                    } else {
+                        f0[i] *= f1[i]/(f1[i] + fnew[i]);
+                    }
+                    x1[i] = xnew[i];
+                    f1[i] = fnew[i];
+                }
+            }
+
+            for (int i = 0; i < n; ++i) {
+                stats.total_iterations += iterations[i];
+                stats.max_iterations = max(stats.max_iterations, iterations[i]);
+            }
+        }
+
+
     private:
         inline static double regulaFalsiStep(const double a,
                                              const double b,
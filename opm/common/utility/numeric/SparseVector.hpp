@@ -179,6 +179,100 @@ namespace Opm
 	    return indices_[nzindex];
 	}
 
+	/// A SparseVector from elements given in any index order. The
+	/// elements are sorted by index, and the elements with the same
+	/// index are summed into one.
+	template <typename DataIter, typename IntegerIter>
+	static SparseVector fromUnordered(int sz,
+					 DataIter data_beg, DataIter data_end,
+					 IntegerIter index_beg, IntegerIter index_end)
+	{
+	    std::vector<T> data(data_beg, data_end);
+	    std::vector<int> indices(index_beg, index_end);
+	    OPM_ERROR_IF(indices.size() != data.size(), "The number of indices of a SparseVector must equal to the number of entries");
+
+	    std::vector<int> order(indices.size());
+	    std::iota(order.begin(), order.end(), 0);
+	    std::stable_sort(order.begin(), order.end(),
+			     [&indices](int a, int b) { return indices[a] < indices[b]; });
+
+	    SparseVector result(sz);
+	    result.data_.reserve(order.size());
+	    result.indices_.reserve(order.size());
+	    for (const int pos : order) {
+		const int index = indices[pos];
+		if (index < 0 || index >= sz) {
+		    OPM_THROW(std::logic_error, "Error in SparseVector construction, index is out of range.");
+		}
+		if (!result.indices_.empty() && result.indices_.back() == index) {
+		    result.data_.back() += data[pos];
+		} else {
+		    result.data_.push_back(data[pos]);
+		    result.indices_.push_back(index);
+		}
+	    }
+	    return result;
+	}
+
+	/// The dense vector operations below take any random access
+	/// container of at least size() elements. The loops run over
+	/// the nonzero elements only, and are written so that the
+	/// compiler can vectorise them with gather instructions where
+	/// the target has them.
+
+	/// \return the sum of the products of the nonzero elements and
+	/// the elements of dense with the same indices.
+	template <typename DenseVector>
+	T dot(const DenseVector& dense) const
+	{
+	    const int* const ind = indices_.data();
+	    const T* const val = data_.data();
+	    const int nnz = data_.size();
+	    T sum = T();
+	    for (int i = 0; i < nnz; ++i) {
+		sum += val[i] * dense[ind[i]];
+	    }
+	    return sum;
+	}
+
+	/// Adds a times this vector to dense.
+	template <typename DenseVector>
+	void axpy(const T& a, DenseVector& dense) const
+	{
+	    const int* const ind = indices_.data();
+	    const T* const val = data_.data();
+	    const int nnz = data_.size();
+	    for (int i = 0; i < nnz; ++i) {
+		dense[ind[i]] += a * val[i];
+	    }
+	}
+
+	/// Writes the nonzero elements into dense, leaving the other
+	/// elements of dense as they are.
+	template <typename DenseVector>
+	void scatter(DenseVector& dense) const
+	{
+	    const int* const ind = indices_.data();
+	    const T* const val = data_.data();
+	    const int nnz = data_.size();
+	    for (int i = 0; i < nnz; ++i) {
+		dense[ind[i]] = val[i];
+	    }
+	}
+
+	/// Replaces the nonzero elements with the elements of dense
+	/// with the same indices; the sparsity pattern is unchanged.
+	template <typename DenseVector>
+	void gather(const DenseVector& dense)
+	{
+	    const int* const ind = indices_.data();
+	    T* const val = data_.data();
+	    const int nnz = data_.size();
+	    for (int i = 0; i < nnz; ++i) {
+		val[i] = dense[ind[i]];
+	    }
+	}
+
     private:
 	// The vectors data_ and indices_ are always the same size.
 	// The indices are supposed to be stored in increasing order,
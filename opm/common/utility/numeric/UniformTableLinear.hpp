@@ -76,6 +76,22 @@ namespace Opm {
 	    /// @return f'(x)
 	    double derivative(const double x) const;
 
+	    /// @brief Evaluate the values at an array of x values.
+	    ///        Gives the same values as operator() for every x; the
+	    ///        loop has no data dependent branches apart from the
+	    ///        clamping, which lets the compiler vectorise it.
+	    /// @param x array of domain values
+	    /// @param y array of num values, f(x)
+	    /// @param num the number of values
+	    void evaluate(const double* x, double* y, int num) const;
+
+	    /// @brief Evaluate the derivatives at an array of x values,
+	    ///        as evaluate() for derivative().
+	    /// @param x array of domain values
+	    /// @param dy array of num values, f'(x)
+	    /// @param num the number of values
+	    void derivative(const double* x, double* dy, int num) const;
+
 	    /// @brief Equality operator.
 	    /// @param other another UniformTableLinear.
 	    /// @return true if they are represented exactly alike.
@@ -210,6 +226,41 @@ namespace Opm {
 	}
 
 
+	template<typename T>
+	inline void
+	UniformTableLinear<T>
+	::evaluate(const double* xparam, double* y, int num) const
+	{
+            // Implements ClosestValue policy; at xmax_ the last interval
+            // is used with weight one on the last value.
+            const int last = int(y_values_.size()) - 2;
+            const T* yv = y_values_.data();
+            for (int i = 0; i < num; ++i) {
+                double x = std::min(xparam[i], xmax_);
+                x = std::max(x, xmin_);
+                const double pos = (x - xmin_)/xdelta_;
+                const int left = std::min(int(pos), last);
+                const double w = std::min(pos - left, 1.0);
+                y[i] = (1.0 - w)*yv[left] + w*yv[left + 1];
+            }
+	}
+
+	template<typename T>
+	inline void
+	UniformTableLinear<T>
+	::derivative(const double* xparam, double* dy, int num) const
+	{
+            const int last = int(y_values_.size()) - 2;
+            const T* yv = y_values_.data();
+            for (int i = 0; i < num; ++i) {
+                const bool inside = !(xparam[i] > xmax_ || xparam[i] < xmin_);
+                double x = std::min(xparam[i], xmax_);
+                x = std::max(x, xmin_);
+                const int left = std::min(int((x - xmin_)/xdelta_), last);
+                dy[i] = inside ? (yv[left + 1] - yv[left])/xdelta_ : 0.0;
+            }
+	}
+
 	template<typename T>
 	inline bool
 	UniformTableLinear<T>
@@ -15,10 +15,20 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstddef>
 #include <vector>
 #include <math.h>  
 
 
 double calculateCellVol(const std::vector<double>& X, const std::vector<double>& Y, const std::vector<double>& Z);
 
+/*
+  The volumes of num_cells cells at once. The corners are stored corner
+  by corner: the coordinate of corner c of cell i is X[c * num_cells + i],
+  with the corners in the same order as for a single cell. Collapsed
+  cells, where the top face coincides with the bottom face, get zero
+  volume.
+*/
+void calculateCellVol(std::size_t num_cells, const double* X, const double* Y, const double* Z, double* volumes);
+
 
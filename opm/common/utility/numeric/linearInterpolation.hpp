@@ -52,6 +52,24 @@ namespace Opm
     }
 
 
+    inline int tableIndex(const std::vector<double>& table, double x, int hint)
+    {
+	// As tableIndex(table, x), but the interval hint and the interval
+	// after it are tried before the binary search. When consecutive
+	// lookups are for increasing x values, the hint is usually right.
+	const int n = table.size() - 1;
+	if (n < 2 || !(table[n] > table[0])) {
+	    return tableIndex(table, x);
+	}
+	for (int j = hint; j >= 0 && j < n && j <= hint + 1; ++j) {
+	    if ((j == 0 || x >= table[j]) && (j == n - 1 || x < table[j + 1])) {
+		return j;
+	    }
+	}
+	return tableIndex(table, x);
+    }
+
+
     inline double linearInterpolationDerivative(const std::vector<double>& xv,
                                                 const std::vector<double>& yv, double x)
     {
@@ -36,6 +36,7 @@
 #ifndef OPM_PARAMETERGROUP_HEADER
 #define OPM_PARAMETERGROUP_HEADER
 
+#include <cstddef>
 #include <exception>
 #include <map>
 #include <string>
@@ -162,6 +163,41 @@ namespace Opm {
 			 const T& default_value,
 			 const Requirement& r) const;
 
+	    /// \brief A parameter looked up once and kept as a typed value.
+	    ///
+	    /// The value is converted on the first call to value(), and
+	    /// again only after parameters have been inserted or read
+	    /// anywhere in the parameter tree of the group.  The handle
+	    /// refers to the group, which must outlive it.
+	    template<typename T>
+	    class Handle {
+	    public:
+		const T& value() const;
+
+	    private:
+		friend class ParameterGroup;
+		Handle(const ParameterGroup& group, const std::string& name,
+		       bool has_default, const T& default_value);
+
+		const ParameterGroup* group_;
+		std::string name_;
+		bool has_default_;
+		T default_value_;
+		mutable T value_;
+		mutable std::size_t revision_;
+		mutable bool resolved_;
+	    };
+
+	    /// \brief Returns a handle to the parameter \p name, which
+	    ///        behaves as get<T>(name).
+	    template<typename T>
+	    Handle<T> handle(const std::string& name) const;
+
+	    /// \brief Returns a handle to the parameter \p name, which
+	    ///        behaves as getDefault<T>(name, default_value).
+	    template<typename T>
+	    Handle<T> handle(const std::string& name, const T& default_value) const;
+
 	    /// \brief This method returns the parameter group given by name,
 	    ///        i.e. it is an alias of get<ParameterGroup>().
 	    ///
@@ -252,6 +288,9 @@ namespace Opm {
 	    const ParameterGroup* parent_;
 	    bool output_is_enabled_;
 	    std::vector<std::string> unhandled_arguments_;
+	    // Shared by all the groups of a tree, and incremented whenever
+	    // an item is inserted; invalidates the values of the handles.
+	    std::shared_ptr<std::size_t> revision_;
 
 	    template<typename T, class Requirement>
 	    T translate(const pair_type& data, const Requirement& chk) const;
@@ -107,7 +107,8 @@ namespace Opm {
         template <typename StringArray>
 	ParameterGroup::ParameterGroup(int argc, StringArray argv, bool verify_syntax,
                                        const bool enable_output)
-            : path_(ID_path_root), parent_(0), output_is_enabled_(enable_output)
+            : path_(ID_path_root), parent_(0), output_is_enabled_(enable_output),
+              revision_(std::make_shared<std::size_t>(0))
 	{
 	    if (verify_syntax && (argc < 2)) {
 		std::cerr << "Usage: " << argv[0] << " "
@@ -268,6 +269,44 @@ namespace Opm {
 	    }
 	}
 
+	template<typename T>
+	inline ParameterGroup::Handle<T>::Handle(const ParameterGroup& group,
+						  const std::string& name,
+						  bool has_default,
+						  const T& default_value)
+	    : group_(&group), name_(name), has_default_(has_default),
+	      default_value_(default_value), value_(), revision_(0), resolved_(false)
+	{
+	}
+
+	template<typename T>
+	inline const T& ParameterGroup::Handle<T>::value() const
+	{
+	    const std::size_t revision = *group_->revision_;
+	    if (!resolved_ || revision_ != revision) {
+		value_ = has_default_
+		    ? group_->getDefault<T>(name_, default_value_)
+		    : group_->get<T>(name_);
+		revision_ = revision;
+		resolved_ = true;
+	    }
+	    return value_;
+	}
+
+	template<typename T>
+	inline ParameterGroup::Handle<T>
+	ParameterGroup::handle(const std::string& name) const
+	{
+	    return Handle<T>(*this, name, false, T());
+	}
+
+	template<typename T>
+	inline ParameterGroup::Handle<T>
+	ParameterGroup::handle(const std::string& name, const T& default_value) const
+	{
+	    return Handle<T>(*this, name, true, default_value);
+	}
+
 	template<typename T, class Requirement>
 	inline T ParameterGroup::translate(const pair_type& named_data,
 					   const Requirement& chk) const
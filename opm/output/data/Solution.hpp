@@ -40,6 +40,12 @@ class Solution : public std::map< std::string, data::CellData > {
 
         bool has( const std::string& ) const;
 
+        /*
+          Whether the fields are in SI units, i.e. have not been converted
+          with convertFromSI().
+        */
+        bool isSI() const;
+
         /*
          * Get the data field of the struct matching the requested key. Will
          * throw std::out_of_range if they key does not exist.
@@ -22,12 +22,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <map>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -154,11 +157,36 @@ namespace Opm {
         int control;
         std::vector< Connection > connections;
         std::unordered_map<std::size_t, Segment> segments;
+
         inline bool flowing() const noexcept;
+
+        /// The connection in grid cell index, or nullptr if the well has
+        /// no connection there.
+        inline const Connection* find_connection( Connection::global_index index ) const;
+
+        /// Build the cell index of the connections; must be called after
+        /// the connections have been filled to make find_connection()
+        /// a binary search instead of a linear one, and again after the
+        /// connections have been changed.
+        inline void index_connections();
+
+        /// True if find_connection() searches the cell index.
+        inline bool indexed() const noexcept;
+
         template <class MessageBufferType>
         void write(MessageBufferType& buffer) const;
         template <class MessageBufferType>
         void read(MessageBufferType& buffer);
+
+    private:
+        /*
+          Connections sorted on grid cell as (Connection::index, position in
+          connections) pairs, built by index_connections(). The index is
+          fresh while it has as many entries as there are connections; a
+          fresh index is trusted, also for the cells it does not hold.
+          Without a fresh index the connections are scanned linearly.
+        */
+        std::vector< std::pair< Connection::global_index, std::size_t > > connection_index;
     };
 
 
@@ -177,41 +205,52 @@ namespace Opm {
             const auto& witr = this->find( well_name );
             if( witr == this->end() ) return 0.0;
 
-            const auto& well = witr->second;
-            const auto& connection = std::find_if( well.connections.begin() ,
-                                                   well.connections.end() ,
-                                                   [=]( const Connection& c ) {
-                                                        return c.index == connection_grid_index; });
-
-            if( connection == well.connections.end() )
+            const auto* connection = witr->second.find_connection( connection_grid_index );
+            if( connection == nullptr )
                 return 0.0;
 
             return connection->rates.get( m, 0.0 );
         }
 
+        /// The wells named in names, in the same order, and null for
+        /// the names without a well. With the names of
+        /// Schedule::wellNames() a well is found at its
+        /// Schedule::wellIndex().
+        std::vector< const Well* > by_index(const std::vector< std::string >& names) const {
+            std::vector< const Well* > wells;
+            wells.reserve( names.size() );
+            for (const auto& name : names) {
+                const auto witr = this->find( name );
+                wells.push_back( witr == this->end() ? nullptr : &witr->second );
+            }
+
+            return wells;
+        }
+
+        /// Index the connections of all the wells, see
+        /// Well::index_connections(). Typically called once when the
+        /// simulator has filled in the results of a report step.
+        void index_connections() {
+            for (auto& witr : *this)
+                witr.second.index_connections();
+        }
+
+        /// All the wells in one contiguous buffer, see WellRatesView for
+        /// the layout; unpack() adds the wells of a packed buffer.
+        inline std::string pack() const;
+        inline void unpack(const char* data, std::size_t size);
+
+        /// The wells are sent as a single packed string.
         template <class MessageBufferType>
         void write(MessageBufferType& buffer) const {
-            unsigned int size = this->size();
-            buffer.write(size);
-            for (const auto& witr : *this) {
-                const std::string& name = witr.first;
-                buffer.write(name);
-                const Well& well = witr.second;
-                well.write(buffer);
-            }
+            buffer.write(this->pack());
         }
 
         template <class MessageBufferType>
         void read(MessageBufferType& buffer) {
-            unsigned int size;
-            buffer.read(size);
-            for (size_t i = 0; i < size; ++i) {
-                std::string name;
-                buffer.read(name);
-                Well well;
-                well.read(buffer);
-                this->emplace(name, well);
-            }
+            std::string packed;
+            buffer.read(packed);
+            this->unpack(packed.data(), packed.size());
         }
 
     };
@@ -219,6 +258,83 @@ namespace Opm {
     using Wells = WellRates;    
 
 
+    /*
+      A read-only view of the buffer of WellRates::pack(), which gives
+      access to the wells without building the maps. The buffer is
+
+         header
+         one WellRatesView::Head per well, in name order
+         the connections of all the wells, as Connection
+         the segments of all the wells ordered on segment number, as Segment
+         num_wells + 1 offsets of the names
+         the names, each followed by a nul character
+
+      where every block is a multiple of eight bytes, so the buffer must
+      be aligned like a double; the connections and segments of a well
+      are given by the first and count members of its head. The layout
+      is the memory layout of the structs, so both sides must run the
+      same binary, as for the MPI gather of the results.
+    */
+    class WellRatesView {
+    public:
+        struct Head {
+            Rates rates;
+            double bhp;
+            double thp;
+            double temperature;
+            std::int64_t control;
+            std::uint64_t first_connection;
+            std::uint64_t num_connections;
+            std::uint64_t first_segment;
+            std::uint64_t num_segments;
+        };
+
+        struct Header {
+            std::uint64_t version;
+            std::uint64_t num_wells;
+            std::uint64_t num_connections;
+            std::uint64_t num_segments;
+            std::uint64_t name_bytes;
+        };
+
+        static const std::uint64_t version = 1;
+
+        /// Throws std::invalid_argument if the buffer is not a valid
+        /// packed buffer.
+        inline WellRatesView(const char* data, std::size_t size);
+
+        std::size_t size() const { return this->header.num_wells; }
+
+        const char* name(std::size_t well) const { return this->names + this->name_offsets[well]; }
+        const Head& head(std::size_t well) const { return this->heads[well]; }
+
+        const Connection* connections_begin(std::size_t well) const {
+            return this->connections + this->heads[well].first_connection;
+        }
+        const Connection* connections_end(std::size_t well) const {
+            return this->connections_begin(well) + this->heads[well].num_connections;
+        }
+
+        const Segment* segments_begin(std::size_t well) const {
+            return this->segments + this->heads[well].first_segment;
+        }
+        const Segment* segments_end(std::size_t well) const {
+            return this->segments_begin(well) + this->heads[well].num_segments;
+        }
+
+        /// The position of the well, or size() if there is no such well.
+        inline std::size_t find(const std::string& name) const;
+
+    private:
+        Header header;
+        const Head* heads;
+        const Connection* connections;
+        const Segment* segments;
+        const std::uint64_t* name_offsets;
+        const char* names;
+    };
+
+
     /* IMPLEMENTATIONS */
 
     inline bool Rates::has( opt m ) const {
@@ -304,6 +420,227 @@ namespace Opm {
         return this->rates.any();
     }
 
+    inline const Connection* Well::find_connection( Connection::global_index index ) const {
+        using entry = std::pair< Connection::global_index, std::size_t >;
+
+        if( this->indexed() ) {
+            const auto pos = std::lower_bound( this->connection_index.begin(),
+                                               this->connection_index.end(),
+                                               index,
+                                               []( const entry& e, Connection::global_index i ) {
+                                                   return e.first < i;
+                                               } );
+
+            if( pos == this->connection_index.end() || pos->first != index )
+                return nullptr;
+
+            return &this->connections[ pos->second ];
+        }
+
+        const auto connection = std::find_if( this->connections.begin(),
+                                              this->connections.end(),
+                                              [=]( const Connection& c ) {
+                                                  return c.index == index; });
+
+        if( connection == this->connections.end() )
+            return nullptr;
+
+        return &*connection;
+    }
+
+    inline void Well::index_connections() {
+        this->connection_index.clear();
+        this->connection_index.reserve( this->connections.size() );
+        for( std::size_t pos = 0; pos < this->connections.size(); ++pos )
+            this->connection_index.emplace_back( this->connections[ pos ].index, pos );
+
+        std::stable_sort( this->connection_index.begin(), this->connection_index.end(),
+                          []( const std::pair< Connection::global_index, std::size_t >& lhs,
+                              const std::pair< Connection::global_index, std::size_t >& rhs ) {
+                              return lhs.first < rhs.first;
+                          } );
+    }
+
+    inline bool Well::indexed() const noexcept {
+        return this->connection_index.size() == this->connections.size();
+    }
+
+    inline WellRatesView::WellRatesView(const char* data, std::size_t size) {
+        static_assert(std::is_trivially_copyable<Connection>::value &&
+                      std::is_trivially_copyable<Segment>::value &&
+                      std::is_trivially_copyable<Head>::value,
+                      "The packed wells are copied as raw memory");
+        static_assert(sizeof(Connection) % 8 == 0 && sizeof(Segment) % 8 == 0 &&
+                      sizeof(Head) % 8 == 0 && sizeof(Header) % 8 == 0,
+                      "The packed blocks must keep the alignment");
+
+        const auto invalid = []() {
+            return std::invalid_argument("Not a valid packed buffer of well results");
+        };
+
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(double) != 0 || size < sizeof(Header))
+            throw invalid();
+
+        std::memcpy(&this->header, data, sizeof(Header));
+        if (this->header.version != version)
+            throw invalid();
+
+        const auto& h = this->header;
+        const std::uint64_t blocks[] = {
+            h.num_wells * sizeof(Head),
+            h.num_connections * sizeof(Connection),
+            h.num_segments * sizeof(Segment),
+            (h.num_wells + 1) * sizeof(std::uint64_t),
+        };
+
+        std::uint64_t expected = sizeof(Header) + h.name_bytes;
+        for (const auto block : blocks)
+            expected += block;
+
+        if (expected != size || h.num_wells > size)
+            throw invalid();
+
+        const char* block = data + sizeof(Header);
+        this->heads = reinterpret_cast<const Head*>(block);
+        block += blocks[0];
+        this->connections = reinterpret_cast<const Connection*>(block);
+        block += blocks[1];
+        this->segments = reinterpret_cast<const Segment*>(block);
+        block += blocks[2];
+        this->name_offsets = reinterpret_cast<const std::uint64_t*>(block);
+        block += blocks[3];
+        this->names = block;
+
+        for (std::size_t well = 0; well < h.num_wells; ++well) {
+            const auto& head = this->heads[well];
+            const auto begin = this->name_offsets[well];
+            const auto end = this->name_offsets[well + 1];
+            if (begin >= end || end > h.name_bytes || this->names[end - 1] != '\0' ||
+                head.first_connection + head.num_connections > h.num_connections ||
+                head.first_segment + head.num_segments > h.num_segments)
+                throw invalid();
+        }
+    }
+
+    inline std::size_t WellRatesView::find(const std::string& name) const {
+        std::size_t first = 0;
+        std::size_t last = this->size();
+        while (first < last) {
+            const auto middle = first + (last - first) / 2;
+            const int cmp = std::strcmp(this->name(middle), name.c_str());
+            if (cmp == 0)
+                return middle;
+
+            if (cmp < 0)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        return this->size();
+    }
+
+    /*
+      The blocks are filled with one memcpy per connection array and per
+      segment; the segments are ordered on segment number so that equal
+      wells pack to equal buffers.
+    */
+    inline std::string WellRates::pack() const {
+        using Head = WellRatesView::Head;
+        WellRatesView::Header header{ WellRatesView::version, this->size(), 0, 0, 0 };
+        for (const auto& witr : *this) {
+            header.num_connections += witr.second.connections.size();
+            header.num_segments += witr.second.segments.size();
+            header.name_bytes += witr.first.size() + 1;
+        }
+
+        const std::size_t size = sizeof(header)
+                               + header.num_wells * sizeof(Head)
+                               + header.num_connections * sizeof(Connection)
+                               + header.num_segments * sizeof(Segment)
+                               + (header.num_wells + 1) * sizeof(std::uint64_t)
+                               + header.name_bytes;
+
+        std::string packed(size, '\0');
+        char* out = &packed[0];
+        std::memcpy(out, &header, sizeof(header));
+
+        char* heads = out + sizeof(header);
+        char* connections = heads + header.num_wells * sizeof(Head);
+        char* segments = connections + header.num_connections * sizeof(Connection);
+        char* offsets = segments + header.num_segments * sizeof(Segment);
+        char* names = offsets + (header.num_wells + 1) * sizeof(std::uint64_t);
+
+        std::uint64_t connection = 0;
+        std::uint64_t segment = 0;
+        std::uint64_t name_offset = 0;
+        std::vector<const Segment*> ordered;
+        for (const auto& witr : *this) {
+            const auto& well = witr.second;
+
+            Head head{ well.rates, well.bhp, well.thp, well.temperature, well.control,
+                       connection, well.connections.size(), segment, well.segments.size() };
+            std::memcpy(heads, &head, sizeof(head));
+            heads += sizeof(head);
+
+            if (!well.connections.empty())
+                std::memcpy(connections, well.connections.data(), well.connections.size() * sizeof(Connection));
+            connections += well.connections.size() * sizeof(Connection);
+            connection += well.connections.size();
+
+            ordered.clear();
+            for (const auto& seg : well.segments)
+                ordered.push_back(&seg.second);
+            std::sort(ordered.begin(), ordered.end(), [](const Segment* lhs, const Segment* rhs) {
+                return lhs->segNumber < rhs->segNumber;
+            });
+            for (const auto* seg : ordered) {
+                std::memcpy(segments, seg, sizeof(Segment));
+                segments += sizeof(Segment);
+            }
+            segment += well.segments.size();
+
+            std::memcpy(offsets, &name_offset, sizeof(name_offset));
+            offsets += sizeof(name_offset);
+            std::memcpy(names + name_offset, witr.first.c_str(), witr.first.size() + 1);
+            name_offset += witr.first.size() + 1;
+        }
+        std::memcpy(offsets, &name_offset, sizeof(name_offset));
+
+        return packed;
+    }
+
+    /*
+      The buffer of a message is not necessarily aligned, it is copied
+      to aligned memory first if it is not.
+    */
+    inline void WellRates::unpack(const char* data, std::size_t size) {
+        std::vector<double> aligned;
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(double) != 0) {
+            aligned.resize((size + sizeof(double) - 1) / sizeof(double));
+            std::memcpy(aligned.data(), data, size);
+            data = reinterpret_cast<const char*>(aligned.data());
+        }
+
+        const WellRatesView view(data, size);
+        for (std::size_t index = 0; index < view.size(); ++index) {
+            const auto& head = view.head(index);
+
+            Well well;
+            well.rates = head.rates;
+            well.bhp = head.bhp;
+            well.thp = head.thp;
+            well.temperature = head.temperature;
+            well.control = static_cast<int>(head.control);
+            well.connections.assign(view.connections_begin(index), view.connections_end(index));
+            well.index_connections();
+            for (auto seg = view.segments_begin(index); seg != view.segments_end(index); ++seg)
+                well.segments.emplace(seg->segNumber, *seg);
+
+            this->emplace_hint(this->end(), view.name(index), std::move(well));
+        }
+    }
+
     template <class MessageBufferType>
     void Rates::write(MessageBufferType& buffer) const {
             buffer.write(this->mask);
@@ -426,6 +763,7 @@ namespace Opm {
             auto& comp = this->connections[ i ];
             comp.read(buffer);
         }
+        this->index_connections();
 
         // Segment information (if applicable)
         const auto nSeg = [&buffer]() -> unsigned int
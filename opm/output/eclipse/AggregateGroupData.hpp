@@ -56,6 +56,11 @@ namespace Opm { namespace RestartIO { namespace Helpers {
     public:
 	explicit AggregateGroupData(const std::vector<int>& inteHead);
 
+        /// Clear the arrays for another report step, resized to the
+        /// dimensions in \p inteHead.  Equivalent to constructing a new
+        /// object, but reuses the existing storage where possible.
+        void reset(const std::vector<int>& inteHead);
+
 	void captureDeclaredGroupData(const Opm::Schedule&                 sched,
 				      const std::vector<std::string>&      restart_group_keys,
 				      const std::vector<std::string>&      restart_field_keys,
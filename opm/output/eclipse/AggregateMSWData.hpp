@@ -61,6 +61,11 @@ namespace Opm { namespace RestartIO { namespace Helpers {
     {
     public:
         explicit AggregateMSWData(const std::vector<int>& inteHead);
+
+        /// Clear the arrays for another report step, resized to the
+        /// dimensions in \p inteHead.  Equivalent to constructing a new
+        /// object, but reuses the existing storage where possible.
+        void reset(const std::vector<int>& inteHead);
 	
         void captureDeclaredMSWData(const Opm::Schedule& sched,
                                      const std::size_t    rptStep,
@@ -44,6 +44,11 @@ namespace Opm { namespace RestartIO { namespace Helpers {
     public:
         explicit AggregateWellData(const std::vector<int>& inteHead);
 
+        /// Clear the arrays for another report step, resized to the
+        /// dimensions in \p inteHead.  Equivalent to constructing a new
+        /// object, but reuses the existing storage where possible.
+        void reset(const std::vector<int>& inteHead);
+
 	void captureDeclaredWellData(const Schedule&   	sched,
                         const UnitSystem& 		units,
                         const std::size_t 		sim_step,
@@ -0,0 +1,115 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ARRAY_READER_HPP
+#define OPM_ARRAY_READER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// \file
+///
+/// Random access to the arrays of unformatted ECLIPSE files -- restart,
+/// summary and INIT files -- for many concurrent readers.
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    /// Reads the arrays of one unformatted ECLIPSE file.
+    ///
+    /// Opening a file scans its array headers once.  The index is shared
+    /// by all the readers of the file for as long as the file keeps its
+    /// size and modification time, so opening the same case again, from
+    /// any thread, costs a lookup.
+    ///
+    /// Decoded arrays are kept in a process wide cache of recently used
+    /// arrays, within a memory budget.  The arrays are handed out as
+    /// shared pointers, and stay valid after they are evicted.
+    ///
+    /// All member functions may be called concurrently on one or many
+    /// readers of the same file: the index is immutable, every read
+    /// opens its own stream, and the cache is split in shards which are
+    /// locked independently and only while they are looked up or
+    /// updated, never while a file is read.
+    class ArrayReader
+    {
+    public:
+        /// One array of the file.
+        struct Entry
+        {
+            /// Array name, without trailing blanks.
+            std::string keyword;
+
+            /// Element type: INTE, REAL, DOUB, LOGI, CHAR, C0nn or MESS.
+            std::string type;
+
+            /// Number of elements.
+            std::size_t size;
+
+            /// Position of the first data record in the file.
+            std::size_t offset;
+        };
+
+        static const std::size_t defaultCacheBudget = 256 * 1024 * 1024;
+
+        explicit ArrayReader(const std::string& filename);
+
+        const std::string& filename() const;
+
+        /// The arrays of the file, in file order.
+        const std::vector<Entry>& entries() const;
+
+        /// Number of arrays named \p keyword.
+        std::size_t count(const std::string& keyword) const;
+
+        /// Position in entries() of the array named \p keyword, counting
+        /// from \p occurrence zero for the first one.  Throws
+        /// std::invalid_argument if there is no such array.
+        std::size_t find(const std::string& keyword, std::size_t occurrence = 0) const;
+
+        /// The values of the INTE or LOGI array at position \p index of
+        /// entries(); logical values are nonzero for true.
+        std::shared_ptr<const std::vector<int>> getInt(std::size_t index) const;
+
+        /// The values of the REAL or DOUB array at position \p index.
+        std::shared_ptr<const std::vector<double>> getDouble(std::size_t index) const;
+
+        /// The values of the CHAR or C0nn array at position \p index,
+        /// without trailing blanks.
+        std::shared_ptr<const std::vector<std::string>> getString(std::size_t index) const;
+
+        /// Memory budget in bytes of the cache of decoded arrays, shared
+        /// by all the readers of the process.  Arrays larger than a
+        /// sixteenth of the budget are not cached.
+        static void setCacheBudget(std::size_t bytes);
+
+    private:
+        struct Index;
+
+        std::shared_ptr<const Index> index;
+
+        template <typename T>
+        std::shared_ptr<const std::vector<T>>
+        get(std::size_t index, const char* const* types) const;
+    };
+
+}}} // Opm::RestartIO::Helpers
+
+#endif // OPM_ARRAY_READER_HPP
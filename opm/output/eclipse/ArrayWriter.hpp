@@ -0,0 +1,108 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ARRAY_WRITER_HPP
+#define OPM_ARRAY_WRITER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <opm/output/eclipse/UnformattedArray.hpp>
+
+/// \file
+///
+/// Sequential writer of the numeric arrays of ECLIPSE files, in the
+/// unformatted (binary) or the formatted (text) format.
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    /// Writes arrays to the end of a stdio stream, in the same bytes as
+    /// ERT's ecl_kw_fwrite():
+    ///
+    ///   - Unformatted: the layout of UnformattedArray, a header record
+    ///     followed by big-endian Fortran records of at most 1000
+    ///     elements.
+    ///
+    ///   - Formatted: a header line followed by blocks of at most 1000
+    ///     elements, written in lines of 6 integers, 4 floats or 3
+    ///     doubles, the reals in ECLIPSE's 0.ddddE+xx notation.
+    ///
+    /// The values are encoded straight from the caller's vector into
+    /// one reusable buffer, which is written out in multiples of the
+    /// block size when it is full, so a large array costs a few large
+    /// writes and no copy of the array. The text of large formatted
+    /// arrays is produced in parallel, in ranges of blocks.
+    ///
+    /// The stream may be shared with other writers, e.g. the fortio of
+    /// ERT, as long as flush() is called before they write; the
+    /// destructor flushes too, but can not report errors.
+    class ArrayWriter
+    {
+    public:
+        using Type = UnformattedArray::Type;
+
+        /// Converts n values from src to dst, e.g. to output units.
+        using Convert = std::function<void(const double* src, double* dst, std::size_t n)>;
+
+        static const std::size_t blockSize = 4096;
+        static const std::size_t defaultBufferSize = 1024 * blockSize;
+
+        ArrayWriter(std::FILE* stream, bool formatted, std::size_t bufferSize = defaultBufferSize);
+        ~ArrayWriter();
+
+        ArrayWriter(const ArrayWriter&) = delete;
+        ArrayWriter& operator=(const ArrayWriter&) = delete;
+
+        bool formatted() const;
+
+        void write(const std::string& keyword, const std::vector<int>& data);
+        void write(const std::string& keyword, const std::vector<float>& data);
+
+        /// Write the values as REAL (Type::Float) or DOUB (Type::Double).
+        void write(const std::string& keyword, const std::vector<double>& data, Type type);
+
+        /// Write the values as REAL or DOUB after passing them through
+        /// convert, at most 1000 values at a time. For large formatted
+        /// arrays convert is called from several threads at once.
+        void write(const std::string& keyword, const std::vector<double>& data, Type type,
+                   const Convert& convert);
+
+        /// Write everything buffered to the stream.
+        void flush();
+
+    private:
+        template <typename T>
+        void writeArray(const std::string& keyword, const T* data, std::size_t size,
+                        Type type, const Convert* convert);
+
+        char* reserve(std::size_t bytes);
+        void writeOut(std::size_t bytes);
+
+        std::FILE* stream;
+        bool is_formatted;
+        std::vector<char> buffer;
+        std::size_t used = 0;
+    };
+
+}}} // Opm::RestartIO::Helpers
+
+#endif // OPM_ARRAY_WRITER_HPP
@@ -0,0 +1,131 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_COLUMNAR_SUMMARY_HPP
+#define OPM_COLUMNAR_SUMMARY_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+  The summary time series in columnar form, for analysis tools which
+  read a few vectors over all the timesteps: the timesteps are stored
+  in chunks of a fixed number of rows, and within a chunk every vector
+  is one contiguous column.
+
+  All the numbers are little endian; integers are 32 bit unsigned and
+  values are IEEE doubles. The file starts with a header
+
+     "OPMCSMRY", version (1), number of columns C, rows per chunk N,
+     C x (name length, name, unit length, unit)
+
+  followed by the chunks, each of which has
+
+     number of rows R (1 <= R <= N),
+     C x (min, max)      - of the column within the chunk,
+     C x R values        - column after column.
+
+  Only the last chunk can have fewer than N rows. The first column is
+  TIME in days; a vector without a value at a timestep has NaN there,
+  and a column without values in a chunk has NaN as its min and max.
+*/
+
+namespace Opm { namespace out {
+
+class ColumnarSummary {
+public:
+    /*
+      Creates the file, replacing an existing one, and writes the
+      header; throws std::runtime_error if the file can not be written.
+    */
+    ColumnarSummary( const std::string& filename,
+                     const std::vector< std::string >& keys,
+                     const std::vector< std::string >& units,
+                     std::size_t chunk_size );
+
+    /* Writes the rows of the last, partial chunk. */
+    ~ColumnarSummary();
+
+    /*
+      Adds a timestep, one value per key. The rows are buffered until
+      the chunk is full, so the output costs one write per chunk.
+    */
+    void append( const std::vector< double >& row );
+
+    /* Writes the buffered rows, as a partial chunk if need be. */
+    void flush();
+
+    /* The bytes of the chunk buffer. */
+    std::size_t memory_usage() const;
+
+private:
+    std::ofstream stream;
+    std::size_t num_columns;
+    std::size_t chunk_size;
+    std::size_t rows = 0;
+
+    /* Column major, chunk_size rows per column. */
+    std::vector< double > columns;
+    std::vector< char > buffer;
+};
+
+
+class ColumnarSummaryFile {
+public:
+    struct ChunkStats {
+        std::size_t rows;
+        double min;
+        double max;
+    };
+
+    /* Throws std::runtime_error if the file is not a columnar summary. */
+    explicit ColumnarSummaryFile( const std::string& filename );
+
+    const std::vector< std::string >& keys() const;
+    const std::vector< std::string >& units() const;
+    std::size_t numRows() const;
+
+    /*
+      The values of one vector over all the timesteps, read chunk by
+      chunk; throws std::invalid_argument for an unknown key.
+    */
+    std::vector< double > get( const std::string& key ) const;
+
+    /* The min and max of a vector in each chunk. */
+    std::vector< ChunkStats > stats( const std::string& key ) const;
+
+private:
+    struct Chunk {
+        std::size_t offset;
+        std::size_t rows;
+    };
+
+    std::string filename;
+    std::vector< std::string > m_keys;
+    std::vector< std::string > m_units;
+    std::vector< Chunk > chunks;
+
+    std::size_t column( const std::string& key ) const;
+};
+
+}}
+
+#endif // OPM_COLUMNAR_SUMMARY_HPP
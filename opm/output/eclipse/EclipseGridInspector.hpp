@@ -90,11 +90,25 @@ public:
     /// {LLL, HLL, LHL, HHL, LLH, HLH, LHH, HHH }.
     std::array<double, 8> cellZvals(int i, int j, int k) const;
 
+    /// The same quantities for all the cells with global index in
+    /// [begin, end), computed in parallel; use 0 and the product of
+    /// gridSize() for the whole grid. COORD, ZCORN and the grid limits
+    /// are only looked up once.
+    std::vector<std::pair<double,double>> cellDipsRange(int begin, int end) const;
+    std::vector<std::array<double, 8>> cellZvalsRange(int begin, int end) const;
+    std::vector<double> cellVolumesVerticalPillars(int begin, int end) const;
+
+    /// The area of the base of the cells, assuming vertical pillars.
+    std::vector<double> cellAreasVerticalPillars(int begin, int end) const;
+
 private:
     Opm::Deck deck_;
     int logical_gridsize_[3];
     void init_();
     void checkLogicalCoords(int i, int j, int k) const;
+    void checkCellRange(int begin, int end) const;
+    const std::vector<double>& coord_() const;
+    const std::vector<double>& zcorn_() const;
 };
 
 } // namespace Opm
@@ -98,6 +98,10 @@ public:
   *       If you want the FOE keyword in the summary output the
   *       simProps container must contain the initial OIP field.
   *
+  *       The properties are converted to output units as they are
+  *       written, without a converted copy; pass the containers with
+  *       std::move() to avoid copying the arrays into the call.
+  *
   *   In addition:
   *
   *   - The NNC argument is distributed between the EGRID and INIT
@@ -137,6 +141,11 @@ public:
      * can be added here are represented with mnenonics in the RPTRST
      * keyword.
      *
+     * The RestartValue is taken by value; pass it with std::move() to
+     * hand the field vectors over without copying them. The output
+     * layer does not modify the fields, the unit conversion is done
+     * while the values are copied into the output keywords.
+     *
      * The extra_restart argument is an optional aergument which can
      * be used to store arbitrary double vectors in the restart
      * file. The following rules apply for the extra data:
@@ -217,9 +226,42 @@ public:
       required, and the output layer will throw an exception if it is
       missing, if the bool is false missing keywords will be ignored
       (there will *not* be an empty vector in the return value).
+
+      The summary values of the restart step, e.g. the cumulative
+      totals, are restored from the restart file as well, so the
+      summary output continues from them.
     */
     RestartValue loadRestart(const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys = {}) const;
 
+    /*
+      As loadRestart(), but the solution vectors are loaded straight
+      into the simulator's own storage; see RestartIO::loadInto().
+    */
+    RestartValue loadRestartInto(const std::vector<RestartBuffer>& solution_buffers, const std::vector<RestartKey>& extra_keys = {}) const;
+
+
+    /*
+      In asynchronous mode writeTimeStep() only copies the input to a
+      queue and returns, the summary, restart and RFT files are then
+      written by a separate output thread. When maxQueued report steps
+      are waiting to be written writeTimeStep() will block until the
+      output thread has caught up.
+
+      An exception in the output thread is rethrown from the next call to
+      writeTimeStep() or flush(), and the report steps queued after the
+      failing step are not written. The other methods of EclipseIO will
+      wait for the queue to drain before they run, and disabling
+      asynchronous output or destroying the EclipseIO object will write
+      all pending report steps.
+    */
+    void setAsyncOutput(bool enable, std::size_t maxQueued = 2);
+
+    /*
+      Wait until all report steps passed to writeTimeStep() have been
+      written; a no-op in synchronous mode.
+    */
+    void flush();
+
 
     EclipseIO( const EclipseIO& ) = delete;
     ~EclipseIO();
@@ -20,6 +20,10 @@
 #ifndef OPM_REGION_CACHE_HPP
 #define OPM_REGION_CACHE_HPP
 
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -28,16 +32,92 @@ namespace Opm {
     class EclipseGrid;
 
 namespace out {
+
+    /*
+      Index of the active cells and the well connections in every region
+      of one or more region sets (FIPNUM, FIPxxx, ...). Each region set
+      is stored in compressed row form: the items of region r are the
+      entries offsets[r] <= i < offsets[r+1] of one flat array. Region ids
+      less than one are not part of any region.
+
+      The connections are only indexed by FIPNUM, and are kept in the
+      order of the wells and connections in the Schedule.
+    */
     class RegionCache {
     public:
+        template <typename T>
+        class Range {
+        public:
+            Range(const T* first_arg, const T* last_arg) :
+                first(first_arg),
+                last(last_arg)
+            {}
+
+            const T* begin() const { return this->first; }
+            const T* end() const { return this->last; }
+            std::size_t size() const { return this->last - this->first; }
+            bool empty() const { return this->first == this->last; }
+            const T& operator[](std::size_t index) const { return this->first[index]; }
+
+        private:
+            const T* first;
+            const T* last;
+        };
+
         RegionCache() = default;
         RegionCache(const Eclipse3DProperties& properties, const EclipseGrid& grid, const Schedule& schedule);
-        const std::vector<std::pair<std::string,size_t>>& connections( int region_id ) const;
+        RegionCache(const Eclipse3DProperties& properties,
+                    const EclipseGrid& grid,
+                    const Schedule& schedule,
+                    const std::vector<std::string>& region_set_names);
+
+        Range<std::pair<std::string,size_t>> connections( int region_id ) const;
+
+        bool hasRegionSet(const std::string& region_set) const;
+
+        /* The ids of the regions with at least one active cell. */
+        const std::vector<int>& regions(const std::string& region_set) const;
+
+        /* The largest region id in the region set. */
+        int maxRegion(const std::string& region_set) const;
+
+        /* The active indices of the cells in the region, in ascending order. */
+        Range<std::size_t> cells(const std::string& region_set, int region_id) const;
+
+        /*
+          The sum of the active cell values over every region of the
+          region set; element r - 1 of the result is the sum for region r,
+          which is the layout of the region values passed to
+          Summary::add_timestep().
+        */
+        std::vector<double> reduce(const std::vector<double>& values, const std::string& region_set) const;
+
+        /*
+          As reduce(), but the weighted mean of the values, e.g. the pore
+          volume weighted pressure. Regions with zero total weight get the
+          value zero.
+        */
+        std::vector<double> average(const std::vector<double>& values,
+                                    const std::vector<double>& weights,
+                                    const std::string& region_set) const;
+
+        /* The bytes allocated by the index, not counting the object itself. */
+        std::size_t memory_usage() const;
 
     private:
-        std::vector<std::pair<std::string,size_t>> connections_empty;
+        struct RegionSet {
+            std::vector<int> regions;
+            std::vector<std::size_t> offsets;
+            std::vector<std::size_t> cells;
+        };
+
+        const RegionSet& regionSet(const std::string& region_set) const;
+
+        std::size_t num_active = 0;
+        std::map<std::string, RegionSet> region_sets;
 
-        std::map<int , std::vector<std::pair<std::string,size_t>>> connection_map;
+        std::vector<std::size_t> connection_offsets;
+        std::vector<std::pair<std::string,size_t>> connection_list;
     };
 }
 }
@@ -23,6 +23,7 @@
 #ifndef RESTART_IO_HPP
 #define RESTART_IO_HPP
 
+#include <memory>
 #include <vector>
 #include <map>
 
@@ -34,6 +35,7 @@
 #include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
+#include <opm/output/eclipse/WriteRestartHelpers.hpp>
 
 #include <ert/ecl/EclKW.hpp>
 #include <ert/ecl/ecl_rsthead.h>
@@ -71,6 +73,18 @@ namespace RestartIO {
 
    will read and write to the file "CASE.X0010" - completely ignoring
    the report step argument '99'.
+
+   Unless ECLIPSE compatible restart files are requested save() also
+   writes the values of the SummaryState, in index order, as the array
+   OPM_SMRY; it can be loaded as an extra vector with identity
+   dimension and handed to Summary::set_restart_vectors().
+
+   If IOConfig::getDeduplicateRST() is set as well, a unified restart
+   file written through one set of OutputBuffers does not repeat the
+   arrays which are unchanged since an earlier report step. Their
+   keywords and the report steps which hold their data are listed in
+   the arrays OPM_REFK and OPM_REFS instead, and load() resolves the
+   references transparently.
 */
 
 /*void save(const std::string& filename,
@@ -87,13 +101,78 @@ namespace RestartIO {
 void save(const std::string& filename,
           int report_step,
           double seconds_elapsed,
-          RestartValue value,
+          const RestartValue& value,
           const EclipseState& es,
           const EclipseGrid& grid,
           const Schedule& schedule,
           const SummaryState& sumState,
           bool write_double = false);
 
+/*
+  As save() above, with the header items which are the same for every
+  report step precomputed; EclipseIO creates these once for all the
+  restart files of a run.
+*/
+void save(const std::string& filename,
+          int report_step,
+          double seconds_elapsed,
+          const RestartValue& value,
+          const EclipseState& es,
+          const EclipseGrid& grid,
+          const Schedule& schedule,
+          const SummaryState& sumState,
+          const Helpers::StaticHeaders& headers,
+          bool write_double = false);
+
+/*
+  The well, connection, segment and group arrays of the restart file,
+  kept from one call to save() to the next. The arrays are cleared for
+  every report step, and their storage is only allocated again when it
+  must grow; EclipseIO keeps one set for all the restart files of a run.
+  A set must not be used by two calls to save() at the same time.
+
+  The set also keeps a unified restart file open from one call to
+  save() to the next, with the offsets of the SEQNUM keywords written
+  through it. A report step after the last one written is appended
+  without reading the file; only a report step which rewinds the file
+  seeks and truncates it. A report step which save() fails to write is
+  truncated away again. The file is flushed at the end of every save(),
+  and closed when the set is destroyed or another file is written.
+*/
+class OutputBuffers {
+public:
+    struct Arrays;
+    struct UnifiedFile;
+
+    OutputBuffers();
+    ~OutputBuffers();
+
+    /* The arrays, cleared and sized for the dimensions in inteHead. */
+    Arrays& reset(const std::vector<int>& inteHead);
+
+    /* The open unified restart file. */
+    UnifiedFile& unifiedFile();
+
+private:
+    std::unique_ptr<Arrays> arrays;
+    std::unique_ptr<UnifiedFile> unified;
+};
+
+/*
+  As save() above, with the restart arrays in reused buffers.
+*/
+void save(const std::string& filename,
+          int report_step,
+          double seconds_elapsed,
+          const RestartValue& value,
+          const EclipseState& es,
+          const EclipseGrid& grid,
+          const Schedule& schedule,
+          const SummaryState& sumState,
+          const Helpers::StaticHeaders& headers,
+          OutputBuffers& buffers,
+          bool write_double = false);
+
 RestartValue load( const std::string& filename,
                    int report_step,
                    const std::vector<RestartKey>& solution_keys,
@@ -102,6 +181,20 @@ RestartValue load( const std::string& filename,
                    const Schedule& schedule,
                    const std::vector<RestartKey>& extra_keys = {});
 
+/*
+  As load() above, but the solution vectors are decoded and converted to
+  SI straight into the caller's buffers, in parallel across the vectors,
+  and the solution of the returned RestartValue is empty. The wells and
+  the extra vectors are returned as from load().
+*/
+RestartValue loadInto( const std::string& filename,
+                       int report_step,
+                       const std::vector<RestartBuffer>& solution_buffers,
+                       const EclipseState& es,
+                       const EclipseGrid& grid,
+                       const Schedule& schedule,
+                       const std::vector<RestartKey>& extra_keys = {});
+
 }
 }
 #endif
@@ -18,8 +18,10 @@
 #ifndef RESTART_VALUE_HPP
 #define RESTART_VALUE_HPP
 
+#include <cstddef>
 #include <string>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
@@ -52,6 +54,56 @@ namespace Opm {
     };
 
 
+    /*
+      A destination in simulator storage for one solution vector, for use
+      with RestartIO::loadInto(). Element i of the buffer receives the
+      value of active cell cells[i] in the restart file, or of active cell
+      i when the buffer is created without a list of cells; e.g. a rank
+      of a parallel simulator passes the global active indices of its own
+      cells. The values are converted to SI units. Only the listed cells
+      are read from an unformatted restart file, not the whole vector;
+      the cells may also be given as half open ranges [first, last) of
+      active indices, e.g. the interior of a rank in a partitioning by
+      slabs.
+    */
+    class RestartBuffer {
+    public:
+
+        RestartKey key;
+        double* data;
+        std::size_t size;
+        std::vector<std::size_t> cells;
+
+        RestartBuffer( RestartKey _key, double* _data, std::size_t _size)
+            : key(std::move(_key)),
+              data(_data),
+              size(_size)
+        {}
+
+
+        RestartBuffer( RestartKey _key, double* _data, std::vector<std::size_t> _cells)
+            : key(std::move(_key)),
+              data(_data),
+              size(_cells.size()),
+              cells(std::move(_cells))
+        {}
+
+
+        RestartBuffer( RestartKey _key, double* _data, const std::vector<std::pair<std::size_t, std::size_t>>& _ranges)
+            : key(std::move(_key)),
+              data(_data),
+              size(0)
+        {
+            for (const auto& range : _ranges)
+                for (std::size_t cell = range.first; cell < range.second; cell++)
+                    this->cells.push_back(cell);
+
+            this->size = this->cells.size();
+        }
+
+    };
+
+
     /*
       A simple class used to communicate values between the simulator and the
       RestartIO function.
@@ -74,6 +126,20 @@ namespace Opm {
 
         void convertFromSI(const UnitSystem& units);
         void convertToSI(const UnitSystem& units);
+
+        /*
+          Per field override of the write_double argument to
+          RestartIO::save(), e.g. to store the pressure in double precision
+          and the saturations in single precision. Fields without an
+          override follow the write_double argument. The overrides are
+          ignored for ECLIPSE compatible restart files, which always store
+          the solution in single precision.
+        */
+        void setOutputPrecision(const std::string& key, bool write_double);
+        bool writeDouble(const std::string& key, bool default_write_double) const;
+
+    private:
+        std::map<std::string, bool> output_double;
     };
 
 }
@@ -20,12 +20,16 @@
 #ifndef OPM_OUTPUT_SUMMARY_HPP
 #define OPM_OUTPUT_SUMMARY_HPP
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
@@ -42,6 +46,8 @@ namespace Opm {
 
 namespace out {
 
+class ColumnarSummary;
+
 class Summary {
     public:
         Summary( const EclipseState&, const SummaryConfig&, const EclipseGrid&, const Schedule& );
@@ -57,21 +63,118 @@ class Summary {
                            const std::map<std::string, std::vector<double>>& region_values = {},
                            const std::map<std::pair<std::string, int>, double>& block_values = {});
 
+        /*
+          The single, region and block values the simulator passes in can
+          also be addressed by slot: value_slot() gives the slot of a
+          single value keyword, or of a region or block keyword and its
+          region or block number, and -1 if the keyword is not in the
+          summary. The slots are fixed when the summary is set up, and
+          add_timestep_slots() takes one SI value per slot, from 0 to
+          num_value_slots() - 1.
+        */
+        int value_slot(const std::string& keyword) const;
+        int value_slot(const std::string& keyword, int num) const;
+        std::size_t num_value_slots() const;
+
+        void add_timestep_slots(int report_step,
+                                double secs_elapsed,
+                                const EclipseState& es,
+                                const Schedule& schedule,
+                                const data::Wells&,
+                                const std::vector<double>& slot_values);
+
+        /*
+          Whether the timestep ending at secs_elapsed is written, according
+          to IOConfig::setSummaryRecording(); a substep is a ministep which
+          does not end a report step. A timestep which is not written is
+          passed to skip_timestep() instead of add_timestep(), which only
+          integrates the totals over it.
+        */
+        bool record_timestep(double secs_elapsed, bool substep) const;
+        void skip_timestep(int report_step,
+                           double secs_elapsed,
+                           const EclipseState& es,
+                           const Schedule& schedule,
+                           const data::Wells&);
+
         void write();
 
         ~Summary();
 
         const SummaryState& get_restart_vectors() const;
 
+        /*
+          Restores the values of the previous report step, e.g. the
+          cumulative totals, from the block of values written to the
+          restart file by RestartIO::save(). The block is ignored with a
+          warning if the summary has a different number of vectors.
+        */
+        void set_restart_vectors(const std::vector<double>& values);
+
+        /*
+          The buffers of the writer, and the timesteps which have not
+          been written yet.
+        */
+        MemoryUsage memory_usage() const;
+
     private:
         class keyword_handlers;
 
+        ecl_sum_tstep_type* begin_timestep(int report_step,
+                                           double secs_elapsed,
+                                           const EclipseState& es,
+                                           const Schedule& schedule,
+                                           const data::Wells&);
+        void end_timestep(ecl_sum_tstep_type* tstep, double secs_elapsed);
+        void check_elapsed(double secs_elapsed, const EclipseState& es) const;
+
         const EclipseGrid& grid;
         out::RegionCache regionCache;
         ERT::ert_unique_ptr< ecl_sum_type, ecl_sum_free > ecl_sum;
         std::unique_ptr< keyword_handlers > handlers;
         double prev_time_elapsed = 0;
+
+        /*
+          The summary files are written incrementally: the first write()
+          stores the SMSPEC file, and every write() appends the timesteps
+          added since the previous one to the data files. The timesteps
+          are not added to ecl_sum, which would keep them all for the
+          length of the run; they are held here until they are written,
+          and the history is only kept in the files.
+        */
+        std::string basename;
+        bool fmt_output = false;
+        bool unified_output = true;
+        bool smspec_written = false;
+        int written_report_step = -1;
+        int next_ministep = 0;
+        using tstep_ptr = ERT::ert_unique_ptr< ecl_sum_tstep_type, ecl_sum_tstep_free >;
+        std::vector< tstep_ptr > unwritten_steps;
+
+        /* The recording policy and the timesteps written and skipped. */
+        std::size_t record_every_nth = 1;
+        double record_interval = 0;
+        std::size_t recorded_steps = 0;
+        std::size_t skipped_steps = 0;
+        double recorded_time = 0;
+
+        /*
+          The optional columnar copy of the time series; its columns,
+          after TIME, are the values of prev_state at columnar_index,
+          which are chosen at the first timestep.
+        */
+        std::size_t columnar_chunk = 0;
+        std::unique_ptr< ColumnarSummary > columnar;
+        std::vector< std::size_t > columnar_index;
+        std::vector< double > columnar_row;
+        void append_columnar( double sim_days );
+
         SummaryState prev_state;
+        /*
+          Work area for add_timestep(); has the same keys as prev_state and
+          is swapped with it at the end of every timestep.
+        */
+        SummaryState state;
 };
 
 }
@@ -0,0 +1,96 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_UNFORMATTED_ARRAY_HPP
+#define OPM_UNFORMATTED_ARRAY_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// \file
+///
+/// Byte layout of the arrays of unformatted (binary) ECLIPSE files,
+/// for writing the cells of a distributed array directly into their
+/// final position in the file.
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    /// One numeric array of an unformatted ECLIPSE file: a header
+    /// record with the keyword, the number of elements and the type,
+    /// followed by the values in Fortran records of at most 1000
+    /// big-endian elements each.
+    ///
+    /// Since the position of every element in the file is known up
+    /// front, the ranks of a parallel run can each write the values
+    /// of their own cells, without gathering the global array onto
+    /// one rank: one rank writes the frame -- the header and the
+    /// record markers -- and every rank writes its values with
+    /// writeValues().  The streams must be opened for writing without
+    /// truncation, e.g. std::ios::in | std::ios::out | std::ios::binary,
+    /// and the result is the same file as if the global array had been
+    /// written sequentially.
+    class UnformattedArray
+    {
+    public:
+        enum class Type { Integer, Float, Double };
+
+        /// \param[in] keyword Array name, at most eight characters.
+        /// \param[in] type Element type in the file.
+        /// \param[in] size Number of elements in the global array.
+        UnformattedArray(const std::string& keyword, Type type, std::size_t size);
+
+        std::size_t size() const;
+
+        /// Number of bytes the array occupies in the file.
+        std::size_t byteSize() const;
+
+        /// Position of element \p index relative to the start of the array.
+        std::size_t elementOffset(std::size_t index) const;
+
+        /// Write the header record and the record markers of the array
+        /// starting at position \p offset of the stream.
+        void writeFrame(std::ostream& os, std::size_t offset) const;
+
+        /// Write the values of the cells with the given global indices,
+        /// converted to the element type of the array.  Consecutive
+        /// global indices are written with a single write per record.
+        void writeValues(std::ostream& os, std::size_t offset,
+                         const std::vector<double>& values,
+                         const std::vector<std::size_t>& globalIndex) const;
+
+        void writeValues(std::ostream& os, std::size_t offset,
+                         const std::vector<int>& values,
+                         const std::vector<std::size_t>& globalIndex) const;
+
+    private:
+        template <typename T>
+        void write(std::ostream& os, std::size_t offset,
+                   const std::vector<T>& values,
+                   const std::vector<std::size_t>& globalIndex) const;
+
+        std::string keyword;
+        Type type;
+        std::size_t count;
+    };
+
+}}} // Opm::RestartIO::Helpers
+
+#endif // OPM_UNFORMATTED_ARRAY_HPP
@@ -21,6 +21,8 @@
 #define OPM_WINDOWED_ARRAY_HPP
 
 #include <cassert>
+#include <cstddef>
+#include <exception>
 #include <iterator>
 #include <type_traits>
 #include <vector>
@@ -74,6 +76,18 @@ namespace Opm { namespace RestartIO { namespace Helpers {
             , windowSize_(sz.value)
         {}
 
+        /// Reset all data items to their default value and change the
+        /// number of windows and the window size.  Reuses the existing
+        /// storage if it is large enough.
+        ///
+        /// \param[in] n Number of windows.
+        /// \param[in] sz Number of data items per window.
+        void reset(const NumWindows n, const WindowSize sz)
+        {
+            this->x_.assign(n.value * sz.value, T{});
+            this->windowSize_ = sz.value;
+        }
+
         /// Retrieve number of windows allocated for this array.
         Idx numWindows() const
         {
@@ -181,6 +195,21 @@ namespace Opm { namespace RestartIO { namespace Helpers {
             , numCols_(nCols.value)
         {}
 
+        /// Reset all data items to their default value and change the
+        /// matrix dimensions.  Reuses the existing storage if it is
+        /// large enough.
+        ///
+        /// \param[in] nRows Number of rows.
+        /// \param[in] nCols Number of columns.
+        /// \param[in] sz Number of data items per (row,column) window.
+        void reset(const NumRows&    nRows,
+                   const NumCols&    nCols,
+                   const WindowSize& sz)
+        {
+            this->data_.reset(NumWindows{ nRows.value * nCols.value }, sz);
+            this->numCols_ = nCols.value;
+        }
+
         /// Retrieve number of columns allocated for this matrix.
         Idx numCols() const
         {
@@ -257,6 +286,38 @@ namespace Opm { namespace RestartIO { namespace Helpers {
         }
     };
 
+    /// Invoke op(i) for all i in [0, n), in parallel if OpenMP is
+    /// available.
+    ///
+    /// Intended for filling the windows of \c WindowedArray and \c
+    /// WindowedMatrix objects, one entity (e.g., well) per call, so
+    /// different calls never touch the same items.  The first exception
+    /// thrown by \p op is rethrown once all calls have finished.
+    ///
+    /// \tparam Op Callable with signature void(std::size_t).
+    template <typename Op>
+    void parallelFor(const std::size_t n, Op&& op)
+    {
+        std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (long long i = 0; i < static_cast<long long>(n); ++i) {
+            try {
+                op(static_cast<std::size_t>(i));
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(opm_restart_parallel_for)
+#endif
+                if (! error) { error = std::current_exception(); }
+            }
+        }
+
+        if (error) { std::rethrow_exception(error); }
+    }
+
 }}} // Opm::RestartIO::Helpers
 
 #endif // OPM_WINDOW_ARRAY_HPP
@@ -22,6 +22,8 @@
 
 #include <vector>
 
+#include <opm/output/eclipse/InteHEAD.hpp>
+
 // Missing definitions (really belong in ert/ecl_well/well_const.h, but not
 // defined there)
 #define SCON_KH_INDEX 3
@@ -63,6 +65,30 @@ namespace Opm { namespace RestartIO { namespace Helpers {
     createLogiHead(const EclipseState& es);
 
 
+    /*
+      The restart header items which are the same at every report step:
+      the grid and array dimensions, units, phases and region dimensions
+      of INTEHEAD, and all of LOGIHEAD. A writer creates these once and
+      passes them to createInteHead(), which then only fills in the items
+      which depend on the report step, e.g. the number of wells, the date
+      and the tuning parameters.
+    */
+    struct StaticHeaders {
+        StaticHeaders(const EclipseState& es, const EclipseGrid& grid);
+
+        InteHEAD          inteHead;
+        std::vector<bool> logiHead;
+    };
+
+    std::vector<int>
+    createInteHead(const StaticHeaders& headers,
+                   const EclipseState&  es,
+                   const Schedule&      sched,
+                   const double         simTime,
+                   const int            num_solver_steps,
+                   const int            lookup_step);
+
+
     std::vector<int> serialize_ICON(int lookup_step, // The integer index used to look up dynamic properties, e.g. the number of well.
                                     int ncwmax,      // Max number of completions per well, should be entry 17 from createInteHead.
                                     int niconz,      // Number of elements per completion in ICON, should be entry 32 from createInteHead.
@@ -562,6 +562,9 @@ void ecl_kw_memcpy(::Opm::RestartIO::ecl_kw_type *target, const ::Opm::RestartIO
 ::Opm::RestartIO::ecl_file_kw_type * ecl_file_kw_alloc0( const char * header , ::Opm::RestartIO::ecl_data_type data_type , int size , ::Opm::RestartIO::offset_type offset);
 bool   ecl_file_kw_fskip_data( const ::Opm::RestartIO::ecl_file_kw_type * file_kw , fortio_type * fortio);
 const char * ecl_file_kw_get_header( const ::Opm::RestartIO::ecl_file_kw_type * file_kw );
+int          ecl_file_kw_get_size( const ::Opm::RestartIO::ecl_file_kw_type * file_kw );
+bool         ecl_file_view_index_fread_kw( const ::Opm::RestartIO::ecl_file_view_type * ecl_file_view , const char * kw , int ith ,
+                                           const std::size_t * index , std::size_t index_size , double * data);
 
 bool   ecl_kw_fskip_data__( ::Opm::RestartIO::ecl_data_type, int, fortio_type *);
 ::Opm::RestartIO::ecl_data_type   ecl_file_kw_get_data_type(const ::Opm::RestartIO::ecl_file_kw_type * file_kw);
@@ -20,11 +20,13 @@
 #ifndef DECK_HPP
 #define DECK_HPP
 
+#include <iterator>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include <boost/filesystem.hpp>
 
@@ -60,6 +62,79 @@ namespace Opm {
         public:
             typedef std::vector< DeckKeyword >::const_iterator const_iterator;
 
+            /*
+              The occurrences of one keyword in the view, in deck order.
+              The range is a pair of iterators into the shared keyword
+              index and the keywords of the deck, so it is cheap to
+              create and copy and does not allocate; it is only valid as
+              long as the deck is alive and unchanged. A range can be
+              kept to count, index and iterate the occurrences without
+              looking up the keyword again:
+
+                 const auto wells = deck.getKeywordRange< ParserKeywords::WELSPECS >();
+                 for( const auto& keyword : wells ) ...
+            */
+            class KeywordRange {
+                public:
+                    using offset_iterator = std::vector< size_t >::const_iterator;
+
+                    class iterator : public std::iterator< std::random_access_iterator_tag,
+                                                           const DeckKeyword > {
+                        public:
+                            iterator() = default;
+                            iterator( offset_iterator pos, const_iterator keywords, size_t start ) :
+                                pos( pos ), keywords( keywords ), start( start )
+                            {}
+
+                            const DeckKeyword& operator*() const { return this->keywords[ *this->pos - this->start ]; }
+                            const DeckKeyword* operator->() const { return &**this; }
+                            const DeckKeyword& operator[]( difference_type n ) const { return *( *this + n ); }
+
+                            iterator& operator++() { ++this->pos; return *this; }
+                            iterator operator++( int ) { auto tmp = *this; ++this->pos; return tmp; }
+                            iterator& operator--() { --this->pos; return *this; }
+                            iterator operator--( int ) { auto tmp = *this; --this->pos; return tmp; }
+                            iterator& operator+=( difference_type n ) { this->pos += n; return *this; }
+                            iterator& operator-=( difference_type n ) { this->pos -= n; return *this; }
+                            iterator operator+( difference_type n ) const { auto tmp = *this; return tmp += n; }
+                            iterator operator-( difference_type n ) const { auto tmp = *this; return tmp -= n; }
+                            difference_type operator-( const iterator& rhs ) const { return this->pos - rhs.pos; }
+
+                            bool operator==( const iterator& rhs ) const { return this->pos == rhs.pos; }
+                            bool operator!=( const iterator& rhs ) const { return this->pos != rhs.pos; }
+                            bool operator<( const iterator& rhs ) const { return this->pos < rhs.pos; }
+                            bool operator>( const iterator& rhs ) const { return this->pos > rhs.pos; }
+                            bool operator<=( const iterator& rhs ) const { return this->pos <= rhs.pos; }
+                            bool operator>=( const iterator& rhs ) const { return this->pos >= rhs.pos; }
+
+                        private:
+                            offset_iterator pos;
+                            const_iterator keywords;
+                            size_t start = 0;
+                    };
+
+                    KeywordRange( offset_iterator lo, offset_iterator hi,
+                                  const_iterator keywords, size_t start ) :
+                        lo( lo ), hi( hi ), keywords( keywords ), start( start )
+                    {}
+
+                    iterator begin() const { return iterator( this->lo, this->keywords, this->start ); }
+                    iterator end() const { return iterator( this->hi, this->keywords, this->start ); }
+
+                    size_t size() const { return std::distance( this->lo, this->hi ); }
+                    bool empty() const { return this->lo == this->hi; }
+
+                    const DeckKeyword& operator[]( size_t index ) const { return this->begin()[ index ]; }
+                    const DeckKeyword& front() const { return *this->begin(); }
+                    const DeckKeyword& back() const { return *( this->end() - 1 ); }
+
+                private:
+                    offset_iterator lo;
+                    offset_iterator hi;
+                    const_iterator keywords;
+                    size_t start;
+            };
+
             bool hasKeyword( const DeckKeyword& keyword ) const;
             bool hasKeyword( const std::string& keyword ) const;
             template< class Keyword >
@@ -86,6 +161,12 @@ namespace Opm {
                 return getKeywordList( Keyword::keywordName );
             }
 
+            KeywordRange getKeywordRange( const std::string& keyword ) const;
+            template< class Keyword >
+            KeywordRange getKeywordRange() const {
+                return getKeywordRange( Keyword::keywordName );
+            }
+
             size_t count(const std::string& keyword) const;
             size_t size() const;
 
@@ -94,19 +175,45 @@ namespace Opm {
 
 
         protected:
+            using KeywordIndex = std::unordered_map< std::string, std::vector< size_t > >;
+            using offset_range = std::pair< std::vector< size_t >::const_iterator,
+                                            std::vector< size_t >::const_iterator >;
+
             void add( const DeckKeyword*, const_iterator, const_iterator );
 
-            const std::vector< size_t >& offsets( const std::string& ) const;
+            /*
+              The positions of the keyword in the view, as a range of
+              positions in the whole deck; subtract start() to get the
+              position in the view.
+            */
+            offset_range offsets( const std::string& ) const;
+            size_t start() const;
 
             DeckView( const_iterator first, const_iterator last );
-            explicit DeckView( std::pair< const_iterator, const_iterator > );
+
+            /*
+              The keywords [first, last) of the view 'whole', sharing its
+              keyword index.
+            */
+            DeckView( const DeckView& whole, size_t first, size_t last );
 
             void reinit( const_iterator, const_iterator );
 
+            /* The bytes allocated by the keyword index. */
+            size_t indexMemoryUsage() const;
+
         private:
             const_iterator first;
             const_iterator last;
-            std::map< std::string, std::vector< size_t > > keywordMap;
+
+            /*
+              The sorted positions of the keywords in the whole deck, by
+              name. The index is built once for the deck and shared by all
+              the views into it, e.g. the sections, which find their own
+              keywords by binary search for their range of positions.
+            */
+            std::shared_ptr< KeywordIndex > keywordIndex;
+            size_t first_position = 0;
 
     };
 
@@ -116,6 +223,8 @@ namespace Opm {
             using DeckView::hasKeyword;
             using DeckView::getKeyword;
             using DeckView::getKeywordList;
+            using DeckView::KeywordRange;
+            using DeckView::getKeywordRange;
             using DeckView::count;
             using DeckView::size;
             using DeckView::begin;
@@ -130,6 +239,7 @@ namespace Opm {
             Deck( std::initializer_list< std::string > );
 
             Deck( const Deck& );
+            Deck( Deck&& );
 
             //! \brief Deleted assignment operator.
             Deck& operator=(const Deck& rhs) = delete;
@@ -149,11 +259,45 @@ namespace Opm {
             void setDataFile(const std::string& dataFile);
             std::string makeDeckPath(const std::string& path) const;
 
+            /*
+              The canonical paths of all the files the deck was read
+              from, the DATA file first. Only set by parseFile() when
+              all the input files could be read; empty otherwise.
+            */
+            const std::vector< std::string >& getInputFiles() const;
+            void setInputFiles(const std::vector< std::string >& inputFiles);
+
             iterator begin();
             iterator end();
             void write( DeckOutput& output ) const ;
             friend std::ostream& operator<<(std::ostream& os, const Deck& deck);
+
+            /*
+              The keywords are summed up by name, with the largest
+              keywords first.
+            */
+            MemoryUsage memory_usage() const;
+
+            /*
+              Converts the items with at least min_size values to SI
+              units up front, instead of on the first
+              getSIDoubleData() of each item.
+            */
+            void convertToSI( size_t min_size ) const;
+
+            /*
+              The content fingerprint of all the keywords in order, and
+              of the keywords read from one file, by the file name of
+              DeckKeyword::getFileName(); a file without keywords has the
+              empty Fingerprint(). Both are updated as the keywords are
+              added, from the fingerprints of the keywords, so comparing
+              decks or looking up a file takes constant time.
+            */
+            const Fingerprint& fingerprint() const;
+            Fingerprint fingerprint( const std::string& fileName ) const;
         private:
+            friend class Section;
+
             Deck( std::vector< DeckKeyword >&& );
 
             std::vector< DeckKeyword > keywordList;
@@ -162,6 +306,12 @@ namespace Opm {
 
             std::string m_dataFile;
             std::string input_path;
+            std::vector< std::string > input_files;
+
+            Fingerprint m_fingerprint;
+            std::map< std::string, Fingerprint > m_fileFingerprints;
+
+            void addFingerprint( const DeckKeyword& keyword );
     };
 }
 #endif  /* DECK_HPP */
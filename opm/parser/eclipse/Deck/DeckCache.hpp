@@ -0,0 +1,102 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DECK_CACHE_HPP
+#define DECK_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    class Deck;
+    class DeckKeyword;
+
+    /*
+     * Binary cache of a fully parsed deck, i.e. the keyword, record and item
+     * trees with the unit dimensions applied by the parser. The cache file
+     * stores the size and a content hash of every file which went into the
+     * deck, and is only used if all of them are unchanged. The key is chosen
+     * by the caller and should capture everything else the deck depends on,
+     * like the keyword definitions and the ParseContext.
+     *
+     * The file is stored next to the DATA file: CASE.DATA is cached as
+     * CASE.DECKCACHE.
+     */
+    class DeckCache {
+    public:
+        static std::string cacheFile( const std::string& dataFile );
+
+        /*
+         * Load the deck from the cache file. Returns false, leaving the deck
+         * untouched, if the cache is missing, unreadable, written with
+         * another key or if any of the input files have changed.
+         */
+        static bool load( const std::string& cacheFile, std::uint64_t key, Deck& deck );
+
+        /*
+         * Write the deck to the cache file. The file is written to a
+         * temporary and moved in place, so concurrent readers never see a
+         * partial cache. Failing to write the cache is not an error, and is
+         * reported by returning false.
+         */
+        static bool save( const std::string& cacheFile,
+                          std::uint64_t key,
+                          const std::vector< std::string >& inputFiles,
+                          const Deck& deck );
+
+        /*
+         * The keywords of a single include file, cached in a directory next
+         * to the DATA file: the includes of CASE.DATA are cached in
+         * CASE.INCLUDECACHE, one file per include named by the hash of its
+         * path. An entry stores the size and the content hash of the include
+         * file and is used as long as these and the key are unchanged, so
+         * the unchanged includes of an edited deck are not parsed again.
+         * The caller must only cache files which parse the same in any deck,
+         * i.e. without keywords sized by other keywords, nested includes or
+         * PATHS aliases.
+         */
+        static std::string includeCacheDir( const std::string& dataFile );
+        static std::string includeCacheFile( const std::string& cacheDir,
+                                             const std::string& includeFile );
+
+        static bool loadKeywords( const std::string& cacheFile,
+                                  std::uint64_t key,
+                                  const std::string& includeFile,
+                                  std::vector< DeckKeyword >& keywords );
+
+        /* Caches the keywords [first, last) of the deck. */
+        static bool saveKeywords( const std::string& cacheFile,
+                                  std::uint64_t key,
+                                  const std::string& includeFile,
+                                  const Deck& deck,
+                                  std::size_t first,
+                                  std::size_t last );
+
+        /* 64 bit FNV-1a, chainable through the seed. */
+        static std::uint64_t hash( const char* data, std::size_t size,
+                                   std::uint64_t seed = 14695981039346656037ULL );
+        static std::uint64_t hash( const std::string& data,
+                                   std::uint64_t seed = 14695981039346656037ULL );
+    };
+}
+
+#endif
@@ -26,6 +26,8 @@
 #include <ostream>
 
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
+#include <opm/parser/eclipse/Utility/Symbol.hpp>
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Opm {
@@ -40,6 +42,12 @@ namespace Opm {
         DeckItem( const std::string&, double, size_t size_hint = 8 );
         DeckItem( const std::string&, std::string, size_t size_hint = 8 );
 
+        // The parser creates its items from the interned item names.
+        explicit DeckItem( Symbol );
+        DeckItem( Symbol, int, size_t size_hint = 8 );
+        DeckItem( Symbol, double, size_t size_hint = 8 );
+        DeckItem( Symbol, std::string, size_t size_hint = 8 );
+
         const std::string& name() const;
 
         // return true if the default value was used for a given data point
@@ -65,6 +73,35 @@ namespace Opm {
         template< typename T > const std::vector< T >& getData() const;
         const std::vector< double >& getSIDoubleData() const;
 
+        /*
+          Performs the conversion of getSIDoubleData() ahead of the first
+          call, see Deck::convertToSI(); items which are not double
+          items with dimensions, or have context dependent units, are
+          left as they are.
+        */
+        void convertToSI() const;
+
+        /*
+          Move the values out of the item instead of copying them; the
+          item is left without values. releaseSIDoubleData() converts
+          the values to SI units in place.
+        */
+        template< typename T > std::vector< T > releaseData();
+        std::vector< double > releaseSIDoubleData();
+
+        /*
+          Numeric items with long N*value runs in the input, e.g. ACTNUM
+          1000000*1 or PORO 400*0.25 ..., are stored as runs of repeated
+          values, and are only expanded when the dense values are asked
+          for. Run i holds getRunLengths()[i] copies of
+          getRunValues<T>()[i]; the run lengths are empty for items which
+          are stored value by value. getSIRunValues() are the run values
+          converted to SI units.
+        */
+        const std::vector< size_t >& getRunLengths() const;
+        template< typename T > const std::vector< T >& getRunValues() const;
+        std::vector< double > getSIRunValues() const;
+
         void push_back( int );
         void push_back( double );
         void push_back( std::string );
@@ -106,24 +143,62 @@ namespace Opm {
         bool operator==(const DeckItem& other) const;
         bool operator!=(const DeckItem& other) const;
 
+        /* The bytes allocated by the item, not counting the item object itself. */
+        std::size_t memory_usage() const;
+
+        /*
+          The content fingerprint of the item: the name, the type, the
+          values as they were read and which of them are defaulted. The
+          dimensions are not included; they follow from the keyword and
+          the unit system of the deck. The values are added as runs of
+          equal values, so an item stored as runs has the same
+          fingerprint as the same values stored value by value.
+        */
+        Fingerprint fingerprint() const;
+
     private:
+        friend struct DeckCacheIO;
+
         std::vector< double > dval;
         std::vector< int > ival;
         std::vector< std::string > sval;
 
         type_tag type = type_tag::unknown;
 
-        std::string item_name;
+        Symbol item_name;
         std::vector< bool > defaulted;
         std::vector< Dimension > dimensions;
-        mutable std::vector< double > SIdata;
+
+        /*
+          The values converted to SI units, created on the first call to
+          getSIDoubleData(). The vector is published with the atomic
+          shared_ptr functions, so concurrent readers of a const item
+          see either no data or the complete conversion.
+        */
+        mutable std::shared_ptr< const std::vector< double > > SIdata;
+
+        /*
+          While the item is stored as runs, ival or dval hold one value
+          per run and run_size is the number of values. The expanded
+          values are created on the first request for them, and published
+          like SIdata; the pointer is to a std::vector of the item type.
+        */
+        std::vector< size_t > runs;
+        size_t run_size = 0;
+        mutable std::shared_ptr< const void > dense;
 
         template< typename T > std::vector< T >& value_ref();
         template< typename T > const std::vector< T >& value_ref() const;
+        template< typename T > const std::vector< T >& values() const;
+        template< typename T > std::vector< T > expandRuns( const std::vector< T >& ) const;
+        template< typename T > void expand();
+        template< typename T > void push_run( T, size_t, bool );
         template< typename T > void push( T );
         template< typename T > void push( T, size_t );
         template< typename T > void push_default( T );
         template< typename T > void write_vector(DeckOutput& writer, const std::vector<T>& data) const;
+        template< typename T > void write_runs(DeckOutput& writer) const;
+        void convertToSI( const double* raw, double* si, size_t size ) const;
     };
 }
 #endif  /* DECKITEM_HPP */
@@ -24,7 +24,10 @@
 #include <vector>
 #include <memory>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
+#include <opm/parser/eclipse/Utility/Symbol.hpp>
 
 namespace Opm {
     class ParserKeyword;
@@ -63,7 +66,7 @@ namespace Opm {
 
         template <class Keyword>
         bool isKeyword() const {
-            if (Keyword::keywordName == m_keywordName)
+            if (Keyword::keywordName == m_keywordName.str())
                 return true;
             else
                 return false;
@@ -76,16 +79,31 @@ namespace Opm {
         bool operator==(const DeckKeyword& other) const;
         bool operator!=(const DeckKeyword& other) const;
 
+        /* The keyword object with all its records, named by the keyword. */
+        MemoryUsage memory_usage() const;
+
+        /*
+          The content fingerprint of the name and the records, updated as
+          the records are added; it describes the keyword as it was read,
+          and is not updated when the records are modified through
+          getRecord(), e.g. when a grid property takes over the data of
+          the keyword. The location is not part of the fingerprint.
+        */
+        const Fingerprint& fingerprint() const;
+
         friend std::ostream& operator<<(std::ostream& os, const DeckKeyword& keyword);
     private:
-        std::string m_keywordName;
-        std::string m_fileName;
+        friend struct DeckCacheIO;
+
+        Symbol m_keywordName;
+        Symbol m_fileName;
         int m_lineNumber;
 
         std::vector< DeckRecord > m_recordList;
         bool m_knownKeyword;
         bool m_isDataKeyword;
         bool m_slashTerminated;
+        Fingerprint m_fingerprint;
     };
 }
 
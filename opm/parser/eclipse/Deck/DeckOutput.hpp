@@ -26,6 +26,19 @@
 
 namespace Opm {
 
+    /*
+      Formats a deck, or keywords one at a time, to a stream. The output
+      is assembled in an internal buffer which is handed to the stream in
+      large blocks; the buffer is flushed at the end of every item,
+      record and keyword and when the DeckOutput goes out of scope, so
+      the stream can be written to directly between keywords. Numbers are
+      formatted without going through the stream, the doubles with the
+      same format as an ostream with the given precision.
+
+      Keywords can be written as they are produced, without building a
+      Deck, with DeckKeyword::write() followed by the keyword_sep string.
+    */
+
     class DeckOutput {
     public:
         explicit DeckOutput(std::ostream& s, int precision = 10);
@@ -43,20 +56,30 @@ namespace Opm {
         void write_string(const std::string& s);
         template <typename T> void write(const T& value);
 
+        /*
+          Write count copies of the value, as N*value if compress_repeats
+          is set.
+        */
+        template <typename T> void write(const T& value, size_t count);
+        void flush();
+
         std::string item_sep = " ";        // Separator between items on a row.
         size_t      columns = 16;          // The maximum number of columns on a record.
         std::string record_indent = "   "; // The indentation when starting a new line.
         std::string keyword_sep = "\n\n";  // The separation between keywords;
+        bool        compress_repeats = false; // Write repeated values as N*value.
     private:
         std::ostream& os;
+        std::string buffer;
         size_t default_count;
         size_t row_count;
         bool record_on;
-        int org_precision;
+        int precision;
 
         template <typename T> void write_value(const T& value);
+        void write_count(size_t count);
         void write_sep( );
-        void set_precision(int precision);
+        void flush_full( );
     };
 }
 
@@ -70,6 +70,12 @@ namespace Opm {
         bool operator==(const DeckRecord& other) const;
         bool operator!=(const DeckRecord& other) const;
 
+        /* The bytes allocated by the record and its items. */
+        std::size_t memory_usage() const;
+
+        /* The fingerprints of the items, in order. */
+        Fingerprint fingerprint() const;
+
     private:
         std::vector< DeckItem > m_items;
 
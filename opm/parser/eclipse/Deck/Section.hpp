@@ -21,6 +21,8 @@
 #define SECTION_HPP
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
@@ -46,6 +48,14 @@ class Section : public DeckView {
         static bool hasSUMMARY( const Deck& );
         static bool hasSCHEDULE( const Deck& );
 
+        // true for the keywords which start a section, e.g. GRID
+        static bool isSectionName( const std::string& keyword );
+
+        // the positions of the keywords which start a section in the deck,
+        // in increasing order; found from the keyword index of the deck
+        // without going through the keywords
+        static std::vector< size_t > sectionOffsets( const Deck& deck );
+
         // returns whether the deck has all mandatory sections and if all sections are in
         // the right order
         static bool checkSectionTopology(const Deck& deck,
@@ -53,6 +63,8 @@ class Section : public DeckView {
                                          bool ensureKeywordSectionAffiliation = false);
 
     private:
+        Section( const Deck& deck, const std::string& startKeyword, std::pair< size_t, size_t > range );
+
         std::string section_name;
         const UnitSystem& units;
 
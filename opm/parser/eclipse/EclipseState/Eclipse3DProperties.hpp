@@ -54,39 +54,72 @@ namespace Opm {
                             const TableManager& tableManager,
                             const EclipseGrid& eclipseGrid);
 
+        /// As above, but the values of the grid property keywords are
+        /// moved out of the deck where possible instead of copied; those
+        /// keywords are left without values, the rest of the deck is
+        /// unchanged.
+        Eclipse3DProperties(Deck&& deck,
+                            const TableManager& tableManager,
+                            const EclipseGrid& eclipseGrid);
+
         Eclipse3DProperties( UnitSystem unit_system,
                              const TableManager& tableManager,
                              const EclipseGrid& eclipseGrid);
 
-        std::vector< int > getRegions( const std::string& keyword ) const;
+        /// The distinct values of the region property keyword, in
+        /// increasing order; empty if the property is not in the deck.
+        /// The values are cached with the property, and the reference
+        /// stays valid until the property is modified.
+        const std::vector< int >& getRegions( const std::string& keyword ) const;
         std::string getDefaultRegionKeyword() const;
 
         const GridProperty<int>&      getIntGridProperty     ( const std::string& keyword ) const;
         const GridProperty<double>&   getDoubleGridProperty  ( const std::string& keyword ) const;
 
+        /// The properties by handle, see GridProperties::keywordHandle();
+        /// resolve the handle once where a property is looked up often.
+        GridProperties<int>::Handle    intGridPropertyHandle   ( const std::string& keyword ) const;
+        GridProperties<double>::Handle doubleGridPropertyHandle( const std::string& keyword ) const;
+        const GridProperty<int>&      getIntGridProperty     ( GridProperties<int>::Handle handle ) const;
+        const GridProperty<double>&   getDoubleGridProperty  ( GridProperties<double>::Handle handle ) const;
+
         const GridProperties<int>& getIntProperties() const;
         const GridProperties<double>& getDoubleProperties() const;
 
+        /// Stores the properties compactly where the values allow - by
+        /// layer, and the integer properties in 8 or 16 bits - see
+        /// GridProperty::compact(); called once the deck is processed.
+        void compactProperties();
+
+        MemoryUsage memory_usage() const;
+
         bool hasDeckIntGridProperty(const std::string& keyword) const;
         bool hasDeckDoubleGridProperty(const std::string& keyword) const;
         bool supportsGridProperty(const std::string& keyword) const;
 
     private:
+        Eclipse3DProperties(const Deck& deck,
+                            const TableManager& tableManager,
+                            const EclipseGrid& eclipseGrid,
+                            bool consumeDeck);
+
         const GridProperty<int>& getRegion(const DeckItem& regionItem) const;
         void processGridProperties(const Deck& deck,
-                                   const EclipseGrid& eclipseGrid);
+                                   const EclipseGrid& eclipseGrid,
+                                   bool consumeDeck);
 
         void scanSection(const Section& section,
-                         const EclipseGrid& eclipseGrid);
+                         const EclipseGrid& eclipseGrid,
+                         bool consumeDeck);
 
-        void handleADDKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleADDKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
         void handleBOXKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleCOPYKeyword(    const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleCOPYKeyword(    const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
         void handleENDBOXKeyword(  BoxManager& boxManager);
-        void handleEQUALSKeyword(  const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleMAXVALUEKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleMINVALUEKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleMULTIPLYKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleEQUALSKeyword(  const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
+        void handleMAXVALUEKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
+        void handleMINVALUEKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
+        void handleMULTIPLYKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations);
 
         void handleADDREGKeyword(  const DeckKeyword& deckKeyword );
         void handleCOPYREGKeyword( const DeckKeyword& deckKeyword );
@@ -96,7 +129,8 @@ namespace Opm {
         void handleOPERATERKeyword( const DeckKeyword& deckKeyword);
 
         void loadGridPropertyFromDeckKeyword(const Box& inputBox,
-                                             const DeckKeyword& deckKeyword);
+                                             const DeckKeyword& deckKeyword,
+                                             bool consumeDeck);
 
         std::string            m_defaultRegion;
         UnitSystem             m_deckUnitSystem;
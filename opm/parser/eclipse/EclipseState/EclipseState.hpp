@@ -21,8 +21,11 @@
 #define OPM_ECLIPSE_STATE_HPP
 
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseConfig.hpp>
@@ -56,6 +59,13 @@ namespace Opm {
     class TableManager;
     class UnitSystem;
 
+    /*
+      A fully constructed EclipseState may be shared read-only between
+      threads: the values its const methods compute on first use - the
+      grid geometry, grid properties and their region indices, and the
+      SI values of the deck items - are built once and handed to all the
+      threads which ask for them.
+    */
     class EclipseState {
     public:
         enum EnabledTypes {
@@ -67,6 +77,36 @@ namespace Opm {
 
         EclipseState(const Deck& deck , const ParseContext& parseContext = ParseContext());
 
+        /*
+          As above, but the grid properties take over the arrays of the
+          grid property keywords, and the COORD and ZCORN values are
+          released once the grid has been built, instead of being
+          copied; the bulk of a large deck is then held only once. The
+          items of those keywords are left empty, everything else in
+          the deck is intact and can still be used to build the
+          Schedule and the SummaryConfig.
+        */
+        EclipseState(Deck&& deck , const ParseContext& parseContext = ParseContext());
+
+        /*
+          The state of an edited deck, where changedKeywords are the
+          names of the keywords which have been added, removed or
+          modified since previous was built. The table manager, the
+          input grid and the EclipseConfig of previous are reused when
+          none of the changed keywords affect them; in particular when
+          only grid properties, property operations, faults and
+          multipliers have changed the grid is not processed again.
+          The grid properties, the transmissibility multipliers, the
+          faults and the simulation configuration refer to each other
+          and are always rebuilt. A Schedule holds on to the grid and
+          the properties of the state it was built with, and must be
+          built again from the new state.
+        */
+        EclipseState(const EclipseState& previous,
+                     const Deck& deck,
+                     const std::set<std::string>& changedKeywords,
+                     const ParseContext& parseContext = ParseContext());
+
         const IOConfig& getIOConfig() const;
         IOConfig& getIOConfig();
 
@@ -95,6 +135,17 @@ namespace Opm {
         const EclipseConfig& getEclipseConfig() const;
         const EclipseConfig& cfg() const;
 
+        /*
+          The J-function scaling of the capillary pressure of every
+          cell, PORO^alpha / PERM^beta with the alpha and beta factors
+          of JFUNC and the permeability in the JFUNC direction, the
+          mean of PERMX and PERMY for XY, in SI units. The capillary
+          pressure in Pa is the tabulated J value times this factor
+          times the surface tension in N/m. Empty unless the deck has
+          JFUNC.
+        */
+        const std::vector<double>& getJFuncScaling() const;
+
         // the unit system used by the deck. note that it is rarely needed to convert
         // units because internally to opm-parser everything is represented by SI
         // units...
@@ -107,10 +158,43 @@ namespace Opm {
 
         const Runspec& runspec() const;
 
+        /* The grid, the properties, the tables and the NNCs. */
+        MemoryUsage memory_usage() const;
+
     private:
+        enum Components {
+            TableComponent = 0x01,
+            GridComponent = 0x02,
+            ConfigComponent = 0x04,
+
+            AllComponents = TableComponent | GridComponent | ConfigComponent
+        };
+
+        EclipseState(const EclipseState& previous,
+                     const Deck& deck,
+                     const ParseContext& parseContext,
+                     int rebuild);
+
+        /*
+          The table manager, the EclipseConfig and the input grid only
+          depend on the deck, and are built concurrently before the
+          members which depend on them.
+        */
+        struct DeckComponents;
+        static DeckComponents buildComponents(const Deck& deck, const ParseContext& parseContext);
+
+        EclipseState(const Deck& deck, DeckComponents&& components);
+        EclipseState(Deck&& deck, DeckComponents&& components);
+
+        static int affectedComponents(const EclipseState& previous,
+                                      const Deck& deck,
+                                      const std::set<std::string>& changedKeywords);
+
+        void initState(const Deck& deck);
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
         void initFaults(const Deck& deck);
+        void initJFuncScaling();
 
         void setMULTFLT(const Opm::Section& section);
 
@@ -130,6 +214,7 @@ namespace Opm {
 
         FaultCollection m_faults;
         std::string m_title;
+        std::vector<double> m_jfuncScaling;
 
     };
 }
@@ -21,13 +21,54 @@
 #ifndef BOX_HPP_
 #define BOX_HPP_
 
-#include <vector>
 #include <cstddef>
+#include <iterator>
+#include <vector>
 
 namespace Opm {
 
+    /*
+      The Box class describes a BOX region of the grid. The cells of the
+      box are not stored; the box is traversed as runs of consecutive
+      global indices, one for each (j,k) row of the box. When the box
+      spans the whole grid in the i direction the rows are contiguous and
+      are merged, and when it also spans the whole grid in the j direction
+      the layers are merged as well, so the global box is a single range.
+
+      The ranges are numbered in the order of the cells in the box, with i
+      running fastest; range number r covers the cells [r*rangeSize(),
+      (r + 1)*rangeSize()) of the box.
+    */
+
     class Box {
     public:
+        /*
+          Iterates over the global indices of the cells in the box.
+        */
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            const_iterator() = default;
+            const_iterator(const Box& box, size_t range);
+
+            size_t operator*() const;
+            const_iterator& operator++();
+            const_iterator operator++(int);
+            bool operator==(const const_iterator& other) const;
+            bool operator!=(const const_iterator& other) const;
+
+        private:
+            const Box* m_box = nullptr;
+            size_t m_range = 0;
+            size_t m_begin = 0;
+            size_t m_offset = 0;
+        };
+
         Box() = default;
         Box(int nx , int ny , int nz);
         Box(const Box& globalBox , int i1 , int i2 , int j1 , int j2 , int k1 , int k2); // Zero offset coordinates.
@@ -35,13 +76,16 @@ namespace Opm {
         size_t size() const;
         bool   isGlobal() const;
         size_t getDim(size_t idim) const;
-        const std::vector<size_t>& getIndexList() const;
+        std::vector<size_t> getIndexList() const;
         bool equal(const Box& other) const;
 
         explicit operator bool() const;
-        std::vector<size_t>::const_iterator begin() const;
-        std::vector<size_t>::const_iterator end() const;
+        const_iterator begin() const;
+        const_iterator end() const;
 
+        size_t numRanges() const;
+        size_t rangeSize() const;
+        size_t rangeBegin(size_t range) const;
 
         int I1() const;
         int I2() const;
@@ -51,13 +95,14 @@ namespace Opm {
         int K2() const;
 
     private:
-        void initIndexList();
+        void initRanges();
         size_t m_dims[3] = { 0, 0, 0 };
         size_t m_offset[3];
         size_t m_stride[3];
 
         bool   m_isGlobal;
-        std::vector<size_t> m_indexList;
+        size_t m_rangeSize = 0;
+        size_t m_rowsPerRange = 1;
 
         int lower(int dim) const;
         int upper(int dim) const;
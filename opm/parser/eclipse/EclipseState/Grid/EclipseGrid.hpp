@@ -22,6 +22,7 @@
 #define OPM_PARSER_ECLIPSE_GRID_HPP
 
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/Value.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MinpvMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/PinchMode.hpp>
@@ -31,7 +32,10 @@
 #include <ert/util/ert_unique_ptr.hpp>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
 namespace Opm {
@@ -99,6 +103,15 @@ namespace Opm {
         size_t getGlobalIndex(size_t active_index) const;
         size_t getGlobalIndex(size_t i, size_t j, size_t k) const;
 
+        /*
+          Batch versions of activeIndex(i,j,k) and of getIJK() for active
+          indices, see GridDims::getGlobalIndices(); they throw
+          std::invalid_argument for inactive cells and indices outside
+          the grid.
+        */
+        std::vector<size_t> activeIndex(const std::vector<std::array<int, 3>>& ijk) const;
+        std::vector<std::array<int, 3>> getActiveIJK(const std::vector<size_t>& activeIndices) const;
+
         /*
           For RADIAL grids you can *optionally* use the keyword
           'CIRCLE' to denote that period boundary conditions should be
@@ -137,20 +150,58 @@ namespace Opm {
                 throw std::invalid_argument("Input vector must have full size");
 
             {
-                std::vector<T> compressed_vector( this->getNumActive() );
                 const auto& active_map = this->getActiveMap( );
+                const long num_active = active_map.size();
+                std::vector<T> compressed_vector( num_active );
 
-                for (size_t i = 0; i < this->getNumActive(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_active >= parallel_copy_size)
+#endif
+                for (long i = 0; i < num_active; ++i)
                     compressed_vector[i] = input_vector[ active_map[i] ];
 
                 return compressed_vector;
             }
         }
 
+        /*
+          The inverse of compressedVector(): will return a vector of
+          nx*ny*nz elements, where the inactive cells are set to
+          fill_value. An input vector of nx*ny*nz elements is copied
+          straight out again; any other size is an exception.
+        */
+        template<typename T>
+        std::vector<T> expandedVector(const std::vector<T>& input_vector, const T& fill_value = T()) const {
+            if (input_vector.size() == getCartesianSize())
+                return input_vector;
+
+            if (input_vector.size() != this->getNumActive())
+                throw std::invalid_argument("Input vector must have active size");
+
+            {
+                const auto& active_map = this->getActiveMap( );
+                const long num_active = active_map.size();
+                std::vector<T> global_vector( getCartesianSize() , fill_value );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_active >= parallel_copy_size)
+#endif
+                for (long i = 0; i < num_active; ++i)
+                    global_vector[ active_map[i] ] = input_vector[i];
+
+                return global_vector;
+            }
+        }
+
 
         /// Will return a vector a length num_active; where the value
         /// of each element is the corresponding global index.
         const std::vector<int>& getActiveMap() const;
+
+        /// Will return a vector of length nx*ny*nz; where the value of
+        /// each element is the active index of the cell, or -1 for
+        /// inactive cells.
+        const std::vector<int>& getGlobalToActiveMap() const;
         std::array<double, 3> getCellCenter(size_t i,size_t j, size_t k) const;
         std::array<double, 3> getCellCenter(size_t globalIndex) const;
         std::array<double, 3> getCornerPos(size_t i,size_t j, size_t k, size_t corner_index) const;
@@ -166,6 +217,21 @@ namespace Opm {
         double getCellDepth(size_t globalIndex) const;
         ZcornMapper zcornMapper() const;
 
+        /*
+          Geometry of all the cells in global index order. The values are
+          computed for the whole grid, in parallel when OpenMP is
+          available, on the first call and cached. The centers and
+          dimensions are returned as {x, y, z} and {dx, dy, dz} arrays;
+          the depth of a cell is the z coordinate of the center.
+
+          These methods, and the per-cell geometry methods, may be called
+          concurrently on a const grid.
+        */
+        const std::vector<double>& getCellVolumes() const;
+        const std::vector<double>& getCellDepths() const;
+        const std::array< std::vector<double>, 3 >& getCellCenters() const;
+        const std::array< std::vector<double>, 3 >& getCellDimensions() const;
+
         /*
           The exportZCORN method will adjust the z coordinates to ensure that cells do not
           overlap. The return value is the number of points which have been adjusted.
@@ -180,14 +246,59 @@ namespace Opm {
         bool equal(const EclipseGrid& other) const;
         const ecl_grid_type * c_ptr() const;
 
+        /*
+          The arrays of the grid itself; the corner point geometry held
+          by libecl is not included.
+        */
+        MemoryUsage memory_usage() const;
+
     private:
         std::vector<double> m_minpvVector;
         MinpvMode::ModeEnum m_minpvMode;
         Value<double> m_pinch;
         PinchMode::ModeEnum m_pinchoutMode;
         PinchMode::ModeEnum m_multzMode;
-        mutable std::vector<double> volume_cache;
-        mutable std::vector< int > activeMap;
+
+        /*
+          The cached geometry of getCellVolumes(), getCellCenters() and
+          getCellDimensions(). Each array is built once, under its
+          once_flag, and then announced by its ready flag; the per-cell
+          methods read the arrays only when they are ready and otherwise
+          ask ecl_grid. A copied grid starts with an empty cache.
+        */
+        struct GeometryCache {
+            GeometryCache() = default;
+            GeometryCache(const GeometryCache&) {}
+            GeometryCache& operator=(const GeometryCache&) = delete;
+
+            std::once_flag volumes_built;
+            std::once_flag centers_built;
+            std::once_flag dims_built;
+            std::atomic< bool > volumes_ready{ false };
+            std::atomic< bool > centers_ready{ false };
+            std::atomic< bool > dims_ready{ false };
+
+            std::vector<double> volumes;
+            std::array< std::vector<double>, 3 > centers;
+            std::array< std::vector<double>, 3 > dims;
+        };
+        mutable GeometryCache m_geometry;
+        /*
+          The active cells, indexed natively rather than through ecl_grid:
+          the active index of every global cell (-1 for inactive cells),
+          whether the cell is active, and the global index of every
+          active cell. Rebuilt whenever the ecl_grid or ACTNUM changes.
+        */
+        std::vector< int > m_activeIndex;
+        std::vector< char > m_cellActive;
+        std::vector< int > activeMap;
+
+        /*
+          The compress and expand helpers copy in parallel above this
+          number of cells. Note that they are not used with
+          std::vector<bool>, which can not be written concurrently.
+        */
+        static const long parallel_copy_size = 1 << 16;
         bool m_circle = false;
         /*
           The internal class grid_ptr is a a std::unique_ptr with
@@ -206,6 +317,7 @@ namespace Opm {
         };
         grid_ptr m_grid;
         void initBinaryGrid(const Deck& deck);
+        void initActiveIndex();
 
         void initCornerPointGrid(const std::array<int,3>& dims ,
                                  const std::vector<double>& coord ,
@@ -231,6 +343,41 @@ namespace Opm {
         static void scatterDim(const std::array<int, 3>& dims , size_t dim , const std::vector<double>& DV , std::vector<double>& D);
    };
 
+    inline size_t EclipseGrid::getNumActive( ) const {
+        return this->activeMap.size();
+    }
+
+    inline bool EclipseGrid::allActive( ) const {
+        return this->activeMap.size() == this->m_activeIndex.size();
+    }
+
+    inline bool EclipseGrid::cellActive( size_t globalIndex ) const {
+        assertGlobalIndex( globalIndex );
+        return this->m_cellActive[ globalIndex ] != 0;
+    }
+
+    inline size_t EclipseGrid::activeIndex(size_t globalIndex) const {
+        if (globalIndex >= this->m_activeIndex.size() || this->m_activeIndex[ globalIndex ] < 0)
+            throw std::invalid_argument("Input argument does not correspond to an active cell");
+        return static_cast<size_t>( this->m_activeIndex[ globalIndex ] );
+    }
+
+    /**
+       Observe: the input argument is assumed to be in the space
+       [0,num_active).
+    */
+    inline size_t EclipseGrid::getGlobalIndex(size_t active_index) const {
+        return static_cast<size_t>( this->activeMap[ active_index ] );
+    }
+
+    inline const std::vector<int>& EclipseGrid::getActiveMap() const {
+        return this->activeMap;
+    }
+
+    inline const std::vector<int>& EclipseGrid::getGlobalToActiveMap() const {
+        return this->m_activeIndex;
+    }
+
     class CoordMapper {
     public:
         CoordMapper(size_t nx, size_t ny);
@@ -275,6 +422,8 @@ namespace Opm {
         size_t fixupZCORN( std::vector<double>& zcorn);
         bool validZCORN( const std::vector<double>& zcorn) const;
     private:
+        size_t columnStart(size_t column) const;
+
         std::array<size_t,3> dims;
         std::array<size_t,3> stride;
         std::array<size_t,8> cell_shift;
@@ -20,13 +20,19 @@
 #define OPM_PARSER_FAULT_FACE_HPP
 
 #include <cstddef>
-#include <vector>
 
+#include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 
 namespace Opm {
 
 
+/*
+  The faces of one FAULTS record. The cells are kept as the box of the
+  record, so the size of a face does not depend on the number of cells
+  it covers, and the cells can be visited as ranges of consecutive
+  global indices, see Box.
+*/
 class FaultFace {
 public:
     FaultFace(size_t nx , size_t ny , size_t nz,
@@ -35,8 +41,9 @@ public:
               size_t K1 , size_t K2,
               FaceDir::DirEnum faceDir);
 
-    std::vector<size_t>::const_iterator begin() const;
-    std::vector<size_t>::const_iterator end() const;
+    Box::const_iterator begin() const;
+    Box::const_iterator end() const;
+    const Box& getBox() const;
     FaceDir::DirEnum getDir() const;
 
     bool operator==( const FaultFace& rhs ) const;
@@ -45,7 +52,7 @@ public:
 private:
     static void checkCoord(size_t dim , size_t l1 , size_t l2);
     FaceDir::DirEnum m_faceDir;
-    std::vector<size_t> m_indexList;
+    Box m_box;
 };
 
 
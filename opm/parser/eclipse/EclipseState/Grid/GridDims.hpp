@@ -50,6 +50,16 @@ namespace Opm {
 
         const std::array<int, 3> getIJK(size_t globalIndex) const;
 
+        /*
+          Batch versions of getGlobalIndex() and getIJK() for the setup
+          code which converts many cells at a time; the strides and
+          divisors are computed once per call. Unlike the single cell
+          versions they check the input, and throw std::invalid_argument
+          for an index outside the grid.
+        */
+        std::vector<size_t> getGlobalIndices(const std::vector<std::array<int, 3>>& ijk) const;
+        std::vector<std::array<int, 3>> getIJK(const std::vector<size_t>& globalIndices) const;
+
         size_t getCartesianSize() const;
 
         void assertGlobalIndex(size_t globalIndex) const;
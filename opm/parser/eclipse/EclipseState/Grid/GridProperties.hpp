@@ -19,12 +19,16 @@
 #ifndef ECLIPSE_GRIDPROPERTIES_HPP_
 #define ECLIPSE_GRIDPROPERTIES_HPP_
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <map>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 
@@ -59,6 +63,41 @@ namespace Opm {
 
     class Eclipse3DProperties;
 
+    /*
+      A record of EQUALS, COPY, ADD, MULTIPLY, MINVALUE or MAXVALUE with
+      its property and box resolved; apply() performs the record. The
+      operation modifies the property target, and reads the property
+      source unless that is nullptr.
+    */
+    struct GridPropertyOperation {
+        const void* target = nullptr;
+        const void* source = nullptr;
+        size_t cells = 0;
+        std::function< void() > apply;
+    };
+
+    /*
+      Operations which are applied together, concurrently when they
+      cover enough cells. An operation only fits if it modifies no
+      property which another operation of the batch reads or modifies,
+      and reads no property which another one modifies, so the result
+      is the same as applying them one at a time in any order.
+    */
+    class GridPropertyOperations {
+    public:
+        bool fits( const GridPropertyOperation& operation ) const;
+        void add( GridPropertyOperation operation );
+
+        /* Applies the operations, and empties the batch. */
+        void apply();
+
+    private:
+        std::vector< GridPropertyOperation > operations;
+        std::vector< const void* > targets;
+        std::vector< const void* > sources;
+        size_t cells = 0;
+    };
+
     template <typename T>
     class GridProperties {
     public:
@@ -105,6 +144,22 @@ namespace Opm {
         const GridProperty<T>& getKeyword(const std::string& keyword) const;
         const GridProperty<T>& getDeckKeyword(const std::string& keyword) const;
 
+        /*
+          A handle is the position of a keyword in the list of supported
+          keywords, numbered in the order the container was constructed
+          with. Resolving the handle of a keyword is a string lookup,
+          hasKeyword() and getKeyword() with a handle are array lookups
+          once the property exists; the string overloads above resolve
+          the handle first. The handles of a container are valid in its
+          copies. keywordHandle() throws std::invalid_argument if the
+          keyword is not supported.
+        */
+        typedef std::size_t Handle;
+
+        Handle keywordHandle(const std::string& keyword) const;
+        bool hasKeyword(Handle handle) const;
+        const GridProperty<T>& getKeyword(Handle handle) const;
+
 
         bool addKeyword(const std::string& keywordName);
         void copyKeyword(const std::string& srcField ,
@@ -129,12 +184,31 @@ namespace Opm {
 
         GridProperty<T>& getOrCreateProperty(const std::string& name);
 
+        /* One part for each property which has been created. */
+        MemoryUsage memory_usage() const;
+
         /**
            The fine print of the manual says the ADD keyword should support
            some state dependent semantics regarding endpoint scaling arrays
            in the PROPS section. That is not supported.
         */
 
+        /*
+          The box records are handled in two steps: the prepare methods
+          resolve the property, creating it if needed, and the box, and
+          return the operation which applies the record. isPrepared() is
+          true if preparing an operation on the keyword reads no other
+          property: the property starts out as a constant, or has its
+          data and has run its post processor.
+        */
+        bool isPrepared( const std::string& keyword ) const;
+        GridPropertyOperation prepareADDRecord( const DeckRecord& record, BoxManager& boxManager);
+        GridPropertyOperation prepareMAXVALUERecord( const DeckRecord& record, BoxManager& boxManager);
+        GridPropertyOperation prepareMINVALUERecord( const DeckRecord& record, BoxManager& boxManager);
+        GridPropertyOperation prepareMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager);
+        GridPropertyOperation prepareCOPYRecord( const DeckRecord& record, BoxManager& boxManager);
+        GridPropertyOperation prepareEQUALSRecord( const DeckRecord& record, BoxManager& boxManager);
+
         void handleADDRecord( const DeckRecord& record, BoxManager& boxManager);
         void handleMAXVALUERecord( const DeckRecord& record, BoxManager& boxManager);
         void handleMINVALUERecord( const DeckRecord& record, BoxManager& boxManager);
@@ -151,7 +225,9 @@ namespace Opm {
         /*
           Iterators over initialized properties. The overloaded
           operator*() opens the pair which comes natively from the
-          std::map iterator.
+          std::map iterator. Unlike the lookups above, which may be
+          called concurrently, the iteration must not overlap with a
+          getKeyword() which creates a property.
         */
         const_iterator begin() const {
             return const_iterator( m_properties.begin() );
@@ -191,6 +267,10 @@ namespace Opm {
 
 
         GridProperty<T>& getKeyword(const std::string& keyword);
+        GridProperty<T>& getKeyword(Handle handle);
+        Handle addHandle(const std::string& keyword) const;
+        bool findHandle(const std::string& keyword, Handle& handle) const;
+        GridProperty<T>* cachedProperty(Handle handle) const;
         bool addAutoGeneratedKeyword_(const std::string& keywordName) const;
         void insertKeyword(const SupportedKeywordInfo& supportedKeyword) const;
         bool isAutoGenerated_(const std::string& keyword) const;
@@ -204,6 +284,35 @@ namespace Opm {
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
         mutable std::set<std::string> m_autoGeneratedProperties;
+
+        /*
+          The keyword of every handle, and the properties of the handles
+          looked up so far. The properties are not carried over to a
+          copy, which looks them up again in its own storage.
+        */
+        struct PropertyCache {
+            PropertyCache() = default;
+            PropertyCache(const PropertyCache&) {}
+            PropertyCache& operator=(const PropertyCache&) {
+                this->properties.clear();
+                return *this;
+            }
+
+            std::vector< GridProperty<T>* > properties;
+        };
+
+        mutable std::vector<std::string> m_handleNames;
+        mutable std::unordered_map<std::string, Handle> m_handles;
+        mutable PropertyCache m_handleProperties;
+
+        /*
+          Guards the containers above, which the const getKeyword()
+          fills on first use, and the post processors it runs. The int
+          and double containers of an Eclipse3DProperties share one
+          lock, as the post processors of the one look up properties in
+          the other.
+        */
+        std::shared_ptr< std::recursive_mutex > m_lock = std::make_shared< std::recursive_mutex >();
     };
 
 }
@@ -20,9 +20,14 @@
 #define ECLIPSE_GRIDPROPERTY_HPP_
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
+
 /*
   This class implemenents a class representing properties which are
   define over an ECLIPSE grid, i.e. with one value for each logical
@@ -82,6 +87,12 @@ class GridPropertySupportedKeywordInfo {
         const post& postProcessor() const;
         bool isDefaultInitializable() const;
 
+        /*
+          True if the property starts out as a constant and has no post
+          processor, i.e. creating it reads no other property.
+        */
+        bool hasConstantDefault() const;
+
     private:
 
         std::string m_keywordName;
@@ -89,6 +100,7 @@ class GridPropertySupportedKeywordInfo {
         post m_postProcessor;
         std::string m_dimensionString;
         bool m_defaultInitializable;
+        bool m_constantDefault = false;
 };
 
 template< typename T >
@@ -110,9 +122,22 @@ public:
     void iset(size_t i , size_t j , size_t k , T value);
 
 
+    /*
+      The data is shared between copies of the property until one of
+      them is modified; the non const getData() makes a private copy of
+      the data if it is shared. The reference it returns must therefore
+      not be held while the property is copied.
+
+      The const methods may be called concurrently; the data and the
+      region index which they create on first use are built once, and
+      handed to all the callers.
+    */
     const std::vector<T>& getData() const;
     std::vector<T>& getData();
 
+    /* True if the two properties currently share the same data. */
+    bool sharesData( const GridProperty<T>& other ) const;
+
     bool containsNaN() const;
     const std::string& getDimensionString() const;
 
@@ -124,6 +149,23 @@ public:
     void maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask );
     void initMask( T value, std::vector<bool>& mask ) const;
 
+    /*
+      The masked operations restricted to the cells of one region, as
+      listed by regionIndex().
+    */
+    void maskedSet( T value, const RegionIndex::Cells& cells );
+    void maskedMultiply( T value, const RegionIndex::Cells& cells );
+    void maskedAdd( T value, const RegionIndex::Cells& cells );
+    void maskedCopy( const GridProperty< T >& other, const RegionIndex::Cells& cells );
+
+    /*
+      The cells of every region of an integer property; the index is
+      built on first use and kept until the property is modified. The
+      caller shares the ownership of the index, so it remains valid
+      while the property itself is modified through it.
+    */
+    std::shared_ptr< const RegionIndex > regionIndex() const;
+
     /**
        Due to the convention where it is only necessary to supply the
        top layer of the petrophysical properties we can unfortunately
@@ -134,6 +176,13 @@ public:
     void loadFromDeckKeyword( const DeckKeyword& );
     void loadFromDeckKeyword( const Box&, const DeckKeyword& );
 
+    /*
+      As loadFromDeckKeyword(), but when the keyword specifies every
+      cell the values are moved out of the keyword instead of copied,
+      and the keyword is left without values.
+    */
+    void consumeDeckKeyword( const Box&, DeckKeyword& );
+
     void copyFrom( const GridProperty< T >&, const Box& );
     void scale( T scaleFactor, const Box& );
     void maxvalue( T value, const Box& );
@@ -157,6 +206,7 @@ public:
       assembling the properties.
     */
     void runPostProcessor();
+    bool hasRunPostProcessor() const;
      /*
       Will scan through the roperty and return a vector of all the
       indices where the property value agrees with the input value.
@@ -262,13 +312,86 @@ public:
      */
     bool deckAssigned() const;
 
+    /*
+      The data vector is not created when the property is constructed,
+      but on first access; if the property is completely assigned from
+      the deck the initializer is never called. Will return false
+      until the data has been created.
+    */
+    bool materialized() const;
+
+    /*
+      A property can be stored compactly: as one value per layer when
+      every layer is constant - a single value if the whole property is
+      constant - or, for integer properties, as 8 or 16 bit offsets from
+      the smallest value. compact() returns false and keeps the full
+      array if the property has no data yet or none of the forms fits.
+
+      The const getData() creates the full array alongside the compact
+      data, and writes to individual cells replace the compact data with
+      the full array. iget(), regionIndex() and compressedCopy() read the
+      compact data without widening it, and scale(), add(), maxvalue(),
+      minvalue(), setScalar() and copyFrom() on the global box or on
+      boxes of whole layers keep a layered property compact. setScalar()
+      on the global box always gives a constant property.
+
+      Unlike the other const methods compact() changes the storage, and
+      must not be called while the property is used from other threads.
+    */
+    bool compact() const;
+    bool compacted() const;
+
+    /* True if all the cells have the same value. */
+    bool isConstant() const;
+
+    /*
+      The bytes allocated by the property: the full array, the compact
+      data and the region index, whichever exist.
+    */
+    size_t memory_usage() const;
+
+    /*
+      The content fingerprint of the keyword name, the dimensions of
+      the grid and the values. Like the region index it is computed on
+      first use and kept until the property is modified; the storage of
+      the values does not change it.
+    */
+    Fingerprint fingerprint() const;
+
 private:
+    struct CompactData;
+
     const DeckItem& getDeckItem( const DeckKeyword& );
     void setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem);
+    bool coversAllCells(const DeckItem& deckItem) const;
+    void assignDeckData(const DeckItem& deckItem);
+    void releaseDeckData(DeckItem& deckItem);
+    void deckDataAssigned();
+    std::shared_ptr< const CompactData > compactLayers() const;
+    template< typename F >
+    bool updateLayers( const Box& inputBox, F op );
+    const std::vector<T>& data() const;
+    std::vector<T>& writableData();
 
     size_t m_nx, m_ny, m_nz;
     SupportedKeywordInfo m_kwInfo;
-    std::vector<T> m_data;
+    mutable std::shared_ptr<std::vector<T>> m_data;
+    mutable std::shared_ptr< const CompactData > m_compact;
+    mutable std::shared_ptr< const RegionIndex > m_regionIndex;
+    mutable std::shared_ptr< const Fingerprint > m_fingerprint;
+
+    /*
+      Serializes the creation of m_data and m_regionIndex from const
+      methods; a copied property gets a lock of its own.
+    */
+    struct BuildLock {
+        BuildLock() = default;
+        BuildLock(const BuildLock&) {}
+        BuildLock& operator=(const BuildLock&) { return *this; }
+
+        std::mutex mutex;
+    };
+    mutable BuildLock m_buildLock;
     bool m_hasRunPostProcessor = false;
     bool assigned = false;
 };
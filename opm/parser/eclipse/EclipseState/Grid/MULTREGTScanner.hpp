@@ -71,11 +71,37 @@ namespace Opm {
                         const std::vector< const DeckKeyword* >& keywords);
         double getRegionMultiplier(size_t globalCellIdx1, size_t globalCellIdx2, FaceDir::DirEnum faceDir) const;
 
+        /*
+          The region multipliers of a list of faces; element i of the
+          result is getRegionMultiplier(globalCellIdx1[i],
+          globalCellIdx2[i], faceDir[i]). The region properties are only
+          looked up once for the whole list.
+        */
+        std::vector<double> getRegionMultipliers(const std::vector<size_t>& globalCellIdx1,
+                                                 const std::vector<size_t>& globalCellIdx2,
+                                                 const std::vector<FaceDir::DirEnum>& faceDir) const;
+
     private:
+        /*
+          The records of one region keyword as a dense table indexed by
+          the pair of region ids, with the region ids which occur in the
+          records numbered consecutively.
+        */
+        struct RegionTable {
+            std::string region_name;
+            std::vector<int> index;
+            std::size_t size = 0;
+            std::vector<int> records;
+
+            int record(int regionId1, int regionId2) const;
+        };
+
         void addKeyword( const Eclipse3DProperties& props, const DeckKeyword& deckKeyword, const std::string& defaultRegion);
         void assertKeywordSupported(const DeckKeyword& deckKeyword, const std::string& defaultRegion);
+        const MULTREGTRecord* findRecord(const RegionTable& table, int regionId1, int regionId2, FaceDir::DirEnum faceDir) const;
+
         std::vector< MULTREGTRecord > m_records;
-        std::map<std::string , MULTREGTSearchMap> m_searchMap;
+        std::vector< RegionTable > m_tables;
         const Eclipse3DProperties& m_e3DProps;
     };
 
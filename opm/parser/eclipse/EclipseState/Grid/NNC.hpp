@@ -38,6 +38,7 @@ struct NNCdata {
 };
 
 class Deck;
+class EDITNNC;
 
 /// Represents non-neighboring connections (non-standard adjacencies).
 /// This class is essentially a directed weighted graph.
@@ -53,12 +54,73 @@ public:
     size_t numNNC() const;
     bool hasNNC() const;
 
+    /// Sort the connections by (cell1, cell2) and combine repeated
+    /// connections between the same two cells into one connection with
+    /// the sum of their transmissibilities.
+    void sortUnique();
+
+    /// The connections of all the parts, e.g. the buffers filled by
+    /// different threads, in one sorted and deduplicated NNC.
+    static NNC merge(const std::vector<NNC>& parts);
+
+    /// Multiply the transmissibility of every connection by the EDITNNC
+    /// multipliers given for the same two cells, in either order; several
+    /// multipliers for one pair of cells are all applied. Returns the pairs
+    /// of cells, lowest cell first, with EDITNNC multipliers but no
+    /// connection, and their combined multiplier.
+    std::vector<NNCdata> applyEditNNC(const EDITNNC& editnnc);
+
+    template <class MessageBufferType>
+    void write(MessageBufferType& buffer) const {
+        buffer.write(m_nnc.size());
+        for (const auto& nnc : m_nnc) {
+            buffer.write(nnc.cell1);
+            buffer.write(nnc.cell2);
+            buffer.write(nnc.trans);
+        }
+    }
+
+    template <class MessageBufferType>
+    void read(MessageBufferType& buffer) {
+        size_t size = 0;
+        buffer.read(size);
+        m_nnc.resize(size);
+        for (auto& nnc : m_nnc) {
+            buffer.read(nnc.cell1);
+            buffer.read(nnc.cell2);
+            buffer.read(nnc.trans);
+        }
+    }
+
 private:
 
     std::vector<NNCdata> m_nnc;
 };
 
 
+/// Compressed row index of the connections of every cell in an NNC. The
+/// connections are indexed from both of their cells; the neighbours of a
+/// cell are sorted by cell index.
+class NNCIndex
+{
+public:
+    struct Neighbour {
+        size_t cell;
+        size_t nnc;     // index of the connection in NNC::nncdata()
+    };
+
+    NNCIndex(const NNC& nnc, size_t numCells);
+
+    const Neighbour* begin(size_t cell) const;
+    const Neighbour* end(size_t cell) const;
+    size_t numNeighbours(size_t cell) const;
+
+private:
+    std::vector<size_t> m_offsets;
+    std::vector<Neighbour> m_neighbours;
+};
+
+
 } // namespace Opm
 
 
@@ -0,0 +1,77 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REGION_INDEX_HPP
+#define OPM_REGION_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The RegionIndex class lists the cells of every region of a region
+      array like FLUXNUM or MULTNUM, so that the xxxREG keywords can
+      visit the cells of one region without scanning the whole grid. The
+      cells of all the regions are stored in one vector, grouped by
+      region value and in increasing global index within each region.
+    */
+
+    class RegionIndex {
+    public:
+        /*
+          The global indices of the cells in one region.
+        */
+        class Cells {
+        public:
+            Cells() = default;
+            Cells(const size_t* begin, const size_t* end);
+
+            const size_t* begin() const;
+            const size_t* end() const;
+            size_t size() const;
+            bool empty() const;
+            size_t operator[](size_t index) const;
+
+        private:
+            const size_t* m_begin = nullptr;
+            const size_t* m_end = nullptr;
+        };
+
+        explicit RegionIndex(const std::vector<int>& regions);
+
+        /* The distinct region values, in increasing order. */
+        const std::vector<int>& regions() const;
+
+        /* Empty if no cell has the region value. */
+        Cells cells(int region) const;
+
+        /* The bytes allocated by the index. */
+        size_t memory_usage() const;
+
+    private:
+        static const size_t block_size = 1 << 16;
+
+        std::vector<int> m_regions;
+        std::vector<size_t> m_offsets;
+        std::vector<size_t> m_cells;
+    };
+}
+
+#endif
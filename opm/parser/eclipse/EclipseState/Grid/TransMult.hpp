@@ -33,6 +33,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
@@ -51,6 +52,24 @@ namespace Opm {
         double getMultiplier(size_t globalIndex, FaceDir::DirEnum faceDir) const;
         double getMultiplier(size_t i , size_t j , size_t k, FaceDir::DirEnum faceDir) const;
         double getRegionMultiplier( size_t globalCellIndex1, size_t globalCellIndex2, FaceDir::DirEnum faceDir) const;
+        std::vector<double> getRegionMultipliers( const std::vector<size_t>& globalCellIndex1,
+                                                  const std::vector<size_t>& globalCellIndex2,
+                                                  const std::vector<FaceDir::DirEnum>& faceDir) const;
+
+        /*
+          The combined multiplier of the faces between every cell and its
+          neighbour in the positive X, Y or Z direction, i.e. for XPlus
+          element g is
+
+             MULTX(g) * MULTX-(g + 1) * MULTREGT(g, g + 1)
+
+          with the fault multipliers included in MULTX and MULTX-. The
+          elements of the cells in the last layer of the direction, which
+          have no neighbour, are one. The array should be built once,
+          after all the multipliers have been applied.
+        */
+        std::vector<double> getFaceMultipliers(FaceDir::DirEnum faceDir) const;
+
         void applyMULT(const GridProperty<double>& srcMultProp, FaceDir::DirEnum faceDir);
         void applyMULTFLT(const FaultCollection& faults);
         void applyMULTFLT(const Fault& fault);
@@ -59,6 +78,7 @@ namespace Opm {
         size_t getGlobalIndex(size_t i , size_t j , size_t k) const;
         void assertIJK(size_t i , size_t j , size_t k) const;
         double getMultiplier__(size_t globalIndex , FaceDir::DirEnum faceDir) const;
+        const std::vector<double>* getDirectionData(FaceDir::DirEnum faceDir) const;
         void insertNewProperty(FaceDir::DirEnum faceDir);
         bool hasDirectionProperty(FaceDir::DirEnum faceDir) const;
         GridProperty<double>& getDirectionProperty(FaceDir::DirEnum faceDir);
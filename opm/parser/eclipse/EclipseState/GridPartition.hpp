@@ -0,0 +1,78 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_PARTITION_HPP
+#define OPM_GRID_PARTITION_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+namespace Opm {
+
+    class GridDims;
+    template< typename > class GridProperty;
+    class Schedule;
+    class TransMult;
+    class Well;
+
+    /*
+      The cells of one partition of a distributed simulation, given by
+      their global (cartesian) indices. The slices extracted with the
+      partition contain only the data of the local cells, in the order
+      of globalCells(), and can be sent to the process owning the
+      partition; the process which has built the full EclipseState and
+      Schedule extracts the slices of all the partitions, and the other
+      processes never hold more than their own cells.
+
+      The NNC slice contains the connections with at least one local
+      cell, with the global cell indices of the input; the wells are
+      the wells with at least one connection in a local cell.
+    */
+
+    class GridPartition {
+    public:
+        GridPartition(const GridDims& dims, std::vector<std::size_t> globalCells);
+
+        const std::vector<std::size_t>& globalCells() const;
+        std::size_t size() const;
+
+        bool contains(std::size_t globalIndex) const;
+        /* Throws std::invalid_argument if the cell is not in the partition. */
+        std::size_t localIndex(std::size_t globalIndex) const;
+
+        template< typename T >
+        std::vector<T> slice(const GridProperty<T>& property) const;
+        std::vector<double> slice(const TransMult& transMult, FaceDir::DirEnum faceDir) const;
+        NNC slice(const NNC& nnc) const;
+        std::vector<const Well*> wells(const Schedule& schedule, std::size_t timeStep) const;
+
+    private:
+        std::size_t m_cartesianSize;
+        std::size_t m_nx;
+        std::size_t m_nxny;
+        std::vector<std::size_t> m_globalCells;
+        std::vector<std::size_t> m_sorted;
+        std::vector<std::size_t> m_sortedLocal;
+    };
+}
+
+#endif
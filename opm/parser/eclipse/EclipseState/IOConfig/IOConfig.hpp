@@ -20,6 +20,9 @@
 #ifndef OPM_IO_CONFIG_HPP
 #define OPM_IO_CONFIG_HPP
 
+#include <cstddef>
+#include <map>
+
 #include <boost/date_time/gregorian/gregorian_types.hpp>
 
 namespace Opm {
@@ -154,6 +157,44 @@ namespace Opm {
 
         void setEclCompatibleRST(bool ecl_rst);
         bool getEclCompatibleRST() const;
+
+        /*
+          Unified restart files which are not ECLIPSE compatible can
+          refer back to the arrays of an earlier report step when they
+          are unchanged, instead of repeating them; off by default.
+        */
+        void setDeduplicateRST(bool dedup_rst);
+        bool getDeduplicateRST() const;
+
+        /*
+          The summary time series can also be written in columnar
+          form, in chunks of this number of timesteps; see
+          out::ColumnarSummary. Zero, the default, disables it.
+        */
+        void setColumnarSummary(std::size_t chunk_steps);
+        std::size_t getColumnarSummary() const;
+
+        /*
+          Which timesteps are written to the summary files. Report steps
+          are always written; a substep only when every_nth ministeps
+          and min_interval seconds have passed since the last written
+          timestep, and never if every_nth is zero. The totals are
+          integrated over all the ministeps regardless. The default
+          writes every ministep.
+        */
+        void setSummaryRecording(std::size_t every_nth, double min_interval = 0);
+        std::size_t getSummaryRecordingSteps() const;
+        double getSummaryRecordingInterval() const;
+
+        /*
+          The vectors of a class - the first letter of the keyword, e.g.
+          'W' for the well vectors and 'C' for the connection vectors -
+          are only evaluated at every nth written timestep, and repeat
+          their last value in between. The totals are not affected.
+        */
+        void setSummaryCadence(char var_class, std::size_t every_nth);
+        const std::map<char, std::size_t>& getSummaryCadence() const;
+
         bool getWriteEGRIDFile() const;
         bool getWriteINITFile() const;
         bool getUNIFOUT() const;
@@ -202,6 +243,11 @@ namespace Opm {
         bool            m_nosim;
         std::string     m_base_name;
         bool            ecl_compatible_rst = true;
+        bool            dedup_rst = false;
+        std::size_t     columnar_summary = 0;
+        std::size_t     summary_every_nth = 1;
+        double          summary_min_interval = 0;
+        std::map<char, std::size_t> summary_cadence;
 
         IOConfig( const GRIDSection&,
                   const RUNSPECSection&,
@@ -329,6 +329,14 @@ namespace Opm {
         const std::map< std::string, int >& getRestartKeywords( size_t timestep ) const;
         int getKeyword( const std::string& keyword, size_t timeStep) const;
 
+        /*
+          The mnemonics with a nonzero value at the report step, in
+          sorted order. The lists are compiled once, when the
+          configuration is created, so the output code can loop over the
+          selected fields without probing every mnemonic at every step.
+        */
+        const std::vector< std::string >& getSelectedKeywords( size_t timestep ) const;
+
         void overrideRestartWriteInterval(size_t interval);
         void handleSolutionSection(const SOLUTIONSection& solutionSection, const ParseContext& parseContext);
         void setWriteInitialRestartFile(bool writeInitialRestartFile);
@@ -361,9 +369,17 @@ namespace Opm {
         void update( size_t step, const RestartSchedule& rs);
         static RestartSchedule rptsched( const DeckKeyword& );
 
+        /// Precompute which report steps write a restart file and the
+        /// selected mnemonics of every step.
+        void compileOutputPlan( );
+
         DynamicState< RestartSchedule > restart_schedule;
         DynamicState< std::map< std::string, int > > restart_keywords;
         std::vector< bool > save_keywords;
+
+        std::vector< bool > write_restart;
+        std::vector< size_t > selected_index;
+        std::vector< std::vector< std::string > > selected_keywords;
     };
 } //namespace Opm
 
@@ -21,9 +21,11 @@
 #ifndef ActionAST_HPP
 #define ActionAST_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionContext.hpp>
 
 namespace Opm {
 
@@ -89,13 +91,13 @@ ASTNode(TokenType type_arg, const std::string& func_arg, const std::vector<std::
     arg_list(arg_list_arg)
 {}
 
-    bool eval(const ActionContext& context) const;
-    double value(const ActionContext& context) const;
     TokenType type;
     void add_child(const ASTNode& child);
     size_t size() const;
 
 private:
+    friend class ActionAST;
+
     std::string func;
     std::vector<std::string> arg_list;
     double number = 0.0;
@@ -124,6 +126,24 @@ private:
 };
 
 
+/*
+  The ActionAST class parses the condition of an ACTIONX keyword into a tree
+  of ASTNode instances, and then lowers the tree to a flat program which is
+  used for the evaluation. The comparisons are stored in an array where the
+  operands are either constants or references to keys, and the AND/OR
+  structure becomes a sequence of jumps which short circuits exactly like
+  the tree walk did.
+
+  The keys are resolved to slots in the ActionContext on the first
+  evaluation, and then again only when the condition is evaluated against
+  a context with another layout, e.g. after new keys have been added to
+  the summary state; evaluating the condition is therefore a loop over
+  the program with no string work and no allocation. A key where the
+  argument contains a wildcard, e.g. 'WWCT OP* > 0.50', resolves to the
+  set of all the matching keys, and the comparison is true if it holds
+  for at least one of them.
+*/
+
 class ActionAST{
 public:
     ActionAST() = default;
@@ -137,7 +157,53 @@ public:
 
     bool eval(const ActionContext& context) const;
 private:
-    ASTNode tree;
+    struct Operand {
+        bool constant;
+        double value;
+        std::size_t key;
+    };
+
+    struct Comparison {
+        TokenType op;
+        Operand lhs;
+        Operand rhs;
+    };
+
+    enum class OpCode {
+        compare,
+        jump_if_true,
+        jump_if_false
+    };
+
+    struct Instruction {
+        OpCode code;
+        std::size_t arg;
+    };
+
+    struct Key {
+        std::string name;
+        std::string func;
+        std::string arg;
+        bool wildcard;
+    };
+
+    void compile(const ASTNode& node);
+    Operand compile_operand(const ASTNode& node);
+    void resolve(const ActionContext& context) const;
+    bool compare(const Comparison& cmp, const ActionContext& context) const;
+
+    std::vector<Instruction> program;
+    std::vector<Comparison> comparisons;
+    std::vector<Key> keys;
+
+    /*
+      The slots of key i are slots[slot_offset[i]] .. slots[slot_offset[i+1]],
+      resolved_layout is the layout() of the context they were resolved
+      against.
+    */
+    mutable std::vector<ActionContext::Slot> slots;
+    mutable std::vector<std::size_t> slot_offset;
+    mutable std::pair<std::size_t, std::size_t> resolved_layout;
 };
 }
 #endif
@@ -21,8 +21,10 @@
 #ifndef ActionContext_HPP
 #define ActionContext_HPP
 
+#include <cstddef>
 #include <string>
-#include <map>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
@@ -30,6 +32,15 @@ namespace Opm {
 
 class ActionContext {
 public:
+    /*
+      A Slot is a resolved reference to one value in the context, i.e. an
+      index in either the internal storage or in the SummaryState member.
+    */
+    struct Slot {
+        bool local;
+        std::size_t index;
+    };
+
     /*
       Observe that the ActionContext takes a copy of the SummaryState object.
     */
@@ -45,9 +56,34 @@ public:
     double get(const std::string& func) const;
     void   add(const std::string& func, double value);
 
+    /*
+      Resolve a key, or all the 'func:arg' keys where arg matches a shell
+      style wildcard pattern, to slots which can be evaluated without any
+      string lookup. A key is resolved when it is registered, also if it
+      does not have a value yet, so has() must be checked before get().
+
+      The slots are valid for all the contexts with the same layout(),
+      i.e. the SummaryState::layout() of the summary state and of the
+      local values. Contexts built from the same summary state, or a
+      copy of it, and with the same local values added in the same
+      order share the layout, so the slots can be kept from one
+      evaluation to the next.
+    */
+    bool resolve(const std::string& key, Slot& slot) const;
+    void resolve(const std::string& func, const std::string& pattern, std::vector<Slot>& slots) const;
+    std::pair<std::size_t, std::size_t> layout() const;
+
+    bool has(const Slot& slot) const {
+        return slot.local ? this->values.has(slot.index) : this->summary_state.has(slot.index);
+    }
+
+    double get(const Slot& slot) const {
+        return slot.local ? this->values.get(slot.index) : this->summary_state.get(slot.index);
+    }
+
 private:
     SummaryState summary_state;
-    std::map<std::string, double> values;
+    SummaryState values;
 };
 }
 #endif
@@ -64,6 +64,12 @@ public:
 
     void addKeyword(const DeckKeyword& kw);
     bool ready(std::time_t sim_time) const;
+    /*
+      The first simulation time where ready() returns true, or the
+      largest std::time_t value when the action has already been run
+      max_run times.
+    */
+    std::time_t next_time() const;
     bool eval(std::time_t sim_time, const ActionContext& context);
 
 
@@ -72,6 +78,10 @@ public:
     double min_wait() const { return this->m_min_wait; }
     std::time_t start_time() const { return this->m_start_time; }
 
+    /* The keywords which are applied when the action triggers. */
+    std::vector<DeckKeyword>::const_iterator begin() const { return this->keywords.begin(); }
+    std::vector<DeckKeyword>::const_iterator end() const { return this->keywords.end(); }
+
 private:
     std::string m_name;
     size_t m_max_run = 0;
@@ -23,12 +23,25 @@
 
 #include <string>
 #include <ctime>
+#include <functional>
 #include <map>
+#include <queue>
+#include <set>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
 
 namespace Opm {
 
+/*
+  The actions are kept in a queue ordered by the time they can run
+  next, so that ready() and pending() only look at the actions which
+  are due. Actions handed out by at() and pending() may be evaluated by
+  the caller, they are therefore put back in the queue - with their new
+  time - on the next call to ready() or pending(). Actions which have
+  been run max_run times are dropped from the queue.
+*/
+
 class Actions {
 public:
     Actions() = default;
@@ -40,7 +53,28 @@ public:
     std::vector<ActionX *> pending(std::time_t sim_time);
 
 private:
+    struct Entry {
+        std::time_t time;
+        std::size_t seq;
+        std::string name;
+
+        bool operator>(const Entry& other) const;
+    };
+
+    void schedule(const std::string& name) const;
+    void requeue() const;
+
     std::map<std::string, ActionX> actions;
+
+    /*
+      An action is in the queue at most once; the entry which is current
+      for an action is the one with the sequence number in 'queued',
+      other entries for the action are stale and skipped.
+    */
+    mutable std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    mutable std::map<std::string, std::size_t> queued;
+    mutable std::set<std::string> touched;
+    mutable std::size_t seq = 0;
 };
 }
 #endif
@@ -25,6 +25,7 @@
 #include <vector>
 #include <algorithm>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 
 
@@ -49,6 +50,12 @@ namespace Opm {
        The update() method returns true if the updated value is
        different from the current value, this implies that the
        class<T> must support operator!=
+
+       Internally the values are stored as a sorted list of change
+       points, i.e. the first timestep of every run of a value, so
+       the memory use is proportional to the number of changes and
+       not to the number of timesteps. Iterating over a
+       DynamicState visits every run once.
     */
 
 
@@ -60,20 +67,26 @@ class DynamicState {
         typedef typename std::vector< T >::iterator iterator;
 
         DynamicState( const TimeMap& timeMap, T initial ) :
-            m_data( timeMap.size(), initial ),
+            m_steps( 1, 0 ),
+            m_values( 1, std::move( initial ) ),
+            m_size( timeMap.size() ),
             initial_range( timeMap.size() )
         {}
 
         void globalReset( T value ) {
-            this->m_data.assign( this->m_data.size(), value );
+            this->m_steps.assign( 1, 0 );
+            this->m_values.assign( 1, std::move( value ) );
         }
 
         const T& back() const {
-            return m_data.back();
+            return m_values.back();
         }
 
         const T& at( size_t index ) const {
-            return this->m_data.at( index );
+            if (index >= this->m_size)
+                throw std::out_of_range("Invalid index for DynamicState");
+
+            return this->m_values[ this->run( index ) ];
         }
 
         const T& operator[](size_t index) const {
@@ -85,7 +98,8 @@ class DynamicState {
         }
 
         void updateInitial( T initial ) {
-            std::fill_n( this->m_data.begin(), this->initial_range, initial );
+            if (this->initial_range > 0)
+                this->assign( 0, this->initial_range, std::move( initial ) );
         }
 
         /**
@@ -93,25 +107,23 @@ class DynamicState {
            return true, otherwise it will return false.
         */
         bool update( size_t index, T value ) {
-            if( this->initial_range == this->m_data.size() )
+            if( this->initial_range == this->m_size )
                 this->initial_range = index;
 
-            const bool change = (value != this->m_data.at( index ));
+            const bool change = (value != this->at( index ));
 
             if( !change ) return false;
 
-            std::fill( this->m_data.begin() + index,
-                       this->m_data.end(),
-                       value );
+            this->assign( index, this->m_size, std::move( value ) );
 
             return true;
         }
 
         void update_elm( size_t index, const T& value ) {
-            if (this->m_data.size() <= index)
+            if (this->m_size <= index)
                 throw std::out_of_range("Invalid index for update_elm()");
 
-            this->m_data[index] = value;
+            this->assign( index, index + 1, value );
         }
 
 
@@ -123,48 +135,139 @@ class DynamicState {
       applied for all times in the range [Tx,T2].
     */
     void update_equal(size_t index, const T& value) {
-        if (this->m_data.size() <= index)
+        if (this->m_size <= index)
             throw std::out_of_range("Invalid index for update_equal()");
 
-        const T prev_value = this->m_data[index];
+        const T prev_value = this->at( index );
         if (prev_value == value)
             return;
 
-        while (true) {
-            if (this->m_data[index] != prev_value)
-                break;
-
-            this->m_data[index] = value;
-
-            index++;
-            if (index == this->m_data.size())
-                break;
+        auto next = this->run( index ) + 1;
+        while (next < this->m_steps.size() && this->m_values[next] == prev_value)
+            ++next;
 
-        }
+        const size_t last = (next < this->m_steps.size()) ? this->m_steps[next] : this->m_size;
+        this->assign( index, last, value );
     }
 
         /// Will return the index of the first occurence of @value, or
         /// -1 if @value is not found.
         int find(const T& value) const {
-            auto iter = std::find( m_data.begin() , m_data.end() , value);
-            if( iter == this->m_data.end() ) return -1;
+            auto iter = std::find( m_values.begin() , m_values.end() , value);
+            if( iter == this->m_values.end() ) return -1;
 
-            return std::distance( m_data.begin() , iter );
+            return this->m_steps[ std::distance( m_values.begin() , iter ) ];
         }
 
 
 
         iterator begin() {
-            return this->m_data.begin();
+            return this->m_values.begin();
         }
 
 
         iterator end() {
-            return this->m_data.end();
+            return this->m_values.end();
+        }
+
+        /*
+          The bytes allocated for the runs; the second form adds the
+          bytes returned by value_bytes(value) for the value of every
+          run, for value types which own memory themselves.
+        */
+        std::size_t memory_usage() const {
+            return MemoryUsage::heap( this->m_steps ) + MemoryUsage::heap( this->m_values );
+        }
+
+        template <typename F>
+        std::size_t memory_usage(F value_bytes) const {
+            std::size_t bytes = this->memory_usage();
+            for (const auto& value : this->m_values)
+                bytes += value_bytes( value );
+
+            return bytes;
+        }
+
+        /*
+          Only the runs are packed, i.e. the size of the buffer grows
+          with the number of changes and not with the number of
+          timesteps. The buffer must be able to write and read a T.
+        */
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const {
+            buffer.write( this->m_size );
+            buffer.write( this->initial_range );
+            buffer.write( this->m_steps.size() );
+            for (size_t run = 0; run < this->m_steps.size(); run++) {
+                buffer.write( this->m_steps[run] );
+                buffer.write( this->m_values[run] );
+            }
+        }
+
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer) {
+            size_t runs = 0;
+            buffer.read( this->m_size );
+            buffer.read( this->initial_range );
+            buffer.read( runs );
+            if (runs == 0)
+                throw std::invalid_argument("Can not read a DynamicState without values");
+
+            this->m_steps.resize( runs );
+            this->m_values.resize( runs, this->m_values.front() );
+            for (size_t run = 0; run < runs; run++) {
+                buffer.read( this->m_steps[run] );
+                buffer.read( this->m_values[run] );
+            }
         }
 
     private:
-        std::vector< T > m_data;
+        /// Index of the run which contains timestep @index.
+        size_t run( size_t index ) const {
+            if (index >= this->m_steps.back())
+                return this->m_steps.size() - 1;
+
+            auto iter = std::upper_bound( this->m_steps.begin(), this->m_steps.end(), index );
+            return std::distance( this->m_steps.begin(), iter ) - 1;
+        }
+
+        /// Make sure a run starts at timestep @index.
+        void split( size_t index ) {
+            const auto r = this->run( index );
+            if (this->m_steps[r] == index)
+                return;
+
+            T value = this->m_values[r];
+            this->m_steps.insert( this->m_steps.begin() + r + 1, index );
+            this->m_values.insert( this->m_values.begin() + r + 1, std::move( value ) );
+        }
+
+        void erase( size_t first, size_t last ) {
+            this->m_steps.erase( this->m_steps.begin() + first, this->m_steps.begin() + last );
+            this->m_values.erase( this->m_values.begin() + first, this->m_values.begin() + last );
+        }
+
+        /// Assign @value to the timesteps [first, last).
+        void assign( size_t first, size_t last, T value ) {
+            if (last < this->m_size)
+                this->split( last );
+            this->split( first );
+
+            const auto first_run = this->run( first );
+            const auto last_run = (last < this->m_size) ? this->run( last ) : this->m_steps.size();
+
+            /*
+              Neighbouring runs are deliberately not merged: some value
+              types compare equal while still carrying different data,
+              and the value stored last must be the one returned.
+            */
+            this->m_values[ first_run ] = std::move( value );
+            this->erase( first_run + 1, last_run );
+        }
+
+        std::vector< size_t > m_steps;
+        std::vector< T > m_values;
+        size_t m_size;
         size_t initial_range;
 };
 
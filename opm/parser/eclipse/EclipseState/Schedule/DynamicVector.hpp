@@ -22,6 +22,9 @@
 
 
 #include <stdexcept>
+#include <vector>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 
 namespace Opm {
@@ -58,6 +61,20 @@ namespace Opm {
             (*this)[index] = std::move( value );
         }
 
+        /* As DynamicState<T>::memory_usage(). */
+        std::size_t memory_usage() const {
+            return MemoryUsage::heap( this->m_data );
+        }
+
+        template <typename F>
+        std::size_t memory_usage(F value_bytes) const {
+            std::size_t bytes = this->memory_usage();
+            for (const auto& value : this->m_data)
+                bytes += value_bytes( value );
+
+            return bytes;
+        }
+
     private:
         std::vector<T> m_data;
     };
@@ -20,6 +20,7 @@
 #define SCHEDULE_EVENTS_HPP
 
 #include <cstdint>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp>
 
@@ -93,7 +94,19 @@ namespace Opm
 
             /* The VFP tables have changed */
             VFPINJ_UPDATE = 4096,
-            VFPPROD_UPDATE = 8192
+            VFPPROD_UPDATE = 8192,
+
+            /*
+              An existing well has been moved to another group with
+              the WELSPECS keyword.
+            */
+            WELL_GROUP_CHANGE = 16384,
+
+            /*
+              The efficiency factor of a well or group has been set
+              with the WEFAC or GEFAC keywords.
+            */
+            EFFICIENCY_UPDATE = 32768
         };
     }
 
@@ -110,6 +123,11 @@ namespace Opm
            // when a new well is introduced.
            ...
 
+      Besides the event mask of every report step the class keeps, for
+      every event type, the sorted list of report steps where it
+      happened, so that the next event, or any event in a range of
+      report steps, is found with a binary search per event type in
+      the mask instead of a loop over the report steps.
     */
 
     class Events {
@@ -117,8 +135,24 @@ namespace Opm
         explicit Events(const TimeMap& timeMap);
         void addEvent(ScheduleEvents::Events event, size_t reportStep);
         bool hasEvent(uint64_t eventMask, size_t reportStep) const;
+
+        /*
+          The first report step >= fromStep with one of the events in
+          eventMask, or -1 if there is no such report step.
+        */
+        int nextEvent(uint64_t eventMask, size_t fromStep) const;
+
+        /*
+          Whether one of the events in eventMask happens in one of the
+          report steps firstStep, ..., lastStep.
+        */
+        bool anyEvent(uint64_t eventMask, size_t firstStep, size_t lastStep) const;
+
+        /* The bytes allocated by the event lists, not counting the object itself. */
+        size_t memory_usage() const;
     private:
         DynamicVector<uint64_t> m_events;
+        std::vector<std::vector<size_t>> m_eventSteps;
     };
 }
 
@@ -20,6 +20,9 @@
 #ifndef GROUPTREE_HPP
 #define GROUPTREE_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <map>
@@ -28,6 +31,38 @@ namespace Opm {
 
 class GroupTree {
     public:
+        /*
+          The tree in flat form, with the nodes numbered in the order of
+          their names. The children of node n are the entries
+          child_offsets[n] <= i < child_offsets[n+1] of child_list. The
+          pre-order lists every node before its children and the
+          post-order every node after them, so a reduction over the tree
+          is one linear pass over postorder. Only the nodes connected to
+          FIELD are part of the traversal orders.
+        */
+        struct Index {
+            static const std::size_t npos = static_cast< std::size_t >( -1 );
+
+            std::vector< std::string > names;
+            std::vector< std::size_t > parent;
+            std::vector< std::size_t > level;
+            std::vector< std::size_t > child_offsets;
+            std::vector< std::size_t > child_list;
+            std::vector< std::size_t > preorder;
+            std::vector< std::size_t > postorder;
+            std::size_t root = npos;
+
+            std::size_t size() const;
+            std::size_t find( const std::string& name ) const;
+            std::size_t numChildren( std::size_t node ) const;
+
+            /*
+              Adds the value of every node to its parent, bottom up; on
+              return values[n] is the sum over the subtree of node n.
+            */
+            void accumulate( std::vector< double >& values ) const;
+        };
+
         void update( const std::string& name);
         void update( const std::string& name, const std::string& parent);
 	void updateSeqIndex( const std::string& name, const std::string& other_parent);
@@ -37,6 +72,10 @@ class GroupTree {
 	const std::map<std::string , size_t>& nameSeqIndMap() const;
 	const std::map<size_t, std::string >& seqIndNameMap() const;
 	size_t groupTreeSize();
+
+        /* Built on first use; the tree must not be updated while it is in use. */
+        const Index& index() const;
+
         bool operator==( const GroupTree& ) const;
         bool operator!=( const GroupTree& ) const;
 
@@ -59,6 +98,18 @@ class GroupTree {
         std::vector< group >::iterator find( const std::string& );
 	std::map<std::string , size_t> m_nameSeqIndMap;
 	std::map<size_t, std::string > m_seqIndNameMap;
+
+        struct IndexCache {
+            IndexCache() = default;
+            IndexCache(const IndexCache&) {}
+            IndexCache& operator=(const IndexCache&);
+            void reset();
+
+            std::atomic< bool > built{ false };
+            std::mutex build_mutex;
+            Index index;
+        };
+        mutable IndexCache index_cache;
 };
 
 }
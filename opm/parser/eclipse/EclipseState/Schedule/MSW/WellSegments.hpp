@@ -20,8 +20,8 @@
 #ifndef SEGMENTSET_HPP_HEADER_INCLUDED
 #define SEGMENTSET_HPP_HEADER_INCLUDED
 
+#include <string>
 #include <vector>
-#include <map>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/Segment.hpp>
@@ -62,6 +62,9 @@ namespace Opm {
         bool operator==( const WellSegments& ) const;
         bool operator!=( const WellSegments& ) const;
 
+        /* The bytes allocated for the segments, not counting the object itself. */
+        size_t memory_usage() const;
+
     private:
 
         // name of the well
@@ -90,8 +93,9 @@ namespace Opm {
 
         std::vector< Segment > m_segments;
         // the mapping from the segment number to the
-        // storage index in the vector
-        std::map<int, int> segment_number_to_index;
+        // storage index in the vector, indexed by the segment
+        // number; -1 for numbers without a segment
+        std::vector<int> segment_number_to_index;
     };
 }
 
@@ -19,8 +19,11 @@
 #ifndef SCHEDULE_HPP
 #define SCHEDULE_HPP
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -39,6 +42,7 @@
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellPropertyPool.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Actions.hpp>
 
@@ -60,15 +64,27 @@ namespace Opm
 
     class Schedule {
     public:
+        /*
+          With a restartStep the Schedule is only complete from that
+          report step on, for a run restarted at restartStep: the
+          keywords of the earlier report steps are all applied at report
+          step zero, in deck order. The state at restartStep and later is
+          the same as for the full Schedule, but the earlier history is
+          collapsed into one step, so every property holds a single
+          value before restartStep, and the events of the earlier steps
+          are all at step zero.
+        */
         Schedule(const Deck& deck,
                  const EclipseGrid& grid,
                  const Eclipse3DProperties& eclipseProperties,
                  const Runspec &runspec,
-                 const ParseContext& parseContext = ParseContext());
+                 const ParseContext& parseContext = ParseContext(),
+                 size_t restartStep = 0);
 
         Schedule(const Deck& deck,
                  const EclipseState& es,
-                 const ParseContext& parseContext = ParseContext());
+                 const ParseContext& parseContext = ParseContext(),
+                 size_t restartStep = 0);
 
         /*
          * If the input deck does not specify a start time, Eclipse's 1. Jan
@@ -82,14 +98,49 @@ namespace Opm
 
         const TimeMap& getTimeMap() const;
 
+        /* The first report step with the full history, see the constructor. */
+        size_t restartStep() const;
+
         size_t numWells() const;
         size_t numWells(size_t timestep) const;
         size_t getMaxNumConnectionsForWells(size_t timestep) const;
         bool hasWell(const std::string& wellName) const;
         const Well* getWell(const std::string& wellName) const;
-        std::vector< const Well* > getOpenWells(size_t timeStep) const;
+
+        /*
+          The wells and the groups are numbered 0, 1, ... in the order
+          they are defined, and keep their number for the whole run; the
+          number is the seqIndex() of the well or group. Code which
+          handles data of all the wells every report step can resolve
+          the names once and address the wells by number, e.g. with
+          SummaryState::well_var_index() and data::WellRates::by_index().
+          wellNames() and groupNames() are ordered by number.
+        */
+        size_t wellIndex(const std::string& wellName) const;
+        const Well* getWell(size_t wellIndex) const;
+        std::vector< std::string > wellNames() const;
         std::vector< const Well* > getWells() const;
-        std::vector< const Well* > getWells(size_t timeStep) const;
+
+        /*
+          The step based lists returned by reference, from getOpenWells(),
+          getWells(), getChangedWells(), getChildGroups() and getGroups(),
+          are valid until the next applyAction().
+        */
+        const std::vector< const Well* >& getOpenWells(size_t timeStep) const;
+        const std::vector< const Well* >& getWells(size_t timeStep) const;
+
+        /*
+          The wells with at least one event at report step 'timeStep',
+          i.e. the wells which were opened or shut, got new controls,
+          new connections or were moved to another group. Use
+          Well::hasEvent() to check for the individual events.
+        */
+        const std::vector< const Well* >& getChangedWells(size_t timeStep) const;
+        /*
+          The wells with one of the events in eventMask in one of the
+          report steps firstStep, ..., lastStep.
+        */
+        std::vector< const Well* > getChangedWells(uint64_t eventMask, size_t firstStep, size_t lastStep) const;
 
         /*
           The overload with a group name argument will return all
@@ -101,7 +152,7 @@ namespace Opm
           't'.
         */
         //std::vector< const Group& > getChildGroups(const std::string& group_name, size_t timeStep) const;
-        std::vector< const Group* > getChildGroups(const std::string& group_name, size_t timeStep) const;
+        const std::vector< const Group* >& getChildGroups(const std::string& group_name, size_t timeStep) const;
         std::vector< const Well* > getWells(const std::string& group, size_t timeStep) const;
         std::vector< const Well* > getChildWells(const std::string& group_name, size_t timeStep) const;
         std::vector< const Well* > getWellsMatching( const std::string& ) const;
@@ -111,13 +162,37 @@ namespace Opm
         const Actions& actionConfig() const;
         void evalAction(const SummaryState& summary_state, size_t timeStep);
 
+        /*
+          The wells and groups changed by applyAction().
+        */
+        struct ActionResult {
+            std::vector< std::string > wells;
+            std::vector< std::string > groups;
+        };
+
+        /*
+          Applies the keywords of an ACTIONX which has triggered at report
+          step 'reportStep', as if they had been in the SCHEDULE section at
+          that step. The keywords are handled in place: only the state of
+          the wells and groups they name is updated, from reportStep
+          onwards, and the names of those wells and groups are returned
+          so the caller can refresh just them. The step based well and
+          group lists are rebuilt on the next query; the lists and the
+          Well and Group pointers returned before are invalidated, and
+          fingerprint() changes so holders of them can tell.
+        */
+        ActionResult applyAction(size_t reportStep, const ActionX& action, const ParseContext& parseContext = ParseContext());
+
         const GroupTree& getGroupTree(size_t t) const;
         size_t numGroups() const;
         size_t numGroups(size_t timeStep) const;
         bool hasGroup(const std::string& groupName) const;
         const Group& getGroup(const std::string& groupName) const;
+        size_t groupIndex(const std::string& groupName) const;
+        const Group& getGroup(size_t groupIndex) const;
+        std::vector< std::string > groupNames() const;
         std::vector< const Group* > getGroups() const;
-        std::vector< const Group* > getGroups(size_t timeStep) const;
+        const std::vector< const Group* >& getGroups(size_t timeStep) const;
         const Tuning& getTuning() const;
         const MessageLimits& getMessageLimits() const;
         void invalidNamePattern (const std::string& namePattern, const ParseContext& parseContext, const DeckKeyword& keyword) const;
@@ -127,14 +202,40 @@ namespace Opm
         bool hasOilVaporizationProperties() const;
         const VFPProdTable& getVFPProdTable(int table_id, size_t timeStep) const;
         const VFPInjTable& getVFPInjTable(int table_id, size_t timeStep) const;
-        std::map<int, std::shared_ptr<const VFPProdTable> > getVFPProdTables(size_t timeStep) const;
-        std::map<int, std::shared_ptr<const VFPInjTable> > getVFPInjTables(size_t timeStep) const;
+        /*
+          The VFP tables in use at report step timeStep, by table id. The
+          maps are built once for each range of report steps without VFP
+          changes and are shared by those steps.
+        */
+        const std::map<int, std::shared_ptr<const VFPProdTable> >& getVFPProdTables(size_t timeStep) const;
+        const std::map<int, std::shared_ptr<const VFPInjTable> >& getVFPInjTables(size_t timeStep) const;
         /*
           Will remove all completions which are connected to cell which is not
           active. Will scan through all wells and all timesteps.
         */
         void filterConnections(const EclipseGrid& grid);
         size_t size() const;
+
+        /*
+          Parts for the wells - summed over all the wells - the events,
+          the modifier decks, the VFP tables and the step index. The
+          groups and the VFP tables are counted shallowly.
+        */
+        MemoryUsage memory_usage() const;
+
+        /*
+          The content fingerprint of the schedule, and of the wells at a
+          report step. The fingerprint of a report step combines its
+          time with Well::fingerprint() of the wells defined at the step;
+          the fingerprint of the schedule combines the fingerprints of
+          all the report steps with those of the SCHEDULE section
+          keywords and of the actions applied, which cover the state
+          which is not held by the wells. They are computed when the
+          schedule is built, and updated by filterConnections() and
+          applyAction().
+        */
+        const Fingerprint& fingerprint() const;
+        const Fingerprint& fingerprint(size_t timeStep) const;
     private:
         TimeMap m_timeMap;
         OrderedMap< Well > m_wells;
@@ -149,9 +250,80 @@ namespace Opm
         std::map<int, DynamicState<std::shared_ptr<VFPProdTable>>> vfpprod_tables;
         std::map<int, DynamicState<std::shared_ptr<VFPInjTable>>> vfpinj_tables;
         DynamicState<std::shared_ptr<WellTestConfig>> wtest_config;
+        WellPropertyPool m_wellProperties;
 
         WellProducer::ControlModeEnum m_controlModeWHISTCTL;
         Actions actions;
+        size_t m_restartStep;
+
+        Fingerprint m_inputFingerprint;
+        Fingerprint m_fingerprint;
+        std::vector< Fingerprint > m_stepFingerprints;
+        void updateFingerprints();
+
+        /*
+          The per report step well and group lists, and VFP table maps,
+          returned by reference from the step based queries. The index is
+          built on first use; consecutive report steps where nothing
+          changed share the same list. The index refers to the wells and
+          groups of the Schedule object it was built for, so copies start
+          out with an empty index.
+        */
+        struct StepIndex {
+            StepIndex() = default;
+            StepIndex(const StepIndex&) {}
+            StepIndex& operator=(const StepIndex&);
+
+            template< typename L >
+            struct Lists {
+                std::vector< L > lists;
+                std::vector< std::size_t > step;
+
+                void push_back(L list);
+                const L& at(size_t timeStep) const;
+            };
+
+            using WellLists = Lists< std::vector< const Well* > >;
+            using GroupLists = Lists< std::vector< const Group* > >;
+
+            std::atomic< bool > built{ false };
+            std::mutex build_mutex;
+
+            WellLists wells;
+            WellLists open_wells;
+            WellLists changed_wells;
+            GroupLists groups;
+            std::map< std::string, GroupLists > child_groups;
+            Lists< std::map< int, std::shared_ptr< const VFPProdTable > > > vfpprod_tables;
+            Lists< std::map< int, std::shared_ptr< const VFPInjTable > > > vfpinj_tables;
+        };
+        mutable StepIndex step_index;
+
+        const StepIndex& stepIndex() const;
+        void buildStepIndex(StepIndex& index) const;
+
+        /*
+          The positions in m_wells and m_groups of the names matching the
+          wildcard patterns seen so far. Wells and groups are only ever
+          appended, so an entry is brought up to date by matching the
+          names added since it was last used. The index is filled from
+          const queries and is therefore guarded by a mutex.
+        */
+        struct PatternIndex {
+            PatternIndex() = default;
+            PatternIndex(const PatternIndex&) {}
+            PatternIndex& operator=(const PatternIndex&);
+
+            struct Matches {
+                std::size_t checked = 0;
+                std::vector< std::size_t > index;
+            };
+
+            std::mutex mutex;
+            std::unordered_map< std::string, Matches > wells;
+            std::unordered_map< std::string, Matches > groups;
+        };
+        mutable PatternIndex pattern_index;
 
         std::vector< Well* > getWells(const std::string& wellNamePattern);
         std::vector< Group* > getGroups(const std::string& groupNamePattern);
@@ -165,6 +337,7 @@ namespace Opm
         void addWell(const std::string& wellName, const DeckRecord& record, size_t timeStep, WellCompletion::CompletionOrderEnum wellCompletionOrder);
         void handleCOMPORD(const ParseContext& parseContext, const DeckKeyword& compordKeyword, size_t currentStep);
         void handleWELSPECS( const SCHEDULESection&, size_t, size_t  );
+        void handleWELSPECS( const DeckKeyword& keyword, size_t currentStep, const DeckKeyword* compord );
         void handleWCONProducer( const DeckKeyword& keyword, size_t currentStep, bool isPredictionMode,  const ParseContext& parseContext);
         void handleWCONHIST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWCONPROD( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
@@ -20,8 +20,13 @@
 #ifndef SUMMARY_STATE_H
 #define SUMMARY_STATE_H
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ert/ecl/smspec_node.hpp>
 
@@ -58,11 +63,21 @@ namespace Opm{
       // accessible through the specialized st.has_well_var("OPY", "WGOR").
       st.has("WGOR:OPY") => True
       st.has_well_var("OPY", "WGOR") => False
+
+  Internally the values are stored in a flat vector, and every key is given
+  a dense index the first time it is seen. Code which updates the same set of
+  keys repeatedly, like the summary output, should register the keys once
+  with index() and then use the index based set() and get() methods; the
+  string based methods remain available for the occasional lookup. The
+  clear() method forgets all the values, but keeps the keys and the storage,
+  i.e. a SummaryState can be reused without allocating. Two SummaryState
+  instances where the same keys have been registered in the same order will
+  use the same indices, and can be swapped.
 */
 
 class SummaryState {
 public:
-    typedef std::unordered_map<std::string, double>::const_iterator const_iterator;
+    class const_iterator;
 
     double get(const std::string&) const;
     bool has(const std::string& key) const;
@@ -72,12 +87,127 @@ public:
     void add_well_var(const std::string& well, const std::string& var, double value);
     bool has_well_var(const std::string& well, const std::string& var) const;
     double get_well_var(const std::string& well, const std::string& var) const;
+    std::size_t well_var_index(const std::string& well, const std::string& var);
+
+    /*
+      The indices of the variable var of the wells, in the order of the
+      names; with the names of Schedule::wellNames() the index of a
+      well's variable is the element at its Schedule::wellIndex().
+    */
+    std::vector<std::size_t> well_var_index(const std::vector<std::string>& wells, const std::string& var);
+
+    std::size_t index(const std::string& key);
+    std::size_t index(const ecl::smspec_node& node);
+    bool find(const std::string& key, std::size_t& index) const;
+    std::size_t size() const;
+
+    /*
+      An id of the registered keys and their indices: states with the
+      same layout() have the same keys at the same indices, e.g. a state
+      and its copies. Registering a new key gives the state a new layout.
+    */
+    std::size_t layout() const;
+    const std::string& key(std::size_t index) const;
+    bool has(std::size_t index) const;
+    double get(std::size_t index) const;
+    void set(std::size_t index, double value);
+    void clear();
+
+    /*
+      All the values as one block, in index order; the entries of keys
+      without a value are unspecified. set_data() assigns a value to
+      every key, and requires size() values.
+    */
+    const std::vector<double>& data() const;
+    void set_data(const std::vector<double>& values);
+
+    /*
+      Makes this state a copy of other. When the keys of other are the
+      keys of this state followed by new ones, as for the buffers of a
+      SummaryStateBuffer, only the new keys and the values are copied.
+    */
+    void update(const SummaryState& other);
+
+    /* The bytes allocated for the keys and values, not counting the object itself. */
+    std::size_t memory_usage() const;
 
     const_iterator begin() const;
     const_iterator end() const;
+
+    /*
+      Iterates over the keys which have a value, the elements are
+      (key, value) pairs.
+    */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair< std::string, double >;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        const_iterator(const SummaryState* state, std::size_t index);
+        value_type operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+
+    private:
+        void skip_unset();
+
+        const SummaryState* state;
+        std::size_t pos;
+    };
+
+private:
+    static std::size_t new_layout();
+
+    std::unordered_map<std::string, std::size_t> key_index;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> well_index;
+    std::vector<std::string> keys;
+    std::vector<double> values;
+    std::vector<char> assigned;
+    std::size_t layout_id = new_layout();
+};
+
+
+/*
+  A SummaryState which is written by the simulator while it is read
+  elsewhere, e.g. by the ACTIONX and UDQ evaluation or the output
+  thread. The writers fill back(), and publish() makes it the current
+  snapshot; the readers get the snapshot with snapshot(), an immutable
+  state which is neither copied nor locked and which stays valid for as
+  long as they hold it, while the writers go on with the next step.
+
+     SummaryStateBuffer buffer;
+     buffer.back().add_well_var("OP1", "WOPR", 100);
+     buffer.publish();
+
+     auto st = buffer.snapshot();    // any thread
+     st->get_well_var("OP1", "WOPR");
+
+  After publish() the back buffer starts as a copy of the published
+  state. It is the state published two steps back when no reader holds
+  that any more, so a step reuses the storage of the earlier steps and
+  only copies the values.
+
+  back() and publish() must be called by one writer at a time; several
+  threads may set() values of keys registered beforehand, with index(),
+  in back() at the same time. snapshot() can be called from any thread.
+*/
+
+class SummaryStateBuffer {
+public:
+    SummaryStateBuffer();
+
+    SummaryState& back();
+    void publish();
+    std::shared_ptr<const SummaryState> snapshot() const;
+
 private:
-    std::unordered_map<std::string,double> values;
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> well_values;
+    std::shared_ptr<SummaryState> back_state;
+    std::shared_ptr<SummaryState> published;
+    std::shared_ptr<const SummaryState> front;
 };
 
 }
@@ -55,6 +55,15 @@ namespace Opm {
         /// Return the length of a given time step in seconds.
         double getTimeStepLength(size_t tStepIdx) const;
 
+        /// Return the index of the last time step starting at or before the given
+        /// point in time; throws std::invalid_argument for times before the start.
+        size_t step_of(std::time_t t) const;
+        /// As step_of(), for a point in time given in seconds since the start.
+        size_t step_of_seconds(double seconds) const;
+        /// Return the seconds from the start of the simulation to the start of
+        /// every time step, i.e. element i is seconds(i).
+        const std::vector<double>& cumulativeSeconds() const;
+
         /// Return true if the given timestep is the first one of a new month or year, or if frequency > 1,
         /// return true for every n'th timestep of every first new month or first new year timesteps,
         /// starting from start_timestep-1.
@@ -74,8 +83,8 @@ namespace Opm {
         const std::vector<size_t>& getFirstTimestepMonths() const;
         const std::vector<size_t>& getFirstTimestepYears() const;
         bool isTimestepInFreqSequence (size_t timestep, size_t start_timestep, size_t frequency, bool years) const;
-        size_t closest(const std::vector<size_t> & vec, size_t value) const;
 
+        std::vector<double> m_cumulative_seconds;     // The seconds since the start of every timestep
         std::vector<size_t> m_first_timestep_years;   // A list of the first timestep of every year
         std::vector<size_t> m_first_timestep_months;  // A list of the first timestep of every month
     };
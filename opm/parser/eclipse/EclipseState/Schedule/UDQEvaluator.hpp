@@ -0,0 +1,166 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef UDQ_EVALUATOR_HPP_
+#define UDQ_EVALUATOR_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/UDQConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ.hpp>
+
+
+namespace Opm {
+
+    class SummaryState;
+
+    /*
+      The UDQEvaluator compiles the ASSIGN and DEFINE expressions of the UDQ
+      keyword for field, group and well quantities, and evaluates them
+      against a SummaryState. A well or group quantity is a dense array
+      indexed by the position of the well or group in the lists passed to
+      the constructor, and every operation in an expression is applied to
+      the complete array at once:
+
+         DEFINE WUOPRL  WOPR 'P*' * 0.5 /
+
+      is evaluated as one gather of WOPR for all the wells, one
+      multiplication of the whole array and one write of WUOPRL back to the
+      SummaryState. Wells which are not selected by a pattern, or where a
+      value is missing, are undefined; undefined values propagate through
+      the arithmetic, are skipped by the reductions SUM, AVEA, MAX, ... and
+      are written as the UDQPARAM undefined value. When a UDQ is used in a
+      later expression its undefined elements remain undefined.
+
+      The SummaryState indices of all the quantities are resolved on the
+      first call to eval(), and then again only when eval() is called with
+      a SummaryState of another layout(), e.g. after keys have been added.
+      Calls to eval() from several threads are serialized. Expressions
+      for other variable types (segment, connection, region, aquifer and
+      block) are ignored.
+    */
+    class UDQEvaluator {
+    public:
+        UDQEvaluator(const UDQConfig& config,
+                     const UDQ& udq,
+                     const std::vector<std::string>& wells,
+                     const std::vector<std::string>& groups);
+
+        void eval(SummaryState& st) const;
+
+    private:
+        enum class VarType {
+            FIELD,
+            WELL,
+            GROUP
+        };
+
+        enum class OpCode {
+            number, vector,
+            neg, add, sub, mul, div, pow,
+            eq, ne, gt, ge, lt, le,
+            uadd, umax, umin, umul,
+            sum, avea, aveg, aveh, max, min, norm1, norm2, normi, prod,
+            abs, exp, ln, log, nint, sorta, sortd
+        };
+
+        struct Instruction {
+            OpCode code;
+            std::size_t arg;
+        };
+
+        struct Vector {
+            VarType type;
+            std::string var;
+            std::string pattern;
+            std::size_t definition;
+        };
+
+        struct Definition {
+            UDQAction action;
+            VarType type;
+            std::string keyword;
+            std::string pattern;
+            double value;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct Set {
+            VarType type;
+            std::vector<double> values;
+            std::vector<char> defined;
+        };
+
+        class Compiler;
+
+        std::size_t size(VarType type) const;
+        const std::string& name(VarType type, std::size_t index) const;
+        std::size_t key_index(SummaryState& st, VarType type, const std::string& var, std::size_t index) const;
+        void resolve(SummaryState& st) const;
+        Set& push(std::size_t& sp, VarType type) const;
+        void binary(OpCode code, Set& lhs, const Set& rhs) const;
+        void unary(OpCode code, Set& arg) const;
+        void reduce(OpCode code, Set& arg) const;
+
+        double undefined_value;
+        double cmp_eps;
+        std::vector<std::string> wells;
+        std::vector<std::string> groups;
+
+        std::vector<Definition> definitions;
+        std::vector<Instruction> program;
+        std::vector<double> numbers;
+        std::vector<Vector> vectors;
+
+        /*
+          SummaryState index of element i of vector v is
+          vector_index[vector_offset[v] + i], and correspondingly for the
+          output of definition d through output_offset. Elements which are
+          not selected hold npos. The output_defined flags record which
+          elements of the UDQs were defined in the last evaluation.
+        */
+        mutable std::vector<std::size_t> vector_index;
+        mutable std::vector<std::size_t> vector_offset;
+        mutable std::vector<std::size_t> output_index;
+        mutable std::vector<std::size_t> output_offset;
+        mutable std::vector<char> output_defined;
+        mutable std::size_t resolved_layout = 0;
+        mutable std::vector<Set> stack;
+
+        /*
+          Serializes eval(), which updates the members above; a copied
+          evaluator gets a lock of its own.
+        */
+        struct EvalLock {
+            EvalLock() = default;
+            EvalLock(const EvalLock&) {}
+            EvalLock& operator=(const EvalLock&) { return *this; }
+
+            std::mutex mutex;
+        };
+        mutable EvalLock eval_lock;
+    };
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_VFP_EVALUATOR_HPP
+#define OPM_VFP_EVALUATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    class VFPInjTable;
+    class VFPProdTable;
+
+    /*
+      The value of a VFP table and its partial derivatives with respect
+      to the table axes. The derivatives of the axes an evaluator does
+      not have, e.g. wfr for an injection table, are zero.
+    */
+    struct VFPEvaluation {
+        double value = 0;
+        double dthp = 0;
+        double dwfr = 0;
+        double dgfr = 0;
+        double dalq = 0;
+        double dflo = 0;
+    };
+
+
+    /*
+      One axis of a VFP table. locate() finds the segment containing a
+      value and the position of the value within the segment; values
+      outside the axis are extrapolated linearly from the first or the
+      last segment. On input the index is a hint for the segment, as for
+      TableEvaluator. An axis with a single point has the position zero
+      and no slope.
+    */
+    class VFPAxis {
+    public:
+        VFPAxis() = default;
+        explicit VFPAxis(const std::vector<double>& values);
+
+        void locate(double x, std::size_t& index, double& factor) const;
+        double inverseWidth(std::size_t index) const;
+        std::size_t size() const;
+
+    private:
+        std::vector<double> m_values;
+        std::vector<double> m_inv_width;
+    };
+
+
+    /*
+      Precomputed evaluation of a VFPPROD table: multilinear interpolation
+      in thp, wfr, gfr, alq and flo, with linear extrapolation outside the
+      axes. The table is copied into one contiguous array in the order of
+      VFPProdTable::getTable(), i.e. with flo innermost, so the two flo
+      values of a corner pair are adjacent and the 32 corners of a cell of
+      the table are read from 16 short runs. The inverse widths of the
+      axis segments are computed once up front.
+
+      The batch versions evaluate the table for many wells at once; the
+      segments found for one well are the hints for the next.
+    */
+    class VFPProdEvaluator {
+    public:
+        explicit VFPProdEvaluator(const VFPProdTable& table);
+
+        double operator()(double thp, double wfr, double gfr, double alq, double flo) const;
+        VFPEvaluation evaluate(double thp, double wfr, double gfr, double alq, double flo) const;
+
+        void evaluate(std::size_t size,
+                      const double* thp, const double* wfr, const double* gfr,
+                      const double* alq, const double* flo,
+                      double* bhp) const;
+
+        void evaluate(std::size_t size,
+                      const double* thp, const double* wfr, const double* gfr,
+                      const double* alq, const double* flo,
+                      VFPEvaluation* result) const;
+
+    private:
+        static const std::size_t dims = 5;
+
+        double eval(const double* x, std::size_t* hint, double* deriv) const;
+
+        VFPAxis m_axes[dims];
+
+        /* The distance in m_data between neighbouring points along each
+           axis; zero for an axis with a single point. */
+        std::size_t m_step[dims];
+        std::vector<double> m_data;
+    };
+
+
+    /*
+      As VFPProdEvaluator, for the thp and flo axes of a VFPINJ table.
+    */
+    class VFPInjEvaluator {
+    public:
+        explicit VFPInjEvaluator(const VFPInjTable& table);
+
+        double operator()(double thp, double flo) const;
+        VFPEvaluation evaluate(double thp, double flo) const;
+
+        void evaluate(std::size_t size, const double* thp, const double* flo, double* bhp) const;
+        void evaluate(std::size_t size, const double* thp, const double* flo, VFPEvaluation* result) const;
+
+    private:
+        static const std::size_t dims = 2;
+
+        double eval(const double* x, std::size_t* hint, double* deriv) const;
+
+        VFPAxis m_axes[dims];
+        std::size_t m_step[dims];
+        std::vector<double> m_data;
+    };
+}
+
+#endif
@@ -21,7 +21,9 @@
 #ifndef WELL_HPP_
 #define WELL_HPP_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/WellSegments.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
 
 namespace Opm {
 
@@ -116,13 +119,19 @@ namespace Opm {
           negative values are arbitrary negative id values for connections which
           have not been lumped together in a completion. In the case of negative
           id values the list of connections always has exactly one element.
+
+          The map is built on first use and shared by all the report steps
+          with the same connections; the reference is valid until the
+          connections of the well are changed.
          */
 
-        std::map<int, std::vector<Connection>> getCompletions(size_t time_step) const;
+        const std::map<int, std::vector<Connection>>& getCompletions(size_t time_step) const;
         const WellConnections& getConnections(size_t timeStep) const;
         const WellConnections& getConnections() const;
         WellConnections getActiveConnections(size_t timeStep, const EclipseGrid& grid) const;
         WellConnections * newWellConnections(size_t time_step);
+        /* A new set sharing the connections of time_step, see WellConnections. */
+        WellConnections * copyWellConnections(size_t time_step);
         void updateWellConnections(size_t time_step, WellConnections * new_set );
 
         /* The rate of a given phase under the following assumptions:
@@ -139,15 +148,30 @@ namespace Opm {
         bool operator==(const Well&) const;
         bool operator!=(const Well&) const;
 
+        /*
+          Named after the well, with one part for the connections, the
+          segments, the events and the other time dependent properties.
+        */
+        MemoryUsage memory_usage() const;
+
+        /*
+          The control properties are held as shared, immutable values;
+          the Schedule passes the values interned in its WellPropertyPool,
+          so wells with the same settings share them. The overloads taking
+          a value make a private copy.
+        */
         bool                            setProductionProperties(size_t timeStep , const WellProductionProperties& properties);
+        bool                            setProductionProperties(size_t timeStep , std::shared_ptr<const WellProductionProperties> properties);
         WellProductionProperties        getProductionPropertiesCopy(size_t timeStep) const;
         const WellProductionProperties& getProductionProperties(size_t timeStep)  const;
 
         bool                           setInjectionProperties(size_t timeStep , const WellInjectionProperties& properties);
+        bool                           setInjectionProperties(size_t timeStep , std::shared_ptr<const WellInjectionProperties> properties);
         WellInjectionProperties        getInjectionPropertiesCopy(size_t timeStep) const;
         const WellInjectionProperties& getInjectionProperties(size_t timeStep) const;
 
         bool                           setPolymerProperties(size_t timeStep , const WellPolymerProperties& properties);
+        bool                           setPolymerProperties(size_t timeStep , std::shared_ptr<const WellPolymerProperties> properties);
         WellPolymerProperties          getPolymerPropertiesCopy(size_t timeStep) const;
         const WellPolymerProperties&   getPolymerProperties(size_t timeStep) const;
 
@@ -158,6 +182,7 @@ namespace Opm {
         const double&                  getSolventFraction(size_t timeStep) const;
 
         bool                            setEconProductionLimits(const size_t timeStep, const WellEconProductionLimits& productionlimits);
+        bool                            setEconProductionLimits(const size_t timeStep, std::shared_ptr<const WellEconProductionLimits> productionlimits);
         const WellEconProductionLimits& getEconProductionLimits(const size_t timeStep) const;
 
         int  firstRFTOutput( ) const;
@@ -205,6 +230,19 @@ namespace Opm {
           scan through all timesteps.
         */
         void filterConnections(const EclipseGrid& grid);
+
+        /*
+          The content fingerprint of the well at the report step: the
+          status, the group, the control, polymer, tracer and economic
+          properties, the connections, the segments, the events and the
+          other time dependent properties. The fingerprints of all the
+          report steps are computed by updateFingerprints(), which the
+          Schedule calls when it has built or changed the well; the
+          properties and connections shared between report steps are
+          only fingerprinted once.
+        */
+        const Fingerprint& fingerprint(size_t timeStep) const;
+        void updateFingerprints();
     private:
         size_t m_creationTimeStep;
         std::string m_name;
@@ -221,10 +259,10 @@ namespace Opm {
 
         DynamicState< int > m_isProducer;
         DynamicState< std::shared_ptr<WellConnections> > m_completions;
-        DynamicState< WellProductionProperties > m_productionProperties;
-        DynamicState< WellInjectionProperties > m_injectionProperties;
-        DynamicState< WellPolymerProperties > m_polymerProperties;
-        DynamicState< WellEconProductionLimits > m_econproductionlimits;
+        DynamicState< std::shared_ptr< const WellProductionProperties > > m_productionProperties;
+        DynamicState< std::shared_ptr< const WellInjectionProperties > > m_injectionProperties;
+        DynamicState< std::shared_ptr< const WellPolymerProperties > > m_polymerProperties;
+        DynamicState< std::shared_ptr< const WellEconProductionLimits > > m_econproductionlimits;
         DynamicState< double > m_solventFraction;
         DynamicState< WellTracerProperties > m_tracerProperties;
         DynamicState< std::string > m_groupName;
@@ -245,6 +283,22 @@ namespace Opm {
         DynamicState< WellSegments > m_segmentset;
         size_t timesteps;
         Events events;
+        DynamicState< Fingerprint > m_fingerprints;
+
+        /*
+          The getCompletions() maps by connection set. Cleared whenever the
+          connections are changed, and not copied along with the well.
+        */
+        struct CompletionsCache {
+            CompletionsCache() = default;
+            CompletionsCache(const CompletionsCache&) {}
+            CompletionsCache& operator=(const CompletionsCache&);
+            void clear();
+
+            std::mutex mutex;
+            std::map< const WellConnections*, std::map<int, std::vector<Connection>> > completions;
+        };
+        mutable CompletionsCache completions_cache;
     };
 }
 
@@ -21,15 +21,33 @@
 #ifndef CONNECTIONSET_HPP_
 #define CONNECTIONSET_HPP_
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/Connection.hpp>
 
 namespace Opm {
     class EclipseGrid;
     class Eclipse3DProperties;
+
+    /*
+      The connections are shared between the copies of a set: a copy
+      only copies pointers, and a connection is first copied when it is
+      modified through one of the non-const accessors. A set and the
+      sets copied from it also share the connection factors computed by
+      loadCOMPDAT(), so that a connection which is specified again with
+      the same input is not computed again.
+    */
     class WellConnections {
     public:
         WellConnections() = default;
         WellConnections(int headI, int headJ);
+        /* Shares the connections of src, with another well head. */
+        WellConnections(int headI, int headJ, const WellConnections& src);
         // cppcheck-suppress noExplicitConstructor
         WellConnections(const WellConnections& src, const EclipseGrid& grid);
         void addConnection(int i, int j , int k ,
@@ -48,12 +66,21 @@ namespace Opm {
                            const bool defaultSatTabId = true);
         void loadCOMPDAT(const DeckRecord& record, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, std::size_t& totNC);
 
-        using const_iterator = std::vector< Connection >::const_iterator;
+        /*
+          Evaluate the lazily initialized grid properties and SI
+          converted record items used by loadCOMPDAT(). After this
+          loadCOMPDAT() can be called concurrently on different
+          WellConnections instances.
+        */
+        static void prepareCOMPDAT(const DeckRecord& record, const Eclipse3DProperties& eclipseProperties);
+
+        using const_iterator = boost::indirect_iterator< std::vector< std::shared_ptr< Connection > >::const_iterator, const Connection >;
 
         void add( Connection );
         size_t size() const;
         const Connection& operator[](size_t index) const;
         const Connection& get(size_t index) const;
+        Connection& get(size_t index);
         const Connection& getFromIJK(const int i, const int j, const int k) const;
         Connection& getFromIJK(const int i, const int j, const int k);
 
@@ -81,6 +108,36 @@ namespace Opm {
         bool operator==( const WellConnections& ) const;
         bool operator!=( const WellConnections& ) const;
 
+        /*
+          The fields of the connections as contiguous arrays, element c
+          of every array belonging to connection c, for the code which
+          passes over one or two fields of all the connections. The
+          columns are assembled on the first call, which is safe from
+          several threads, and kept until the connections are modified;
+          the references are invalidated by any non-const call.
+        */
+        struct Columns {
+            std::vector< int > i, j, k;
+            std::vector< int > complnum;
+            std::vector< int > segment;
+            std::vector< int > satTableId;
+            std::vector< WellCompletion::StateEnum > state;
+            std::vector< WellCompletion::DirectionEnum > direction;
+            std::vector< double > depth;
+            std::vector< double > CF;
+            std::vector< double > Kh;
+            std::vector< double > rw;
+            std::vector< double > r0;
+            std::vector< double > skinFactor;
+
+            size_t memory_usage() const;
+        };
+
+        const Columns& columns() const;
+
+        /* The bytes allocated for the connections, not counting the object itself. */
+        size_t memory_usage() const;
+
     private:
         void addConnection(int i, int j , int k ,
                            int complnum,
@@ -99,9 +156,51 @@ namespace Opm {
                            const bool defaultSatTabId = true);
 
         size_t findClosestConnection(int oi, int oj, double oz, size_t start_pos);
+        void invalidateColumns();
+        Connection& unshare(size_t index);
+
+        /*
+          The input of the connection factor calculation of one cell,
+          and the resulting CF, Kh and effective radius.
+        */
+        struct FactorKey {
+            std::size_t global_index;
+            int direction;
+            double rw;
+            double skin_factor;
+            double CF;
+            double Kh;
+            double r0;
+            bool Kh_from_CF;
+
+            bool operator==( const FactorKey& ) const;
+        };
+
+        struct FactorHash {
+            std::size_t operator()( const FactorKey& ) const;
+        };
+
+        struct Factors {
+            double CF;
+            double Kh;
+            double r0;
+        };
+
+        using FactorCache = std::unordered_map< FactorKey, Factors, FactorHash >;
+
+        /* Copies and assigns the assembled columns atomically. */
+        struct ColumnCache {
+            ColumnCache() = default;
+            ColumnCache( const ColumnCache& );
+            ColumnCache& operator=( const ColumnCache& );
+
+            std::shared_ptr< const Columns > columns;
+        };
 
         int headI, headJ;
-        std::vector< Connection > m_connections;
+        std::vector< std::shared_ptr< Connection > > m_connections;
+        std::shared_ptr< FactorCache > m_factors;
+        mutable ColumnCache m_columns;
     };
 }
 
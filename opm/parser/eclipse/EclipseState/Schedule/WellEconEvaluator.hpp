@@ -0,0 +1,122 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_WELL_ECON_EVALUATOR_HPP
+#define OPM_WELL_ECON_EVALUATOR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
+
+namespace Opm {
+
+    class Well;
+    class WellTestState;
+
+    /*
+      Evaluates the WECON economic limits of all the wells of a report
+      step in one pass. The limits are gathered from the wells once, into
+      one array per limit, when the evaluator is constructed; a limit
+      which is not set, and all the limits of an injector, are zero.
+
+      The simulator passes the surface production rates of the wells as
+      one array per phase, in the order of the wells passed to the
+      constructor. Wells with a zero total rate are not flowing and are
+      not checked. For wells with the POTN quantity limit the rate limits
+      are checked against the potentials when they are given. As in
+      WellEconProductionLimits the secondary water cut limit is not
+      handled.
+    */
+    class WellEconEvaluator {
+    public:
+        enum Limit {
+            MIN_OIL_RATE         = 1,
+            MIN_GAS_RATE         = 2,
+            MIN_LIQUID_RATE      = 4,
+            MIN_RESERVOIR_RATE   = 8,
+            MAX_WATER_CUT        = 16,
+            MAX_GAS_OIL_RATIO    = 32,
+            MAX_WATER_GAS_RATIO  = 64,
+            MAX_GAS_LIQUID_RATIO = 128
+        };
+
+        static const int RateLimits  = MIN_OIL_RATE | MIN_GAS_RATE | MIN_LIQUID_RATE | MIN_RESERVOIR_RATE;
+        static const int RatioLimits = MAX_WATER_CUT | MAX_GAS_OIL_RATIO | MAX_WATER_GAS_RATIO | MAX_GAS_LIQUID_RATIO;
+
+        /*
+          Surface rates of oil, gas and water and the reservoir volume
+          rate, all positive for production and in SI units; the ratio
+          limits are compared as WellEconProductionLimits holds them, in
+          the units of the deck. Without the
+          reservoir rates the MIN_RESERVOIR_RATE limits are not checked.
+        */
+        struct Rates {
+            const double* oil = nullptr;
+            const double* gas = nullptr;
+            const double* water = nullptr;
+            const double* reservoir = nullptr;
+        };
+
+        /*
+          A well which violates one or more of its limits. A violated
+          rate limit shuts the well, i.e. the workover is WELL; for the
+          ratio limits it is the workover of the WECON record, e.g. CON
+          to close the worst offending connection, which is left to the
+          simulator.
+        */
+        struct Violation {
+            std::size_t well;
+            int limits;
+            WellEcon::WorkoverEnum workover;
+            bool end_run;
+        };
+
+        WellEconEvaluator(const std::vector<const Well*>& wells, std::size_t timeStep);
+
+        std::size_t size() const;
+        const std::string& name(std::size_t well) const;
+
+        std::vector<Violation> evaluate(const Rates& rates, const Rates* potentials = nullptr) const;
+
+        /*
+          Records the wells which are shut by the violations as closed
+          for ECONOMIC reasons, so that WTEST will consider them for
+          reopening.
+        */
+        void close(const std::vector<Violation>& violations, WellTestState& state, double sim_time) const;
+
+    private:
+        std::vector<std::string> m_names;
+        std::vector<double> m_min_oil_rate;
+        std::vector<double> m_min_gas_rate;
+        std::vector<double> m_min_liquid_rate;
+        std::vector<double> m_min_reservoir_rate;
+        std::vector<double> m_max_water_cut;
+        std::vector<double> m_max_gas_oil_ratio;
+        std::vector<double> m_max_water_gas_ratio;
+        std::vector<double> m_max_gas_liquid_ratio;
+        std::vector<char> m_potentials;
+        std::vector<char> m_end_run;
+        std::vector<WellEcon::WorkoverEnum> m_workover;
+    };
+}
+
+#endif
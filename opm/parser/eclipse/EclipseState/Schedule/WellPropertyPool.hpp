@@ -0,0 +1,69 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_WELL_PROPERTY_POOL_HPP
+#define OPM_WELL_PROPERTY_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WellEconProductionLimits.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellInjectionProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp>
+
+namespace Opm {
+
+    /*
+      The distinct well control settings of a Schedule. Keywords like
+      WCONPROD 'P*' give thousands of wells the same properties; intern()
+      returns the one shared, immutable copy of a value, so the wells hold
+      handles to it and the memory grows with the number of distinct
+      settings instead of with the number of wells. Two values are the
+      same object exactly when all their fields are equal, including the
+      ones their operator== does not compare, e.g. the ALQ value of the
+      production properties.
+
+      The pool is not thread safe; the Schedule fills it while the
+      SCHEDULE section is processed.
+    */
+    class WellPropertyPool {
+    public:
+        std::shared_ptr<const WellProductionProperties> intern(const WellProductionProperties& properties);
+        std::shared_ptr<const WellInjectionProperties> intern(const WellInjectionProperties& properties);
+        std::shared_ptr<const WellPolymerProperties> intern(const WellPolymerProperties& properties);
+        std::shared_ptr<const WellEconProductionLimits> intern(const WellEconProductionLimits& limits);
+
+        /* The number of distinct values, of all the types. */
+        std::size_t size() const;
+        std::size_t memory_usage() const;
+
+    private:
+        template <typename T>
+        using Pool = std::unordered_multimap<std::size_t, std::shared_ptr<const T>>;
+
+        Pool<WellProductionProperties> production;
+        Pool<WellInjectionProperties> injection;
+        Pool<WellPolymerProperties> polymer;
+        Pool<WellEconProductionLimits> econ_limits;
+    };
+}
+
+#endif
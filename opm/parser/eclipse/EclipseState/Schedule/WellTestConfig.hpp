@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -55,6 +56,15 @@ public:
 
 private:
     std::vector<WTESTWell> wells;
+
+    /*
+      The positions in wells of the entries for every well name, so that
+      the simulator can look up the configuration of a closed well
+      without scanning all the WTEST entries.
+    */
+    std::unordered_map<std::string, std::vector<size_t>> index;
+
+    const WTESTWell* find(const std::string& well, Reason reason) const;
 };
 
 
@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.hpp>
@@ -113,6 +114,14 @@ public:
 private:
     std::vector<ClosedWell> wells;
     std::vector<ClosedCompletion> completions;
+
+    /*
+      For every well in wells the bitwise or of the reasons it is closed
+      for, and for every well in completions the numbers of its closed
+      completions; the has...() queries are then lookups by well name.
+    */
+    std::unordered_map<std::string, int> well_reasons;
+    std::unordered_map<std::string, std::vector<int>> well_completions;
 };
 
 
@@ -23,6 +23,8 @@
 #include <string>
 #include <map>
 
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
+
 namespace Opm {
 
     class WellTracerProperties {
@@ -36,6 +38,9 @@ namespace Opm {
         bool operator==(const WellTracerProperties& other) const;
         bool operator!=(const WellTracerProperties& other) const;
 
+        /* The tracers and their concentrations, by tracer name. */
+        Fingerprint fingerprint() const;
+
     private:
         std::map< std::string, double > m_tracerConcentrations;
     };
@@ -20,7 +20,7 @@
 #ifndef OPM_TRESHOLD_PRESSURES_HPP
 #define OPM_TRESHOLD_PRESSURES_HPP
 
-#include <map>
+#include <cstddef>
 #include <vector>
 
 namespace Opm {
@@ -62,19 +62,36 @@ namespace Opm {
           hasThresholdPressure(r1,r2) first to be safe.
         */
         double getThresholdPressure(int r1 , int r2) const;
+
+        /*
+          The threshold pressures for a list of region pairs, e.g. the
+          EQLNUM values on the two sides of the faces of the grid; i.e.
+          getThresholdPressure(region1[i], region2[i]) for all i. The
+          two lists must have the same length.
+        */
+        std::vector<double> getThresholdPressures(const std::vector<int>& region1 , const std::vector<int>& region2) const;
         size_t size() const;
         bool active() const;
         bool restart() const;
     private:
         bool m_active;
         bool m_restart;
-        static std::pair<int,int> makeIndex(int r1 , int r2);
+        size_t m_size = 0;
+        int m_numRegions = 0;
+
+        static const size_t npos = static_cast<size_t>(-1);
+        size_t index(int r1 , int r2) const;
+        double lookup(int r1 , int r2) const;
         void addPair(int r1 , int r2 , const std::pair<bool , double>& valuePair);
         void addBarrier(int r1 , int r2);
         void addBarrier(int r1 , int r2 , double p);
 
+        /*
+          Symmetric m_numRegions x m_numRegions tables, the pair of
+          regions r1 and r2 is at (r1 - 1) * m_numRegions + (r2 - 1).
+        */
+        std::vector<bool> m_regionBarrier;
         std::vector<std::pair<bool,double>> m_thresholdPressureTable;
-        std::map<std::pair<int,int> , std::pair<bool , double> > m_pressureTable;
     };
 } //namespace Opm
 
@@ -26,6 +26,8 @@
 
 #include <ert/ecl/smspec_node.hpp>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+
 namespace Opm {
 
     /*
@@ -136,6 +138,9 @@ namespace Opm {
             */
             bool require3DField( const std::string& keyword) const;
             bool requireFIPNUM( ) const;
+
+            /* The strings held by the libecl nodes are not counted. */
+            MemoryUsage memory_usage() const;
         private:
             SummaryConfig( const Deck& deck,
                            const Schedule& schedule,
@@ -40,6 +40,25 @@ namespace Opm {
         bool isDecreasing( ) const;
         Table::DefaultAction getDefaultMode( ) const;
         double getDefaultValue( ) const;
+
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const {
+            buffer.write( m_name );
+            buffer.write( static_cast<int>( m_order ) );
+            buffer.write( static_cast<int>( m_defaultAction ) );
+            buffer.write( m_defaultValue );
+        }
+
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer) {
+            int order, defaultAction;
+            buffer.read( m_name );
+            buffer.read( order );
+            buffer.read( defaultAction );
+            buffer.read( m_defaultValue );
+            m_order = static_cast<Table::ColumnOrderEnum>( order );
+            m_defaultAction = static_cast<Table::DefaultAction>( defaultAction );
+        }
     private:
         std::string m_name;
         Table::ColumnOrderEnum m_order;
@@ -126,6 +126,9 @@ The first row actually corresponds to saturated values.
         */
         std::vector< SimpleTable >::const_iterator begin() const;
         std::vector< SimpleTable >::const_iterator end()   const;
+
+        /* The bytes allocated by the table, not counting the table object itself. */
+        size_t memory_usage() const;
     protected:
         ColumnSchema m_outerColumnSchema;
         TableColumn m_outerColumn;
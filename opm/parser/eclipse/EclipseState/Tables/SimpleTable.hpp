@@ -63,6 +63,33 @@ namespace Opm {
         /// throws std::invalid_argument if jf != m_jfunc
         void assertJFuncPressure(const bool jf) const;
 
+        /* The bytes allocated by the columns, not counting the table object itself. */
+        size_t memory_usage() const;
+
+        /*
+          Pack the table for sending to another process; reading
+          replaces the schema and all the columns of the table.
+        */
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const {
+            m_schema.write( buffer );
+            buffer.write( static_cast<int>( m_jfunc ) );
+            for (const auto& column : m_columns)
+                column.write( buffer );
+        }
+
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer) {
+            int jfunc;
+            m_schema.read( buffer );
+            buffer.read( jfunc );
+            m_jfunc = (jfunc != 0);
+            m_columns = OrderedMap<TableColumn>();
+            addColumns();
+            for (auto& column : m_columns)
+                column.read( buffer );
+        }
+
     protected:
         TableSchema m_schema;
         OrderedMap<TableColumn> m_columns;
@@ -60,6 +60,39 @@ namespace Opm {
         std::vector<double> vectorCopy() const;
         std::vector<double>::const_iterator begin() const;
         std::vector<double>::const_iterator end() const;
+
+        /* The bytes allocated by the column, not counting the column object itself. */
+        size_t memory_usage() const;
+
+        /*
+          Only the values are packed; the schema is part of the table
+          and the column must be created from it before reading.
+        */
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const {
+            buffer.write( m_values.size() );
+            for (size_t index = 0; index < m_values.size(); index++) {
+                buffer.write( m_values[index] );
+                buffer.write( static_cast<int>( m_default[index] ) );
+            }
+        }
+
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer) {
+            size_t size = 0;
+            buffer.read( size );
+            m_values.resize( size );
+            m_default.resize( size );
+            m_defaultCount = 0;
+            for (size_t index = 0; index < size; index++) {
+                int defaulted;
+                buffer.read( m_values[index] );
+                buffer.read( defaulted );
+                m_default[index] = (defaulted != 0);
+                if (defaulted)
+                    m_defaultCount++;
+            }
+        }
     private:
         void assertUpdate(size_t index, double value) const;
         void assertPrevious(size_t index , double value) const;
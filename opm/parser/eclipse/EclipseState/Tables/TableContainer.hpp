@@ -21,8 +21,8 @@
 #define OPM_TABLE_CONTAINER_HPP
 
 #include <cstddef>
-#include <map>
 #include <memory>
+#include <vector>
 
 namespace Opm {
 
@@ -57,6 +57,11 @@ namespace Opm {
 
             container.getTable( 0 ) == container[9] == table0;
             container.gteTable(10 ) ==> exception
+
+         The table used for every table number is resolved when the
+         tables are added, so getTable() is a single indexed load; it
+         is called for every cell when the region numbers of a grid
+         are mapped to tables.
         */
     public:
         explicit TableContainer( size_t maxTables );
@@ -77,6 +82,9 @@ namespace Opm {
         const SimpleTable& getTable(size_t tableNumber) const;
         const SimpleTable& operator[](size_t tableNumber) const;
 
+        /* The tables in the container, including the table objects. */
+        size_t memory_usage() const;
+
         template <class TableType>
         const TableType& getTable(size_t tableNumber) const {
             const SimpleTable &simpleTable = getTable( tableNumber );
@@ -86,7 +94,11 @@ namespace Opm {
 
     private:
         size_t m_maxTables;
-        std::map<size_t , std::shared_ptr<const SimpleTable> > m_tables;
+        size_t m_size = 0;
+        /* The added tables, by table number; null if not added. */
+        std::vector< std::shared_ptr<const SimpleTable> > m_tables;
+        /* The table used for a table number, null before the first table. */
+        std::vector< const SimpleTable* > m_lookup;
     };
 
 }
@@ -0,0 +1,146 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_TABLE_EVALUATOR_HPP
+#define OPM_TABLE_EVALUATOR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    class PvtxTable;
+    class SimpleTable;
+    class TableContainer;
+
+    /*
+      Precomputed linear interpolation of one column of a SimpleTable
+      as a function of the first column. The evaluator gives the same
+      values as SimpleTable::evaluate(), but the column is resolved and
+      the values are copied into contiguous arrays once, up front.
+
+      The segment of the previous lookup can be passed back in as a hint;
+      when the arguments of consecutive lookups are close, as for the
+      cells of a grid or the iterations of a solver, the hint is usually
+      the right segment or a neighbour of it and the binary search is
+      skipped. The hint is kept by the caller and not by the evaluator,
+      so one evaluator can be shared between threads.
+
+      After resample(n) the function is replaced with linear
+      interpolation between n uniformly spaced samples of it, and a
+      lookup is a single multiplication. The resampled function is only
+      an approximation of the table; it is exact at the table points if
+      they happen to fall on the uniform grid.
+    */
+
+    class TableEvaluator {
+    public:
+        TableEvaluator() = default;
+        TableEvaluator(const SimpleTable& table, const std::string& column);
+        TableEvaluator(std::vector<double> xs, std::vector<double> ys);
+
+        double operator()(double x) const;
+        double operator()(double x, std::size_t& hint) const;
+
+        void evaluate(const double* x, double* y, std::size_t size) const;
+        void evaluate(const std::vector<double>& x, std::vector<double>& y) const;
+
+        void resample(std::size_t samples);
+        bool uniform() const;
+
+        std::size_t size() const;
+        const std::vector<double>& xs() const;
+        const std::vector<double>& ys() const;
+
+    private:
+        std::size_t segment(double x) const;
+        std::size_t segment(double x, std::size_t hint) const;
+        double interpolate(std::size_t segment, double x) const;
+
+        std::vector<double> m_xs;
+        std::vector<double> m_ys;
+
+        std::vector<double> m_uniform;
+        double m_xmin = 0;
+        double m_inv_dx = 0;
+    };
+
+
+    /*
+      Precomputed evaluation of one column of a PVTO or PVTG table with
+      the same interpolation as PvtxTable::evaluate(): linear in the
+      outer argument between the undersaturated tables of the two
+      neighbouring saturated rows.
+    */
+
+    class PvtxEvaluator {
+    public:
+        PvtxEvaluator(const PvtxTable& table, const std::string& column);
+
+        double operator()(double outerArg, double innerArg) const;
+        void evaluate(const double* outerArg, const double* innerArg, double* y, std::size_t size) const;
+        void evaluate(const std::vector<double>& outerArg,
+                      const std::vector<double>& innerArg,
+                      std::vector<double>& y) const;
+
+        void resample(std::size_t samples);
+
+    private:
+        double eval(double outerArg, double innerArg, std::size_t& outer_hint, std::size_t& inner_hint) const;
+
+        std::vector<double> m_outer;
+        std::vector<TableEvaluator> m_inner;
+    };
+
+
+    /*
+      Evaluation of one column of the depth tables of the equilibration
+      regions as a function of depth, e.g. RS of RSVD or PBUB of PBVD.
+      Region r, counted from one as in EQLNUM, uses table r - 1 of the
+      container, or the last table before it as for
+      TableContainer::getTable().
+
+      The batch evaluation of all the cells takes the EQLNUM value and
+      the depth of every cell, and uses the segment found for the
+      previous cell of the same region as the hint. When the cells of a
+      region come in depth order, e.g. the cells of a column, most
+      lookups are one or two comparisons.
+    */
+
+    class DepthTableEvaluator {
+    public:
+        DepthTableEvaluator(const TableContainer& tables, const std::string& column, std::size_t numRegions);
+
+        std::size_t numRegions() const;
+
+        double operator()(int region, double depth) const;
+        void evaluate(int region, const double* depth, double* values, std::size_t size) const;
+        void evaluate(const std::vector<int>& eqlnum,
+                      const std::vector<double>& depth,
+                      std::vector<double>& values) const;
+
+    private:
+        const TableEvaluator& table(int region) const;
+
+        std::vector<TableEvaluator> m_tables;
+    };
+}
+
+#endif
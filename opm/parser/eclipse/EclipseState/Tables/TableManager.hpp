@@ -21,6 +21,9 @@
 #ifndef OPM_TABLE_MANAGER_HPP
 #define OPM_TABLE_MANAGER_HPP
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <set>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -34,6 +37,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/PvtgTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/PvtoTable.hpp>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/FlatTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SorwmisTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SgcwmisTable.hpp>
@@ -56,6 +60,18 @@ namespace Opm {
     class TableManager {
     public:
         explicit TableManager( const Deck& deck );
+
+        /*
+          Lazy mode: the table keywords of the deck are only indexed by
+          table name, and the TableContainer of a table - and the PVTG
+          and PVTO tables - are built on the first access through
+          getTables(), hasTables() or the get*Tables() methods. The
+          manager shares the ownership of the deck for that purpose.
+          Different tables can be requested concurrently from several
+          threads; errors and warnings about a table keyword are
+          reported when the table is built.
+        */
+        explicit TableManager( std::shared_ptr< const Deck > deck );
         TableManager() = default;
 
         const TableContainer& getTables( const std::string& tableName ) const;
@@ -141,21 +157,35 @@ namespace Opm {
         bool useJFunc() const;
 
         double rtemp() const;
+
+        /*
+          One part for each table collection; in lazy mode only the
+          collections which have been built are counted.
+        */
+        MemoryUsage memory_usage() const;
     private:
-        TableContainer& forceGetTables( const std::string& tableName , size_t numTables);
+        using TableBuilder = std::function< void( const Deck&, TableContainer& ) >;
+        struct LazyTables;
+
+        void init(const Deck& deck);
 
-        void complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName);
+        static void complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName);
 
-        void addTables( const std::string& tableName , size_t numTables);
+        /*
+          Registers the table collection tableName; the builder fills the
+          container, at once or on first access in lazy mode.
+        */
+        void addTables( const Deck& deck, const std::string& tableName , size_t numTables,
+                        TableBuilder builder = TableBuilder());
         void initSimpleTables(const Deck& deck);
         void initRTempTables(const Deck& deck);
         void initDims(const Deck& deck);
-        void initRocktabTables(const Deck& deck);
-        void initGasvisctTables(const Deck& deck);
+        static void initRocktabTables(const Deck& deck, TableContainer& container);
+        static void initGasvisctTables(const Deck& deck, TableContainer& container);
 
-        void initPlymaxTables(const Deck& deck);
-        void initPlyrockTables(const Deck& deck);
-        void initPlyshlogTables(const Deck& deck);
+        static void initPlymaxTables(const Deck& deck, TableContainer& container);
+        static void initPlyrockTables(const Deck& deck, TableContainer& container);
+        static void initPlyshlogTables(const Deck& deck, TableContainer& container);
 
         void initPlymwinjTables(const Deck& deck);
         void initSkprwatTables(const Deck& deck);
@@ -168,25 +198,24 @@ namespace Opm {
          * JFUNC
          */
         template <class TableType>
-        void initSimpleTableContainerWithJFunc(const Deck& deck,
+        static void initSimpleTableContainerWithJFunc(const Deck& deck,
                                       const std::string& keywordName,
-                                      const std::string& tableName,
-                                      size_t numTables) {
-            if (!deck.hasKeyword(keywordName))
+                                      TableContainer& container,
+                                      bool useJFunc) {
+            const auto keywords = deck.getKeywordRange(keywordName);
+            if (keywords.empty())
                 return; // the table is not featured by the deck...
 
-            auto& container = forceGetTables(tableName , numTables);
-
-            if (deck.count(keywordName) > 1) {
+            if (keywords.size() > 1) {
                 complainAboutAmbiguousKeyword(deck, keywordName);
                 return;
             }
 
-            const auto& tableKeyword = deck.getKeyword(keywordName);
+            const auto& tableKeyword = keywords.front();
             for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
                 const auto& dataItem = tableKeyword.getRecord( tableIdx ).getItem( 0 );
                 if (dataItem.size() > 0) {
-                    std::shared_ptr<TableType> table = std::make_shared<TableType>( dataItem, useJFunc() );
+                    std::shared_ptr<TableType> table = std::make_shared<TableType>( dataItem, useJFunc );
                     container.addTable( tableIdx , table );
                 }
             }
@@ -195,21 +224,19 @@ namespace Opm {
 
 
         template <class TableType>
-        void initSimpleTableContainer(const Deck& deck,
+        static void initSimpleTableContainer(const Deck& deck,
                                       const std::string& keywordName,
-                                      const std::string& tableName,
-                                      size_t numTables) {
-            if (!deck.hasKeyword(keywordName))
+                                      TableContainer& container) {
+            const auto keywords = deck.getKeywordRange(keywordName);
+            if (keywords.empty())
                 return; // the table is not featured by the deck...
 
-            auto& container = forceGetTables(tableName , numTables);
-
-            if (deck.count(keywordName) > 1) {
+            if (keywords.size() > 1) {
                 complainAboutAmbiguousKeyword(deck, keywordName);
                 return;
             }
 
-            const auto& tableKeyword = deck.getKeyword(keywordName);
+            const auto& tableKeyword = keywords.front();
             for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
                 const auto& dataItem = tableKeyword.getRecord( tableIdx ).getItem( 0 );
                 if (dataItem.size() > 0) {
@@ -219,19 +246,35 @@ namespace Opm {
             }
         }
 
+        /*
+          Registers the table collection tableName, filled from the
+          keyword keywordName.
+        */
         template <class TableType>
-        void initSimpleTableContainer(const Deck& deck,
-                                      const std::string& keywordName,
-                                      size_t numTables) {
-            initSimpleTableContainer<TableType>(deck , keywordName , keywordName , numTables);
+        void addSimpleTables(const Deck& deck,
+                             const std::string& keywordName,
+                             const std::string& tableName,
+                             size_t numTables) {
+            addTables( deck, tableName, numTables, [keywordName]( const Deck& tableDeck, TableContainer& container ) {
+                initSimpleTableContainer<TableType>( tableDeck, keywordName, container );
+            });
         }
 
+        template <class TableType>
+        void addSimpleTables(const Deck& deck,
+                             const std::string& keywordName,
+                             size_t numTables) {
+            addSimpleTables<TableType>( deck, keywordName, keywordName, numTables );
+        }
 
         template <class TableType>
-        void initSimpleTableContainerWithJFunc(const Deck& deck,
+        void addSimpleTablesWithJFunc(const Deck& deck,
                                       const std::string& keywordName,
                                       size_t numTables) {
-            initSimpleTableContainerWithJFunc<TableType>(deck , keywordName , keywordName , numTables);
+            const bool jfunc = useJFunc();
+            addTables( deck, keywordName, numTables, [keywordName, jfunc]( const Deck& tableDeck, TableContainer& container ) {
+                initSimpleTableContainerWithJFunc<TableType>( tableDeck, keywordName, container, jfunc );
+            });
         }
 
 
@@ -240,15 +283,16 @@ namespace Opm {
         void initSimpleTable(const Deck& deck,
                               const std::string& keywordName,
                               std::vector<TableType>& tableVector) {
-            if (!deck.hasKeyword(keywordName))
+            const auto keywords = deck.getKeywordRange(keywordName);
+            if (keywords.empty())
                 return; // the table is not featured by the deck...
 
-            if (deck.count(keywordName) > 1) {
+            if (keywords.size() > 1) {
                 complainAboutAmbiguousKeyword(deck, keywordName);
                 return;
             }
 
-            const auto& tableKeyword = deck.getKeyword(keywordName);
+            const auto& tableKeyword = keywords.front();
             for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
                 const auto& dataItem = tableKeyword.getRecord( tableIdx ).getItem( 0 );
                 if (dataItem.size() == 0) {
@@ -270,18 +314,19 @@ namespace Opm {
 
 
         template <class TableType>
-        void initFullTables(const Deck& deck,
+        static void initFullTables(const Deck& deck,
                             const std::string& keywordName,
                             std::vector<TableType>& tableVector) {
-            if (!deck.hasKeyword(keywordName))
+            const auto keywords = deck.getKeywordRange(keywordName);
+            if (keywords.empty())
                 return; // the table is not featured by the deck...
 
-            if (deck.count(keywordName) > 1) {
+            if (keywords.size() > 1) {
                 complainAboutAmbiguousKeyword(deck, keywordName);
                 return;
             }
 
-            const auto& tableKeyword = deck.getKeyword(keywordName);
+            const auto& tableKeyword = keywords.front();
 
             int numTables = TableType::numTables( tableKeyword );
             for (int tableIdx = 0; tableIdx < numTables; ++tableIdx)
@@ -310,6 +355,7 @@ namespace Opm {
         const bool hasEnptvd = false;// if deck has keyword ENPTVD
         const bool hasEqlnum = false;// if deck has keyword EQLNUM
         std::shared_ptr<JFunc> jfunc;
+        std::shared_ptr<LazyTables> m_lazyTables;
 
         double m_rtemp;
     };
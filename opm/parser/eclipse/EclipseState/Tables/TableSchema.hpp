@@ -37,6 +37,25 @@ namespace Opm {
 
         /* Number of columns */
         size_t size() const;
+
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const {
+            buffer.write( m_columns.size() );
+            for (const auto& column : m_columns)
+                column.write( buffer );
+        }
+
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer) {
+            size_t columns = 0;
+            buffer.read( columns );
+            m_columns = OrderedMap<ColumnSchema>();
+            for (size_t index = 0; index < columns; index++) {
+                ColumnSchema column( "", Table::RANDOM, Table::DEFAULT_NONE );
+                column.read( buffer );
+                addColumn( column );
+            }
+        }
     private:
         OrderedMap<ColumnSchema> m_columns;
     };
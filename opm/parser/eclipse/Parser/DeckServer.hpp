@@ -0,0 +1,122 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_DECK_SERVER_HPP
+#define OPM_DECK_SERVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+namespace Opm {
+
+    class Deck;
+    class EclipseState;
+
+/*
+  Keeps one configured Parser and the recently parsed decks, with their
+  EclipseState once it has been requested, for a long running process
+  which loads the same decks repeatedly, e.g. an interactive QC tool or
+  the opmd daemon. A request for a deck whose input files are all
+  unchanged - same size and modification time as when it was parsed -
+  returns the deck from memory; otherwise the deck is parsed again,
+  with the deck and include caches enabled so that the unchanged
+  include files are not parsed again.
+
+  The decks are evicted least recently used first when the estimated
+  memory of the decks and states held, see MemoryUsage, exceeds the
+  budget; the returned pointers keep an evicted deck alive for as long
+  as the caller holds them. A deck without a complete list of input
+  files, see Deck::getInputFiles(), is not held.
+
+  The server can be used from several threads; different decks are
+  parsed concurrently, see the thread safety of Parser.
+
+     DeckServer server( 2UL << 30 );
+     auto deck = server.deck( "CASE.DATA" );
+     auto state = server.eclipseState( "CASE.DATA" );
+*/
+
+class DeckServer {
+public:
+    struct Statistics {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+        std::size_t decks = 0;
+        std::size_t bytes = 0;
+    };
+
+    explicit DeckServer(std::size_t memoryBudget,
+                        const ParseContext& parseContext = ParseContext());
+
+    std::shared_ptr< const Deck > deck(const std::string& dataFile);
+    std::shared_ptr< const EclipseState > eclipseState(const std::string& dataFile);
+
+    Statistics statistics() const;
+    void clear();
+
+    const Parser& parser() const;
+
+private:
+    struct Signature {
+        std::string path;
+        std::uint64_t size;
+        std::int64_t mtime;
+    };
+
+    struct Entry {
+        std::string dataFile;
+        std::vector< Signature > inputs;
+        std::shared_ptr< const Deck > deck;
+        std::shared_ptr< const EclipseState > state;
+        std::size_t bytes = 0;
+    };
+
+    using EntryList = std::list< Entry >;
+
+    static bool current(const std::vector< Signature >& inputs);
+    static bool signature(const std::string& path, Signature& sig);
+
+    std::shared_ptr< const Deck > lookup(const std::string& dataFile,
+                                         std::shared_ptr< const EclipseState >* state);
+    std::shared_ptr< const Deck > parse(const std::string& key, const std::string& dataFile);
+    void insert(Entry&& entry);
+    void evict();
+
+    Parser m_parser;
+    ParseContext m_parseContext;
+    std::size_t m_budget;
+
+    mutable std::mutex m_mutex;
+    EntryList m_entries;
+    std::unordered_map< std::string, EntryList::iterator > m_index;
+    Statistics m_statistics;
+};
+
+} // namespace Opm
+
+#endif
@@ -0,0 +1,54 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_DECK_VISITOR_HPP
+#define OPM_DECK_VISITOR_HPP
+
+#include <string>
+
+namespace Opm {
+
+    class DeckKeyword;
+
+    /*
+      Callbacks for Parser::visitFile(). select() is called for every
+      keyword in the input, in input order, with the name of the section
+      it is in; the section is empty before the first section keyword.
+      The keywords selected with Action::Parse are parsed and passed to
+      visit(), the others are skipped. Parsing ends at the end of the
+      input, or when select() returns Action::Stop or visit() returns
+      false.
+    */
+
+    class DeckVisitor {
+    public:
+        enum class Action {
+            Parse,
+            Skip,
+            Stop
+        };
+
+        virtual ~DeckVisitor() = default;
+
+        virtual Action select(const std::string& keyword, const std::string& section) = 0;
+        virtual bool visit(const DeckKeyword& keyword, const std::string& section) = 0;
+    };
+}
+
+#endif
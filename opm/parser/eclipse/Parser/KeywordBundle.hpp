@@ -0,0 +1,74 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYWORD_BUNDLE_HPP
+#define KEYWORD_BUNDLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    class ParserKeyword;
+
+    /*
+     * Binary bundle of parser keyword definitions, compiled from directories
+     * of JSON keyword files. Loading a bundle constructs the ParserKeyword
+     * objects straight from the file, without any JSON parsing, which makes
+     * large sets of runtime loaded keywords cheap to add to a Parser.
+     *
+     * The bundle stores a format version which follows the layout of the
+     * ParserKeyword, ParserRecord and ParserItem classes; a bundle written
+     * by another version of the parser is rejected and must be compiled
+     * again.
+     */
+    class KeywordBundle {
+    public:
+        static const std::uint32_t version;
+
+        /*
+         * Write the keywords to the bundle file. Throws std::runtime_error
+         * if the file can not be written.
+         */
+        static void save( const std::string& bundleFile,
+                          const std::vector< const ParserKeyword* >& keywords );
+
+        /*
+         * Compile all the JSON keyword files in the directory, in the same
+         * way as Parser::loadKeywordsFromDirectory(), into the bundle file.
+         * Throws std::invalid_argument if the directory does not exist or
+         * a keyword file is invalid.
+         */
+        static void compile( const std::string& directory,
+                             const std::string& bundleFile,
+                             bool recursive = true );
+
+        /*
+         * The keywords of the bundle file, in the order they were saved.
+         * Throws std::invalid_argument if the file can not be read, is not
+         * a keyword bundle or has another version.
+         */
+        static std::vector< std::unique_ptr< ParserKeyword > >
+        load( const std::string& bundleFile );
+    };
+}
+
+#endif
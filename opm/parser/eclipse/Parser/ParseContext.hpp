@@ -86,6 +86,13 @@ namespace Opm {
         explicit ParseContext(const std::vector<std::pair<std::string , InputError::Action>>& initial);
 
         void handleError( const std::string& errorKey, const std::string& msg ) const;
+
+        /*
+          Whether the action for @errorKey is InputError::IGNORE. This is a
+          cheap check which callers can use to avoid assembling an error
+          message which handleError() would throw away anyway.
+        */
+        bool isIgnored( const std::string& errorKey ) const;
         void handleUnknownKeyword(const std::string& keyword) const;
         bool hasKey(const std::string& key) const;
         ParseContext  withKey(const std::string& key, InputError::Action action = InputError::WARN) const;
@@ -304,8 +311,17 @@ namespace Opm {
         void initEnv();
         void envUpdate( const std::string& envVariable , InputError::Action action );
         void patternUpdate( const std::string& pattern , InputError::Action action);
+        InputError::Action action( const std::string& key ) const;
 
         std::map<std::string , InputError::Action> m_errorContexts;
+
+        /*
+          The actions of the keys added by initDefault(), in the order they
+          are added there. The error situations are checked with the static
+          key strings of this class, and those are recognized by address,
+          so handleError() and isIgnored() avoid the map lookup.
+        */
+        std::vector<InputError::Action> m_defaultActions;
         std::set<std::string> ignore_keywords;
     };
 }
@@ -0,0 +1,114 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PARSE_PROFILE_HPP
+#define OPM_PARSE_PROFILE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Where the time of the input processing goes, per keyword and per
+  input file. For every keyword the parser records the bytes and
+  tokens of its records, the time spent tokenizing it into a raw
+  keyword and the time spent in ParserKeyword::parse(); the parts of
+  the EclipseState construction which handle keywords one by one, the
+  grid property sections and the SCHEDULE section, add the time spent
+  on every keyword. For every input file, the data file and the
+  INCLUDE files, the size of the file and the totals of its keywords
+  are recorded.
+
+  The profile is disabled by default, and costs a single atomic load
+  per keyword then. Keywords tokenized ahead on the include threads,
+  see Parser::setIncludeThreads(), have no tokenize time.
+
+     ParseProfile::enable();
+     auto deck = parser.parseFile(filename, parseContext);
+     EclipseState es(deck, parseContext);
+     ParseProfile::log();
+*/
+
+class ParseProfile {
+public:
+    struct Entry {
+        std::string name;
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        std::size_t records = 0;
+        std::size_t items = 0;
+        double tokenize = 0;
+        double parse = 0;
+        double consume = 0;
+
+        double total() const;
+    };
+
+    /*
+      The keywords and the files, ordered with the largest total time
+      first; the count of a file is the number of keywords read from it.
+    */
+    struct Report {
+        std::vector<Entry> keywords;
+        std::vector<Entry> files;
+    };
+
+    /* Times the handling of a keyword while alive. */
+    class Consume {
+    public:
+        explicit Consume(const std::string& keyword);
+        ~Consume();
+
+        Consume(const Consume&) = delete;
+        Consume& operator=(const Consume&) = delete;
+    private:
+        const std::string* keyword;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static void enable(bool on = true);
+    static bool enabled();
+    static void reset();
+
+    static void addKeyword(const std::string& keyword,
+                           const std::string& file,
+                           std::size_t bytes,
+                           std::size_t records,
+                           std::size_t items,
+                           double tokenize,
+                           double parse);
+    static void addFile(const std::string& file, std::size_t bytes);
+    static void addConsume(const std::string& keyword, double seconds);
+
+    static Report report();
+
+    /* At most max_rows keywords and files; zero writes all. */
+    static void writeTable(std::ostream& os, std::size_t max_rows = 0);
+    static void writeJSON(std::ostream& os);
+
+    /* Writes the table as an OpmLog note. */
+    static void log(std::size_t max_rows = 25);
+};
+
+} // namespace Opm
+
+#endif
@@ -20,10 +20,13 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <boost/filesystem.hpp>
 
@@ -38,12 +41,24 @@ namespace Json {
 namespace Opm {
 
     class Deck;
+    class DeckVisitor;
     class ParseContext;
     class RawKeyword;
 
     /// The hub of the parsing process.
     /// An input file in the eclipse data format is specified, several steps of parsing is performed
     /// and the semantically parsed result is returned.
+    ///
+    /// Thread safety: once configured, a Parser can be shared by any number
+    /// of threads which call the const methods concurrently, e.g. parseFile()
+    /// of different decks on one const Parser. The keyword tables and the
+    /// wildcard regular expressions are only read while parsing, and all
+    /// the state of a parse lives in the parse itself. The configuring
+    /// methods - adding keywords and the set*() options - must not run
+    /// concurrently with anything else on the same Parser. Concurrent parses
+    /// of the same DATA file with the deck or include cache enabled are
+    /// safe, as the cache files are replaced atomically. The messages of
+    /// concurrent parses are interleaved in the OpmLog.
 
     class Parser {
     public:
@@ -58,6 +73,94 @@ namespace Opm {
                          const ParseContext& = ParseContext()) const;
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext) const;
 
+        /*!
+         * \brief Parse the input keyword by keyword into a DeckVisitor, without
+         * building a Deck.
+         *
+         * The visitor selects the keywords to parse; the records of the other
+         * keywords are only located in the input, not tokenized. INCLUDE, PATHS
+         * and END are handled as in parseFile(), and the visited keywords have
+         * the units of the deck applied.
+         */
+        void visitFile(const std::string& dataFile,
+                       DeckVisitor& visitor,
+                       const ParseContext& = ParseContext()) const;
+        void visitString(const std::string& data,
+                         DeckVisitor& visitor,
+                         const ParseContext& = ParseContext()) const;
+
+        /*!
+         * \brief Parse only the given sections of the deck, e.g. { "SCHEDULE" }.
+         *
+         * The input of the other sections is skipped line by line, without
+         * tokenizing, except for the keywords the selected sections depend
+         * on: the keywords which size other keywords, the unit system and
+         * PATHS. The INCLUDE files of the skipped sections are not read at
+         * all when a SectionIndex of the deck shows that they have none of
+         * these keywords. The section keywords are all in the deck. The
+         * deck and include caches and the include threads are not used.
+         */
+        Deck parseSections(const std::string& dataFile,
+                           const std::set< std::string >& sections,
+                           const ParseContext& = ParseContext()) const;
+
+        /*!
+         * \brief Load and tokenize the files INCLUDEd from the DATA file on
+         * worker threads in parseFile().
+         *
+         * The keywords are still added to the deck in input order, and errors
+         * are reported through the ParseContext as usual. Include files which
+         * need context from the deck, like keywords sized by another keyword,
+         * are only read ahead and then parsed normally. The default of zero
+         * threads disables the feature.
+         */
+        void setIncludeThreads(size_t numThreads);
+
+        /*!
+         * \brief Bound the memory of the include files read ahead with
+         * setIncludeThreads().
+         *
+         * The worker threads hold back further reads while the files they
+         * have loaded, and the main parse has not yet reached, add up to more
+         * than this many bytes. The default of zero leaves it unbounded.
+         */
+        void setIncludeReadAhead(size_t bytes);
+
+        /*!
+         * \brief Keep a binary cache of the decks parsed with parseFile().
+         *
+         * The cache is stored next to the DATA file, and a later parseFile()
+         * of the same DATA file loads the deck from it instead of parsing, as
+         * long as none of the input files have changed and the keywords and
+         * ParseContext are the same. Note that the warnings issued while
+         * parsing are not repeated when the deck is loaded from the cache.
+         */
+        void setDeckCache(bool enable);
+
+        /*!
+         * \brief Keep a binary cache of the keywords of every INCLUDE file.
+         *
+         * Unlike the deck cache, which is only used when none of the input
+         * files have changed, the include cache is per file: the unchanged
+         * include files of an edited deck are loaded from the cache, and
+         * only the edited ones are parsed. Only include files which parse
+         * the same in any deck are cached, i.e. files without nested
+         * includes, PATHS aliases, unknown keywords or keywords which get
+         * their size from another keyword. The cache is stored in a
+         * directory next to the DATA file, see DeckCache.
+         */
+        void setIncludeCache(bool enable);
+
+        /*!
+         * \brief Convert the large items to SI units at the end of parseFile().
+         *
+         * The double items with at least minSize values are converted when
+         * the deck has been parsed, instead of on the first
+         * getSIDoubleData() of each item. The default of zero leaves the
+         * conversion to the first use.
+         */
+        void setSIConversion(size_t minSize);
+
         /// Method to add ParserKeyword instances, these holding type and size information about the keywords and their data.
         void addParserKeyword(const Json::JsonObject& jsonKeyword);
         void addParserKeyword(std::unique_ptr< const ParserKeyword >&& parserKeyword);
@@ -76,6 +179,14 @@ namespace Opm {
         bool loadKeywordFromFile(const boost::filesystem::path& configFile);
 
         void loadKeywordsFromDirectory(const boost::filesystem::path& directory , bool recursive = true);
+
+        /*!
+         * \brief Adds the keywords of a bundle compiled with KeywordBundle::compile()
+         *
+         * Equivalent to loading the JSON keyword directories the bundle was
+         * compiled from, without parsing any JSON.
+         */
+        void loadKeywordBundle(const boost::filesystem::path& bundleFile);
         void applyUnitsToDeck(Deck& deck) const;
 
         /*!
@@ -115,16 +226,26 @@ namespace Opm {
     private:
         // associative map of the parser internal name and the corresponding ParserKeyword object
         std::vector< std::unique_ptr< const ParserKeyword > > keyword_storage;
-        // associative map of deck names and the corresponding ParserKeyword object
-        std::map< string_view, const ParserKeyword* > m_deckParserKeywords;
+        // hash map of deck names and the corresponding ParserKeyword object
+        std::unordered_map< string_view, const ParserKeyword* > m_deckParserKeywords;
         // associative map of the parser internal names and the corresponding
         // ParserKeyword object for keywords which match a regular expression
         std::map< string_view, const ParserKeyword* > m_wildCardKeywords;
+        // the immutable default keywords, shared by all parsers in the process
+        std::shared_ptr< const Parser > m_defaultKeywords;
+        size_t m_includeThreads = 0;
+        size_t m_includeReadAhead = 0;
+        bool m_deckCache = false;
+        bool m_includeCache = false;
+        size_t m_siConversionSize = 0;
 
         bool hasWildCardKeyword(const std::string& keyword) const;
         const ParserKeyword* matchingKeyword(const string_view& keyword) const;
 
         void addDefaultKeywords();
+        std::set< std::string > sizeKeywords() const;
+        std::uint64_t deckCacheKey( const ParseContext& context ) const;
+        static std::shared_ptr< const Parser > defaultKeywords();
     };
 
 } // namespace Opm
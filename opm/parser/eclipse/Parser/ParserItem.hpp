@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Utility/Symbol.hpp>
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Json {
@@ -56,6 +57,7 @@ namespace Opm {
         bool hasDimension() const;
         size_t numDimensions() const;
         const std::string& name() const;
+        Symbol symbol() const;
         item_size sizeType() const;
         std::string getDescription() const;
         bool scalar() const;
@@ -80,13 +82,15 @@ namespace Opm {
                                     const std::string* defaultValue = nullptr ) const;
 
     private:
+        friend struct KeywordBundleIO;
+
         double dval;
         int ival;
         std::string sval;
         bool raw_string = false;
         std::vector< std::string > dimensions;
 
-        std::string m_name;
+        Symbol m_name;
         item_size m_sizeType;
         std::string m_description;
 
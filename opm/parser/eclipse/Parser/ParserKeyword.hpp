@@ -19,6 +19,7 @@
 #ifndef PARSER_KEYWORD_H
 #define PARSER_KEYWORD_H
 
+#include <bitset>
 #include <iosfwd>
 #include <string>
 #include <memory>
@@ -136,12 +137,16 @@ namespace Opm {
         bool operator!=( const ParserKeyword& ) const;
 
     private:
+        friend struct KeywordBundleIO;
+
         KeywordSize keyword_size;
         std::string m_name;
         DeckNameSet m_deckNames;
         DeckNameSet m_validSectionNames;
         std::string m_matchRegexString;
         boost::regex m_matchRegex;
+        // the (ASCII) characters a name matched by m_matchRegex can start with
+        std::bitset< 128 > m_matchRegexStart;
         std::vector< ParserRecord > m_records;
         enum ParserKeywordSizeEnum m_keywordSizeType;
         size_t m_fixedSize;
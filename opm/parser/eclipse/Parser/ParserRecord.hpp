@@ -25,6 +25,7 @@
 #include <memory>
 
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
+#include <opm/parser/eclipse/Units/Dimension.hpp>
 
 namespace Opm {
 
@@ -48,6 +49,21 @@ namespace Opm {
         bool hasDimension() const;
         bool hasItem(const std::string& itemName) const;
         void applyUnitsToDeck( Deck& deck, DeckRecord& deckRecord) const;
+
+        /*
+          applyUnitsToDeck() in two steps: the dimensions of the items
+          are looked up by name in the unit systems of the deck once,
+          and can then be applied to all the records of a keyword which
+          are parsed by this ParserRecord.
+        */
+        struct ItemUnits {
+            size_t item;
+            Dimension active;
+            Dimension fallback;
+        };
+
+        std::vector< ItemUnits > resolveUnits( Deck& deck ) const;
+        void applyUnits( const std::vector< ItemUnits >& units, DeckRecord& deckRecord ) const;
         std::vector< ParserItem >::const_iterator begin() const;
         std::vector< ParserItem >::const_iterator end() const;
 
@@ -55,6 +71,8 @@ namespace Opm {
         bool operator!=( const ParserRecord& ) const;
 
     private:
+        friend struct KeywordBundleIO;
+
         bool m_dataRecord;
         std::vector< ParserItem > m_items;
     };
@@ -0,0 +1,88 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_SECTION_INDEX_HPP
+#define OPM_SECTION_INDEX_HPP
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*
+  The location of the section keywords - RUNSPEC, GRID, EDIT, PROPS,
+  REGIONS, SOLUTION, SUMMARY and SCHEDULE - of a deck, found by a quick
+  scan of the DATA file and the files it INCLUDEs, without tokenizing
+  or parsing any keyword. The scan only looks at the lines which hold
+  nothing but a keyword name; PATHS aliases, ENDINC and END are honored
+  as in Parser::parseFile(). Gzipped and missing include files are not
+  scanned.
+
+     SectionIndex index( "CASE.DATA" );
+     for (const auto& entry : index.find( "SCHEDULE" ))
+         std::cout << entry.file << ":" << entry.line << std::endl;
+
+  The index also keeps the names of the keywords found in every file,
+  with the files it includes, which Parser::parseSections() uses to
+  decide which include files of the skipped sections can be left
+  unread.
+*/
+
+class SectionIndex {
+public:
+    struct Entry {
+        std::string section;
+        /* The canonical path of the file, and the byte offset and line
+           number, starting at one, of the section keyword in it. */
+        std::string file;
+        std::size_t offset;
+        std::size_t line;
+    };
+
+    explicit SectionIndex(const std::string& dataFile);
+
+    /* All the section keywords, in input order. */
+    const std::vector< Entry >& entries() const;
+    std::vector< Entry > find(const std::string& section) const;
+
+    /* The canonical paths of the scanned files, in input order. */
+    const std::vector< std::string >& files() const;
+
+    /*
+      Whether the file, or a file it includes, has one of the keywords;
+      true for a file which has not been scanned.
+    */
+    bool contains(const std::string& file, const std::set< std::string >& keywords) const;
+
+private:
+    void scan(const std::string& file, std::set< std::string >& active);
+
+    std::string m_rootPath;
+    std::map< std::string, std::string > m_pathMap;
+    std::vector< Entry > m_entries;
+    std::vector< std::string > m_files;
+    std::map< std::string, std::set< std::string > > m_keywords;
+    bool m_end = false;
+};
+
+} // namespace Opm
+
+#endif
@@ -23,7 +23,6 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <list>
 
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
@@ -43,6 +42,10 @@ namespace Opm {
         RawKeyword(const string_view& name , Raw::KeywordSizeEnum sizeType , const std::string& filename, size_t lineNR);
         RawKeyword(const string_view& name , const std::string& filename, size_t lineNR , size_t inputSize , bool isTableCollection = false);
 
+        // The records refer to the name and filename of the keyword.
+        RawKeyword(const RawKeyword&) = delete;
+        RawKeyword& operator=(const RawKeyword&) = delete;
+
         const std::string& getKeywordName() const;
         void addRawRecordString( const string_view& );
         size_t size() const;
@@ -63,8 +66,8 @@ namespace Opm {
         const std::string& getFilename() const;
         size_t getLineNR() const;
 
-        using const_iterator = std::list< RawRecord >::const_iterator;
-        using iterator = std::list< RawRecord >::iterator;
+        using const_iterator = std::vector< RawRecord >::const_iterator;
+        using iterator = std::vector< RawRecord >::iterator;
 
         const_iterator begin() const;
         const_iterator end() const;
@@ -80,7 +83,11 @@ namespace Opm {
         size_t m_numTables;
         size_t m_currentNumTables = 0;
         std::string m_name;
-        std::list< RawRecord > m_records;
+        /*
+         * The records of a keyword are kept in one block, which is released
+         * with the keyword as soon as it has been parsed into a DeckKeyword.
+         */
+        std::vector< RawRecord > m_records;
         string_view m_partialRecordString;
 
         size_t m_lineNR;
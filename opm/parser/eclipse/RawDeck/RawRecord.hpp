@@ -20,10 +20,9 @@
 #ifndef RECORD_HPP
 #define RECORD_HPP
 
-#include <deque>
 #include <memory>
 #include <string>
-#include <list>
+#include <vector>
 
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
@@ -35,7 +34,8 @@ namespace Opm {
 
     class RawRecord {
     public:
-        RawRecord( const string_view&, const std::string& fileName = "", const std::string& keywordName = "");
+        RawRecord( const string_view& );
+        RawRecord( const string_view&, const std::string& fileName, const std::string& keywordName );
 
         inline string_view pop_front();
         void push_front( string_view token );
@@ -43,6 +43,16 @@ namespace Opm {
         inline size_t size() const;
 
         std::string getRecordString() const;
+
+        /*
+         * Direct access to the untokenized record string, for scanners which
+         * can consume the whole record in a single pass (bulk numeric data).
+         * Only meaningful while untouched() holds; after consuming the data
+         * the caller discards the remaining tokens with clear().
+         */
+        inline string_view getRecordView() const;
+        inline bool untouched() const;
+        void clear();
         inline string_view getItem(size_t index) const;
         const std::string& getFileName() const;
         const std::string& getKeywordName() const;
@@ -53,10 +63,24 @@ namespace Opm {
 
     private:
         string_view m_sanitizedRecordString;
-        std::deque< string_view > m_recordItems;
-        const std::string m_fileName;
-        const std::string m_keywordName;
-
+        /*
+         * The record is split into tokens on first access, so that bulk data
+         * records which are scanned straight from the record string never pay
+         * for building the token vector. Consumed tokens are not erased, the
+         * front of the record is the m_front'th token.
+         */
+        mutable std::vector< string_view > m_recordItems;
+        mutable size_t m_front = 0;
+        mutable bool m_tokenized = false;
+        /*
+         * The file and keyword names are owned by the RawKeyword, which
+         * outlives its records; a record only refers to them.
+         */
+        const std::string* m_fileName;
+        const std::string* m_keywordName;
+
+        inline void tokenize() const;
+        void splitRecordString() const;
         void setRecordString(const std::string& singleRecordString);
     };
 
@@ -64,18 +88,31 @@ namespace Opm {
      * These are frequently called, but fairly trivial in implementation, and
      * inlining the calls gives a decent low-effort performance benefit.
      */
+    void RawRecord::tokenize() const {
+        if( !this->m_tokenized ) this->splitRecordString();
+    }
+
     string_view RawRecord::pop_front() {
-        auto front = m_recordItems.front();
-        this->m_recordItems.pop_front();
-        return front;
+        this->tokenize();
+        return this->m_recordItems.at( this->m_front++ );
     }
 
     size_t RawRecord::size() const {
-        return m_recordItems.size();
+        this->tokenize();
+        return m_recordItems.size() - this->m_front;
     }
 
     string_view RawRecord::getItem(size_t index) const {
-        return this->m_recordItems.at( index );
+        this->tokenize();
+        return this->m_recordItems.at( this->m_front + index );
+    }
+
+    string_view RawRecord::getRecordView() const {
+        return this->m_sanitizedRecordString;
+    }
+
+    bool RawRecord::untouched() const {
+        return !this->m_tokenized;
     }
 }
 
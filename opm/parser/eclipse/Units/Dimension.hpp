@@ -20,8 +20,11 @@
 #ifndef DIMENSION_H
 #define DIMENSION_H
 
+#include <cstddef>
 #include <string>
 
+#include <opm/parser/eclipse/Utility/Symbol.hpp>
+
 namespace Opm {
 
     class Dimension {
@@ -35,16 +38,27 @@ namespace Opm {
         double convertRawToSi(double rawValue) const;
         double convertSiToRaw(double siValue) const;
 
+        // convert size values; the input and output may be the same array
+        void convertRawToSi(const double* rawValues, double* siValues, std::size_t size) const;
+        void convertSiToRaw(const double* siValues, double* rawValues, std::size_t size) const;
+
         bool equal(const Dimension& other) const;
         const std::string& getName() const;
         bool isCompositable() const;
+        // true if converting to SI leaves the value unchanged
+        bool isIdentity() const;
+        // false for the context dependent units, which convert by hand
+        bool isConvertible() const;
         static Dimension newComposite(const std::string& dim, double SIfactor, double SIoffset = 0.0);
 
         bool operator==( const Dimension& ) const;
         bool operator!=( const Dimension& ) const;
 
     private:
-        std::string m_name;
+        friend struct DeckCacheIO;
+
+        /* Every double item of the deck has a copy of its dimension. */
+        Symbol m_name;
         double m_SIfactor;
         double m_SIoffset;
     };
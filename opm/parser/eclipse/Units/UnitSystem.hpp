@@ -20,6 +20,7 @@
 #ifndef UNITSYSTEM_H
 #define UNITSYSTEM_H
 
+#include <cstddef>
 #include <string>
 #include <map>
 #include <vector>
@@ -97,6 +98,12 @@ namespace Opm {
         double to_si( measure, double ) const;
         void from_si( measure, std::vector<double>& ) const;
         void to_si( measure, std::vector<double>& ) const;
+        /* Convert size values; the input and output may be the same array. */
+        void from_si( measure, const double* input, double* output, std::size_t size ) const;
+        void to_si( measure, const double* input, double* output, std::size_t size ) const;
+        /* The factor f and offset o of from_si( m, v ) = f * (v - o). */
+        double from_si_factor( measure ) const;
+        double to_si_offset( measure ) const;
         const char* name( measure ) const;
 
         static ert_ecl_unit_enum ecl_units(UnitType opm_unit);
@@ -0,0 +1,91 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPM_FINGERPRINT_HPP
+#define OPM_FINGERPRINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      A 128 bit content fingerprint, built incrementally by adding values
+      in order; two fingerprints built from the same sequence of values
+      are equal, and with overwhelming probability only then. The values
+      are mixed as 64 bit words and strings byte by byte in a fixed order,
+      so the fingerprint does not depend on the platform or the process
+      and can be stored, e.g. in a cache file.
+
+      Doubles are added by their bit pattern, with -0.0 added as 0.0 and
+      all NaNs as the same NaN. A fingerprint added to another adds its
+      value, which is how the fingerprints of the parts of an object are
+      combined into the fingerprint of the whole.
+
+      The mixing is that of MurmurHash3; the fingerprint is meant for
+      change detection, not as protection against deliberate collisions.
+    */
+
+    class Fingerprint {
+    public:
+        Fingerprint() = default;
+
+        template< typename T >
+        typename std::enable_if< std::is_integral< T >::value || std::is_enum< T >::value, Fingerprint& >::type
+        add( T value ) {
+            this->mix( static_cast< std::uint64_t >( value ) );
+            return *this;
+        }
+
+        Fingerprint& add( double value );
+        Fingerprint& add( const char* data, std::size_t size );
+        Fingerprint& add( const std::string& value );
+        Fingerprint& add( const Fingerprint& other );
+
+        template< typename T >
+        Fingerprint& add( const std::vector< T >& values ) {
+            this->add( values.size() );
+            for( const auto& value : values )
+                this->add( value );
+            return *this;
+        }
+
+        std::uint64_t high() const;
+        std::uint64_t low() const;
+
+        /* The 32 hexadecimal digits of the value, high word first. */
+        std::string hex() const;
+
+        bool operator==( const Fingerprint& rhs ) const;
+        bool operator!=( const Fingerprint& rhs ) const;
+        bool operator<( const Fingerprint& rhs ) const;
+
+    private:
+        void mix( std::uint64_t word );
+        void finish( std::uint64_t& h1, std::uint64_t& h2 ) const;
+
+        std::uint64_t m_h1 = 0;
+        std::uint64_t m_h2 = 0;
+        std::uint64_t m_words = 0;
+    };
+}
+
+#endif
@@ -21,7 +21,10 @@
 #define OPM_UTILITY_SUBSTRING_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iosfwd>
 #include <stdexcept>
 #include <string>
@@ -237,4 +240,23 @@ namespace Opm {
 
 }
 
+namespace std {
+    /*
+     * Hash string_views like the strings they view, so they can be used as
+     * keys of unordered containers. FNV-1a, which is fast for the short
+     * keyword names that make up most of the keys.
+     */
+    template<>
+    struct hash< Opm::string_view > {
+        size_t operator()( const Opm::string_view& view ) const {
+            std::uint64_t h = 14695981039346656037ULL;
+            for( char c : view ) {
+                h ^= static_cast< unsigned char >( c );
+                h *= 1099511628211ULL;
+            }
+            return static_cast< size_t >( h );
+        }
+    };
+}
+
 #endif //OPM_UTILITY_SUBSTRING_HPP
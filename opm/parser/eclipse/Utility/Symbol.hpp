@@ -0,0 +1,60 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SYMBOL_HPP
+#define OPM_SYMBOL_HPP
+
+#include <string>
+
+namespace Opm {
+
+    /*
+      A Symbol is a pointer to the single copy of a string in a process
+      wide table. The deck holds millions of items and keywords, but only
+      a few hundred distinct item names, keyword names and file names;
+      these are stored as symbols instead of as a string each.
+
+      Creating a Symbol from a string takes a lock and a hash lookup,
+      copying one is free. Two symbols are equal if and only if their
+      strings are equal. The strings are never released.
+    */
+
+    class Symbol {
+    public:
+        Symbol();
+        explicit Symbol( const std::string& str );
+
+        const std::string& str() const {
+            return *this->m_str;
+        }
+
+        bool operator==( const Symbol& rhs ) const {
+            return this->m_str == rhs.m_str;
+        }
+
+        bool operator!=( const Symbol& rhs ) const {
+            return this->m_str != rhs.m_str;
+        }
+
+    private:
+        const std::string* m_str;
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdexcept>
+
+#include <opm/common/OpmLog/AsyncLog.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* Initial capacity of the message strings in the queue. */
+    const std::size_t messageReserve = 256;
+
+    std::size_t roundUpPower2(std::size_t value) {
+        std::size_t power = 2;
+        while (power < value)
+            power *= 2;
+
+        return power;
+    }
+
+}
+
+    /*
+      The queue is the bounded queue of D. Vyukov, with a single
+      consumer. The sequence number of a slot tells whose turn it is: a
+      producer may fill slot i at position pos when its sequence is pos,
+      and the consumer may empty it when the sequence is pos + 1.
+
+      When the queue is empty the consumer sleeps on m_wakeup, after
+      setting m_sleeping; a producer which sees m_sleeping after filling
+      a slot wakes it. Both sides store their flag before they load the
+      other's, sequentially consistent, so at least one of them sees the
+      other and no wakeup is lost. flush() waits on m_drained in the same
+      way, counted in m_flush_waiters.
+    */
+    AsyncLog::AsyncLog(std::shared_ptr<LogBackend> sink, std::size_t capacity) :
+        LogBackend(sink ? sink->getMask() : 0),
+        m_sink(sink),
+        m_capacity(roundUpPower2(capacity)),
+        m_slots(new Slot[m_capacity]),
+        m_enqueue_pos(0),
+        m_dequeue_pos(0),
+        m_stop(false),
+        m_sleeping(false),
+        m_flush_waiters(0)
+    {
+        if (!m_sink)
+            throw std::invalid_argument("AsyncLog needs a backend to pass the messages on to");
+
+        for (std::size_t index = 0; index < m_capacity; index++) {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+            m_slots[index].message.reserve(messageReserve);
+        }
+
+        m_thread = std::thread([this]() { this->run(); });
+    }
+
+
+    AsyncLog::~AsyncLog() {
+        m_stop.store(true);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wakeup.notify_one();
+        }
+        m_thread.join();
+    }
+
+
+    std::shared_ptr<LogBackend> AsyncLog::sink() const {
+        return m_sink;
+    }
+
+
+    void AsyncLog::addMessageUnconditionally(int64_t messageFlag, const std::string& message) {
+        const std::size_t index_mask = m_capacity - 1;
+        std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true) {
+            slot = &m_slots[pos & index_mask];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else {
+                // The queue is full, or another producer took the slot.
+                if (sequence < pos)
+                    std::this_thread::yield();
+
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->flag = messageFlag;
+        slot->message.assign(message);
+        slot->sequence.store(pos + 1);
+
+        if (m_sleeping.load()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wakeup.notify_one();
+        }
+    }
+
+
+    void AsyncLog::flush() {
+        const std::size_t target = m_enqueue_pos.load(std::memory_order_acquire);
+        if (m_dequeue_pos.load(std::memory_order_acquire) >= target)
+            return;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_flush_waiters.fetch_add(1);
+        m_drained.wait(lock, [this, target]() { return m_dequeue_pos.load() >= target; });
+        m_flush_waiters.fetch_sub(1);
+    }
+
+
+    void AsyncLog::run() {
+        const std::size_t index_mask = m_capacity - 1;
+        std::size_t idle = 0;
+
+        while (true) {
+            const std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[pos & index_mask];
+
+            if (slot.sequence.load(std::memory_order_acquire) == pos + 1) {
+                try {
+                    m_sink->addMessage(slot.flag, slot.message);
+                } catch (...) {
+                    // A failing backend must not take the process down.
+                }
+
+                slot.sequence.store(pos + m_capacity, std::memory_order_release);
+                m_dequeue_pos.store(pos + 1);
+                if (m_flush_waiters.load() > 0) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_drained.notify_all();
+                }
+
+                idle = 0;
+                continue;
+            }
+
+            if (m_stop.load(std::memory_order_acquire)
+                && m_enqueue_pos.load(std::memory_order_acquire) == pos)
+                break;
+
+            // Spin a little for the next message of a burst, then sleep
+            // until a producer or the destructor wakes the thread.
+            if (++idle < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleeping.store(true);
+            m_wakeup.wait(lock, [this, &slot, pos]() {
+                return (slot.sequence.load() == pos + 1) || m_stop.load();
+            });
+            m_sleeping.store(false);
+            idle = 0;
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,173 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+#include <opm/common/OpmLog/Metrics.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+namespace Opm {
+
+namespace {
+
+    std::atomic<bool>& reporting() {
+        static std::atomic<bool> on{false};
+        return on;
+    }
+
+
+    void write_tree(std::ostream& os, const MemoryUsage& usage, std::size_t depth) {
+        const std::string indent(2 * depth, ' ');
+        const auto total = usage.total();
+        os << std::left << std::setw(48) << (indent + usage.name)
+           << std::right << std::setw(16) << total
+           << std::setw(12) << std::fixed << std::setprecision(1) << total / (1024.0 * 1024.0)
+           << std::endl;
+
+        for (const auto& child : usage.children)
+            write_tree(os, child, depth + 1);
+    }
+
+}
+
+
+    MemoryUsage::MemoryUsage(const std::string& name_arg, std::size_t bytes_arg) :
+        name(name_arg),
+        bytes(bytes_arg)
+    {}
+
+
+    std::size_t MemoryUsage::total() const {
+        std::size_t sum = this->bytes;
+        for (const auto& child : this->children)
+            sum += child.total();
+        return sum;
+    }
+
+
+    const MemoryUsage* MemoryUsage::child(const std::string& child_name) const {
+        for (const auto& part : this->children) {
+            if (part.name == child_name)
+                return &part;
+        }
+        return nullptr;
+    }
+
+
+    MemoryUsage& MemoryUsage::add(MemoryUsage part) {
+        this->children.push_back(std::move(part));
+        return this->children.back();
+    }
+
+
+    MemoryUsage& MemoryUsage::add(const std::string& child_name, std::size_t child_bytes) {
+        return this->add(MemoryUsage(child_name, child_bytes));
+    }
+
+
+    MemoryUsage& MemoryUsage::accumulate(const MemoryUsage& part) {
+        auto iter = std::find_if(this->children.begin(), this->children.end(),
+                                 [&part](const MemoryUsage& existing) { return existing.name == part.name; });
+        if (iter == this->children.end())
+            return this->add(part);
+
+        iter->bytes += part.bytes;
+        for (const auto& grandchild : part.children)
+            iter->accumulate(grandchild);
+        return *iter;
+    }
+
+
+    void MemoryUsage::sort() {
+        for (auto& part : this->children)
+            part.sort();
+
+        std::stable_sort(this->children.begin(), this->children.end(),
+                         [](const MemoryUsage& a, const MemoryUsage& b) { return a.total() > b.total(); });
+    }
+
+
+    void MemoryUsage::write(std::ostream& os) const {
+        os << std::left << std::setw(48) << "memory"
+           << std::right << std::setw(16) << "bytes"
+           << std::setw(12) << "MiB" << std::endl;
+        write_tree(os, *this, 0);
+    }
+
+
+    void MemoryUsage::enable(bool on) {
+        reporting() = on;
+    }
+
+
+    bool MemoryUsage::enabled() {
+        return reporting();
+    }
+
+
+    void MemoryUsage::log(const MemoryUsage& usage) {
+        if (!enabled())
+            return;
+
+        Metrics::gauge("memory " + usage.name, usage.total());
+
+        std::ostringstream report;
+        usage.write(report);
+        OpmLog::note(report.str());
+    }
+
+
+    std::size_t MemoryUsage::heap(const std::vector<bool>& values) {
+        return values.capacity() / 8;
+    }
+
+
+    /*
+      Short strings are stored inside the string object itself, in which
+      case the string owns no heap storage.
+    */
+    std::size_t MemoryUsage::heap(const std::string& value) {
+        const char* object = reinterpret_cast<const char*>(&value);
+        const char* data = value.data();
+        if (data >= object && data < object + sizeof(value))
+            return 0;
+
+        return value.capacity() + 1;
+    }
+
+
+    std::size_t MemoryUsage::heap(const std::vector<std::string>& values) {
+        std::size_t sum = values.capacity() * sizeof(std::string);
+        for (const auto& value : values)
+            sum += heap(value);
+        return sum;
+    }
+
+
+    std::size_t MemoryUsage::heap(const std::set<std::string>& values) {
+        std::size_t sum = values.size() * sizeof(std::string);
+        for (const auto& value : values)
+            sum += heap(value);
+        return sum;
+    }
+
+} // namespace Opm
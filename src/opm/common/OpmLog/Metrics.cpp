@@ -0,0 +1,254 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <opm/common/OpmLog/Metrics.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const std::vector<double>& bucket_bounds() {
+        static const std::vector<double> bounds = []() {
+            std::vector<double> b;
+            for (int exponent = -20; exponent <= 40; exponent += 2)
+                b.push_back(std::ldexp(1.0, exponent));
+            return b;
+        }();
+        return bounds;
+    }
+
+
+    Metrics::Histogram empty_histogram() {
+        Metrics::Histogram histogram;
+        histogram.bounds = bucket_bounds();
+        histogram.counts.assign(histogram.bounds.size() + 1, 0);
+        return histogram;
+    }
+
+
+    /* The counters and histograms of one thread. */
+    struct Shard {
+        std::mutex mutex;
+        std::map<std::string, int64_t> counters;
+        std::map<std::string, Metrics::Histogram> histograms;
+    };
+
+
+    struct Registry {
+        std::atomic<bool> enabled{false};
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Shard>> shards;
+        std::map<std::string, Metrics::Gauge> gauges;
+
+        /*
+          The shards are shared with the registry so the metrics of
+          threads which have terminated are still part of the snapshot.
+        */
+        Shard& local() {
+            thread_local std::shared_ptr<Shard> shard;
+            if (!shard) {
+                shard = std::make_shared<Shard>();
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->shards.push_back(shard);
+            }
+            return *shard;
+        }
+
+        std::vector<std::shared_ptr<Shard>> all() {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->shards;
+        }
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+
+    std::string metric_name(const std::string& name) {
+        std::string result = "opm_";
+        for (const char c : name)
+            result += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        return result;
+    }
+
+}
+
+
+    void Metrics::enable(bool on) {
+        registry().enabled = on;
+    }
+
+
+    bool Metrics::enabled() {
+        return registry().enabled.load(std::memory_order_relaxed);
+    }
+
+
+    void Metrics::count(const std::string& name, int64_t increment) {
+        if (!enabled())
+            return;
+
+        auto& shard = registry().local();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.counters[name] += increment;
+    }
+
+
+    void Metrics::gauge(const std::string& name, double value) {
+        if (!enabled())
+            return;
+
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto iter = reg.gauges.find(name);
+        if (iter == reg.gauges.end()) {
+            iter = reg.gauges.emplace(name, Gauge()).first;
+            iter->second.max = value;
+        }
+
+        iter->second.value = value;
+        iter->second.max = std::max(iter->second.max, value);
+    }
+
+
+    void Metrics::observe(const std::string& name, double value) {
+        if (!enabled())
+            return;
+
+        const auto& bounds = bucket_bounds();
+        const auto bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+
+        auto& shard = registry().local();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.histograms.find(name);
+        if (iter == shard.histograms.end())
+            iter = shard.histograms.emplace(name, empty_histogram()).first;
+
+        auto& histogram = iter->second;
+        histogram.counts[bucket] += 1;
+        histogram.count += 1;
+        histogram.sum += value;
+    }
+
+
+    Metrics::Snapshot Metrics::snapshot() {
+        Snapshot snap;
+        for (const auto& shard : registry().all()) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            for (const auto& pair : shard->counters)
+                snap.counters[pair.first] += pair.second;
+
+            for (const auto& pair : shard->histograms) {
+                auto iter = snap.histograms.find(pair.first);
+                if (iter == snap.histograms.end())
+                    iter = snap.histograms.emplace(pair.first, empty_histogram()).first;
+
+                auto& target = iter->second;
+                for (std::size_t index = 0; index < target.counts.size(); index++)
+                    target.counts[index] += pair.second.counts[index];
+                target.count += pair.second.count;
+                target.sum += pair.second.sum;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        snap.gauges = registry().gauges;
+        return snap;
+    }
+
+
+    void Metrics::reset() {
+        for (const auto& shard : registry().all()) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->counters.clear();
+            shard->histograms.clear();
+        }
+
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().gauges.clear();
+    }
+
+
+    void Metrics::writePrometheus(std::ostream& os) {
+        const auto snap = snapshot();
+        os.unsetf(std::ios_base::floatfield);
+        os << std::setprecision(9);
+
+        for (const auto& pair : snap.counters) {
+            const auto name = metric_name(pair.first) + "_total";
+            os << "# TYPE " << name << " counter" << std::endl
+               << name << " " << pair.second << std::endl;
+        }
+
+        for (const auto& pair : snap.gauges) {
+            const auto name = metric_name(pair.first);
+            os << "# TYPE " << name << " gauge" << std::endl
+               << name << " " << pair.second.value << std::endl
+               << "# TYPE " << name << "_max gauge" << std::endl
+               << name << "_max " << pair.second.max << std::endl;
+        }
+
+        for (const auto& pair : snap.histograms) {
+            const auto name = metric_name(pair.first);
+            const auto& histogram = pair.second;
+            os << "# TYPE " << name << " histogram" << std::endl;
+
+            std::uint64_t cumulative = 0;
+            for (std::size_t index = 0; index < histogram.bounds.size(); index++) {
+                cumulative += histogram.counts[index];
+                os << name << "_bucket{le=\"" << histogram.bounds[index] << "\"} " << cumulative << std::endl;
+            }
+            os << name << "_bucket{le=\"+Inf\"} " << histogram.count << std::endl
+               << name << "_sum " << histogram.sum << std::endl
+               << name << "_count " << histogram.count << std::endl;
+        }
+    }
+
+
+    MetricsLog::MetricsLog(const std::string& logFile) :
+        StreamLog(logFile, MetricsReport)
+    {}
+
+
+    MetricsLog::MetricsLog(std::ostream& os) :
+        StreamLog(os, MetricsReport)
+    {}
+
+
+    void MetricsLog::addMessageUnconditionally(int64_t messageType, const std::string& message) {
+        std::ostringstream report;
+        if (!message.empty())
+            report << "# " << message << std::endl;
+
+        Metrics::writePrometheus(report);
+        StreamLog::addMessageUnconditionally(messageType, report.str());
+    }
+
+} // namespace Opm
@@ -21,6 +21,7 @@
 #include <opm/common/OpmLog/Logger.hpp>
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <iostream>
+#include <mutex>
 #include <errno.h>  // For errno
 #include <stdio.h>  // For fileno() and stdout
 
@@ -53,6 +54,17 @@ namespace Opm {
                 return isatty(file_descriptor);
             }
         }
+
+        /*
+          Messages may be added from several threads at once, for
+          instance while the components of an EclipseState are built
+          concurrently; the backends are not synchronised themselves.
+        */
+        std::mutex& messageMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
     }
 
 
@@ -65,14 +77,18 @@ namespace Opm {
 
 
     void OpmLog::addMessage(int64_t messageFlag , const std::string& message) {
-        if (m_logger)
+        if (m_logger) {
+            std::lock_guard<std::mutex> lock(messageMutex());
             m_logger->addMessage( messageFlag , message );
+        }
     }
 
 
     void OpmLog::addTaggedMessage(int64_t messageFlag, const std::string& tag, const std::string& message) {
-        if (m_logger)
+        if (m_logger) {
+            std::lock_guard<std::mutex> lock(messageMutex());
             m_logger->addTaggedMessage( messageFlag, tag, message );
+        }
     }
 
 
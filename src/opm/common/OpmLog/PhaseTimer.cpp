@@ -0,0 +1,365 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+#include <opm/common/OpmLog/Metrics.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
+
+namespace Opm {
+
+namespace {
+
+    using phase_clock = std::chrono::steady_clock;
+
+    struct ThreadNode {
+        std::string name;
+        std::size_t parent;
+        std::size_t calls = 0;
+        double seconds = 0;
+        std::map<std::string, int64_t> counters;
+        std::vector<std::size_t> children;
+
+        ThreadNode(const std::string& name_arg, std::size_t parent_arg) :
+            name(name_arg),
+            parent(parent_arg)
+        {}
+    };
+
+    struct TraceEvent {
+        std::size_t node;
+        phase_clock::time_point begin;
+        phase_clock::time_point end;
+    };
+
+    /*
+      The phase tree of one thread. The nodes are only ever appended, so
+      the indices of the open scopes on the stack stay valid through a
+      reset(). The mutex is only contended while a report is generated.
+    */
+    struct ThreadRecord {
+        std::mutex mutex;
+        std::size_t id;
+        std::vector<ThreadNode> nodes;
+        std::vector<std::pair<std::size_t, phase_clock::time_point>> stack;
+        std::vector<TraceEvent> events;
+
+        explicit ThreadRecord(std::size_t id_arg) :
+            id(id_arg)
+        {
+            this->nodes.emplace_back("", 0);
+        }
+
+        std::size_t current() const {
+            return this->stack.empty() ? 0 : this->stack.back().first;
+        }
+
+        std::size_t child(const std::string& name) {
+            const auto parent = this->current();
+            for (const auto index : this->nodes[parent].children) {
+                if (this->nodes[index].name == name)
+                    return index;
+            }
+
+            this->nodes.emplace_back(name, parent);
+            this->nodes[parent].children.push_back(this->nodes.size() - 1);
+            return this->nodes.size() - 1;
+        }
+    };
+
+
+    struct Registry {
+        std::atomic<bool> enabled{false};
+        std::atomic<bool> trace{false};
+        const phase_clock::time_point epoch = phase_clock::now();
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadRecord>> threads;
+
+        /*
+          The records are shared with the registry so the phases of
+          threads which have terminated are still part of the report.
+        */
+        ThreadRecord& local() {
+            thread_local std::shared_ptr<ThreadRecord> record;
+            if (!record) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                record = std::make_shared<ThreadRecord>(this->threads.size());
+                this->threads.push_back(record);
+            }
+            return *record;
+        }
+
+        std::vector<std::shared_ptr<ThreadRecord>> all() {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->threads;
+        }
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+
+    void merge(PhaseTimer::Node& target, const ThreadRecord& record, std::size_t index) {
+        const auto& source = record.nodes[index];
+        target.calls += source.calls;
+        target.seconds += source.seconds;
+        for (const auto& pair : source.counters)
+            target.counters[pair.first] += pair.second;
+
+        for (const auto child_index : source.children) {
+            const auto& name = record.nodes[child_index].name;
+            auto iter = std::find_if(target.children.begin(), target.children.end(),
+                                     [&name](const PhaseTimer::Node& node) { return node.name == name; });
+            if (iter == target.children.end()) {
+                target.children.emplace_back();
+                target.children.back().name = name;
+                iter = target.children.end() - 1;
+            }
+            merge(*iter, record, child_index);
+        }
+    }
+
+
+    std::string json_string(const std::string& s) {
+        std::string quoted = "\"";
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+
+    void write_tree(std::ostream& os, const PhaseTimer::Node& node, double parent_seconds, std::size_t depth) {
+        const std::string indent(2 * depth, ' ');
+        os << std::left << std::setw(48) << (indent + node.name)
+           << std::right << std::setw(10) << node.calls
+           << std::setw(14) << std::fixed << std::setprecision(6) << node.seconds;
+        if (parent_seconds > 0)
+            os << std::setw(9) << std::setprecision(1) << 100 * node.seconds / parent_seconds << " %";
+        os << std::endl;
+
+        for (const auto& pair : node.counters)
+            os << indent << "  # " << pair.first << ": " << pair.second << std::endl;
+
+        for (const auto& child : node.children)
+            write_tree(os, child, node.seconds, depth + 1);
+    }
+
+
+    void write_json(std::ostream& os, const PhaseTimer::Node& node) {
+        os << "{\"name\": " << json_string(node.name)
+           << ", \"calls\": " << node.calls
+           << ", \"seconds\": " << node.seconds
+           << ", \"counters\": {";
+        {
+            bool first = true;
+            for (const auto& pair : node.counters) {
+                os << (first ? "" : ", ") << json_string(pair.first) << ": " << pair.second;
+                first = false;
+            }
+        }
+        os << "}, \"children\": [";
+        for (std::size_t index = 0; index < node.children.size(); index++) {
+            os << (index == 0 ? "" : ", ");
+            write_json(os, node.children[index]);
+        }
+        os << "]}";
+    }
+
+}
+
+
+    const PhaseTimer::Node* PhaseTimer::Node::child(const std::string& child_name) const {
+        for (const auto& node : this->children) {
+            if (node.name == child_name)
+                return &node;
+        }
+        return nullptr;
+    }
+
+
+    PhaseTimer::Scope::Scope(const std::string& name) :
+        active(registry().enabled.load(std::memory_order_relaxed))
+    {
+        if (Metrics::enabled()) {
+            this->metric = name + " seconds";
+            this->start = phase_clock::now();
+        }
+
+        if (!this->active)
+            return;
+
+        auto& record = registry().local();
+        std::lock_guard<std::mutex> lock(record.mutex);
+        const auto index = record.child(name);
+        record.stack.emplace_back(index, phase_clock::now());
+    }
+
+
+    PhaseTimer::Scope::~Scope() {
+        if (!this->metric.empty())
+            Metrics::observe(this->metric, std::chrono::duration<double>(phase_clock::now() - this->start).count());
+
+        if (!this->active)
+            return;
+
+        const auto end = phase_clock::now();
+        auto& record = registry().local();
+        std::lock_guard<std::mutex> lock(record.mutex);
+        const auto open = record.stack.back();
+        record.stack.pop_back();
+
+        auto& node = record.nodes[open.first];
+        node.calls += 1;
+        node.seconds += std::chrono::duration<double>(end - open.second).count();
+
+        if (registry().trace.load(std::memory_order_relaxed))
+            record.events.push_back({open.first, open.second, end});
+    }
+
+
+    void PhaseTimer::enable(bool on) {
+        registry().enabled = on;
+    }
+
+
+    bool PhaseTimer::enabled() {
+        return registry().enabled;
+    }
+
+
+    void PhaseTimer::enableTrace(bool on) {
+        registry().trace = on;
+    }
+
+
+    void PhaseTimer::count(const std::string& name, int64_t increment) {
+        Metrics::count(name, increment);
+        if (!registry().enabled.load(std::memory_order_relaxed))
+            return;
+
+        auto& record = registry().local();
+        std::lock_guard<std::mutex> lock(record.mutex);
+        record.nodes[record.current()].counters[name] += increment;
+    }
+
+
+    PhaseTimer::Node PhaseTimer::report() {
+        Node root;
+        for (const auto& record : registry().all()) {
+            std::lock_guard<std::mutex> lock(record->mutex);
+            merge(root, *record, 0);
+        }
+        return root;
+    }
+
+
+    void PhaseTimer::reset() {
+        for (const auto& record : registry().all()) {
+            std::lock_guard<std::mutex> lock(record->mutex);
+            for (auto& node : record->nodes) {
+                node.calls = 0;
+                node.seconds = 0;
+                node.counters.clear();
+            }
+            record->events.clear();
+        }
+    }
+
+
+    void PhaseTimer::writeTree(std::ostream& os) {
+        const auto root = report();
+        os << std::left << std::setw(48) << "phase"
+           << std::right << std::setw(10) << "calls"
+           << std::setw(14) << "seconds"
+           << std::setw(11) << "parent" << std::endl;
+
+        for (const auto& pair : root.counters)
+            os << "# " << pair.first << ": " << pair.second << std::endl;
+
+        for (const auto& child : root.children)
+            write_tree(os, child, 0, 0);
+    }
+
+
+    void PhaseTimer::writeJSON(std::ostream& os) {
+        const auto root = report();
+        os.unsetf(std::ios_base::floatfield);
+        os << std::setprecision(9);
+        write_json(os, root);
+        os << std::endl;
+    }
+
+
+    /*
+      Complete ("X") events with the time stamps and durations in
+      microseconds relative to the first use of the timers.
+    */
+    void PhaseTimer::writeChromeTrace(std::ostream& os) {
+        const auto epoch = registry().epoch;
+        const auto micro = [epoch](phase_clock::time_point t) {
+            return std::chrono::duration<double, std::micro>(t - epoch).count();
+        };
+
+        bool first = true;
+        os << "{\"traceEvents\": [" << std::fixed << std::setprecision(3);
+        for (const auto& record : registry().all()) {
+            std::lock_guard<std::mutex> lock(record->mutex);
+            for (const auto& event : record->events) {
+                os << (first ? "" : ",") << std::endl
+                   << "  {\"name\": " << json_string(record->nodes[event.node].name)
+                   << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << record->id
+                   << ", \"ts\": " << micro(event.begin)
+                   << ", \"dur\": " << micro(event.end) - micro(event.begin) << "}";
+                first = false;
+            }
+        }
+        os << std::endl << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+    }
+
+
+    PhaseTimerLog::PhaseTimerLog(const std::string& logFile) :
+        StreamLog(logFile, PhaseReport)
+    {}
+
+
+    PhaseTimerLog::PhaseTimerLog(std::ostream& os) :
+        StreamLog(os, PhaseReport)
+    {}
+
+
+    void PhaseTimerLog::addMessageUnconditionally(int64_t messageType, const std::string& message) {
+        std::ostringstream report;
+        if (!message.empty())
+            report << message << std::endl;
+
+        PhaseTimer::writeTree(report);
+        StreamLog::addMessageUnconditionally(messageType, report.str());
+    }
+
+} // namespace Opm
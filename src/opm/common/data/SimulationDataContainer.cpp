@@ -18,6 +18,7 @@
  */
 
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/common/utility/FirstTouch.hpp>
 #include <opm/common/utility/numeric/cmp.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 
@@ -101,7 +102,7 @@ namespace Opm {
 
     void SimulationDataContainer::registerCellData( const std::string& name , size_t components , double initialValue) {
         if (!hasCellData( name )) {
-            m_cell_data.insert( std::pair<std::string , std::vector<double>>( name , std::vector<double>(components * m_num_cells , initialValue )));
+            m_cell_data.insert( std::pair<std::string , std::vector<double>>( name , FirstTouch::make<double>(components * m_num_cells , initialValue )));
         }
     }
 
@@ -111,31 +112,53 @@ namespace Opm {
                                                         const std::vector<int>& cells ,
                                                         const std::vector<double>& values) {
         auto& data = getCellData( key );
-        if (component >= m_num_phases)
+        const size_t num_components = numCellDataComponents( key );
+        if (component >= num_components)
             OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
 
-
         if (cells.size() != values.size())
             OPM_THROW(std::invalid_argument, "size mismatch between cells and values");
 
-        // This is currently quite broken; the setCellDataComponent
-        // method assumes that the number of components in the field
-        // we are currently focusing on has num_phases components in
-        // total. This restriction should be lifted by allowing a per
-        // field number of components.
+        for (const auto& cell : cells) {
+            if (cell < 0 || size_t(cell) >= m_num_cells)
+                OPM_THROW(std::invalid_argument , "The cell number: " << cell << " is invalid.");
+        }
 
-        if (data.size() != m_num_phases * m_num_cells)
-            OPM_THROW(std::invalid_argument , "Can currently only be used on fields with num_components == num_phases (i.e. saturation...) ");
+        double* field = data.data() + component;
+        for (size_t i = 0; i < cells.size(); i++)
+            field[cells[i] * num_components] = values[i];
+    }
 
 
-        for (size_t i = 0; i < cells.size(); i++) {
-            if (size_t(cells[i]) < m_num_cells) {
-                auto field_index = cells[i] * m_num_phases + component;
-                data[field_index] = values[i];
-            } else {
-                OPM_THROW(std::invalid_argument , "The cell number: " << cells[i] << " is invalid.");
-            }
-        }
+    void SimulationDataContainer::setCellDataComponent( const std::string& key ,
+                                                        size_t component ,
+                                                        const std::vector<double>& values) {
+        auto& data = getCellData( key );
+        const size_t num_components = numCellDataComponents( key );
+        if (component >= num_components)
+            OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
+
+        if (values.size() != m_num_cells)
+            OPM_THROW(std::invalid_argument, "size mismatch between cells and values");
+
+        double* field = data.data() + component;
+        for (size_t cell = 0; cell < m_num_cells; cell++)
+            field[cell * num_components] = values[cell];
+    }
+
+
+    std::vector<double> SimulationDataContainer::getCellDataComponent( const std::string& key , size_t component ) const {
+        const auto& data = getCellData( key );
+        const size_t num_components = numCellDataComponents( key );
+        if (component >= num_components)
+            OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
+
+        std::vector<double> values( m_num_cells );
+        const double* field = data.data() + component;
+        for (size_t cell = 0; cell < m_num_cells; cell++)
+            values[cell] = field[cell * num_components];
+
+        return values;
     }
 
 
@@ -163,7 +186,7 @@ namespace Opm {
 
     void SimulationDataContainer::registerFaceData( const std::string& name , size_t components , double initialValue) {
         if (!hasFaceData( name )) {
-            m_face_data.insert( std::pair<std::string , std::vector<double>>( name , std::vector<double>(components * m_num_faces , initialValue )));
+            m_face_data.insert( std::pair<std::string , std::vector<double>>( name , FirstTouch::make<double>(components * m_num_faces , initialValue )));
         }
     }
 
@@ -206,7 +229,7 @@ namespace Opm {
 
     size_t SimulationDataContainer::numCellDataComponents( const std::string& name ) const {
         const auto& data = getCellData( name );
-        return data.size() / m_num_cells;
+        return m_num_cells == 0 ? 0 : data.size() / m_num_cells;
     }
 
 
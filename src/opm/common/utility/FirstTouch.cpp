@@ -0,0 +1,152 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <opm/common/utility/FirstTouch.hpp>
+
+namespace Opm {
+
+namespace {
+
+    struct Policy {
+        std::atomic<bool> enabled{false};
+        std::atomic<bool> huge_pages{false};
+        std::mutex mutex;
+        std::vector<std::size_t> offsets;
+    };
+
+    Policy& policy() {
+        static Policy instance;
+        return instance;
+    }
+
+
+    /*
+      The offsets of the parts of an array of size values: the
+      partition scaled to the array, or equal parts for the threads.
+    */
+    std::vector<std::size_t> parts(std::size_t size) {
+        auto& p = policy();
+        std::vector<std::size_t> offsets;
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            offsets = p.offsets;
+        }
+
+        const std::size_t cells = offsets.empty() ? 0 : offsets.back();
+        if (cells > 0 && size % cells == 0) {
+            const std::size_t scale = size / cells;
+            for (auto& offset : offsets)
+                offset *= scale;
+            return offsets;
+        }
+
+#ifdef _OPENMP
+        const std::size_t num_parts = std::max(1, omp_get_max_threads());
+#else
+        const std::size_t num_parts = 1;
+#endif
+        offsets.clear();
+        for (std::size_t part = 0; part <= num_parts; part++)
+            offsets.push_back(size * part / num_parts);
+
+        return offsets;
+    }
+
+}
+
+
+    void FirstTouch::enable(bool on) {
+        policy().enabled = on;
+    }
+
+
+    bool FirstTouch::enabled() {
+        return policy().enabled.load(std::memory_order_relaxed);
+    }
+
+
+    void FirstTouch::enableHugePages(bool on) {
+        policy().huge_pages = on;
+    }
+
+
+    void FirstTouch::setPartition(const std::vector<std::size_t>& offsets) {
+        if (!offsets.empty()) {
+            if (offsets.front() != 0 || !std::is_sorted(offsets.begin(), offsets.end()))
+                throw std::invalid_argument("The partition must be increasing offsets starting with zero");
+        }
+
+        auto& p = policy();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.offsets = offsets;
+    }
+
+
+    /*
+      Only the pages which lie entirely inside the array are released,
+      the partial pages at the ends may hold other data of the heap.
+    */
+    void FirstTouch::releasePages(void* data, std::size_t bytes) {
+#ifdef __linux__
+        const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        const auto address = reinterpret_cast<std::uintptr_t>(data);
+        const auto begin = (address + page_size - 1) / page_size * page_size;
+        const auto end = (address + bytes) / page_size * page_size;
+        if (end <= begin)
+            return;
+
+        void* pages = reinterpret_cast<void*>(begin);
+#ifdef MADV_HUGEPAGE
+        if (policy().huge_pages.load(std::memory_order_relaxed))
+            madvise(pages, end - begin, MADV_HUGEPAGE);
+#endif
+        madvise(pages, end - begin, MADV_DONTNEED);
+#else
+        (void) data;
+        (void) bytes;
+#endif
+    }
+
+
+    void FirstTouch::forEachPart(std::size_t size, const std::function<void(std::size_t, std::size_t)>& op) {
+        const auto offsets = parts(size);
+        const long num_parts = static_cast<long>(offsets.size()) - 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+        for (long part = 0; part < num_parts; ++part)
+            op(offsets[part], offsets[part + 1]);
+    }
+
+} // namespace Opm
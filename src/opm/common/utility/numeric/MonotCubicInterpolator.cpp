@@ -41,6 +41,7 @@
 #include <vector>
 #include <map>
 #include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -233,6 +234,83 @@ evaluate(double x) const {
 }
 
 
+void
+MonotCubicInterpolator::
+evaluate(const double* x, double* f, std::size_t n) const {
+
+  if (data.empty()) {
+    throw("MonotCubicInterpolator: evaluate() called on an empty table.");
+  }
+
+  // Contiguous copies of the data points and derivatives
+  vector<double> xs, fs, ds;
+  xs.reserve(data.size());
+  fs.reserve(data.size());
+  for (map<double,double>::const_iterator it = data.begin(); it != data.end(); ++it) {
+    xs.push_back(it->first);
+    fs.push_back(it->second);
+  }
+  const bool hermite = (ddata.size() == data.size());
+  if (hermite) {
+    ds.reserve(ddata.size());
+    for (map<double,double>::const_iterator it = ddata.begin(); it != ddata.end(); ++it) {
+      ds.push_back(it->second);
+    }
+  }
+
+  // Index of the first data point with xs[upper] >= x, as lower_bound()
+  // in evaluate(double); starts at the first interval.
+  std::size_t upper = 1;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double xi = x[i];
+    if (std::isnan(xi) || std::isinf(xi)) {
+      throw("MonotCubicInterpolator: evaluate() received inf/nan input.");
+    }
+
+    // Constant extrapolation (!!)
+    if (xi <= xs.front()) {
+      f[i] = fs.front();
+      continue;
+    }
+    if (xi > xs.back()) {
+      f[i] = fs.back();
+      continue;
+    }
+
+    // Ok, we have x_min < x <= x_max
+    if (xs[upper - 1] >= xi) {
+      upper = std::lower_bound(xs.begin(), xs.end(), xi) - xs.begin();
+    } else {
+      while (xs[upper] < xi) {
+        ++upper;
+      }
+    }
+
+    const std::size_t lower = upper - 1;
+    if (!hermite) {
+      f[i] = fs[lower] + (fs[upper] - fs[lower]) / (xs[upper] - xs[lower]) * (xi - xs[lower]);
+    } else { // Do Cubic Hermite spline
+      const double t = (xi - xs[lower])/(xs[upper] - xs[lower]); // t \in [0,1]
+      const double h = xs[upper] - xs[lower];
+      f[i]
+        = fs[lower] * H00(t)
+        + ds[lower] * H10(t) * h
+        + fs[upper] * H01(t)
+        + ds[upper] * H11(t) * h ;
+    }
+  }
+}
+
+
+vector<double>
+MonotCubicInterpolator::
+evaluate(const vector<double>& x) const {
+  vector<double> f(x.size());
+  evaluate(x.data(), f.data(), x.size());
+  return f;
+}
+
+
 // double
 // MonotCubicInterpolator::
 // evaluate(double x, double& errorestimate_output) {
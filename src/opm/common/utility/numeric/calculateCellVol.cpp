@@ -37,125 +37,154 @@
     in the lengths of cell face diagonals and of the diagonals across the
     cell. For a cubical block only the first four terms would exist.
 
+    The cells are processed in batches of batch_size cells, the arrays of
+    a batch hold one value per cell in the innermost dimension. All the
+    loops over the cells of a batch have the fixed length batch_size, so
+    the compiler can vectorize them over the cells; the loops over the
+    terms have fixed bounds and are unrolled.
 */
 
-double C(const double* r, int i1, int i2, int i3){
+namespace {
 
-   double temp;
+const std::size_t batch_size = 8;
 
-   temp = 0.0;
-   
-   if ((i1 == 0) && (i2 == 0) && (i3 == 0)){
-      temp = r[0];
-   }
+/* The coefficients C(i1,i2,i3) of one coordinate, at i1 + 2*i2 + 4*i3. */
+struct Coefficients {
+   double c[8][batch_size];
+};
 
-   if ((i1 == 1) && (i2 == 0) && (i3 == 0)){
-      temp = r[1] - r[0];
-   }
 
-   if ((i1 == 0) && (i2 == 1) && (i3 == 0)){
-      temp = r[2] - r[0];
+void coefficients(const double (&r)[8][batch_size], Coefficients& coeff){
+   auto& c = coeff.c;
+   for (std::size_t b = 0; b < batch_size; ++b){
+      c[0][b] = r[0][b];
+      c[1][b] = r[1][b] - r[0][b];
+      c[2][b] = r[2][b] - r[0][b];
+      c[3][b] = r[3][b] + r[0][b] - r[2][b] - r[1][b];
+      c[4][b] = r[4][b] - r[0][b];
+      c[5][b] = r[5][b] + r[0][b] - r[4][b] - r[1][b];
+      c[6][b] = r[6][b] + r[0][b] - r[4][b] - r[2][b];
+      c[7][b] = r[7][b] + r[4][b] + r[2][b] + r[1][b] - r[6][b] - r[5][b] - r[3][b] - r[0][b];
    }
+}
 
-   if ((i1 == 0) && (i2 == 0) && (i3 == 1)){
-      temp = r[4]-r[0];
-   }
 
-   if ((i1 == 1) && (i2 == 1) && (i3 == 0)){
-      temp = r[3] + r[0] - r[2] - r[1];
+/*
+   Adds sign times the term of one permutation of the coordinates to
+   the volumes, the volume is the sum of the six terms with the sign of
+   the permutation.
+*/
+void addPermutationTerm(double sign, const Coefficients& u, const Coefficients& v, const Coefficients& w,
+                        double (&volume)[batch_size]){
+   double sum[batch_size] = {};
+   for (int pb = 0; pb < 2; ++pb){
+     for (int pg = 0; pg < 2; ++pg){
+       for (int qa = 0; qa < 2; ++qa){
+         for (int qg = 0; qg < 2; ++qg){
+           for (int ra = 0; ra < 2; ++ra){
+             for (int rb = 0; rb < 2; ++rb){
+               const double* cu = u.c[1 + 2*pb + 4*pg];
+               const double* cv = v.c[qa + 2 + 4*qg];
+               const double* cw = w.c[ra + 2*rb + 4];
+               const double denom = (qa+ra+1) * (pb+rb+1) * (pg+qg+1);
+               for (std::size_t b = 0; b < batch_size; ++b)
+                  sum[b] += cu[b] * cv[b] * cw[b] / denom;
+             }
+           }
+         }
+       }
+     }
    }
 
-   if ((i1 == 0) && (i2 == 1) && (i3 == 1)){
-      temp = r[6] + r[0] - r[4] - r[2];
-   }
+   for (std::size_t b = 0; b < batch_size; ++b)
+      volume[b] += sign * sum[b];
+}
 
-   if ((i1 == 1) && (i2 == 0) && (i3 == 1)){
-      temp = r[5] + r[0] - r[4] - r[1];
+
+/*
+   A cell where every corner of the top face coincides with the corner
+   below it, a pinched out or collapsed cell, has zero volume.
+*/
+bool collapsed(std::size_t num_cells, std::size_t cell,
+               const double* X, const double* Y, const double* Z){
+   for (std::size_t corner = 0; corner < 4; ++corner){
+      const std::size_t top = corner * num_cells + cell;
+      const std::size_t bottom = top + 4 * num_cells;
+      if ((X[top] != X[bottom]) || (Y[top] != Y[bottom]) || (Z[top] != Z[bottom]))
+         return false;
    }
+   return true;
+}
+
 
-   if ((i1 == 1) && (i2 == 1) && (i3 == 1)){
-      temp = r[7] + r[4] + r[2] + r[1] - r[6] - r[5] - r[3] - r[0];
+/*
+   The volumes of the cells [first, last), at most batch_size cells; the
+   unused lanes of a short batch repeat the last cell.
+*/
+void batchVolumes(std::size_t num_cells, std::size_t first, std::size_t last,
+                  const double* X, const double* Y, const double* Z, double* volumes){
+   double r[3][8][batch_size];
+   const double* coord[3] = { X, Y, Z };
+   for (std::size_t axis = 0; axis < 3; ++axis){
+      for (std::size_t corner = 0; corner < 8; ++corner){
+         const double* src = coord[axis] + corner * num_cells;
+         for (std::size_t b = 0; b < batch_size; ++b)
+            r[axis][corner][b] = src[std::min(first + b, last - 1)];
+      }
    }
 
-   return temp;
+   Coefficients cx, cy, cz;
+   coefficients(r[0], cx);
+   coefficients(r[1], cy);
+   coefficients(r[2], cz);
+
+   double volume[batch_size] = {};
+   addPermutationTerm( 1.0, cx, cy, cz, volume);
+   addPermutationTerm(-1.0, cx, cz, cy, volume);
+   addPermutationTerm(-1.0, cy, cx, cz, volume);
+   addPermutationTerm( 1.0, cy, cz, cx, volume);
+   addPermutationTerm( 1.0, cz, cx, cy, volume);
+   addPermutationTerm(-1.0, cz, cy, cx, volume);
+
+   for (std::size_t cell = first; cell < last; ++cell)
+      volumes[cell] = std::fabs(volume[cell - first]);
+}
 
 }
 
 
-double perm123sign(int i1, int i2, int i3){
+double calculateCellVol(const std::vector<double>& X, const std::vector<double>& Y, const std::vector<double>& Z){
+   assert((X.size() == 8) && (Y.size() == 8) && (Z.size() == 8));
 
-   double temp;
-   
-   if ((i1 ==1 ) && (i2==2) && (i3 == 3)){
-      temp = 1.0;
-   }
-   
-   if ((i1 == 1) && (i2==3) && (i3 == 2)){
-      temp = -1.0;
-   }
-   
-   if ((i1 == 2) && (i2 == 1) && (i3 == 3)){
-      temp = -1.0;
-   }
-   
-   if ((i1 == 2) && (i2 == 3) && (i3 == 1)){
-      temp = 1.0;
-   }
-   
-   if ((i1 == 3) && (i2 == 1) && (i3 == 2)){
-      temp = 1.0;
-   }
-   
-   if ((i1 == 3) && (i2 == 2) && (i3 == 1)){
-      temp = -1.0;
-   }
-   
-   return temp;
+   double volume;
+   calculateCellVol(1, X.data(), Y.data(), Z.data(), &volume);
+   return volume;
 }
 
-double calculateCellVol(const std::vector<double>& X, const std::vector<double>& Y, const std::vector<double>& Z){
-      
-  double volume = 0.0;
-  const double* vect[3]; 
-  int permutation[] = {1, 2, 3};
-
-  do {
-     for (int j = 0; j < 3; ++j){
-        if (permutation[j] == 1){
-	   vect[j] = X.data();
-	} else if (permutation[j] == 2){
-	   vect[j] = Y.data();
-	} else if (permutation[j] == 3){
-	   vect[j] = Z.data();
-	} else {
-	     // this condition can never happen, since all values in 'permutation'
-	     // is covered, but compiler analysis may not be deep enough to not give
-	     // warnings about 'vect' being uninitialized further down.
-	     assert(false);
-	     vect[j] = 0;
-        } 
-     }
-    
-     for (int pb = 0; pb < 2; ++pb){
-       for (int pg = 0; pg < 2; ++pg){
-   	 for (int qa = 0; qa < 2; ++qa){
-   	   for (int qg = 0; qg < 2; ++qg){
-   	     for (int ra = 0; ra < 2; ++ra){
-   	       for (int rb = 0; rb < 2; ++rb){
-                 const double cprod = C(vect[0], 1, pb, pg)*C(vect[1], qa, 1, qg)*C(vect[2], ra, rb, 1);
-                 const double denom = (qa+ra+1) * (pb+rb+1) * (pg+qg+1);
-                 volume += perm123sign(permutation[0], permutation[1], permutation[2]) * cprod / denom;
-   	       }
-   	     }
-   	   }
-   	 }
-       }
-     }  
-   
-  } while (std::next_permutation(std::begin(permutation), std::end(permutation)));
 
-  return std::fabs(volume);
-}
+/*
+   A batch where all the cells are collapsed is skipped, in the other
+   batches the collapsed cells are computed with the rest and set to
+   zero afterwards.
+*/
+void calculateCellVol(std::size_t num_cells, const double* X, const double* Y, const double* Z, double* volumes){
+   for (std::size_t first = 0; first < num_cells; first += batch_size){
+      const std::size_t last = std::min(num_cells, first + batch_size);
+
+      bool all_collapsed = true;
+      for (std::size_t cell = first; cell < last; ++cell)
+         all_collapsed = all_collapsed && collapsed(num_cells, cell, X, Y, Z);
 
+      if (all_collapsed){
+         std::fill(volumes + first, volumes + last, 0.0);
+         continue;
+      }
 
+      batchVolumes(num_cells, first, last, X, Y, Z, volumes);
 
+      for (std::size_t cell = first; cell < last; ++cell){
+         if (collapsed(num_cells, cell, X, Y, Z))
+            volumes[cell] = 0.0;
+      }
+   }
+}
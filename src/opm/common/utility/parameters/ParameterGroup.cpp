@@ -50,7 +50,8 @@
 
 namespace Opm {
 	ParameterGroup::ParameterGroup()
-	: path_(ID_path_root), parent_(0), output_is_enabled_(true)
+	: path_(ID_path_root), parent_(0), output_is_enabled_(true),
+	  revision_(std::make_shared<std::size_t>(0))
 	{
 	}
 
@@ -86,7 +87,8 @@ namespace Opm {
 	ParameterGroup::ParameterGroup(const std::string& patharg,
 	                               const ParameterGroup* parent,
                                        const bool enable_output)
-	: path_(patharg), parent_(parent), output_is_enabled_(enable_output)
+	: path_(patharg), parent_(parent), output_is_enabled_(enable_output),
+	  revision_(parent != 0 ? parent->revision_ : std::make_shared<std::size_t>(0))
 	{
 	}
 
@@ -168,6 +170,7 @@ namespace Opm {
 	void ParameterGroup::insert(const std::string& name,
 				    const std::shared_ptr<ParameterMapItem>& data)
         {
+	    ++*revision_;
 	    std::pair<std::string, std::string> name_path = splitParam(name);
 	    map_type::const_iterator it = map_.find(name_path.first);
 	    assert(name_path.second == "");
@@ -200,6 +203,7 @@ namespace Opm {
 	void ParameterGroup::insertParameter(const std::string& name,
                                              const std::string& value)
         {
+	    ++*revision_;
 	    std::pair<std::string, std::string> name_path = splitParam(name);
 	    while (name_path.first == "") {
 		name_path = splitParam(name_path.second);
@@ -76,18 +76,20 @@ namespace {
     }
 
 
+    /// The wells are processed in parallel; the connections of each
+    /// well in sequence.
     template <class ConnOp>
     void connectionLoop(const std::vector<const Opm::Well*>& wells,
                         const Opm::EclipseGrid&              grid,
                         const std::size_t                    sim_step,
                         ConnOp&&                             connOp)
     {
-        for (auto nWell = wells.size(), wellID = 0*nWell;
-             wellID < nWell; ++wellID)
+        Opm::RestartIO::Helpers::parallelFor(wells.size(),
+            [&wells, &grid, sim_step, &connOp](const std::size_t wellID) -> void
         {
             const auto* well = wells[wellID];
 
-            if (well == nullptr) { continue; }
+            if (well == nullptr) { return; }
             const auto& conns = well->getActiveConnections(sim_step, grid);
 	    const int niSI = static_cast<int>(well->getTotNoConn());
 	    std::map <std::size_t, const Opm::Connection*> sIToConn;
@@ -114,7 +116,7 @@ namespace {
             {
                 connOp(*well, wellID, *(connSI[connID]), connID);
             }
-        }
+        });
     }
 
     namespace IConn {
@@ -293,6 +295,20 @@ AggregateConnectionData(const std::vector<int>& inteHead)
 
 // ---------------------------------------------------------------------
 
+void
+Opm::RestartIO::Helpers::AggregateConnectionData::
+reset(const std::vector<int>& inteHead)
+{
+    const auto nRows = numWells(inteHead);
+    const auto nCols = maxNumConn(inteHead);
+
+    this->iConn_.reset({ nRows }, { nCols }, { IConn::entriesPerConn(inteHead) });
+    this->sConn_.reset({ nRows }, { nCols }, { SConn::entriesPerConn(inteHead) });
+    this->xConn_.reset({ nRows }, { nCols }, { XConn::entriesPerConn(inteHead) });
+}
+
+// ---------------------------------------------------------------------
+
 void
 Opm::RestartIO::Helpers::AggregateConnectionData::
 captureDeclaredConnData(const Schedule&        sched,
@@ -31,8 +31,9 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <stdexcept>
 #include <string>
-#include <iostream>
+#include <utility>
 
 // #####################################################################
 // Class Opm::RestartIO::Helpers::AggregateGroupData
@@ -53,99 +54,63 @@ namespace {
         return inteHead[19];
     }
 
-    const int groupType(const Opm::Schedule& sched,
-		      const Opm::Group& group,
-		      const std::size_t simStep)
-    {
-	const std::string& groupName = group.name();
-	if (!sched.hasGroup(groupName))
-            throw std::invalid_argument("No such group: " + groupName);
-        {
-            if (group.hasBeenDefined( simStep )) {
-                const auto& groupTree = sched.getGroupTree( simStep );
-                const auto& childGroups = groupTree.children( groupName );
-
-                if (childGroups.size()) {
-		    return 1;
-                }
-                else {
-		    return 0;
-		}
-            }
-            return 0;
-        }
-    }
-
+    /// Groups are independent and fill disjoint windows of the
+    /// restart arrays, so groupOp is invoked in parallel.
     template <typename GroupOp>
     void groupLoop(const std::vector<const Opm::Group*>& groups,
-                  GroupOp&&                             groupOp)
+                   GroupOp&&                             groupOp)
     {
-        auto groupID = std::size_t{0};
-        for (const auto* group : groups) {
-            groupID += 1;
-
-            if (group == nullptr) { continue; }
+        Opm::RestartIO::Helpers::parallelFor(groups.size(),
+            [&groups, &groupOp](const std::size_t groupID) -> void
+        {
+            const auto* group = groups[groupID];
 
-            groupOp(*group, groupID - 1);
-        }
-    }
+            if (group == nullptr) { return; }
 
-    std::map <size_t, const Opm::Group*>  currentGroupMapIndexGroup(const Opm::Schedule& sched, const size_t simStep, const std::vector<int>& inteHead)
-    {
-	const auto& groups = sched.getGroups(simStep);
-	// make group index for current report step
-	std::map <size_t, const Opm::Group*> indexGroupMap;
-	for (const auto* group : groups) {
-	    int ind = (group->name() == "FIELD")
-	    ? ngmaxz(inteHead)-1 : group->seqIndex()-1;
-	    const std::pair<size_t, const Opm::Group*> groupPair = std::make_pair(static_cast<size_t>(ind), group); 
-	    indexGroupMap.insert(groupPair);
-	}
-	return indexGroupMap;
+            groupOp(*group, groupID);
+        });
     }
 
-    std::map <const std::string, size_t>  currentGroupMapNameIndex(const Opm::Schedule& sched, const size_t simStep, const std::vector<int>& inteHead)
+    /// Group lookups of one report step.  Built once per restart step
+    /// and shared, read-only, by all the groups.
+    struct StepGroups
     {
-	const auto& groups = sched.getGroups(simStep);
-	// make group name to index map for the current time step
-	std::map <const std::string, size_t> groupIndexMap;
-	for (const auto* group : groups) {
-	    int ind = (group->name() == "FIELD")
-                    ? ngmaxz(inteHead)-1 : group->seqIndex()-1;
-	    std::pair<const std::string, size_t> groupPair = std::make_pair(group->name(), ind); 
-	    groupIndexMap.insert(groupPair);
-	}
-	return groupIndexMap;
-    }
+        StepGroups(const Opm::Schedule&    sched_arg,
+                   const std::size_t       simStep,
+                   const std::vector<int>& inteHead)
+            : sched     (sched_arg)
+            , tree      (sched_arg.getGroupTree(simStep))
+            , treeIndex (tree.index())
+            , groups    (ngmaxz(inteHead), nullptr)
+        {
+            // The field group always has seqIndex = 0 because it is
+            // always defined first, and is stored in the last slot.
+            for (const auto* group : sched.getGroups(simStep)) {
+                const auto ind = (group->name() == "FIELD")
+                    ? ngmaxz(inteHead) - 1 : group->seqIndex() - 1;
+
+                this->groups.at(ind) = group;
+                this->slot.emplace(group->name(), ind);
+            }
+        }
 
-    const int currentGroupLevel(const Opm::Schedule& sched, const Opm::Group& group, const size_t simStep)
-    {
-	int level = 0;
-	const std::vector< const Opm::Group* >  groups = sched.getGroups(simStep);
-      	const std::string& groupName = group.name();
-	if (!sched.hasGroup(groupName))
-            throw std::invalid_argument("No such group: " + groupName);
+        std::size_t slotOf(const std::string& name) const
         {
-            if (group.hasBeenDefined( simStep )) {
-                const auto& groupTree = sched.getGroupTree( simStep );
-		//find group level - field level is 0
-		std::string tstGrpName = groupName;
-		while (((tstGrpName.size())>0) && (!(tstGrpName=="FIELD"))) {
-		    std::string curParent = groupTree.parent(tstGrpName);
-		    level+=1;
-		    tstGrpName = curParent;
-		}
-		return level;
-	    }
-	    else {
-		std::stringstream str;
-		str << "actual group has not been defined at report time: " << simStep;
-		throw std::invalid_argument(str.str());
-	    }
-	}
-	return level;
-    }
+            const auto itr = this->slot.find(name);
+            if (itr == this->slot.end())
+                throw std::invalid_argument("Invalid group name: " + name);
+
+            return itr->second;
+        }
+
+        const Opm::Schedule&                sched;
+        const Opm::GroupTree&               tree;
+        const Opm::GroupTree::Index&        treeIndex;
 
+        // Active groups by restart slot, null for unused slots.
+        std::vector<const Opm::Group*>      groups;
+        std::map<std::string, std::size_t>  slot;
+    };
 
     namespace IGrp {
         std::size_t entriesPerGroup(const std::vector<int>& inteHead)
@@ -166,122 +131,98 @@ namespace {
         }
 
         template <class IGrpArray>
-        void staticContrib(const Opm::Schedule&    sched,
-			   const Opm::Group&       group,
-			   const int               nwgmax,
-			   const int               ngmaxz,
-			   const std::size_t       simStep,
-			   IGrpArray&              iGrp,
-			   const std::vector<int>& inteHead)
+        void staticContrib(const StepGroups&       step,
+                           const Opm::Group&       group,
+                           const int               nwgmax,
+                           const int               ngmaxz,
+                           const std::size_t       simStep,
+                           IGrpArray&              iGrp)
         {
-	  // find the number of wells or child groups belonging to a group and store in 
-	  // location nwgmax +1 in the iGrp array
-
-	    const auto childGroups = sched.getChildGroups(group.name(), simStep);
-	    const auto childWells  = sched.getChildWells(group.name(), simStep);
-	    const auto groupMapNameIndex =  currentGroupMapNameIndex(sched, simStep, inteHead);
-	    const auto mapIndexGroup = currentGroupMapIndexGroup(sched, simStep, inteHead);
-	    if ((childGroups.size() != 0) && (childWells.size()!=0))
-	      throw std::invalid_argument("group has both wells and child groups" + group.name());
+            const auto& treeIndex = step.treeIndex;
+            const auto  node      = treeIndex.find(group.name());
+            if (node == Opm::GroupTree::Index::npos)
+                throw std::invalid_argument("Group not in group tree: " + group.name());
+
+            // find the number of wells or child groups belonging to a group and store in
+            // location nwgmax +1 in the iGrp array
+            const auto numChildGroups = treeIndex.numChildren(node);
             int igrpCount = 0;
-	    if (childWells.size() != 0) {
-		//group has child wells
-		for ( auto it = childWells.begin() ; it != childWells.end(); it++) {
-		    iGrp[igrpCount] = (*it)->seqIndex()+1;
-		    igrpCount+=1;
-		}
-	    }
-	    else if (childGroups.size() != 0) {
-		//group has child groups
-		//The field group always has seqIndex = 0 because it is always defined first
-	        //Hence the all groups except the Field group uses the seqIndex assigned
-		std::vector<size_t> childGroupIndex;
-		Opm::RestartIO::Helpers::groupMaps groupMap;
-		groupMap.currentGrpTreeNameSeqIndMap(sched, simStep, groupMapNameIndex,mapIndexGroup);
-		const auto indGroupMap = groupMap.indexGroupMap();
-		const auto gNameIndMap = groupMap.groupNameIndexMap();
-		for (auto* grp : childGroups) {
-		  auto groupName = grp->name();
-		  auto searchGTName = gNameIndMap.find(groupName);
-		  if (searchGTName != gNameIndMap.end()) {
-		      childGroupIndex.push_back(searchGTName->second);
-		  }
-		  else {
-		      throw std::invalid_argument( "Invalid group name" );
-		  }
-		}
-		std::sort(childGroupIndex.begin(), childGroupIndex.end());
-		for (auto groupTreeIndex : childGroupIndex) {
-		    auto searchGTIterator = indGroupMap.find(groupTreeIndex);
-		    if (searchGTIterator != indGroupMap.end()) {
-			auto gname = (searchGTIterator->second)->name();
-			auto gSeqNoItr = groupMapNameIndex.find(gname);
-			if (gSeqNoItr != groupMapNameIndex.end()) {
-			    iGrp[igrpCount] = (gSeqNoItr->second) + 1;
-			    igrpCount+=1;
-			}
-			else {
-			    std::cout << "AggregateGroupData, ChildGroups - Group name: groupMapNameIndex: " << gSeqNoItr->first << std::endl;
-			    throw std::invalid_argument( "Invalid group name" );
-			}
-		    }
-		    else {
-			std::cout << "AggregateGroupData, ChildGroups - GroupTreeIndex: " << groupTreeIndex << std::endl;
-			throw std::invalid_argument( "Invalid GroupTree index" );
-		    }
-		}
-	    }
+            if (numChildGroups > 0) {
+                // group has child groups, listed in the order they were
+                // entered in the group tree
+                const auto& seqIndex = step.tree.nameSeqIndMap();
+
+                std::vector<std::pair<std::size_t, std::size_t>> childGroups;
+                childGroups.reserve(numChildGroups);
+                for (auto i = treeIndex.child_offsets[node]; i < treeIndex.child_offsets[node + 1]; ++i) {
+                    const auto& childName = treeIndex.names[treeIndex.child_list[i]];
+                    const auto  childSlot = step.slotOf(childName);
+                    const auto  seq       = seqIndex.find(childName);
+
+                    childGroups.emplace_back((seq != seqIndex.end()) ? seq->second : childSlot, childSlot);
+                }
+                std::sort(childGroups.begin(), childGroups.end());
 
-	    //assign the number of child wells or child groups to
-	    // location nwgmax
-	    iGrp[nwgmax] =  (childGroups.size() == 0)
-                    ? childWells.size() : childGroups.size();
-
-	    // find the group type (well group (type 0) or node group (type 1) and store the type in  
-	    // location nwgmax + 26
-	    const auto grpType = groupType(sched, group, simStep);
-	    iGrp[nwgmax+26] = grpType;
-
-	    //find group level ("FIELD" is level 0) and store the level in
-	    //location nwgmax + 27
-	    const auto grpLevel = currentGroupLevel(sched, group, simStep);
-	    iGrp[nwgmax+27] = grpLevel;
-	    
-	    // set values for group probably connected to GCONPROD settings
-	    //
-	    if (group.name() != "FIELD")
-	    {
-		iGrp[nwgmax+ 5] = -1;
-		iGrp[nwgmax+12] = -1;
-		iGrp[nwgmax+17] = -1;
-		iGrp[nwgmax+22] = -1;
-
-		//assign values to group number (according to group sequence)
-		iGrp[nwgmax+88] = group.seqIndex();
-		iGrp[nwgmax+89] = group.seqIndex();
-		iGrp[nwgmax+95] = group.seqIndex();
-		iGrp[nwgmax+96] = group.seqIndex();
-	    }
-	    else
-	    {
-		//assign values to group number (according to group sequence)
-		iGrp[nwgmax+88] = ngmaxz;
-		iGrp[nwgmax+89] = ngmaxz;
-		iGrp[nwgmax+95] = ngmaxz;
-		iGrp[nwgmax+96] = ngmaxz;
-	    }
-	    //find parent group and store index of parent group in
-	    //location nwgmax + 28
-	    const auto& groupTree = sched.getGroupTree( simStep );
-	    const std::string& parent = groupTree.parent(group.name());
-	    if (group.name() == "FIELD")
-	      iGrp[nwgmax+28] = 0;
-	    else {
-		if (parent.size() == 0)
-		    throw std::invalid_argument("parent group does not exist" + group.name());
-		const auto itr = groupMapNameIndex.find(parent);
-		iGrp[nwgmax+28] = (itr->second)+1;
-	    }
+                for (const auto& child : childGroups) {
+                    iGrp[igrpCount] = child.second + 1;
+                    igrpCount+=1;
+                }
+            }
+            else {
+                // group has child wells
+                for (const auto& wellName : group.getWells(simStep)) {
+                    iGrp[igrpCount] = step.sched.getWell(wellName)->seqIndex() + 1;
+                    igrpCount+=1;
+                }
+            }
+
+            //assign the number of child wells or child groups to
+            // location nwgmax
+            iGrp[nwgmax] = igrpCount;
+
+            // find the group type (well group (type 0) or node group (type 1) and store the type in
+            // location nwgmax + 26
+            iGrp[nwgmax+26] = (numChildGroups > 0) ? 1 : 0;
+
+            //find group level ("FIELD" is level 0) and store the level in
+            //location nwgmax + 27
+            iGrp[nwgmax+27] = static_cast<int>(treeIndex.level[node]);
+
+            // set values for group probably connected to GCONPROD settings
+            //
+            if (group.name() != "FIELD")
+            {
+                iGrp[nwgmax+ 5] = -1;
+                iGrp[nwgmax+12] = -1;
+                iGrp[nwgmax+17] = -1;
+                iGrp[nwgmax+22] = -1;
+
+                //assign values to group number (according to group sequence)
+                iGrp[nwgmax+88] = group.seqIndex();
+                iGrp[nwgmax+89] = group.seqIndex();
+                iGrp[nwgmax+95] = group.seqIndex();
+                iGrp[nwgmax+96] = group.seqIndex();
+            }
+            else
+            {
+                //assign values to group number (according to group sequence)
+                iGrp[nwgmax+88] = ngmaxz;
+                iGrp[nwgmax+89] = ngmaxz;
+                iGrp[nwgmax+95] = ngmaxz;
+                iGrp[nwgmax+96] = ngmaxz;
+            }
+
+            //find parent group and store index of parent group in
+            //location nwgmax + 28
+            if (group.name() == "FIELD")
+                iGrp[nwgmax+28] = 0;
+            else {
+                const auto parent = treeIndex.parent[node];
+                if (parent == Opm::GroupTree::Index::npos)
+                    throw std::invalid_argument("parent group does not exist" + group.name());
+
+                iGrp[nwgmax+28] = step.slotOf(treeIndex.names[parent]) + 1;
+            }
         }
     } // Igrp
 
@@ -393,37 +334,24 @@ namespace {
 
         // here define the dynamic group quantities to be written to the restart file
         template <class XGrpArray>
-        void dynamicContrib(const std::vector<std::string>&      restart_group_keys,
-			    const std::vector<std::string>&      restart_field_keys,
-			    const std::map<std::string, size_t>& groupKeyToIndex,
-			    const std::map<std::string, size_t>& fieldKeyToIndex,
-			    const Opm::Group&                    group,
-			    const Opm::SummaryState&             sumState,
-			    const bool                           ecl_compatible_rst,
-			    XGrpArray&                           xGrp)
+        void dynamicContrib(const std::vector<std::string>&      keys,
+                            const std::map<std::string, size_t>& keyToIndex,
+                            const Opm::Group&                    group,
+                            const Opm::SummaryState&             sumState,
+                            XGrpArray&                           xGrp)
         {
-	  std::string groupName = group.name();
-	  const std::vector<std::string>& keys = (groupName == "FIELD")
-	  ? restart_field_keys : restart_group_keys;
-	  const std::map<std::string, size_t>& keyToIndex = (groupName == "FIELD")
-	  ? fieldKeyToIndex : groupKeyToIndex;
-
-	  for (const auto key : filter_cumulative(ecl_compatible_rst,keys)) {
-	      std::string compKey = (groupName == "FIELD")
-	      ? key : key + ":" + groupName;
-
-	      if (sumState.has(compKey)) {
-		  double keyValue = sumState.get(compKey);
-		  const auto itr = keyToIndex.find(key);
-		  xGrp[itr->second] = keyValue;
-	      }
-	      /*else {
-		  std::cout << "AggregateGroupData_compkey: " << compKey << std::endl;
-		  std::cout << "AggregateGroupData, empty " << std::endl;
-		  //throw std::invalid_argument("No such keyword: " + compKey);
-	    }*/
-	  }
-	}
+            const std::string& groupName = group.name();
+
+            for (const auto& key : keys) {
+                const std::string compKey = (groupName == "FIELD")
+                    ? key : key + ":" + groupName;
+
+                if (sumState.has(compKey)) {
+                    const auto itr = keyToIndex.find(key);
+                    xGrp[itr->second] = sumState.get(compKey);
+                }
+            }
+        }
     }
 
     namespace ZGrp {
@@ -501,6 +429,23 @@ AggregateGroupData(const std::vector<int>& inteHead)
 
 // ---------------------------------------------------------------------
 
+void
+Opm::RestartIO::Helpers::AggregateGroupData::
+reset(const std::vector<int>& inteHead)
+{
+    const auto numWindows = ngmaxz(inteHead);
+
+    this->iGroup_.reset({ numWindows }, { IGrp::entriesPerGroup(inteHead) });
+    this->sGroup_.reset({ numWindows }, { SGrp::entriesPerGroup(inteHead) });
+    this->xGroup_.reset({ numWindows }, { XGrp::entriesPerGroup(inteHead) });
+    this->zGroup_.reset({ numWindows }, { ZGrp::entriesPerGroup(inteHead) });
+
+    this->nWGMax_ = nwgmax(inteHead);
+    this->nGMaxz_ = ngmaxz(inteHead);
+}
+
+// ---------------------------------------------------------------------
+
 void
 Opm::RestartIO::Helpers::AggregateGroupData::
 captureDeclaredGroupData(const Opm::Schedule&                 sched,
@@ -513,51 +458,35 @@ captureDeclaredGroupData(const Opm::Schedule&                 sched,
 			 const Opm::SummaryState&             sumState,
 			 const std::vector<int>&              inteHead)
 {
-    const auto indexGroupMap = currentGroupMapIndexGroup(sched, simStep, inteHead);
-    const auto nameIndexMap = currentGroupMapNameIndex(sched, simStep, inteHead);
+    const auto step = StepGroups(sched, simStep, inteHead);
 
-    std::vector<const Opm::Group*> curGroups(ngmaxz(inteHead), nullptr);
+    // The cumulative quantities are filtered once, not once per group.
+    const auto groupKeys = XGrp::filter_cumulative(ecl_compatible_rst, restart_group_keys);
+    const auto fieldKeys = XGrp::filter_cumulative(ecl_compatible_rst, restart_field_keys);
 
-    auto it = indexGroupMap.begin();
-    while (it != indexGroupMap.end())
-	{
-	    curGroups[static_cast<int>(it->first)] = it->second;
-	    it++;
-	}
+    groupLoop(step.groups, [&step, &groupKeys, &fieldKeys, &groupKeyToIndex,
+                            &fieldKeyToIndex, &sumState, simStep, this]
+        (const Group& group, const std::size_t groupID) -> void
     {
-	groupLoop(curGroups, [sched, simStep, inteHead, this]
-            (const Group& group, const std::size_t groupID) -> void
-	    {
-		auto ig = this->iGroup_[groupID];
-		IGrp::staticContrib(sched, group, this->nWGMax_, this->nGMaxz_, simStep, ig, inteHead);
-	    });
-    }
+        // Define Static Contributions to IGrp Array.
+        auto ig = this->iGroup_[groupID];
+        IGrp::staticContrib(step, group, this->nWGMax_, this->nGMaxz_, simStep, ig);
 
-    // Define Static Contributions to SGrp Array.
-    groupLoop(curGroups,
-        [this](const Group& group, const std::size_t groupID) -> void
-    {
+        // Define Static Contributions to SGrp Array.
         auto sw = this->sGroup_[groupID];
         SGrp::staticContrib(sw);
-    });
 
-    // Define DynamicContributions to XGrp Array.
-    groupLoop(curGroups,
-        [restart_group_keys, restart_field_keys, groupKeyToIndex, fieldKeyToIndex, ecl_compatible_rst, sumState, this]
-	(const Group& group, const std::size_t groupID) -> void
-    {
+        // Define DynamicContributions to XGrp Array.
+        const auto isField = group.name() == "FIELD";
         auto xg = this->xGroup_[groupID];
-        XGrp::dynamicContrib( restart_group_keys, restart_field_keys, groupKeyToIndex, fieldKeyToIndex, group, sumState, ecl_compatible_rst, xg);
-    });
-    
-    // Define Static Contributions to ZGrp Array.
-    groupLoop(curGroups,
-        [this](const Group& group, const std::size_t groupID) -> void
-    {
+        XGrp::dynamicContrib(isField ? fieldKeys : groupKeys,
+                             isField ? fieldKeyToIndex : groupKeyToIndex,
+                             group, sumState, xg);
+
+        // Define Static Contributions to ZGrp Array.
         auto zw = this->zGroup_[groupID];
         zw[0] = group.name();
     });
-
 }
 
 // ---------------------------------------------------------------------
@@ -69,19 +69,61 @@ namespace {
         return inteHead[180];
     }
 
-    std::vector<std::size_t>
-    inflowSegmentsIndex(const Opm::WellSegments& segSet, std::size_t segIndex) {
-	auto segNumber  = segSet[segIndex].segmentNumber();
-	std::vector<std::size_t> inFlowSegNum;
+    /*
+      The inflow segments of every segment of a segment set, by segment
+      index and in index order, found in one pass over the segments.
+      The ISEG items and the segment ordering are then lookups in this
+      table, instead of a scan over all the segments for every segment.
+      The segment numbers of the set are assumed to be 1 ... size().
+    */
+    struct SegmentTopology {
+        explicit SegmentTopology(const Opm::WellSegments& segSet);
+
+        std::vector<std::vector<std::size_t>> inflow;
+        // the inflow segment on the same branch, 0 if none
+        std::vector<int> inflowCurBranch;
+        // the number of inflow segments on other branches
+        std::vector<int> inflowBranches;
+    };
+
+    SegmentTopology::SegmentTopology(const Opm::WellSegments& segSet)
+        : inflow         (segSet.size())
+        , inflowCurBranch(segSet.size(), 0)
+        , inflowBranches (segSet.size(), 0)
+    {
 	for (int ind = 0; ind < segSet.size(); ind++) {
-	    auto i_outletSeg = segSet[ind].outletSegment();
-	    if (segNumber == i_outletSeg) {
-		inFlowSegNum.push_back(ind);
+	    const auto outletInd = segSet.segmentNumberToIndex(segSet[ind].outletSegment());
+	    if (outletInd < 0) continue;
+
+	    inflow[outletInd].push_back(ind);
+	    if (segSet[ind].branchNumber() != segSet[outletInd].branchNumber()) {
+		inflowBranches[outletInd] += 1;
+	    }
+	    else if (inflowCurBranch[outletInd] == 0) {
+		inflowCurBranch[outletInd] = segSet[ind].segmentNumber();
+	    }
+	    else {
+		throw std::invalid_argument("Non-unique inflow segment in same branch, Well " + segSet.wellName()
+					    + ", segment " + std::to_string(segSet[outletInd].segmentNumber())
+					    + ", branch " + std::to_string(segSet[outletInd].branchNumber())
+					    + ", inflow segments " + std::to_string(inflowCurBranch[outletInd])
+					    + " and " + std::to_string(segSet[ind].segmentNumber()));
 	    }
 	}
-	return inFlowSegNum;
-    }    
-    
+    }
+
+    // the number of connections in every segment, by segment number
+    std::vector<int> connectionsPerSegment(const Opm::WellConnections& compSet, const Opm::WellSegments& segSet) {
+	std::vector<int> noConnections(segSet.size() + 1, 0);
+	for (const auto& conn : compSet) {
+	    const auto cSegment = conn.segment();
+	    if ((cSegment > 0) && (cSegment <= segSet.size())) {
+		noConnections[cSegment] += 1;
+	    }
+	}
+	return noConnections;
+    }
+
     Opm::RestartIO::Helpers::BranchSegmentPar
     getBranchSegmentParam(const Opm::WellSegments& segSet, const int branch)
     {
@@ -119,7 +161,8 @@ namespace {
 	}
 	return sNFOSN;
     }
-    std::vector<std::size_t> segmentOrder(const Opm::WellSegments& segSet, const std::size_t segIndex) {
+    std::vector<std::size_t> segmentOrder(const Opm::WellSegments& segSet, const SegmentTopology& topology,
+					  const std::size_t segIndex) {
 	std::vector<std::size_t> ordSegNumber;
 	std::vector<std::size_t> tempOrdVect;
 	std::vector<std::size_t> segIndCB;
@@ -131,7 +174,7 @@ namespace {
 	// loop down branch to find all segments in branch and number from "toe" to "heel"
 	while (newSInd < segSet.size()) {
 		endOrigBranch = true;
-		const auto iSInd = inflowSegmentsIndex(segSet, newSInd);
+		const auto& iSInd = topology.inflow[newSInd];
 		for (auto isi : iSInd )  {
 			auto inflowBranch = segSet[isi].branchNumber();
 			if (origBranchNo == inflowBranch) {
@@ -149,7 +192,7 @@ namespace {
 			}
 			else {
 			    // if inflow segment belongs to different branch, start new search
-			    auto nSOrd = segmentOrder(segSet, ind);
+			    auto nSOrd = segmentOrder(segSet, topology, ind);
 			    // copy the segments already found and indexed into the total ordered segment vector
 			    for (std::size_t indOS = 0; indOS < nSOrd.size(); indOS++) {
 				ordSegNumber.push_back(nSOrd[indOS]);
@@ -233,7 +276,8 @@ namespace {
 	
 	// find an ordered list of segments 
 	std::size_t segmentInd = 0;
-	auto orderedSegmentNo = segmentOrder(segSet, segmentInd);
+	const SegmentTopology topology(segSet);
+	auto orderedSegmentNo = segmentOrder(segSet, topology, segmentInd);
 	auto sNFOSN = segmentNoFromOrderedSegmentNo(segSet, orderedSegmentNo);
 	// loop over segments according to the ordered segments sequence which ensures that the segments alway are traversed in the from 
 	// inflow to outflow direction (a branch toe is the innermost inflow end)
@@ -287,117 +331,21 @@ namespace {
 	return firstSegNo;
     }
 
-    int noConnectionsSegment(const Opm::WellConnections& compSet,
-                             const Opm::WellSegments&    segSet,
-                             const std::size_t           segIndex)
-    {
-	auto segNumber  = segSet[segIndex].segmentNumber();
-	int noConnections = 0;
-	for (auto it : compSet) {
-	    auto cSegment = it.segment();
-	    if (segNumber == cSegment) {
-		noConnections+=1;
-	    }
-	}
-
-	return noConnections;
-    }
-
-    int sumConnectionsSegment(const Opm::WellConnections& compSet,
-                              const Opm::WellSegments&    segSet,
-                              const std::size_t           segIndex)
-    {
-      // This function returns (for a given segment) the sum of number of connections for each segment
-      // with lower segment index than the currnet segment
-      // If the segment contains no connections, the number returned is zero.
-	int sumConn = 0;
-	if (noConnectionsSegment(compSet, segSet, segIndex) > 0) {
-	// add up the number of connections for å segments with lower segment index than current segment
-	    	    auto segNumber  = segSet[segIndex].segmentNumber();
-	    for (int i_seg = 1; i_seg <= segNumber; i_seg++) {
-		auto  ind = segSet.segmentNumberToIndex(i_seg);
-		int addCon = (ind == static_cast<int>(segIndex)) ? 1 : noConnectionsSegment(compSet, segSet, ind);
-		sumConn += addCon;
-	    }
-	}
-	return sumConn;
-    }
-
-    int noInFlowBranches(const Opm::WellSegments& segSet, std::size_t segIndex) {
-	auto segNumber  = segSet[segIndex].segmentNumber();
-	auto branch     = segSet[segIndex].branchNumber();
-	int noIFBr = 0;
-	for (int ind = 0; ind < segSet.size(); ind++) {
-	    auto o_segNum = segSet[ind].outletSegment();
-	    auto i_branch = segSet[ind].branchNumber();
-	    if ((segNumber == o_segNum) && (branch != i_branch)){
-		noIFBr+=1;
-	    }
-	}
-	return noIFBr;
-    }
-    //find the number of inflow branch-segments (segments that has a branch) from the
-    // first segment to the current segment for segments that has at least one inflow branch
-    // Segments with no inflow branches get the value zero
-    int sumNoInFlowBranches(const Opm::WellSegments& segSet, std::size_t segIndex) {
-	int sumIFB = 0;
-	auto segNo =segSet[segIndex].segmentNumber();
-	while (segNo >=1) {
-	    auto segInd = segSet.segmentNumberToIndex(segNo);
-	    auto curBranch = segSet[segInd].branchNumber();
-	    const auto iSInd = inflowSegmentsIndex(segSet, segInd);
-	    for (auto inFlowInd : iSInd) {
-		auto inFlowBranch = segSet[inFlowInd].branchNumber();
-		// if inflow segment belongs to different branch add contribution
-		if (curBranch != inFlowBranch) {
-		    sumIFB+=1;
-		}
-	    }
-	    segNo-=1;
-	}
-	// check if the segment has inflow branches - if yes return sumIFB else return zero
-	return  (noInFlowBranches(segSet, segIndex) >= 1)
-		    ? sumIFB : 0;
-    }
-
-
-    int inflowSegmentCurBranch(const Opm::WellSegments& segSet, std::size_t segIndex) {
-	auto branch = segSet[segIndex].branchNumber();
-	auto segNumber  = segSet[segIndex].segmentNumber();
-	int inFlowSegNum = 0;
-	for (int ind = 0; ind < segSet.size(); ind++) {
-	    auto i_segNum = segSet[ind].segmentNumber();
-	    auto i_branch = segSet[ind].branchNumber();
-	    auto i_outFlowSeg = segSet[ind].outletSegment();
-	    if ((branch == i_branch) && (segNumber == i_outFlowSeg)) {
-		if (inFlowSegNum == 0) {
-		    inFlowSegNum = i_segNum;
-		}
-		else {
-		  std::cout << "Non-unique inflow segment in same branch, Well: " << segSet.wellName() << std::endl;
-		  std::cout <<  "Segment number: " << segNumber << std::endl;
-		  std::cout <<  "Branch number: " << branch << std::endl;
-		  std::cout <<  "Inflow segment number 1: " << inFlowSegNum << std::endl;
-		  std::cout <<  "Inflow segment number 2: " << segSet[ind].segmentNumber() << std::endl;
-		  throw std::invalid_argument("Non-unique inflow segment in same branch, Well " + segSet.wellName());
-		}
-	    }
-	}
-	return inFlowSegNum;
-    }
-
+    /// The multi-segment wells fill disjoint windows of the restart
+    /// arrays, so mswOp is invoked in parallel.
     template <typename MSWOp>
     void MSWLoop(const std::vector<const Opm::Well*>& wells,
                   MSWOp&&                             mswOp)
     {
-        auto mswID = std::size_t{0};
-        for (const auto* well : wells) {
-            mswID += 1;
+        Opm::RestartIO::Helpers::parallelFor(wells.size(),
+            [&wells, &mswOp](const std::size_t mswID) -> void
+        {
+            const auto* well = wells[mswID];
 
-            if (well == nullptr) { continue; }
+            if (well == nullptr) { return; }
 
-            mswOp(*well, mswID - 1);
-        }
+            mswOp(*well, mswID);
+        });
     }
 
     namespace ISeg {
@@ -433,19 +381,28 @@ namespace {
 		const auto& completionSet = well.getConnections(rptStep);
 		const auto& noElmSeg      = nisegz(inteHead);
 		std::size_t segmentInd = 0;
-		auto orderedSegmentNo = segmentOrder(welSegSet, segmentInd);
+		const SegmentTopology topology(welSegSet);
+		const auto noConnections = connectionsPerSegment(completionSet, welSegSet);
+		auto orderedSegmentNo = segmentOrder(welSegSet, topology, segmentInd);
+		// running sums over the segment numbers of the inflow branches and the connections
+		int sumIFB = 0;
+		int sumConn = 0;
 		for (int segNumber = 1; segNumber <= welSegSet.size(); segNumber++) {
 		    auto ind = welSegSet.segmentNumberToIndex(segNumber);
 		    auto iS = (segNumber-1)*noElmSeg;
+		    sumIFB += topology.inflowBranches[ind];
 		    iSeg[iS + 0] = orderedSegmentNo[ind];
 		    iSeg[iS + 1] = welSegSet[ind].outletSegment();
-		    iSeg[iS + 2] = inflowSegmentCurBranch(welSegSet, ind);
+		    iSeg[iS + 2] = topology.inflowCurBranch[ind];
 		    iSeg[iS + 3] = welSegSet[ind].branchNumber();
-		    iSeg[iS + 4] = noInFlowBranches(welSegSet, ind);
-		    iSeg[iS + 5] = sumNoInFlowBranches(welSegSet, ind);
-		    iSeg[iS + 6] = noConnectionsSegment(completionSet, welSegSet, ind);
-		    iSeg[iS + 7] = sumConnectionsSegment(completionSet, welSegSet, ind);
+		    iSeg[iS + 4] = topology.inflowBranches[ind];
+		    // the number of inflow branches to the segments up to this one, zero without inflow branches
+		    iSeg[iS + 5] = (topology.inflowBranches[ind] >= 1) ? sumIFB : 0;
+		    iSeg[iS + 6] = noConnections[segNumber];
+		    // the connections of the segments before this one plus one, zero without connections
+		    iSeg[iS + 7] = (noConnections[segNumber] > 0) ? sumConn + 1 : 0;
 		    iSeg[iS + 8] = iSeg[iS+0];
+		    sumConn += noConnections[segNumber];
 		}
 	    }
 	    else {
@@ -662,7 +619,7 @@ namespace {
         {
 	    if (well.isMultiSegment(rptStep)) {
 		//
-		auto welSegSet = well.getWellSegments(rptStep);
+		const auto& welSegSet = well.getWellSegments(rptStep);
 		auto branches = SegmentSetBranches(welSegSet);
 		for (auto it = branches.begin()+1; it != branches.end(); it++){
 		    iLBS[*it-2] = firstSegmentInBranch(welSegSet, *it);
@@ -701,7 +658,7 @@ namespace {
         {
 	    if (well.isMultiSegment(rptStep)) {
 		//
-		auto welSegSet = well.getWellSegments(rptStep);
+		const auto& welSegSet = well.getWellSegments(rptStep);
 		auto branches = SegmentSetBranches(welSegSet);
 		auto noElmBranch = nilbrz(inteHead);
 		for (auto it = branches.begin(); it != branches.end(); it++){
@@ -734,6 +691,20 @@ AggregateMSWData(const std::vector<int>& inteHead)
 
 // ---------------------------------------------------------------------
 
+void
+Opm::RestartIO::Helpers::AggregateMSWData::
+reset(const std::vector<int>& inteHead)
+{
+    const auto numWindows = nswlmx(inteHead);
+
+    this->iSeg_.reset({ numWindows }, { ISeg::entriesPerMSW(inteHead) });
+    this->rSeg_.reset({ numWindows }, { RSeg::entriesPerMSW(inteHead) });
+    this->iLBS_.reset({ numWindows }, { ILBS::entriesPerMSW(inteHead) });
+    this->iLBR_.reset({ numWindows }, { ILBR::entriesPerMSW(inteHead) });
+}
+
+// ---------------------------------------------------------------------
+
 void
 Opm::RestartIO::Helpers::AggregateMSWData::
 captureDeclaredMSWData(const Schedule&         sched,
@@ -74,19 +74,21 @@ namespace {
         return s.substr(b, e - b + 1);
     }
 
+    /// Wells are independent and fill disjoint windows of the
+    /// restart arrays, so wellOp is invoked in parallel.
     template <typename WellOp>
     void wellLoop(const std::vector<const Opm::Well*>& wells,
                   WellOp&&                             wellOp)
     {
-        for (auto nWell = wells.size(), wellID = 0*nWell;
-             wellID < nWell; ++wellID)
+        Opm::RestartIO::Helpers::parallelFor(wells.size(),
+            [&wells, &wellOp](const std::size_t wellID) -> void
         {
             const auto* well = wells[wellID];
 
-            if (well == nullptr) { continue; }
+            if (well == nullptr) { return; }
 
             wellOp(*well, wellID);
-        }
+        });
     }
 
     namespace IWell {
@@ -807,6 +809,22 @@ AggregateWellData(const std::vector<int>& inteHead)
 
 // ---------------------------------------------------------------------
 
+void
+Opm::RestartIO::Helpers::AggregateWellData::
+reset(const std::vector<int>& inteHead)
+{
+    const auto numWindows = numWells(inteHead);
+
+    this->iWell_.reset({ numWindows }, { IWell::entriesPerWell(inteHead) });
+    this->sWell_.reset({ numWindows }, { SWell::entriesPerWell(inteHead) });
+    this->xWell_.reset({ numWindows }, { XWell::entriesPerWell(inteHead) });
+    this->zWell_.reset({ numWindows }, { ZWell::entriesPerWell(inteHead) });
+
+    this->nWGMax_ = maxNumGroups(inteHead);
+}
+
+// ---------------------------------------------------------------------
+
 void
 Opm::RestartIO::Helpers::AggregateWellData::
 captureDeclaredWellData(const Schedule&   sched,
@@ -821,15 +839,28 @@ captureDeclaredWellData(const Schedule&   sched,
     {
         //const auto grpNames = groupNames(sched.getGroups());
 	const auto groupMapNameIndex = IWell::currentGroupMapNameIndex(sched, sim_step, inteHead);
-        auto msWellID       = std::size_t{0};
+
+        // 1-based index of each well among the multi-segment wells,
+        // computed up front as the wells are processed in parallel.
+        auto msWellID = std::vector<std::size_t>(wells.size(), 0);
+        {
+            auto msw = std::size_t{0};
+            for (auto nWell = wells.size(), wellID = 0*nWell;
+                 wellID < nWell; ++wellID)
+            {
+                if (wells[wellID] == nullptr) { continue; }
+
+                msw += wells[wellID]->isMultiSegment(sim_step);
+                msWellID[wellID] = msw;
+            }
+        }
 
         wellLoop(wells, [&groupMapNameIndex, &msWellID, sim_step, this]
             (const Well& well, const std::size_t wellID) -> void
         {
-            msWellID += well.isMultiSegment(sim_step);  // 1-based index.
             auto iw   = this->iWell_[wellID];
 
-            IWell::staticContrib(well, msWellID, groupMapNameIndex,
+            IWell::staticContrib(well, msWellID[wellID], groupMapNameIndex,
                                  this->nWGMax_, sim_step, iw);
         });
     }
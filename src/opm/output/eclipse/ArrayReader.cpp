@@ -0,0 +1,433 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/output/eclipse/ArrayReader.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+namespace {
+
+    using Entry = Opm::RestartIO::Helpers::ArrayReader::Entry;
+
+    const std::size_t headerSize = 4 + 16 + 4;
+    const std::size_t markerSize = 4;
+    const std::size_t cacheShards = 16;
+
+    std::uint32_t get32(const char* src) {
+        std::uint32_t value = 0;
+        for (int byte = 0; byte < 4; byte++)
+            value = (value << 8) | static_cast<unsigned char>(src[byte]);
+        return value;
+    }
+
+    std::uint64_t get64(const char* src) {
+        std::uint64_t value = 0;
+        for (int byte = 0; byte < 8; byte++)
+            value = (value << 8) | static_cast<unsigned char>(src[byte]);
+        return value;
+    }
+
+    std::size_t elementSize(const std::string& type) {
+        if (type == "INTE" || type == "REAL" || type == "LOGI")
+            return 4;
+
+        if (type == "DOUB" || type == "CHAR")
+            return 8;
+
+        if (type == "MESS")
+            return 0;
+
+        if (type[0] == 'C' && type[1] == '0' && std::isdigit(type[2]) && std::isdigit(type[3]))
+            return 10 * (type[2] - '0') + (type[3] - '0');
+
+        throw std::runtime_error("Unknown array type '" + type + "'");
+    }
+
+    /* Character arrays are written in records of 105 elements. */
+    std::size_t blockElements(const std::string& type) {
+        return (type[0] == 'C') ? 105 : 1000;
+    }
+
+    std::size_t dataBytes(const Entry& entry) {
+        const std::size_t block = blockElements(entry.type);
+        const std::size_t blocks = (entry.size + block - 1) / block;
+        return entry.size * elementSize(entry.type) + blocks * 2 * markerSize;
+    }
+
+    std::string trimmed(const char* begin, std::size_t size) {
+        while (size > 0 && begin[size - 1] == ' ')
+            size--;
+
+        return std::string(begin, size);
+    }
+
+
+    /*
+      The values of an array, read in one go and with the record markers
+      removed.
+    */
+    std::vector<char> readValues(const std::string& filename, const Entry& entry) {
+        const std::size_t element = elementSize(entry.type);
+        const std::size_t block = blockElements(entry.type);
+
+        std::vector<char> data(dataBytes(entry));
+        std::ifstream stream(filename, std::ios::binary);
+        stream.seekg(entry.offset);
+        stream.read(data.data(), data.size());
+        if (!stream)
+            throw std::runtime_error("Reading " + entry.keyword + " from " + filename + " failed");
+
+        std::size_t src = 0;
+        std::size_t dst = 0;
+        for (std::size_t first = 0; first < entry.size; first += block) {
+            const std::size_t bytes = std::min(block, entry.size - first) * element;
+            if (get32(&data[src]) != bytes || get32(&data[src + markerSize + bytes]) != bytes)
+                throw std::runtime_error("Corrupt record in " + entry.keyword + " of " + filename);
+
+            std::memmove(&data[dst], &data[src + markerSize], bytes);
+            src += bytes + 2 * markerSize;
+            dst += bytes;
+        }
+
+        data.resize(dst);
+        return data;
+    }
+
+    void decode(const std::vector<char>& data, const Entry&, std::vector<int>& values) {
+        values.resize(data.size() / 4);
+        for (std::size_t index = 0; index < values.size(); index++)
+            values[index] = static_cast<std::int32_t>(get32(&data[4 * index]));
+    }
+
+    void decode(const std::vector<char>& data, const Entry& entry, std::vector<double>& values) {
+        if (entry.type == "DOUB") {
+            values.resize(data.size() / 8);
+            for (std::size_t index = 0; index < values.size(); index++) {
+                const std::uint64_t bits = get64(&data[8 * index]);
+                std::memcpy(&values[index], &bits, sizeof bits);
+            }
+        } else {
+            values.resize(data.size() / 4);
+            for (std::size_t index = 0; index < values.size(); index++) {
+                const std::uint32_t bits = get32(&data[4 * index]);
+                float value;
+                std::memcpy(&value, &bits, sizeof value);
+                values[index] = value;
+            }
+        }
+    }
+
+    void decode(const std::vector<char>& data, const Entry& entry, std::vector<std::string>& values) {
+        const std::size_t element = elementSize(entry.type);
+        values.resize(entry.size);
+        for (std::size_t index = 0; index < values.size(); index++)
+            values[index] = trimmed(&data[element * index], element);
+    }
+
+    template <typename T>
+    std::size_t memoryUse(const std::vector<T>& values) {
+        return values.size() * sizeof(T);
+    }
+
+    std::size_t memoryUse(const std::vector<std::string>& values) {
+        std::size_t bytes = values.size() * sizeof(std::string);
+        for (const auto& value : values)
+            bytes += value.capacity();
+        return bytes;
+    }
+
+
+    /*
+      The decoded arrays of all the readers, keyed by the identity of the
+      index of the file and the position of the array in it.  Every shard
+      is an LRU list with its own lock and its share of the budget.
+    */
+    struct CacheKey {
+        std::uint64_t file;
+        std::size_t index;
+
+        bool operator==(const CacheKey& other) const {
+            return this->file == other.file && this->index == other.index;
+        }
+    };
+
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& key) const {
+            return static_cast<std::size_t>(key.file * 1000003) ^ key.index;
+        }
+    };
+
+    class ArrayCache {
+    public:
+        std::shared_ptr<const void> find(const CacheKey& key) {
+            auto& shard = this->shard(key);
+            std::lock_guard<std::mutex> guard(shard.lock);
+
+            auto iter = shard.values.find(key);
+            if (iter == shard.values.end())
+                return nullptr;
+
+            shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.position);
+            return iter->second.data;
+        }
+
+        /*
+          Returns the array which is in the cache after the insert, which
+          is the one of another thread if it came first.
+        */
+        std::shared_ptr<const void> insert(const CacheKey& key, std::shared_ptr<const void> data, std::size_t bytes) {
+            const std::size_t limit = this->budget.load() / cacheShards;
+            if (bytes > limit)
+                return data;
+
+            auto& shard = this->shard(key);
+            std::lock_guard<std::mutex> guard(shard.lock);
+
+            auto iter = shard.values.find(key);
+            if (iter != shard.values.end())
+                return iter->second.data;
+
+            shard.lru.push_front(key);
+            shard.values[key] = Value{ data, bytes, shard.lru.begin() };
+            shard.bytes += bytes;
+            evict(shard, limit);
+            return data;
+        }
+
+        void setBudget(std::size_t bytes) {
+            this->budget.store(bytes);
+            for (auto& shard : this->shards) {
+                std::lock_guard<std::mutex> guard(shard.lock);
+                evict(shard, bytes / cacheShards);
+            }
+        }
+
+    private:
+        struct Value {
+            std::shared_ptr<const void> data;
+            std::size_t bytes;
+            std::list<CacheKey>::iterator position;
+        };
+
+        struct Shard {
+            std::mutex lock;
+            std::list<CacheKey> lru;
+            std::unordered_map<CacheKey, Value, CacheKeyHash> values;
+            std::size_t bytes = 0;
+        };
+
+        Shard& shard(const CacheKey& key) {
+            return this->shards[CacheKeyHash()(key) % cacheShards];
+        }
+
+        static void evict(Shard& shard, std::size_t limit) {
+            while (shard.bytes > limit && !shard.lru.empty()) {
+                auto iter = shard.values.find(shard.lru.back());
+                shard.bytes -= iter->second.bytes;
+                shard.values.erase(iter);
+                shard.lru.pop_back();
+            }
+        }
+
+        std::array<Shard, cacheShards> shards;
+        std::atomic<std::size_t> budget{ Opm::RestartIO::Helpers::ArrayReader::defaultCacheBudget };
+    };
+
+    /*
+      Leaked, like the other process wide tables, so that readers in
+      static objects can be used during static destruction.
+    */
+    ArrayCache& arrayCache() {
+        static ArrayCache* cache = new ArrayCache();
+        return *cache;
+    }
+
+    const char* const intTypes[] = { "INTE", "LOGI", nullptr };
+    const char* const doubleTypes[] = { "REAL", "DOUB", nullptr };
+    const char* const stringTypes[] = { "CHAR", "C0", nullptr };
+
+}
+
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    const std::size_t ArrayReader::defaultCacheBudget;
+
+    struct ArrayReader::Index
+    {
+        std::string filename;
+        std::uintmax_t fileSize;
+        std::time_t modified;
+        std::uint64_t id;
+
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, std::vector<std::size_t>> positions;
+    };
+
+
+    ArrayReader::ArrayReader(const std::string& filename)
+    {
+        static std::mutex lock;
+        static std::unordered_map<std::string, std::shared_ptr<const Index>> indices;
+        static std::atomic<std::uint64_t> next_id{ 0 };
+
+        boost::system::error_code ec;
+        const auto path = boost::filesystem::absolute(filename).string();
+        const auto file_size = boost::filesystem::file_size(path, ec);
+        const auto modified = ec ? std::time_t(0) : boost::filesystem::last_write_time(path, ec);
+        if (ec)
+            throw std::invalid_argument("Unable to open " + filename);
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            auto iter = indices.find(path);
+            if (iter != indices.end()
+                && iter->second->fileSize == file_size
+                && iter->second->modified == modified)
+            {
+                this->index = iter->second;
+                return;
+            }
+        }
+
+        // Scan the headers without holding the lock; two threads opening
+        // a new file at the same time both scan it.
+        auto index = std::make_shared<Index>();
+        index->filename = path;
+        index->fileSize = file_size;
+        index->modified = modified;
+        index->id = next_id++;
+
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            throw std::invalid_argument("Unable to open " + filename);
+
+        std::size_t offset = 0;
+        while (offset < file_size) {
+            char header[headerSize];
+            stream.seekg(offset);
+            stream.read(header, headerSize);
+            if (!stream || get32(header) != 16 || get32(header + 20) != 16)
+                throw std::runtime_error(filename + " is not an unformatted ECLIPSE file");
+
+            Entry entry;
+            entry.keyword = trimmed(header + 4, 8);
+            entry.size = get32(header + 12);
+            entry.type = std::string(header + 16, 4);
+            entry.offset = offset + headerSize;
+
+            offset = entry.offset + dataBytes(entry);
+            if (offset > file_size)
+                throw std::runtime_error(filename + " is truncated in " + entry.keyword);
+
+            index->positions[entry.keyword].push_back(index->entries.size());
+            index->entries.push_back(std::move(entry));
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        indices[path] = index;
+        this->index = index;
+    }
+
+
+    const std::string& ArrayReader::filename() const {
+        return this->index->filename;
+    }
+
+
+    const std::vector<ArrayReader::Entry>& ArrayReader::entries() const {
+        return this->index->entries;
+    }
+
+
+    std::size_t ArrayReader::count(const std::string& keyword) const {
+        const auto iter = this->index->positions.find(keyword);
+        return (iter == this->index->positions.end()) ? 0 : iter->second.size();
+    }
+
+
+    std::size_t ArrayReader::find(const std::string& keyword, std::size_t occurrence) const {
+        if (occurrence >= this->count(keyword))
+            throw std::invalid_argument("No occurrence " + std::to_string(occurrence) + " of "
+                                        + keyword + " in " + this->filename());
+
+        return this->index->positions.at(keyword)[occurrence];
+    }
+
+
+    template <typename T>
+    std::shared_ptr<const std::vector<T>>
+    ArrayReader::get(std::size_t index, const char* const* types) const {
+        const auto& entry = this->entries().at(index);
+
+        bool valid = false;
+        for (auto type = types; *type != nullptr; type++)
+            valid |= (entry.type.compare(0, std::strlen(*type), *type) == 0);
+
+        if (!valid)
+            throw std::invalid_argument("The array " + entry.keyword + " of "
+                                        + this->filename() + " has the wrong type " + entry.type);
+
+        const CacheKey key{ this->index->id, index };
+        auto& cache = arrayCache();
+        auto cached = cache.find(key);
+        if (cached)
+            return std::static_pointer_cast<const std::vector<T>>(cached);
+
+        auto values = std::make_shared<std::vector<T>>();
+        decode(readValues(this->filename(), entry), entry, *values);
+
+        const auto bytes = memoryUse(*values);
+        return std::static_pointer_cast<const std::vector<T>>(cache.insert(key, std::move(values), bytes));
+    }
+
+
+    std::shared_ptr<const std::vector<int>> ArrayReader::getInt(std::size_t index) const {
+        return this->get<int>(index, intTypes);
+    }
+
+
+    std::shared_ptr<const std::vector<double>> ArrayReader::getDouble(std::size_t index) const {
+        return this->get<double>(index, doubleTypes);
+    }
+
+
+    std::shared_ptr<const std::vector<std::string>> ArrayReader::getString(std::size_t index) const {
+        return this->get<std::string>(index, stringTypes);
+    }
+
+
+    void ArrayReader::setCacheBudget(std::size_t bytes) {
+        arrayCache().setBudget(bytes);
+    }
+
+}}} // Opm::RestartIO::Helpers
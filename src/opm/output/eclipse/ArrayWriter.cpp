@@ -0,0 +1,456 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/output/eclipse/ArrayWriter.hpp>
+
+#include <opm/common/utility/ParallelChunks.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using Type = Opm::RestartIO::Helpers::ArrayWriter::Type;
+
+    const std::size_t recordSize = 1000;
+    const std::size_t headerSize = 4 + 16 + 4;
+    const std::size_t markerSize = 4;
+
+    /* The longest text of a header line and of a formatted value,
+       including the separators. */
+    const std::size_t formattedHeaderSize = 31;
+    const std::size_t maxFormattedValue = 32;
+    const std::size_t maxRecordBytes = recordSize * (maxFormattedValue + 1);
+
+    /* Formatted arrays with at least this many records are encoded in
+       parallel. */
+    const std::size_t minParallelRecords = 16;
+
+
+    const char* typeName(Type type) {
+        switch (type) {
+        case Type::Integer: return "INTE";
+        case Type::Float:   return "REAL";
+        default:            return "DOUB";
+        }
+    }
+
+    std::size_t columns(Type type) {
+        switch (type) {
+        case Type::Integer: return 6;
+        case Type::Float:   return 4;
+        default:            return 3;
+        }
+    }
+
+
+    // ---------------------------------------------------------------
+    // Unformatted encoding: big-endian values.
+
+    void put32(char* dst, std::uint32_t value) {
+        for (int byte = 0; byte < 4; byte++)
+            dst[byte] = static_cast<char>((value >> (24 - 8 * byte)) & 0xFF);
+    }
+
+    void put64(char* dst, std::uint64_t value) {
+        for (int byte = 0; byte < 8; byte++)
+            dst[byte] = static_cast<char>((value >> (56 - 8 * byte)) & 0xFF);
+    }
+
+    char* putBinary(char* dst, int value, Type) {
+        put32(dst, static_cast<std::uint32_t>(value));
+        return dst + 4;
+    }
+
+    char* putBinary(char* dst, double value, Type type) {
+        if (type == Type::Double) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            put64(dst, bits);
+            return dst + 8;
+        }
+
+        const float fvalue = static_cast<float>(value);
+        std::uint32_t bits;
+        std::memcpy(&bits, &fvalue, sizeof bits);
+        put32(dst, bits);
+        return dst + 4;
+    }
+
+    char* putBinary(char* dst, float value, Type) {
+        return putBinary(dst, static_cast<double>(value), Type::Float);
+    }
+
+
+    // ---------------------------------------------------------------
+    // Formatted encoding, the same text as ERT's fprintf() formats
+    // " %11d", "  %11.8fE%+03d" and "  %17.14fD%+03d".
+
+    /* Right aligned decimal digits of value in [dst, dst + width). */
+    void putDigits(char* dst, std::size_t width, std::uint64_t value) {
+        for (std::size_t pos = width; pos-- > 0;) {
+            dst[pos] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    char* putInt(char* dst, int value) {
+        char digits[12];
+        std::size_t len = 0;
+        std::uint64_t abs_value = value < 0 ? -static_cast<std::int64_t>(value) : value;
+        do {
+            digits[len++] = static_cast<char>('0' + abs_value % 10);
+            abs_value /= 10;
+        } while (abs_value > 0);
+        if (value < 0)
+            digits[len++] = '-';
+
+        *dst++ = ' ';
+        for (std::size_t pad = len; pad < 11; pad++)
+            *dst++ = ' ';
+        while (len > 0)
+            *dst++ = digits[--len];
+
+        return dst;
+    }
+
+    /* The powers of ten as computed by std::pow(), for the scaling of
+       the values into [0.1, 1) exactly as ERT does it. */
+    const int maxPow10 = 350;
+
+    const std::array<double, 2 * maxPow10 + 1>& powersOfTen() {
+        static const auto powers = []() {
+            std::array<double, 2 * maxPow10 + 1> p;
+            for (int exp = -maxPow10; exp <= maxPow10; exp++)
+                p[exp + maxPow10] = std::pow(10.0, exp);
+            return p;
+        }();
+        return powers;
+    }
+
+    double pow10(double exp) {
+        if (std::fabs(exp) <= maxPow10)
+            return powersOfTen()[static_cast<int>(exp) + maxPow10];
+
+        return std::pow(10.0, exp);
+    }
+
+    /*
+      Rounds a, in [0, 1], to an integer number of units of 10^-digits
+      as printf() does: the exact product is a*scale + err, and exact
+      ties go to even.
+    */
+    std::uint64_t roundScaled(double a, double scale) {
+        const double p = a * scale;
+        const double err = std::fma(a, scale, -p);
+        const double floor_p = std::floor(p);
+        const double diff = (p - floor_p) - 0.5;
+
+        auto q = static_cast<std::uint64_t>(floor_p);
+        if (diff > 0 || (diff == 0 && (err > 0 || (err == 0 && (q & 1)))))
+            q++;
+
+        return q;
+    }
+
+    char* putReal(char* dst, double x, bool is_double) {
+        const int digits = is_double ? 14 : 8;
+        const char exp_char = is_double ? 'D' : 'E';
+
+        double pow_x = std::ceil(std::log10(std::fabs(x)));
+        double arg_x = x / pow10(pow_x);
+        if (x != 0.0) {
+            if (std::fabs(arg_x) == 1.0) {
+                arg_x *= 0.10;
+                pow_x += 1;
+            }
+        } else {
+            arg_x = 0.0;
+            pow_x = 0.0;
+        }
+
+        if (!std::isfinite(x)) {
+            const char* fmt = is_double ? "  %17.14fD%+03d" : "  %11.8fE%+03d";
+            const int len = std::snprintf(dst, maxFormattedValue + 1, fmt, arg_x, static_cast<int>(pow_x));
+            return dst + std::min<std::size_t>(len, maxFormattedValue);
+        }
+
+        const double scale = is_double ? 1e14 : 1e8;
+        const std::uint64_t unit = is_double ? 100000000000000ULL : 100000000ULL;
+        const std::uint64_t q = roundScaled(std::fabs(arg_x), scale);
+
+        *dst++ = ' ';
+        *dst++ = ' ';
+        *dst++ = (arg_x < 0) ? '-' : ' ';
+        *dst++ = static_cast<char>('0' + q / unit);
+        *dst++ = '.';
+        putDigits(dst, digits, q % unit);
+        dst += digits;
+
+        const int exponent = static_cast<int>(pow_x);
+        *dst++ = exp_char;
+        *dst++ = (exponent < 0) ? '-' : '+';
+        const unsigned int abs_exp = std::abs(exponent);
+        const std::size_t exp_digits = abs_exp >= 100 ? 3 : 2;
+        putDigits(dst, exp_digits, abs_exp);
+        return dst + exp_digits;
+    }
+
+    char* putText(char* dst, int value, Type) {
+        return putInt(dst, value);
+    }
+
+    char* putText(char* dst, double value, Type type) {
+        if (type == Type::Double)
+            return putReal(dst, value, true);
+
+        return putReal(dst, static_cast<float>(value), false);
+    }
+
+    char* putText(char* dst, float value, Type) {
+        return putReal(dst, value, false);
+    }
+
+
+    // ---------------------------------------------------------------
+
+    std::size_t encodeHeader(char* dst, const std::string& keyword, Type type,
+                             std::size_t size, bool formatted) {
+        if (formatted) {
+            char* pos = dst;
+            *pos++ = ' ';
+            *pos++ = '\'';
+            std::memset(pos, ' ', 8);
+            std::memcpy(pos, keyword.data(), keyword.size());
+            pos += 8;
+            *pos++ = '\'';
+            pos = putInt(pos, static_cast<int>(size));
+            *pos++ = ' ';
+            *pos++ = '\'';
+            std::memcpy(pos, typeName(type), 4);
+            pos += 4;
+            *pos++ = '\'';
+            *pos++ = '\n';
+            return pos - dst;
+        }
+
+        put32(dst, 16);
+        std::memset(dst + 4, ' ', 8);
+        std::memcpy(dst + 4, keyword.data(), keyword.size());
+        put32(dst + 12, static_cast<std::uint32_t>(size));
+        std::memcpy(dst + 16, typeName(type), 4);
+        put32(dst + 20, 16);
+        return headerSize;
+    }
+
+    template <typename T>
+    std::size_t encodeRecord(char* dst, const T* values, std::size_t n, Type type, bool formatted) {
+        if (formatted) {
+            const std::size_t cols = columns(type);
+            char* pos = dst;
+            for (std::size_t index = 0; index < n; index++) {
+                pos = putText(pos, values[index], type);
+                if ((index + 1) % cols == 0 || index + 1 == n)
+                    *pos++ = '\n';
+            }
+            return pos - dst;
+        }
+
+        char* pos = dst + markerSize;
+        for (std::size_t index = 0; index < n; index++)
+            pos = putBinary(pos, values[index], type);
+
+        const auto bytes = static_cast<std::uint32_t>(pos - dst - markerSize);
+        put32(dst, bytes);
+        put32(pos, bytes);
+        return pos + markerSize - dst;
+    }
+
+    /* The values of one record, passed through the conversion if any. */
+    const double* convertRecord(const double* values, std::size_t n,
+                                const Opm::RestartIO::Helpers::ArrayWriter::Convert* convert,
+                                double* chunk) {
+        if (!convert)
+            return values;
+
+        (*convert)(values, chunk, n);
+        return chunk;
+    }
+
+    template <typename T>
+    const T* convertRecord(const T* values, std::size_t,
+                           const Opm::RestartIO::Helpers::ArrayWriter::Convert*,
+                           double*) {
+        return values;
+    }
+
+    /* The text of the records [first, last) of a formatted array. */
+    template <typename T>
+    std::vector<char> encodeRecords(const T* data, std::size_t size,
+                                    std::size_t first, std::size_t last, Type type,
+                                    const Opm::RestartIO::Helpers::ArrayWriter::Convert* convert) {
+        std::vector<char> text((last - first) * maxRecordBytes);
+        std::size_t used = 0;
+        double chunk[recordSize];
+        for (std::size_t record = first; record < last; record++) {
+            const std::size_t begin = record * recordSize;
+            const std::size_t n = std::min(recordSize, size - begin);
+            const auto* values = convertRecord(data + begin, n, convert, chunk);
+            used += encodeRecord(text.data() + used, values, n, type, true);
+        }
+
+        text.resize(used);
+        return text;
+    }
+
+}
+
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    const std::size_t ArrayWriter::blockSize;
+    const std::size_t ArrayWriter::defaultBufferSize;
+
+
+    ArrayWriter::ArrayWriter(std::FILE* stream_arg, bool formatted_arg, std::size_t bufferSize) :
+        stream(stream_arg),
+        is_formatted(formatted_arg),
+        // Room for at least one full record and the remainder of a block.
+        buffer(std::max(bufferSize, blockSize + maxRecordBytes))
+    {
+        if (!this->stream)
+            throw std::invalid_argument("An array writer needs an open stream");
+    }
+
+
+    ArrayWriter::~ArrayWriter() {
+        try {
+            this->flush();
+        } catch (...) {
+        }
+    }
+
+
+    bool ArrayWriter::formatted() const {
+        return this->is_formatted;
+    }
+
+
+    void ArrayWriter::flush() {
+        this->writeOut(this->used);
+    }
+
+
+    void ArrayWriter::writeOut(std::size_t bytes) {
+        if (bytes == 0)
+            return;
+
+        if (std::fwrite(this->buffer.data(), 1, bytes, this->stream) != bytes)
+            throw std::runtime_error("Writing an ECLIPSE array failed");
+
+        std::memmove(this->buffer.data(), this->buffer.data() + bytes, this->used - bytes);
+        this->used -= bytes;
+    }
+
+
+    /*
+      Makes room for up to the given number of bytes at the end of the
+      buffer; the caller adds the number of bytes actually used. A full
+      buffer is written out in whole blocks, the remainder, less than
+      one block, is moved to the front.
+    */
+    char* ArrayWriter::reserve(std::size_t bytes) {
+        if (this->used + bytes > this->buffer.size())
+            this->writeOut(this->used - this->used % blockSize);
+
+        return this->buffer.data() + this->used;
+    }
+
+
+    template <typename T>
+    void ArrayWriter::writeArray(const std::string& keyword, const T* data, std::size_t size,
+                                 Type type, const Convert* convert) {
+        if (keyword.size() > 8)
+            throw std::invalid_argument("The keyword " + keyword + " is longer than eight characters");
+
+        this->used += encodeHeader(this->reserve(std::max(headerSize, formattedHeaderSize)),
+                                   keyword, type, size, this->is_formatted);
+
+        const std::size_t records = (size + recordSize - 1) / recordSize;
+        const auto ranges = (this->is_formatted && records >= minParallelRecords)
+            ? chunkRanges(records, minParallelRecords / 2)
+            : std::vector<std::pair<std::size_t, std::size_t>>{};
+
+        if (ranges.size() > 1) {
+            std::vector<std::vector<char>> texts(ranges.size());
+            forEachChunk(ranges, [&](std::size_t chunk, std::size_t first, std::size_t last) {
+                texts[chunk] = encodeRecords(data, size, first, last, type, convert);
+            });
+
+            this->flush();
+            for (const auto& text : texts) {
+                if (std::fwrite(text.data(), 1, text.size(), this->stream) != text.size())
+                    throw std::runtime_error("Writing the ECLIPSE array " + keyword + " failed");
+            }
+            return;
+        }
+
+        double chunk[recordSize];
+        for (std::size_t record = 0; record < records; record++) {
+            const std::size_t begin = record * recordSize;
+            const std::size_t n = std::min(recordSize, size - begin);
+            const auto* values = convertRecord(data + begin, n, convert, chunk);
+            this->used += encodeRecord(this->reserve(maxRecordBytes), values, n, type, this->is_formatted);
+        }
+    }
+
+
+    void ArrayWriter::write(const std::string& keyword, const std::vector<int>& data) {
+        this->writeArray(keyword, data.data(), data.size(), Type::Integer, nullptr);
+    }
+
+
+    void ArrayWriter::write(const std::string& keyword, const std::vector<float>& data) {
+        this->writeArray(keyword, data.data(), data.size(), Type::Float, nullptr);
+    }
+
+
+    void ArrayWriter::write(const std::string& keyword, const std::vector<double>& data, Type type) {
+        if (type == Type::Integer)
+            throw std::invalid_argument("Double values can only be written as REAL or DOUB");
+
+        this->writeArray(keyword, data.data(), data.size(), type, nullptr);
+    }
+
+
+    void ArrayWriter::write(const std::string& keyword, const std::vector<double>& data, Type type,
+                            const Convert& convert) {
+        if (type == Type::Integer)
+            throw std::invalid_argument("Double values can only be written as REAL or DOUB");
+
+        this->writeArray(keyword, data.data(), data.size(), type, &convert);
+    }
+
+}}} // Opm::RestartIO::Helpers
@@ -0,0 +1,287 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/output/eclipse/ColumnarSummary.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace Opm { namespace out {
+
+namespace {
+
+    const char magic[] = "OPMCSMRY";
+    const std::size_t magicSize = 8;
+    const std::uint32_t version = 1;
+
+    void put32( std::vector< char >& dst, std::uint32_t value ) {
+        for (int byte = 0; byte < 4; byte++)
+            dst.push_back( static_cast< char >( (value >> (8 * byte)) & 0xFF ) );
+    }
+
+    void putDouble( std::vector< char >& dst, double value ) {
+        std::uint64_t bits;
+        std::memcpy( &bits, &value, sizeof bits );
+        for (int byte = 0; byte < 8; byte++)
+            dst.push_back( static_cast< char >( (bits >> (8 * byte)) & 0xFF ) );
+    }
+
+    void putString( std::vector< char >& dst, const std::string& value ) {
+        put32( dst, static_cast< std::uint32_t >( value.size() ) );
+        dst.insert( dst.end(), value.begin(), value.end() );
+    }
+
+    std::uint32_t get32( const char* src ) {
+        std::uint32_t value = 0;
+        for (int byte = 3; byte >= 0; byte--)
+            value = (value << 8) | static_cast< unsigned char >( src[byte] );
+        return value;
+    }
+
+    double getDouble( const char* src ) {
+        std::uint64_t bits = 0;
+        for (int byte = 7; byte >= 0; byte--)
+            bits = (bits << 8) | static_cast< unsigned char >( src[byte] );
+
+        double value;
+        std::memcpy( &value, &bits, sizeof value );
+        return value;
+    }
+
+    void read( std::ifstream& stream, char* dst, std::size_t size, const std::string& filename ) {
+        stream.read( dst, size );
+        if (static_cast< std::size_t >( stream.gcount() ) != size)
+            throw std::runtime_error( "Columnar summary file " + filename + " is truncated" );
+    }
+
+    std::uint32_t read32( std::ifstream& stream, const std::string& filename ) {
+        char bytes[4];
+        read( stream, bytes, sizeof bytes, filename );
+        return get32( bytes );
+    }
+
+    std::string readString( std::ifstream& stream, const std::string& filename ) {
+        std::string value( read32( stream, filename ), ' ' );
+        if (!value.empty())
+            read( stream, &value[0], value.size(), filename );
+        return value;
+    }
+
+}
+
+
+ColumnarSummary::ColumnarSummary( const std::string& filename,
+                                  const std::vector< std::string >& keys,
+                                  const std::vector< std::string >& units,
+                                  std::size_t chunk_size_arg ) :
+    stream( filename, std::ios_base::binary | std::ios_base::trunc ),
+    num_columns( keys.size() ),
+    chunk_size( std::max( chunk_size_arg, std::size_t( 1 ) ) ),
+    columns( num_columns * chunk_size )
+{
+    if (keys.size() != units.size())
+        throw std::invalid_argument( "Columnar summary: one unit per key is required" );
+
+    if (!this->stream)
+        throw std::runtime_error( "Unable to open columnar summary file " + filename );
+
+    this->buffer.insert( this->buffer.end(), magic, magic + magicSize );
+    put32( this->buffer, version );
+    put32( this->buffer, static_cast< std::uint32_t >( this->num_columns ) );
+    put32( this->buffer, static_cast< std::uint32_t >( this->chunk_size ) );
+    for (std::size_t col = 0; col < this->num_columns; ++col) {
+        putString( this->buffer, keys[col] );
+        putString( this->buffer, units[col] );
+    }
+
+    this->stream.write( this->buffer.data(), this->buffer.size() );
+    this->stream.flush();
+    if (!this->stream)
+        throw std::runtime_error( "Unable to write columnar summary file " + filename );
+}
+
+
+ColumnarSummary::~ColumnarSummary() {
+    this->flush();
+}
+
+
+void ColumnarSummary::append( const std::vector< double >& row ) {
+    if (row.size() != this->num_columns)
+        throw std::invalid_argument( "Columnar summary: the row has the wrong number of values" );
+
+    for (std::size_t col = 0; col < this->num_columns; ++col)
+        this->columns[ col * this->chunk_size + this->rows ] = row[col];
+
+    if (++this->rows == this->chunk_size)
+        this->flush();
+}
+
+
+void ColumnarSummary::flush() {
+    if (this->rows == 0)
+        return;
+
+    const auto nan = std::numeric_limits< double >::quiet_NaN();
+
+    this->buffer.clear();
+    this->buffer.reserve( 4 + 8 * this->num_columns * (2 + this->rows) );
+    put32( this->buffer, static_cast< std::uint32_t >( this->rows ) );
+
+    for (std::size_t col = 0; col < this->num_columns; ++col) {
+        const auto first = this->columns.begin() + col * this->chunk_size;
+        auto min = nan;
+        auto max = nan;
+        for (auto value = first; value != first + this->rows; ++value) {
+            if (std::isnan( *value ))
+                continue;
+
+            if (std::isnan( min ) || *value < min) min = *value;
+            if (std::isnan( max ) || *value > max) max = *value;
+        }
+
+        putDouble( this->buffer, min );
+        putDouble( this->buffer, max );
+    }
+
+    for (std::size_t col = 0; col < this->num_columns; ++col) {
+        const auto first = this->columns.begin() + col * this->chunk_size;
+        for (auto value = first; value != first + this->rows; ++value)
+            putDouble( this->buffer, *value );
+    }
+
+    this->stream.write( this->buffer.data(), this->buffer.size() );
+    this->stream.flush();
+    this->rows = 0;
+}
+
+
+std::size_t ColumnarSummary::memory_usage() const {
+    return this->columns.capacity() * sizeof( double ) + this->buffer.capacity();
+}
+
+
+ColumnarSummaryFile::ColumnarSummaryFile( const std::string& filename_arg ) :
+    filename( filename_arg )
+{
+    std::ifstream stream( this->filename, std::ios_base::binary );
+    if (!stream)
+        throw std::runtime_error( "Unable to open columnar summary file " + this->filename );
+
+    char header[magicSize];
+    read( stream, header, magicSize, this->filename );
+    if (std::memcmp( header, magic, magicSize ) != 0 || read32( stream, this->filename ) != version)
+        throw std::runtime_error( this->filename + " is not a columnar summary file" );
+
+    const auto num_columns = read32( stream, this->filename );
+    read32( stream, this->filename );   // rows per chunk
+
+    for (std::uint32_t col = 0; col < num_columns; ++col) {
+        this->m_keys.push_back( readString( stream, this->filename ) );
+        this->m_units.push_back( readString( stream, this->filename ) );
+    }
+
+    const std::size_t data_start = stream.tellg();
+    stream.seekg( 0, std::ios_base::end );
+    const std::size_t file_size = stream.tellg();
+    stream.seekg( data_start );
+
+    for (std::size_t offset = data_start; offset < file_size; ) {
+        const std::size_t rows = read32( stream, this->filename );
+        const std::size_t next = offset + 4 + 8 * num_columns * (2 + rows);
+        if (next > file_size)
+            throw std::runtime_error( "Columnar summary file " + this->filename + " is truncated" );
+
+        this->chunks.push_back( { offset, rows } );
+        offset = next;
+        stream.seekg( offset );
+    }
+}
+
+
+const std::vector< std::string >& ColumnarSummaryFile::keys() const {
+    return this->m_keys;
+}
+
+
+const std::vector< std::string >& ColumnarSummaryFile::units() const {
+    return this->m_units;
+}
+
+
+std::size_t ColumnarSummaryFile::numRows() const {
+    std::size_t rows = 0;
+    for (const auto& chunk : this->chunks)
+        rows += chunk.rows;
+    return rows;
+}
+
+
+std::size_t ColumnarSummaryFile::column( const std::string& key ) const {
+    const auto pos = std::find( this->m_keys.begin(), this->m_keys.end(), key );
+    if (pos == this->m_keys.end())
+        throw std::invalid_argument( "No summary vector " + key + " in " + this->filename );
+
+    return pos - this->m_keys.begin();
+}
+
+
+std::vector< double > ColumnarSummaryFile::get( const std::string& key ) const {
+    const auto col = this->column( key );
+    const auto num_columns = this->m_keys.size();
+
+    std::ifstream stream( this->filename, std::ios_base::binary );
+    std::vector< double > values;
+    values.reserve( this->numRows() );
+
+    std::vector< char > bytes;
+    for (const auto& chunk : this->chunks) {
+        bytes.resize( 8 * chunk.rows );
+        stream.seekg( chunk.offset + 4 + 16 * num_columns + 8 * col * chunk.rows );
+        read( stream, bytes.data(), bytes.size(), this->filename );
+
+        for (std::size_t row = 0; row < chunk.rows; ++row)
+            values.push_back( getDouble( bytes.data() + 8 * row ) );
+    }
+
+    return values;
+}
+
+
+std::vector< ColumnarSummaryFile::ChunkStats > ColumnarSummaryFile::stats( const std::string& key ) const {
+    const auto col = this->column( key );
+
+    std::ifstream stream( this->filename, std::ios_base::binary );
+    std::vector< ChunkStats > chunk_stats;
+
+    char bytes[16];
+    for (const auto& chunk : this->chunks) {
+        stream.seekg( chunk.offset + 4 + 16 * col );
+        read( stream, bytes, sizeof bytes, this->filename );
+        chunk_stats.push_back( { chunk.rows, getDouble( bytes ), getDouble( bytes + 8 ) } );
+    }
+
+    return chunk_stats;
+}
+
+}}
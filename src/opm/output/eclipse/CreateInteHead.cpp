@@ -210,26 +210,19 @@ namespace {
 // Public Interface (createInteHead()) Below Separator
 // ---------------------------------------------------------------------
 
-std::vector<int>
-Opm::RestartIO::Helpers::
-createInteHead(const EclipseState& es,
-               const EclipseGrid&  grid,
-               const Schedule&     sched,
-               const double        simTime,
-               const int           num_solver_steps,
-               const int           lookup_step
-	      )
+Opm::RestartIO::Helpers::StaticHeaders::
+StaticHeaders(const EclipseState& es,
+              const EclipseGrid&  grid)
+    : logiHead(createLogiHead(es))
 {
     const auto& rspec = es.runspec();
     const auto& tdim  = es.getTableManager();
     const auto& rdim  = tdim.getRegdims();
 
-    const auto ih = InteHEAD{}
+    this->inteHead
         .dimensions         (grid.getNXYZ())
         .numActive          (static_cast<int>(grid.getNumActive()))
         .unitConventions    (getUnitConvention(es.getDeckUnitSystem()))
-        .wellTableDimensions(getWellTableDims(rspec, sched, lookup_step))
-        .calendarDate       (getSimulationTimePoint(sched.posixStartTime(), simTime))
         .activePhases       (getActivePhases(rspec))
              // The numbers below have been determined experimentally to work
              // across a range of reference cases, but are not guaranteed to be
@@ -241,13 +234,43 @@ createInteHead(const EclipseState& es,
              // n{isx}aaqz: number of data elements per aquifer in {ISX}AAQ
              // n{isa}caqz: number of data elements per aquifer connection in {ISA}CAQ
         .params_NAAQZ       (1, 18, 24, 10, 7, 2, 4)
-        .stepParam          (num_solver_steps, lookup_step)
-        .tuningParam        (getTuningPars(sched.getTuning(), lookup_step))
-        .wellSegDimensions  (getWellSegDims(rspec, sched, lookup_step))
         .regionDimensions   (getRegDims(tdim, rdim))
-	.ngroups(getNoGroups(sched, lookup_step))
         .variousParam       (201702, 100)  // Output should be compatible with Eclipse 100, 2017.02 version.
         ;
+}
+
+std::vector<int>
+Opm::RestartIO::Helpers::
+createInteHead(const StaticHeaders& headers,
+               const EclipseState&  es,
+               const Schedule&      sched,
+               const double         simTime,
+               const int            num_solver_steps,
+               const int            lookup_step)
+{
+    const auto& rspec = es.runspec();
+
+    auto ih = headers.inteHead;
+    ih.wellTableDimensions(getWellTableDims(rspec, sched, lookup_step))
+      .calendarDate       (getSimulationTimePoint(sched.posixStartTime(), simTime))
+      .stepParam          (num_solver_steps, lookup_step)
+      .tuningParam        (getTuningPars(sched.getTuning(), lookup_step))
+      .wellSegDimensions  (getWellSegDims(rspec, sched, lookup_step))
+      .ngroups            (getNoGroups(sched, lookup_step))
+      ;
 
     return ih.data();
 }
+
+std::vector<int>
+Opm::RestartIO::Helpers::
+createInteHead(const EclipseState& es,
+               const EclipseGrid&  grid,
+               const Schedule&     sched,
+               const double        simTime,
+               const int           num_solver_steps,
+               const int           lookup_step)
+{
+    return createInteHead(StaticHeaders(es, grid), es, sched,
+                          simTime, num_solver_steps, lookup_step);
+}
@@ -87,95 +87,182 @@ void EclipseGridInspector::init_()
 
 }
 
-/**
-   Return the dip slopes for the cell relative to xy-plane in x- and y- direction.
-   Dip slope is average rise in positive x-direction over cell length in x-direction.
-   Similarly for y.
+namespace {
+
+    /* The eight ZCORN values of cell (i, j, k), ordered as in cellZvals(). */
+    std::array<double, 8> cell_zvals(const std::vector<double>& z, const int* dims, int i, int j, int k)
+    {
+        int delta[3] = { 1,
+                         2*dims[0],
+                         4*dims[0]*dims[1] };
+        int ix = 2*(i*delta[0] + j*delta[1] + k*delta[2]);
+        std::array<double, 8> cellz = {{ z[ix], z[ix + delta[0]],
+                                           z[ix + delta[1]], z[ix + delta[1] + delta[0]],
+                                           z[ix + delta[2]], z[ix + delta[2] + delta[0]],
+                                           z[ix + delta[2] + delta[1]], z[ix + delta[2] + delta[1] + delta[0]] }};
+        return cellz;
+    }
 
-   Current implementation is for vertical pillars, but is not difficult to fix.
 
-   @returns a std::pair<double,double> with x-dip in first component and y-dip in second.
-*/
-std::pair<double,double> EclipseGridInspector::cellDips(int i, int j, int k) const
+    /* The base area of the cells of column (i, j) as half the 2d cross product of the diagonals. */
+    double cell_area(const std::vector<double>& pillc, const int* dims, int i, int j)
+    {
+        int numxpill = dims[0] + 1;
+        int pix = i + j*numxpill;
+        double px[4] = { pillc[6*pix],
+                         pillc[6*(pix + 1)],
+                         pillc[6*(pix + numxpill)],
+                         pillc[6*(pix + numxpill + 1)] };
+        double py[4] = { pillc[6*pix + 1],
+                         pillc[6*(pix + 1) + 1],
+                         pillc[6*(pix + numxpill) + 1],
+                         pillc[6*(pix + numxpill + 1) + 1] };
+        double diag1[2] = { px[3] - px[0], py[3] - py[0] };
+        double diag2[2] = { px[2] - px[1], py[2] - py[1] };
+        return 0.5*(diag1[0]*diag2[1] - diag1[1]*diag2[0]);
+    }
+
+
+    /* The area times the average of the z-differences along each pillar. */
+    double cell_volume(const std::vector<double>& pillc, const std::vector<double>& z,
+                       const int* dims, int i, int j, int k)
+    {
+        const auto cellz = cell_zvals(z, dims, i, j, k);
+        double diffz[4] = { cellz[4] - cellz[0],
+                            cellz[5] - cellz[1],
+                            cellz[6] - cellz[2],
+                            cellz[7] - cellz[3] };
+        double averzdiff = 0.25*std::accumulate(diffz, diffz + 4, 0.0);
+        return averzdiff*cell_area(pillc, dims, i, j);
+    }
+
+
+    std::pair<double,double> cell_dips(const std::vector<double>& pillc, const std::array<double, 8>& cellz,
+                                       const int* dims, int i, int j, double zmin, double zmax)
+    {
+        // Compute rise in positive x-direction for all four edges (and then find mean)
+        // Current implementation is for regularly placed and vertical pillars!
+        int numxpill = dims[0] + 1;
+        int pix = i + j*numxpill;
+        double cell_xlength = pillc[6*(pix + 1)] - pillc[6*pix];
+        double xrise[4] = { (cellz[1] - cellz[0])/cell_xlength,  // LLL -> HLL
+                            (cellz[3] - cellz[2])/cell_xlength,  // LHL -> HHL
+                            (cellz[5] - cellz[4])/cell_xlength,  // LLH -> HLH
+                            (cellz[7] - cellz[6])/cell_xlength}; // LHH -> HHH
+
+        double cell_ylength = pillc[6*(pix + numxpill) + 1] - pillc[6*pix + 1];
+        double yrise[4] = { (cellz[2] - cellz[0])/cell_ylength,  // LLL -> LHL
+                            (cellz[3] - cellz[1])/cell_ylength,  // HLL -> HHL
+                            (cellz[6] - cellz[4])/cell_ylength,  // LLH -> LHH
+                            (cellz[7] - cellz[5])/cell_ylength}; // HLH -> HHH
+
+
+        // Now ignore those edges that touch the global top or bottom surface
+        // of the entire grdecl model. This is to avoid bias, as these edges probably
+        // don't follow an overall dip for the model if it exists.
+        int x_edges = 4;
+        int y_edges = 4;
+        // LLL -> HLL
+        if ((cellz[1] == zmin) || (cellz[0] == zmin)) {
+            xrise[0] = 0; x_edges--;
+        }
+        // LHL -> HHL
+        if ((cellz[2] == zmin) || (cellz[3] == zmin)) {
+            xrise[1] = 0; x_edges--;
+        }
+        // LLH -> HLH
+        if ((cellz[4] == zmax) || (cellz[5] == zmax)) {
+            xrise[2] = 0; x_edges--;
+        }
+        // LHH -> HHH
+        if ((cellz[6] == zmax) || (cellz[7] == zmax)) {
+            xrise[3] = 0; x_edges--;
+        }
+        // LLL -> LHL
+        if ((cellz[0] == zmin) || (cellz[2] == zmin)) {
+            yrise[0] = 0; y_edges--;
+        }
+        // HLL -> HHL
+        if ((cellz[1] == zmin) || (cellz[3] == zmin)) {
+            yrise[1] = 0; y_edges--;
+        }
+        // LLH -> LHH
+        if ((cellz[6] == zmax) || (cellz[4] == zmax)) {
+            yrise[2] = 0; y_edges--;
+        }
+        // HLH -> HHH
+        if ((cellz[7] == zmax) || (cellz[5] == zmax)) {
+            yrise[3] = 0; y_edges--;
+        }
+
+        return std::make_pair( (xrise[0] + xrise[1] + xrise[2] + xrise[3])/x_edges,
+                               (yrise[0] + yrise[1] + yrise[2] + yrise[3])/y_edges);
+    }
+
+
+    /*
+      Calls op(cell, i, j, k) for the cells in [begin, end); the cells
+      are independent, so they are processed concurrently.
+    */
+    template <typename F>
+    void forCellRange(const int* dims, int begin, int end, F op)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int cell = begin; cell < end; ++cell) {
+            const int i = cell % dims[0];
+            const int j = (cell / dims[0]) % dims[1];
+            const int k = cell / (dims[0]*dims[1]);
+            op(cell - begin, i, j, k);
+        }
+    }
+
+}
+
+
+const std::vector<double>& EclipseGridInspector::coord_() const
 {
-    checkLogicalCoords(i, j, k);
     const std::vector<double>& pillc =
         deck_.getKeyword("COORD").getSIDoubleData();
     int num_pillars = (logical_gridsize_[0] + 1)*(logical_gridsize_[1] + 1);
-        if (6*num_pillars != int(pillc.size())) {
+    if (6*num_pillars != int(pillc.size())) {
         throw std::runtime_error("Wrong size of COORD field.");
     }
+    return pillc;
+}
+
+
+const std::vector<double>& EclipseGridInspector::zcorn_() const
+{
     const std::vector<double>& z =
         deck_.getKeyword("ZCORN").getSIDoubleData();
     int num_cells = logical_gridsize_[0]*logical_gridsize_[1]*logical_gridsize_[2];
     if (8*num_cells != int(z.size())) {
         throw std::runtime_error("Wrong size of ZCORN field");
     }
+    return z;
+}
 
-    // Pick ZCORN-value for all 8 corners of the given cell
-    std::array<double, 8> cellz = cellZvals(i, j, k);
-
-    // Compute rise in positive x-direction for all four edges (and then find mean)
-    // Current implementation is for regularly placed and vertical pillars!
-    int numxpill = logical_gridsize_[0] + 1;
-    int pix = i + j*numxpill;
-    double cell_xlength = pillc[6*(pix + 1)] - pillc[6*pix];
-    flush(std::cout);
-    double xrise[4] = { (cellz[1] - cellz[0])/cell_xlength,  // LLL -> HLL
-                        (cellz[3] - cellz[2])/cell_xlength,  // LHL -> HHL
-                        (cellz[5] - cellz[4])/cell_xlength,  // LLH -> HLH
-                        (cellz[7] - cellz[6])/cell_xlength}; // LHH -> HHH
-
-    double cell_ylength = pillc[6*(pix + numxpill) + 1] - pillc[6*pix + 1];
-    double yrise[4] = { (cellz[2] - cellz[0])/cell_ylength,  // LLL -> LHL
-                        (cellz[3] - cellz[1])/cell_ylength,  // HLL -> HHL
-                        (cellz[6] - cellz[4])/cell_ylength,  // LLH -> LHH
-                        (cellz[7] - cellz[5])/cell_ylength}; // HLH -> HHH
-
-
-    // Now ignore those edges that touch the global top or bottom surface
-    // of the entire grdecl model. This is to avoid bias, as these edges probably
-    // don't follow an overall dip for the model if it exists.
-    int x_edges = 4;
-    int y_edges = 4;
-    std::array<double, 6> gridlimits = getGridLimits();
-    double zmin = gridlimits[4];
-    double zmax = gridlimits[5];
-    // LLL -> HLL
-    if ((cellz[1] == zmin) || (cellz[0] == zmin)) {
-	xrise[0] = 0; x_edges--;
-    }
-    // LHL -> HHL
-    if ((cellz[2] == zmin) || (cellz[3] == zmin)) {
-	xrise[1] = 0; x_edges--;
-    }
-    // LLH -> HLH
-    if ((cellz[4] == zmax) || (cellz[5] == zmax)) {
-	xrise[2] = 0; x_edges--;
-    }
-    // LHH -> HHH
-    if ((cellz[6] == zmax) || (cellz[7] == zmax)) {
-	xrise[3] = 0; x_edges--;
-    }
-    // LLL -> LHL
-    if ((cellz[0] == zmin) || (cellz[2] == zmin)) {
-	yrise[0] = 0; y_edges--;
-    }
-    // HLL -> HHL
-    if ((cellz[1] == zmin) || (cellz[3] == zmin)) {
-	yrise[1] = 0; y_edges--;
-    }
-    // LLH -> LHH
-    if ((cellz[6] == zmax) || (cellz[4] == zmax)) {
-	yrise[2] = 0; y_edges--;
-    }
-    // HLH -> HHH
-    if ((cellz[7] == zmax) || (cellz[5] == zmax)) {
-	yrise[3] = 0; y_edges--;
-    }
 
-    return std::make_pair( (xrise[0] + xrise[1] + xrise[2] + xrise[3])/x_edges,
-                          (yrise[0] + yrise[1] + yrise[2] + yrise[3])/y_edges);
+/**
+   Return the dip slopes for the cell relative to xy-plane in x- and y- direction.
+   Dip slope is average rise in positive x-direction over cell length in x-direction.
+   Similarly for y.
+
+   Current implementation is for vertical pillars, but is not difficult to fix.
+
+   @returns a std::pair<double,double> with x-dip in first component and y-dip in second.
+*/
+std::pair<double,double> EclipseGridInspector::cellDips(int i, int j, int k) const
+{
+    checkLogicalCoords(i, j, k);
+    const std::vector<double>& pillc = coord_();
+    const std::vector<double>& z = zcorn_();
+
+    std::array<double, 6> gridlimits = getGridLimits();
+    return cell_dips(pillc, cell_zvals(z, logical_gridsize_, i, j, k),
+                     logical_gridsize_, i, j, gridlimits[4], gridlimits[5]);
 }
 /**
   Wrapper for cellDips(i, j, k).
@@ -209,49 +296,9 @@ double EclipseGridInspector::cellVolumeVerticalPillars(int i, int j, int k) cons
 {
     // Checking parameters and obtaining values from parser.
     checkLogicalCoords(i, j, k);
-    const std::vector<double>& pillc =
-        deck_.getKeyword("COORD").getSIDoubleData();
-    int num_pillars = (logical_gridsize_[0] + 1)*(logical_gridsize_[1] + 1);
-    if (6*num_pillars != int(pillc.size())) {
-	throw std::runtime_error("Wrong size of COORD field.");
-    }
-    const std::vector<double>& z =
-        deck_.getKeyword("ZCORN").getSIDoubleData();
-    int num_cells = logical_gridsize_[0]*logical_gridsize_[1]*logical_gridsize_[2];
-    if (8*num_cells != int(z.size())) {
-	throw std::runtime_error("Wrong size of ZCORN field");
-    }
-
-    // Computing the base area as half the 2d cross product of the diagonals.
-    int numxpill = logical_gridsize_[0] + 1;
-    int pix = i + j*numxpill;
-    double px[4] = { pillc[6*pix],
-		     pillc[6*(pix + 1)],
-		     pillc[6*(pix + numxpill)],
-		     pillc[6*(pix + numxpill + 1)] };
-    double py[4] = { pillc[6*pix + 1],
-		     pillc[6*(pix + 1) + 1],
-		     pillc[6*(pix + numxpill) + 1],
-		     pillc[6*(pix + numxpill + 1) + 1] };
-    double diag1[2] = { px[3] - px[0], py[3] - py[0] };
-    double diag2[2] = { px[2] - px[1], py[2] - py[1] };
-    double area = 0.5*(diag1[0]*diag2[1] - diag1[1]*diag2[0]);
-
-    // Computing the average of the z-differences along each pillar.
-    int delta[3] = { 1,
-		     2*logical_gridsize_[0],
-		     4*logical_gridsize_[0]*logical_gridsize_[1] };
-    int ix = 2*(i*delta[0] + j*delta[1] + k*delta[2]);
-    double cellz[8] = { z[ix], z[ix + delta[0]],
-			z[ix + delta[1]], z[ix + delta[1] + delta[0]],
-			z[ix + delta[2]], z[ix + delta[2] + delta[0]],
-			z[ix + delta[2] + delta[1]], z[ix + delta[2] + delta[1] + delta[0]] };
-    double diffz[4] = { cellz[4] - cellz[0],
-			cellz[5] - cellz[1],
-			cellz[6] - cellz[2],
-			cellz[7] - cellz[3] };
-    double averzdiff = 0.25*std::accumulate(diffz, diffz + 4, 0.0);
-    return averzdiff*area;
+    const std::vector<double>& pillc = coord_();
+    const std::vector<double>& z = zcorn_();
+    return cell_volume(pillc, z, logical_gridsize_, i, j, k);
 }
 
 
@@ -278,8 +325,8 @@ std::array<double, 6> EclipseGridInspector::getGridLimits() const
         throw std::runtime_error("EclipseGridInspector: Grid does not have SPECGRID, COORD, and ZCORN, can't find dimensions.");
     }
 
-    std::vector<double> coord = deck_.getKeyword("COORD").getSIDoubleData();
-    std::vector<double> zcorn = deck_.getKeyword("ZCORN").getSIDoubleData();
+    const std::vector<double>& coord = deck_.getKeyword("COORD").getSIDoubleData();
+    const std::vector<double>& zcorn = deck_.getKeyword("ZCORN").getSIDoubleData();
 
     double xmin = +DBL_MAX;
     double xmax = -DBL_MAX;
@@ -308,9 +355,18 @@ std::array<double, 6> EclipseGridInspector::getGridLimits() const
             ymin = coord[pillarindex * 6 + 4];
     }
 
-    std::array<double, 6> gridlimits = {{ xmin, xmax, ymin, ymax,
-                                            *min_element(zcorn.begin(), zcorn.end()),
-                                            *max_element(zcorn.begin(), zcorn.end()) }};
+    double zmin = +DBL_MAX;
+    double zmax = -DBL_MAX;
+    const long num_zcorn = static_cast<long>(zcorn.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(min:zmin) reduction(max:zmax)
+#endif
+    for (long index = 0; index < num_zcorn; ++index) {
+        zmin = std::min(zmin, zcorn[index]);
+        zmax = std::max(zmax, zcorn[index]);
+    }
+
+    std::array<double, 6> gridlimits = {{ xmin, xmax, ymin, ymax, zmin, zmax }};
     return gridlimits;
 }
 
@@ -327,23 +383,75 @@ std::array<int, 3> EclipseGridInspector::gridSize() const
 
 std::array<double, 8> EclipseGridInspector::cellZvals(int i, int j, int k) const
 {
-    // Get the zcorn field.
-    const std::vector<double>& z = deck_.getKeyword("ZCORN").getSIDoubleData();
+    return cell_zvals(zcorn_(), logical_gridsize_, i, j, k);
+}
+
+
+void EclipseGridInspector::checkCellRange(int begin, int end) const
+{
     int num_cells = logical_gridsize_[0]*logical_gridsize_[1]*logical_gridsize_[2];
-    if (8*num_cells != int(z.size())) {
-	throw std::runtime_error("Wrong size of ZCORN field");
-    }
+    if (begin < 0 || begin > end || end > num_cells)
+        throw std::runtime_error("Cell range out of bounds");
+}
+
+
+std::vector<std::pair<double,double>> EclipseGridInspector::cellDipsRange(int begin, int end) const
+{
+    checkCellRange(begin, end);
+    const std::vector<double>& pillc = coord_();
+    const std::vector<double>& z = zcorn_();
+    const std::array<double, 6> gridlimits = getGridLimits();
+    const int* dims = logical_gridsize_;
+
+    std::vector<std::pair<double,double>> dips(end - begin);
+    forCellRange(dims, begin, end, [&](int index, int i, int j, int k) {
+            dips[index] = cell_dips(pillc, cell_zvals(z, dims, i, j, k),
+                                    dims, i, j, gridlimits[4], gridlimits[5]);
+        });
+    return dips;
+}
+
+
+std::vector<std::array<double, 8>> EclipseGridInspector::cellZvalsRange(int begin, int end) const
+{
+    checkCellRange(begin, end);
+    const std::vector<double>& z = zcorn_();
+    const int* dims = logical_gridsize_;
+
+    std::vector<std::array<double, 8>> zvals(end - begin);
+    forCellRange(dims, begin, end, [&](int index, int i, int j, int k) {
+            zvals[index] = cell_zvals(z, dims, i, j, k);
+        });
+    return zvals;
+}
+
 
-    // Make the coordinate array.
-    int delta[3] = { 1,
-		     2*logical_gridsize_[0],
-		     4*logical_gridsize_[0]*logical_gridsize_[1] };
-    int ix = 2*(i*delta[0] + j*delta[1] + k*delta[2]);
-    std::array<double, 8> cellz = {{ z[ix], z[ix + delta[0]],
-				       z[ix + delta[1]], z[ix + delta[1] + delta[0]],
-				       z[ix + delta[2]], z[ix + delta[2] + delta[0]],
-				       z[ix + delta[2] + delta[1]], z[ix + delta[2] + delta[1] + delta[0]] }};
-    return cellz;
+std::vector<double> EclipseGridInspector::cellVolumesVerticalPillars(int begin, int end) const
+{
+    checkCellRange(begin, end);
+    const std::vector<double>& pillc = coord_();
+    const std::vector<double>& z = zcorn_();
+    const int* dims = logical_gridsize_;
+
+    std::vector<double> volumes(end - begin);
+    forCellRange(dims, begin, end, [&](int index, int i, int j, int k) {
+            volumes[index] = cell_volume(pillc, z, dims, i, j, k);
+        });
+    return volumes;
+}
+
+
+std::vector<double> EclipseGridInspector::cellAreasVerticalPillars(int begin, int end) const
+{
+    checkCellRange(begin, end);
+    const std::vector<double>& pillc = coord_();
+    const int* dims = logical_gridsize_;
+
+    std::vector<double> areas(end - begin);
+    forCellRange(dims, begin, end, [&](int index, int i, int j, int) {
+            areas[index] = cell_area(pillc, dims, i, j);
+        });
+    return areas;
 }
 
 
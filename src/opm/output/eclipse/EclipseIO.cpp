@@ -37,15 +37,29 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/Utility/Functional.hpp>
 
+#include <opm/output/eclipse/ArrayWriter.hpp>
 #include <opm/output/eclipse/RestartIO.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 #include <opm/output/eclipse/Tables.hpp>
+#include <opm/common/OpmLog/Metrics.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <exception>
+#include <future>
 #include <memory>     // unique_ptr
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <utility>    // move
 
+#include <boost/filesystem.hpp>
+
 #include <ert/ecl/EclKW.hpp>
 #include <ert/ecl/EclFilename.hpp>
 
@@ -67,14 +81,57 @@
 namespace Opm {
 namespace {
 
+/*
+  Counts the bytes an output phase adds to a file as the "bytes" counter
+  of the innermost open PhaseTimer phase; the file sizes are only looked
+  up when the phase timers or the metrics are enabled.
+*/
+class FileBytesCounter {
+public:
+    explicit FileBytesCounter( const std::string& filename_arg ) :
+        filename( filename_arg ),
+        enabled( PhaseTimer::enabled() || Metrics::enabled() ),
+        initial_size( enabled ? size() : 0 )
+    {}
+
+    ~FileBytesCounter() {
+        if (this->enabled)
+            PhaseTimer::count( "bytes", this->size() - this->initial_size );
+    }
+
+private:
+    int64_t size() const {
+        boost::system::error_code ec;
+        const auto file_size = boost::filesystem::file_size( this->filename, ec );
+        return ec ? 0 : static_cast< int64_t >( file_size );
+    }
+
+    std::string filename;
+    bool enabled;
+    int64_t initial_size;
+};
+
 
+/*
+  The keywords are encoded straight into a buffer which is written to
+  the stream of the fortio in a few large writes, instead of being
+  copied into an ecl_kw first. The buffer is sized to the keyword, up to
+  the default size of the writer.
+*/
+using ArrayWriter = RestartIO::Helpers::ArrayWriter;
 
+std::size_t writerBufferSize( std::size_t elements ) {
+    return std::min( 64 + elements * 20, ArrayWriter::defaultBufferSize );
+}
 
 void writeKeyword( ERT::FortIO& fortio ,
                    const std::string& keywordName,
                    const std::vector<int> &data ) {
-    ERT::EclKW< int > kw( keywordName, data );
-    kw.fwrite( fortio );
+    ArrayWriter writer( fortio_get_FILE( fortio.get() ),
+                        fortio_fmt_file( fortio.get() ),
+                        writerBufferSize( data.size() ) );
+    writer.write( keywordName, data );
+    writer.flush();
 }
 
 /*
@@ -87,9 +144,29 @@ void writeKeyword( ERT::FortIO& fortio ,
                    const std::string& keywordName,
                    const std::vector<double> &data) {
 
-    ERT::EclKW< float > kw( keywordName, data );
-    kw.fwrite( fortio );
+    ArrayWriter writer( fortio_get_FILE( fortio.get() ),
+                        fortio_fmt_file( fortio.get() ),
+                        writerBufferSize( data.size() ) );
+    writer.write( keywordName, data, ArrayWriter::Type::Float );
+    writer.flush();
+}
 
+/*
+  As above, with the values passed through convert on their way into
+  the output buffer, so that e.g. the unit conversion of a large array
+  does not need a converted copy of it.
+*/
+
+void writeKeyword( ERT::FortIO& fortio ,
+                   const std::string& keywordName,
+                   const std::vector<double> &data,
+                   const ArrayWriter::Convert& convert) {
+
+    ArrayWriter writer( fortio_get_FILE( fortio.get() ),
+                        fortio_fmt_file( fortio.get() ),
+                        writerBufferSize( data.size() ) );
+    writer.write( keywordName, data, ArrayWriter::Type::Float, convert );
+    writer.flush();
 }
 
 
@@ -102,16 +179,33 @@ class RFT {
          const std::string&  basename,
          bool format );
 
-        void writeTimeStep( std::vector< const Well* >,
+        void writeTimeStep( const std::vector< const Well* >& wells,
                             const EclipseGrid& grid,
                             int report_step,
                             time_t current_time,
                             double days,
                             const UnitSystem& units,
-                            data::Wells wellData);
+                            const data::Wells& wellData);
     private:
+        /*
+          The active cells of the connections of one well, with the
+          depth of the cell. The connections of a well rarely change
+          between the RFT steps, while the cell depth is computed from
+          the cell corners, so the cells are kept until the (i,j,k) list
+          of the connections changes.
+        */
+        struct WellCells {
+            std::vector< std::array< int, 3 > > ijk;
+            std::vector< size_t > global_index;
+            std::vector< std::array< int, 3 > > cell_ijk;
+            std::vector< double > depth;
+        };
+
+        const WellCells& wellCells( const Well& well, const EclipseGrid& grid, int report_step );
+
         std::string filename;
         bool fmt_file;
+        std::unordered_map< std::string, WellCells > well_cells;
 };
 
 
@@ -123,13 +217,42 @@ class RFT {
 {}
 
 
-void RFT::writeTimeStep( std::vector< const Well* > wells,
+const RFT::WellCells& RFT::wellCells( const Well& well, const EclipseGrid& grid, int report_step ) {
+    const auto& connections = well.getConnections( report_step );
+    std::vector< std::array< int, 3 > > ijk;
+    ijk.reserve( connections.size() );
+    for( const auto& connection : connections )
+        ijk.push_back( {{ connection.getI(), connection.getJ(), connection.getK() }} );
+
+    auto& cells = this->well_cells[ well.name() ];
+    if( cells.ijk == ijk )
+        return cells;
+
+    cells = WellCells();
+    for( const auto& c : ijk ) {
+        const size_t i = size_t( c[0] );
+        const size_t j = size_t( c[1] );
+        const size_t k = size_t( c[2] );
+
+        if( !grid.cellActive( i, j, k ) ) continue;
+
+        cells.global_index.push_back( grid.getGlobalIndex( i, j, k ) );
+        cells.cell_ijk.push_back( c );
+        cells.depth.push_back( grid.getCellDepth( i, j, k ) );
+    }
+    cells.ijk = std::move( ijk );
+
+    return cells;
+}
+
+
+void RFT::writeTimeStep( const std::vector< const Well* >& wells,
                          const EclipseGrid& grid,
                          int report_step,
                          time_t current_time,
                          double days,
                          const UnitSystem& units,
-                         data::Wells wellDatas) {
+                         const data::Wells& wellDatas) {
     using rft = ERT::ert_unique_ptr< ecl_rft_node_type, ecl_rft_node_free >;
 
     fortio_type * fortio;
@@ -148,49 +271,69 @@ void RFT::writeTimeStep( std::vector< const Well* > wells,
             || well->getPLTActive( report_step ) ) )
             continue;
 
-        auto* rft_node = ecl_rft_node_alloc_new( well->name().c_str(), "RFT",
-                current_time, days );
-
         const auto& wellData = wellDatas.at(well->name());
 
         if (wellData.connections.empty())
             continue;
 
-        for( const auto& connection : well->getConnections( report_step ) ) {
-
-            const size_t i = size_t( connection.getI() );
-            const size_t j = size_t( connection.getJ() );
-            const size_t k = size_t( connection.getK() );
-
-            if( !grid.cellActive( i, j, k ) ) continue;
-
-            const auto index = grid.getGlobalIndex( i, j, k );
-            const double depth = grid.getCellDepth( i, j, k );
-
-            const auto& connectionData = std::find_if( wellData.connections.begin(),
-                                                   wellData.connections.end(),
-                                                   [=]( const data::Connection& c ) {
-                                                        return c.index == index;
-                                                   } );
+        const auto& cells = this->wellCells( *well, grid, report_step );
+        rft ecl_node( ecl_rft_node_alloc_new( well->name().c_str(), "RFT",
+                                              current_time, days ) );
 
+        for( size_t index = 0; index < cells.global_index.size(); index++ ) {
+            const auto* connectionData = wellData.find_connection( cells.global_index[index] );
+            if( connectionData == nullptr ) continue;
 
             const double press = units.from_si(UnitSystem::measure::pressure,connectionData->cell_pressure);
             const double satwat = units.from_si(UnitSystem::measure::identity, connectionData->cell_saturation_water);
             const double satgas = units.from_si(UnitSystem::measure::identity, connectionData->cell_saturation_gas);
 
+            const auto& c = cells.cell_ijk[index];
             auto* cell = ecl_rft_cell_alloc_RFT(
-                            i, j, k, depth, press, satwat, satgas );
+                            c[0], c[1], c[2], cells.depth[index], press, satwat, satgas );
 
-            ecl_rft_node_append_cell( rft_node, cell );
+            ecl_rft_node_append_cell( ecl_node.get(), cell );
         }
 
-        rft ecl_node( rft_node );
         ecl_rft_node_fwrite( ecl_node.get(), fortio, units.getEclType() );
     }
 
     fortio_fclose( fortio );
 }
 
+/*
+  An owned copy of the arguments to EclipseIO::writeTimeStep(), to be
+  written by the asynchronous output thread.
+*/
+struct OutputStep {
+    OutputStep( int report_step_arg,
+                bool isSubstep_arg,
+                double secs_elapsed_arg,
+                RestartValue value_arg,
+                const std::map<std::string, double>& single_values_arg,
+                const std::map<std::string, std::vector<double>>& region_values_arg,
+                const std::map<std::pair<std::string, int>, double>& block_values_arg,
+                bool write_double_arg ) :
+        report_step( report_step_arg ),
+        isSubstep( isSubstep_arg ),
+        secs_elapsed( secs_elapsed_arg ),
+        value( std::move( value_arg ) ),
+        single_values( single_values_arg ),
+        region_values( region_values_arg ),
+        block_values( block_values_arg ),
+        write_double( write_double_arg )
+    {}
+
+    int report_step;
+    bool isSubstep;
+    double secs_elapsed;
+    RestartValue value;
+    std::map<std::string, double> single_values;
+    std::map<std::string, std::vector<double>> region_values;
+    std::map<std::pair<std::string, int>, double> block_values;
+    bool write_double;
+};
+
 inline std::string uppercase( std::string x ) {
     std::transform( x.begin(), x.end(), x.begin(),
         []( char c ) { return std::toupper( c ); } );
@@ -203,8 +346,29 @@ inline std::string uppercase( std::string x ) {
 class EclipseIO::Impl {
     public:
     Impl( const EclipseState&, EclipseGrid, const Schedule&, const SummaryConfig& );
-        void writeINITFile( const data::Solution& simProps, std::map<std::string, std::vector<int> > int_data, const NNC& nnc) const;
+        ~Impl();
+        void writeINITFile( const data::Solution& simProps, const std::map<std::string, std::vector<int> >& int_data, const NNC& nnc) const;
         void writeEGRIDFile( const NNC& nnc );
+        void writeTimeStep( int report_step,
+                            bool isSubstep,
+                            double secs_elapsed,
+                            const RestartValue& value,
+                            const std::map<std::string, double>& single_summary_values,
+                            const std::map<std::string, std::vector<double>>& region_summary_values,
+                            const std::map<std::pair<std::string, int>, double>& block_summary_values,
+                            bool write_double );
+
+        bool asyncOutput() const;
+        void startOutputThread( std::size_t maxQueued );
+        void stopOutputThread();
+        void enqueue( std::unique_ptr< OutputStep > step );
+        void flush();
+
+        /* The extra keys of a restart load, with the summary values added. */
+        std::vector< RestartKey > summaryKeys( const std::vector< RestartKey >& extra_keys ) const;
+        /* Restores the summary values, and drops them from the extra
+           vectors unless the caller asked for them. */
+        void restoreSummary( RestartValue& rst_value, const std::vector< RestartKey >& extra_keys );
 
         const EclipseState& es;
         EclipseGrid grid;
@@ -214,6 +378,28 @@ class EclipseIO::Impl {
         out::Summary summary;
         RFT rft;
         bool output_enabled;
+
+        /* The step-invariant restart headers, created with the first
+           restart file. */
+        std::unique_ptr< RestartIO::Helpers::StaticHeaders > restart_headers;
+
+        /* The well, connection, segment and group arrays, reused for
+           every restart file. */
+        RestartIO::OutputBuffers restart_buffers;
+
+    private:
+        void outputLoop();
+        void rethrowOutputError();
+
+        std::thread output_thread;
+        std::mutex output_mutex;
+        std::condition_variable output_queued;
+        std::condition_variable output_written;
+        std::deque< std::unique_ptr< OutputStep > > output_queue;
+        std::size_t max_queued = 0;
+        bool output_busy = false;
+        bool output_stop = false;
+        std::exception_ptr output_error;
 };
 
 EclipseIO::Impl::Impl( const EclipseState& eclipseState,
@@ -230,8 +416,168 @@ EclipseIO::Impl::Impl( const EclipseState& eclipseState,
     , output_enabled( eclipseState.getIOConfig().getOutputEnabled() )
 {}
 
+EclipseIO::Impl::~Impl() {
+    try {
+        this->stopOutputThread();
+    } catch (const std::exception& e) {
+        OpmLog::error( std::string( "Writing the output failed: " ) + e.what() );
+    } catch (...) {
+        OpmLog::error( "Writing the output failed" );
+    }
+}
+
+
+namespace {
+    const std::string summary_restart_key = "OPM_SMRY";
+
+    bool hasKey( const std::vector< RestartKey >& keys, const std::string& key ) {
+        return std::any_of( keys.begin(), keys.end(),
+                            [&key]( const RestartKey& restart_key ) { return restart_key.key == key; });
+    }
+}
+
+std::vector< RestartKey > EclipseIO::Impl::summaryKeys( const std::vector< RestartKey >& extra_keys ) const {
+    auto keys = extra_keys;
+    if (!hasKey( keys, summary_restart_key ))
+        keys.emplace_back( summary_restart_key, UnitSystem::measure::identity, false );
+
+    return keys;
+}
+
+void EclipseIO::Impl::restoreSummary( RestartValue& rst_value, const std::vector< RestartKey >& extra_keys ) {
+    if (!rst_value.hasExtra( summary_restart_key ))
+        return;
+
+    this->summary.set_restart_vectors( rst_value.getExtra( summary_restart_key ));
+    if (hasKey( extra_keys, summary_restart_key ))
+        return;
+
+    auto& extra = rst_value.extra;
+    extra.erase( std::remove_if( extra.begin(), extra.end(),
+                                 []( const std::pair< RestartKey, std::vector< double > >& pair ) {
+                                     return pair.first.key == summary_restart_key;
+                                 }),
+                 extra.end() );
+}
+
+
+bool EclipseIO::Impl::asyncOutput() const {
+    return this->output_thread.joinable();
+}
+
+
+void EclipseIO::Impl::startOutputThread( std::size_t maxQueued ) {
+    std::unique_lock< std::mutex > lock( this->output_mutex );
+    this->max_queued = std::max( maxQueued, std::size_t( 1 ) );
+    if (this->output_thread.joinable())
+        return;
+
+    this->output_stop = false;
+    this->output_thread = std::thread( &EclipseIO::Impl::outputLoop, this );
+}
+
+
+/*
+  Writes all the queued report steps and stops the thread; the first
+  error from the output thread, if any, is rethrown.
+*/
+void EclipseIO::Impl::stopOutputThread() {
+    if (!this->output_thread.joinable())
+        return;
+
+    {
+        std::unique_lock< std::mutex > lock( this->output_mutex );
+        this->output_stop = true;
+    }
+    this->output_queued.notify_one();
+    this->output_thread.join();
+
+    std::unique_lock< std::mutex > lock( this->output_mutex );
+    this->rethrowOutputError();
+}
+
+
+void EclipseIO::Impl::outputLoop() {
+    std::unique_lock< std::mutex > lock( this->output_mutex );
+    while (true) {
+        this->output_queued.wait( lock, [this] { return this->output_stop || !this->output_queue.empty(); } );
+        if (this->output_queue.empty())
+            return;
+
+        auto step = std::move( this->output_queue.front() );
+        this->output_queue.pop_front();
+        Metrics::gauge( "output queue", this->output_queue.size() );
+        const bool skip = bool( this->output_error );
+        this->output_busy = true;
+        this->output_written.notify_all();
+        lock.unlock();
+
+        std::exception_ptr error;
+        if (!skip) {
+            try {
+                this->writeTimeStep( step->report_step,
+                                     step->isSubstep,
+                                     step->secs_elapsed,
+                                     step->value,
+                                     step->single_values,
+                                     step->region_values,
+                                     step->block_values,
+                                     step->write_double );
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        step.reset();
+
+        lock.lock();
+        if (error && !this->output_error)
+            this->output_error = error;
+
+        this->output_busy = false;
+        this->output_written.notify_all();
+    }
+}
+
+
+/* Must be called with output_mutex held. */
+void EclipseIO::Impl::rethrowOutputError() {
+    if (!this->output_error)
+        return;
+
+    auto error = this->output_error;
+    this->output_error = nullptr;
+    std::rethrow_exception( error );
+}
+
+
+void EclipseIO::Impl::enqueue( std::unique_ptr< OutputStep > step ) {
+    std::unique_lock< std::mutex > lock( this->output_mutex );
+    this->output_written.wait( lock, [this] {
+            return this->output_error || this->output_queue.size() < this->max_queued;
+        });
+
+    this->rethrowOutputError();
+    this->output_queue.push_back( std::move( step ) );
+    Metrics::gauge( "output queue", this->output_queue.size() );
+    lock.unlock();
+    this->output_queued.notify_one();
+}
+
+
+void EclipseIO::Impl::flush() {
+    if (!this->output_thread.joinable())
+        return;
+
+    std::unique_lock< std::mutex > lock( this->output_mutex );
+    this->output_written.wait( lock, [this] {
+            return this->output_queue.empty() && !this->output_busy;
+        });
+
+    this->rethrowOutputError();
+}
 
-void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<std::string, std::vector<int> > int_data, const NNC& nnc) const {
+
+void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, const std::map<std::string, std::vector<int> >& int_data, const NNC& nnc) const {
     const auto& units = this->es.getUnits();
     const IOConfig& ioConfig = this->es.cfg().io();
 
@@ -246,31 +592,104 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
                         ECL_ENDIAN_FLIP );
 
 
-    // Write INIT header. Observe that the PORV vector is treated
-    // specially; that is because for this particulat vector we write
-    // a total of nx*ny*nz values, where the PORV vector has been
-    // explicitly set to zero for inactive cells. The convention is
-    // that the active/inactive cell mapping can be inferred by
-    // reading the PORV vector.
-    {
-
-        const auto& opm_data = this->es.get3DProperties().getDoubleGridProperty("PORV").getData();
-        auto ecl_data = opm_data;
-
-        for (size_t global_index = 0; global_index < opm_data.size(); global_index++)
-            if (!this->grid.cellActive( global_index ))
-                ecl_data[global_index] = 0;
-
+    /*
+      The property arrays are compressed and converted to output units
+      in the background while the header and the grid arrays are
+      written. The lazily evaluated properties and the active map of
+      the grid are materialised here first, so the background tasks
+      only read shared data.
+    */
+    using double_kw = std::pair<std::string, UnitSystem::measure>;
+    /*
+      This is a rather arbitrary hardcoded list of 3D keywords
+      which are written to the INIT file, if they are in the
+      current EclipseState.
+    */
+    const std::vector<double_kw> doubleKeywords = {{"PORO"  , UnitSystem::measure::identity },
+                                                   {"PERMX" , UnitSystem::measure::permeability },
+                                                   {"PERMY" , UnitSystem::measure::permeability },
+                                                   {"PERMZ" , UnitSystem::measure::permeability },
+                                                   {"NTG"   , UnitSystem::measure::identity }};
+
+    const auto& doubleProperties = this->es.get3DProperties().getDoubleProperties();
+    const auto& intProperties = this->es.get3DProperties().getIntProperties();
+
+    // The INIT file should always contain the NTG property, we
+    // therefor invoke the auto create functionality to ensure
+    // that "NTG" is included in the properties container.
+    doubleProperties.assertKeyword("NTG");
+
+    // It seems that the INIT file should always contain these
+    // keywords, we therefor call getKeyword() here to invoke the
+    // autocreation property, and ensure that the keywords exist
+    // in the properties container.
+    intProperties.assertKeyword("PVTNUM");
+    intProperties.assertKeyword("SATNUM");
+    intProperties.assertKeyword("EQLNUM");
+    intProperties.assertKeyword("FIPNUM");
+
+    const auto& porv = doubleProperties.getKeyword("PORV").getData();
+    std::vector<const GridProperty<double>*> doubleInput;
+    for (const auto& kw_pair : doubleKeywords) {
+        if (doubleProperties.hasKeyword( kw_pair.first)) {
+            doubleInput.push_back( &doubleProperties.getKeyword(kw_pair.first) );
+            doubleInput.back()->getData();
+        }
+        else
+            doubleInput.push_back( nullptr );
+    }
 
-        ecl_init_file_fwrite_header( fortio.get(),
-                                     this->grid.c_ptr(),
-                                     NULL,
-                                     units.getEclType(),
-                                     this->es.runspec( ).eclPhaseMask( ),
-                                     this->schedule.posixStartTime( ));
+    std::vector<const GridProperty<int>*> intInput;
+    for (const auto& property : intProperties) {
+        intInput.push_back( &property );
+        property.getData();
+    }
 
-        units.from_si( UnitSystem::measure::volume, ecl_data );
-        writeKeyword( fortio, "PORV" , ecl_data );
+    auto doubleData = std::async(std::launch::async, [this, &doubleKeywords, &doubleInput, &units]() {
+        std::vector<std::vector<double>> ecl_data( doubleInput.size() );
+        for (size_t index = 0; index < doubleInput.size(); index++) {
+            if (doubleInput[index]) {
+                ecl_data[index] = doubleInput[index]->compressedCopy( this->grid );
+                units.from_si( doubleKeywords[index].second, ecl_data[index] );
+            }
+        }
+        return ecl_data;
+    });
+
+    auto intData = std::async(std::launch::async, [this, &intInput]() {
+        std::vector<std::vector<int>> ecl_data;
+        for (const auto* property : intInput)
+            ecl_data.push_back( property->compressedCopy( this->grid ) );
+        return ecl_data;
+    });
+
+    // Write INIT header.
+    ecl_init_file_fwrite_header( fortio.get(),
+                                 this->grid.c_ptr(),
+                                 NULL,
+                                 units.getEclType(),
+                                 this->es.runspec( ).eclPhaseMask( ),
+                                 this->schedule.posixStartTime( ));
+
+    // Observe that the PORV vector is treated specially; that is
+    // because for this particulat vector we write a total of
+    // nx*ny*nz values, where the PORV vector has been explicitly set
+    // to zero for inactive cells. The convention is that the
+    // active/inactive cell mapping can be inferred by reading the
+    // PORV vector. The values are converted and the inactive cells
+    // zeroed as they are written, the writer passes consecutive
+    // ranges of porv to the conversion.
+    {
+        const double* first = porv.data();
+        const auto& grid = this->grid;
+        writeKeyword( fortio, "PORV" , porv,
+                      [first, &grid, &units](const double* src, double* dst, std::size_t n) {
+                          const std::size_t offset = src - first;
+                          for (std::size_t i = 0; i < n; i++)
+                              dst[i] = grid.cellActive( offset + i )
+                                  ? units.from_si( UnitSystem::measure::volume, src[i] )
+                                  : 0;
+                      });
     }
 
     // Writing quantities which are calculated by the grid to the INIT file.
@@ -279,41 +698,45 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
 
     // Write properties from the input deck.
     {
-        const auto& properties = this->es.get3DProperties().getDoubleProperties();
-        using double_kw = std::pair<std::string, UnitSystem::measure>;
-        /*
-          This is a rather arbitrary hardcoded list of 3D keywords
-          which are written to the INIT file, if they are in the
-          current EclipseState.
-        */
-        std::vector<double_kw> doubleKeywords = {{"PORO"  , UnitSystem::measure::identity },
-                                                 {"PERMX" , UnitSystem::measure::permeability },
-                                                 {"PERMY" , UnitSystem::measure::permeability },
-                                                 {"PERMZ" , UnitSystem::measure::permeability },
-                                                 {"NTG"   , UnitSystem::measure::identity }};
-
-        // The INIT file should always contain the NTG property, we
-        // therefor invoke the auto create functionality to ensure
-        // that "NTG" is included in the properties container.
-        properties.assertKeyword("NTG");
-
-        for (const auto& kw_pair : doubleKeywords) {
-            if (properties.hasKeyword( kw_pair.first)) {
-                const auto& opm_property = properties.getKeyword(kw_pair.first);
-                auto ecl_data = opm_property.compressedCopy( this->grid );
-
-                units.from_si( kw_pair.second, ecl_data );
-                writeKeyword( fortio, kw_pair.first, ecl_data );
-            }
+        const auto ecl_data = doubleData.get();
+        for (size_t index = 0; index < doubleKeywords.size(); index++) {
+            if (doubleInput[index])
+                writeKeyword( fortio, doubleKeywords[index].first, ecl_data[index] );
         }
     }
 
 
     // Write properties which have been initialized by the simulator.
+    // The properties are converted to output units as they are
+    // written; an active sized property is written straight from the
+    // simulator's vector, and a global sized property is compressed
+    // into one buffer shared by all the properties.
     {
+        const auto num_active = this->grid.getNumActive();
+        const auto& active_map = this->grid.getActiveMap();
+        std::vector<double> compressed;
         for (const auto& prop : simProps) {
-            auto ecl_data = this->grid.compressedVector( prop.second.data );
-            writeKeyword( fortio, prop.first, ecl_data );
+            const auto& data = prop.second.data;
+            const auto dim = prop.second.dim;
+
+            const std::vector<double>* ecl_data = &data;
+            if (data.size() != num_active) {
+                if (data.size() != this->grid.getCartesianSize())
+                    throw std::invalid_argument("Input vector must have full size");
+
+                compressed.resize( num_active );
+                for (std::size_t i = 0; i < num_active; i++)
+                    compressed[i] = data[ active_map[i] ];
+                ecl_data = &compressed;
+            }
+
+            if (simProps.isSI() && dim != UnitSystem::measure::identity)
+                writeKeyword( fortio, prop.first, *ecl_data,
+                              [&units, dim](const double* src, double* dst, std::size_t n) {
+                                  units.from_si( dim, src, dst, n );
+                              });
+            else
+                writeKeyword( fortio, prop.first, *ecl_data );
         }
     }
 
@@ -330,21 +753,9 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
 
     // Write all integer field properties from the input deck.
     {
-        const auto& properties = this->es.get3DProperties().getIntProperties();
-
-        // It seems that the INIT file should always contain these
-        // keywords, we therefor call getKeyword() here to invoke the
-        // autocreation property, and ensure that the keywords exist
-        // in the properties container.
-        properties.assertKeyword("PVTNUM");
-        properties.assertKeyword("SATNUM");
-        properties.assertKeyword("EQLNUM");
-        properties.assertKeyword("FIPNUM");
-
-        for (const auto& property : properties) {
-            auto ecl_data = property.compressedCopy( this->grid );
-            writeKeyword( fortio , property.getKeywordName() , ecl_data );
-        }
+        const auto ecl_data = intData.get();
+        for (size_t index = 0; index < intInput.size(); index++)
+            writeKeyword( fortio , intInput[index]->getKeywordName() , ecl_data[index] );
     }
 
 
@@ -361,14 +772,18 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
     }
 
 
-    // Write NNC transmissibilities
+    // Write NNC transmissibilities, converted as they are written.
     {
-        std::vector<double> tran;
-        for( const NNCdata& nd : nnc.nncdata() )
-            tran.push_back( nd.trans );
-
-        units.from_si( UnitSystem::measure::transmissibility , tran );
-        writeKeyword( fortio, "TRANNNC" , tran );
+        const auto& nncdata = nnc.nncdata();
+        std::vector<double> tran( nncdata.size() );
+        std::transform( nncdata.begin(), nncdata.end(), tran.begin(),
+                        []( const NNCdata& nd ) { return nd.trans; } );
+
+        writeKeyword( fortio, "TRANNNC" , tran,
+                      [&units](const double* src, double* dst, std::size_t n) {
+                          for (std::size_t i = 0; i < n; i++)
+                              dst[i] = units.from_si( UnitSystem::measure::transmissibility, src[i] );
+                      });
     }
 }
 
@@ -394,11 +809,12 @@ void EclipseIO::writeInitial( data::Solution simProps, std::map<std::string, std
     if( !this->impl->output_enabled )
         return;
 
+    this->impl->flush();
+
     {
         const auto& es = this->impl->es;
         const IOConfig& ioConfig = es.cfg().io();
 
-        simProps.convertFromSI( es.getUnits() );
         if( ioConfig.getWriteINITFile() )
             this->impl->writeINITFile( simProps , int_data, nnc );
 
@@ -417,15 +833,59 @@ void EclipseIO::writeTimeStep(int report_step,
                               const std::map<std::string, std::vector<double> >& region_summary_values,
                               const std::map<std::pair<std::string, int>, double>& block_summary_values,
                               const bool write_double)
- {
+{
 
     if( !this->impl->output_enabled )
         return;
 
+    value.wells.index_connections();
+    if (this->impl->asyncOutput()) {
+        std::unique_ptr< OutputStep > step( new OutputStep( report_step,
+                                                            isSubstep,
+                                                            secs_elapsed,
+                                                            std::move( value ),
+                                                            single_summary_values,
+                                                            region_summary_values,
+                                                            block_summary_values,
+                                                            write_double ) );
+        this->impl->enqueue( std::move( step ) );
+    } else
+        this->impl->writeTimeStep( report_step,
+                                   isSubstep,
+                                   secs_elapsed,
+                                   value,
+                                   single_summary_values,
+                                   region_summary_values,
+                                   block_summary_values,
+                                   write_double );
+}
+
+
+void EclipseIO::setAsyncOutput( bool enable, std::size_t maxQueued ) {
+    if (enable)
+        this->impl->startOutputThread( maxQueued );
+    else
+        this->impl->stopOutputThread();
+}
+
+
+void EclipseIO::flush() {
+    this->impl->flush();
+}
+
 
-    const auto& es = this->impl->es;
-    const auto& grid = this->impl->grid;
-    const auto& schedule = this->impl->schedule;
+void EclipseIO::Impl::writeTimeStep( int report_step,
+                                     bool  isSubstep,
+                                     double secs_elapsed,
+                                     const RestartValue& value,
+                                     const std::map<std::string, double>& single_summary_values,
+                                     const std::map<std::string, std::vector<double> >& region_summary_values,
+                                     const std::map<std::pair<std::string, int>, double>& block_summary_values,
+                                     const bool write_double)
+{
+    const auto& es = this->es;
+    const auto& grid = this->grid;
+    const auto& schedule = this->schedule;
     const auto& units = es.getUnits();
     const auto& ioConfig = es.getIOConfig();
     const auto& restart = es.cfg().restart();
@@ -433,11 +893,14 @@ void EclipseIO::writeTimeStep(int report_step,
 
 
     /*
-      Summary data is written unconditionally for every timestep except for the
-      very intial report_step==0 call, which is only garbage.
+      Summary data is written for every timestep the recording policy of the
+      IOConfig selects, except for the very intial report_step==0 call, which
+      is only garbage; the other timesteps only update the totals.
     */
-    if (report_step > 0) {
-        this->impl->summary.add_timestep( report_step,
+    if (report_step > 0 && !this->summary.record_timestep( secs_elapsed, isSubstep ))
+        this->summary.skip_timestep( report_step, secs_elapsed, es, schedule, value.wells );
+    else if (report_step > 0) {
+        this->summary.add_timestep( report_step,
                                           secs_elapsed,
                                           es,
                                           schedule,
@@ -445,7 +908,14 @@ void EclipseIO::writeTimeStep(int report_step,
                                           single_summary_values ,
                                           region_summary_values,
                                           block_summary_values);
-        this->impl->summary.write();
+
+        PhaseTimer::Scope phase( "Summary::write" );
+        FileBytesCounter bytes( ERT::EclFilename( this->outputDir,
+                                                  this->baseName,
+                                                  ioConfig.getUNIFOUT() ? ECL_UNIFIED_SUMMARY_FILE : ECL_SUMMARY_FILE,
+                                                  report_step,
+                                                  ioConfig.getFMTOUT() ) );
+        this->summary.write();
     }
 
     /*
@@ -455,13 +925,19 @@ void EclipseIO::writeTimeStep(int report_step,
     */
     if(!isSubstep && restart.getWriteRestartFile(report_step))
     {
-        std::string filename = ERT::EclFilename( this->impl->outputDir,
-                                                 this->impl->baseName,
+        std::string filename = ERT::EclFilename( this->outputDir,
+                                                 this->baseName,
                                                  ioConfig.getUNIFOUT() ? ECL_UNIFIED_RESTART_FILE : ECL_RESTART_FILE,
                                                  report_step,
                                                  ioConfig.getFMTOUT() );
+        PhaseTimer::Scope phase( "EclipseIO::restart" );
+        FileBytesCounter bytes( filename );
+        if (!this->restart_headers)
+            this->restart_headers.reset( new RestartIO::Helpers::StaticHeaders( es, grid ) );
+
         RestartIO::save(filename, report_step, secs_elapsed, value, es, grid, schedule,
-                        this->impl->summary.get_restart_vectors(), write_double);
+                        this->summary.get_restart_vectors(), *this->restart_headers,
+                        this->restart_buffers, write_double);
     }
 
 
@@ -472,24 +948,30 @@ void EclipseIO::writeTimeStep(int report_step,
         return;
 
     {
-        std::vector<const Well*> sched_wells = this->impl->schedule.getWells( report_step );
+        std::vector<const Well*> sched_wells = this->schedule.getWells( report_step );
         const auto rft_active = [report_step] (const Well* w) { return w->getRFTActive( report_step ) || w->getPLTActive( report_step ); };
         if (std::any_of(sched_wells.begin(), sched_wells.end(), rft_active)) {
-            this->impl->rft.writeTimeStep( sched_wells,
+            PhaseTimer::Scope phase( "EclipseIO::rft" );
+            FileBytesCounter bytes( ERT::EclFilename( this->outputDir,
+                                                      this->baseName,
+                                                      ECL_RFT_FILE,
+                                                      ioConfig.getFMTOUT() ) );
+            this->rft.writeTimeStep( sched_wells,
                                            grid,
                                            report_step,
-                                           secs_elapsed + this->impl->schedule.posixStartTime(),
+                                           secs_elapsed + this->schedule.posixStartTime(),
                                            units.from_si( UnitSystem::measure::time, secs_elapsed ),
                                            units,
                                            value.wells );
         }
     }
 
- }
+}
 
 
 
 RestartValue EclipseIO::loadRestart(const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys) const {
+    this->impl->flush();
     const auto& es                       = this->impl->es;
     const auto& grid                     = this->impl->grid;
     const auto& schedule                 = this->impl->schedule;
@@ -500,7 +982,25 @@ RestartValue EclipseIO::loadRestart(const std::vector<RestartKey>& solution_keys
                                                                         report_step,
                                                                         false );
 
-    return RestartIO::load( filename , report_step , solution_keys , es, grid , schedule, extra_keys);
+    auto rst_value = RestartIO::load( filename , report_step , solution_keys , es, grid , schedule,
+                                      this->impl->summaryKeys( extra_keys ));
+    this->impl->restoreSummary( rst_value, extra_keys );
+    return rst_value;
+}
+
+RestartValue EclipseIO::loadRestartInto(const std::vector<RestartBuffer>& solution_buffers, const std::vector<RestartKey>& extra_keys) const {
+    this->impl->flush();
+    const auto& es                       = this->impl->es;
+    const InitConfig& initConfig         = es.getInitConfig();
+    const int report_step                = initConfig.getRestartStep();
+    const std::string filename           = es.getIOConfig().getRestartFileName( initConfig.getRestartRootName(),
+                                                                                report_step,
+                                                                                false );
+
+    auto rst_value = RestartIO::loadInto( filename , report_step , solution_buffers , es, this->impl->grid , this->impl->schedule,
+                                          this->impl->summaryKeys( extra_keys ));
+    this->impl->restoreSummary( rst_value, extra_keys );
+    return rst_value;
 }
 
 EclipseIO::EclipseIO( const EclipseState& es,
@@ -57,48 +57,22 @@ Opm::DifferentiateOutputTable::calcSlopes(const std::size_t      nDep,
         return;
     }
 
-    auto x = table.column(desc.tableID, desc.primID, 0);
+    const auto x = table.column(desc.tableID, desc.primID, 0);
 
-    using colIT = decltype(x);
-
-    auto y  = std::vector<colIT>{};  y .reserve(nDep);
-    auto dy = std::vector<colIT>{};  dy.reserve(nDep);
-    auto y0 = std::vector<double>(nDep);
-    auto y1 = y0;
+    // One dependent column at a time.  The inner loop only reads the
+    // contiguous x and y columns and writes the contiguous derivative
+    // column, which lets the compiler vectorise it.
     for (auto j = 0*nDep; j < nDep; ++j) {
-        y .push_back(table.column(desc.tableID, desc.primID, j + 1 + 0*nDep));
-        dy.push_back(table.column(desc.tableID, desc.primID, j + 1 + 1*nDep));
-
-        y1[j] = *y.back();  ++y.back();
+        const auto y  = table.column(desc.tableID, desc.primID, j + 1 + 0*nDep);
+        const auto dy = table.column(desc.tableID, desc.primID, j + 1 + 1*nDep);
 
         // Store derivatives at right interval end-point.
-        ++dy.back();
-    }
-
-    using std::swap;
-
-    auto x1 = *x;  ++x;  auto x0 = 0 * x1;
-
-    // Recall: Number of slope intervals one less than number of active
-    // table rows.
-    for (auto n = desc.numActRows - 1, i = 0*n; i < n; ++i) {
-        // Save previous right-hand point as this left-hand point, clear
-        // space for new right-hand point.
-        swap(x0, x1);  x1 = *x;  ++x;
-        swap(y0, y1);
-
-        const auto dx = x1 - x0;
-
-        for (auto j = 0*nDep; j < nDep; ++j) {
-            y1[j] = *y[j];
-
-            const auto delta = y1[j] - y0[j];
+        for (auto i = 0*desc.numActRows + 1; i < desc.numActRows; ++i) {
+            const auto dx    = x[i] - x[i - 1];
+            const auto delta = y[i] - y[i - 1];
 
             // Choice for dx==0 somewhat debatable.
-            *dy[j] = (std::abs(dx) > 0.0) ? (delta / dx) : 0.0;
-
-            // Advance column iterators;
-            ++y[j];  ++dy[j];
+            dy[i] = (std::abs(dx) > 0.0) ? (delta / dx) : 0.0;
         }
     }
 }
@@ -37,10 +37,16 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 
+#include <opm/common/utility/ParallelChunks.hpp>
+
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <exception>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -73,16 +79,44 @@ public:
         return this->step_view_;
     }
 
+    /// The keyword of the report step, or the identical one of an
+    /// earlier report step which it refers to; see OPM_REFK.
     const Opm::RestartIO::ecl_kw_type* getKeyword(const char* kw) const
     {
-        namespace Load = Opm::RestartIO;
+        const auto* view = this->viewOf(kw);
 
-        // Main grid only.  Does not handle/support LGR.
-        return Load::ecl_file_view_has_kw       (*this, kw)
-            ?  Load::ecl_file_view_iget_named_kw(*this, kw, 0)
+        return (view != nullptr)
+            ?  Opm::RestartIO::ecl_file_view_iget_named_kw(view, kw, 0)
             :  nullptr;
     }
 
+    /// Number of elements of the keyword, without loading it, or -1
+    /// if it is not in the report step.
+    int keywordSize(const char* kw) const
+    {
+        namespace Load = Opm::RestartIO;
+
+        const auto* view = this->viewOf(kw);
+
+        return (view != nullptr)
+            ?  Load::ecl_file_kw_get_size(Load::ecl_file_view_iget_named_file_kw(view, kw, 0))
+            :  -1;
+    }
+
+    /// Read the elements 'cells' of the floating point keyword into
+    /// 'data', seeking to them in the file rather than loading the
+    /// whole keyword.  False if the keyword is missing or can not be
+    /// read in part, e.g. from a formatted file.
+    bool readCells(const char*                     kw,
+                   const std::vector<std::size_t>& cells,
+                   double*                         data) const
+    {
+        const auto* view = this->viewOf(kw);
+
+        return (view != nullptr)
+            && Opm::RestartIO::ecl_file_view_index_fread_kw(view, kw, 0, cells.data(), cells.size(), data);
+    }
+
 private:
     using RstFile = Opm::RestartIO::ert_unique_ptr<
         Opm::RestartIO::ecl_file_type,
@@ -92,6 +126,29 @@ private:
     RstFile                             rst_file_;
     Opm::RestartIO::ecl_file_view_type* step_view_ = nullptr;
 
+    /// The views of the earlier report steps which hold the arrays
+    /// that the report step refers to, by keyword.
+    std::map<std::string, Opm::RestartIO::ecl_file_view_type*> references_;
+
+    void resolveReferences(const std::string& filename);
+
+    /// The view which holds the keyword of the report step; see
+    /// getKeyword().
+    const Opm::RestartIO::ecl_file_view_type* viewOf(const char* kw) const
+    {
+        namespace Load = Opm::RestartIO;
+
+        // Main grid only.  Does not handle/support LGR.
+        if (Load::ecl_file_view_has_kw(*this, kw))
+            return *this;
+
+        const auto ref = this->references_.find(kw);
+        if ((ref == this->references_.end()) || ! Load::ecl_file_view_has_kw(ref->second, kw))
+            return nullptr;
+
+        return ref->second;
+    }
+
     operator Opm::RestartIO::ecl_file_type*()
     {
         return this->rst_file_.get();
@@ -128,12 +185,53 @@ RestartFileView::RestartFileView(const std::string& filename,
             + std::to_string(report_step)
         };
     }
+
+    this->resolveReferences(filename);
+}
+
+void RestartFileView::resolveReferences(const std::string& filename)
+{
+    namespace Load = Opm::RestartIO;
+
+    if (! Load::ecl_file_view_has_kw(this->step_view_, "OPM_REFK"))
+        return;
+
+    const auto* keys  = Load::ecl_file_view_iget_named_kw(this->step_view_, "OPM_REFK", 0);
+    const auto* steps = Load::ecl_file_view_iget_named_kw(this->step_view_, "OPM_REFS", 0);
+    const auto  size  = Load::ecl_kw_get_size(keys);
+    if (Load::ecl_kw_get_size(steps) != size) {
+        throw std::runtime_error {
+            "Restart file '" + filename + "': OPM_REFK and OPM_REFS differ in size"
+        };
+    }
+
+    const auto* report_steps = Load::ecl_kw_get_type_ptr<int>(steps, Load::ECL_INT_TYPE);
+
+    std::map<int, Load::ecl_file_view_type*> views;
+    for (int i = 0; i < size; ++i) {
+        auto key = std::string(Load::ecl_kw_iget_char_ptr(keys, i));
+        key.erase(key.find_last_not_of(' ') + 1);
+
+        auto& view = views[report_steps[i]];
+        if (view == nullptr)
+            view = Load::ecl_file_get_restart_view(*this, -1, report_steps[i], -1, -1);
+
+        if (view == nullptr) {
+            throw std::runtime_error {
+                "Restart file '" + filename + "': " + key + " refers to report step "
+                + std::to_string(report_steps[i]) + ", which is not in the file"
+            };
+        }
+
+        this->references_[key] = view;
+    }
 }
 
 RestartFileView::RestartFileView(RestartFileView&& rhs)
     : sim_step_ (rhs.sim_step_)            // Scalar (size_t)
     , rst_file_ (std::move(rhs.rst_file_))
     , step_view_(rhs.step_view_)           // Pointer
+    , references_(std::move(rhs.references_))
 {}
 
 RestartFileView& RestartFileView::operator=(RestartFileView&& rhs)
@@ -141,6 +239,7 @@ RestartFileView& RestartFileView::operator=(RestartFileView&& rhs)
     this->sim_step_  = rhs.sim_step_;            // Scalar (size_t)
     this->rst_file_  = std::move(rhs.rst_file_);
     this->step_view_ = rhs.step_view_;           // Pointer copy
+    this->references_ = std::move(rhs.references_);
 
     return *this;
 }
@@ -212,6 +311,114 @@ namespace {
         return sol;
     }
 
+    template <typename T>
+    void gatherToSI(const T*                    ecl_data,
+                    const Opm::RestartBuffer&   buffer,
+                    const Opm::UnitSystem&      usys)
+    {
+        if (buffer.cells.empty()) {
+            for (std::size_t i = 0; i < buffer.size; ++i)
+                buffer.data[i] = ecl_data[i];
+        }
+        else {
+            for (std::size_t i = 0; i < buffer.size; ++i)
+                buffer.data[i] = ecl_data[buffer.cells[i]];
+        }
+
+        usys.to_si(buffer.key.dim, buffer.data, buffer.data, buffer.size);
+    }
+
+    void restoreBuffer(const ::Opm::RestartIO::ecl_kw_type* ecl_kw,
+                       const Opm::RestartBuffer&            buffer,
+                       const Opm::UnitSystem&               usys)
+    {
+        namespace Load = ::Opm::RestartIO;
+
+        if (Load::ecl_type_get_type(Load::ecl_kw_get_data_type(ecl_kw)) == Load::ECL_DOUBLE_TYPE)
+            gatherToSI(Load::ecl_kw_get_type_ptr<double>(ecl_kw, Load::ECL_DOUBLE_TYPE), buffer, usys);
+        else
+            gatherToSI(Load::ecl_kw_get_type_ptr<float>(ecl_kw, Load::ECL_FLOAT_TYPE), buffer, usys);
+    }
+
+    void restoreSOLUTION(const RestartFileView&                 rst_view,
+                         const std::vector<Opm::RestartBuffer>& solution_buffers,
+                         const int                              numcells,
+                         const Opm::UnitSystem&                 usys)
+    {
+        // A null keyword means the cells of the buffer have already been
+        // read from the file and only the unit conversion remains.
+        using Job = std::pair<const Opm::RestartBuffer*,
+                              const Opm::RestartIO::ecl_kw_type*>;
+
+        // The keywords are read from the file one at a time; the decoding
+        // and unit conversion which follow are independent per buffer.  A
+        // buffer with a list of cells reads only those cells of the
+        // keyword, so a rank of a parallel run does not load the arrays of
+        // the whole grid.
+        std::vector<Job> jobs;
+        for (const auto& buffer : solution_buffers) {
+            const auto& vector = buffer.key.key;
+            const auto  size   = rst_view.keywordSize(vector.c_str());
+
+            if (size < 0) {
+                throwIfMissingRequired(buffer.key);
+                continue;
+            }
+
+            if (size != numcells) {
+                throw std::runtime_error {
+                    "Restart file: Could not restore "
+                    + vector + ", mismatched number of cells"
+                };
+            }
+
+            const auto outside = [numcells](const std::size_t cell)
+            {
+                return cell >= static_cast<std::size_t>(numcells);
+            };
+
+            if ((buffer.cells.empty() && (buffer.size > static_cast<std::size_t>(numcells)))
+                || std::any_of(buffer.cells.begin(), buffer.cells.end(), outside))
+            {
+                throw std::invalid_argument {
+                    "Restart buffer for " + vector
+                    + " refers to cells outside the active grid"
+                };
+            }
+
+            if (! buffer.cells.empty() &&
+                rst_view.readCells(vector.c_str(), buffer.cells, buffer.data))
+            {
+                jobs.emplace_back(&buffer, nullptr);
+                continue;
+            }
+
+            jobs.emplace_back(&buffer, rst_view.getKeyword(vector.c_str()));
+        }
+
+        const auto restore = [](const Job& job, const Opm::UnitSystem& units)
+        {
+            const auto& buffer = *job.first;
+
+            if (job.second == nullptr)
+                units.to_si(buffer.key.dim, buffer.data, buffer.data, buffer.size);
+            else
+                restoreBuffer(job.second, buffer, units);
+        };
+
+        std::vector<std::future<void>> tasks;
+        for (std::size_t j = 1; j < jobs.size(); ++j) {
+            tasks.push_back(std::async(std::launch::async, restore,
+                                       std::cref(jobs[j]), std::cref(usys)));
+        }
+
+        if (! jobs.empty())
+            restore(jobs[0], usys);
+
+        for (auto& task : tasks)
+            task.get();
+    }
+
     void restoreExtra(const RestartFileView&              rst_view,
                       const std::vector<Opm::RestartKey>& extra_keys,
                       const Opm::UnitSystem&              usys,
@@ -433,25 +640,52 @@ namespace {
                              conn, wdim.maxConnPerWell);
     }
 
-    std::unordered_map<std::size_t, boost::iterator_range<const double*>::size_type>
+    /// Connection position in the result set, indexed by the connection's
+    /// sequence index.  Sequence indices without a connection map to
+    /// noConnection.
+    const auto noConnection = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t>
     seqID_to_resID(const WellArrayDim& wdim,
                    const std::size_t   wellID,
                    const std::size_t   nConn,
                    const int*          icon_full)
     {
-        using SizeT    = boost::iterator_range<const double*>::size_type;
-        auto  seqToRes = std::unordered_map<std::size_t, SizeT>{};
+        auto seqToRes = std::vector<std::size_t>(nConn, noConnection);
 
         for (auto connID = 0*nConn; connID < nConn; ++connID) {
             const auto icon =
                 getIConWindow(icon_full, wdim, wellID, connID);
 
-            seqToRes.emplace(icon[VI::IConn::index::SeqIndex] - 1, connID);
+            const auto seqID = icon[VI::IConn::index::SeqIndex] - 1;
+            if (seqID < 0) { continue; }
+
+            const auto seq = static_cast<std::size_t>(seqID);
+            if (seq >= seqToRes.size()) {
+                seqToRes.resize(seq + 1, noConnection);
+            }
+
+            if (seqToRes[seq] == noConnection) {
+                seqToRes[seq] = connID;
+            }
         }
 
         return seqToRes;
     }
 
+    std::size_t resID(const std::vector<std::size_t>& seqToRes,
+                      const std::size_t               seqID)
+    {
+        if ((seqID >= seqToRes.size()) || (seqToRes[seqID] == noConnection)) {
+            throw std::out_of_range {
+                "Restart file: No connection with sequence index "
+                + std::to_string(seqID + 1)
+            };
+        }
+
+        return seqToRes[seqID];
+    }
+
     void restoreConnRates(const Opm::Well&        well,
                           const std::size_t       wellID,
                           const std::size_t       sim_step,
@@ -489,7 +723,7 @@ namespace {
 
         auto linConnID = std::size_t{0};
         for (const auto& conn : conns) {
-            const auto connID = seq_to_res.at(conn.getSeqIndex());
+            const auto connID = resID(seq_to_res, conn.getSeqIndex());
             const auto xcon   =
                 getXConWindow(xcon_full, wdim, wellID, connID);
 
@@ -574,6 +808,15 @@ namespace {
         return xw;
     }
 
+    /// Calls wellOp(wellID) for all wells, in parallel.  Every well
+    /// only reads the result set and writes its own slot, so the wells
+    /// are independent.
+    template <typename WellOp>
+    void wellLoop(const std::size_t numWells, WellOp&& wellOp)
+    {
+        Opm::forEachPosition(numWells, 64, wellOp);
+    }
+
     Opm::data::Wells
     restore_wells_ecl(const RestartFileView&     rst_view,
                       const ::Opm::EclipseState& es,
@@ -601,14 +844,22 @@ namespace {
 
         const auto  sim_step = rst_view.simStep();
         const auto& wells    = schedule.getWells(sim_step);
+
+        // Restore into one preallocated slot per well, then move the
+        // slots into the result map.
+        auto slots = std::vector<Opm::data::Well>(wells.size());
+        wellLoop(wells.size(), [&](const std::size_t wellID)
+        {
+            slots[wellID] =
+                restore_well(*wells[wellID], wellID, sim_step, grid, wdim,
+                             units, phases, iwel_full, xwel_full,
+                             icon_full, xcon_full);
+        });
+
         for (auto nWells = wells.size(), wellID = 0*nWells;
              wellID < nWells; ++wellID)
         {
-            const auto* well = wells[wellID];
-
-            soln[well->name()] =
-                restore_well(*well, wellID, sim_step, grid, wdim, units, phases,
-                             iwel_full, xwel_full, icon_full, xcon_full);
+            soln[wells[wellID]->name()] = std::move(slots[wellID]);
         }
 
         return soln;
@@ -633,7 +884,7 @@ namespace Opm { namespace RestartIO  {
 
         xr.convertToSI(es.getUnits());
 
-        auto xw = Opm::RestartIO::ecl_file_view_has_kw(rst_view, "OPM_XWEL")
+        auto xw = (rst_view.getKeyword("OPM_XWEL") != nullptr)
             ? restore_wells_opm(rst_view, es, grid, schedule)
             : restore_wells_ecl(rst_view, es, grid, schedule);
 
@@ -645,4 +896,31 @@ namespace Opm { namespace RestartIO  {
 
         return rst_value;
     }
+
+    RestartValue
+    loadInto(const std::string&               filename,
+             int                              report_step,
+             const std::vector<RestartBuffer>& solution_buffers,
+             const EclipseState&              es,
+             const EclipseGrid&               grid,
+             const Schedule&                  schedule,
+             const std::vector<RestartKey>&   extra_keys)
+    {
+        const auto rst_view = RestartFileView{ filename, report_step };
+
+        restoreSOLUTION(rst_view, solution_buffers,
+                        grid.getNumActive(), es.getUnits());
+
+        auto xw = (rst_view.getKeyword("OPM_XWEL") != nullptr)
+            ? restore_wells_opm(rst_view, es, grid, schedule)
+            : restore_wells_ecl(rst_view, es, grid, schedule);
+
+        auto rst_value = RestartValue{ data::Solution{}, std::move(xw) };
+
+        if (! extra_keys.empty()) {
+            restoreExtra(rst_view, extra_keys, es.getUnits(), rst_value);
+        }
+
+        return rst_value;
+    }
 }} // Opm::RestartIO
@@ -16,6 +16,10 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellConnections.hpp>
@@ -30,9 +34,74 @@
 namespace Opm {
 namespace out {
 
-RegionCache::RegionCache(const Eclipse3DProperties& properties, const EclipseGrid& grid, const Schedule& schedule) {
-    const auto& fipnum = properties.getIntGridProperty("FIPNUM");
+namespace {
+
+    /*
+      Stable counting sort of the items by region; returns the offsets
+      array with max_region + 2 elements and reorders the items.
+    */
+    template <typename T>
+    std::vector<std::size_t> compress(const std::vector<int>& item_regions, std::vector<T>& items) {
+        int max_region = 0;
+        for (const auto region : item_regions)
+            max_region = std::max(max_region, region);
+
+        std::vector<std::size_t> offsets(max_region + 2, 0);
+        for (const auto region : item_regions)
+            offsets[region + 1] += 1;
+
+        for (std::size_t r = 1; r < offsets.size(); r++)
+            offsets[r] += offsets[r - 1];
+
+        std::vector<T> sorted(items.size());
+        auto next = offsets;
+        for (std::size_t index = 0; index < items.size(); index++)
+            sorted[next[item_regions[index]]++] = std::move(items[index]);
+
+        items = std::move(sorted);
+        return offsets;
+    }
 
+}
+
+
+RegionCache::RegionCache(const Eclipse3DProperties& properties, const EclipseGrid& grid, const Schedule& schedule) :
+    RegionCache(properties, grid, schedule, {"FIPNUM"})
+{}
+
+
+RegionCache::RegionCache(const Eclipse3DProperties& properties,
+                         const EclipseGrid& grid,
+                         const Schedule& schedule,
+                         const std::vector<std::string>& region_set_names) :
+    num_active(grid.getNumActive())
+{
+    for (const auto& name : region_set_names) {
+        // Read through iget(), which does not widen a compacted property.
+        const auto& property = properties.getIntGridProperty(name);
+        std::vector<int> cell_regions;
+        std::vector<std::size_t> cells;
+        for (std::size_t active_index = 0; active_index < this->num_active; active_index++) {
+            const int region_id = property.iget(grid.getGlobalIndex(active_index));
+            if (region_id > 0) {
+                cell_regions.push_back(region_id);
+                cells.push_back(active_index);
+            }
+        }
+
+        RegionSet region_set;
+        region_set.offsets = compress(cell_regions, cells);
+        region_set.cells = std::move(cells);
+        for (std::size_t r = 1; r + 1 < region_set.offsets.size(); r++) {
+            if (region_set.offsets[r + 1] > region_set.offsets[r])
+                region_set.regions.push_back(static_cast<int>(r));
+        }
+
+        this->region_sets[name] = std::move(region_set);
+    }
+
+    const auto& fipnum = properties.getIntGridProperty("FIPNUM");
+    std::vector<int> connection_regions;
     const auto& wells = schedule.getWells();
     for (const auto& well : wells) {
         const auto& connections = well->getConnections( );
@@ -40,21 +109,116 @@ RegionCache::RegionCache(const Eclipse3DProperties& properties, const EclipseGri
             size_t global_index = grid.getGlobalIndex( c.getI() , c.getJ() , c.getK());
             if (grid.cellActive( global_index )) {
                 size_t active_index = grid.activeIndex( global_index );
-                int region_id =fipnum.iget( global_index );
-                auto& well_index_list = this->connection_map[ region_id ];
-                well_index_list.push_back( { well->name() , active_index } );
+                int region_id = fipnum.iget( global_index );
+                if (region_id > 0) {
+                    connection_regions.push_back( region_id );
+                    this->connection_list.push_back( { well->name() , active_index } );
+                }
             }
         }
     }
+    this->connection_offsets = compress(connection_regions, this->connection_list);
 }
 
 
-    const std::vector<std::pair<std::string,size_t>>& RegionCache::connections( int region_id ) const {
-        const auto iter = this->connection_map.find( region_id );
-        if (iter == this->connection_map.end())
-            return this->connections_empty;
-        else
-            return iter->second;
+    RegionCache::Range<std::pair<std::string,size_t>> RegionCache::connections( int region_id ) const {
+        if (region_id < 0 || static_cast<std::size_t>(region_id) + 1 >= this->connection_offsets.size())
+            return { nullptr, nullptr };
+
+        const auto* data = this->connection_list.data();
+        return { data + this->connection_offsets[region_id], data + this->connection_offsets[region_id + 1] };
+    }
+
+
+    bool RegionCache::hasRegionSet(const std::string& region_set) const {
+        return this->region_sets.count(region_set) > 0;
+    }
+
+
+    const RegionCache::RegionSet& RegionCache::regionSet(const std::string& region_set) const {
+        const auto iter = this->region_sets.find(region_set);
+        if (iter == this->region_sets.end())
+            throw std::invalid_argument("The region set " + region_set + " is not in the region cache");
+
+        return iter->second;
+    }
+
+
+    const std::vector<int>& RegionCache::regions(const std::string& region_set) const {
+        return this->regionSet(region_set).regions;
+    }
+
+
+    int RegionCache::maxRegion(const std::string& region_set) const {
+        return static_cast<int>(this->regionSet(region_set).offsets.size()) - 2;
+    }
+
+
+    RegionCache::Range<std::size_t> RegionCache::cells(const std::string& region_set, int region_id) const {
+        const auto& rs = this->regionSet(region_set);
+        if (region_id < 0 || static_cast<std::size_t>(region_id) + 1 >= rs.offsets.size())
+            return { nullptr, nullptr };
+
+        const auto* data = rs.cells.data();
+        return { data + rs.offsets[region_id], data + rs.offsets[region_id + 1] };
+    }
+
+
+    std::vector<double> RegionCache::reduce(const std::vector<double>& values, const std::string& region_set) const {
+        if (values.size() != this->num_active)
+            throw std::invalid_argument("The values to reduce must have one element per active cell");
+
+        const auto& rs = this->regionSet(region_set);
+        std::vector<double> result(rs.offsets.size() - 2, 0);
+        for (const auto region_id : rs.regions) {
+            double sum = 0;
+            for (std::size_t index = rs.offsets[region_id]; index < rs.offsets[region_id + 1]; index++)
+                sum += values[rs.cells[index]];
+
+            result[region_id - 1] = sum;
+        }
+        return result;
+    }
+
+
+    std::vector<double> RegionCache::average(const std::vector<double>& values,
+                                             const std::vector<double>& weights,
+                                             const std::string& region_set) const {
+        if (values.size() != this->num_active || weights.size() != this->num_active)
+            throw std::invalid_argument("The values and weights to average must have one element per active cell");
+
+        const auto& rs = this->regionSet(region_set);
+        std::vector<double> result(rs.offsets.size() - 2, 0);
+        for (const auto region_id : rs.regions) {
+            double sum = 0;
+            double weight_sum = 0;
+            for (std::size_t index = rs.offsets[region_id]; index < rs.offsets[region_id + 1]; index++) {
+                const auto cell = rs.cells[index];
+                sum += values[cell] * weights[cell];
+                weight_sum += weights[cell];
+            }
+
+            if (weight_sum > 0)
+                result[region_id - 1] = sum / weight_sum;
+        }
+        return result;
+    }
+
+
+    std::size_t RegionCache::memory_usage() const {
+        std::size_t bytes = MemoryUsage::heap(this->connection_offsets)
+                          + MemoryUsage::heap(this->connection_list);
+
+        for (const auto& conn : this->connection_list)
+            bytes += MemoryUsage::heap(conn.first);
+
+        for (const auto& pair : this->region_sets)
+            bytes += sizeof(pair) + MemoryUsage::heap(pair.first)
+                   + MemoryUsage::heap(pair.second.regions)
+                   + MemoryUsage::heap(pair.second.offsets)
+                   + MemoryUsage::heap(pair.second.cells);
+
+        return bytes;
     }
 
 }
@@ -28,10 +28,13 @@
 #include <opm/output/eclipse/AggregateWellData.hpp>
 #include <opm/output/eclipse/AggregateConnectionData.hpp>
 #include <opm/output/eclipse/AggregateMSWData.hpp>
+#include <opm/output/eclipse/ArrayWriter.hpp>
 #include <opm/output/eclipse/WriteRestartHelpers.hpp>
 
 #include <opm/output/eclipse/libECLRestart.hpp>
 
+#include <opm/common/OpmLog/PhaseTimer.hpp>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -42,7 +45,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -138,15 +147,8 @@ namespace {
 
                 const auto active_index = grid.activeIndex(i, j, k);
 
-                const auto& connection =
-                    std::find_if(well.connections.begin(),
-                                 well.connections.end(),
-                        [active_index](const data::Connection& c)
-                    {
-                        return c.index == active_index;
-                    });
-
-                if (connection == well.connections.end()) {
+                const auto* connection = well.find_connection(active_index);
+                if (connection == nullptr) {
                     xwel.insert( xwel.end(), rs_size, 0.0 );
                     continue;
                 }
@@ -201,63 +203,175 @@ namespace {
         }
     }
 
-    ert_unique_ptr<ecl_rst_file_type, ecl_rst_file_close>
-    openRestartFile(const std::string& filename,
-                    const int          report_step)
+    /*
+      The solution and extra arrays are encoded straight into the buffer
+      of a writer on the stream of the restart file, converted from SI
+      to the output units on the way, instead of being copied into an
+      ecl_kw first. The writer is flushed before ERT writes to the
+      file again.
+    */
+    void writeField(Helpers::ArrayWriter&      writer,
+                    const std::string&         key,
+                    const std::vector<double>& data,
+                    const bool                 write_double,
+                    const UnitSystem&          units,
+                    const UnitSystem::measure  dim)
     {
-        auto rst_file = ::Opm::RestartIO::
-            ert_unique_ptr< ::Opm::RestartIO::ecl_rst_file_type,
-                            ::Opm::RestartIO::ecl_rst_file_close>{};
+        using Type = Helpers::ArrayWriter::Type;
+        const auto type = write_double ? Type::Double : Type::Float;
 
-        if (::Opm::RestartIO::EclFiletype(filename) == ECL_UNIFIED_RESTART_FILE)
-            rst_file.reset(::Opm::RestartIO::ecl_rst_file_open_write_seek(filename.c_str(),
-                                                                          report_step));
-        else
-            rst_file.reset(::Opm::RestartIO::ecl_rst_file_open_write(filename.c_str()));
+        if (dim == UnitSystem::measure::identity) {
+            writer.write(key, data, type);
+            return;
+        }
 
-        return rst_file;
+        writer.write(key, data, type,
+                     [&units, dim](const double* src, double* dst, const std::size_t n)
+                     {
+                         units.from_si(dim, src, dst, n);
+                     });
     }
 
-    ert_unique_ptr<ecl_kw_type, ecl_kw_free>
-    make_ecl_kw_pointer(const std::string&         kw,
-                        const std::vector<double>& data,
-                        const bool                 write_double)
+    template <typename T>
+    void write_kw(::Opm::RestartIO::ecl_rst_file_type* rst_file,
+                  const std::string&                   keyword,
+                  const std::vector<T>&                data)
     {
-        auto kw_ptr = Opm::RestartIO::
-            ert_unique_ptr< ::Opm::RestartIO::ecl_kw_type, ecl_kw_free>{};
+        const auto kw = EclKW<T>(keyword, data);
+
+        ::Opm::RestartIO::ecl_rst_file_add_kw(rst_file, kw.get());
+    }
 
-        if (write_double) {
-            ::Opm::RestartIO::ecl_kw_type* ecl_kw =
-                ::Opm::RestartIO::ecl_kw_alloc(kw.c_str(), data.size(), ECL_DOUBLE);
+    /// 64 bit FNV-1a hash of the bytes of an array, continuing from
+    /// \p hash.
+    std::uint64_t hashBytes(const void*       data,
+                            const std::size_t size,
+                            std::uint64_t     hash = 14695981039346656037ULL)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
 
-            ::Opm::RestartIO::ecl_kw_set_memcpy_data(ecl_kw , data.data());
+        return hash;
+    }
 
-            kw_ptr.reset(ecl_kw);
+    template <typename T>
+    std::uint64_t hashArray(const std::vector<T>& data)
+    {
+        const auto size = data.size();
+        return hashBytes(data.data(), size * sizeof(T),
+                         hashBytes(&size, sizeof size));
+    }
+
+    std::uint64_t hashArray(const std::vector<const char*>& data)
+    {
+        const auto size = data.size();
+        auto hash = hashBytes(&size, sizeof size);
+        for (const auto* item : data) {
+            hash = hashBytes(item, std::strlen(item) + 1, hash);
         }
-        else {
-            ::Opm::RestartIO::ecl_kw_type* ecl_kw = ::Opm::RestartIO::
-                ecl_kw_alloc(kw.c_str(), data.size(), ECL_FLOAT);
 
-            float* float_data = ecl_kw_get_type_ptr<float>(ecl_kw, ECL_FLOAT_TYPE);
+        return hash;
+    }
+
+    /// Back-references from the arrays of a report step to the identical
+    /// arrays of an earlier report step of the same unified restart file.
+    ///
+    /// The hash of every array is remembered along with the report step
+    /// which holds its data.  An array whose hash is unchanged is not
+    /// written again; its keyword and the report step of the data are
+    /// listed in the arrays OPM_REFK and OPM_REFS of the step instead,
+    /// which RestartIO::load() resolves.
+    class ArrayReferences
+    {
+    public:
+        /// Forget the hashes of other files and of the report steps
+        /// which are overwritten by \p report_step.
+        void startStep(const std::string& filename, const int report_step)
+        {
+            if (filename != this->filename_) {
+                this->clear();
+                this->filename_ = filename;
+            }
 
-            for (auto n = data.size(), i = 0*n; i < n; ++i) {
-                float_data[i] = static_cast<float>(data[i]);
+            for (auto entry = this->stored_.begin(); entry != this->stored_.end(); ) {
+                if (entry->second.report_step >= report_step)
+                    entry = this->stored_.erase(entry);
+                else
+                    ++entry;
             }
 
-            kw_ptr.reset(ecl_kw);
+            this->report_step_ = report_step;
+            this->keys_.clear();
+            this->steps_.clear();
         }
 
-        return kw_ptr;
-    }
+        void clear()
+        {
+            this->filename_.clear();
+            this->stored_.clear();
+            this->keys_.clear();
+            this->steps_.clear();
+        }
+
+        /// True if the array \p key with hash \p hash is identical to
+        /// a stored one, in which case a reference is recorded.
+        /// Otherwise the array becomes the stored one, and must be
+        /// written.
+        bool unchanged(const std::string& key, const std::uint64_t hash)
+        {
+            auto entry = this->stored_.find(key);
+            if ((entry != this->stored_.end()) && (entry->second.hash == hash)) {
+                this->keys_.push_back(key);
+                this->steps_.push_back(entry->second.report_step);
+                return true;
+            }
 
+            this->stored_[key] = Stored{ hash, this->report_step_ };
+            return false;
+        }
+
+        /// Writes the references of the current report step, if any.
+        void write(::Opm::RestartIO::ecl_rst_file_type* rst_file) const
+        {
+            if (this->keys_.empty())
+                return;
+
+            auto keys = std::vector<const char*>{};
+            for (const auto& key : this->keys_)
+                keys.push_back(key.c_str());
+
+            write_kw(rst_file, "OPM_REFK", keys);
+            write_kw(rst_file, "OPM_REFS", this->steps_);
+        }
+
+    private:
+        struct Stored {
+            std::uint64_t hash;
+            int           report_step;
+        };
+
+        std::string                    filename_;
+        int                            report_step_ = 0;
+        std::map<std::string, Stored>  stored_;
+        std::vector<std::string>       keys_;
+        std::vector<int>               steps_;
+    };
+
+    /// As write_kw(), except that an array which is unchanged since an
+    /// earlier report step is only referenced if \p refs is not null.
     template <typename T>
     void write_kw(::Opm::RestartIO::ecl_rst_file_type* rst_file,
+                  ArrayReferences*                     refs,
                   const std::string&                   keyword,
                   const std::vector<T>&                data)
     {
-        const auto kw = EclKW<T>(keyword, data);
+        if ((refs != nullptr) && refs->unchanged(keyword, hashArray(data)))
+            return;
 
-        ::Opm::RestartIO::ecl_rst_file_add_kw(rst_file, kw.get());
+        write_kw(rst_file, keyword, data);
     }
 
     std::vector<int>
@@ -266,20 +380,19 @@ namespace {
                 int                                  report_step,
                 double                               simTime,
                 const Schedule&                      schedule,
-                const EclipseGrid&                   grid,
-                const EclipseState&                  es)
+                const EclipseState&                  es,
+                const Helpers::StaticHeaders&        headers)
     {
         if (rst_file->unified) {
             ::Opm::RestartIO::ecl_rst_file_fwrite_SEQNUM(rst_file, report_step);
         }
 
         // write INTEHEAD to restart file
-        const auto ih = Helpers::createInteHead(es, grid, schedule, simTime, sim_step, sim_step);
+        const auto ih = Helpers::createInteHead(headers, es, schedule, simTime, sim_step, sim_step);
         write_kw(rst_file, "INTEHEAD", ih);
 
         // write LOGIHEAD to restart file
-        const auto lh = Helpers::createLogiHead(es);
-        write_kw(rst_file, "LOGIHEAD", lh);
+        write_kw(rst_file, "LOGIHEAD", headers.logiHead);
 
         // write DOUBHEAD to restart file
         const auto dh = Helpers::createDoubHead(es, schedule, sim_step, simTime);
@@ -294,13 +407,13 @@ namespace {
 		    const bool                           ecl_compatible_rst,
                     const Schedule&                      schedule,
                     const Opm::SummaryState&             sumState,
-                    const std::vector<int>&              ih)
+                    const std::vector<int>&              ih,
+                    Helpers::AggregateGroupData&         groupData,
+                    ArrayReferences*                     refs)
     {
         // write IGRP to restart file
         const size_t simStep = static_cast<size_t> (sim_step);
 
-        auto  groupData = Helpers::AggregateGroupData(ih);
-
         auto & rst_g_keys = groupData.restart_group_keys;
         auto & rst_f_keys = groupData.restart_field_keys;
         auto & grpKeyToInd = groupData.groupKeyToIndex;
@@ -311,88 +424,162 @@ namespace {
                                            grpKeyToInd, fldKeyToInd,
 					   ecl_compatible_rst,
                                            simStep, sumState, ih);
-        write_kw(rst_file, "IGRP", groupData.getIGroup());
-        write_kw(rst_file, "SGRP", groupData.getSGroup());
-        write_kw(rst_file, "XGRP", groupData.getXGroup());
-	write_kw(rst_file, "ZGRP", serialize_ZWEL(groupData.getZGroup()));
+        write_kw(rst_file, refs, "IGRP", groupData.getIGroup());
+        write_kw(rst_file, refs, "SGRP", groupData.getSGroup());
+        write_kw(rst_file, refs, "XGRP", groupData.getXGroup());
+	write_kw(rst_file, refs, "ZGRP", serialize_ZWEL(groupData.getZGroup()));
     }
 
-    void writeMSWData(::Opm::RestartIO::ecl_rst_file_type* rst_file,
-                      int                                  sim_step,
-                      const UnitSystem&                    units,
-                      const Schedule&                      schedule,
-                      const EclipseGrid&                   grid,
-		      const Opm::SummaryState&             sumState,
-		      const Opm::data::Wells&              wells,
-                      const std::vector<int>&              ih)
+    /// Well, multi-segment well and connection restart arrays.
+    struct WellRestartData
     {
-        // write ISEG, RSEG, ILBS and ILBR to restart file
-        const size_t simStep = static_cast<size_t> (sim_step);
-        auto  MSWData = Helpers::AggregateMSWData(ih);
-        MSWData.captureDeclaredMSWData(schedule, simStep, units, ih, grid, sumState, wells);
+        explicit WellRestartData(const std::vector<int>& ih)
+            : mswData       (ih)
+            , wellData      (ih)
+            , connectionData(ih)
+        {}
 
-        write_kw(rst_file, "ISEG", MSWData.getISeg());
-        write_kw(rst_file, "ILBS", MSWData.getILBs());
-        write_kw(rst_file, "ILBR", MSWData.getILBr());
-        write_kw(rst_file, "RSEG", MSWData.getRSeg());
-    }
+        void reset(const std::vector<int>& ih)
+        {
+            this->haveMSW = false;
+
+            this->mswData.reset(ih);
+            this->wellData.reset(ih);
+            this->connectionData.reset(ih);
+
+            this->opm_iwel.clear();
+            this->opm_xwel.clear();
+        }
 
-    void writeWell(::Opm::RestartIO::ecl_rst_file_type* rst_file,
-                   int                                  sim_step,
-		   const bool                       ecl_compatible_rst,
-                   const Phases&                        phases,
-                   const UnitSystem&                    units,
-                   const EclipseGrid&                   grid,
-                   const Schedule&                      schedule,
-                   const data::Wells&                   wells,
-                   const Opm::SummaryState&             sumState,
-                   const std::vector<int>&              ih)
+        bool haveMSW = false;
+
+        Helpers::AggregateMSWData        mswData;
+        Helpers::AggregateWellData       wellData;
+        Helpers::AggregateConnectionData connectionData;
+
+        std::vector<int>    opm_iwel;
+        std::vector<double> opm_xwel;
+    };
+
+    /// Aggregate the well related restart arrays of a report step into
+    /// \p data, which must have been reset for the step.  Does no I/O,
+    /// so it can run concurrently with the output of the other restart
+    /// arrays.  Returns false if there are no wells.
+    bool
+    captureWellData(WellRestartData&         data,
+                    int                      sim_step,
+                    const bool               ecl_compatible_rst,
+                    const Phases&            phases,
+                    const UnitSystem&        units,
+                    const EclipseGrid&       grid,
+                    const Schedule&          schedule,
+                    const data::Wells&       wells,
+                    const Opm::SummaryState& sumState,
+                    const std::vector<int>&  ih)
     {
-        auto wellData = Helpers::AggregateWellData(ih);
-        wellData.captureDeclaredWellData(schedule, units, sim_step, sumState, ih);
-        wellData.captureDynamicWellData(schedule, sim_step, ecl_compatible_rst, wells, sumState);
+        const auto  simStep     = static_cast<std::size_t>(sim_step);
+        const auto& sched_wells = schedule.getWells(sim_step);
 
-        write_kw(rst_file, "IWEL", wellData.getIWell());
-        write_kw(rst_file, "SWEL", wellData.getSWell());
-        write_kw(rst_file, "XWEL", wellData.getXWell());
-        write_kw(rst_file, "ZWEL", serialize_ZWEL(wellData.getZWell()));
+        if (sched_wells.empty()) {
+            return false;
+        }
 
-        // Extended set of OPM well vectors
-	if (!ecl_compatible_rst)
+        data.haveMSW =
+            std::any_of(std::begin(sched_wells), std::end(sched_wells),
+                [sim_step](const Well* well)
         {
-            const auto sched_wells = schedule.getWells(sim_step);
+            return well->isMultiSegment(sim_step);
+        });
+
+        if (data.haveMSW) {
+            data.mswData.captureDeclaredMSWData(schedule, simStep, units, ih,
+                                                 grid, sumState, wells);
+        }
 
-            const auto opm_xwel =
-                serialize_OPM_XWEL(wells, sim_step, sched_wells, phases, grid);
+        data.wellData.captureDeclaredWellData(schedule, units, sim_step, sumState, ih);
+        data.wellData.captureDynamicWellData(schedule, sim_step, ecl_compatible_rst, wells, sumState);
 
-            const auto opm_iwel = serialize_OPM_IWEL(wells, sched_wells);
+        // Extended set of OPM well vectors
+        if (!ecl_compatible_rst) {
+            data.opm_xwel = serialize_OPM_XWEL(wells, sim_step, sched_wells, phases, grid);
+            data.opm_iwel = serialize_OPM_IWEL(wells, sched_wells);
+        }
+
+        data.connectionData.captureDeclaredConnData(schedule, grid, units, wells, sim_step);
+
+        return true;
+    }
 
-            write_kw(rst_file, "OPM_IWEL", opm_iwel);
-            write_kw(rst_file, "OPM_XWEL", opm_xwel);
+    void writeWellData(::Opm::RestartIO::ecl_rst_file_type* rst_file,
+                       const bool                           ecl_compatible_rst,
+                       const WellRestartData&               data,
+                       ArrayReferences*                     refs)
+    {
+        if (data.haveMSW) {
+            // write ISEG, RSEG, ILBS and ILBR to restart file
+            write_kw(rst_file, refs, "ISEG", data.mswData.getISeg());
+            write_kw(rst_file, refs, "ILBS", data.mswData.getILBs());
+            write_kw(rst_file, refs, "ILBR", data.mswData.getILBr());
+            write_kw(rst_file, refs, "RSEG", data.mswData.getRSeg());
         }
 
-        auto connectionData = Helpers::AggregateConnectionData(ih);
-        connectionData.captureDeclaredConnData(schedule, grid, units, wells, sim_step);
+        write_kw(rst_file, refs, "IWEL", data.wellData.getIWell());
+        write_kw(rst_file, refs, "SWEL", data.wellData.getSWell());
+        write_kw(rst_file, refs, "XWEL", data.wellData.getXWell());
+        write_kw(rst_file, refs, "ZWEL", serialize_ZWEL(data.wellData.getZWell()));
+
+        if (!ecl_compatible_rst) {
+            write_kw(rst_file, refs, "OPM_IWEL", data.opm_iwel);
+            write_kw(rst_file, refs, "OPM_XWEL", data.opm_xwel);
+        }
 
-        write_kw(rst_file, "ICON", connectionData.getIConn());
-        write_kw(rst_file, "SCON", connectionData.getSConn());
-        write_kw(rst_file, "XCON", connectionData.getXConn());
+        write_kw(rst_file, refs, "ICON", data.connectionData.getIConn());
+        write_kw(rst_file, refs, "SCON", data.connectionData.getSConn());
+        write_kw(rst_file, refs, "XCON", data.connectionData.getXConn());
     }
 
     void writeSolution(ecl_rst_file_type*  rst_file,
                        const RestartValue& value,
+                       const UnitSystem&         units,
                        const bool                ecl_compatible_rst,
-                       const bool                write_double_arg)
+                       const bool                write_double_arg,
+                       ArrayReferences*          refs)
     {
         ecl_rst_file_start_solution(rst_file);
 
-        auto write = [rst_file]
+        // The caller's choice of precision is already forced off for
+        // ECLIPSE compatible files, and per field overrides are not
+        // applied there either.
+        auto write_double = [&value, ecl_compatible_rst, write_double_arg]
+            (const std::string& key) -> bool
+        {
+            return ecl_compatible_rst
+                ? write_double_arg
+                : value.writeDouble(key, write_double_arg);
+        };
+
+        // A solution which is not in SI units is written as it is.
+        auto solution_dim = [&value](const UnitSystem::measure dim)
+        {
+            return value.solution.isSI() ? dim : UnitSystem::measure::identity;
+        };
+
+        Helpers::ArrayWriter writer(fortio_get_FILE(rst_file->fortio), rst_file->fmt_file);
+        auto write = [&writer, &units, refs]
             (const std::string&         key,
              const std::vector<double>& data,
+             const UnitSystem::measure  dim,
              const bool                 write_double) -> void
         {
-            auto kw = make_ecl_kw_pointer(key, data, write_double);
-            ::Opm::RestartIO::ecl_rst_file_add_kw(rst_file, kw.get());
+            if (refs != nullptr) {
+                // The converted values differ if the precision or the
+                // unit of an unchanged SI array does.
+                const int type[] = { static_cast<int>(dim), write_double };
+                if (refs->unchanged(key, hashBytes(type, sizeof type, hashArray(data))))
+                    return;
+            }
+
+            writeField(writer, key, data, write_double, units, dim);
         };
 
         for (const auto& elm : value.solution) {
@@ -400,7 +587,7 @@ namespace {
 
             if (elm.second.target == data::TargetType::RESTART_SOLUTION)
             {
-                write(elm.first, elm.second.data, write_double_arg);
+                write(elm.first, elm.second.data, solution_dim(elm.second.dim), write_double(elm.first));
             }
         }
 
@@ -409,99 +596,271 @@ namespace {
             if (extraInSolution(key)) {
                 // Observe that the extra data is unconditionally
                 // output as double precision.
-                write(key, elm.second, true);
+                write(key, elm.second, elm.first.dim, true);
             }
         }
 
+        writer.flush();
+
         ecl_rst_file_end_solution(rst_file);
 
 	if (ecl_compatible_rst) return;
 
         for (const auto& elm : value.solution) {
             if (elm.second.target == data::TargetType::RESTART_AUXILIARY) {
-                write(elm.first, elm.second.data, write_double_arg);
+                write(elm.first, elm.second.data, solution_dim(elm.second.dim), write_double(elm.first));
             }
         }
+
+        writer.flush();
     }
 
     void writeExtraData(::Opm::RestartIO::ecl_rst_file_type* rst_file,
-                        const RestartValue::ExtraVector&     extra_data)
+                        const RestartValue::ExtraVector&     extra_data,
+                        const UnitSystem&                    units)
     {
+        Helpers::ArrayWriter writer(fortio_get_FILE(rst_file->fortio), rst_file->fmt_file);
         for (const auto& extra_value : extra_data) {
             const std::string& key = extra_value.first.key;
-            const std::vector<double>& data = extra_value.second;
-            if (! extraInSolution(key)) {
-                ecl_kw_type * ecl_kw = ecl_kw_alloc_new_shared( key.c_str() , data.size() , ECL_DOUBLE , const_cast<double *>(data.data()));
-                ecl_rst_file_add_kw( rst_file , ecl_kw);
-                ecl_kw_free( ecl_kw );
-            }
-
+            if (! extraInSolution(key))
+                writeField(writer, key, extra_value.second, true, units, extra_value.first.dim);
         }
+
+        writer.flush();
     }
 
 } // Anonymous namespace
 
+struct OutputBuffers::Arrays
+{
+    explicit Arrays(const std::vector<int>& ih)
+        : groupData(ih)
+        , wellData (ih)
+    {}
+
+    Helpers::AggregateGroupData groupData;
+    WellRestartData             wellData;
+    ArrayReferences             references;
+};
+
+/*
+  The SEQNUM offsets are only known for the report steps written through
+  the open file. The part of the file before the first of them was left
+  by ecl_rst_file_open_write_seek(), which keeps the report steps before
+  the one it was opened for; a report step before that is only found by
+  opening the file again.
+*/
+struct OutputBuffers::UnifiedFile
+{
+    using FilePtr = ert_unique_ptr< ::Opm::RestartIO::ecl_rst_file_type,
+                                    ::Opm::RestartIO::ecl_rst_file_close>;
+
+    /// The file positioned for the SEQNUM of report_step.
+    ::Opm::RestartIO::ecl_rst_file_type*
+    open(const std::string& filename, const int report_step)
+    {
+        auto pos = this->seqnum.lower_bound(report_step);
+        const bool reopen = !this->file || (filename != this->filename)
+            || ((pos == this->seqnum.begin()) && (pos != this->seqnum.end())
+                && (pos->first != report_step));
+
+        if (reopen) {
+            this->file.reset();
+            this->seqnum.clear();
+            this->filename = filename;
+            this->file.reset(::Opm::RestartIO::ecl_rst_file_open_write_seek(filename.c_str(),
+                                                                            report_step));
+        }
+        else if (pos != this->seqnum.end()) {
+            fortio_fseek(this->file->fortio, pos->second, SEEK_SET);
+            fortio_ftruncate_current(this->file->fortio);
+            this->seqnum.erase(pos, this->seqnum.end());
+        }
+
+        this->seqnum[report_step] = ::Opm::RestartIO::ecl_rst_file_ftell(this->file.get());
+        return this->file.get();
+    }
+
+    /// Truncates the file back to the SEQNUM of report_step, removing
+    /// a report step which was only partly written.
+    void discard(const int report_step)
+    {
+        auto pos = this->seqnum.find(report_step);
+        if (pos == this->seqnum.end())
+            return;
+
+        fortio_fseek(this->file->fortio, pos->second, SEEK_SET);
+        fortio_ftruncate_current(this->file->fortio);
+        this->seqnum.erase(pos, this->seqnum.end());
+        this->flush();
+    }
+
+    void flush()
+    {
+        std::fflush(fortio_get_FILE(this->file->fortio));
+    }
+
+    std::string filename;
+    FilePtr     file;
+    std::map<int, ::Opm::RestartIO::offset_type> seqnum;
+};
+
+OutputBuffers::OutputBuffers() = default;
+
+OutputBuffers::~OutputBuffers() = default;
+
+OutputBuffers::Arrays& OutputBuffers::reset(const std::vector<int>& inteHead)
+{
+    if (!this->arrays) {
+        this->arrays.reset(new Arrays(inteHead));
+    }
+    else {
+        this->arrays->groupData.reset(inteHead);
+        this->arrays->wellData.reset(inteHead);
+    }
+
+    return *this->arrays;
+}
+
+OutputBuffers::UnifiedFile& OutputBuffers::unifiedFile()
+{
+    if (!this->unified)
+        this->unified.reset(new UnifiedFile());
+
+    return *this->unified;
+}
+
 void save(const std::string&  filename,
           int                 report_step,
           double              seconds_elapsed,
-          RestartValue        value,
+          const RestartValue& value,
           const EclipseState& es,
           const EclipseGrid&  grid,
           const Schedule&     schedule,
           const SummaryState& sumState,
           bool                write_double)
 {
+    save(filename, report_step, seconds_elapsed, value, es, grid, schedule,
+         sumState, Helpers::StaticHeaders(es, grid), write_double);
+}
+
+void save(const std::string&            filename,
+          int                           report_step,
+          double                        seconds_elapsed,
+          const RestartValue&           value,
+          const EclipseState&           es,
+          const EclipseGrid&            grid,
+          const Schedule&               schedule,
+          const SummaryState&           sumState,
+          const Helpers::StaticHeaders& headers,
+          bool                          write_double)
+{
+    OutputBuffers buffers;
+    save(filename, report_step, seconds_elapsed, value, es, grid, schedule,
+         sumState, headers, buffers, write_double);
+}
+
+void save(const std::string&            filename,
+          int                           report_step,
+          double                        seconds_elapsed,
+          const RestartValue&           value,
+          const EclipseState&           es,
+          const EclipseGrid&            grid,
+          const Schedule&               schedule,
+          const SummaryState&           sumState,
+          const Helpers::StaticHeaders& headers,
+          OutputBuffers&                buffers,
+          bool                          write_double)
+{
+    PhaseTimer::Scope phase("RestartIO::save");
     ::Opm::RestartIO::checkSaveArguments(es, value, grid);
     bool ecl_compatible_rst = es.getIOConfig().getEclCompatibleRST();
     const auto  sim_step = std::max(report_step - 1, 0);
     const auto& units    = es.getUnits();
 
-    auto rst_file = openRestartFile(filename, report_step);
+    // A unified file stays open in the buffers, other files are written
+    // from the start and closed again.
+    auto separate_file = OutputBuffers::UnifiedFile::FilePtr{};
+    auto* unified_file = static_cast<OutputBuffers::UnifiedFile*>(nullptr);
+    auto* rst_file = static_cast< ::Opm::RestartIO::ecl_rst_file_type*>(nullptr);
+    if (::Opm::RestartIO::EclFiletype(filename) == ECL_UNIFIED_RESTART_FILE) {
+        unified_file = &buffers.unifiedFile();
+        rst_file = unified_file->open(filename, report_step);
+    }
+    else {
+        separate_file.reset(::Opm::RestartIO::ecl_rst_file_open_write(filename.c_str()));
+        rst_file = separate_file.get();
+    }
+
     if (ecl_compatible_rst)
       write_double = false;
 
-    // Convert solution fields and extra values from SI to user units.
-    value.solution.convertFromSI(units);
-    for (auto& extra_value : value.extra) {
-        const auto& restart_key = extra_value.first;
-        auto&       data        = extra_value.second;
+    // A report step which fails part-way is removed from a unified file
+    // again, so that the file ends with the last complete report step.
+    auto* refs = static_cast<ArrayReferences*>(nullptr);
+    try {
+        const auto inteHD = writeHeader(rst_file, sim_step, report_step,
+                                        seconds_elapsed, schedule, es, headers);
 
-        units.from_si(restart_key.dim, data);
-    }
+        auto& arrays = buffers.reset(inteHD);
+
+        // Unchanged arrays are referenced rather than repeated only in the
+        // OPM specific unified files.
+        if (!ecl_compatible_rst && es.getIOConfig().getDeduplicateRST() && rst_file->unified) {
+            refs = &arrays.references;
+            refs->startStep(filename, report_step);
+        }
+        else
+            arrays.references.clear();
+
+        // The well, connection and segment arrays are aggregated in the
+        // background while the group data is written; only value.wells is
+        // shared, and it is not modified.
+        const auto& phases = es.runspec().phases();
+        auto haveWells = std::async(std::launch::async,
+            [sim_step, ecl_compatible_rst, &arrays, &phases, &units, &grid,
+             &schedule, &value, &sumState, &inteHD]()
+        {
+            return captureWellData(arrays.wellData, sim_step, ecl_compatible_rst, phases,
+                                   units, grid, schedule, value.wells, sumState, inteHD);
+        });
 
-    const auto inteHD = writeHeader(rst_file.get(), sim_step, report_step,
-                                    seconds_elapsed, schedule, grid, es);
+        writeGroup(rst_file, sim_step, ecl_compatible_rst,
+                   schedule, sumState, inteHD, arrays.groupData, refs);
 
-    writeGroup(rst_file.get(), sim_step, ecl_compatible_rst,
-               schedule, sumState, inteHD);
+        // Write well and MSW data only when applicable (i.e., when present)
+        if (haveWells.get()) {
+            writeWellData(rst_file, ecl_compatible_rst, arrays.wellData, refs);
+        }
 
-    // Write well and MSW data only when applicable (i.e., when present)
-    {
-        const auto& wells = schedule.getWells(sim_step);
+        // The solution fields and extra values are converted from SI to
+        // user units as they are copied into the output keywords.
+        writeSolution(rst_file, value, units, ecl_compatible_rst, write_double, refs);
 
-        if (! wells.empty()) {
-            const auto numMSW =
-                std::count_if(std::begin(wells), std::end(wells),
-                    [sim_step](const Well* well)
-            {
-                return well->isMultiSegment(sim_step);
-            });
+        if (!ecl_compatible_rst) {
+          ::Opm::RestartIO::writeExtraData(rst_file, value.extra, units);
 
-            if (numMSW > 0) {
-                writeMSWData(rst_file.get(), sim_step, units,
-                             schedule, grid, sumState, value.wells, inteHD);
-            }
+          // The summary values, e.g. the cumulative totals, in the order of
+          // the summary vectors; see Summary::set_restart_vectors().
+          if (sumState.size() > 0)
+              write_kw(rst_file, "OPM_SMRY", sumState.data());
 
-            writeWell(rst_file.get(), sim_step, ecl_compatible_rst,
-                      es.runspec().phases(), units, grid, schedule,
-                      value.wells, sumState, inteHD);
+          if (refs != nullptr)
+              refs->write(rst_file);
         }
     }
+    catch (...) {
+        if (unified_file != nullptr) {
+            unified_file->discard(report_step);
+            if (refs != nullptr)
+                refs->startStep(filename, report_step);
+        }
 
-    writeSolution(rst_file.get(), value, ecl_compatible_rst, write_double);
+        throw;
+    }
 
-    if (!ecl_compatible_rst)
-      ::Opm::RestartIO::writeExtraData(rst_file.get(), value.extra);
+    if (unified_file != nullptr)
+        unified_file->flush();
 }
 
 }} // Opm::RestartIO
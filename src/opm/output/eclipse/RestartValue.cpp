@@ -101,5 +101,15 @@ namespace Opm {
         }
     }
 
+    void RestartValue::setOutputPrecision(const std::string& key, bool write_double) {
+        this->output_double[key] = write_double;
+    }
+
+    bool RestartValue::writeDouble(const std::string& key, bool default_write_double) const {
+        const auto iter = this->output_double.find(key);
+        if (iter == this->output_double.end())
+            return default_write_double;
 
+        return iter->second;
+    }
 }
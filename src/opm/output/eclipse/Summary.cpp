@@ -18,15 +18,22 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <exception>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
+#include <opm/common/utility/ParallelChunks.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
@@ -40,12 +47,17 @@
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
+#include <opm/output/eclipse/ColumnarSummary.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 #include <opm/output/eclipse/RegionCache.hpp>
 
 #include <ert/ecl/smspec_node.hpp>
 #include <ert/ecl/ecl_smspec.hpp>
 #include <ert/ecl/ecl_kw_magic.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/ecl/EclFilename.hpp>
+#include <ert/ecl/EclKW.hpp>
+#include <ert/ecl/FortIO.hpp>
 
 namespace {
     struct SegmentResultDescriptor
@@ -294,7 +306,14 @@ struct fn_args {
     const data::Wells& wells;
     const out::RegionCache& regionCache;
     const EclipseGrid& grid;
-    const std::vector< std::pair< std::string, double > > eff_factors;
+    const std::vector< std::pair< std::string, double > >& eff_factors;
+    const std::vector< std::array< double, 6 > >& region_rates;
+    /* Connection vectors only; nullptr if there is no such connection. */
+    const Connection* connection;
+    const data::Well* well_result;
+    const data::Connection* connection_result;
+    /* Segment vectors only; nullptr if the segment has no results. */
+    const data::Segment* segment_result;
 };
 
 /* Since there are several enums in opm scattered about more-or-less
@@ -397,26 +416,13 @@ inline quantity flowing( const fn_args& args ) {
 template< rt phase, bool injection = true, bool polymer = false >
 inline quantity crate( const fn_args& args ) {
     const quantity zero = { 0, rate_unit< phase >() };
-    // The args.num value is the literal value which will go to the
-    // NUMS array in the eclispe SMSPEC file; the values in this array
-    // are offset 1 - whereas we need to use this index here to look
-    // up a completion with offset 0.
-    const size_t global_index = args.num - 1;
-    if( args.schedule_wells.empty() ) return zero;
+    // The connection results are looked up at the cell of the vector
+    // once per timestep, see Summary::keyword_handlers::connection_table.
+    const auto* completion = args.connection_result;
+    if( completion == nullptr ) return zero;
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
-    const auto& completion = std::find_if( well_data.connections.begin(),
-                                           well_data.connections.end(),
-                                           [=]( const data::Connection& c ) {
-                                                return c.index == global_index;
-                                           } );
-
-    if( completion == well_data.connections.end() ) return zero;
-
     double eff_fac = efac( args.eff_factors, name );
     double concentration = polymer
                            ? well->getPolymerProperties( args.sim_step ).m_polymerConcentration
@@ -433,29 +439,19 @@ inline quantity crate( const fn_args& args ) {
 template< rt phase, bool polymer = false >
 inline quantity srate( const fn_args& args ) {
     const quantity zero = { 0, rate_unit< phase >() };
-    // The args.num value is the literal value which will go to the
-    // NUMS array in the eclispe SMSPEC file; the values in this array
-    // are offset 1 - whereas we need to use this index here to look
-    // up a completion with offset 0.
-    const size_t segNumber = args.num;
-    if( args.schedule_wells.empty() ) return zero;
+    // The segment results are looked up by the segment number of the
+    // vector once per timestep, see Summary::keyword_handlers::segment_table.
+    const auto* segment = args.segment_result;
+    if( segment == nullptr ) return zero;
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
-
-    const auto& segment = well_data.segments.find(segNumber);
-
-    if( segment == well_data.segments.end() ) return zero;
-
     double eff_fac = efac( args.eff_factors, name );
     double concentration = polymer
                            ? well->getPolymerProperties( args.sim_step ).m_polymerConcentration
                            : 1;
 
-    auto v = segment->second.rates.get( phase, 0.0 ) * eff_fac * concentration;
+    auto v = segment->rates.get( phase, 0.0 ) * eff_fac * concentration;
     //switch sign of rate - opposite convention in flow vs eclipse
     v *= -1;
 
@@ -466,26 +462,8 @@ inline quantity srate( const fn_args& args ) {
 inline quantity trans_factors ( const fn_args& args ) {
     const quantity zero = { 0, measure::transmissibility };
 
-    if( args.schedule_wells.empty() ) return zero;
-    // Like completion rate we need to look
-    // up a connection with offset 0.
-    const size_t global_index = args.num - 1;
-
-    const auto& well = args.schedule_wells.front();
-    const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& grid = args.grid;
-    const auto& connections = well->getConnections(args.sim_step);
-
-    const auto& connection = std::find_if(
-        connections.begin(),
-        connections.end(),
-        [=]( const Opm::Connection& c ) {
-            return grid.getGlobalIndex(c.getI(), c.getJ(), c.getK()) == global_index;
-        } );
-
-    if( connection == connections.end() ) return zero;
+    const auto* connection = args.connection;
+    if( args.well_result == nullptr || connection == nullptr ) return zero;
 
     const auto& v = connection->CF() * connection->wellPi();
     return { v, measure::transmissibility };
@@ -494,24 +472,10 @@ inline quantity trans_factors ( const fn_args& args ) {
 inline quantity spr ( const fn_args& args ) {
     const quantity zero = { 0, measure::pressure };
 
-    if( args.schedule_wells.empty() ) return zero;
-    // Like completion rate we need to look
-    // up a connection with offset 0.
-    const size_t segNumber = args.num;
-    if( args.schedule_wells.empty() ) return zero;
-
-    const auto& well = args.schedule_wells.front();
-    const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
-
-    const auto& segment = well_data.segments.find(segNumber);
-
-    if( segment == well_data.segments.end() ) return zero;
-
+    const auto* segment = args.segment_result;
+    if( segment == nullptr ) return zero;
 
-    const auto& v = segment->second.pressure;
+    const auto& v = segment->pressure;
     return { v, measure::pressure };
 }
 
@@ -630,24 +594,20 @@ inline quantity duration( const fn_args& args ) {
     return { args.duration, measure::time };
 }
 
+/*
+  The region rates are accumulated for all the regions in one sweep per
+  timestep, see region_rate_table. Every region has the injected and the
+  produced rate of oil, water and gas, in this order.
+*/
+constexpr std::size_t region_rate_column( rt phase, bool injection ) {
+    return 2 * (phase == rt::oil ? 0 : (phase == rt::wat ? 1 : 2)) + (injection ? 0 : 1);
+}
+
 template<rt phase , bool injection>
 quantity region_rate( const fn_args& args ) {
     double sum = 0;
-    const auto& well_connections = args.regionCache.connections( args.num );
-
-    for (const auto& pair : well_connections) {
-
-        double eff_fac = efac( args.eff_factors, pair.first );
-
-        double rate = args.wells.get( pair.first , pair.second , phase ) * eff_fac;
-
-        // We are asking for the production rate in an injector - or
-        // opposite. We just clamp to zero.
-        if ((rate > 0) != injection)
-            rate = 0;
-
-        sum += rate;
-    }
+    if (args.num >= 0 && static_cast< std::size_t >( args.num ) < args.region_rates.size())
+        sum = args.region_rates[ args.num ][ region_rate_column( phase, injection ) ];
 
     if( injection )
         return { sum, rate_unit< phase >() };
@@ -1042,6 +1002,44 @@ static const std::unordered_map< std::string, UnitSystem::measure> block_units =
   {"BGSAS"      , UnitSystem::measure::identity},
 };
 
+/*
+  How the values of a summary keyword are produced: passed in by the
+  simulator as a single, region or block value, or evaluated by one of
+  the kernels in funs. The table merges the tables above, with the
+  single values taking precedence over the region values, and so on, so
+  a summary node is classified with a single lookup.
+*/
+struct keyword_source {
+    enum class kind { single_value, region, block, kernel };
+
+    kind type;
+    UnitSystem::measure unit;
+    const ofun* kernel;
+};
+
+const std::unordered_map< std::string, keyword_source >& keyword_sources() {
+    static const auto* sources = [] {
+        auto* table = new std::unordered_map< std::string, keyword_source >();
+        using kind = keyword_source::kind;
+
+        for (const auto& pair : single_values_units)
+            table->emplace( pair.first, keyword_source{ kind::single_value, pair.second, nullptr } );
+
+        for (const auto& pair : region_units)
+            table->emplace( pair.first, keyword_source{ kind::region, pair.second, nullptr } );
+
+        for (const auto& pair : block_units)
+            table->emplace( pair.first, keyword_source{ kind::block, pair.second, nullptr } );
+
+        for (const auto& pair : funs)
+            table->emplace( pair.first, keyword_source{ kind::kernel, UnitSystem::measure::identity, &pair.second } );
+
+        return table;
+    }();
+
+    return *sources;
+}
+
 inline std::vector< const Well* > find_wells( const Schedule& schedule,
                                               const ecl::smspec_node* node,
                                               const int sim_step,
@@ -1090,6 +1088,17 @@ inline std::vector< const Well* > find_wells( const Schedule& schedule,
     return {};
 }
 
+/*
+  Calls op(pos) for pos in [0, count), in parallel. The handlers only
+  read the schedule, the well results and the previous values, and
+  every position writes its own output slot, so the positions are
+  independent.
+*/
+template< typename Op >
+void forEachHandler( std::size_t count, Op&& op ) {
+    forEachPosition( count, 2048, op );
+}
+
 }
 
 namespace out {
@@ -1098,13 +1107,218 @@ class Summary::keyword_handlers {
     public:
         using fn = ofun;
         std::vector< std::pair< const ecl::smspec_node*, fn > > handlers;
-        std::map< std::string, const ecl::smspec_node* > single_value_nodes;
-        std::map< std::pair <std::string, int>, const ecl::smspec_node* > region_nodes;
-        std::map< std::pair <std::string, int>, const ecl::smspec_node* > block_nodes;
+
+        /*
+          The nodes of the values passed in by the simulator. The nodes
+          are appended while the summary is set up and sorted on their
+          key once all of them are registered.
+        */
+        template< typename Key >
+        struct node_index {
+            std::vector< std::pair< Key, const ecl::smspec_node* > > nodes;
+
+            void add( Key key, const ecl::smspec_node* node ) {
+                this->nodes.emplace_back( std::move( key ), node );
+            }
+
+            void sort() {
+                std::stable_sort( this->nodes.begin(), this->nodes.end(),
+                                  []( const std::pair< Key, const ecl::smspec_node* >& lhs,
+                                      const std::pair< Key, const ecl::smspec_node* >& rhs ) {
+                                      return lhs.first < rhs.first;
+                                  });
+            }
+
+            /* Position of key in nodes, or -1 if there is no such node. */
+            int find( const Key& key ) const {
+                const auto iter = std::lower_bound( this->nodes.begin(), this->nodes.end(), key,
+                                                    []( const std::pair< Key, const ecl::smspec_node* >& node,
+                                                        const Key& k ) {
+                                                        return node.first < k;
+                                                    });
+                if (iter == this->nodes.end() || iter->first != key)
+                    return -1;
+
+                return static_cast< int >( iter - this->nodes.begin() );
+            }
+        };
+
+        node_index< std::string > single_value_nodes;
+        node_index< std::pair< std::string, int > > region_nodes;
+        node_index< std::pair< std::string, int > > block_nodes;
+
+        /*
+          The value slots of the simulator values: the single value nodes
+          followed by the region nodes and the block nodes, in the order of
+          the sorted node indices. Every slot has the SummaryState index of
+          its key and the conversion from SI to output units, so a timestep
+          can store the values without looking up keys or unit systems.
+        */
+        struct value_slots {
+            std::size_t region_offset = 0;
+            std::size_t block_offset = 0;
+            std::vector< std::size_t > state_index;
+            std::vector< double > factor;
+            std::vector< double > offset;
+
+            void add( std::size_t index, measure m, const UnitSystem& usys ) {
+                this->state_index.push_back( index );
+                this->factor.push_back( usys.from_si_factor( m ) );
+                this->offset.push_back( usys.to_si_offset( m ) );
+            }
+
+            void set( SummaryState& st, std::size_t slot, double si_value ) const {
+                st.set( this->state_index[ slot ], this->factor[ slot ] * (si_value - this->offset[ slot ]) );
+            }
+        };
+        value_slots slots;
 
         // Memory management for restart-related summary vectors
         // that are not requested in SUMMARY section.
         std::vector<std::unique_ptr<ecl::smspec_node>> rstvec_backing_store;
+
+        /*
+          The wells and efficiency factors of every handler, resolved
+          from the Schedule at report step bound_step. The binding stays
+          valid until the Schedule has an event which changes the wells,
+          the group structure or the efficiency factors, or is changed
+          in place by an action, which changes its fingerprint.
+        */
+        struct well_binding {
+            std::vector< const Well* > wells;
+            std::vector< std::pair< std::string, double > > efac;
+        };
+        std::vector< well_binding > bindings;
+        int bound_step = -1;
+        Fingerprint bound_fingerprint;
+
+        /*
+          The connections of the connection vectors, CWPR, CTFAC and so
+          on, resolved before the handlers are evaluated. The schedule
+          connection at the cell of a vector is only searched for when
+          the well has a new set of connections, and the results of the
+          connection are found at the position among the connections of
+          the well results it had at the previous timestep, which is
+          normally the same, so the handlers index their connection
+          directly. The positions are indexed like handler, the
+          resolved connections like the handlers.
+        */
+        struct connection_table {
+            std::vector< std::size_t > handler;
+            std::vector< data::Connection::global_index > cell;
+            std::vector< const WellConnections* > well_connections;
+            std::vector< std::size_t > slot;
+
+            std::vector< const Connection* > connection;
+            std::vector< const data::Well* > well_result;
+            std::vector< const data::Connection* > result;
+
+            void init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers );
+            void resolve( const std::vector< well_binding >& bindings,
+                          int sim_step,
+                          const data::Wells& well_results,
+                          const EclipseGrid& grid );
+        };
+        connection_table connections;
+
+        /*
+          The segments of the segment vectors, SOFR, SPR and so on. The
+          results of the segments of every multi-segment well with
+          segment vectors are gathered once per timestep into a flat
+          array ordered like the WellSegments of the well, which the
+          segment vectors index by the position of their segment number
+          instead of looking up the well and the segment by name and
+          number. The positions are indexed like handler, the resolved
+          segments like the handlers.
+        */
+        struct segment_table {
+            std::vector< const Well* > wells;
+            std::vector< const WellSegments* > well_segments;
+            std::vector< std::vector< const data::Segment* > > results;
+
+            std::vector< std::size_t > handler;
+            std::vector< int > segment;
+            std::vector< std::size_t > well;
+
+            std::vector< const data::Segment* > result;
+
+            void init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers );
+            void bind( const std::vector< well_binding >& bindings );
+            void resolve( int sim_step, const data::Wells& well_results );
+        };
+        segment_table segments;
+
+        /*
+          The well connections of the regions with region rate handlers,
+          ROPR, RWIT and so on. A connection refers to its well by
+          position in wells, and remembers its position among the
+          connections of the well results, which is normally the same
+          every timestep, so the rates of all regions are accumulated in
+          one sweep without looking up well names or cells.
+        */
+        struct region_rate_table {
+            std::vector< std::string > wells;
+            std::vector< double > efac;
+            std::vector< const data::Well* > results;
+
+            std::vector< int > region;
+            std::vector< std::size_t > well;
+            std::vector< data::Connection::global_index > cell;
+            std::vector< std::size_t > slot;
+
+            std::vector< std::array< double, 6 > > rates;
+
+            void init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers,
+                       const out::RegionCache& regionCache );
+            void bind( const Schedule& schedule, int sim_step );
+            void accumulate( const data::Wells& well_results );
+        };
+        region_rate_table region_rates;
+
+        /*
+          The SummaryState index of the value computed by every handler,
+          and whether the key at a given SummaryState index is written to
+          the summary file.
+        */
+        std::vector< std::size_t > state_index;
+        std::vector< bool > in_smspec;
+
+        /*
+          The evaluation plan compiled from the handlers. The handlers
+          are evaluated grouped by keyword, so the same kernel runs over
+          all its wells, connections or regions in sequence, and the unit
+          conversion is applied to all the values in one pass afterwards
+          with the cached per-handler factor and offset. A handler always
+          returns its value in the same unit; should the unit differ
+          from the cached one the conversion of that handler is updated.
+          The handlers are evaluated in parallel, each into its own slot
+          of si_values, see forEachHandler(); the previous values are
+          only read in the sequential pass which follows. A handler
+          with a cadence of n, from IOConfig::setSummaryCadence(),
+          is only evaluated at every nth written timestep.
+        */
+        struct evaluation_plan {
+            std::vector< std::size_t > order;
+            std::vector< int > num;
+            std::vector< char > is_total;
+            std::vector< std::size_t > cadence;
+            std::vector< measure > unit;
+            std::vector< double > factor;
+            std::vector< double > offset;
+            std::vector< double > si_values;
+
+            void set_unit( std::size_t index, measure m, const UnitSystem& usys );
+        };
+        evaluation_plan plan;
+
+        void compile_plan( const UnitSystem& usys,
+                           const std::map< char, std::size_t >& cadence );
+
+        void bind_wells( const Schedule& schedule,
+                         int sim_step,
+                         const out::RegionCache& regionCache );
+
+        std::size_t memory_usage() const;
 };
 
 Summary::Summary( const EclipseState& st,
@@ -1129,7 +1343,13 @@ Summary::Summary( const EclipseState& st,
                   const char* basename ) :
     grid( grid_arg ),
     regionCache( st.get3DProperties( ) , grid_arg, schedule ),
-    handlers( new keyword_handlers() )
+    handlers( new keyword_handlers() ),
+    basename( basename ),
+    fmt_output( st.getIOConfig().getFMTOUT() ),
+    unified_output( st.getIOConfig().getUNIFOUT() ),
+    record_every_nth( st.getIOConfig().getSummaryRecordingSteps() ),
+    record_interval( st.getIOConfig().getSummaryRecordingInterval() ),
+    columnar_chunk( st.getIOConfig().getColumnarSummary() )
 {
 
     const auto& init_config = st.getInitConfig();
@@ -1162,15 +1382,24 @@ Summary::Summary( const EclipseState& st,
      * entry.
      */
     std::set< std::string > unsupported_keywords;
+    ecl_smspec_type * smspec = ecl_sum_get_smspec(this->ecl_sum.get());
+    const auto& sources = keyword_sources();
 
+    /*
+      The unit of a kernel does not depend on its arguments, so it is
+      found by calling the kernel with dummy input once per keyword.
+    */
+    std::unordered_map< const ofun*, std::string > kernel_units;
+
+    this->handlers->handlers.reserve( std::distance( sum.begin(), sum.end() ) );
     for( const auto& node : sum ) {
-        ecl_smspec_type * smspec = ecl_sum_get_smspec(this->ecl_sum.get());
         std::string keyword = node.keyword();
 
-        const auto single_value_pair = single_values_units.find( keyword );
-        const auto funs_pair = funs.find( keyword );
-        const auto region_pair = region_units.find( keyword );
-        const auto block_pair = block_units.find( keyword );
+        const auto source = sources.find( keyword );
+        if (source == sources.end()) {
+            unsupported_keywords.insert(keyword);
+            continue;
+        }
 
         /*
           All summary values of the type ECL_SMSPEC_MISC_VAR
@@ -1178,17 +1407,24 @@ Summary::Summary( const EclipseState& st,
           in the misc_values map when calling
           add_timestep.
         */
-        if (single_value_pair != single_values_units.end()) {
+        switch (source->second.type) {
+        case keyword_source::kind::single_value: {
             auto node_type = node.type();
             if ((node_type != ECL_SMSPEC_FIELD_VAR) && (node_type != ECL_SMSPEC_MISC_VAR)) {
                 continue;
             }
-            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), st.getUnits().name( single_value_pair->second ), 0);
-            this->handlers->single_value_nodes.emplace( keyword, nodeptr );
-        } else if (region_pair != region_units.end()) {
-            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( region_pair->second ), 0);
-            this->handlers->region_nodes.emplace( std::make_pair(keyword, node.num()), nodeptr );
-        } else if (block_pair != block_units.end()) {
+            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), st.getUnits().name( source->second.unit ), 0);
+            this->handlers->single_value_nodes.add( keyword, nodeptr );
+            break;
+        }
+
+        case keyword_source::kind::region: {
+            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( source->second.unit ), 0);
+            this->handlers->region_nodes.add( std::make_pair(keyword, node.num()), nodeptr );
+            break;
+        }
+
+        case keyword_source::kind::block: {
             if (node.type() != ECL_SMSPEC_BLOCK_VAR)
                 continue;
 
@@ -1196,9 +1432,12 @@ Summary::Summary( const EclipseState& st,
             if (!this->grid.cellActive(global_index))
                 continue;
 
-            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( block_pair->second ), 0 );
-            this->handlers->block_nodes.emplace( std::make_pair(keyword, node.num()), nodeptr );
-        } else if (funs_pair != funs.end()) {
+            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( source->second.unit ), 0 );
+            this->handlers->block_nodes.add( std::make_pair(keyword, node.num()), nodeptr );
+            break;
+        }
+
+        case keyword_source::kind::kernel: {
             auto node_type = node.type();
 
             if ((node_type == ECL_SMSPEC_COMPLETION_VAR) || (node_type == ECL_SMSPEC_BLOCK_VAR)) {
@@ -1207,27 +1446,41 @@ Summary::Summary( const EclipseState& st,
                     continue;
             }
 
-            /* get unit strings by calling each function with dummy input */
-            const auto handle = funs_pair->second;
-            const std::vector< const Well* > dummy_wells;
-
-            const fn_args no_args { dummy_wells, // Wells from Schedule object
-                                    0,           // Duration of time step
-                                    0,           // Simulation step
-                                    node.num(),
-                                    {},          // Well results - data::Wells
-                                    {},          // Region <-> cell mappings.
-                                    this->grid,
-                                    {}};
-
-            const auto val = handle( no_args );
+            const auto* handle = source->second.kernel;
+            auto unit = kernel_units.find( handle );
+            if (unit == kernel_units.end()) {
+                /* get unit strings by calling each function with dummy input */
+                const std::vector< const Well* > dummy_wells;
+
+                const fn_args no_args { dummy_wells, // Wells from Schedule object
+                                        0,           // Duration of time step
+                                        0,           // Simulation step
+                                        node.num(),
+                                        {},          // Well results - data::Wells
+                                        {},          // Region <-> cell mappings.
+                                        this->grid,
+                                        {},
+                                        {},
+                                        nullptr,     // Connection
+                                        nullptr,     // Well result
+                                        nullptr,     // Connection result
+                                        nullptr };   // Segment result
+
+                const auto val = (*handle)( no_args );
+                unit = kernel_units.emplace( handle, st.getUnits().name( val.unit ) ).first;
+            }
 
-            auto * nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.wgname().c_str(), node.num(), st.getUnits().name( val.unit ), 0 );
-            this->handlers->handlers.emplace_back( nodeptr, handle );
-        } else {
-            unsupported_keywords.insert(keyword);
+            auto * nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.wgname().c_str(), node.num(), unit->second.c_str(), 0 );
+            this->handlers->handlers.emplace_back( nodeptr, *handle );
+            break;
+        }
         }
     }
+
+    this->handlers->single_value_nodes.sort();
+    this->handlers->region_nodes.sort();
+    this->handlers->block_nodes.sort();
+
     for ( const auto& keyword : unsupported_keywords ) {
         Opm::OpmLog::info("Keyword " + std::string(keyword) + " is unhandled");
     }
@@ -1283,10 +1536,153 @@ Summary::Summary( const EclipseState& st,
         }
     }
 
+    /*
+      Register all the keys up front, so prev_state and state share the
+      same dense layout and the timesteps can work with indices.
+    */
     for (const auto& pair : this->handlers->handlers) {
         const auto * nodeptr = pair.first;
+        const auto index = this->prev_state.index(*nodeptr);
+        this->handlers->state_index.push_back(index);
         if (nodeptr->is_total())
-            this->prev_state.add(*nodeptr, 0);
+            this->prev_state.set(index, 0);
+    }
+
+    {
+        const auto& usys = st.getUnits();
+        auto& slots = this->handlers->slots;
+
+        for (const auto& pair : this->handlers->single_value_nodes.nodes)
+            slots.add( this->prev_state.index(*pair.second), single_values_units.at(pair.first), usys );
+
+        slots.region_offset = slots.state_index.size();
+        for (const auto& pair : this->handlers->region_nodes.nodes)
+            slots.add( this->prev_state.index(*pair.second), region_units.at(pair.first.first), usys );
+
+        slots.block_offset = slots.state_index.size();
+        for (const auto& pair : this->handlers->block_nodes.nodes)
+            slots.add( this->prev_state.index(*pair.second), block_units.at(pair.first.first), usys );
+    }
+
+    for (std::size_t index = 0; index < this->prev_state.size(); ++index) {
+        const auto& key = this->prev_state.key(index);
+        this->handlers->in_smspec.push_back(ecl_sum_has_key(this->ecl_sum.get(), key.c_str()));
+    }
+
+    this->state = this->prev_state;
+    this->state.clear();
+
+    this->handlers->compile_plan( st.getUnits(), st.getIOConfig().getSummaryCadence() );
+    this->handlers->region_rates.init( this->handlers->handlers, this->regionCache );
+    this->handlers->connections.init( this->handlers->handlers );
+    this->handlers->segments.init( this->handlers->handlers );
+
+    if (MemoryUsage::enabled())
+        MemoryUsage::log( this->memory_usage() );
+}
+
+
+void Summary::keyword_handlers::evaluation_plan::set_unit( std::size_t index,
+                                                           measure m,
+                                                           const UnitSystem& usys ) {
+    this->unit[ index ] = m;
+    this->factor[ index ] = usys.from_si_factor( m );
+    this->offset[ index ] = usys.to_si_offset( m );
+}
+
+
+std::size_t Summary::keyword_handlers::memory_usage() const {
+    using mu = MemoryUsage;
+    std::size_t bytes = sizeof( *this )
+                      + mu::heap( this->handlers )
+                      + mu::heap( this->single_value_nodes.nodes )
+                      + mu::heap( this->region_nodes.nodes )
+                      + mu::heap( this->block_nodes.nodes )
+                      + mu::heap( this->slots.state_index )
+                      + mu::heap( this->slots.factor )
+                      + mu::heap( this->slots.offset )
+                      + mu::heap( this->rstvec_backing_store )
+                      + this->rstvec_backing_store.size() * sizeof( ecl::smspec_node )
+                      + mu::heap( this->bindings )
+                      + mu::heap( this->region_rates.wells )
+                      + mu::heap( this->region_rates.efac )
+                      + mu::heap( this->region_rates.results )
+                      + mu::heap( this->region_rates.region )
+                      + mu::heap( this->region_rates.well )
+                      + mu::heap( this->region_rates.cell )
+                      + mu::heap( this->region_rates.slot )
+                      + mu::heap( this->region_rates.rates )
+                      + mu::heap( this->connections.handler )
+                      + mu::heap( this->connections.cell )
+                      + mu::heap( this->connections.well_connections )
+                      + mu::heap( this->connections.slot )
+                      + mu::heap( this->connections.connection )
+                      + mu::heap( this->connections.well_result )
+                      + mu::heap( this->connections.result )
+                      + mu::heap( this->segments.wells )
+                      + mu::heap( this->segments.well_segments )
+                      + mu::heap( this->segments.results )
+                      + mu::heap( this->segments.handler )
+                      + mu::heap( this->segments.segment )
+                      + mu::heap( this->segments.well )
+                      + mu::heap( this->segments.result )
+                      + mu::heap( this->state_index )
+                      + mu::heap( this->in_smspec )
+                      + mu::heap( this->plan.order )
+                      + mu::heap( this->plan.num )
+                      + mu::heap( this->plan.is_total )
+                      + mu::heap( this->plan.cadence )
+                      + mu::heap( this->plan.unit )
+                      + mu::heap( this->plan.factor )
+                      + mu::heap( this->plan.offset )
+                      + mu::heap( this->plan.si_values );
+
+    for (const auto& pair : this->single_value_nodes.nodes)
+        bytes += mu::heap( pair.first );
+    for (const auto& pair : this->region_nodes.nodes)
+        bytes += mu::heap( pair.first.first );
+    for (const auto& pair : this->block_nodes.nodes)
+        bytes += mu::heap( pair.first.first );
+
+    for (const auto& binding : this->bindings) {
+        bytes += mu::heap( binding.wells ) + mu::heap( binding.efac );
+        for (const auto& efac : binding.efac)
+            bytes += mu::heap( efac.first );
+    }
+
+    return bytes;
+}
+
+void Summary::keyword_handlers::compile_plan( const UnitSystem& usys,
+                                              const std::map< char, std::size_t >& cadence ) {
+    const auto size = this->handlers.size();
+    auto& p = this->plan;
+
+    p.order.resize( size );
+    std::iota( p.order.begin(), p.order.end(), std::size_t( 0 ) );
+    std::stable_sort( p.order.begin(), p.order.end(),
+                      [this]( std::size_t lhs, std::size_t rhs ) {
+                          return std::strcmp( this->handlers[ lhs ].first->get_keyword(),
+                                              this->handlers[ rhs ].first->get_keyword() ) < 0;
+                      });
+
+    p.num.resize( size );
+    p.is_total.resize( size );
+    p.cadence.assign( size, 1 );
+    p.unit.resize( size );
+    p.factor.resize( size );
+    p.offset.resize( size );
+    p.si_values.assign( size, 0.0 );
+
+    for (std::size_t index = 0; index < size; ++index) {
+        const auto* node = this->handlers[ index ].first;
+        p.num[ index ] = node->get_num();
+        p.is_total[ index ] = node->is_total();
+        p.set_unit( index, measure::identity, usys );
+
+        const auto every_nth = cadence.find( node->get_keyword()[0] );
+        if (every_nth != cadence.end() && !node->is_total())
+            p.cadence[ index ] = std::max( every_nth->second, std::size_t( 1 ) );
     }
 }
 
@@ -1306,6 +1702,33 @@ Summary::Summary( const EclipseState& st,
  * rates and accumulated values.
  *
  */
+/*
+ * The efficiency factor of the well times the factors of the groups above
+ * it, up to but not including top_group, or up to the top of the group tree
+ * when top_group is nullptr.
+ */
+double well_efficiency_factor( const Schedule& schedule,
+                               const Well& well,
+                               const int sim_step,
+                               const char* top_group ) {
+    const auto &groupTree = schedule.getGroupTree(sim_step);
+    double eff_factor = well.getEfficiencyFactor(sim_step);
+    const auto* group_node = &schedule.getGroup(well.getGroupName(sim_step));
+
+    while(true){
+        if( top_group && group_node->name() == top_group )
+            break;
+        eff_factor *= group_node->getGroupEfficiencyFactor( sim_step );
+
+        const auto& parent = groupTree.parent( group_node->name() );
+        if( !schedule.hasGroup( parent ) )
+            break;
+        group_node = &schedule.getGroup( parent );
+    }
+
+    return eff_factor;
+}
+
 std::vector< std::pair< std::string, double > >
 well_efficiency_factors( const ecl::smspec_node* node,
                          const Schedule& schedule,
@@ -1323,32 +1746,295 @@ well_efficiency_factors( const ecl::smspec_node* node,
 
     const bool is_group = (var_type == ECL_SMSPEC_GROUP_VAR);
     const bool is_rate = !node->is_total();
-    const auto &groupTree = schedule.getGroupTree(sim_step);
+    const char* top_group = (is_group && is_rate) ? node->get_wgname() : nullptr;
 
     for( const auto* well : schedule_wells ) {
-        double eff_factor = well->getEfficiencyFactor(sim_step);
-
         if ( !well->hasBeenDefined( sim_step ) )
             continue;
 
-        const auto* group_node = &schedule.getGroup(well->getGroupName(sim_step));
+        efac.emplace_back( well->name(), well_efficiency_factor( schedule, *well, sim_step, top_group ) );
+    }
 
-        while(true){
-            if((   is_group
-                && is_rate
-                && group_node->name() == node->get_wgname() ))
-                break;
-            eff_factor *= group_node->getGroupEfficiencyFactor( sim_step );
+    return efac;
+}
 
-            const auto& parent = groupTree.parent( group_node->name() );
-            if( !schedule.hasGroup( parent ) )
-                break;
-            group_node = &schedule.getGroup( parent );
+void Summary::keyword_handlers::bind_wells( const Schedule& schedule,
+                                            int sim_step,
+                                            const out::RegionCache& regionCache ) {
+    constexpr uint64_t binding_events = ScheduleEvents::NEW_WELL
+                                      | ScheduleEvents::NEW_GROUP
+                                      | ScheduleEvents::GROUP_CHANGE
+                                      | ScheduleEvents::WELL_GROUP_CHANGE
+                                      | ScheduleEvents::EFFICIENCY_UPDATE;
+
+    bool rebind = (this->bound_step < 0)
+               || (sim_step < this->bound_step)
+               || (this->bindings.size() != this->handlers.size())
+               || (this->bound_fingerprint != schedule.fingerprint());
+
+    const auto& events = schedule.getEvents();
+    for (int step = this->bound_step + 1; !rebind && step <= sim_step; ++step)
+        rebind = events.hasEvent( binding_events, step );
+
+    if (rebind) {
+        this->bindings.clear();
+        this->bindings.reserve( this->handlers.size() );
+        for (const auto& f : this->handlers) {
+            auto schedule_wells = find_wells( schedule, f.first, sim_step, regionCache );
+            auto eff_factors = well_efficiency_factors( f.first, schedule, schedule_wells, sim_step );
+            this->bindings.push_back( { std::move( schedule_wells ), std::move( eff_factors ) } );
         }
-        efac.emplace_back( well->name(), eff_factor );
+        this->region_rates.bind( schedule, sim_step );
+        this->segments.bind( this->bindings );
     }
 
-    return efac;
+    this->bound_step = sim_step;
+    this->bound_fingerprint = schedule.fingerprint();
+}
+
+void Summary::keyword_handlers::region_rate_table::init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers,
+                                                         const out::RegionCache& regionCache ) {
+    std::vector< int > regions;
+    for (const auto& handler : handlers) {
+        if (handler.first->get_var_type() == ECL_SMSPEC_REGION_VAR)
+            regions.push_back( handler.first->get_num() );
+    }
+
+    std::sort( regions.begin(), regions.end() );
+    regions.erase( std::unique( regions.begin(), regions.end() ), regions.end() );
+    if (regions.empty() || regions.back() < 0)
+        return;
+
+    std::unordered_map< std::string, std::size_t > well_index;
+    for (const auto region_id : regions) {
+        for (const auto& connection : regionCache.connections( region_id )) {
+            const auto pos = well_index.emplace( connection.first, this->wells.size() );
+            if (pos.second)
+                this->wells.push_back( connection.first );
+
+            this->region.push_back( region_id );
+            this->well.push_back( pos.first->second );
+            this->cell.push_back( connection.second );
+        }
+    }
+
+    this->efac.assign( this->wells.size(), 1.0 );
+    this->results.assign( this->wells.size(), nullptr );
+    this->slot.assign( this->cell.size(), 0 );
+    this->rates.resize( regions.back() + 1 );
+}
+
+void Summary::keyword_handlers::connection_table::init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers ) {
+    for (std::size_t index = 0; index < handlers.size(); ++index) {
+        const auto* node = handlers[ index ].first;
+        if (node->get_var_type() != ECL_SMSPEC_COMPLETION_VAR || node->get_num() < 1)
+            continue;
+
+        // The NUMS of a connection vector is the global cell index plus one.
+        this->handler.push_back( index );
+        this->cell.push_back( node->get_num() - 1 );
+    }
+
+    this->well_connections.assign( this->handler.size(), nullptr );
+    this->slot.assign( this->handler.size(), 0 );
+    this->connection.assign( handlers.size(), nullptr );
+    this->well_result.assign( handlers.size(), nullptr );
+    this->result.assign( handlers.size(), nullptr );
+}
+
+void Summary::keyword_handlers::connection_table::resolve( const std::vector< well_binding >& bindings,
+                                                           int sim_step,
+                                                           const data::Wells& well_results,
+                                                           const EclipseGrid& grid ) {
+    const Well* last_well = nullptr;
+    const data::Well* last_result = nullptr;
+
+    for (std::size_t pos = 0; pos < this->handler.size(); ++pos) {
+        const auto index = this->handler[ pos ];
+        const auto& wells = bindings[ index ].wells;
+        this->well_result[ index ] = nullptr;
+        this->result[ index ] = nullptr;
+        if (wells.empty())
+            continue;
+
+        const auto* well = wells.front();
+        const auto& connections = well->getConnections( sim_step );
+        if (&connections != this->well_connections[ pos ]) {
+            this->well_connections[ pos ] = &connections;
+            this->connection[ index ] = nullptr;
+            const auto& columns = connections.columns();
+            for (std::size_t c = 0; c < columns.i.size(); ++c) {
+                if (grid.getGlobalIndex( columns.i[ c ], columns.j[ c ], columns.k[ c ] ) == this->cell[ pos ]) {
+                    this->connection[ index ] = &connections[ c ];
+                    break;
+                }
+            }
+        }
+
+        if (well != last_well) {
+            const auto iter = well_results.find( well->name() );
+            last_well = well;
+            last_result = (iter == well_results.end()) ? nullptr : &iter->second;
+        }
+
+        if (!last_result)
+            continue;
+
+        this->well_result[ index ] = last_result;
+        const auto& results = last_result->connections;
+        const auto hint = this->slot[ pos ];
+        if (hint < results.size() && results[ hint ].index == this->cell[ pos ])
+            this->result[ index ] = &results[ hint ];
+        else {
+            this->result[ index ] = last_result->find_connection( this->cell[ pos ] );
+            if (this->result[ index ])
+                this->slot[ pos ] = this->result[ index ] - results.data();
+        }
+    }
+}
+
+void Summary::keyword_handlers::segment_table::init( const std::vector< std::pair< const ecl::smspec_node*, ofun > >& handlers ) {
+    for (std::size_t index = 0; index < handlers.size(); ++index) {
+        const auto* node = handlers[ index ].first;
+        if (node->get_var_type() != ECL_SMSPEC_SEGMENT_VAR)
+            continue;
+
+        this->handler.push_back( index );
+        this->segment.push_back( node->get_num() );
+    }
+
+    this->well.assign( this->handler.size(), 0 );
+    this->result.assign( handlers.size(), nullptr );
+}
+
+void Summary::keyword_handlers::segment_table::bind( const std::vector< well_binding >& bindings ) {
+    this->wells.clear();
+    for (std::size_t pos = 0; pos < this->handler.size(); ++pos) {
+        const auto& wells = bindings[ this->handler[ pos ] ].wells;
+        const Well* well = wells.empty() ? nullptr : wells.front();
+
+        // The segment vectors of a well normally follow each other.
+        auto iter = std::find( this->wells.rbegin(), this->wells.rend(), well );
+        if (iter == this->wells.rend()) {
+            this->wells.push_back( well );
+            iter = this->wells.rbegin();
+        }
+        this->well[ pos ] = std::distance( iter, this->wells.rend() ) - 1;
+    }
+
+    this->well_segments.assign( this->wells.size(), nullptr );
+    this->results.resize( this->wells.size() );
+}
+
+void Summary::keyword_handlers::segment_table::resolve( int sim_step, const data::Wells& well_results ) {
+    for (std::size_t index = 0; index < this->wells.size(); ++index) {
+        auto& results = this->results[ index ];
+        const auto* well = this->wells[ index ];
+        this->well_segments[ index ] = nullptr;
+        results.clear();
+        if (!well || !well->isMultiSegment( sim_step ))
+            continue;
+
+        const auto& segments = well->getWellSegments( sim_step );
+        this->well_segments[ index ] = &segments;
+        results.assign( segments.size(), nullptr );
+
+        const auto result = well_results.find( well->name() );
+        if (result == well_results.end())
+            continue;
+
+        for (const auto& segment : result->second.segments) {
+            const int pos = segments.segmentNumberToIndex( segment.first );
+            if (pos >= 0 && static_cast< std::size_t >( pos ) < results.size())
+                results[ pos ] = &segment.second;
+        }
+    }
+
+    for (std::size_t pos = 0; pos < this->handler.size(); ++pos) {
+        const auto index = this->handler[ pos ];
+        const auto* segments = this->well_segments[ this->well[ pos ] ];
+        this->result[ index ] = nullptr;
+        if (!segments)
+            continue;
+
+        const int slot = segments->segmentNumberToIndex( this->segment[ pos ] );
+        if (slot >= 0)
+            this->result[ index ] = this->results[ this->well[ pos ] ][ slot ];
+    }
+}
+
+void Summary::keyword_handlers::region_rate_table::bind( const Schedule& schedule, int sim_step ) {
+    for (std::size_t index = 0; index < this->wells.size(); ++index) {
+        const auto* well = schedule.getWell( this->wells[ index ] );
+        this->efac[ index ] = (well && well->hasBeenDefined( sim_step ))
+            ? well_efficiency_factor( schedule, *well, sim_step, nullptr )
+            : 1.0;
+    }
+}
+
+void Summary::keyword_handlers::region_rate_table::accumulate( const data::Wells& well_results ) {
+    static const rt phases[] = { rt::oil, rt::wat, rt::gas };
+
+    for (auto& region_rates : this->rates)
+        region_rates.fill( 0.0 );
+
+    for (std::size_t index = 0; index < this->wells.size(); ++index) {
+        const auto result = well_results.find( this->wells[ index ] );
+        this->results[ index ] = (result == well_results.end()) ? nullptr : &result->second;
+    }
+
+    for (std::size_t index = 0; index < this->cell.size(); ++index) {
+        const auto* result = this->results[ this->well[ index ] ];
+        if (!result)
+            continue;
+
+        const auto& connections = result->connections;
+        const data::Connection* connection = nullptr;
+        if (this->slot[ index ] < connections.size() && connections[ this->slot[ index ] ].index == this->cell[ index ])
+            connection = &connections[ this->slot[ index ] ];
+        else {
+            connection = result->find_connection( this->cell[ index ] );
+            if (!connection)
+                continue;
+
+            this->slot[ index ] = connection - connections.data();
+        }
+
+        // A positive rate is injected and a negative rate produced; the
+        // region_rate kernels return the produced rates as positive values.
+        const double eff_fac = this->efac[ this->well[ index ] ];
+        auto& region_rates = this->rates[ this->region[ index ] ];
+        for (std::size_t p = 0; p < 3; ++p) {
+            const double rate = connection->rates.get( phases[ p ], 0.0 ) * eff_fac;
+            if (rate > 0)
+                region_rates[ 2 * p ] += rate;
+            else
+                region_rates[ 2 * p + 1 ] += rate;
+        }
+    }
+}
+
+int Summary::value_slot( const std::string& keyword ) const {
+    return this->handlers->single_value_nodes.find( keyword );
+}
+
+int Summary::value_slot( const std::string& keyword, int num ) const {
+    const auto key = std::make_pair( keyword, num );
+    const auto& slots = this->handlers->slots;
+
+    const auto region = this->handlers->region_nodes.find( key );
+    if (region >= 0)
+        return static_cast< int >( slots.region_offset ) + region;
+
+    const auto block = this->handlers->block_nodes.find( key );
+    if (block >= 0)
+        return static_cast< int >( slots.block_offset ) + block;
+
+    return -1;
+}
+
+std::size_t Summary::num_value_slots() const {
+    return this->handlers->slots.state_index.size();
 }
 
 void Summary::add_timestep( int report_step,
@@ -1359,7 +2045,135 @@ void Summary::add_timestep( int report_step,
                             const std::map<std::string, double>& single_values,
                             const std::map<std::string, std::vector<double>>& region_values,
                             const std::map<std::pair<std::string, int>, double>& block_values) {
+    PhaseTimer::Scope phase("Summary::add_timestep");
 
+    auto* tstep = this->begin_timestep( report_step, secs_elapsed, es, schedule, wells );
+    const auto& slots = this->handlers->slots;
+    auto& st = this->state;
+
+    for( const auto& value_pair : single_values ) {
+        const auto slot = this->handlers->single_value_nodes.find( value_pair.first );
+        if (slot >= 0)
+            slots.set( st, slot, value_pair.second );
+    }
+
+    for( const auto& value_pair : region_values ) {
+        const std::string& key = value_pair.first;
+        for (size_t reg = 0; reg < value_pair.second.size(); ++reg) {
+            const auto slot = this->handlers->region_nodes.find( std::make_pair(key, static_cast<int>(reg+1)) );
+            if (slot >= 0)
+                slots.set( st, slots.region_offset + slot, value_pair.second[reg] );
+        }
+    }
+
+    for( const auto& value_pair : block_values ) {
+        const auto slot = this->handlers->block_nodes.find( value_pair.first );
+        if (slot >= 0)
+            slots.set( st, slots.block_offset + slot, value_pair.second );
+    }
+
+    this->end_timestep( tstep, secs_elapsed );
+}
+
+void Summary::add_timestep_slots( int report_step,
+                                  double secs_elapsed,
+                                  const EclipseState& es,
+                                  const Schedule& schedule,
+                                  const data::Wells& wells,
+                                  const std::vector<double>& slot_values ) {
+    PhaseTimer::Scope phase("Summary::add_timestep");
+
+    const auto& slots = this->handlers->slots;
+    if (slot_values.size() != slots.state_index.size())
+        throw std::invalid_argument {
+            "Expected " + std::to_string(slots.state_index.size())
+            + " summary slot values, got " + std::to_string(slot_values.size())
+        };
+
+    auto* tstep = this->begin_timestep( report_step, secs_elapsed, es, schedule, wells );
+    for (std::size_t slot = 0; slot < slot_values.size(); ++slot)
+        slots.set( this->state, slot, slot_values[slot] );
+
+    this->end_timestep( tstep, secs_elapsed );
+}
+
+bool Summary::record_timestep( double secs_elapsed, bool substep ) const {
+    if (!substep)
+        return true;
+
+    return (this->record_every_nth > 0)
+        && (this->skipped_steps + 1 >= this->record_every_nth)
+        && (secs_elapsed - this->recorded_time >= this->record_interval);
+}
+
+/*
+  The timestep is not written, but the totals must still include it:
+  the total handlers are evaluated over the timestep and added to the
+  values of the previous timestep, so the next written timestep
+  continues from them. The other vectors keep the values of the last
+  written timestep.
+*/
+void Summary::skip_timestep( int report_step,
+                             double secs_elapsed,
+                             const EclipseState& es,
+                             const Schedule& schedule,
+                             const data::Wells& wells ) {
+    PhaseTimer::Scope phase("Summary::skip_timestep");
+
+    this->check_elapsed( secs_elapsed, es );
+    const double duration = secs_elapsed - this->prev_time_elapsed;
+    const auto sim_step = std::max( 0, report_step - 1 );
+
+    this->handlers->bind_wells( schedule, sim_step, this->regionCache );
+    this->handlers->region_rates.accumulate( wells );
+    this->handlers->connections.resolve( this->handlers->bindings, sim_step, wells, this->grid );
+    this->handlers->segments.resolve( sim_step, wells );
+    auto& plan = this->handlers->plan;
+    const auto& units = es.getUnits();
+    const auto& state_index = this->handlers->state_index;
+    const auto& kh = *this->handlers;
+    forEachHandler( plan.order.size(), [&]( std::size_t pos ) {
+        const auto index = plan.order[ pos ];
+        if (!plan.is_total[ index ])
+            return;
+
+        const auto& f = kh.handlers[ index ];
+        const auto& binding = kh.bindings[ index ];
+
+        const auto val = f.second( { binding.wells,
+                                     duration,
+                                     sim_step,
+                                     plan.num[ index ],
+                                     wells,
+                                     this->regionCache,
+                                     this->grid,
+                                     binding.efac,
+                                     kh.region_rates.rates,
+                                     kh.connections.connection[ index ],
+                                     kh.connections.well_result[ index ],
+                                     kh.connections.result[ index ],
+                                     kh.segments.result[ index ] });
+
+        if (val.unit != plan.unit[ index ])
+            plan.set_unit( index, val.unit, units );
+
+        plan.si_values[ index ] = val.value;
+    });
+
+    for (std::size_t index = 0; index < plan.si_values.size(); ++index) {
+        if (!plan.is_total[ index ])
+            continue;
+
+        const auto state_pos = state_index[ index ];
+        this->prev_state.set( state_pos, this->prev_state.get( state_pos )
+                                         + plan.factor[ index ] * (plan.si_values[ index ] - plan.offset[ index ]) );
+    }
+
+    this->prev_time_elapsed = secs_elapsed;
+    ++this->skipped_steps;
+}
+
+void Summary::check_elapsed( double secs_elapsed, const EclipseState& es ) const {
     if (secs_elapsed < this->prev_time_elapsed) {
         const auto& usys    = es.getUnits();
         const auto  elapsed = usys.from_si(measure::time, secs_elapsed);
@@ -1374,10 +2188,21 @@ void Summary::add_timestep( int report_step,
             + "). Incorrect restart time?"
         };
     }
+}
 
-    auto* tstep = ecl_sum_add_tstep( this->ecl_sum.get(), report_step, secs_elapsed );
+ecl_sum_tstep_type* Summary::begin_timestep( int report_step,
+                                             double secs_elapsed,
+                                             const EclipseState& es,
+                                             const Schedule& schedule,
+                                             const data::Wells& wells ) {
+    this->check_elapsed( secs_elapsed, es );
+
+    auto* tstep = ecl_sum_tstep_alloc_new( report_step, this->next_ministep++, secs_elapsed,
+                                           ecl_sum_get_smspec( this->ecl_sum.get() ) );
+    this->unwritten_steps.emplace_back( tstep );
     const double duration = secs_elapsed - this->prev_time_elapsed;
-    SummaryState st;
+    auto& st = this->state;
+    st.clear();
 
     /* report_step is the number of the file we are about to write - i.e. for instance CASE.S$report_step
      * for the data in a non-unified summary file.
@@ -1385,86 +2210,212 @@ void Summary::add_timestep( int report_step,
      * necessary to use when consulting the Schedule object. */
     const auto sim_step = std::max( 0, report_step - 1 );
 
-    for( auto& f : this->handlers->handlers ) {
-        const int num = smspec_node_get_num( f.first );
-
-        const auto schedule_wells = find_wells( schedule, f.first, sim_step, this->regionCache );
-        auto eff_factors = well_efficiency_factors( f.first, schedule, schedule_wells, sim_step );
-
-        const auto val = f.second( { schedule_wells,
+    this->handlers->bind_wells( schedule, sim_step, this->regionCache );
+    this->handlers->region_rates.accumulate( wells );
+    this->handlers->connections.resolve( this->handlers->bindings, sim_step, wells, this->grid );
+    this->handlers->segments.resolve( sim_step, wells );
+    auto& plan = this->handlers->plan;
+    const auto& units = es.getUnits();
+    const auto& state_index = this->handlers->state_index;
+    const auto& prev_values = this->prev_state.data();
+    const auto recorded = this->recorded_steps;
+    const auto& kh = *this->handlers;
+    forEachHandler( plan.order.size(), [&]( std::size_t pos ) {
+        const auto index = plan.order[ pos ];
+        if (recorded % plan.cadence[ index ] != 0)
+            return;
+
+        const auto& f = kh.handlers[ index ];
+        const auto& binding = kh.bindings[ index ];
+
+        const auto val = f.second( { binding.wells,
                                      duration,
                                      sim_step,
-                                     num,
+                                     plan.num[ index ],
                                      wells,
                                      this->regionCache,
                                      this->grid,
-                                     eff_factors});
-
-        double unit_applied_val = es.getUnits().from_si( val.unit, val.value );
-        if (smspec_node_is_total(f.first)) {
-            const auto* genkey = smspec_node_get_gen_key1( f.first );
-            unit_applied_val += this->prev_state.get(genkey);
+                                     binding.efac,
+                                     kh.region_rates.rates,
+                                     kh.connections.connection[ index ],
+                                     kh.connections.well_result[ index ],
+                                     kh.connections.result[ index ],
+                                     kh.segments.result[ index ] });
+
+        if (val.unit != plan.unit[ index ])
+            plan.set_unit( index, val.unit, units );
+
+        plan.si_values[ index ] = val.value;
+    });
+
+    for (std::size_t index = 0; index < plan.si_values.size(); ++index) {
+        if (recorded % plan.cadence[ index ] != 0) {
+            st.set( state_index[ index ], prev_values[ state_index[ index ] ] );
+            continue;
         }
 
-        st.add(*f.first, unit_applied_val);
+        double unit_applied_val = plan.factor[ index ] * (plan.si_values[ index ] - plan.offset[ index ]);
+        if (plan.is_total[ index ])
+            unit_applied_val += prev_values[ state_index[ index ] ];
+
+        st.set( state_index[ index ], unit_applied_val );
     }
 
-    for( const auto& value_pair : single_values ) {
-        const std::string key = value_pair.first;
-        const auto node_pair = this->handlers->single_value_nodes.find( key );
-        if (node_pair != this->handlers->single_value_nodes.end()) {
-            const auto unit = single_values_units.at( key );
-            double si_value = value_pair.second;
-            double output_value = es.getUnits().from_si(unit , si_value );
-            st.add(*node_pair->second, output_value);
-        }
+    return tstep;
+}
+
+void Summary::end_timestep( ecl_sum_tstep_type* tstep, double secs_elapsed ) {
+    const auto& st = this->state;
+    const auto& in_smspec = this->handlers->in_smspec;
+    for (std::size_t index = 0; index < st.size(); ++index) {
+        if (!st.has(index))
+            continue;
+
+        const auto* key = st.key(index).c_str();
+        const bool write = (index < in_smspec.size())
+            ? in_smspec[index]
+            : ecl_sum_has_key(this->ecl_sum.get(), key);
+
+        if (write)
+            ecl_sum_tstep_set_from_key(tstep, key, st.get(index));
     }
 
-    for( const auto& value_pair : region_values ) {
-        const std::string key = value_pair.first;
-        for (size_t reg = 0; reg < value_pair.second.size(); ++reg) {
-            const auto node_pair = this->handlers->region_nodes.find( std::make_pair(key, reg+1) );
-            if (node_pair != this->handlers->region_nodes.end()) {
-                const auto * nodeptr = node_pair->second;
-                const auto unit = region_units.at( key );
-
-                assert (smspec_node_get_num( nodeptr ) - 1 == static_cast<int>(reg));
-                double si_value = value_pair.second[reg];
-                double output_value = es.getUnits().from_si(unit , si_value );
-                st.add(*nodeptr, output_value);
-            }
+    std::swap(this->prev_state, this->state);
+    this->prev_time_elapsed = secs_elapsed;
+    this->recorded_time = secs_elapsed;
+    this->skipped_steps = 0;
+    ++this->recorded_steps;
+
+    if (this->columnar_chunk > 0)
+        this->append_columnar( ecl_sum_tstep_get_sim_days( tstep ) );
+}
+
+/*
+  The columns are the vectors of the SMSPEC file, in the order of the
+  summary state; the file is created at the first timestep, when they
+  are known.
+*/
+void Summary::append_columnar( double sim_days ) {
+    const auto& st = this->prev_state;
+
+    if (!this->columnar) {
+        std::vector< std::string > keys { "TIME" };
+        std::vector< std::string > units { "DAYS" };
+        const auto& in_smspec = this->handlers->in_smspec;
+        for (std::size_t index = 0; index < st.size(); ++index) {
+            const auto* key = st.key(index).c_str();
+            const bool write = (index < in_smspec.size())
+                ? in_smspec[index]
+                : ecl_sum_has_key(this->ecl_sum.get(), key);
+
+            if (!write)
+                continue;
+
+            this->columnar_index.push_back( index );
+            keys.push_back( key );
+            units.push_back( ecl_sum_get_unit( this->ecl_sum.get(), key ) );
         }
+
+        this->columnar.reset( new ColumnarSummary( this->basename + ".CSMRY", keys, units,
+                                                   this->columnar_chunk ) );
+        this->columnar_row.resize( keys.size() );
     }
 
-    for( const auto& value_pair : block_values ) {
-        const std::pair<std::string, int> key = value_pair.first;
-        const auto node_pair = this->handlers->block_nodes.find( key );
-        if (node_pair != this->handlers->block_nodes.end()) {
-            const auto * nodeptr = node_pair->second;
-            const auto unit = block_units.at( key.first );
-            double si_value = value_pair.second;
-            double output_value = es.getUnits().from_si(unit , si_value );
-            st.add(*nodeptr, output_value);
-        }
+    const auto nan = std::numeric_limits< double >::quiet_NaN();
+    this->columnar_row[0] = sim_days;
+    for (std::size_t col = 0; col < this->columnar_index.size(); ++col) {
+        const auto index = this->columnar_index[col];
+        this->columnar_row[col + 1] = st.has(index) ? st.get(index) : nan;
     }
 
-    for (const auto& pair: st) {
-        const auto* key = pair.first.c_str();
+    this->columnar->append( this->columnar_row );
+}
+
+/*
+  Rewriting the complete summary with ecl_sum_fwrite() for every timestep
+  makes the total output quadratic in the length of the run; write()
+  therefore only appends the SEQHDR, MINISTEP and PARAMS keywords of the new
+  timesteps, and frees them. The vectors are all registered by the
+  constructor, so the SMSPEC file is written once.
+*/
+void Summary::write() {
+    const int params_size = ecl_smspec_get_params_size( ecl_sum_get_smspec( this->ecl_sum.get() ) );
+    if (!this->smspec_written) {
+        ecl_sum_fwrite_smspec( this->ecl_sum.get() );
+        this->smspec_written = true;
+    }
 
-        if (ecl_sum_has_key(this->ecl_sum.get(), key)) {
-            ecl_sum_tstep_set_from_key(tstep, key, pair.second);
+    std::unique_ptr< ERT::FortIO > fortio;
+    std::vector< float > params( params_size );
+    for (const auto& step : this->unwritten_steps) {
+        const auto* tstep = step.get();
+        const int report_step = ecl_sum_tstep_get_report( tstep );
+        const bool new_report = (report_step != this->written_report_step);
+
+        if (!fortio || (new_report && !this->unified_output)) {
+            const auto filename = this->unified_output
+                ? ERT::EclFilename( this->basename, ECL_UNIFIED_SUMMARY_FILE, this->fmt_output )
+                : ERT::EclFilename( this->basename, ECL_SUMMARY_FILE, report_step, this->fmt_output );
+
+            /*
+              The unified file is truncated by the first write() of the run,
+              a non-unified file when its report step is started.
+            */
+            const bool truncate = this->unified_output
+                ? (this->written_report_step < 0)
+                : new_report;
+
+            fortio.reset( new ERT::FortIO( filename,
+                                           truncate ? std::ios_base::out : std::ios_base::app,
+                                           this->fmt_output,
+                                           ECL_ENDIAN_FLIP ) );
         }
+
+        if (new_report) {
+            ERT::EclKW< int > seqhdr( SEQHDR_KW, std::vector< int >( 1, 0 ) );
+            seqhdr.fwrite( *fortio );
+            this->written_report_step = report_step;
+        }
+
+        ERT::EclKW< int > ministep( MINISTEP_KW, std::vector< int >( 1, ecl_sum_tstep_get_ministep( tstep ) ) );
+        ministep.fwrite( *fortio );
+
+        for (int index = 0; index < params_size; ++index)
+            params[ index ] = ecl_sum_tstep_iget( tstep, index );
+
+        ERT::EclKW< float > params_kw( PARAMS_KW, params );
+        params_kw.fwrite( *fortio );
     }
 
-    this->prev_state = st;
-    this->prev_time_elapsed = secs_elapsed;
+    this->unwritten_steps.clear();
 }
 
-void Summary::write() {
-    ecl_sum_fwrite( this->ecl_sum.get() );
+Summary::~Summary() {}
+
+MemoryUsage Summary::memory_usage() const {
+    MemoryUsage usage( "Summary", sizeof( *this ) + MemoryUsage::heap( this->basename ) );
+    usage.add( "keyword handlers", this->handlers->memory_usage() );
+    usage.add( "region cache", this->regionCache.memory_usage() );
+    usage.add( "summary state", this->state.memory_usage() + this->prev_state.memory_usage() );
+    const auto params_size = ecl_smspec_get_params_size( ecl_sum_get_smspec( this->ecl_sum.get() ) );
+    usage.add( "unwritten steps", MemoryUsage::heap( this->unwritten_steps )
+               + this->unwritten_steps.size() * params_size * sizeof( float ) );
+    if (this->columnar)
+        usage.add( "columnar summary", this->columnar->memory_usage()
+                   + MemoryUsage::heap( this->columnar_index ) + MemoryUsage::heap( this->columnar_row ) );
+    usage.sort();
+    return usage;
 }
 
-Summary::~Summary() {}
+void Summary::set_restart_vectors(const std::vector<double>& values)
+{
+    if (values.size() != this->prev_state.size()) {
+        OpmLog::warning("The summary vectors in the restart file do not match the SUMMARY section - the cumulative vectors start from zero");
+        return;
+    }
+
+    this->prev_state.set_data(values);
+}
 
 const SummaryState& Summary::get_restart_vectors() const
 {
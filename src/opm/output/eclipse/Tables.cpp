@@ -37,12 +37,24 @@
 
 #include <opm/output/eclipse/LinearisedOutputTable.hpp>
 
+#include <opm/common/utility/ParallelChunks.hpp>
+
 #include <algorithm>
 #include <array>
 #include <cstddef>
 #include <iterator>
 #include <vector>
 
+namespace {
+    /// Call \p body for every table ID in [0, numTab), in parallel.
+    /// The tables must be independent of each other.
+    template <class Body>
+    void forEachTable(const std::size_t numTab, Body&& body)
+    {
+        Opm::forEachPosition(numTab, 16, body);
+    }
+}
+
 /// Functions to facilitate generating TAB vector entries for tabulated
 /// saturation functions.
 namespace { namespace SatFunc {
@@ -97,16 +109,18 @@ namespace { namespace SatFunc {
             const auto numPrim = std::size_t{1};
             const auto numCols = 1 + 2*numDep;
 
-            auto descr = ::Opm::DifferentiateOutputTable::Descriptor{};
-            descr.primID = 0 * numPrim;
-
             auto linTable = ::Opm::LinearisedOutputTable {
                 numTab, numPrim, numRows, numCols
             };
 
-            for (descr.tableID = 0*numTab;
-                 descr.tableID < 1*numTab; ++descr.tableID)
+            // Each table fills its own column ranges of linTable, so the
+            // tables are built concurrently.
+            forEachTable(numTab, [numPrim, numDep, &buildDeps, &linTable]
+                (const std::size_t tableID)
             {
+                auto descr = ::Opm::DifferentiateOutputTable::Descriptor{};
+                descr.tableID = tableID;
+                descr.primID  = 0 * numPrim;
                 descr.numActRows =
                     buildDeps(descr.tableID, descr.primID, linTable);
 
@@ -118,7 +132,7 @@ namespace { namespace SatFunc {
                 //    whence we unambiguously invoke function calcSlopes()
                 //    from namespace ::Opm::DifferentiateOutputTable.
                 calcSlopes(numDep, descr, linTable);
-            }
+            });
 
             return linTable.getDataDestructively();
         }
@@ -1071,8 +1085,8 @@ namespace Opm {
             size_t table_stride = dims.outer_size * composition_stride;
             size_t column_stride = table_stride * pvtoTables.size();
 
-            size_t table_index = 0;
-            for (const auto& table : pvtoTables) {
+            forEachTable(pvtoTables.size(), [&](const std::size_t table_index) {
+                const auto& table = pvtoTables[table_index];
                 size_t composition_index = 0;
                 for (const auto& underSatTable : table) {
                     const auto& p  = underSatTable.getColumn("P");
@@ -1100,8 +1114,7 @@ namespace Opm {
                     for (size_t index = 0; index < rs.size(); index++)
                         rs_values[index + table_index * dims.outer_size ] = rs[index];
                 }
-                table_index++;
-            }
+            });
 
             this->addData( TABDIMS_IBPVTO_OFFSET_ITEM , pvtoData );
             this->addData( TABDIMS_JBPVTO_OFFSET_ITEM , rs_values );
@@ -1122,8 +1135,8 @@ namespace Opm {
             size_t table_stride = dims.outer_size * composition_stride;
             size_t column_stride = table_stride * dims.num_tables;
 
-            size_t table_index = 0;
-            for (const auto& table : pvtgTables) {
+            forEachTable(pvtgTables.size(), [&](const std::size_t table_index) {
+                const auto& table = pvtgTables[table_index];
                 size_t composition_index = 0;
                 for (const auto& underSatTable : table) {
                     const auto& col0 = underSatTable.getColumn(0);
@@ -1148,9 +1161,7 @@ namespace Opm {
                         p_values[index + table_index * dims.outer_size ] =
                             this->units.from_si( UnitSystem::measure::pressure , p[index]);
                 }
-
-                table_index++;
-            }
+            });
 
             this->addData( TABDIMS_IBPVTG_OFFSET_ITEM , pvtgData );
             this->addData( TABDIMS_JBPVTG_OFFSET_ITEM , p_values );
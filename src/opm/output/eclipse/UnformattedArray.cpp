@@ -0,0 +1,184 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/output/eclipse/UnformattedArray.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+    const std::size_t blockSize = 1000;
+    const std::size_t headerSize = 4 + 16 + 4;
+    const std::size_t markerSize = 4;
+
+    std::size_t elementSize(Opm::RestartIO::Helpers::UnformattedArray::Type type) {
+        using Type = Opm::RestartIO::Helpers::UnformattedArray::Type;
+        return (type == Type::Double) ? 8 : 4;
+    }
+
+    const char* typeName(Opm::RestartIO::Helpers::UnformattedArray::Type type) {
+        using Type = Opm::RestartIO::Helpers::UnformattedArray::Type;
+        switch (type) {
+        case Type::Integer: return "INTE";
+        case Type::Float:   return "REAL";
+        default:            return "DOUB";
+        }
+    }
+
+    void put32(char* dst, std::uint32_t value) {
+        for (int byte = 0; byte < 4; byte++)
+            dst[byte] = static_cast<char>((value >> (24 - 8 * byte)) & 0xFF);
+    }
+
+    void put64(char* dst, std::uint64_t value) {
+        for (int byte = 0; byte < 8; byte++)
+            dst[byte] = static_cast<char>((value >> (56 - 8 * byte)) & 0xFF);
+    }
+
+    void encode(char* dst, double value, Opm::RestartIO::Helpers::UnformattedArray::Type type) {
+        using Type = Opm::RestartIO::Helpers::UnformattedArray::Type;
+        if (type == Type::Integer)
+            put32(dst, static_cast<std::uint32_t>(static_cast<std::int32_t>(value)));
+        else if (type == Type::Float) {
+            const float fvalue = static_cast<float>(value);
+            std::uint32_t bits;
+            std::memcpy(&bits, &fvalue, sizeof bits);
+            put32(dst, bits);
+        } else {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            put64(dst, bits);
+        }
+    }
+
+}
+
+
+namespace Opm { namespace RestartIO { namespace Helpers {
+
+    UnformattedArray::UnformattedArray(const std::string& keyword_arg, Type type_arg, std::size_t size_arg) :
+        keyword(keyword_arg),
+        type(type_arg),
+        count(size_arg)
+    {
+        if (this->keyword.size() > 8)
+            throw std::invalid_argument("The keyword " + keyword + " is longer than eight characters");
+
+        this->keyword.resize(8, ' ');
+    }
+
+
+    std::size_t UnformattedArray::size() const {
+        return this->count;
+    }
+
+
+    std::size_t UnformattedArray::byteSize() const {
+        const std::size_t blocks = (this->count + blockSize - 1) / blockSize;
+        return headerSize + blocks * 2 * markerSize + this->count * elementSize(this->type);
+    }
+
+
+    std::size_t UnformattedArray::elementOffset(std::size_t index) const {
+        const std::size_t block = index / blockSize;
+        const std::size_t blockBytes = 2 * markerSize + blockSize * elementSize(this->type);
+        return headerSize + block * blockBytes + markerSize + (index % blockSize) * elementSize(this->type);
+    }
+
+
+    void UnformattedArray::writeFrame(std::ostream& os, std::size_t offset) const {
+        char header[headerSize];
+        put32(header, 16);
+        std::memcpy(header + 4, this->keyword.data(), 8);
+        put32(header + 12, static_cast<std::uint32_t>(this->count));
+        std::memcpy(header + 16, typeName(this->type), 4);
+        put32(header + 20, 16);
+
+        os.seekp(offset);
+        os.write(header, headerSize);
+
+        for (std::size_t first = 0; first < this->count; first += blockSize) {
+            const std::size_t elements = std::min(blockSize, this->count - first);
+            char marker[markerSize];
+            put32(marker, static_cast<std::uint32_t>(elements * elementSize(this->type)));
+
+            os.seekp(offset + this->elementOffset(first) - markerSize);
+            os.write(marker, markerSize);
+            os.seekp(offset + this->elementOffset(first + elements - 1) + elementSize(this->type));
+            os.write(marker, markerSize);
+        }
+
+        if (!os)
+            throw std::runtime_error("Writing the frame of " + this->keyword + " failed");
+    }
+
+
+    template <typename T>
+    void UnformattedArray::write(std::ostream& os, std::size_t offset,
+                                 const std::vector<T>& values,
+                                 const std::vector<std::size_t>& globalIndex) const {
+        if (values.size() != globalIndex.size())
+            throw std::invalid_argument("The values and global indices of " + this->keyword + " differ in size");
+
+        const std::size_t es = elementSize(this->type);
+        std::vector<char> buffer;
+        std::size_t first = 0;
+        while (first < values.size()) {
+            if (globalIndex[first] >= this->count)
+                throw std::invalid_argument("Global index out of range for " + this->keyword);
+
+            // The run of consecutive cells within one record.
+            std::size_t last = first + 1;
+            while (last < values.size()
+                   && globalIndex[last] == globalIndex[last - 1] + 1
+                   && globalIndex[last] < this->count
+                   && globalIndex[last] / blockSize == globalIndex[first] / blockSize)
+                last++;
+
+            buffer.resize((last - first) * es);
+            for (std::size_t index = first; index < last; index++)
+                encode(buffer.data() + (index - first) * es, values[index], this->type);
+
+            os.seekp(offset + this->elementOffset(globalIndex[first]));
+            os.write(buffer.data(), buffer.size());
+            first = last;
+        }
+
+        if (!os)
+            throw std::runtime_error("Writing the values of " + this->keyword + " failed");
+    }
+
+
+    void UnformattedArray::writeValues(std::ostream& os, std::size_t offset,
+                                       const std::vector<double>& values,
+                                       const std::vector<std::size_t>& globalIndex) const {
+        this->write(os, offset, values, globalIndex);
+    }
+
+
+    void UnformattedArray::writeValues(std::ostream& os, std::size_t offset,
+                                       const std::vector<int>& values,
+                                       const std::vector<std::size_t>& globalIndex) const {
+        this->write(os, offset, values, globalIndex);
+    }
+
+}}} // Opm::RestartIO::Helpers
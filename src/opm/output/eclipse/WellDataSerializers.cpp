@@ -37,13 +37,13 @@ serialize_SCON(int lookup_step,
     std::vector<double> data(sched_wells.size() * well_field_size, 0);
     size_t well_offset = 0;
     for (const Opm::Well* well : sched_wells) {
-        const auto& connections = well->getConnections( lookup_step );
+        const auto& columns = well->getConnections( lookup_step ).columns();
         size_t connection_offset = 0;
         bool explicit_ctf_not_found = false;
-        for (const auto& connection : connections) {
+        for (size_t c = 0; c < columns.CF.size(); c++) {
             const size_t offset = well_offset + connection_offset;
-            data[ offset + SCON_CF_INDEX ] = units.from_si(Opm::UnitSystem::measure::transmissibility,connection.CF());
-            data[ offset + SCON_KH_INDEX ] = units.from_si(Opm::UnitSystem::measure::effective_Kh, connection.Kh());
+            data[ offset + SCON_CF_INDEX ] = units.from_si(Opm::UnitSystem::measure::transmissibility, columns.CF[ c ]);
+            data[ offset + SCON_KH_INDEX ] = units.from_si(Opm::UnitSystem::measure::effective_Kh, columns.Kh[ c ]);
             connection_offset += nsconz;
         }
         if (explicit_ctf_not_found) {
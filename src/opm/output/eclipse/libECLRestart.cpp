@@ -23,6 +23,7 @@
 #include <opm/output/eclipse/libECLRestart.hpp>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <cstddef>
 #include <time.h>
 #include <ctime>
@@ -31,6 +32,8 @@
 #include <iostream>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <fstream> 
 #include <fcntl.h>
 #include <cstdint>
@@ -1309,6 +1312,85 @@ static char * ecl_kw_alloc_input_buffer(const ::Opm::RestartIO::ecl_kw_type * ec
   return buffer;
 }
 
+/*
+  Numeric keywords with at least ECL_KW_MMAP_MIN_SIZE bytes of data are
+  decoded from a read-only mapping of the file, straight into the storage
+  of the keyword. This bypasses both the stdio buffer and the intermediate
+  input buffer of the fread() path.
+*/
+#define ECL_KW_MMAP_MIN_SIZE (1 << 20)
+
+static int ecl_kw_decode_record_size( const unsigned char * p ) {
+  if (ECL_ENDIAN_FLIP)
+    return static_cast<int>( (uint32_t( p[0] ) << 24) | (uint32_t( p[1] ) << 16) |
+                             (uint32_t( p[2] ) <<  8) |  uint32_t( p[3] ) );
+
+  int32_t size;
+  memcpy( &size , p , sizeof size );
+  return size;
+}
+
+/*
+  Read the @elements items of @element_size bytes, stored in Fortran
+  records of at most @blocksize items, from the current position of
+  @fortio into @data. Returns false, leaving the file position untouched,
+  if the mapping fails or the record structure is not as expected; the
+  caller should then fall back to fortio_fread_buffer().
+*/
+static bool ecl_kw_mmap_fread_data( fortio_type * fortio , char * data , int elements , int blocksize , int element_size) {
+  FILE * stream = fortio_get_FILE( fortio );
+  const off_t start = ftello( stream );
+  if (start < 0)
+    return false;
+
+  const int    records    = elements / blocksize + (elements % blocksize != 0);
+  const size_t data_size  = size_t( elements ) * element_size;
+  const size_t total_size = data_size + size_t( records ) * 2 * sizeof(int32_t);
+
+  const int fd = fileno( stream );
+  struct stat st;
+  if ((fd < 0) || (fstat( fd , &st ) != 0) || (st.st_size < off_t( start + total_size )))
+    return false;
+
+  const long   page_size  = sysconf( _SC_PAGESIZE );
+  const off_t  map_start  = start - (start % page_size);
+  const size_t map_offset = size_t( start - map_start );
+  const size_t map_size   = map_offset + total_size;
+
+  void * map = mmap( NULL , map_size , PROT_READ , MAP_PRIVATE , fd , map_start );
+  if (map == MAP_FAILED)
+    return false;
+
+  madvise( map , map_size , MADV_SEQUENTIAL );
+
+  bool ok = true;
+  {
+    const unsigned char * p = static_cast<const unsigned char *>( map ) + map_offset;
+    size_t copied = 0;
+    for (int record = 0; ok && (record < records); record++) {
+      const size_t record_size = std::min( data_size - copied , size_t( blocksize ) * element_size );
+      const int head = ecl_kw_decode_record_size( p );
+      const int tail = ecl_kw_decode_record_size( p + sizeof(int32_t) + record_size );
+
+      if ((head != static_cast<int>( record_size )) || (tail != head)) {
+        ok = false;
+        break;
+      }
+
+      memcpy( data + copied , p + sizeof(int32_t) , record_size );
+      copied += record_size;
+      p += record_size + 2 * sizeof(int32_t);
+    }
+  }
+  munmap( map , map_size );
+
+  if (ok)
+    ok = (fseeko( stream , start + off_t( total_size ) , SEEK_SET ) == 0);
+
+  return ok;
+}
+
+
 bool ecl_kw_fread_data(::Opm::RestartIO::ecl_kw_type *ecl_kw, fortio_type *fortio) {
   bool fmt_file                = fortio_fmt_file( fortio );
   if (ecl_kw->size > 0) {
@@ -1392,8 +1474,28 @@ bool ecl_kw_fread_data(::Opm::RestartIO::ecl_kw_type *ecl_kw, fortio_type *forti
       free(read_fmt);
       return true;
     } else {
-      char * buffer = ::Opm::RestartIO::ecl_kw_alloc_input_buffer(ecl_kw);
       const int sizeof_iotype = ::Opm::RestartIO::ecl_type_get_sizeof_iotype(ecl_kw->data_type);
+
+      /*
+        Numeric data has the same layout in the file as in memory, apart
+        from the byte order, and is read directly into the keyword.
+      */
+      if (::Opm::RestartIO::ecl_type_is_numeric(ecl_kw->data_type)) {
+        const size_t data_size = size_t( ecl_kw->size ) * sizeof_iotype;
+        bool read_ok = false;
+        if (data_size >= ECL_KW_MMAP_MIN_SIZE)
+          read_ok = ::Opm::RestartIO::ecl_kw_mmap_fread_data(fortio, ecl_kw->data, ecl_kw->size, blocksize, sizeof_iotype);
+
+        if (!read_ok)
+          read_ok = fortio_fread_buffer(fortio, ecl_kw->data, data_size);
+
+        if (read_ok && ECL_ENDIAN_FLIP)
+          ::Opm::RestartIO::util_endian_flip_vector(ecl_kw->data, sizeof_iotype, ecl_kw->size);
+
+        return read_ok;
+      }
+
+      char * buffer = ::Opm::RestartIO::ecl_kw_alloc_input_buffer(ecl_kw);
       bool read_ok = fortio_fread_buffer(fortio, buffer, ecl_kw->size * sizeof_iotype);
 
       if (read_ok)
@@ -1613,6 +1715,134 @@ static ::Opm::RestartIO::ecl_kw_type * ecl_file_view_get_kw(const ::Opm::Restart
 }
 
 
+template <typename T>
+static void ecl_kw_gather_double( const T * src , const std::size_t * index , std::size_t index_size , double * data) {
+  for (std::size_t i = 0; i < index_size; i++)
+    data[i] = src[index[i]];
+}
+
+
+/*
+  Read the elements @index[0..index_size) of the ith occurence of the
+  float or double keyword @kw, converted to double, into @data without
+  loading the whole keyword. The data of a binary keyword is stored in
+  Fortran records of BLOCKSIZE_NUMERIC elements following the header
+  record, so the position of an element follows from its index; the
+  elements are read in file order, one fread() for every run of
+  neighbouring elements within a record, and the size marker of every
+  record visited is checked.
+
+  A keyword which is already loaded is gathered from memory. Returns
+  false, having read nothing, for formatted files, other data types and
+  indices outside the keyword; the keyword must then be loaded in full.
+*/
+bool ecl_file_view_index_fread_kw( const ::Opm::RestartIO::ecl_file_view_type * ecl_file_view , const char * kw , int ith ,
+                                   const std::size_t * index , std::size_t index_size , double * data) {
+  const ::Opm::RestartIO::ecl_file_kw_type * file_kw = ::Opm::RestartIO::ecl_file_view_iget_named_file_kw( ecl_file_view , kw , ith );
+  const ::Opm::RestartIO::ecl_data_type data_type = file_kw->data_type;
+  const bool is_double = ::Opm::RestartIO::ecl_type_is_double( data_type );
+  if (!is_double && !::Opm::RestartIO::ecl_type_is_float( data_type ))
+    return false;
+
+  const std::size_t kw_size = static_cast<std::size_t>( file_kw->kw_size );
+  for (std::size_t i = 0; i < index_size; i++)
+    if (index[i] >= kw_size)
+      return false;
+
+  if (file_kw->kw != NULL) {
+    if (is_double)
+      ecl_kw_gather_double( reinterpret_cast<const double *>( file_kw->kw->data ) , index , index_size , data );
+    else
+      ecl_kw_gather_double( reinterpret_cast<const float *>( file_kw->kw->data ) , index , index_size , data );
+    return true;
+  }
+
+  fortio_type * fortio = ecl_file_view->fortio;
+  if (fortio == NULL || fortio_fmt_file( fortio ) || !fortio_assert_stream_open( fortio ))
+    return false;
+
+  FILE * stream = fortio_get_FILE( fortio );
+  const std::size_t element_size = ::Opm::RestartIO::ecl_type_get_sizeof_iotype( data_type );
+  const std::size_t blocksize    = BLOCKSIZE_NUMERIC;
+  const std::size_t record_bytes = blocksize * element_size + 2 * sizeof(int32_t);
+  const std::size_t header_bytes = ECL_STRING8_LENGTH + sizeof(int32_t) + ECL_TYPE_LENGTH;
+  const ::Opm::RestartIO::offset_type data_start = file_kw->file_offset + header_bytes + 2 * sizeof(int32_t);
+
+  const auto record_marker = [stream]( ::Opm::RestartIO::offset_type pos , int * size ) {
+    unsigned char marker[sizeof(int32_t)];
+    if ((fseeko( stream , pos , SEEK_SET ) != 0) || (fread( marker , sizeof marker , 1 , stream ) != 1))
+      return false;
+
+    *size = ecl_kw_decode_record_size( marker );
+    return true;
+  };
+
+  std::vector<std::size_t> order( index_size );
+  for (std::size_t i = 0; i < index_size; i++)
+    order[i] = i;
+  std::sort( order.begin() , order.end() , [index]( std::size_t i1 , std::size_t i2 ) { return index[i1] < index[i2]; });
+
+  bool ok = true;
+  {
+    int header_size = 0;
+    ok = record_marker( file_kw->file_offset , &header_size ) && (header_size == static_cast<int>( header_bytes ));
+  }
+
+  std::vector<char> buffer;
+  std::size_t checked_record = kw_size;
+  std::size_t pos = 0;
+  while (ok && (pos < index_size)) {
+    const std::size_t first  = index[order[pos]];
+    const std::size_t record = first / blocksize;
+    std::size_t end = pos + 1;
+    while ((end < index_size) && (index[order[end]] - index[order[end - 1]] <= 1) && (index[order[end]] / blocksize == record))
+      end++;
+    const std::size_t last = index[order[end - 1]];
+
+    const ::Opm::RestartIO::offset_type record_start = data_start + record * record_bytes;
+    if (record != checked_record) {
+      const std::size_t elements = std::min( blocksize , kw_size - record * blocksize );
+      int size = 0;
+      if (!record_marker( record_start , &size ) || (size != static_cast<int>( elements * element_size ))) {
+        ok = false;
+        break;
+      }
+      checked_record = record;
+    }
+
+    const std::size_t count = last - first + 1;
+    buffer.resize( count * element_size );
+    const ::Opm::RestartIO::offset_type offset = record_start + sizeof(int32_t) + (first - record * blocksize) * element_size;
+    if ((fseeko( stream , offset , SEEK_SET ) != 0) || (fread( buffer.data() , element_size , count , stream ) != count)) {
+      ok = false;
+      break;
+    }
+
+    if (ECL_ENDIAN_FLIP)
+      ::Opm::RestartIO::util_endian_flip_vector( buffer.data() , element_size , count );
+
+    for (std::size_t i = pos; i < end; i++) {
+      const std::size_t element = index[order[i]] - first;
+      if (is_double) {
+        double value;
+        memcpy( &value , &buffer[element * element_size] , sizeof value );
+        data[order[i]] = value;
+      } else {
+        float value;
+        memcpy( &value , &buffer[element * element_size] , sizeof value );
+        data[order[i]] = value;
+      }
+    }
+    pos = end;
+  }
+
+  if (::Opm::RestartIO::ecl_file_view_flags_set( ecl_file_view , ECL_FILE_CLOSE_STREAM))
+    fortio_fclose_stream( fortio );
+
+  return ok;
+}
+
+
 
 bool ecl_file_view_flags_set( const ::Opm::RestartIO::ecl_file_view_type * file_view , int query_flags) {
   return ::Opm::RestartIO::ecl_file_view_check_flags( *file_view->flags , query_flags );
@@ -2354,6 +2584,10 @@ const char * ecl_file_kw_get_header( const ::Opm::RestartIO::ecl_file_kw_type *
   return file_kw->header;
 }
 
+int ecl_file_kw_get_size( const ::Opm::RestartIO::ecl_file_kw_type * file_kw ) {
+  return file_kw->kw_size;
+}
+
 const int * int_vector_get_const_ptr(const ::Opm::RestartIO::int_vector_type * vector) {
   return vector->data;
 }
@@ -3806,6 +4040,204 @@ static bool ecl_file_scan( ::Opm::RestartIO::ecl_file_type * ecl_file ) {
   return scan_ok;
 }
 
+
+/**
+   The keyword index built by ecl_file_scan() is cached in a side file
+   named as the file with the suffix ECL_FILE_INDEX_SUFFIX, so opening a
+   long unified restart file again does not have to visit the header of
+   every keyword in the file. The cache is only written for files of at
+   least ECL_FILE_INDEX_MIN_SIZE bytes, and is ignored unless the size and
+   modification time of the file are unchanged and the last indexed
+   keyword is found at its recorded offset.
+
+   Layout: the magic string, version, file size, file mtime and number of
+   keywords, followed by (header, type name, size, offset) for every
+   keyword. Integers are stored in native byte order.
+*/
+
+#define ECL_FILE_INDEX_SUFFIX   ".OPMIDX"
+#define ECL_FILE_INDEX_MAGIC    "OPMKWIDX"
+#define ECL_FILE_INDEX_VERSION  1
+#define ECL_FILE_INDEX_MIN_SIZE (int64_t( 64 ) << 20)
+
+static bool is_ecl_string_name(const char * type_name);
+
+namespace {
+
+  struct ecl_file_index_entry {
+    char         header[ECL_STRING8_LENGTH + 1];
+    char         type_name[ECL_TYPE_LENGTH + 1];
+    int32_t      kw_size;
+    int64_t      offset;
+  };
+
+  bool ecl_file_index_stat( const char * filename , int64_t * file_size , int64_t * mtime) {
+    struct stat buffer;
+    if (stat( filename , &buffer ) != 0)
+      return false;
+
+    *file_size = static_cast<int64_t>( buffer.st_size );
+    *mtime = static_cast<int64_t>( buffer.st_mtime );
+    return true;
+  }
+
+  bool ecl_file_index_valid_type( const char * type_name ) {
+    return (strcmp( type_name , ECL_TYPE_NAME_CHAR ) == 0)
+        || (strcmp( type_name , ECL_TYPE_NAME_FLOAT ) == 0)
+        || (strcmp( type_name , ECL_TYPE_NAME_INT ) == 0)
+        || (strcmp( type_name , ECL_TYPE_NAME_DOUBLE ) == 0)
+        || (strcmp( type_name , ECL_TYPE_NAME_BOOL ) == 0)
+        || (strcmp( type_name , ECL_TYPE_NAME_MESSAGE ) == 0)
+        || ::Opm::RestartIO::is_ecl_string_name( type_name );
+  }
+
+  template <typename T>
+  bool ecl_file_index_read( FILE * stream , T * value ) {
+    return fread( value , sizeof * value , 1 , stream ) == 1;
+  }
+
+  template <typename T>
+  bool ecl_file_index_write( FILE * stream , const T& value ) {
+    return fwrite( &value , sizeof value , 1 , stream ) == 1;
+  }
+
+}
+
+/*
+  Populate the global view from the index file; returns false, leaving
+  the ecl_file untouched, if there is no valid index.
+*/
+static bool ecl_file_load_index( ::Opm::RestartIO::ecl_file_type * ecl_file , const char * filename ) {
+  int64_t file_size, mtime;
+  if (!ecl_file_index_stat( filename , &file_size , &mtime ))
+    return false;
+
+  const std::string index_file = std::string( filename ) + ECL_FILE_INDEX_SUFFIX;
+  FILE * stream = fopen( index_file.c_str() , "rb" );
+  if (stream == NULL)
+    return false;
+
+  std::vector< ecl_file_index_entry > entries;
+  bool valid = false;
+  {
+    char magic[8];
+    int32_t version;
+    int64_t index_file_size, index_mtime, count;
+
+    if ((fread( magic , 1 , sizeof magic , stream ) == sizeof magic) &&
+        (memcmp( magic , ECL_FILE_INDEX_MAGIC , sizeof magic ) == 0) &&
+        ecl_file_index_read( stream , &version ) && (version == ECL_FILE_INDEX_VERSION) &&
+        ecl_file_index_read( stream , &index_file_size ) && (index_file_size == file_size) &&
+        ecl_file_index_read( stream , &index_mtime ) && (index_mtime == mtime) &&
+        ecl_file_index_read( stream , &count ) && (count > 0) && (count < file_size)) {
+
+      entries.resize( count );
+      valid = true;
+      for (auto& entry : entries) {
+        if (!(ecl_file_index_read( stream , &entry.header ) &&
+              ecl_file_index_read( stream , &entry.type_name ) &&
+              ecl_file_index_read( stream , &entry.kw_size ) &&
+              ecl_file_index_read( stream , &entry.offset ))) {
+          valid = false;
+          break;
+        }
+
+        entry.header[ECL_STRING8_LENGTH] = '\0';
+        entry.type_name[ECL_TYPE_LENGTH] = '\0';
+        if ((entry.kw_size < 0) || (entry.offset < 0) || (entry.offset >= file_size) ||
+            !ecl_file_index_valid_type( entry.type_name )) {
+          valid = false;
+          break;
+        }
+      }
+    }
+  }
+  fclose( stream );
+
+  if (!valid)
+    return false;
+
+  /* The last keyword must be found where the index says it is. */
+  {
+    const auto& last = entries.back();
+    ::Opm::RestartIO::ecl_kw_type * work_kw = ::Opm::RestartIO::ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT_2 , NULL);
+
+    fortio_fseek( ecl_file->fortio , last.offset , SEEK_SET );
+    valid = (::Opm::RestartIO::ecl_kw_fread_header( work_kw , ecl_file->fortio ) == ::Opm::RestartIO::ECL_KW_READ_OK)
+         && (strcmp( ::Opm::RestartIO::ecl_kw_get_header( work_kw ) , last.header ) == 0)
+         && (::Opm::RestartIO::ecl_kw_get_size( work_kw ) == last.kw_size);
+
+    ::Opm::RestartIO::ecl_kw_free( work_kw );
+    fortio_fseek( ecl_file->fortio , 0 , SEEK_SET );
+  }
+
+  if (!valid)
+    return false;
+
+  for (const auto& entry : entries) {
+    ::Opm::RestartIO::ecl_file_kw_type * file_kw =
+      ::Opm::RestartIO::ecl_file_kw_alloc0( entry.header ,
+                                            ::Opm::RestartIO::ecl_type_create_from_name( entry.type_name ) ,
+                                            entry.kw_size ,
+                                            static_cast< ::Opm::RestartIO::offset_type >( entry.offset ));
+    ::Opm::RestartIO::ecl_file_view_add_kw( ecl_file->global_view , file_kw );
+  }
+  ::Opm::RestartIO::ecl_file_view_make_index( ecl_file->global_view );
+
+  return true;
+}
+
+/*
+  Write the index of the global view. The index is written to a temporary
+  file which is renamed in place; failing to write it is silently ignored.
+*/
+static void ecl_file_save_index( const ::Opm::RestartIO::ecl_file_type * ecl_file , const char * filename ) {
+  int64_t file_size, mtime;
+  if (!ecl_file_index_stat( filename , &file_size , &mtime ) || (file_size < ECL_FILE_INDEX_MIN_SIZE))
+    return;
+
+  const auto * kw_list = ecl_file->global_view->kw_list;
+  const int64_t count = ::Opm::RestartIO::vector_get_size( kw_list );
+  if (count == 0)
+    return;
+
+  const std::string index_file = std::string( filename ) + ECL_FILE_INDEX_SUFFIX;
+  const std::string tmp_file = index_file + ".tmp";
+  FILE * stream = fopen( tmp_file.c_str() , "wb" );
+  if (stream == NULL)
+    return;
+
+  bool ok = (fwrite( ECL_FILE_INDEX_MAGIC , 1 , 8 , stream ) == 8)
+         && ecl_file_index_write( stream , int32_t( ECL_FILE_INDEX_VERSION ) )
+         && ecl_file_index_write( stream , file_size )
+         && ecl_file_index_write( stream , mtime )
+         && ecl_file_index_write( stream , count );
+
+  for (int i = 0; ok && (i < count); i++) {
+    const auto * file_kw = static_cast<const ::Opm::RestartIO::ecl_file_kw_type *>( ::Opm::RestartIO::vector_iget_const( kw_list , i ));
+    ecl_file_index_entry entry;
+    memset( &entry , 0 , sizeof entry );
+
+    strncpy( entry.header , file_kw->header , ECL_STRING8_LENGTH );
+    {
+      char * type_name = ::Opm::RestartIO::ecl_type_alloc_name( file_kw->data_type );
+      strncpy( entry.type_name , type_name , ECL_TYPE_LENGTH );
+      free( type_name );
+    }
+    entry.kw_size = file_kw->kw_size;
+    entry.offset = static_cast<int64_t>( file_kw->file_offset );
+
+    ok = ecl_file_index_write( stream , entry.header )
+      && ecl_file_index_write( stream , entry.type_name )
+      && ecl_file_index_write( stream , entry.kw_size )
+      && ecl_file_index_write( stream , entry.offset );
+  }
+
+  ok = (fclose( stream ) == 0) && ok;
+  if (!ok || (rename( tmp_file.c_str() , index_file.c_str() ) != 0))
+    remove( tmp_file.c_str() );
+}
+
 void ecl_file_select_global( ::Opm::RestartIO::ecl_file_type * ecl_file ) {
   ecl_file->active_view = ecl_file->global_view;
 }
@@ -3818,7 +4250,13 @@ void ecl_file_select_global( ::Opm::RestartIO::ecl_file_type * ecl_file ) {
     ecl_file->fortio = fortio;
     ecl_file->global_view = ::Opm::RestartIO::ecl_file_view_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_view , true );
 
-    if (::Opm::RestartIO::ecl_file_scan( ecl_file )) {
+    bool indexed = ::Opm::RestartIO::ecl_file_load_index( ecl_file , filename );
+    if (!indexed && ::Opm::RestartIO::ecl_file_scan( ecl_file )) {
+      ::Opm::RestartIO::ecl_file_save_index( ecl_file , filename );
+      indexed = true;
+    }
+
+    if (indexed) {
       ::Opm::RestartIO::ecl_file_select_global( ecl_file );
 
       if (ecl_file_view_check_flags( ecl_file->flags , ::Opm::RestartIO::ECL_FILE_CLOSE_STREAM))
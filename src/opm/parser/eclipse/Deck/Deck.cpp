@@ -21,39 +21,43 @@
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 namespace Opm {
 
     bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
-        auto key = this->keywordMap.find( keyword.name() );
-
-        if( key == this->keywordMap.end() ) return false;
-
-        for( auto index : key->second )
-            if( &this->getKeyword( index ) == &keyword ) return true;
+        for( const auto& kw : this->getKeywordRange( keyword.name() ) )
+            if( &kw == &keyword ) return true;
 
         return false;
     }
 
     bool DeckView::hasKeyword( const std::string& keyword ) const {
-        return this->keywordMap.find( keyword ) != this->keywordMap.end();
+        const auto range = this->offsets( keyword );
+        return range.first != range.second;
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword, size_t index ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto range = this->getKeywordRange( keyword );
+        if( range.empty() )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).at( index ) );
+        if( index >= range.size() )
+            throw std::out_of_range("Keyword " + keyword + " index " + std::to_string( index ) + " is out of range.");
+
+        return range[ index ];
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto range = this->getKeywordRange( keyword );
+        if( range.empty() )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).back() );
+        return range.back();
     }
 
     const DeckKeyword& DeckView::getKeyword( size_t index ) const {
@@ -64,25 +68,27 @@ namespace Opm {
     }
 
     size_t DeckView::count( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) ) return 0;
-
-        return this->offsets( keyword ).size();
+        const auto range = this->offsets( keyword );
+        return std::distance( range.first, range.second );
    }
 
     const std::vector< const DeckKeyword* > DeckView::getKeywordList( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return {};
-
-        const auto& indices = this->offsets( keyword );
+        const auto range = this->getKeywordRange( keyword );
 
         std::vector< const DeckKeyword* > ret;
-        ret.reserve( indices.size() );
+        ret.reserve( range.size() );
 
-        for( size_t i : indices )
-            ret.push_back( &this->getKeyword( i ) );
+        for( const auto& kw : range )
+            ret.push_back( &kw );
 
         return ret;
     }
 
+    DeckView::KeywordRange DeckView::getKeywordRange( const std::string& keyword ) const {
+        const auto range = this->offsets( keyword );
+        return KeywordRange( range.first, range.second, this->begin(), this->start() );
+    }
+
     size_t DeckView::size() const {
         return std::distance( this->begin(), this->end() );
     }
@@ -96,40 +102,70 @@ namespace Opm {
     }
 
     void DeckView::add( const DeckKeyword* kw, const_iterator f, const_iterator l ) {
-        this->keywordMap[ kw->name() ].push_back( std::distance( f, l ) - 1 );
+        (*this->keywordIndex)[ kw->name() ].push_back( std::distance( f, l ) - 1 );
         this->first = f;
         this->last = l;
     }
 
     static const std::vector< size_t > empty_indices = {};
-    const std::vector< size_t >& DeckView::offsets( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return empty_indices;
+    DeckView::offset_range DeckView::offsets( const std::string& keyword ) const {
+        const auto key = this->keywordIndex->find( keyword );
+        if( key == this->keywordIndex->end() )
+            return { empty_indices.begin(), empty_indices.end() };
+
+        const auto& positions = key->second;
+        const size_t stop = this->start() + this->size();
+
+        auto lo = positions.begin();
+        auto hi = positions.end();
+        if( this->start() > 0 )
+            lo = std::lower_bound( positions.begin(), positions.end(), this->start() );
 
-        return this->keywordMap.find( keyword )->second;
+        if( lo != hi && positions.back() >= stop )
+            hi = std::lower_bound( lo, positions.end(), stop );
+
+        return { lo, hi };
+    }
+
+    size_t DeckView::start() const {
+        return this->first_position;
     }
 
     DeckView::DeckView( const_iterator first_arg, const_iterator last_arg ) :
-        first( first_arg ), last( last_arg )
+        first( first_arg ), last( last_arg ),
+        keywordIndex( std::make_shared< KeywordIndex >() )
     {
         size_t index = 0;
         for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
+            (*this->keywordIndex)[ kw.name() ].push_back( index++ );
     }
 
+    DeckView::DeckView( const DeckView& whole, size_t first_arg, size_t last_arg ) :
+        first( whole.begin() + first_arg ), last( whole.begin() + last_arg ),
+        keywordIndex( whole.keywordIndex ),
+        first_position( whole.start() + first_arg )
+    {}
+
     void DeckView::reinit( const_iterator first_arg, const_iterator last_arg ) {
         this->first = first_arg;
         this->last = last_arg;
+        this->first_position = 0;
 
-        this->keywordMap.clear();
+        // A fresh index; the old one may be shared with other views.
+        this->keywordIndex = std::make_shared< KeywordIndex >();
 
         size_t index = 0;
         for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
+            (*this->keywordIndex)[ kw.name() ].push_back( index++ );
     }
 
-    DeckView::DeckView( std::pair< const_iterator, const_iterator > limits ) :
-        DeckView( limits.first, limits.second )
-    {}
+    size_t DeckView::indexMemoryUsage() const {
+        size_t bytes = sizeof( *this->keywordIndex );
+        for( const auto& entry : *this->keywordIndex )
+            bytes += sizeof( entry ) + MemoryUsage::heap( entry.first ) + MemoryUsage::heap( entry.second );
+
+        return bytes;
+    }
 
     Deck::Deck() : Deck( std::vector< DeckKeyword >() ) {}
 
@@ -154,6 +190,9 @@ namespace Opm {
             this->activeUnits = UnitSystem::newFIELD();
         if( this->hasKeyword( "METRIC" ) )
             this->activeUnits = UnitSystem::newMETRIC();
+
+        for( const auto& keyword : this->keywordList )
+            this->addFingerprint( keyword );
     }
 
     Deck::Deck( std::initializer_list< DeckKeyword > ilist ) :
@@ -170,11 +209,32 @@ namespace Opm {
         defaultUnits( d.defaultUnits ),
         activeUnits( d.activeUnits ),
         m_dataFile( d.m_dataFile ),
-        input_path( d.input_path ) {
+        input_path( d.input_path ),
+        input_files( d.input_files ),
+        m_fingerprint( d.m_fingerprint ),
+        m_fileFingerprints( d.m_fileFingerprints ) {
+        this->reinit(this->keywordList.begin(), this->keywordList.end());
+    }
+
+    Deck::Deck( Deck&& d ) :
+        DeckView( d.begin(), d.begin() ),
+        keywordList( std::move( d.keywordList ) ),
+        defaultUnits( d.defaultUnits ),
+        activeUnits( d.activeUnits ),
+        m_dataFile( std::move( d.m_dataFile ) ),
+        input_path( std::move( d.input_path ) ),
+        input_files( std::move( d.input_files ) ),
+        m_fingerprint( d.m_fingerprint ),
+        m_fileFingerprints( std::move( d.m_fileFingerprints ) ) {
         this->reinit(this->keywordList.begin(), this->keywordList.end());
+        d.keywordList.clear();
+        d.m_fingerprint = Fingerprint();
+        d.m_fileFingerprints.clear();
+        d.reinit(d.keywordList.begin(), d.keywordList.end());
     }
 
     void Deck::addKeyword( DeckKeyword&& keyword ) {
+        this->addFingerprint( keyword );
         this->keywordList.push_back( std::move( keyword ) );
 
         auto fst = this->keywordList.begin();
@@ -189,6 +249,23 @@ namespace Opm {
     }
 
 
+    void Deck::addFingerprint( const DeckKeyword& keyword ) {
+        this->m_fingerprint.add( keyword.fingerprint() );
+        this->m_fileFingerprints[ keyword.getFileName() ].add( keyword.fingerprint() );
+    }
+
+    const Fingerprint& Deck::fingerprint() const {
+        return this->m_fingerprint;
+    }
+
+    Fingerprint Deck::fingerprint( const std::string& fileName ) const {
+        const auto pos = this->m_fileFingerprints.find( fileName );
+        if( pos == this->m_fileFingerprints.end() )
+            return Fingerprint();
+
+        return pos->second;
+    }
+
     DeckKeyword& Deck::getKeyword( size_t index ) {
         return this->keywordList.at( index );
     }
@@ -238,6 +315,14 @@ namespace Opm {
             this->input_path = dataFile.substr(0, slash_pos);
     }
 
+    const std::vector< std::string >& Deck::getInputFiles() const {
+        return this->input_files;
+    }
+
+    void Deck::setInputFiles(const std::vector< std::string >& inputFiles) {
+        this->input_files = inputFiles;
+    }
+
     Deck::iterator Deck::begin() {
         return this->keywordList.begin();
     }
@@ -257,6 +342,37 @@ namespace Opm {
         }
     }
 
+    MemoryUsage Deck::memory_usage() const {
+        const auto unused = this->keywordList.capacity() - this->keywordList.size();
+        MemoryUsage usage( "Deck", sizeof( *this ) + unused * sizeof( DeckKeyword )
+                                   + MemoryUsage::heap( this->m_dataFile )
+                                   + MemoryUsage::heap( this->input_path )
+                                   + MemoryUsage::heap( this->input_files ) );
+
+        usage.add( "keyword index", this->indexMemoryUsage() );
+        auto& keywords = usage.add( "keywords", 0 );
+        for( const auto& keyword : this->keywordList )
+            keywords.accumulate( keyword.memory_usage() );
+
+        keywords.sort();
+        return usage;
+    }
+
+    /*
+      The items are converted one by one, every item in parallel blocks,
+      see Dimension::convertRawToSi().
+    */
+    void Deck::convertToSI( size_t min_size ) const {
+        for( const auto& keyword : this->keywordList ) {
+            for( const auto& record : keyword ) {
+                for( const auto& item : record ) {
+                    if( item.size() >= min_size )
+                        item.convertToSI();
+                }
+            }
+        }
+    }
+
     std::ostream& operator<<(std::ostream& os, const Deck& deck) {
         DeckOutput out( os, 10 );
         deck.write( out );
@@ -0,0 +1,551 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckCache.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm {
+
+namespace {
+
+/*
+ * Bump the version whenever the layout below, or the layout of any of the
+ * Deck classes, changes.
+ */
+const char magic[ 8 ] = { 'O', 'P', 'M', 'D', 'E', 'C', 'K', '\0' };
+const char include_magic[ 8 ] = { 'O', 'P', 'M', 'I', 'N', 'C', 'L', '\0' };
+const std::uint32_t version = 2;
+
+/* thrown on truncated or otherwise unexpected cache contents */
+struct corrupt_cache {};
+
+class writer {
+    public:
+        template< typename T >
+        void pod( T x ) {
+            this->buffer.append( reinterpret_cast< const char* >( &x ), sizeof( x ) );
+        }
+
+        void str( const std::string& s ) {
+            this->pod< std::uint64_t >( s.size() );
+            this->buffer.append( s );
+        }
+
+        template< typename T >
+        void vec( const std::vector< T >& v ) {
+            this->pod< std::uint64_t >( v.size() );
+            this->buffer.append( reinterpret_cast< const char* >( v.data() ),
+                                 v.size() * sizeof( T ) );
+        }
+
+        void vec( const std::vector< std::string >& v ) {
+            this->pod< std::uint64_t >( v.size() );
+            for( const auto& s : v ) this->str( s );
+        }
+
+        std::string buffer;
+};
+
+class reader {
+    public:
+        reader( const char* first, const char* last ) : cursor( first ), end( last ) {}
+
+        template< typename T >
+        T pod() {
+            T x;
+            std::memcpy( &x, this->take( sizeof( x ) ), sizeof( x ) );
+            return x;
+        }
+
+        std::string str() {
+            const auto n = this->pod< std::uint64_t >();
+            return std::string( this->take( n ), n );
+        }
+
+        template< typename T >
+        void vec( std::vector< T >& v ) {
+            const auto n = this->pod< std::uint64_t >();
+            if( n > std::uint64_t( this->end - this->cursor ) / sizeof( T ) )
+                throw corrupt_cache();
+
+            v.resize( n );
+            std::memcpy( v.data(), this->take( n * sizeof( T ) ), n * sizeof( T ) );
+        }
+
+        void vec( std::vector< std::string >& v ) {
+            const auto n = this->pod< std::uint64_t >();
+            v.clear();
+            v.reserve( std::min< std::uint64_t >( n, this->end - this->cursor ) );
+            for( std::uint64_t i = 0; i < n; ++i )
+                v.push_back( this->str() );
+        }
+
+        bool done() const {
+            return this->cursor == this->end;
+        }
+
+    private:
+        const char* take( std::uint64_t n ) {
+            if( n > std::uint64_t( this->end - this->cursor ) )
+                throw corrupt_cache();
+
+            const char* p = this->cursor;
+            this->cursor += n;
+            return p;
+        }
+
+        const char* cursor;
+        const char* end;
+};
+
+bool read_file( const std::string& filename, std::string& content ) {
+    std::unique_ptr< std::FILE, decltype( &std::fclose ) > fp {
+        std::fopen( filename.c_str(), "rb" ),
+        &std::fclose
+    };
+
+    if( !fp ) return false;
+
+    content.clear();
+    char chunk[ 1 << 16 ];
+    std::size_t n;
+    while( ( n = std::fread( chunk, 1, sizeof( chunk ), fp.get() ) ) > 0 )
+        content.append( chunk, n );
+
+    return !std::ferror( fp.get() );
+}
+
+bool hash_file( const std::string& filename, std::uint64_t& size, std::uint64_t& digest ) {
+    std::unique_ptr< std::FILE, decltype( &std::fclose ) > fp {
+        std::fopen( filename.c_str(), "rb" ),
+        &std::fclose
+    };
+
+    if( !fp ) return false;
+
+    size = 0;
+    digest = DeckCache::hash( nullptr, 0 );
+
+    std::vector< char > chunk( 1 << 20 );
+    std::size_t n;
+    while( ( n = std::fread( chunk.data(), 1, chunk.size(), fp.get() ) ) > 0 ) {
+        digest = DeckCache::hash( chunk.data(), n, digest );
+        size += n;
+    }
+
+    return !std::ferror( fp.get() );
+}
+
+/*
+ * The file is written to a temporary and moved in place, so concurrent
+ * readers never see a partial file.
+ */
+bool write_file( const std::string& filename, const std::string& content ) {
+    boost::system::error_code ec;
+    const auto tmp = boost::filesystem::unique_path( filename + ".%%%%-%%%%", ec );
+    if( ec ) return false;
+
+    {
+        std::ofstream stream( tmp.string(), std::ios::binary );
+        stream.write( content.data(), content.size() );
+        stream.close();
+
+        if( !stream ) {
+            boost::filesystem::remove( tmp, ec );
+            return false;
+        }
+    }
+
+    boost::filesystem::rename( tmp, filename, ec );
+    if( ec ) {
+        boost::filesystem::remove( tmp, ec );
+        return false;
+    }
+
+    return true;
+}
+
+UnitSystem make_units( UnitSystem::UnitType type ) {
+    switch( type ) {
+        case UnitSystem::UnitType::UNIT_TYPE_METRIC: return UnitSystem::newMETRIC();
+        case UnitSystem::UnitType::UNIT_TYPE_FIELD:  return UnitSystem::newFIELD();
+        case UnitSystem::UnitType::UNIT_TYPE_LAB:    return UnitSystem::newLAB();
+        case UnitSystem::UnitType::UNIT_TYPE_PVT_M:  return UnitSystem::newPVT_M();
+        default: throw corrupt_cache();
+    }
+}
+
+}
+
+/*
+ * The Deck classes are (de)serialized here rather than through member
+ * functions, which keeps the binary layout in one place. DeckItem,
+ * DeckKeyword and Dimension befriend DeckCacheIO for this.
+ */
+struct DeckCacheIO {
+    enum : std::uint8_t {
+        no_defaults = 0,
+        all_defaults = 1,
+        mixed_defaults = 2,
+    };
+
+    static void write( writer& out, const DeckItem& item ) {
+        out.str( item.item_name.str() );
+        out.pod< std::uint8_t >( static_cast< std::uint8_t >( item.type ) );
+
+        switch( item.type ) {
+            case type_tag::integer: out.vec( item.ival ); break;
+            case type_tag::fdouble: out.vec( item.dval ); break;
+            case type_tag::string:  out.vec( item.sval ); break;
+            default: break;
+        }
+        out.vec( item.runs );
+
+        const auto& def = item.defaulted;
+        const auto count = std::count( def.begin(), def.end(), true );
+        out.pod< std::uint64_t >( def.size() );
+        if( count == 0 ) {
+            out.pod< std::uint8_t >( no_defaults );
+        } else if( std::size_t( count ) == def.size() ) {
+            out.pod< std::uint8_t >( all_defaults );
+        } else {
+            out.pod< std::uint8_t >( mixed_defaults );
+            for( bool d : def ) out.pod< std::uint8_t >( d );
+        }
+
+        out.pod< std::uint64_t >( item.dimensions.size() );
+        for( const auto& dim : item.dimensions ) {
+            out.str( dim.getName() );
+            out.pod( dim.m_SIfactor );
+            out.pod( dim.getSIOffset() );
+        }
+    }
+
+    static DeckItem read_item( reader& in ) {
+        DeckItem item;
+        item.item_name = Symbol( in.str() );
+
+        const auto type = in.pod< std::uint8_t >();
+        switch( type ) {
+            case static_cast< std::uint8_t >( type_tag::integer ):
+                item.type = type_tag::integer;
+                in.vec( item.ival );
+                break;
+            case static_cast< std::uint8_t >( type_tag::fdouble ):
+                item.type = type_tag::fdouble;
+                in.vec( item.dval );
+                break;
+            case static_cast< std::uint8_t >( type_tag::string ):
+                item.type = type_tag::string;
+                in.vec( item.sval );
+                break;
+            case static_cast< std::uint8_t >( type_tag::unknown ):
+                break;
+            default:
+                throw corrupt_cache();
+        }
+
+        in.vec( item.runs );
+        if( !item.runs.empty() && item.runs.size() != item.ival.size() + item.dval.size() )
+            throw corrupt_cache();
+        item.run_size = std::accumulate( item.runs.begin(), item.runs.end(), std::size_t( 0 ) );
+
+        const auto def_size = in.pod< std::uint64_t >();
+        switch( in.pod< std::uint8_t >() ) {
+            case no_defaults:
+                item.defaulted.assign( def_size, false );
+                break;
+            case all_defaults:
+                item.defaulted.assign( def_size, true );
+                break;
+            case mixed_defaults:
+                item.defaulted.reserve( def_size );
+                for( std::uint64_t i = 0; i < def_size; ++i )
+                    item.defaulted.push_back( in.pod< std::uint8_t >() != 0 );
+                break;
+            default:
+                throw corrupt_cache();
+        }
+
+        const auto num_dims = in.pod< std::uint64_t >();
+        for( std::uint64_t i = 0; i < num_dims; ++i ) {
+            const auto name = in.str();
+            const auto factor = in.pod< double >();
+            const auto offset = in.pod< double >();
+            item.dimensions.push_back( Dimension::newComposite( name, factor, offset ) );
+        }
+
+        return item;
+    }
+
+    static void write( writer& out, const DeckKeyword& keyword ) {
+        out.str( keyword.m_keywordName.str() );
+        out.str( keyword.m_fileName.str() );
+        out.pod< std::int32_t >( keyword.m_lineNumber );
+        out.pod< std::uint8_t >( keyword.m_knownKeyword );
+        out.pod< std::uint8_t >( keyword.m_isDataKeyword );
+        out.pod< std::uint8_t >( keyword.m_slashTerminated );
+
+        out.pod< std::uint64_t >( keyword.size() );
+        for( const auto& record : keyword ) {
+            out.pod< std::uint64_t >( record.size() );
+            for( const auto& item : record )
+                write( out, item );
+        }
+    }
+
+    static DeckKeyword read_keyword( reader& in ) {
+        DeckKeyword keyword( in.str() );
+        keyword.m_fileName = Symbol( in.str() );
+        keyword.m_lineNumber = in.pod< std::int32_t >();
+        keyword.m_knownKeyword = in.pod< std::uint8_t >() != 0;
+        keyword.m_isDataKeyword = in.pod< std::uint8_t >() != 0;
+        keyword.m_slashTerminated = in.pod< std::uint8_t >() != 0;
+
+        const auto num_records = in.pod< std::uint64_t >();
+        for( std::uint64_t i = 0; i < num_records; ++i ) {
+            const auto num_items = in.pod< std::uint64_t >();
+            std::vector< DeckItem > items;
+            for( std::uint64_t j = 0; j < num_items; ++j )
+                items.push_back( read_item( in ) );
+
+            keyword.addRecord( DeckRecord( std::move( items ) ) );
+        }
+
+        return keyword;
+    }
+};
+
+std::string DeckCache::cacheFile( const std::string& dataFile ) {
+    boost::filesystem::path path( dataFile );
+    path.replace_extension( ".DECKCACHE" );
+    return path.string();
+}
+
+std::uint64_t DeckCache::hash( const char* data, std::size_t size, std::uint64_t seed ) {
+    const std::uint64_t prime = 1099511628211ULL;
+
+    std::uint64_t h = seed;
+    for( std::size_t i = 0; i < size; ++i ) {
+        h ^= static_cast< unsigned char >( data[ i ] );
+        h *= prime;
+    }
+
+    return h;
+}
+
+std::uint64_t DeckCache::hash( const std::string& data, std::uint64_t seed ) {
+    return hash( data.data(), data.size(), seed );
+}
+
+bool DeckCache::load( const std::string& cacheFile, std::uint64_t key, Deck& deck ) {
+    std::string content;
+    if( !read_file( cacheFile, content ) ) return false;
+
+    try {
+        reader in( content.data(), content.data() + content.size() );
+
+        char file_magic[ sizeof( magic ) ];
+        for( auto& c : file_magic ) c = in.pod< char >();
+        if( std::memcmp( file_magic, magic, sizeof( magic ) ) != 0 ) return false;
+        if( in.pod< std::uint32_t >() != version ) return false;
+        if( in.pod< std::uint64_t >() != key ) return false;
+
+        /*
+         * Compare all the sizes before hashing anything, so that the common
+         * case of an edited file is detected without reading the input.
+         */
+        struct input_file {
+            std::string path;
+            std::uint64_t size;
+            std::uint64_t digest;
+        };
+
+        std::vector< input_file > inputs;
+        const auto num_files = in.pod< std::uint64_t >();
+        for( std::uint64_t i = 0; i < num_files; ++i ) {
+            input_file f;
+            f.path = in.str();
+            f.size = in.pod< std::uint64_t >();
+            f.digest = in.pod< std::uint64_t >();
+
+            boost::system::error_code ec;
+            const auto size = boost::filesystem::file_size( f.path, ec );
+            if( ec || size != f.size ) return false;
+
+            inputs.push_back( std::move( f ) );
+        }
+
+        for( const auto& f : inputs ) {
+            std::uint64_t size, digest;
+            if( !hash_file( f.path, size, digest ) ) return false;
+            if( size != f.size || digest != f.digest ) return false;
+        }
+
+        const auto units = make_units(
+            static_cast< UnitSystem::UnitType >( in.pod< std::int32_t >() )
+        );
+
+        std::vector< DeckKeyword > keywords;
+        const auto num_keywords = in.pod< std::uint64_t >();
+        for( std::uint64_t i = 0; i < num_keywords; ++i )
+            keywords.push_back( DeckCacheIO::read_keyword( in ) );
+
+        if( !in.done() ) return false;
+
+        for( auto& keyword : keywords )
+            deck.addKeyword( std::move( keyword ) );
+
+        std::vector< std::string > input_files;
+        for( const auto& f : inputs )
+            input_files.push_back( f.path );
+
+        deck.setInputFiles( input_files );
+        deck.getActiveUnitSystem() = units;
+        return true;
+    } catch( const corrupt_cache& ) {
+        return false;
+    }
+}
+
+bool DeckCache::save( const std::string& cacheFile,
+                      std::uint64_t key,
+                      const std::vector< std::string >& inputFiles,
+                      const Deck& deck ) {
+    writer out;
+    for( char c : magic ) out.pod( c );
+    out.pod( version );
+    out.pod( key );
+
+    out.pod< std::uint64_t >( inputFiles.size() );
+    for( const auto& file : inputFiles ) {
+        std::uint64_t size, digest;
+        if( !hash_file( file, size, digest ) ) return false;
+
+        out.str( file );
+        out.pod( size );
+        out.pod( digest );
+    }
+
+    out.pod< std::int32_t >( static_cast< std::int32_t >( deck.getActiveUnitSystem().getType() ) );
+    out.pod< std::uint64_t >( deck.size() );
+    for( const auto& keyword : deck )
+        DeckCacheIO::write( out, keyword );
+
+    return write_file( cacheFile, out.buffer );
+}
+
+std::string DeckCache::includeCacheDir( const std::string& dataFile ) {
+    boost::filesystem::path path( dataFile );
+    path.replace_extension( ".INCLUDECACHE" );
+    return path.string();
+}
+
+std::string DeckCache::includeCacheFile( const std::string& cacheDir, const std::string& includeFile ) {
+    char name[ 17 ];
+    std::snprintf( name, sizeof( name ), "%016llx",
+                   static_cast< unsigned long long >( hash( includeFile ) ) );
+
+    return ( boost::filesystem::path( cacheDir ) / name ).string();
+}
+
+bool DeckCache::loadKeywords( const std::string& cacheFile,
+                              std::uint64_t key,
+                              const std::string& includeFile,
+                              std::vector< DeckKeyword >& keywords ) {
+    std::string content;
+    if( !read_file( cacheFile, content ) ) return false;
+
+    try {
+        reader in( content.data(), content.data() + content.size() );
+
+        char file_magic[ sizeof( include_magic ) ];
+        for( auto& c : file_magic ) c = in.pod< char >();
+        if( std::memcmp( file_magic, include_magic, sizeof( include_magic ) ) != 0 ) return false;
+        if( in.pod< std::uint32_t >() != version ) return false;
+        if( in.pod< std::uint64_t >() != key ) return false;
+        if( in.str() != includeFile ) return false;
+
+        const auto cached_size = in.pod< std::uint64_t >();
+        const auto cached_digest = in.pod< std::uint64_t >();
+
+        boost::system::error_code ec;
+        if( boost::filesystem::file_size( includeFile, ec ) != cached_size || ec ) return false;
+
+        std::uint64_t size, digest;
+        if( !hash_file( includeFile, size, digest ) ) return false;
+        if( size != cached_size || digest != cached_digest ) return false;
+
+        std::vector< DeckKeyword > cached;
+        const auto num_keywords = in.pod< std::uint64_t >();
+        for( std::uint64_t i = 0; i < num_keywords; ++i )
+            cached.push_back( DeckCacheIO::read_keyword( in ) );
+
+        if( !in.done() ) return false;
+
+        keywords = std::move( cached );
+        return true;
+    } catch( const corrupt_cache& ) {
+        return false;
+    }
+}
+
+bool DeckCache::saveKeywords( const std::string& cacheFile,
+                              std::uint64_t key,
+                              const std::string& includeFile,
+                              const Deck& deck,
+                              std::size_t first,
+                              std::size_t last ) {
+    writer out;
+    for( char c : include_magic ) out.pod( c );
+    out.pod( version );
+    out.pod( key );
+    out.str( includeFile );
+
+    std::uint64_t size, digest;
+    if( !hash_file( includeFile, size, digest ) ) return false;
+    out.pod( size );
+    out.pod( digest );
+
+    out.pod< std::uint64_t >( last - first );
+    for( std::size_t index = first; index < last; ++index )
+        DeckCacheIO::write( out, deck.getKeyword( index ) );
+
+    boost::system::error_code ec;
+    boost::filesystem::create_directories( boost::filesystem::path( cacheFile ).parent_path(), ec );
+    if( ec ) return false;
+
+    return write_file( cacheFile, out.buffer );
+}
+
+}
@@ -17,18 +17,67 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
 
 namespace Opm {
 
+namespace {
+
+/*
+ * An N*value token with at least min_run_length values switches the item to
+ * run storage, and the item goes back to storing value by value once the
+ * runs hold fewer than min_values_per_run values on average.
+ */
+const size_t min_run_length = 32;
+const size_t min_values_per_run = 4;
+const size_t min_runs = 16;
+
+template< typename T >
+bool same_value( const T& a, const T& b ) {
+    return a == b;
+}
+
+// Bitwise, so that e.g. -0.0 and 0.0 are not merged into one run.
+bool same_value( double a, double b ) {
+    return std::memcmp( &a, &b, sizeof( a ) ) == 0;
+}
+
+template< typename T >
+void add_runs( Fingerprint& fingerprint, const std::vector< T >& values, const std::vector< size_t >& runs ) {
+    const T* current = nullptr;
+    size_t length = 0;
+    for( size_t i = 0; i < values.size(); i++ ) {
+        const size_t n = runs.empty() ? 1 : runs[ i ];
+        if( current && same_value( *current, values[ i ] ) ) {
+            length += n;
+            continue;
+        }
+
+        if( current )
+            fingerprint.add( *current ).add( length );
+
+        current = &values[ i ];
+        length = n;
+    }
+
+    if( current )
+        fingerprint.add( *current ).add( length );
+}
+
+}
+
 template< typename T >
 std::vector< T >& DeckItem::value_ref() {
     return const_cast< std::vector< T >& >(
@@ -62,7 +111,21 @@ const std::vector< std::string >& DeckItem::value_ref< std::string >() const {
 
 DeckItem::DeckItem( const std::string& nm ) : item_name( nm ) {}
 
-DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
+DeckItem::DeckItem( const std::string& nm, int x, size_t hint ) :
+    DeckItem( Symbol( nm ), x, hint )
+{}
+
+DeckItem::DeckItem( const std::string& nm, double x, size_t hint ) :
+    DeckItem( Symbol( nm ), x, hint )
+{}
+
+DeckItem::DeckItem( const std::string& nm, std::string x, size_t hint ) :
+    DeckItem( Symbol( nm ), std::move( x ), hint )
+{}
+
+DeckItem::DeckItem( Symbol nm ) : item_name( nm ) {}
+
+DeckItem::DeckItem( Symbol nm, int, size_t hint ) :
     type( get_type< int >() ),
     item_name( nm )
 {
@@ -70,7 +133,7 @@ DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
     this->defaulted.reserve( hint );
 }
 
-DeckItem::DeckItem( const std::string& nm, double, size_t hint ) :
+DeckItem::DeckItem( Symbol nm, double, size_t hint ) :
     type( get_type< double >() ),
     item_name( nm )
 {
@@ -78,7 +141,7 @@ DeckItem::DeckItem( const std::string& nm, double, size_t hint ) :
     this->defaulted.reserve( hint );
 }
 
-DeckItem::DeckItem( const std::string& nm, std::string, size_t hint ) :
+DeckItem::DeckItem( Symbol nm, std::string, size_t hint ) :
     type( get_type< std::string >() ),
     item_name( nm )
 {
@@ -87,7 +150,7 @@ DeckItem::DeckItem( const std::string& nm, std::string, size_t hint ) :
 }
 
 const std::string& DeckItem::name() const {
-    return this->item_name;
+    return this->item_name.str();
 }
 
 bool DeckItem::defaultApplied( size_t index ) const {
@@ -95,15 +158,12 @@ bool DeckItem::defaultApplied( size_t index ) const {
 }
 
 bool DeckItem::hasValue( size_t index ) const {
-    switch( this->type ) {
-        case type_tag::integer: return this->ival.size() > index;
-        case type_tag::fdouble: return this->dval.size() > index;
-        case type_tag::string:  return this->sval.size() > index;
-        default: throw std::logic_error( "Type not set." );
-    }
+    return this->size() > index;
 }
 
 size_t DeckItem::size() const {
+    if( !this->runs.empty() ) return this->run_size;
+
     switch( this->type ) {
         case type_tag::integer: return this->ival.size();
         case type_tag::fdouble: return this->dval.size();
@@ -119,16 +179,109 @@ size_t DeckItem::out_size() const {
 
 template< typename T >
 const T& DeckItem::get( size_t index ) const {
-    return this->value_ref< T >().at( index );
+    return this->values< T >().at( index );
 }
 
 template< typename T >
 const std::vector< T >& DeckItem::getData() const {
+    return this->values< T >();
+}
+
+const std::vector< size_t >& DeckItem::getRunLengths() const {
+    return this->runs;
+}
+
+template< typename T >
+const std::vector< T >& DeckItem::getRunValues() const {
     return this->value_ref< T >();
 }
 
+/*
+ * The items stored as runs have a single dimension, see push_backDimension(),
+ * so converting the run values is the same as converting the values.
+ */
+std::vector< double > DeckItem::getSIRunValues() const {
+    if( this->dimensions.empty() )
+        throw std::invalid_argument("No dimension has been set for item'"
+                                    + this->name()
+                                    + "'; can not ask for SI data");
+
+    auto si = this->value_ref< double >();
+    this->convertToSI( si.data(), si.data(), si.size() );
+    return si;
+}
+
+/*
+ * The dense values of the item. For an item stored as runs they are expanded
+ * on the first call; like SIdata this does not change the observable state,
+ * and threads racing to expand the same item publish the same values.
+ */
+template< typename T >
+const std::vector< T >& DeckItem::values() const {
+    const auto& stored = this->value_ref< T >();
+    if( this->runs.empty() ) return stored;
+
+    auto expanded = std::atomic_load( &this->dense );
+    if( !expanded ) {
+        std::shared_ptr< const void > expected;
+        std::shared_ptr< const void > desired =
+            std::make_shared< std::vector< T > >( this->expandRuns( stored ) );
+        std::atomic_compare_exchange_strong( &this->dense, &expected, desired );
+        expanded = std::atomic_load( &this->dense );
+    }
+
+    return *static_cast< const std::vector< T >* >( expanded.get() );
+}
+
+template< typename T >
+std::vector< T > DeckItem::expandRuns( const std::vector< T >& run_values ) const {
+    std::vector< T > data( this->run_size );
+    auto out = data.begin();
+    for( size_t run = 0; run < this->runs.size(); ++run )
+        out = std::fill_n( out, this->runs[ run ], run_values[ run ] );
+
+    return data;
+}
+
+/* Go back to storing the values one by one. */
+template< typename T >
+void DeckItem::expand() {
+    if( this->runs.empty() ) return;
+
+    auto data = this->expandRuns( this->value_ref< T >() );
+    this->value_ref< T >().swap( data );
+    this->runs = std::vector< size_t >();
+    this->run_size = 0;
+    this->dense.reset();
+}
+
+template< typename T >
+void DeckItem::push_run( T x, size_t n, bool is_default ) {
+    auto& val = this->value_ref< T >();
+
+    if( !val.empty() && same_value( val.back(), x ) ) {
+        this->runs.back() += n;
+    } else {
+        val.push_back( std::move( x ) );
+        this->runs.push_back( n );
+    }
+
+    this->run_size += n;
+    this->defaulted.insert( this->defaulted.end(), n, is_default );
+    this->dense.reset();
+
+    if( this->runs.size() >= min_runs
+        && this->runs.size() * min_values_per_run > this->run_size )
+        this->expand< T >();
+}
+
 template< typename T >
 void DeckItem::push( T x ) {
+    if( !this->runs.empty() ) {
+        this->push_run( std::move( x ), 1, false );
+        return;
+    }
+
     auto& val = this->value_ref< T >();
 
     val.push_back( std::move( x ) );
@@ -151,8 +304,33 @@ template< typename T >
 void DeckItem::push( T x, size_t n ) {
     auto& val = this->value_ref< T >();
 
-    val.insert( val.end(), n, x );
-    this->defaulted.insert( this->defaulted.end(), n, false );
+    if( this->runs.empty() ) {
+        const bool start_runs = this->type != type_tag::string
+                             && n >= min_run_length
+                             && (val.size() + 1) * min_values_per_run <= val.size() + n;
+
+        if( !start_runs ) {
+            val.insert( val.end(), n, x );
+            this->defaulted.insert( this->defaulted.end(), n, false );
+            return;
+        }
+
+        /* The values before the first long run become runs as well. */
+        std::vector< T > run_values;
+        for( auto& value : val ) {
+            if( !run_values.empty() && same_value( run_values.back(), value ) ) {
+                this->runs.back()++;
+            } else {
+                run_values.push_back( std::move( value ) );
+                this->runs.push_back( 1 );
+            }
+        }
+
+        this->run_size = val.size();
+        val.swap( run_values );
+    }
+
+    this->push_run( std::move( x ), n, false );
 }
 
 void DeckItem::push_back( int x, size_t n ) {
@@ -170,10 +348,15 @@ void DeckItem::push_back( std::string x, size_t n ) {
 template< typename T >
 void DeckItem::push_default( T x ) {
     auto& val = this->value_ref< T >();
-    if( this->defaulted.size() != val.size() )
+    if( this->defaulted.size() != this->size() )
         throw std::logic_error("To add a value to an item, "
                 "no 'pseudo defaults' can be added before");
 
+    if( !this->runs.empty() ) {
+        this->push_run( std::move( x ), 1, true );
+        return;
+    }
+
     val.push_back( std::move( x ) );
     this->defaulted.push_back( true );
 }
@@ -200,7 +383,7 @@ void DeckItem::push_backDummyDefault() {
 
 std::string DeckItem::getTrimmedString( size_t index ) const {
     return boost::algorithm::trim_copy(
-               this->value_ref< std::string >().at( index )
+               this->values< std::string >().at( index )
            );
 }
 
@@ -209,39 +392,138 @@ double DeckItem::getSIDouble( size_t index ) const {
 }
 
 const std::vector< double >& DeckItem::getSIDoubleData() const {
-    const auto& raw = this->value_ref< double >();
     // we already converted this item to SI?
-    if( !this->SIdata.empty() ) return this->SIdata;
+    const auto converted = std::atomic_load( &this->SIdata );
+    if( converted ) return *converted;
 
     if( this->dimensions.empty() )
         throw std::invalid_argument("No dimension has been set for item'"
                                     + this->name()
                                     + "'; can not ask for SI data");
 
+    /*
+     * Dimensionless items, and e.g. lengths in metric decks, are already in
+     * SI units. Hand out the raw data rather than keeping a second full size
+     * copy of what is often the largest arrays in the deck.
+     */
+    const auto is_identity = []( const Dimension& dim ) {
+        return dim.isIdentity();
+    };
+
+    if( std::all_of( this->dimensions.begin(), this->dimensions.end(), is_identity ) )
+        return this->values< double >();
+
     /*
      * This is an unobservable state change - SIData is lazily converted to
-     * SI units, so externally the object still behaves as const
+     * SI units, so externally the object still behaves as const. Threads
+     * racing to convert the same item all publish the same values, and
+     * the first one to finish wins. Items stored as runs are converted run
+     * by run, without expanding the raw values.
      */
-    const auto dim_size = dimensions.size();
-    const auto sz = raw.size();
-    this->SIdata.resize( sz );
-
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        this->SIdata[ index ] = this->dimensions[ dimIndex ]
-                                .convertRawToSi( raw[ index ] );
+    std::shared_ptr< std::vector< double > > si;
+    if( !this->runs.empty() ) {
+        si = std::make_shared< std::vector< double > >( this->expandRuns( this->getSIRunValues() ) );
+    } else {
+        const auto& raw = this->value_ref< double >();
+        si = std::make_shared< std::vector< double > >( raw.size() );
+        this->convertToSI( raw.data(), si->data(), raw.size() );
     }
 
-    return this->SIdata;
+    std::shared_ptr< const std::vector< double > > expected;
+    std::shared_ptr< const std::vector< double > > desired = std::move( si );
+    std::atomic_compare_exchange_strong( &this->SIdata, &expected, desired );
+    return *std::atomic_load( &this->SIdata );
+}
+
+void DeckItem::convertToSI() const {
+    if( this->type != type_tag::fdouble || this->dimensions.empty() )
+        return;
+
+    const auto is_convertible = []( const Dimension& dim ) {
+        return dim.isConvertible();
+    };
+
+    if( std::all_of( this->dimensions.begin(), this->dimensions.end(), is_convertible ) )
+        this->getSIDoubleData();
+}
+
+/*
+ * The raw and the SI arrays may be the same array.
+ */
+void DeckItem::convertToSI( const double* raw, double* si, size_t sz ) const {
+    /*
+     * Items where all values share one dimension, which is the common case
+     * for the large arrays, are converted in one pass over the data.
+     */
+    const auto same_dimension = [this]( const Dimension& dim ) {
+        return dim == this->dimensions.front();
+    };
+
+    if( std::all_of( this->dimensions.begin(), this->dimensions.end(), same_dimension ) ) {
+        this->dimensions.front().convertRawToSi( raw, si, sz );
+    } else {
+        const auto dim_size = this->dimensions.size();
+        for( size_t index = 0; index < sz; index++ ) {
+            const auto dimIndex = index % dim_size;
+            si[ index ] = this->dimensions[ dimIndex ].convertRawToSi( raw[ index ] );
+        }
+    }
+}
+
+template< typename T >
+std::vector< T > DeckItem::releaseData() {
+    std::vector< T > values;
+    if( this->runs.empty() )
+        values.swap( this->value_ref< T >() );
+    else
+        values = this->expandRuns( this->value_ref< T >() );
+
+    this->value_ref< T >() = std::vector< T >();
+    this->runs = std::vector< size_t >();
+    this->run_size = 0;
+    this->dense.reset();
+    this->defaulted = std::vector< bool >();
+    this->SIdata.reset();
+    return values;
+}
+
+std::vector< double > DeckItem::releaseSIDoubleData() {
+    if( this->dimensions.empty() )
+        throw std::invalid_argument("No dimension has been set for item'"
+                                    + this->name()
+                                    + "'; can not ask for SI data");
+
+    const auto converted = std::move( this->SIdata );
+    auto values = this->releaseData< double >();
+    const auto is_identity = []( const Dimension& dim ) {
+        return dim.isIdentity();
+    };
+
+    if( converted )
+        values.assign( converted->begin(), converted->end() );
+    else if( !std::all_of( this->dimensions.begin(), this->dimensions.end(), is_identity ) )
+        this->convertToSI( values.data(), values.data(), values.size() );
+
+    return values;
 }
 
 void DeckItem::push_backDimension( const Dimension& active,
                                     const Dimension& def ) {
-    const auto& ds = this->value_ref< double >();
-    const bool dim_inactive = ds.empty()
-                            || this->defaultApplied( ds.size() - 1 );
+    if( this->type != type_tag::fdouble )
+        throw std::invalid_argument( "Item of wrong type." );
+
+    const auto size = this->size();
+    const bool dim_inactive = size == 0
+                            || this->defaultApplied( size - 1 );
 
     this->dimensions.push_back( dim_inactive ? def : active );
+
+    /*
+     * The dimensions cycle over the values, which do not line up with the
+     * runs; such items are stored value by value.
+     */
+    if( !this->runs.empty() && !( this->dimensions.back() == this->dimensions.front() ) )
+        this->expand< double >();
 }
 
 type_tag DeckItem::getType() const {
@@ -252,11 +534,44 @@ type_tag DeckItem::getType() const {
 
 template< typename T >
 void DeckItem::write_vector(DeckOutput& stream, const std::vector<T>& data) const {
-    for (size_t index = 0; index < this->out_size(); index++) {
-        if (this->defaultApplied(index))
+    const size_t size = this->out_size();
+    size_t index = 0;
+    while (index < size) {
+        if (this->defaultApplied(index)) {
             stream.stash_default( );
-        else
-            stream.write( data[index] );
+            index++;
+            continue;
+        }
+
+        size_t end = index + 1;
+        while (end < size && !this->defaultApplied(end) && data[end] == data[index])
+            end++;
+
+        stream.write( data[index], end - index );
+        index = end;
+    }
+}
+
+template< typename T >
+void DeckItem::write_runs(DeckOutput& stream) const {
+    const auto& run_values = this->value_ref< T >();
+    size_t index = 0;
+    for (size_t run = 0; run < this->runs.size(); run++) {
+        const size_t run_end = index + this->runs[run];
+        while (index < run_end) {
+            if (this->defaultApplied(index)) {
+                stream.stash_default( );
+                index++;
+                continue;
+            }
+
+            size_t end = index + 1;
+            while (end < run_end && !this->defaultApplied(end))
+                end++;
+
+            stream.write( run_values[run], end - index );
+            index = end;
+        }
     }
 }
 
@@ -264,10 +579,16 @@ void DeckItem::write_vector(DeckOutput& stream, const std::vector<T>& data) cons
 void DeckItem::write(DeckOutput& stream) const {
     switch( this->type ) {
     case type_tag::integer:
-        this->write_vector( stream, this->ival );
+        if (this->runs.empty())
+            this->write_vector( stream, this->ival );
+        else
+            this->write_runs< int >( stream );
         break;
     case type_tag::fdouble:
-        this->write_vector( stream,  this->dval );
+        if (this->runs.empty())
+            this->write_vector( stream,  this->dval );
+        else
+            this->write_runs< double >( stream );
         break;
     case type_tag::string:
         this->write_vector( stream,  this->sval );
@@ -275,6 +596,7 @@ void DeckItem::write(DeckOutput& stream) const {
     default:
         throw std::logic_error( "Type not set." );
     }
+    stream.flush( );
 }
 
 std::ostream& operator<<(std::ostream& os, const DeckItem& item) {
@@ -319,7 +641,7 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
 
     switch( this->type ) {
     case type_tag::integer:
-        if (this->ival != other.ival)
+        if (this->values< int >() != other.values< int >())
             return false;
         break;
     case type_tag::string:
@@ -328,14 +650,14 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
         break;
     case type_tag::fdouble:
         if (cmp_numeric) {
-            const std::vector<double>& this_data = this->dval;
-            const std::vector<double>& other_data = other.dval;
+            const std::vector<double>& this_data = this->values< double >();
+            const std::vector<double>& other_data = other.values< double >();
             for (size_t i=0; i < this_data.size(); i++) {
                 if (!double_equal( this_data[i] , other_data[i], rel_eps, abs_eps))
                     return false;
             }
         } else {
-            if (this->dval != other.dval)
+            if (this->values< double >() != other.values< double >())
                 return false;
         }
         break;
@@ -356,6 +678,29 @@ bool DeckItem::operator!=(const DeckItem& other) const {
     return !(*this == other);
 }
 
+std::size_t DeckItem::memory_usage() const {
+    std::size_t bytes = MemoryUsage::heap( this->dval )
+                      + MemoryUsage::heap( this->ival )
+                      + MemoryUsage::heap( this->sval )
+                      + MemoryUsage::heap( this->defaulted )
+                      + MemoryUsage::heap( this->dimensions )
+                      + MemoryUsage::heap( this->runs );
+
+    if( const auto si = std::atomic_load( &this->SIdata ) )
+        bytes += sizeof( *si ) + MemoryUsage::heap( *si );
+
+    if( const auto expanded = std::atomic_load( &this->dense ) ) {
+        if( this->type == type_tag::integer )
+            bytes += sizeof( std::vector< int > )
+                   + MemoryUsage::heap( *static_cast< const std::vector< int >* >( expanded.get() ) );
+        else
+            bytes += sizeof( std::vector< double > )
+                   + MemoryUsage::heap( *static_cast< const std::vector< double >* >( expanded.get() ) );
+    }
+
+    return bytes;
+}
+
 
 
 /*
@@ -370,4 +715,46 @@ template const std::string& DeckItem::get< std::string >( size_t ) const;
 template const std::vector< int >& DeckItem::getData< int >() const;
 template const std::vector< double >& DeckItem::getData< double >() const;
 template const std::vector< std::string >& DeckItem::getData< std::string >() const;
+
+Fingerprint DeckItem::fingerprint() const {
+    Fingerprint fingerprint;
+    fingerprint.add( this->name() ).add( this->type );
+
+    switch( this->type ) {
+        case type_tag::integer:
+            fingerprint.add( this->size() );
+            add_runs( fingerprint, this->ival, this->runs );
+            break;
+        case type_tag::fdouble:
+            fingerprint.add( this->size() );
+            add_runs( fingerprint, this->dval, this->runs );
+            break;
+        case type_tag::string:
+            fingerprint.add( this->size() );
+            add_runs( fingerprint, this->sval, this->runs );
+            break;
+        default:
+            break;
+    }
+
+    fingerprint.add( this->defaulted.size() );
+    for( size_t first = 0; first < this->defaulted.size(); ) {
+        const bool value = this->defaulted[ first ];
+        size_t last = first + 1;
+        while( last < this->defaulted.size() && this->defaulted[ last ] == value )
+            last++;
+
+        fingerprint.add( value ).add( last - first );
+        first = last;
+    }
+
+    return fingerprint;
+}
+
+template const std::vector< int >& DeckItem::getRunValues< int >() const;
+template const std::vector< double >& DeckItem::getRunValues< double >() const;
+
+template std::vector< int > DeckItem::releaseData< int >();
+template std::vector< double > DeckItem::releaseData< double >();
+template std::vector< std::string > DeckItem::releaseData< std::string >();
 }
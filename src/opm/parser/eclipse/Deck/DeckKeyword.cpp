@@ -31,6 +31,7 @@ namespace Opm {
         m_isDataKeyword(false),
         m_slashTerminated(true)
     {
+        this->m_fingerprint.add( this->name() );
     }
 
     DeckKeyword::DeckKeyword(const std::string& keywordName, bool knownKeyword) :
@@ -40,6 +41,7 @@ namespace Opm {
         m_isDataKeyword(false),
         m_slashTerminated(true)
     {
+        this->m_fingerprint.add( this->name() );
     }
 
 
@@ -48,12 +50,12 @@ namespace Opm {
     }
 
     void DeckKeyword::setLocation(const std::string& fileName, int lineNumber) {
-        m_fileName = fileName;
+        m_fileName = Symbol(fileName);
         m_lineNumber = lineNumber;
     }
 
     const std::string& DeckKeyword::getFileName() const {
-        return m_fileName;
+        return m_fileName.str();
     }
 
     int DeckKeyword::getLineNumber() const {
@@ -70,7 +72,7 @@ namespace Opm {
 
 
     const std::string& DeckKeyword::name() const {
-        return m_keywordName;
+        return m_keywordName.str();
     }
 
     size_t DeckKeyword::size() const {
@@ -82,9 +84,14 @@ namespace Opm {
     }
 
     void DeckKeyword::addRecord(DeckRecord&& record) {
+        this->m_fingerprint.add( record.fingerprint() );
         this->m_recordList.push_back( std::move( record ) );
     }
 
+    const Fingerprint& DeckKeyword::fingerprint() const {
+        return this->m_fingerprint;
+    }
+
     DeckKeyword::const_iterator DeckKeyword::begin() const {
         return m_recordList.begin();
     }
@@ -192,5 +199,13 @@ namespace Opm {
         return !(*this == other);
     }
 
+    MemoryUsage DeckKeyword::memory_usage() const {
+        std::size_t bytes = sizeof( *this ) + MemoryUsage::heap( this->m_recordList );
+        for (const auto& record : this->m_recordList)
+            bytes += record.memory_usage();
+
+        return MemoryUsage( this->name(), bytes );
+    }
+
 }
 
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdio>
 #include <ostream>
 
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
@@ -24,31 +25,64 @@
 
 namespace Opm {
 
-    DeckOutput::DeckOutput( std::ostream& s, int precision) :
+namespace {
+
+    const size_t buffer_size = 1 << 16;
+
+    void append_unsigned(std::string& buffer, unsigned long long value) {
+        char digits[24];
+        size_t length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+
+        while (length > 0)
+            buffer.push_back(digits[--length]);
+    }
+
+}
+
+
+    DeckOutput::DeckOutput( std::ostream& s, int precision_arg) :
         os( s ),
         default_count( 0 ),
         row_count( 0 ),
         record_on( false ),
-        org_precision( os.precision(precision) )
-    {}
+        precision( precision_arg )
+    {
+        this->buffer.reserve( buffer_size + 256 );
+    }
 
 
     DeckOutput::~DeckOutput() {
-        this->set_precision(this->org_precision);
+        this->flush();
     }
 
 
-    void DeckOutput::set_precision(int precision) {
-        this->os.precision(precision);
+    void DeckOutput::flush() {
+        if (this->buffer.empty())
+            return;
+
+        this->os.write( this->buffer.data(), this->buffer.size() );
+        this->buffer.clear();
+    }
+
+
+    void DeckOutput::flush_full() {
+        if (this->buffer.size() >= buffer_size)
+            this->flush();
     }
 
 
     void DeckOutput::endl() {
-        this->os << std::endl;
+        this->buffer.push_back('\n');
+        this->flush();
     }
 
     void DeckOutput::write_string(const std::string& s) {
-        this->os << s;
+        this->buffer += s;
+        this->flush();
     }
 
 
@@ -57,7 +91,7 @@ namespace Opm {
         if (default_count > 0) {
             write_sep( );
 
-            os << default_count << "*";
+            write_count( default_count );
             default_count = 0;
             row_count++;
         }
@@ -65,21 +99,70 @@ namespace Opm {
         write_sep( );
         write_value( value );
         row_count++;
+        flush_full( );
     }
 
+
+    template <typename T>
+    void DeckOutput::write( const T& value, size_t count ) {
+        if (count == 0)
+            return;
+
+        if (!this->compress_repeats || count == 1) {
+            for (size_t index = 0; index < count; index++)
+                this->write( value );
+            return;
+        }
+
+        if (default_count > 0) {
+            write_sep( );
+
+            write_count( default_count );
+            default_count = 0;
+            row_count++;
+        }
+
+        write_sep( );
+        append_unsigned( this->buffer, count );
+        this->buffer.push_back('*');
+        write_value( value );
+        row_count++;
+        flush_full( );
+    }
+
+
+    void DeckOutput::write_count( size_t count ) {
+        append_unsigned( this->buffer, count );
+        this->buffer.push_back('*');
+    }
+
+
     template <>
     void DeckOutput::write_value( const std::string& value ) {
-        this->os << "'" << value << "'";
+        this->buffer.push_back('\'');
+        this->buffer += value;
+        this->buffer.push_back('\'');
     }
 
     template <>
     void DeckOutput::write_value( const int& value ) {
-        this->os << value;
+        if (value < 0) {
+            this->buffer.push_back('-');
+            append_unsigned( this->buffer, 0ULL - static_cast<unsigned long long>(static_cast<long long>(value)) );
+        } else
+            append_unsigned( this->buffer, value );
     }
 
+    /*
+      The %g conversion is the default floating point format of an
+      ostream, so the output is the same as os << value with the
+      precision set.
+    */
     template <>
     void DeckOutput::write_value( const double& value ) {
-        this->os << value;
+        char digits[64];
+        const int length = std::snprintf( digits, sizeof digits, "%.*g", this->precision, value );
+        this->buffer.append( digits, length );
     }
 
     void DeckOutput::stash_default( ) {
@@ -88,13 +171,15 @@ namespace Opm {
 
 
     void DeckOutput::start_keyword(const std::string& kw) {
-        this->os << kw << std::endl;
+        this->buffer += kw;
+        this->buffer.push_back('\n');
     }
 
 
     void DeckOutput::end_keyword(bool add_slash) {
         if (add_slash)
-            this->os << "/" << std::endl;
+            this->buffer += "/\n";
+        this->flush();
     }
 
 
@@ -105,9 +190,9 @@ namespace Opm {
         }
 
         if (row_count > 0)
-            os << item_sep;
+            this->buffer += item_sep;
         else if (record_on)
-            os << record_indent;
+            this->buffer += record_indent;
     }
 
     void DeckOutput::start_record( ) {
@@ -118,18 +203,22 @@ namespace Opm {
 
 
     void DeckOutput::split_record() {
-        this->os << std::endl;
+        this->buffer.push_back('\n');
         this->row_count = 0;
     }
 
 
     void DeckOutput::end_record( ) {
-        this->os << " /" << std::endl;
+        this->buffer += " /\n";
         this->record_on = false;
+        this->flush();
     }
 
 
     template void DeckOutput::write( const int& value);
     template void DeckOutput::write( const double& value);
     template void DeckOutput::write( const std::string& value);
+    template void DeckOutput::write( const int& value, size_t count);
+    template void DeckOutput::write( const double& value, size_t count);
+    template void DeckOutput::write( const std::string& value, size_t count);
 }
@@ -23,6 +23,7 @@
 #include <string>
 #include <algorithm>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
@@ -173,4 +174,21 @@ namespace Opm {
         return !(*this == other);
     }
 
+    std::size_t DeckRecord::memory_usage() const {
+        std::size_t bytes = MemoryUsage::heap( this->m_items );
+        for (const auto& item : this->m_items)
+            bytes += item.memory_usage();
+
+        return bytes;
+    }
+
+    Fingerprint DeckRecord::fingerprint() const {
+        Fingerprint fingerprint;
+        fingerprint.add( this->m_items.size() );
+        for (const auto& item : this->m_items)
+            fingerprint.add( item.fingerprint() );
+
+        return fingerprint;
+    }
+
 }
@@ -0,0 +1,62 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_KEYWORD_RANGES_HPP
+#define OPM_KEYWORD_RANGES_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opm/common/utility/ParallelChunks.hpp>
+
+namespace Opm {
+
+    /*
+      Messages about keywords, as (position in the deck, message) pairs.
+    */
+    using KeywordMessages = std::vector< std::pair< std::size_t, std::string > >;
+
+    /*
+      Calls check( first, last, messages ) for contiguous ranges [first,
+      last) of the keyword positions [0, size) in parallel, see
+      forEachChunk(), and returns the messages of all the ranges in the
+      order of the ranges. The check must only read the deck.
+    */
+    template< class Check >
+    KeywordMessages checkKeywordRanges( std::size_t size, Check&& check ) {
+        const auto ranges = chunkRanges( size, 4096 );
+        std::vector< KeywordMessages > chunk_messages( ranges.size() );
+
+        forEachChunk( ranges, [&check, &chunk_messages]( std::size_t chunk, std::size_t first, std::size_t last ) {
+            check( first, last, chunk_messages[ chunk ] );
+        } );
+
+        KeywordMessages messages = std::move( chunk_messages.front() );
+        for( std::size_t chunk = 1; chunk < chunk_messages.size(); ++chunk )
+            std::move( chunk_messages[ chunk ].begin(), chunk_messages[ chunk ].end(), std::back_inserter( messages ) );
+
+        return messages;
+    }
+
+}
+
+#endif
@@ -30,37 +30,66 @@
 
 namespace Opm {
 
-    static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
+    namespace {
+
+        const char* const section_names[] = { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                                              "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" };
+
+    }
+
+    bool Section::isSectionName( const std::string& name ) {
+        for( const auto* x : section_names )
             if( name == x ) return true;
 
         return false;
     }
 
-    static std::pair< DeckView::const_iterator, DeckView::const_iterator >
-    find_section( const Deck& deck, const std::string& keyword ) {
+    std::vector< size_t > Section::sectionOffsets( const Deck& deck ) {
+        std::vector< size_t > offsets;
+        if( deck.size() == 0 )
+            return offsets;
 
-        const auto fn = [&keyword]( const DeckKeyword& kw ) {
-            return kw.name() == keyword;
-        };
+        const DeckKeyword* front = &deck.getKeyword( 0 );
+        for( const auto* name : section_names ) {
+            for( const auto& keyword : deck.getKeywordRange( name ) )
+                offsets.push_back( &keyword - front );
+        }
 
-        auto first = std::find_if( deck.begin(), deck.end(), fn );
+        std::sort( offsets.begin(), offsets.end() );
+        return offsets;
+    }
 
-        if( first == deck.end() )
-            return { first, first };
+    /*
+      The section as a range of keyword positions in the deck; both ends
+      are the end of the deck if the deck does not have the section.
+    */
+    static std::pair< size_t, size_t >
+    find_section( const Deck& deck, const std::string& keyword ) {
+        const auto offsets = Section::sectionOffsets( deck );
+
+        auto first = std::find_if( offsets.begin(), offsets.end(), [&deck, &keyword]( size_t offset ) {
+            return deck.getKeyword( offset ).name() == keyword;
+        });
+
+        if( first == offsets.end() )
+            return { deck.size(), deck.size() };
 
-        auto last = std::find_if( first + 1, deck.end(), isSectionDelimiter );
+        const auto next = first + 1;
+        if( next == offsets.end() )
+            return { *first, deck.size() };
 
-        if( last != deck.end() && last->name() == keyword )
+        if( deck.getKeyword( *next ).name() == keyword )
             throw std::invalid_argument( std::string( "Deck contains the '" ) + keyword + "' section multiple times" );
 
-        return { first, last };
+        return { *first, *next };
     }
 
     Section::Section( const Deck& deck, const std::string& section )
-        : DeckView( find_section( deck, section ) ),
+        : Section( deck, section, find_section( deck, section ) )
+    {}
+
+    Section::Section( const Deck& deck, const std::string& section, std::pair< size_t, size_t > range )
+        : DeckView( deck, range.first, range.second ),
           section_name( section ),
           units( deck.getActiveUnitSystem() )
     {}
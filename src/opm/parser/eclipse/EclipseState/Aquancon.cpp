@@ -21,7 +21,7 @@
 #include <utility>
 #include <algorithm>
 #include <iterator>
-#include <iostream>
+#include <memory>
 
 namespace Opm {
     namespace{
@@ -29,243 +29,148 @@ namespace Opm {
             // Grid cell box definition to connect aquifer
             int i1, i2, j1, j2, k1, k2;
 
-            std::vector<size_t> global_index_per_record;
+            // Aquifer influx coefficient, if given, and multiplier
+            bool has_influx_coeff;
+            double influx_coeff;
+            double influx_mult;
 
-            // Variables constants
-            std::vector<std::shared_ptr<double>>  influx_coeff_per_record;  //Aquifer influx coefficient
-            std::vector<double>  influx_mult_per_record;   //Aquifer influx coefficient Multiplier       
-            // Cell face to connect aquifer to        
-            std::vector<int> face_per_record;
-            std::vector<int> record_index_per_record;         
+            // Cell face to connect aquifer to
+            int face;
         };
-    }
 
-    Aquancon::Aquancon(const EclipseGrid& grid, const Deck& deck)
-    { 
-        if (!deck.hasKeyword("AQUANCON"))
-            return;  
+        // One cell of a record, with its position in the output vectors
+        // before the cells defined more than once are merged.
+        struct CellEntry{
+            size_t global_index;
+            int record_index;
+        };
 
-        std::vector<Opm::AquanconRecord> m_aqurecord;
-        // Aquifer ID per record
-        std::vector<int> m_aquiferID_per_record;
-        int m_maxAquID = 0;
 
-        const auto& aquanconKeyword = deck.getKeyword("AQUANCON");
-        // Resize the parameter vector container based on row entries in aquancon
-        m_aqurecord.resize(aquanconKeyword.size());
-        m_aquiferID_per_record.resize(aquanconKeyword.size());
-
-        // We now do a loop over each record entry in aquancon
-        for (size_t aquanconRecordIdx = 0; aquanconRecordIdx < aquanconKeyword.size(); ++aquanconRecordIdx) 
+        /*
+          The connections of one aquifer: the boxes of its records are
+          expanded one row of consecutive global indices at a time, and the
+          cells are sorted on global index and then record index. If a
+          reservoir cell is defined more than once, its previous value for
+          the aquifer influx coefficient is added to the present value
+          (Eclipse 2014.1 Reference Manual p.345); the other values are
+          those of the first record.
+        */
+        Aquancon::AquanconOutput connect_aquifer(int aquiferID,
+                                                 const std::vector<int>& record_indices,
+                                                 const std::vector<AquanconRecord>& records,
+                                                 const EclipseGrid& grid)
         {
-            const auto& aquanconRecord = aquanconKeyword.getRecord(aquanconRecordIdx);
-            m_aquiferID_per_record.at(aquanconRecordIdx) = aquanconRecord.getItem("AQUIFER_ID").template get<int>(0);
-
-            m_aqurecord.at(aquanconRecordIdx).i1 = aquanconRecord.getItem("I1").template get<int>(0);
-            m_aqurecord.at(aquanconRecordIdx).i2 = aquanconRecord.getItem("I2").template get<int>(0);
-            m_aqurecord.at(aquanconRecordIdx).j1 = aquanconRecord.getItem("J1").template get<int>(0);
-            m_aqurecord.at(aquanconRecordIdx).j2 = aquanconRecord.getItem("J2").template get<int>(0);
-            m_aqurecord.at(aquanconRecordIdx).k1 = aquanconRecord.getItem("K1").template get<int>(0);
-            m_aqurecord.at(aquanconRecordIdx).k2 = aquanconRecord.getItem("K2").template get<int>(0);
-
-            m_aquiferID_per_record.at(aquanconRecordIdx) = aquanconRecord.getItem("AQUIFER_ID").template get<int>(0);
-            m_maxAquID = (m_maxAquID < m_aquiferID_per_record.at(aquanconRecordIdx) )?
-                            m_aquiferID_per_record.at(aquanconRecordIdx) : m_maxAquID;
-
-            double influx_mult = aquanconRecord.getItem("INFLUX_MULT").getSIDouble(0);
-
-            FaceDir::DirEnum faceDir = FaceDir::FromString(aquanconRecord.getItem("FACE").getTrimmedString(0));
-              
-            // Loop over the cartesian indices to convert to the global grid index
-            for (int k=m_aqurecord.at(aquanconRecordIdx).k1; k <= m_aqurecord.at(aquanconRecordIdx).k2; k++) {
-                for (int j=m_aqurecord.at(aquanconRecordIdx).j1; j <= m_aqurecord.at(aquanconRecordIdx).j2; j++)
-                    for (int i=m_aqurecord.at(aquanconRecordIdx).i1; i <= m_aqurecord.at(aquanconRecordIdx).i2; i++)
-                        m_aqurecord.at(aquanconRecordIdx).global_index_per_record.push_back
-                                                            (
-                                                                grid.getGlobalIndex(i-1, j-1, k-1)
-                                                            );
-            }
-            size_t global_index_per_record_size = m_aqurecord.at(aquanconRecordIdx).global_index_per_record.size();
-
-            m_aqurecord.at(aquanconRecordIdx).influx_coeff_per_record.resize(global_index_per_record_size, nullptr);
+            const size_t nx = grid.getNX();
+            const size_t ny = grid.getNY();
 
-            if (aquanconRecord.getItem("INFLUX_COEFF").hasValue(0))
-            {
-                const double influx_coeff = aquanconRecord.getItem("INFLUX_COEFF").getSIDouble(0);
+            size_t num_cells = 0;
+            for (int record_index : record_indices) {
+                const auto& record = records[record_index];
+                num_cells += size_t(record.i2 - record.i1 + 1) * (record.j2 - record.j1 + 1) * (record.k2 - record.k1 + 1);
+            }
 
-                for (auto& influx: m_aqurecord.at(aquanconRecordIdx).influx_coeff_per_record)
-                {
-                    influx.reset(new double(influx_coeff));
+            std::vector<CellEntry> cells;
+            cells.reserve(num_cells);
+            for (int record_index : record_indices) {
+                const auto& record = records[record_index];
+                for (int k = record.k1 - 1; k < record.k2; k++) {
+                    for (int j = record.j1 - 1; j < record.j2; j++) {
+                        const size_t row_start = nx * (j + ny * k);
+                        for (int i = record.i1 - 1; i < record.i2; i++)
+                            cells.push_back({ row_start + i, record_index });
+                    }
                 }
             }
 
+            // The records are added in increasing order, so a stable sort on
+            // the global index keeps the record order of the duplicates.
+            std::stable_sort(cells.begin(), cells.end(),
+                             [](const CellEntry& cell1, const CellEntry& cell2) {
+                                 return cell1.global_index < cell2.global_index;
+                             });
+
+            Aquancon::AquanconOutput output;
+            output.aquiferID = aquiferID;
+            output.global_index.reserve(cells.size());
+            output.influx_coeff.reserve(cells.size());
+            output.influx_multiplier.reserve(cells.size());
+            output.reservoir_face_dir.reserve(cells.size());
+            output.record_index.reserve(cells.size());
+
+            for (size_t first = 0; first < cells.size();) {
+                const auto& record = records[cells[first].record_index];
+                bool has_influx_coeff = record.has_influx_coeff;
+                double influx_coeff = record.influx_coeff;
+
+                size_t last = first + 1;
+                for (; last < cells.size() && cells[last].global_index == cells[first].global_index; last++) {
+                    const auto& duplicate = records[cells[last].record_index];
+                    if (duplicate.has_influx_coeff) {
+                        influx_coeff = has_influx_coeff ? influx_coeff + duplicate.influx_coeff : duplicate.influx_coeff;
+                        has_influx_coeff = true;
+                    }
+                }
 
-            m_aqurecord.at(aquanconRecordIdx).influx_mult_per_record.resize(global_index_per_record_size,influx_mult);
-            m_aqurecord.at(aquanconRecordIdx).face_per_record.resize(global_index_per_record_size,faceDir);
-            m_aqurecord.at(aquanconRecordIdx).record_index_per_record.resize(global_index_per_record_size,aquanconRecordIdx);
-        }
-
-        // Collate_function
-        collate_function(m_aquoutput, m_aqurecord, m_aquiferID_per_record, m_maxAquID);
-
-        // Logic for grid connection applied here
-        m_aquoutput = logic_application(m_aquoutput);
-    }
-                                         
-    
-    // This function is used to convert from a per record vector to a per aquifer ID vector.
-    void Aquancon::collate_function(std::vector<Aquancon::AquanconOutput>& output_vector, 
-                                    std::vector<Opm::AquanconRecord>& m_aqurecord, 
-                                    std::vector<int> m_aquiferID_per_record, int m_maxAquID)
-    {
-        output_vector.resize(m_maxAquID);
-        // Find record indices at which the aquifer ids are located in
-        for (int i = 1; i <= m_maxAquID; ++i)
-        {
-            std::vector<int> result_id;
-
-            convert_record_id_to_aquifer_id(result_id, i, m_aquiferID_per_record);
-
-            // We add the aquifer id into each element of output_vector
-            output_vector.at(i - 1).aquiferID = i;
-            for ( auto record_index_matching_id : result_id)
-            {
-                // This is for the global indices
-                output_vector.at(i - 1).global_index.insert(
-                                                             output_vector.at(i - 1).global_index.end(),
-                                                             m_aqurecord.at(record_index_matching_id).global_index_per_record.begin(),
-                                                             m_aqurecord.at(record_index_matching_id).global_index_per_record.end()
-                                                           );
-                // This is for the influx_coeff
-                output_vector.at(i - 1).influx_coeff.insert(
-                                                             output_vector.at(i - 1).influx_coeff.end(),
-                                                             m_aqurecord.at(record_index_matching_id).influx_coeff_per_record.begin(),
-                                                             m_aqurecord.at(record_index_matching_id).influx_coeff_per_record.end()
-                                                           );
-                // This is for the influx_multiplier
-                output_vector.at(i - 1).influx_multiplier.insert(
-                                                                  output_vector.at(i - 1).influx_multiplier.end(),
-                                                                  m_aqurecord.at(record_index_matching_id).influx_mult_per_record.begin(),
-                                                                  m_aqurecord.at(record_index_matching_id).influx_mult_per_record.end()
-                                                                );
-                // This is for the reservoir_face_dir
-                output_vector.at(i - 1).reservoir_face_dir.insert(
-                                                                   output_vector.at(i - 1).reservoir_face_dir.end(),
-                                                                   m_aqurecord.at(record_index_matching_id).face_per_record.begin(),
-                                                                   m_aqurecord.at(record_index_matching_id).face_per_record.end()
-                                                                 );
-                // This is for the record index in order for us to know which one is updated
-                output_vector.at(i - 1).record_index.insert(
-                                                             output_vector.at(i - 1).record_index.end(),
-                                                             m_aqurecord.at(record_index_matching_id).record_index_per_record.begin(),
-                                                             m_aqurecord.at(record_index_matching_id).record_index_per_record.end()
-                                                           );  
+                output.global_index.push_back(cells[first].global_index);
+                output.influx_coeff.push_back(has_influx_coeff ? std::make_shared<double>(influx_coeff) : nullptr);
+                output.influx_multiplier.push_back(record.influx_mult);
+                output.reservoir_face_dir.push_back(record.face);
+                output.record_index.push_back(cells[first].record_index);
+                first = last;
             }
+
+            return output;
         }
     }
 
-    std::vector<Aquancon::AquanconOutput> Aquancon::logic_application(const std::vector<Aquancon::AquanconOutput> original_vector)
+
+    Aquancon::Aquancon(const EclipseGrid& grid, const Deck& deck)
     {
-        std::vector<Aquancon::AquanconOutput> output_vector = original_vector;
-        
-        // Create a local struct to couple each element for easy sorting
-        struct pair_elements
-        {
-          size_t global_index;
-          std::shared_ptr<double> influx_coeff;
-          double influx_multiplier;
-          int reservoir_face_dir;
-          int record_index;
-        };
+        if (!deck.hasKeyword("AQUANCON"))
+            return;
 
-        // Create a working buffer 
-        std::vector<pair_elements> working_buffer;
+        const auto& aquanconKeyword = deck.getKeyword("AQUANCON");
+        std::vector<AquanconRecord> records;
+        records.reserve(aquanconKeyword.size());
+
+        // The record indices of each aquifer ID, in increasing order
+        std::vector<std::vector<int>> aquifer_records;
 
-        // Iterate through each aquifer IDs (This is because each element in the original vector represents an aquifer ID)
-        for (auto aquconvec = output_vector.begin(); aquconvec != output_vector.end(); ++aquconvec)
+        for (size_t aquanconRecordIdx = 0; aquanconRecordIdx < aquanconKeyword.size(); ++aquanconRecordIdx)
         {
-            //Begin to fill the working buffer
-            working_buffer.clear();
-            working_buffer.resize(aquconvec->global_index.size());
-            for (size_t i = 0; i < aquconvec->global_index.size(); ++i )
-            {
-                working_buffer.at(i).global_index = aquconvec->global_index.at(i);
-                working_buffer.at(i).influx_coeff = aquconvec->influx_coeff.at(i);
-                working_buffer.at(i).influx_multiplier = aquconvec->influx_multiplier.at(i);
-                working_buffer.at(i).reservoir_face_dir = aquconvec->reservoir_face_dir.at(i);
-                working_buffer.at(i).record_index = aquconvec->record_index.at(i);
-            }
+            const auto& aquanconRecord = aquanconKeyword.getRecord(aquanconRecordIdx);
+            AquanconRecord record;
 
-            // Sort by ascending order the working_buffer vector in order of priority:
-            // 1) global_index, then 2) record_index
-
-            std::sort(  working_buffer.begin(),
-                        working_buffer.end(),
-                        [](pair_elements& element1, pair_elements& element2) -> bool
-                        {
-                            if (element1.global_index == element2.global_index)
-                            {
-                                return element1.record_index < element2.record_index;
-                            }
-                            else
-                                return element1.global_index < element2.global_index;
-                        }
-                     );
-
-            // We then proceed to obtain unique elements of the global_index, and we apply the 
-            // following behaviour (as mentioned in the Eclipse 2014.1 Reference Manual p.345):
-            // If a reservoir cell is defined more than once, its previous value for the 
-            // aquifer influx coefficient is added to the present value.
-
-            auto i2 = std::unique(  working_buffer.begin(),
-                                    working_buffer.end(),
-                                    [](pair_elements& element1, pair_elements& element2) -> bool
-                                    {
-                                        if (element1.global_index == element2.global_index)
-                                        {
-                                            *(element1.influx_coeff) += *(element2.influx_coeff);
-                                            return true;
-                                        }
-
-                                        return false;
-                                    }
-                                 );
-            working_buffer.resize( std::distance(working_buffer.begin(),i2) );
-
-            // We now resize and fill the output_vector elements
-            aquconvec->global_index.resize(working_buffer.size());
-            aquconvec->influx_coeff.resize(working_buffer.size());
-            aquconvec->influx_multiplier.resize(working_buffer.size());
-            aquconvec->reservoir_face_dir.resize(working_buffer.size());
-            aquconvec->record_index.resize(working_buffer.size());
-            for (size_t i = 0; i < working_buffer.size(); ++i)
-            {
-                aquconvec->global_index.at(i) = working_buffer.at(i).global_index;
-                aquconvec->influx_coeff.at(i) = working_buffer.at(i).influx_coeff;
-                aquconvec->influx_multiplier.at(i) = working_buffer.at(i).influx_multiplier;
-                aquconvec->reservoir_face_dir.at(i) = working_buffer.at(i).reservoir_face_dir;
-                aquconvec->record_index.at(i) = working_buffer.at(i).record_index;
-            }
+            record.i1 = aquanconRecord.getItem("I1").template get<int>(0);
+            record.i2 = aquanconRecord.getItem("I2").template get<int>(0);
+            record.j1 = aquanconRecord.getItem("J1").template get<int>(0);
+            record.j2 = aquanconRecord.getItem("J2").template get<int>(0);
+            record.k1 = aquanconRecord.getItem("K1").template get<int>(0);
+            record.k2 = aquanconRecord.getItem("K2").template get<int>(0);
 
-        }
- 
-        return output_vector;
-    }
+            record.has_influx_coeff = aquanconRecord.getItem("INFLUX_COEFF").hasValue(0);
+            record.influx_coeff = record.has_influx_coeff ? aquanconRecord.getItem("INFLUX_COEFF").getSIDouble(0) : 0;
+            record.influx_mult = aquanconRecord.getItem("INFLUX_MULT").getSIDouble(0);
+            record.face = FaceDir::FromString(aquanconRecord.getItem("FACE").getTrimmedString(0));
+            records.push_back(record);
 
-    void Aquancon::convert_record_id_to_aquifer_id(std::vector<int>& record_indices_matching_id,
-                                                   int i, std::vector<int> m_aquiferID_per_record)
-    {
-        auto it = std::find_if( m_aquiferID_per_record.begin(), m_aquiferID_per_record.end(), 
-                                    [&](int id) {
-                                        return id == i;
-                                    } 
-                                );
-        while (it != m_aquiferID_per_record.end()) {
-            record_indices_matching_id.emplace_back(std::distance(m_aquiferID_per_record.begin(), it));
-            it = std::find_if(std::next(it), m_aquiferID_per_record.end(), [&](int id){return id == i;});
+            const int aquiferID = aquanconRecord.getItem("AQUIFER_ID").template get<int>(0);
+            if (aquiferID < 1)
+                continue;
+
+            if (aquiferID > int(aquifer_records.size()))
+                aquifer_records.resize(aquiferID);
+
+            aquifer_records[aquiferID - 1].push_back(aquanconRecordIdx);
         }
+
+        // One entry per aquifer ID up to the largest one
+        m_aquoutput.reserve(aquifer_records.size());
+        for (size_t aquiferIdx = 0; aquiferIdx < aquifer_records.size(); ++aquiferIdx)
+            m_aquoutput.push_back(connect_aquifer(aquiferIdx + 1, aquifer_records[aquiferIdx], records, grid));
     }
 
+
     const std::vector<Aquancon::AquanconOutput>& Aquancon::getAquOutput() const
     {
         return m_aquoutput;
@@ -18,8 +18,11 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <functional>
-#include <set>
+
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
@@ -31,6 +34,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 #include "Grid/setKeywordBox.hpp"
@@ -39,117 +43,200 @@ namespace Opm {
 
     namespace {
 
+        /*
+          Adds a box operation to the batch. An operation on a property
+          which is not prepared may read other properties when it is
+          applied, so the batch is applied first and the operation on
+          its own.
+        */
+        template< typename Prepare >
+        void batchOperation( GridPropertyOperations& operations, bool prepared, Prepare prepare ) {
+            if (!prepared) {
+                operations.apply();
+                const auto operation = prepare();
+                if (operation.apply)
+                    operation.apply();
+                return;
+            }
+
+            auto operation = prepare();
+            if (!operations.fits( operation ))
+                operations.apply();
+            operations.add( std::move( operation ) );
+        }
+
+
+        /*
+          The post processors below are written as kernels working on a
+          block of consecutive global indices; all the input arrays of a
+          post processor are read in the same sweep, block by block, and
+          the blocks are processed in parallel when OpenMP is enabled.
+          The post processors depend on each other only through
+          GridProperties::getKeyword(), which runs the post processor of
+          the requested property first - i.e. the ACTNUM post processor
+          gets the PORV values after initPORV() and initPORV() gets PORO
+          after distTopLayer(). Each post processor is timed as a phase
+          of its own.
+        */
+        const size_t parallel_block_size = 1 << 16;
+
+        template< typename F >
+        void for_each_block( size_t size, F op ) {
+            const long num_blocks = (size + parallel_block_size - 1) / parallel_block_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_blocks > 1)
+#endif
+            for (long block = 0; block < num_blocks; ++block) {
+                const size_t begin = block * parallel_block_size;
+                op( begin, std::min( size, begin + parallel_block_size ) );
+            }
+        }
+
+
+        /*
+          Every layer copies the undefined values from the layer above,
+          so the layers are processed in order; the columns are split in
+          blocks.
+        */
         void distTopLayer( std::vector<double>&    values,
                            const EclipseGrid*      eclipseGrid )
         {
+            PhaseTimer::Scope phase("Eclipse3DProperties::distTopLayer");
             size_t layerSize = eclipseGrid->getNX() * eclipseGrid->getNY();
             size_t gridSize  = eclipseGrid->getCartesianSize();
 
-            for( size_t globalIndex = layerSize; globalIndex < gridSize; globalIndex++ ) {
-                if( std::isnan( values[ globalIndex ] ) )
-                    values[globalIndex] = values[globalIndex - layerSize];
-            }
+            for_each_block( layerSize, [&values, layerSize, gridSize]( size_t begin, size_t end ) {
+                for (size_t layer = layerSize; layer < gridSize; layer += layerSize) {
+                    for (size_t globalIndex = layer + begin; globalIndex < layer + end; globalIndex++) {
+                        if( std::isnan( values[ globalIndex ] ) )
+                            values[globalIndex] = values[globalIndex - layerSize];
+                    }
+                }
+            });
         }
 
-        // this funcion applies a single pore volume multiplier (i.e., it deals with a single
-        // record of the MULTREGP keyword)
-        void applyPorosityRegionMultiplier_(std::vector<double>& porev,
-                                            const std::vector<int>& regionId,
-                                            int multRegionId,
-                                            double multValue)
+        // a single pore volume multiplier (i.e., a single record of the MULTREGP keyword)
+        struct PorosityRegionMultiplier {
+            const std::vector<int>* regionId;
+            int multRegionId;
+            double multValue;
+        };
+
+        /*
+          The MULTREGP records which apply, in the order they are applied
+          to the pore volumes.
+        */
+        std::vector<PorosityRegionMultiplier> porosityRegionMultipliers( const Deck* deck,
+                                                                         const GridProperties<int>* intGridProperties )
         {
-            for (unsigned i = 0; i < porev.size(); ++i) {
-                if (regionId[i] == multRegionId)
-                    porev[i] *= multValue;
+            std::vector<PorosityRegionMultiplier> multipliers;
+            if (!deck->hasKeyword("MULTREGP"))
+                return multipliers;
+
+            const DeckKeyword& multregpKeyword = deck->getKeyword("MULTREGP");
+            for (unsigned recordIdx = 0; recordIdx < multregpKeyword.size(); ++recordIdx) {
+                const DeckRecord& multregpRecord = multregpKeyword.getRecord(recordIdx);
+
+                int regionId = multregpRecord.getItem("REGION").template get<int>(0);
+                std::string regionType = multregpRecord.getItem("REGION_TYPE").template get<std::string>(0);
+                double multValue = multregpRecord.getItem("MULTIPLIER").template get<double>(0);
+                uppercase(regionType, regionType);
+
+                // deal with the "convenience" feature of ECL: if the region index is
+                // zero or negative, the record is ignored.
+                if (regionId <= 0)
+                    continue;
+
+                // implement a (documented) ECL bug: the region index must be unique
+                // (i.e., it is impossible to specify multipliers for different
+                // region types with the same index). Also, only the last occurence
+                // of each region counts.
+                unsigned record2Idx = recordIdx + 1;
+                for (; record2Idx < multregpKeyword.size(); ++record2Idx) {
+                    const DeckRecord& multregpRecord2 = multregpKeyword.getRecord(record2Idx);
+                    int region2Idx = multregpRecord2.getItem("REGION").template get<int>(0);
+                    if (region2Idx == regionId)
+                        break;
+                }
+                if (record2Idx < multregpKeyword.size())
+                    // the region was specified twice
+                    continue;
+
+                std::string regionKeyword;
+                if (regionType == "M")
+                    regionKeyword = "MULTNUM";
+                else if (regionType == "F")
+                    regionKeyword = "FLUXNUM";
+                else if (regionType == "O")
+                    regionKeyword = "OPERNUM";
+                else
+                    throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+
+                const auto& regionProp = intGridProperties->getKeyword(regionKeyword);
+                multipliers.push_back( { &regionProp.getData(), regionId, multValue } );
             }
+
+            return multipliers;
         }
 
         /// this function initializes the pore volume of all cells. it uses the raw keyword
         /// 'MULTREGP', the integer grid properties 'FLUXNUM', 'MULTNUM' and 'OPERNUM' as
-        /// well as the double grid properties 'PORV', 'PORO', 'NTG' and 'MULTPV'
+        /// well as the double grid properties 'PORV', 'PORO', 'NTG' and 'MULTPV'. The pore
+        /// volume, MULTPV and the MULTREGP multipliers are applied to a cell in one go, in
+        /// the same order as ECLIPSE.
         void initPORV( std::vector<double>&    values,
                        const Deck* deck,
                        const EclipseGrid*      eclipseGrid,
                        const GridProperties<int>* intGridProperties,
                        const GridProperties<double>* doubleGridProperties)
         {
+            PhaseTimer::Scope phase("Eclipse3DProperties::initPORV");
+
+            const std::vector<double>* poroData = nullptr;
+            const std::vector<double>* ntgData = nullptr;
             if ( doubleGridProperties->hasKeyword("PORO") ) {
-                const auto& poro = doubleGridProperties->getKeyword("PORO");
-                const auto& ntg =  doubleGridProperties->getKeyword("NTG");
+                poroData = &doubleGridProperties->getKeyword("PORO").getData();
+                ntgData = &doubleGridProperties->getKeyword("NTG").getData();
+            }
 
-                const auto& poroData = poro.getData();
-                for (size_t globalIndex = 0; globalIndex < poro.getCartesianSize(); globalIndex++) {
-                    if (!std::isfinite(values[globalIndex])) {
-                        double cell_poro = poroData[globalIndex];
-                        if (std::isnan(cell_poro))
-                            throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
+            const std::vector<double>* multpvData = nullptr;
+            if (doubleGridProperties->hasKeyword("MULTPV"))
+                multpvData = &doubleGridProperties->getKeyword("MULTPV").getData();
 
-                        double cell_ntg = ntg.iget(globalIndex);
+            const auto multipliers = porosityRegionMultipliers( deck, intGridProperties );
+
+            std::atomic<bool> missing( false );
+            for_each_block( values.size(), [&]( size_t begin, size_t end ) {
+                for (size_t globalIndex = begin; globalIndex < end; globalIndex++) {
+                    double porv = values[globalIndex];
+                    if (!std::isfinite(porv)) {
+                        if (!poroData || std::isnan((*poroData)[globalIndex])) {
+                            missing = true;
+                            return;
+                        }
+
+                        double cell_poro = (*poroData)[globalIndex];
+                        double cell_ntg = (*ntgData)[globalIndex];
                         double cell_volume = eclipseGrid->getCellVolume(globalIndex);
-                        values[globalIndex] = cell_poro * cell_volume * cell_ntg;
+                        porv = cell_poro * cell_volume * cell_ntg;
                     }
-                }
-            }
-            else {
-                for (size_t globalIndex = 0; globalIndex < values.size(); globalIndex++)
-                    if ( !std::isfinite(values[globalIndex]) )
-                        throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
-            }
 
-            if (doubleGridProperties->hasKeyword("MULTPV")) {
-                const GridProperty<double>& multpvKeyword = doubleGridProperties->getKeyword("MULTPV");
-                const auto& multpvData = multpvKeyword.getData();
-                for (size_t globalIndex = 0; globalIndex < multpvData.size(); globalIndex++)
-                    values[globalIndex] *= multpvData[globalIndex];
-            }
+                    if (multpvData)
+                        porv *= (*multpvData)[globalIndex];
 
-            // deal with the region multiplier for porosity
-            if (deck->hasKeyword("MULTREGP")) {
-                const DeckKeyword& multregpKeyword = deck->getKeyword("MULTREGP");
-                for (unsigned recordIdx = 0; recordIdx < multregpKeyword.size(); ++recordIdx) {
-                    const DeckRecord& multregpRecord = multregpKeyword.getRecord(recordIdx);
-
-                    int regionId = multregpRecord.getItem("REGION").template get<int>(0);
-                    std::string regionType = multregpRecord.getItem("REGION_TYPE").template get<std::string>(0);
-                    double multValue = multregpRecord.getItem("MULTIPLIER").template get<double>(0);
-                    uppercase(regionType, regionType);
-
-                    // deal with the "convenience" feature of ECL: if the region index is
-                    // zero or negative, the record is ignored.
-                    if (regionId <= 0)
-                        continue;
-
-                    // implement a (documented) ECL bug: the region index must be unique
-                    // (i.e., it is impossible to specify multipliers for different
-                    // region types with the same index). Also, only the last occurence
-                    // of each region counts.
-                    unsigned record2Idx = recordIdx + 1;
-                    for (; record2Idx < multregpKeyword.size(); ++record2Idx) {
-                        const DeckRecord& multregpRecord2 = multregpKeyword.getRecord(record2Idx);
-                        int region2Idx = multregpRecord2.getItem("REGION").template get<int>(0);
-                        if (region2Idx == regionId)
-                            break;
+                    for (const auto& mult : multipliers) {
+                        if ((*mult.regionId)[globalIndex] == mult.multRegionId)
+                            porv *= mult.multValue;
                     }
-                    if (record2Idx < multregpKeyword.size())
-                        // the region was specified twice
-                        continue;
 
-                    if (regionType == "M") {
-                        const GridProperty<int>& multnumProp = intGridProperties->getKeyword("MULTNUM");
-                        applyPorosityRegionMultiplier_(values, multnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "F") {
-                        const GridProperty<int>& fluxnumProp = intGridProperties->getKeyword("FLUXNUM");
-                        applyPorosityRegionMultiplier_(values, fluxnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "O") {
-                        const GridProperty<int>& opernumProp = intGridProperties->getKeyword("OPERNUM");
-                        applyPorosityRegionMultiplier_(values, opernumProp.getData(), regionId, multValue);
-                    }
-                    else
-                        throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+                    values[globalIndex] = porv;
                 }
-            }
+            });
+
+            if (missing)
+                throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
+
+            PhaseTimer::count("cells", values.size());
         }
 
 
@@ -180,15 +267,14 @@ namespace Opm {
             if (!hasPORV)
                 return;
 
-            {
-                const auto& porv = doubleGridProperties->getKeyword("PORV");
-                {
-                    const auto& porvData = porv.getData();
-                    for (size_t i = 0; i < porvData.size(); i++)
-                        if (porvData[i] == 0)
-                            values[i] = 0;
-                }
-            }
+            const auto& porvData = doubleGridProperties->getKeyword("PORV").getData();
+
+            PhaseTimer::Scope phase("Eclipse3DProperties::ACTNUM");
+            for_each_block( porvData.size(), [&values, &porvData]( size_t begin, size_t end ) {
+                for (size_t i = begin; i < end; i++)
+                    if (porvData[i] == 0)
+                        values[i] = 0;
+            });
         }
     }
 
@@ -458,11 +544,25 @@ namespace Opm {
         m_doubleGridProperties(eclipseGrid, &unit_system,
                                makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties))
     {
+        m_intGridProperties.m_lock = m_doubleGridProperties.m_lock;
     }
 
     Eclipse3DProperties::Eclipse3DProperties( const Deck&         deck,
                                               const TableManager& tableManager,
                                               const EclipseGrid&  eclipseGrid)
+        : Eclipse3DProperties( deck, tableManager, eclipseGrid, false )
+    {}
+
+    Eclipse3DProperties::Eclipse3DProperties( Deck&&              deck,
+                                              const TableManager& tableManager,
+                                              const EclipseGrid&  eclipseGrid)
+        : Eclipse3DProperties( deck, tableManager, eclipseGrid, true )
+    {}
+
+    Eclipse3DProperties::Eclipse3DProperties( const Deck&         deck,
+                                              const TableManager& tableManager,
+                                              const EclipseGrid&  eclipseGrid,
+                                              bool                consumeDeck)
         :
 
           m_defaultRegion("FLUXNUM"),
@@ -474,6 +574,9 @@ namespace Opm {
           m_doubleGridProperties(eclipseGrid, &m_deckUnitSystem,
                                  makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties))
     {
+        PhaseTimer::Scope phase("Eclipse3DProperties");
+        m_intGridProperties.m_lock = m_doubleGridProperties.m_lock;
+
         /*
          * The EQUALREG, MULTREG, COPYREG, ... keywords are used to manipulate
          * vectors based on region values; for instance the statement
@@ -540,7 +643,7 @@ namespace Opm {
                                                 true );
         }
 
-        processGridProperties(deck, eclipseGrid);
+        processGridProperties(deck, eclipseGrid, consumeDeck);
     }
 
     bool Eclipse3DProperties::supportsGridProperty(const std::string& keyword) const {
@@ -565,16 +668,36 @@ namespace Opm {
 
 
     const GridProperty<int>& Eclipse3DProperties::getIntGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_intGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
-        return gridProperty;
+        return this->getIntGridProperty( m_intGridProperties.keywordHandle( keyword ) );
     }
 
 
 
     /// gets property from doubleGridProperty --- and calls the runPostProcessor
     const GridProperty<double>& Eclipse3DProperties::getDoubleGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_doubleGridProperties.getKeyword( keyword );
+        return this->getDoubleGridProperty( m_doubleGridProperties.keywordHandle( keyword ) );
+    }
+
+
+    GridProperties<int>::Handle Eclipse3DProperties::intGridPropertyHandle( const std::string& keyword ) const {
+        return m_intGridProperties.keywordHandle( keyword );
+    }
+
+
+    GridProperties<double>::Handle Eclipse3DProperties::doubleGridPropertyHandle( const std::string& keyword ) const {
+        return m_doubleGridProperties.keywordHandle( keyword );
+    }
+
+
+    const GridProperty<int>& Eclipse3DProperties::getIntGridProperty( GridProperties<int>::Handle handle ) const {
+        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_intGridProperties.getKeyword( handle );
+        gridProperty.runPostProcessor();
+        return gridProperty;
+    }
+
+
+    const GridProperty<double>& Eclipse3DProperties::getDoubleGridProperty( GridProperties<double>::Handle handle ) const {
+        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_doubleGridProperties.getKeyword( handle );
         gridProperty.runPostProcessor();
         return gridProperty;
     }
@@ -587,6 +710,29 @@ namespace Opm {
         return m_doubleGridProperties;
     }
 
+    void Eclipse3DProperties::compactProperties() {
+        std::vector< std::string > keywords;
+        for (const auto& property : m_intGridProperties)
+            keywords.push_back( property.getKeywordName() );
+
+        // The post processors are run first, they would widen the data again.
+        for (const auto& keyword : keywords)
+            this->getIntGridProperty( keyword ).compact();
+
+        // The double post processors, like the PORV calculation, are
+        // expensive and left to run on first use.
+        for (const auto& property : m_doubleGridProperties)
+            property.compact();
+    }
+
+
+    MemoryUsage Eclipse3DProperties::memory_usage() const {
+        MemoryUsage usage( "Eclipse3DProperties", sizeof( *this ) - sizeof( m_intGridProperties ) - sizeof( m_doubleGridProperties ) );
+        usage.add( m_doubleGridProperties.memory_usage() );
+        usage.add( m_intGridProperties.memory_usage() );
+        return usage;
+    }
+
 
     std::string Eclipse3DProperties::getDefaultRegionKeyword() const {
         return m_defaultRegion;
@@ -601,30 +747,36 @@ namespace Opm {
         }
     }
 
-    std::vector< int > Eclipse3DProperties::getRegions( const std::string& keyword ) const {
-        if( !this->hasDeckIntGridProperty( keyword ) ) return {};
-
-        const auto& property = this->getIntGridProperty( keyword );
+    const std::vector< int >& Eclipse3DProperties::getRegions( const std::string& keyword ) const {
+        static const std::vector< int > no_regions;
+        if( !this->hasDeckIntGridProperty( keyword ) ) return no_regions;
 
-        std::set< int > regions( property.getData().begin(),
-                                 property.getData().end() );
-
-        return { regions.begin(), regions.end() };
+        return this->getIntGridProperty( keyword ).regionIndex()->regions();
     }
 
     ///  Due to the post processor which might be applied to the GridProperty
     ///  objects it is essential that this method use the m_intGridProperties /
     ///  m_doubleGridProperties fields directly and *NOT* use the public methods
     ///  getIntGridProperty / getDoubleGridProperty.
+    ///
+    ///  With consumeDeck the keyword belongs to the deck which was passed
+    ///  to the constructor as an rvalue, and its values may be moved out.
     void Eclipse3DProperties::loadGridPropertyFromDeckKeyword(const Box& inputBox,
-                                                              const DeckKeyword& deckKeyword) {
+                                                              const DeckKeyword& deckKeyword,
+                                                              bool consumeDeck) {
         const std::string& keyword = deckKeyword.name();
         if (m_intGridProperties.supportsKeyword( keyword )) {
             auto& gridProperty = m_intGridProperties.getOrCreateProperty( keyword );
-            gridProperty.loadFromDeckKeyword( inputBox, deckKeyword );
+            if (consumeDeck)
+                gridProperty.consumeDeckKeyword( inputBox, const_cast< DeckKeyword& >( deckKeyword ) );
+            else
+                gridProperty.loadFromDeckKeyword( inputBox, deckKeyword );
         } else if (m_doubleGridProperties.supportsKeyword( keyword )) {
             auto& gridProperty = m_doubleGridProperties.getOrCreateProperty( keyword );
-            gridProperty.loadFromDeckKeyword( inputBox, deckKeyword );
+            if (consumeDeck)
+                gridProperty.consumeDeckKeyword( inputBox, const_cast< DeckKeyword& >( deckKeyword ) );
+            else
+                gridProperty.loadFromDeckKeyword( inputBox, deckKeyword );
         } else {
             throw std::logic_error( "Tried to load unsupported grid property from keyword: " + deckKeyword.name() );
         }
@@ -719,85 +871,101 @@ namespace Opm {
 
 
     void Eclipse3DProperties::processGridProperties( const Deck& deck,
-                                                     const EclipseGrid& eclipseGrid) {
+                                                     const EclipseGrid& eclipseGrid,
+                                                     bool consumeDeck) {
 
         if (Section::hasGRID(deck))
-            scanSection(GRIDSection(deck), eclipseGrid);
+            scanSection(GRIDSection(deck), eclipseGrid, consumeDeck);
 
         if (Section::hasREGIONS(deck))
-            scanSection(REGIONSSection(deck), eclipseGrid);
+            scanSection(REGIONSSection(deck), eclipseGrid, consumeDeck);
 
         if (Section::hasEDIT(deck))
-            scanSection(EDITSection(deck), eclipseGrid);
+            scanSection(EDITSection(deck), eclipseGrid, consumeDeck);
 
         if (Section::hasPROPS(deck))
-            scanSection(PROPSSection(deck), eclipseGrid);
+            scanSection(PROPSSection(deck), eclipseGrid, consumeDeck);
 
         if (Section::hasSOLUTION(deck))
-            scanSection(SOLUTIONSection(deck), eclipseGrid);
+            scanSection(SOLUTIONSection(deck), eclipseGrid, consumeDeck);
     }
 
 
 
     void Eclipse3DProperties::scanSection(const Section& section,
-                                          const EclipseGrid& eclipseGrid) {
+                                          const EclipseGrid& eclipseGrid,
+                                          bool consumeDeck) {
         BoxManager boxManager(eclipseGrid.getNX(),
                               eclipseGrid.getNY(),
                               eclipseGrid.getNZ());
 
+        /*
+          Runs of EQUALS, COPY, ADD, MULTIPLY, MINVALUE and MAXVALUE
+          records on different properties are collected and applied
+          together; every other keyword applies the operations
+          collected so far first.
+        */
+        GridPropertyOperations operations;
         for( const auto& deckKeyword : section ) {
+            ParseProfile::Consume consume( deckKeyword.name() );
 
-            if (supportsGridProperty(deckKeyword.name()) )
+            if (supportsGridProperty(deckKeyword.name()) ) {
+                operations.apply();
                 loadGridPropertyFromDeckKeyword( boxManager.getActiveBox(),
-                                                 deckKeyword);
-            else {
-                if (deckKeyword.name() == "BOX")
-                    handleBOXKeyword(deckKeyword, boxManager);
-
-                else if (deckKeyword.name() == "ENDBOX")
-                    handleENDBOXKeyword(boxManager);
-
-
-                else if (deckKeyword.name() == "COPY")
-                    handleCOPYKeyword( deckKeyword , boxManager);
+                                                 deckKeyword,
+                                                 consumeDeck);
+            } else {
+                if (deckKeyword.name() == "COPY")
+                    handleCOPYKeyword( deckKeyword , boxManager, operations);
 
                 else if (deckKeyword.name() == "EQUALS")
-                    handleEQUALSKeyword(deckKeyword, boxManager);
+                    handleEQUALSKeyword(deckKeyword, boxManager, operations);
 
 
                 else if (deckKeyword.name() == "ADD")
-                    handleADDKeyword( deckKeyword , boxManager);
+                    handleADDKeyword( deckKeyword , boxManager, operations);
 
                 else if (deckKeyword.name() == "MULTIPLY")
-                    handleMULTIPLYKeyword(deckKeyword, boxManager);
+                    handleMULTIPLYKeyword(deckKeyword, boxManager, operations);
 
                 else if (deckKeyword.name() == "MAXVALUE")
-                    handleMAXVALUEKeyword(deckKeyword, boxManager);
+                    handleMAXVALUEKeyword(deckKeyword, boxManager, operations);
 
                 else if (deckKeyword.name() == "MINVALUE")
-                    handleMINVALUEKeyword(deckKeyword, boxManager);
+                    handleMINVALUEKeyword(deckKeyword, boxManager, operations);
+
+                else {
+                    operations.apply();
+
+                    if (deckKeyword.name() == "BOX")
+                        handleBOXKeyword(deckKeyword, boxManager);
 
-                else if (deckKeyword.name() == "EQUALREG")
-                    handleEQUALREGKeyword(deckKeyword);
+                    else if (deckKeyword.name() == "ENDBOX")
+                        handleENDBOXKeyword(boxManager);
 
-                else if (deckKeyword.name() == "ADDREG")
-                    handleADDREGKeyword(deckKeyword);
+                    else if (deckKeyword.name() == "EQUALREG")
+                        handleEQUALREGKeyword(deckKeyword);
 
-                else if (deckKeyword.name() == "MULTIREG")
-                    handleMULTIREGKeyword(deckKeyword);
+                    else if (deckKeyword.name() == "ADDREG")
+                        handleADDREGKeyword(deckKeyword);
 
-                else if (deckKeyword.name() == "COPYREG")
-                    handleCOPYREGKeyword(deckKeyword);
+                    else if (deckKeyword.name() == "MULTIREG")
+                        handleMULTIREGKeyword(deckKeyword);
 
-                else if (deckKeyword.name() == "OPERATE")
-                    handleOPERATEKeyword( deckKeyword , boxManager);
+                    else if (deckKeyword.name() == "COPYREG")
+                        handleCOPYREGKeyword(deckKeyword);
 
-                else if (deckKeyword.name() == "OPERATER")
-                    handleOPERATERKeyword( deckKeyword );
+                    else if (deckKeyword.name() == "OPERATE")
+                        handleOPERATEKeyword( deckKeyword , boxManager);
+
+                    else if (deckKeyword.name() == "OPERATER")
+                        handleOPERATERKeyword( deckKeyword );
+                }
 
                 boxManager.endKeyword();
             }
         }
+        operations.apply();
         boxManager.endSection();
     }
 
@@ -920,14 +1088,16 @@ namespace Opm {
 
     //Note that the MAXVALUE kqeyword is processed in place for the current value of the keyword,
     // and does not "stick" as a persistent attribute of the keyword.
-    void Eclipse3DProperties::handleMAXVALUEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleMAXVALUEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
 
             if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleMAXVALUERecord( record , boxManager );
+                batchOperation( operations, m_doubleGridProperties.isPrepared( field ),
+                                [&]() { return m_doubleGridProperties.prepareMAXVALUERecord( record , boxManager ); } );
             else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleMAXVALUERecord( record , boxManager );
+                batchOperation( operations, m_intGridProperties.isPrepared( field ),
+                                [&]() { return m_intGridProperties.prepareMAXVALUERecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing MAXVALUE keyword. Tried to limit not defined keyword " + field);
 
@@ -936,14 +1106,16 @@ namespace Opm {
 
     //Note that the MINVALUE keyword is processed in place for the current value of the keyword,
     // and does not "stick" as a persistent attribute of the keyword.
-    void Eclipse3DProperties::handleMINVALUEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleMINVALUEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
 
             if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleMINVALUERecord( record , boxManager );
+                batchOperation( operations, m_doubleGridProperties.isPrepared( field ),
+                                [&]() { return m_doubleGridProperties.prepareMINVALUERecord( record , boxManager ); } );
             else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleMINVALUERecord( record , boxManager );
+                batchOperation( operations, m_intGridProperties.isPrepared( field ),
+                                [&]() { return m_intGridProperties.prepareMINVALUERecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing MINVALUE keyword. Tried to limit not defined keyword " + field);
 
@@ -951,14 +1123,16 @@ namespace Opm {
     }
 
 
-    void Eclipse3DProperties::handleMULTIPLYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleMULTIPLYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
 
             if (m_doubleGridProperties.supportsKeyword( field ))
-                m_doubleGridProperties.handleMULTIPLYRecord( record , boxManager );
+                batchOperation( operations, m_doubleGridProperties.isPrepared( field ),
+                                [&]() { return m_doubleGridProperties.prepareMULTIPLYRecord( record , boxManager ); } );
             else if (m_intGridProperties.supportsKeyword( field ))
-                m_intGridProperties.handleMULTIPLYRecord( record , boxManager );
+                batchOperation( operations, m_intGridProperties.isPrepared( field ),
+                                [&]() { return m_intGridProperties.prepareMULTIPLYRecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing MULTIPLY keyword. Tried to scale not defined keyword " + field);
 
@@ -971,14 +1145,16 @@ namespace Opm {
       some state dependent semantics regarding endpoint scaling arrays
       in the PROPS section. That is not supported.
     */
-    void Eclipse3DProperties::handleADDKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleADDKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
 
             if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleADDRecord( record , boxManager );
+                batchOperation( operations, m_doubleGridProperties.isPrepared( field ),
+                                [&]() { return m_doubleGridProperties.prepareADDRecord( record , boxManager ); } );
             else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleADDRecord( record , boxManager );
+                batchOperation( operations, m_intGridProperties.isPrepared( field ),
+                                [&]() { return m_intGridProperties.prepareADDRecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing ADD keyword. Tried to shift not defined keyword " + field);
 
@@ -986,14 +1162,19 @@ namespace Opm {
     }
 
 
-    void Eclipse3DProperties::handleCOPYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleCOPYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("src").get< std::string >(0);
+            const std::string& target = record.getItem("target").get< std::string >(0);
 
             if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleCOPYRecord( record , boxManager );
+                batchOperation( operations,
+                                m_doubleGridProperties.isPrepared( field ) && m_doubleGridProperties.isPrepared( target ),
+                                [&]() { return m_doubleGridProperties.prepareCOPYRecord( record , boxManager ); } );
             else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleCOPYRecord( record , boxManager );
+                batchOperation( operations,
+                                m_intGridProperties.isPrepared( field ) && m_intGridProperties.isPrepared( target ),
+                                [&]() { return m_intGridProperties.prepareCOPYRecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing COPY keyword. Tried to copy not defined keyword " + field);
 
@@ -1001,14 +1182,16 @@ namespace Opm {
     }
 
 
-    void Eclipse3DProperties::handleEQUALSKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
+    void Eclipse3DProperties::handleEQUALSKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager, GridPropertyOperations& operations) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
 
             if (m_doubleGridProperties.supportsKeyword( field ))
-                m_doubleGridProperties.handleEQUALSRecord( record , boxManager );
+                batchOperation( operations, m_doubleGridProperties.isPrepared( field ),
+                                [&]() { return m_doubleGridProperties.prepareEQUALSRecord( record , boxManager ); } );
             else if (m_intGridProperties.supportsKeyword( field ))
-                m_intGridProperties.handleEQUALSRecord( record , boxManager );
+                batchOperation( operations, m_intGridProperties.isPrepared( field ),
+                                [&]() { return m_intGridProperties.prepareEQUALSRecord( record , boxManager ); } );
             else
                 throw std::invalid_argument("Fatal error processing EQUALS keyword. Tried to assign not defined keyword " + field);
 
@@ -17,7 +17,11 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
+#include <future>
+#include <map>
 #include <set>
+#include <thread>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -49,18 +53,177 @@
 
 namespace Opm {
 
+    struct EclipseState::DeckComponents {
+        TableManager tables;
+        EclipseConfig config;
+        EclipseGrid grid;
+    };
+
+
+    /*
+      The tables and the EclipseConfig are built on their own threads
+      while the grid, usually the largest of the three, is built on the
+      calling thread; the properties, the simulation configuration and
+      the transmissibility multipliers depend on them and are built in
+      sequence afterwards. An exception from any of the three is
+      rethrown here, after all of them have finished.
+    */
+    EclipseState::DeckComponents EclipseState::buildComponents(const Deck& deck, const ParseContext& parseContext) {
+        const auto policy = (std::thread::hardware_concurrency() > 1) ? std::launch::async : std::launch::deferred;
+
+        auto tables = std::async(policy, [&deck]() { return TableManager( deck ); });
+        auto config = std::async(policy, [&deck, &parseContext]() { return EclipseConfig( deck, parseContext ); });
+        EclipseGrid grid( deck, nullptr );
+
+        return { tables.get(), config.get(), std::move( grid ) };
+    }
+
+
     EclipseState::EclipseState(const Deck& deck, const ParseContext& parseContext) :
-        m_tables(            deck ),
+        EclipseState( deck, buildComponents( deck, parseContext ) )
+    {}
+
+
+    EclipseState::EclipseState(const Deck& deck, DeckComponents&& components) :
+        m_tables(            std::move( components.tables ) ),
         m_runspec(           deck ),
-        m_eclipseConfig(     deck, parseContext ),
+        m_eclipseConfig(     std::move( components.config ) ),
         m_deckUnitSystem(    deck.getActiveUnitSystem() ),
         m_inputNnc(          deck ),
         m_inputEditNnc(      deck ),
-        m_inputGrid(         deck, nullptr ),
+        m_inputGrid(         std::move( components.grid ) ),
         m_eclipseProperties( deck, m_tables, m_inputGrid ),
         m_simulationConfig(  m_eclipseConfig.getInitConfig().restartRequested(), deck, m_eclipseProperties ),
         m_transMult(         GridDims(deck), deck, m_eclipseProperties )
     {
+        initState(deck);
+    }
+
+
+    /*
+      The properties only take the data of the grid property keywords;
+      the deck is otherwise left alone and is still used by the members
+      built after them.
+    */
+    EclipseState::EclipseState(Deck&& deck, const ParseContext& parseContext) :
+        EclipseState( std::move( deck ), buildComponents( deck, parseContext ) )
+    {
+        // The grid has its own copy of the corner point geometry.
+        for (auto& keyword : deck) {
+            if (keyword.name() == "COORD" || keyword.name() == "ZCORN")
+                keyword.getRecord( 0 ).getItem( 0 ).releaseData< double >();
+        }
+    }
+
+
+    EclipseState::EclipseState(Deck&& deck, DeckComponents&& components) :
+        m_tables(            std::move( components.tables ) ),
+        m_runspec(           deck ),
+        m_eclipseConfig(     std::move( components.config ) ),
+        m_deckUnitSystem(    deck.getActiveUnitSystem() ),
+        m_inputNnc(          deck ),
+        m_inputEditNnc(      deck ),
+        m_inputGrid(         std::move( components.grid ) ),
+        m_eclipseProperties( std::move( deck ), m_tables, m_inputGrid ),
+        m_simulationConfig(  m_eclipseConfig.getInitConfig().restartRequested(), deck, m_eclipseProperties ),
+        m_transMult(         GridDims(deck), deck, m_eclipseProperties )
+    {
+        initState(deck);
+    }
+
+
+    EclipseState::EclipseState(const EclipseState& previous,
+                               const Deck& deck,
+                               const std::set<std::string>& changedKeywords,
+                               const ParseContext& parseContext) :
+        EclipseState( previous, deck, parseContext,
+                      affectedComponents( previous, deck, changedKeywords ) )
+    {}
+
+
+    EclipseState::EclipseState(const EclipseState& previous,
+                               const Deck& deck,
+                               const ParseContext& parseContext,
+                               int rebuild) :
+        m_tables(            (rebuild & TableComponent) ? TableManager( deck ) : previous.m_tables ),
+        m_runspec(           deck ),
+        m_eclipseConfig(     (rebuild & ConfigComponent) ? EclipseConfig( deck, parseContext ) : previous.m_eclipseConfig ),
+        m_deckUnitSystem(    deck.getActiveUnitSystem() ),
+        m_inputNnc(          deck ),
+        m_inputEditNnc(      deck ),
+        m_inputGrid(         (rebuild & GridComponent) ? EclipseGrid( deck, nullptr ) : previous.m_inputGrid ),
+        m_eclipseProperties( deck, m_tables, m_inputGrid ),
+        m_simulationConfig(  m_eclipseConfig.getInitConfig().restartRequested(), deck, m_eclipseProperties ),
+        m_transMult(         GridDims(deck), deck, m_eclipseProperties )
+    {
+        initState(deck);
+    }
+
+
+    /*
+      Keywords in the RUNSPEC section, and grid keywords which are
+      neither grid properties nor operations on them, can change the
+      dimensions and the geometry of the grid; they require a complete
+      rebuild. The sections of a changed keyword are looked up in the
+      new deck; a keyword which has been removed from the deck is only
+      known by name, and unless it is a grid property or one of the
+      property keywords below everything is rebuilt.
+    */
+    int EclipseState::affectedComponents(const EclipseState& previous,
+                                         const Deck& deck,
+                                         const std::set<std::string>& changedKeywords) {
+        static const std::set<std::string> propertyKeywords = {
+            "ADD", "ADDREG", "BOX", "COPY", "COPYREG", "EDITNNC", "ENDBOX", "EQUALREG",
+            "EQUALS", "FAULTS", "GRIDOPTS", "MAXVALUE", "MINVALUE", "MULTFLT", "MULTIPLY",
+            "MULTIREG", "MULTREGP", "MULTREGT", "NNC", "OPERATE", "OPERATER"
+        };
+
+        const auto isPropertyKeyword = [&previous](const std::string& name) {
+            return propertyKeywords.count( name ) > 0
+                || previous.m_eclipseProperties.supportsGridProperty( name );
+        };
+
+        std::map<std::string, std::set<std::string>> sections;
+        {
+            std::string section = "RUNSPEC";
+            for (const auto& keyword : deck) {
+                if (Section::isSectionName( keyword.name() ))
+                    section = keyword.name();
+                else if (changedKeywords.count( keyword.name() ))
+                    sections[keyword.name()].insert( section );
+            }
+        }
+
+        int rebuild = 0;
+        for (const auto& name : changedKeywords) {
+            const auto iter = sections.find( name );
+            if (iter == sections.end()) {
+                if (!isPropertyKeyword( name ))
+                    return AllComponents;
+
+                continue;
+            }
+
+            for (const auto& section : iter->second) {
+                if (section == "RUNSPEC")
+                    return AllComponents;
+
+                if ((section == "GRID" || section == "EDIT") && !isPropertyKeyword( name ))
+                    return AllComponents;
+
+                if (section == "PROPS")
+                    rebuild |= TableComponent;
+
+                if (section == "SOLUTION" || section == "SCHEDULE")
+                    rebuild |= ConfigComponent;
+            }
+        }
+
+        return rebuild;
+    }
+
+
+    void EclipseState::initState(const Deck& deck) {
         m_inputGrid.resetACTNUM(m_eclipseProperties.getIntGridProperty("ACTNUM").getData().data());
 
         if( this->runspec().phases().size() < 3 )
@@ -74,8 +237,81 @@ namespace Opm {
             m_title = boost::algorithm::join( itemValue, " " );
         }
 
+        initJFuncScaling();
+        m_eclipseProperties.compactProperties();
         initTransMult();
         initFaults(deck);
+
+        if (MemoryUsage::enabled())
+            MemoryUsage::log(this->memory_usage());
+    }
+
+    /*
+      One pass over PORO and the permeabilities, before the properties
+      are compacted; the cells are independent.
+    */
+    void EclipseState::initJFuncScaling() {
+        if (!m_tables.useJFunc())
+            return;
+
+        const auto& jfunc = m_tables.getJFunc();
+        const auto& poro = m_eclipseProperties.getDoubleGridProperty("PORO").getData();
+        const auto permData = [this](const std::string& keyword) {
+            return &m_eclipseProperties.getDoubleGridProperty(keyword).getData();
+        };
+
+        const std::vector<double>* perm1 = nullptr;
+        const std::vector<double>* perm2 = nullptr;
+        switch (jfunc.direction()) {
+        case JFunc::Direction::XY:
+            perm1 = permData("PERMX");
+            perm2 = permData("PERMY");
+            break;
+        case JFunc::Direction::X:
+            perm1 = permData("PERMX");
+            break;
+        case JFunc::Direction::Y:
+            perm1 = permData("PERMY");
+            break;
+        case JFunc::Direction::Z:
+            perm1 = permData("PERMZ");
+            break;
+        }
+
+        const double alpha = jfunc.alphaFactor();
+        const double beta = jfunc.betaFactor();
+        const long num_cells = static_cast<long>(poro.size());
+        m_jfuncScaling.resize(poro.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long cell = 0; cell < num_cells; ++cell) {
+            const double perm = perm2
+                ? 0.5 * ((*perm1)[cell] + (*perm2)[cell])
+                : (*perm1)[cell];
+
+            m_jfuncScaling[cell] = perm > 0
+                ? std::pow(poro[cell], alpha) / std::pow(perm, beta)
+                : 0;
+        }
+    }
+
+
+    const std::vector<double>& EclipseState::getJFuncScaling() const {
+        return m_jfuncScaling;
+    }
+
+
+    MemoryUsage EclipseState::memory_usage() const {
+        MemoryUsage usage("EclipseState", sizeof(*this) + MemoryUsage::heap(m_title));
+        usage.add(m_inputGrid.memory_usage());
+        usage.add(m_eclipseProperties.memory_usage());
+        usage.add(m_tables.memory_usage());
+        usage.add("NNC", MemoryUsage::heap(m_inputNnc.nncdata()) + MemoryUsage::heap(m_inputEditNnc.data()));
+        usage.add("JFUNC", MemoryUsage::heap(m_jfuncScaling));
+        usage.sort();
+        return usage;
     }
 
     const UnitSystem& EclipseState::getDeckUnitSystem() const {
@@ -202,8 +438,7 @@ namespace Opm {
 
 
     void EclipseState::setMULTFLT(const Section& section) {
-        for (size_t index=0; index < section.count("MULTFLT"); index++) {
-            const auto& faultsKeyword = section.getKeyword("MULTFLT" , index);
+        for (const auto& faultsKeyword : section.getKeywordRange("MULTFLT")) {
             for (auto iter = faultsKeyword.begin(); iter != faultsKeyword.end(); ++iter) {
 
                 const auto& faultRecord = *iter;
@@ -217,10 +452,9 @@ namespace Opm {
 
     void EclipseState::complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName) {
         OpmLog::error("The " + keywordName + " keyword must be unique in the deck. Ignoring all!");
-        auto keywords = deck.getKeywordList(keywordName);
-        for (size_t i = 0; i < keywords.size(); ++i) {
+        for (const auto& keyword : deck.getKeywordRange(keywordName)) {
             std::string msg = "Ambiguous keyword "+keywordName+" defined here";
-            OpmLog::error(Log::fileMessage(keywords[i]->getFileName(), keywords[i]->getLineNumber(), msg));
+            OpmLog::error(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
         }
     }
 
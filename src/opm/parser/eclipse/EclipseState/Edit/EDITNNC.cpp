@@ -32,10 +32,9 @@ bool isNeighbor(const std::array<size_t, 3>& ijk1, const std::array<size_t, 3>&
     return false;
 }
 
-void readEditNncs(const std::vector< const DeckKeyword* >& editNncsKw, std::vector<NNCdata>& editNncs, const GridDims& gridDims)
+void readEditNncs(const DeckView::KeywordRange& editNncsKw, std::vector<NNCdata>& editNncs, const GridDims& gridDims)
 {
-    for (size_t idx_nnc = 0; idx_nnc<editNncsKw.size(); ++idx_nnc) {
-        const auto& nnc = *editNncsKw[idx_nnc];
+    for (const auto& nnc : editNncsKw) {
         editNncs.reserve(editNncs.size()+nnc.size());
         for (size_t i = 0; i < nnc.size(); ++i) {
             std::array<size_t, 3> ijk1;
@@ -70,7 +69,7 @@ void readEditNncs(const std::vector< const DeckKeyword* >& editNncsKw, std::vect
 EDITNNC::EDITNNC(const Deck& deck)
 {
     GridDims gridDims(deck);
-    const auto& tmpEditNncs = deck.getKeywordList<ParserKeywords::EDITNNC>();
+    const auto tmpEditNncs = deck.getKeywordRange<ParserKeywords::EDITNNC>();
     readEditNncs(tmpEditNncs, m_editnnc, gridDims);
     auto compare = [](const NNCdata& d1, const NNCdata& d2)
         { return d1.cell1 < d2.cell1 ||
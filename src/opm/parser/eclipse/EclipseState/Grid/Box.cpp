@@ -62,7 +62,7 @@ namespace Opm {
         m_stride[2] = m_dims[0] * m_dims[1];
 
         m_isGlobal = true;
-        initIndexList();
+        initRanges();
     }
 
 
@@ -88,7 +88,7 @@ namespace Opm {
         else
             m_isGlobal = false;
 
-        initIndexList();
+        initRanges();
     }
 
 
@@ -117,41 +117,100 @@ namespace Opm {
 
 
 
-    std::vector<size_t>::const_iterator Box::begin() const {
-        return m_indexList.begin();
+    Box::const_iterator Box::begin() const {
+        return const_iterator( *this, 0 );
     }
 
-    std::vector<size_t>::const_iterator Box::end() const {
-        return m_indexList.end();
+    Box::const_iterator Box::end() const {
+        return const_iterator( *this, numRanges() );
     }
 
 
-    const std::vector<size_t>& Box::getIndexList() const {
-        return m_indexList;
+    std::vector<size_t> Box::getIndexList() const {
+        return std::vector<size_t>( begin(), end() );
     }
 
 
-    void Box::initIndexList() {
-        m_indexList.resize( size() );
+    void Box::initRanges() {
+        m_rangeSize = m_dims[0];
+        m_rowsPerRange = 1;
 
-        size_t ii,ij,ik;
-        size_t l = 0;
+        if (m_dims[0] * m_stride[0] == m_stride[1]) {
+            m_rangeSize *= m_dims[1];
+            m_rowsPerRange *= m_dims[1];
 
-        for (ik=0; ik < m_dims[2]; ik++) {
-            size_t k = ik + m_offset[2];
-            for (ij=0; ij < m_dims[1]; ij++) {
-                size_t j = ij + m_offset[1];
-                for (ii=0; ii < m_dims[0]; ii++) {
-                    size_t i = ii + m_offset[0];
-                    size_t g = i * m_stride[0] + j*m_stride[1] + k*m_stride[2];
-
-                    m_indexList[l] = g;
-                    l++;
-                }
+            if (m_dims[1] * m_stride[1] == m_stride[2]) {
+                m_rangeSize *= m_dims[2];
+                m_rowsPerRange *= m_dims[2];
             }
         }
     }
 
+
+    size_t Box::numRanges() const {
+        if (m_rangeSize == 0)
+            return 0;
+
+        return size() / m_rangeSize;
+    }
+
+
+    size_t Box::rangeSize() const {
+        return m_rangeSize;
+    }
+
+
+    size_t Box::rangeBegin(size_t range) const {
+        const size_t row = range * m_rowsPerRange;
+        const size_t j = row % m_dims[1] + m_offset[1];
+        const size_t k = row / m_dims[1] + m_offset[2];
+
+        return m_offset[0] * m_stride[0] + j * m_stride[1] + k * m_stride[2];
+    }
+
+
+    Box::const_iterator::const_iterator(const Box& box, size_t range) :
+        m_box( &box ),
+        m_range( range ),
+        m_begin( range < box.numRanges() ? box.rangeBegin( range ) : 0 )
+    { }
+
+
+    size_t Box::const_iterator::operator*() const {
+        return m_begin + m_offset;
+    }
+
+
+    Box::const_iterator& Box::const_iterator::operator++() {
+        m_offset++;
+        if (m_offset == m_box->rangeSize()) {
+            m_offset = 0;
+            m_range++;
+            if (m_range < m_box->numRanges())
+                m_begin = m_box->rangeBegin( m_range );
+        }
+
+        return *this;
+    }
+
+
+    Box::const_iterator Box::const_iterator::operator++(int) {
+        const_iterator copy( *this );
+        ++(*this);
+        return copy;
+    }
+
+
+    bool Box::const_iterator::operator==(const const_iterator& other) const {
+        return m_range == other.m_range && m_offset == other.m_offset;
+    }
+
+
+    bool Box::const_iterator::operator!=(const const_iterator& other) const {
+        return !(*this == other);
+    }
+
+
     bool Box::equal(const Box& other) const {
 
         if (size() != other.size())
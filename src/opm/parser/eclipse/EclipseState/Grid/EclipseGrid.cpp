@@ -20,11 +20,14 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <algorithm>
 #include <iostream>
 #include <tuple>
 #include <functional>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
+#include <opm/common/utility/FirstTouch.hpp>
 #include <opm/common/utility/numeric/calculateCellVol.hpp>
 
 #include <opm/parser/eclipse/Deck/Section.hpp>
@@ -54,6 +57,55 @@
 
 namespace Opm {
 
+namespace {
+
+    double cornerPointVolume( const ecl_grid_type * grid, size_t globalIndex ) {
+        std::vector<double> x(8,0);
+        std::vector<double> y(8,0);
+        std::vector<double> z(8,0);
+        for (int i=0; i < 8; i++)
+            ecl_grid_get_cell_corner_xyz1(grid, static_cast<int>(globalIndex), i, &x[i], &y[i], &z[i]);
+
+        return calculateCellVol(x,y,z);
+    }
+
+    /*
+      The volumes of the cells [first, last), gathered corner by corner
+      for the batched volume calculation.
+    */
+    void cornerPointVolumes( const ecl_grid_type * grid, size_t first, size_t last, double * volumes ) {
+        const size_t num_cells = last - first;
+        std::vector<double> x(8 * num_cells);
+        std::vector<double> y(8 * num_cells);
+        std::vector<double> z(8 * num_cells);
+        for (size_t cell = 0; cell < num_cells; cell++) {
+            for (size_t i = 0; i < 8; i++) {
+                const size_t pos = i * num_cells + cell;
+                ecl_grid_get_cell_corner_xyz1(grid, static_cast<int>(first + cell), static_cast<int>(i), &x[pos], &y[pos], &z[pos]);
+            }
+        }
+
+        calculateCellVol(num_cells, x.data(), y.data(), z.data(), volumes + first);
+    }
+
+    /*
+      Evaluate op(globalIndex) for all cells; with OpenMP the cells are
+      split in contiguous blocks over the threads. The ecl_grid accessors
+      used by the bulk geometry functions only touch the cell in question,
+      so the cells can be processed concurrently.
+    */
+    template< typename F >
+    void forAllCells( size_t size, F op ) {
+        const long num_cells = static_cast< long >( size );
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long g = 0; g < num_cells; ++g)
+            op( static_cast< size_t >( g ) );
+    }
+
+}
+
 
     EclipseGrid::EclipseGrid(std::array<int, 3>& dims ,
 			     const std::vector<double>& coord ,
@@ -64,10 +116,10 @@ namespace Opm {
 	  m_minpvMode(MinpvMode::ModeEnum::Inactive),
 	  m_pinch("PINCH"),
 	  m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-	  m_multzMode(PinchMode::ModeEnum::TOP),
-          volume_cache(dims[0] * dims[1] * dims[2], -1.0)
+	  m_multzMode(PinchMode::ModeEnum::TOP)
     {
         initCornerPointGrid( dims, coord , zcorn , actnum , mapaxes );
+        initActiveIndex();
     }
 
 
@@ -93,7 +145,7 @@ namespace Opm {
         m_ny = ecl_grid_get_ny( c_ptr() );
         m_nz = ecl_grid_get_nz( c_ptr() );
 
-        volume_cache.resize(m_nx * m_ny * m_nz, -1.0);
+        initActiveIndex();
     }
 
 
@@ -104,9 +156,9 @@ namespace Opm {
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
           m_multzMode(PinchMode::ModeEnum::TOP),
-          volume_cache(nx * ny * nz, -1.0),
           m_grid( ecl_grid_alloc_rectangular(nx, ny, nz, dx, dy, dz, NULL) )
     {
+        initActiveIndex();
     }
 
     EclipseGrid::EclipseGrid(const EclipseGrid& src, const double* zcorn , const std::vector<int>& actnum)
@@ -115,11 +167,11 @@ namespace Opm {
           m_minpvMode( src.m_minpvMode ),
           m_pinch( src.m_pinch ),
           m_pinchoutMode( src.m_pinchoutMode ),
-          m_multzMode( src.m_multzMode ),
-          volume_cache(src.volume_cache.size(), -1.0)
+          m_multzMode( src.m_multzMode )
     {
         const int * actnum_data = (actnum.empty()) ? nullptr : actnum.data();
         m_grid.reset( ecl_grid_alloc_processed_copy( src.c_ptr(), zcorn , actnum_data ));
+        initActiveIndex();
     }
 
 
@@ -168,12 +220,14 @@ namespace Opm {
           m_minpvMode(MinpvMode::ModeEnum::Inactive),
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-          m_multzMode(PinchMode::ModeEnum::TOP),
-          volume_cache(m_nx * m_ny * m_nz, -1.0)
+          m_multzMode(PinchMode::ModeEnum::TOP)
     {
+        PhaseTimer::Scope phase("EclipseGrid");
+        PhaseTimer::count("cells", this->getCartesianSize());
 
         const std::array<int, 3> dims = getNXYZ();
         initGrid(dims, deck);
+        initActiveIndex();
 
         if (actnum != nullptr)
             resetACTNUM(actnum);
@@ -252,24 +306,29 @@ namespace Opm {
         return activeIndex( getGlobalIndex( i,j,k ));
     }
 
-    size_t EclipseGrid::activeIndex(size_t globalIndex) const {
-        int active_index = ecl_grid_get_active_index1( m_grid.get() , globalIndex );
-        if (active_index < 0)
-            throw std::invalid_argument("Input argument does not correspond to an active cell");
-        return static_cast<size_t>( active_index );
+    size_t EclipseGrid::getGlobalIndex(size_t i, size_t j, size_t k) const {
+        return GridDims::getGlobalIndex(i,j,k);
     }
 
-    /**
-       Observe: the input argument is assumed to be in the space
-       [0,num_active).
-    */
-    size_t EclipseGrid::getGlobalIndex(size_t active_index) const {
-        int global_index = ecl_grid_get_global_index1A( m_grid.get() , active_index );
-        return static_cast<size_t>(global_index);
+    std::vector<size_t> EclipseGrid::activeIndex(const std::vector<std::array<int, 3>>& ijk) const {
+        auto indices = getGlobalIndices( ijk );
+        for (auto& index : indices) {
+            const int active_index = this->m_activeIndex[ index ];
+            if (active_index < 0)
+                throw std::invalid_argument("Input argument does not correspond to an active cell");
+            index = static_cast<size_t>( active_index );
+        }
+        return indices;
     }
 
-    size_t EclipseGrid::getGlobalIndex(size_t i, size_t j, size_t k) const {
-        return GridDims::getGlobalIndex(i,j,k);
+    std::vector<std::array<int, 3>> EclipseGrid::getActiveIJK(const std::vector<size_t>& activeIndices) const {
+        std::vector<size_t> globalIndices( activeIndices.size() );
+        for (size_t index = 0; index < activeIndices.size(); index++) {
+            if (activeIndices[ index ] >= this->activeMap.size())
+                throw std::invalid_argument("input index above valid range");
+            globalIndices[ index ] = static_cast<size_t>( this->activeMap[ activeIndices[ index ] ] );
+        }
+        return getIJK( globalIndices );
     }
 
 
@@ -711,15 +770,12 @@ namespace Opm {
 
 
     void EclipseGrid::scatterDim(const std::array<int, 3>& dims , size_t dim , const std::vector<double>& DV , std::vector<double>& D) {
-        int index[3];
-        for (index[2] = 0;  index[2] < dims[2]; index[2]++) {
-            for (index[1] = 0; index[1] < dims[1]; index[1]++) {
-                for (index[0] = 0;  index[0] < dims[0]; index[0]++) {
-                    size_t globalIndex = index[2] * dims[1] * dims[0] + index[1] * dims[0] + index[0];
-                    D[globalIndex] = DV[ index[dim] ];
-                }
-            }
-        }
+        const size_t nx = dims[0];
+        const size_t ny = dims[1];
+        forAllCells( static_cast< size_t >( dims[0] ) * dims[1] * dims[2], [&]( size_t globalIndex ) {
+            const size_t index[3] = { globalIndex % nx, (globalIndex / nx) % ny, globalIndex / (nx * ny) };
+            D[globalIndex] = DV[ index[dim] ];
+        });
     }
 
     const ecl_grid_type * EclipseGrid::c_ptr() const {
@@ -727,6 +783,28 @@ namespace Opm {
     }
 
 
+    MemoryUsage EclipseGrid::memory_usage() const {
+        MemoryUsage usage( "EclipseGrid", sizeof( *this ) + MemoryUsage::heap( m_minpvVector ) );
+        usage.add( "active cells", MemoryUsage::heap( m_activeIndex )
+                                 + MemoryUsage::heap( m_cellActive )
+                                 + MemoryUsage::heap( activeMap ) );
+
+        const auto& cache = this->m_geometry;
+        size_t geometry = 0;
+        if (cache.volumes_ready.load( std::memory_order_acquire ))
+            geometry += MemoryUsage::heap( cache.volumes );
+
+        for (size_t dim = 0; dim < 3; dim++) {
+            if (cache.centers_ready.load( std::memory_order_acquire ))
+                geometry += MemoryUsage::heap( cache.centers[dim] );
+            if (cache.dims_ready.load( std::memory_order_acquire ))
+                geometry += MemoryUsage::heap( cache.dims[dim] );
+        }
+        usage.add( "geometry", geometry );
+        return usage;
+    }
+
+
     bool EclipseGrid::equal(const EclipseGrid& other) const {
         bool status = (m_pinch.equal( other.m_pinch ) && (ecl_grid_compare( c_ptr() , other.c_ptr() , true , false , false )) && (m_minpvMode == other.getMinpvMode()));
         if(m_minpvMode!=MinpvMode::ModeEnum::Inactive){
@@ -736,38 +814,75 @@ namespace Opm {
     }
 
 
-    size_t EclipseGrid::getNumActive( ) const {
-        return static_cast<size_t>(ecl_grid_get_nactive( c_ptr() ));
-    }
-
-    bool EclipseGrid::allActive( ) const {
-        return (getNumActive() == getCartesianSize());
-    }
-
-    bool EclipseGrid::cellActive( size_t globalIndex ) const {
-        assertGlobalIndex( globalIndex );
-        return ecl_grid_cell_active1( c_ptr() , static_cast<int>(globalIndex));
-    }
-
     bool EclipseGrid::cellActive( size_t i , size_t j , size_t k ) const {
         assertIJK(i,j,k);
-        return ecl_grid_cell_active3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return this->m_cellActive[ getGlobalIndex(i,j,k) ] != 0;
     }
 
 
     double EclipseGrid::getCellVolume(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        if (volume_cache[globalIndex] < 0.0) {
-            // Calculate cell volume and put it in the cache.
-            std::vector<double> x(8,0);
-            std::vector<double> y(8,0);
-            std::vector<double> z(8,0);
-            for (int i=0; i < 8; i++) {
-                ecl_grid_get_cell_corner_xyz1(c_ptr(), static_cast<int>(globalIndex), i, &x[i], &y[i], &z[i]);
-            }
-            volume_cache[globalIndex] = calculateCellVol(x,y,z);
-        }
-        return volume_cache[globalIndex];
+        if (this->m_geometry.volumes_ready.load( std::memory_order_acquire ))
+            return this->m_geometry.volumes[globalIndex];
+
+        return cornerPointVolume( c_ptr(), globalIndex );
+    }
+
+    const std::vector<double>& EclipseGrid::getCellVolumes() const {
+        auto& cache = this->m_geometry;
+        std::call_once( cache.volumes_built, [this, &cache]() {
+            const auto* grid = c_ptr();
+            auto& volumes = cache.volumes;
+            volumes = FirstTouch::make< double >( getCartesianSize() );
+
+            const size_t block_size = 256;
+            const size_t num_blocks = (volumes.size() + block_size - 1) / block_size;
+            forAllCells( num_blocks, [grid, &volumes, block_size]( size_t block ) {
+                const size_t first = block * block_size;
+                const size_t last = std::min( volumes.size(), first + block_size );
+                cornerPointVolumes( grid, first, last, volumes.data() );
+            });
+            cache.volumes_ready.store( true, std::memory_order_release );
+        });
+        return cache.volumes;
+    }
+
+    const std::array< std::vector<double>, 3 >& EclipseGrid::getCellCenters() const {
+        auto& cache = this->m_geometry;
+        std::call_once( cache.centers_built, [this, &cache]() {
+            const auto* grid = c_ptr();
+            auto& centers = cache.centers;
+            for (auto& c : centers)
+                c = FirstTouch::make< double >( getCartesianSize() );
+
+            forAllCells( getCartesianSize(), [grid, &centers]( size_t g ) {
+                ecl_grid_get_xyz1( grid, static_cast<int>(g), &centers[0][g], &centers[1][g], &centers[2][g] );
+            });
+            cache.centers_ready.store( true, std::memory_order_release );
+        });
+        return cache.centers;
+    }
+
+    const std::vector<double>& EclipseGrid::getCellDepths() const {
+        return getCellCenters()[2];
+    }
+
+    const std::array< std::vector<double>, 3 >& EclipseGrid::getCellDimensions() const {
+        auto& cache = this->m_geometry;
+        std::call_once( cache.dims_built, [this, &cache]() {
+            const auto* grid = c_ptr();
+            auto& dims = cache.dims;
+            for (auto& d : dims)
+                d = FirstTouch::make< double >( getCartesianSize() );
+
+            forAllCells( getCartesianSize(), [grid, &dims]( size_t g ) {
+                dims[0][g] = ecl_grid_get_cell_dx1( grid, g );
+                dims[1][g] = ecl_grid_get_cell_dy1( grid, g );
+                dims[2][g] = ecl_grid_get_cell_thickness1( grid, g );
+            });
+            cache.dims_ready.store( true, std::memory_order_release );
+        });
+        return cache.dims;
     }
 
 
@@ -778,17 +893,24 @@ namespace Opm {
 
     double EclipseGrid::getCellThicknes(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
-        return ecl_grid_get_cell_thickness3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return getCellThicknes( getGlobalIndex( i,j,k ));
     }
 
     double EclipseGrid::getCellThicknes(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (this->m_geometry.dims_ready.load( std::memory_order_acquire ))
+            return this->m_geometry.dims[2][globalIndex];
+
         return ecl_grid_get_cell_thickness1( c_ptr() , static_cast<int>(globalIndex));
     }
 
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (this->m_geometry.dims_ready.load( std::memory_order_acquire )) {
+            const auto& dims = this->m_geometry.dims;
+            return std::array<double, 3>{{ dims[0][globalIndex], dims[1][globalIndex], dims[2][globalIndex] }};
+        }
         {
             double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
             double dy = ecl_grid_get_cell_dy1( c_ptr() , globalIndex);
@@ -800,18 +922,15 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
-        {
-            size_t globalIndex = getGlobalIndex( i,j,k );
-            double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
-            double dy = ecl_grid_get_cell_dy1( c_ptr() , globalIndex);
-            double dz = ecl_grid_get_cell_thickness1( c_ptr() , globalIndex);
-
-            return std::array<double,3>{ {dx , dy , dz }};
-        }
+        return getCellDims( getGlobalIndex( i,j,k ));
     }
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (this->m_geometry.centers_ready.load( std::memory_order_acquire )) {
+            const auto& centers = this->m_geometry.centers;
+            return std::array<double, 3>{{ centers[0][globalIndex], centers[1][globalIndex], centers[2][globalIndex] }};
+        }
         {
             double x,y,z;
             ecl_grid_get_xyz1( c_ptr() , static_cast<int>(globalIndex) , &x , &y , &z);
@@ -854,22 +973,21 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
-        {
-            double x,y,z;
-            ecl_grid_get_xyz3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k), &x , &y , &z);
-            return std::array<double, 3>{{x,y,z}};
-        }
+        return getCellCenter( getGlobalIndex( i,j,k ));
     }
 
     double EclipseGrid::getCellDepth(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (this->m_geometry.centers_ready.load( std::memory_order_acquire ))
+            return this->m_geometry.centers[2][globalIndex];
+
         return ecl_grid_get_cdepth1( c_ptr() , static_cast<int>(globalIndex));
     }
 
 
     double EclipseGrid::getCellDepth(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
-        return ecl_grid_get_cdepth3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return getCellDepth( getGlobalIndex( i,j,k ));
     }
 
 
@@ -908,11 +1026,21 @@ namespace Opm {
     }
 
 
+    /*
+      The connections are passed to ERT as two plain index arrays in one
+      call; ERT numbers them by their position, as in NNC::nncdata().
+    */
     void EclipseGrid::addNNC(const NNC& nnc) {
-        int idx = 0;
+        const auto& nncdata = nnc.nncdata();
+        std::vector< int > cell1( nncdata.size() );
+        std::vector< int > cell2( nncdata.size() );
+        for (size_t idx = 0; idx < nncdata.size(); idx++) {
+            cell1[idx] = nncdata[idx].cell1;
+            cell2[idx] = nncdata[idx].cell2;
+        }
+
         auto* ecl_grid = const_cast< ecl_grid_type* >( this->c_ptr() );
-        for (const NNCdata& n : nnc.nncdata())
-            ecl_grid_add_self_nnc( ecl_grid, n.cell1, n.cell2, idx++);
+        ecl_grid_add_self_nnc_list( ecl_grid, cell1.data(), cell2.data(), nncdata.size() );
     }
 
 
@@ -923,28 +1051,29 @@ namespace Opm {
 
 
 
-    const std::vector<int>& EclipseGrid::getActiveMap() const {
-        if( !this->activeMap.empty() ) return this->activeMap;
+    void EclipseGrid::initActiveIndex() {
+        const auto size = this->getCartesianSize();
+        const auto* grid = c_ptr();
 
-        this->activeMap.resize( this->getNumActive() );
-        const auto size = int(this->getCartesianSize());
+        this->m_activeIndex.resize( size );
+        this->m_cellActive.resize( size );
+        this->activeMap.assign( ecl_grid_get_nactive( grid ), 0 );
 
-        for( int global_index = 0; global_index < size; global_index++) {
+        for (size_t global_index = 0; global_index < size; global_index++) {
             // Using the low level C function to get the active index, because the C++
             // version will throw for inactive cells.
-            int active_index = ecl_grid_get_active_index1( m_grid.get() , global_index );
+            const int g = static_cast<int>( global_index );
+            const int active_index = ecl_grid_get_active_index1( grid , g );
+            this->m_activeIndex[ global_index ] = active_index;
+            this->m_cellActive[ global_index ] = ecl_grid_cell_active1( grid , g ) ? 1 : 0;
             if (active_index >= 0)
-                this->activeMap[ active_index ] = global_index;
+                this->activeMap[ active_index ] = g;
         }
-
-        return this->activeMap;
     }
 
     void EclipseGrid::resetACTNUM( const int * actnum) {
         ecl_grid_reset_actnum( m_grid.get() , actnum );
-        /* re-build the active map cache */
-        this->activeMap.clear();
-        this->getActiveMap();
+        initActiveIndex();
     }
 
     ZcornMapper EclipseGrid::zcornMapper() const {
@@ -989,66 +1118,83 @@ namespace Opm {
         return index(i,j,k,c);
     }
 
-    bool ZcornMapper::validZCORN( const std::vector<double>& zcorn) const {
-        int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
-        for (size_t j=0; j < this->dims[1]; j++)
-            for (size_t i=0; i < this->dims[0]; i++)
-                for (size_t c=0; c < 4; c++)
-                    for (size_t k=0; k < this->dims[2]; k++) {
-                        /* Between cells */
-                        if (k > 0) {
-                            size_t index1 = this->index(i,j,k-1,c+4);
-                            size_t index2 = this->index(i,j,k,c);
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0)
-                                return false;
-                        }
+    /*
+      The corners of a cell are only compared with the corners above and
+      below them on the same pillar, so every corner column - one of the
+      four corners of a cell column - is checked and fixed up on its own,
+      and the columns are processed in parallel.
+    */
+    size_t ZcornMapper::columnStart(size_t column) const {
+        const size_t c = column % 4;
+        const size_t i = (column / 4) % this->dims[0];
+        const size_t j = (column / 4) / this->dims[0];
 
-                        /* In cell */
-                        {
-                            size_t index1 = this->index(i,j,k,c);
-                            size_t index2 = this->index(i,j,k,c+4);
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0)
-                                return false;
-                        }
-                    }
+        return i*stride[0] + j*stride[1] + cell_shift[c];
+    }
 
-        return true;
+    bool ZcornMapper::validZCORN( const std::vector<double>& zcorn) const {
+        const int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
+        const size_t upper = cell_shift[4];
+        const long num_columns = static_cast< long >( 4 * this->dims[0] * this->dims[1] );
+        bool valid = true;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(&&:valid)
+#endif
+        for (long column = 0; column < num_columns; column++) {
+            if (!valid)
+                continue;
+
+            const size_t start = this->columnStart( column );
+            for (size_t k=0; k < this->dims[2] && valid; k++) {
+                const size_t bottom = start + k*stride[2];
+
+                /* Between cells */
+                if (k > 0 && (zcorn[bottom] - zcorn[bottom - stride[2] + upper]) * sign < 0)
+                    valid = false;
+
+                /* In cell */
+                if ((zcorn[bottom + upper] - zcorn[bottom]) * sign < 0)
+                    valid = false;
+            }
+        }
+
+        return valid;
     }
 
 
 
 
     size_t ZcornMapper::fixupZCORN( std::vector<double>& zcorn) {
-        int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
+        const int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
+        const size_t upper = cell_shift[4];
+        const long num_columns = static_cast< long >( 4 * this->dims[0] * this->dims[1] );
         size_t cells_adjusted = 0;
 
-        for (size_t k=0; k < this->dims[2]; k++)
-            for (size_t j=0; j < this->dims[1]; j++)
-                for (size_t i=0; i < this->dims[0]; i++)
-                    for (size_t c=0; c < 4; c++) {
-                        /* Cell to cell */
-                        if (k > 0) {
-                            size_t index1 = this->index(i,j,k-1,c+4);
-                            size_t index2 = this->index(i,j,k,c);
-
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
-                                zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
-                            }
-                        }
-
-
-                        /* Cell internal */
-                        {
-                            size_t index1 = this->index(i,j,k,c);
-                            size_t index2 = this->index(i,j,k,c+4);
-
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
-                                zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
-                            }
-                        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:cells_adjusted)
+#endif
+        for (long column = 0; column < num_columns; column++) {
+            const size_t start = this->columnStart( column );
+            for (size_t k=0; k < this->dims[2]; k++) {
+                const size_t bottom = start + k*stride[2];
+
+                /* Cell to cell */
+                if (k > 0) {
+                    const size_t above = bottom - stride[2] + upper;
+                    if ((zcorn[bottom] - zcorn[above]) * sign < 0 ) {
+                        zcorn[bottom] = zcorn[above];
+                        cells_adjusted++;
                     }
+                }
+
+                /* Cell internal */
+                if ((zcorn[bottom + upper] - zcorn[bottom]) * sign < 0 ) {
+                    zcorn[bottom + upper] = zcorn[bottom];
+                    cells_adjusted++;
+                }
+            }
+        }
         return cells_adjusted;
     }
 
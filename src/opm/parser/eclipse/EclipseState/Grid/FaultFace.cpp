@@ -47,12 +47,7 @@ namespace Opm {
                 throw std::invalid_argument("When the face is in Z direction we must have K1 == K2");
 
 
-        for (size_t k=K1; k <= K2; k++)
-            for (size_t j=J1; j <= J2; j++)
-                for (size_t i=I1; i <= I2; i++) {
-                    size_t globalIndex = i + j*nx + k*nx*ny;
-                    m_indexList.push_back( globalIndex );
-                }
+        m_box = Box( nx, ny, nz, I1, I2, J1, J2, K1, K2 );
     }
 
 
@@ -65,12 +60,16 @@ namespace Opm {
     }
 
 
-    std::vector<size_t>::const_iterator FaultFace::begin() const {
-        return m_indexList.begin();
+    Box::const_iterator FaultFace::begin() const {
+        return m_box.begin();
     }
 
-    std::vector<size_t>::const_iterator FaultFace::end() const {
-        return m_indexList.end();
+    Box::const_iterator FaultFace::end() const {
+        return m_box.end();
+    }
+
+    const Box& FaultFace::getBox() const {
+        return m_box;
     }
 
 
@@ -80,10 +79,7 @@ namespace Opm {
 
     bool FaultFace::operator==( const FaultFace& rhs ) const {
         return this->m_faceDir == rhs.m_faceDir
-            && this->m_indexList.size() == rhs.m_indexList.size()
-            && std::equal( this->m_indexList.begin(),
-                           this->m_indexList.end(),
-                           rhs.m_indexList.begin() );
+            && this->m_box.equal( rhs.m_box );
     }
 
     bool FaultFace::operator!=( const FaultFace& rhs ) const {
@@ -18,6 +18,7 @@
 */
 
 #include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 
@@ -33,6 +34,45 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/S.hpp> // SPECGRID
 
 namespace Opm {
+
+namespace {
+
+    /*
+      Division by a divisor which is the same for a whole batch, after
+      Lemire, Kaser and Kurz, "Faster remainder by direct computation":
+      with c = ceil(2^64 / d) the quotient of a 32 bit numerator n is the
+      upper word of the 128 bit product c * n. Grids with more than 2^32
+      cells, and compilers without a 128 bit integer, use the division
+      instruction.
+    */
+    class invariant_divisor {
+    public:
+        invariant_divisor(std::size_t divisor, std::size_t max_numerator) :
+            d(divisor)
+        {
+#ifdef __SIZEOF_INT128__
+            if (divisor > 1 && max_numerator <= UINT32_MAX)
+                this->c = UINT64_MAX / divisor + 1;
+#else
+            (void) max_numerator;
+#endif
+        }
+
+        std::size_t quotient(std::size_t n) const {
+#ifdef __SIZEOF_INT128__
+            if (this->c != 0)
+                return static_cast<std::size_t>((static_cast<unsigned __int128>(this->c) * n) >> 64);
+#endif
+            return n / this->d;
+        }
+
+    private:
+        std::size_t d;
+        std::uint64_t c = 0;
+    };
+
+}
+
     GridDims::GridDims(std::array<int, 3> xyz) :
                     GridDims(xyz[0], xyz[1], xyz[2])
     {
@@ -103,6 +143,47 @@ namespace Opm {
         return r;
     }
 
+    std::vector<size_t> GridDims::getGlobalIndices(const std::vector<std::array<int, 3>>& ijk) const {
+        const size_t nx = getNX();
+        const size_t ny = getNY();
+        const size_t nz = getNZ();
+        const size_t nxy = nx * ny;
+
+        std::vector<size_t> globalIndices(ijk.size());
+        for (size_t index = 0; index < ijk.size(); index++) {
+            const auto& cell = ijk[index];
+            const size_t i = static_cast<size_t>(cell[0]);
+            const size_t j = static_cast<size_t>(cell[1]);
+            const size_t k = static_cast<size_t>(cell[2]);
+            if (i >= nx || j >= ny || k >= nz)
+                throw std::invalid_argument("input index above valid range");
+
+            globalIndices[index] = i + j * nx + k * nxy;
+        }
+        return globalIndices;
+    }
+
+    std::vector<std::array<int, 3>> GridDims::getIJK(const std::vector<size_t>& globalIndices) const {
+        const size_t nx = getNX();
+        const size_t nxy = nx * getNY();
+        const size_t size = getCartesianSize();
+        const invariant_divisor layer(nxy, size);
+        const invariant_divisor row(nx, size);
+
+        std::vector<std::array<int, 3>> ijk(globalIndices.size());
+        for (size_t index = 0; index < globalIndices.size(); index++) {
+            const size_t globalIndex = globalIndices[index];
+            if (globalIndex >= size)
+                throw std::invalid_argument("input index above valid range");
+
+            const size_t k = layer.quotient(globalIndex);
+            const size_t plane = globalIndex - k * nxy;
+            const size_t j = row.quotient(plane);
+            ijk[index] = { { int(plane - j * nx), int(j), int(k) } };
+        }
+        return ijk;
+    }
+
     size_t GridDims::getCartesianSize() const {
         return m_nx * m_ny * m_nz;
     }
@@ -17,8 +17,14 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
@@ -50,6 +56,95 @@ namespace Opm {
         return keyword[0] == 'F' && keyword[1] == 'I' && keyword[2] == 'P';
     }
 
+    static void apply( const GridPropertyOperation& operation ) {
+        if (operation.apply)
+            operation.apply();
+    }
+
+
+    bool GridPropertyOperations::fits( const GridPropertyOperation& operation ) const {
+        const auto contains = []( const std::vector< const void* >& properties, const void* property ) {
+            return std::find( properties.begin(), properties.end(), property ) != properties.end();
+        };
+
+        if (!operation.target)
+            return true;
+
+        return !contains( this->targets, operation.target )
+            && !contains( this->sources, operation.target )
+            && !(operation.source && contains( this->targets, operation.source ));
+    }
+
+
+    void GridPropertyOperations::add( GridPropertyOperation operation ) {
+        if (!operation.target)
+            return;
+
+        this->targets.push_back( operation.target );
+        if (operation.source)
+            this->sources.push_back( operation.source );
+
+        this->cells += operation.cells;
+        this->operations.push_back( std::move( operation ) );
+    }
+
+
+    /*
+      The operations are dealt out to the threads round robin; below
+      minCells cells in all they are applied on the calling thread, the
+      bulk operations of one property are parallel themselves when the
+      box is large, see GridProperty.
+    */
+    void GridPropertyOperations::apply() {
+        const size_t minCells = 1 << 16;
+        const size_t numThreads = std::min( this->operations.size(),
+                                            std::max( size_t{1}, size_t{std::thread::hardware_concurrency()} ) );
+
+        if (numThreads < 2 || this->cells < minCells) {
+            for (const auto& operation : this->operations)
+                Opm::apply( operation );
+        } else {
+            const auto run = [this, numThreads]( size_t first ) {
+                for (size_t index = first; index < this->operations.size(); index += numThreads)
+                    Opm::apply( this->operations[ index ] );
+            };
+
+            std::vector< std::future< void > > tasks;
+            for (size_t thread = 1; thread < numThreads; ++thread)
+                tasks.push_back( std::async( std::launch::async, run, thread ) );
+
+            std::exception_ptr error;
+            try {
+                run( 0 );
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            for (auto& task : tasks) {
+                try {
+                    task.get();
+                } catch (...) {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+
+            if (error) {
+                this->operations.clear();
+                this->targets.clear();
+                this->sources.clear();
+                this->cells = 0;
+                std::rethrow_exception( error );
+            }
+        }
+
+        this->operations.clear();
+        this->targets.clear();
+        this->sources.clear();
+        this->cells = 0;
+    }
+
+
     template <>
     GridProperties<double>::GridProperties(const EclipseGrid& eclipseGrid,
                                            const UnitSystem*  deckUnitSystem,
@@ -59,8 +154,10 @@ namespace Opm {
         nz( eclipseGrid.getNZ() ),
         m_deckUnitSystem( deckUnitSystem )
     {
-        for (auto iter = supportedKeywords.begin(); iter != supportedKeywords.end(); ++iter)
+        for (auto iter = supportedKeywords.begin(); iter != supportedKeywords.end(); ++iter) {
+            addHandle( iter->getKeywordName() );
             m_supportedKeywords.emplace( iter->getKeywordName(), std::move( *iter ) );
+        }
     }
 
 
@@ -71,8 +168,10 @@ namespace Opm {
         ny( eclipseGrid.getNY() ),
         nz( eclipseGrid.getNZ() )
     {
-        for (auto iter = supportedKeywords.begin(); iter != supportedKeywords.end(); ++iter)
+        for (auto iter = supportedKeywords.begin(); iter != supportedKeywords.end(); ++iter) {
+            addHandle( iter->getKeywordName() );
             m_supportedKeywords.emplace( iter->getKeywordName(), std::move( *iter ) );
+        }
     }
 
 
@@ -115,22 +214,37 @@ namespace Opm {
 
     template< typename T >
     bool GridProperties<T>::supportsKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         const std::string kw = normalize(keyword);
         return m_supportedKeywords.count( kw ) > 0 || isFipxxx<T>(kw);
     }
 
     template< typename T >
     bool GridProperties<T>::hasKeyword(const std::string& keyword) const {
-        const std::string kw = normalize( keyword );
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        Handle handle;
+        return findHandle( normalize( keyword ), handle ) && hasKeyword( handle );
+    }
 
-        const auto cnt = m_properties.count( kw );
-        const bool positive = cnt > 0;
+    template< typename T >
+    bool GridProperties<T>::hasKeyword(Handle handle) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        return cachedProperty( handle ) != nullptr;
+    }
+
+    template< typename T >
+    typename GridProperties<T>::Handle GridProperties<T>::keywordHandle(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        Handle handle;
+        if (!findHandle( normalize( keyword ), handle ))
+            throw std::invalid_argument("The keyword: " + keyword + " is not supported in this container");
 
-        return positive;
+        return handle;
     }
 
     template< typename T >
     bool GridProperties<T>::hasDeckKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         const std::string kw = normalize( keyword );
 
         const auto cnt = m_properties.count( kw );
@@ -143,12 +257,14 @@ namespace Opm {
 
     template< typename T >
     size_t GridProperties<T>::size() const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         return m_properties.size();
     }
 
 
     template< typename T >
     void GridProperties<T>::assertKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         const std::string kw = normalize(keyword);
 
         if ( !( hasKeyword( kw ) || isDefaultInitializable( kw ) || isFipxxx<T>( kw ) ) )
@@ -165,25 +281,101 @@ namespace Opm {
 
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getKeyword(const std::string& keyword) const {
-        assertKeyword( keyword );
-        return m_properties.at( keyword );
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        return getKeyword( keywordHandle( keyword ) );
+    }
+
+
+    template< typename T >
+    const GridProperty<T>& GridProperties<T>::getKeyword(Handle handle) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        auto* property = cachedProperty( handle );
+        if (property)
+            property->runPostProcessor( );
+        else {
+            assertKeyword( m_handleNames.at( handle ) );
+            property = cachedProperty( handle );
+        }
+
+        return *property;
     }
 
 
     template< typename T >
     GridProperty<T>& GridProperties<T>::getKeyword(const std::string& keyword) {
-        const std::string kw = normalize(keyword);
+        return getKeyword( keywordHandle( keyword ) );
+    }
 
-        if (!hasKeyword(kw))
-            addAutoGeneratedKeyword_(kw);
 
-        return m_properties.at( kw );
+    template< typename T >
+    GridProperty<T>& GridProperties<T>::getKeyword(Handle handle) {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        auto* property = cachedProperty( handle );
+        if (!property) {
+            addAutoGeneratedKeyword_( m_handleNames.at( handle ) );
+            property = cachedProperty( handle );
+        }
+
+        return *property;
+    }
+
+
+    /*
+      The handles are only added, never removed; the callers hold the
+      lock.
+    */
+    template< typename T >
+    typename GridProperties<T>::Handle GridProperties<T>::addHandle(const std::string& keyword) const {
+        const auto iter = m_handles.emplace( keyword, m_handleNames.size() );
+        if (iter.second)
+            m_handleNames.push_back( keyword );
+
+        return iter.first->second;
+    }
+
+
+    template< typename T >
+    bool GridProperties<T>::findHandle(const std::string& keyword, Handle& handle) const {
+        const auto iter = m_handles.find( keyword );
+        if (iter != m_handles.end()) {
+            handle = iter->second;
+            return true;
+        }
+
+        if (!isFipxxx<T>( keyword ))
+            return false;
+
+        handle = addHandle( keyword );
+        return true;
+    }
+
+
+    /*
+      The properties are never removed from the storage, so a property
+      stays in the cache once it has been created.
+    */
+    template< typename T >
+    GridProperty<T>* GridProperties<T>::cachedProperty(Handle handle) const {
+        auto& cache = m_handleProperties.properties;
+        if (handle < cache.size() && cache[ handle ])
+            return cache[ handle ];
+
+        const auto iter = m_properties.find( m_handleNames.at( handle ) );
+        if (iter == m_properties.end())
+            return nullptr;
+
+        if (cache.size() <= handle)
+            cache.resize( m_handleNames.size(), nullptr );
+
+        cache[ handle ] = &iter->second;
+        return cache[ handle ];
     }
 
 
 
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getDeckKeyword(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         const std::string kw = normalize(keyword);
 
         if (hasDeckKeyword(kw))
@@ -255,6 +447,18 @@ namespace Opm {
         return getKeyword(name);
     }
 
+    template< typename T >
+    MemoryUsage GridProperties<T>::memory_usage() const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        MemoryUsage usage( std::is_same< T, int >::value ? "GridProperties<int>" : "GridProperties<double>",
+                           sizeof( *this ) );
+        for (const auto& pair : m_properties)
+            usage.add( pair.first, sizeof( pair.second ) + pair.second.memory_usage() );
+
+        usage.sort();
+        return usage;
+    }
+
     /**
        The fine print of the manual says the ADD keyword should support
        some state dependent semantics regarding endpoint scaling arrays
@@ -262,84 +466,173 @@ namespace Opm {
     */
 
     template< typename T >
-    void GridProperties<T>::handleADDRecord( const DeckRecord& record, BoxManager& boxManager) {
+    bool GridProperties<T>::isPrepared( const std::string& keyword ) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
+        const std::string kw = normalize( keyword );
+
+        // The prepare methods throw for an unsupported keyword.
+        Handle handle;
+        if (!findHandle( kw, handle ))
+            return true;
+
+        const auto* property = cachedProperty( handle );
+        if (property && property->materialized() && property->hasRunPostProcessor())
+            return true;
+
+        const auto info = m_supportedKeywords.find( kw );
+        if (info == m_supportedKeywords.end())
+            return isFipxxx<T>( kw );
+
+        return info->second.hasConstantDefault();
+    }
+
+    template< typename T >
+    GridPropertyOperation GridProperties<T>::prepareADDRecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
         assertKeyword(field);
 
         GridProperty<T>& property = getKeyword( field );
         T shiftValue  = convertInputValue( property , record.getItem("shift").get< double >(0) );
         setKeywordBox(record, boxManager);
-        property.add( shiftValue , boxManager.getActiveBox() );
+
+        const Box box = boxManager.getActiveBox();
+        GridPropertyOperation operation;
+        operation.target = &property;
+        operation.cells = box.size();
+        operation.apply = [&property, shiftValue, box]() { property.add( shiftValue , box ); };
+        return operation;
     }
 
     template< typename T >
-    void GridProperties<T>::handleMAXVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
+    GridPropertyOperation GridProperties<T>::prepareMAXVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
 
         if (hasKeyword( field )) {
             GridProperty<T>& property = getKeyword( field );
             T value  = convertInputValue( record.getItem("value").get< double >(0) );
             setKeywordBox(record, boxManager);
-            property.maxvalue( value , boxManager.getActiveBox() );
+
+            const Box box = boxManager.getActiveBox();
+            GridPropertyOperation operation;
+            operation.target = &property;
+            operation.cells = box.size();
+            operation.apply = [&property, value, box]() { property.maxvalue( value , box ); };
+            return operation;
         } else
             throw std::invalid_argument("Fatal error processing MAXVALUE keyword. Tried to limit not defined keyword " + field);
     }
 
     template< typename T >
-    void GridProperties<T>::handleMINVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
+    GridPropertyOperation GridProperties<T>::prepareMINVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
 
         if (hasKeyword( field )) {
             GridProperty<T>& property = getKeyword( field );
             T value  = convertInputValue( record.getItem("value").get< double >(0) );
             setKeywordBox(record, boxManager);
-            property.minvalue( value , boxManager.getActiveBox() );
+
+            const Box box = boxManager.getActiveBox();
+            GridPropertyOperation operation;
+            operation.target = &property;
+            operation.cells = box.size();
+            operation.apply = [&property, value, box]() { property.minvalue( value , box ); };
+            return operation;
         } else
             throw std::invalid_argument("Fatal error processing MINVALUE keyword. Tried to limit not defined keyword " + field);
     }
 
     template< typename T >
-    void GridProperties<T>::handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager) {
+    GridPropertyOperation GridProperties<T>::prepareMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
         assertKeyword(field);
 
         GridProperty<T>& property = getKeyword( field );
         T factor  = convertInputValue( record.getItem("factor").get< double >(0) );
         setKeywordBox(record, boxManager);
-        property.scale( factor , boxManager.getActiveBox() );
+
+        const Box box = boxManager.getActiveBox();
+        GridPropertyOperation operation;
+        operation.target = &property;
+        operation.cells = box.size();
+        operation.apply = [&property, factor, box]() { property.scale( factor , box ); };
+        return operation;
     }
 
 
     template< typename T >
-    void GridProperties<T>::handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager) {
+    GridPropertyOperation GridProperties<T>::prepareCOPYRecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& srcField = record.getItem("src").get< std::string >(0);
         const std::string& targetField = record.getItem("target").get< std::string >(0);
 
+        GridPropertyOperation operation;
         if (hasKeyword( srcField )) {
             setKeywordBox(record, boxManager);
-            copyKeyword( srcField , targetField , boxManager.getActiveBox() );
+
+            const Box box = boxManager.getActiveBox();
+            const auto& src = this->getKeyword( srcField );
+            auto& target    = this->getOrCreateProperty( targetField );
+            operation.target = &target;
+            operation.source = &src;
+            operation.cells = box.size();
+            operation.apply = [&src, &target, box]() { target.copyFrom( src , box ); };
         } else {
             if (!supportsKeyword( srcField))
                 throw std::invalid_argument("Fatal error processing COPY keyword."
                                             " Tried to copy from not defined keyword " + srcField);
         }
+        return operation;
     }
 
     template< typename T >
-    void GridProperties<T>::handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
+    GridPropertyOperation GridProperties<T>::prepareEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
         double      value  = record.getItem("value").get< double >(0);
 
         if (supportsKeyword( field )) {
             GridProperty<T>& property = getOrCreateProperty( field );
             T targetValue = convertInputValue( property , value );
-
             setKeywordBox(record, boxManager);
-            property.setScalar( targetValue , boxManager.getActiveBox() );
+
+            const Box box = boxManager.getActiveBox();
+            GridPropertyOperation operation;
+            operation.target = &property;
+            operation.cells = box.size();
+            operation.apply = [&property, targetValue, box]() { property.setScalar( targetValue , box ); };
+            return operation;
         } else
             throw std::invalid_argument("Fatal error processing EQUALS keyword. Tried to set not defined keyword " + field);
     }
 
+    template< typename T >
+    void GridProperties<T>::handleADDRecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareADDRecord( record, boxManager ) );
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleMAXVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareMAXVALUERecord( record, boxManager ) );
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleMINVALUERecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareMINVALUERecord( record, boxManager ) );
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareMULTIPLYRecord( record, boxManager ) );
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareCOPYRecord( record, boxManager ) );
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
+        apply( prepareEQUALSRecord( record, boxManager ) );
+    }
+
 
     template< typename T >
     void GridProperties<T>::handleEQUALREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
@@ -349,10 +642,9 @@ namespace Opm {
             double inputValue = record.getItem("VALUE").get<double>(0);
             int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
             T targetValue = convertInputValue( targetProperty , inputValue );
-            std::vector<bool> mask;
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedSet( targetValue , mask);
+            targetProperty.maskedSet( targetValue , regionIndex->cells( regionValue ));
         } else
             throw std::invalid_argument("Fatal error processing EQUALREG record - invalid/undefined keyword: " + targetArray);
     }
@@ -366,10 +658,9 @@ namespace Opm {
         double inputValue = record.getItem("SHIFT").get<double>(0);
         int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
         T shiftValue = convertInputValue( targetProperty , inputValue );
-        std::vector<bool> mask;
+        const auto regionIndex = regionProperty.regionIndex();
 
-        regionProperty.initMask( regionValue , mask);
-        targetProperty.maskedAdd( shiftValue , mask);
+        targetProperty.maskedAdd( shiftValue , regionIndex->cells( regionValue ));
     }
 
     template< typename T >
@@ -381,10 +672,9 @@ namespace Opm {
         double inputValue = record.getItem("FACTOR").get<double>(0);
         int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
         T factor = convertInputValue( inputValue );
-        std::vector<bool> mask;
+        const auto regionIndex = regionProperty.regionIndex();
 
-        regionProperty.initMask( regionValue , mask);
-        targetProperty.maskedMultiply( factor , mask);
+        targetProperty.maskedMultiply( factor , regionIndex->cells( regionValue ));
     }
 
     template< typename T >
@@ -400,12 +690,11 @@ namespace Opm {
 
         {
             int regionValue = record.getItem("REGION_NUMBER").get< int >(0);
-            std::vector<bool> mask;
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray );
             GridProperty<T>& srcProperty = getKeyword( srcArray );
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedCopy( srcProperty , mask );
+            targetProperty.maskedCopy( srcProperty , regionIndex->cells( regionValue ));
         }
     }
 
@@ -546,16 +835,15 @@ namespace Opm {
                     result_prop.runPostProcessor();
             }
 
+            // the index is taken first; getData() invalidates the cached
+            // index if the result is the region array itself.
+            const auto regionIndex = regionProperty.regionIndex();
             std::vector<T>& result_data = result_prop.getData();
             const std::vector<T>& parameter_data = getKeyword( parameter_array ).getData();
             operate_fptr func = operations.at( operation );
-            std::vector<bool> mask;
 
-            regionProperty.initMask(region_value, mask);
-            for (size_t index = 0; index < mask.size(); index++) {
-                if (mask[index])
-                    result_data[index] = func(result_data[index], parameter_data[index], alpha, beta);
-            }
+            for (size_t index : regionIndex->cells( region_value ))
+                result_data[index] = func(result_data[index], parameter_data[index], alpha, beta);
         }
     }
 
@@ -565,6 +853,7 @@ namespace Opm {
                                            std::function< std::vector<T>(size_t) > initProcessor,
                                            const std::string& dimString)
     {
+        addHandle( name );
         m_supportedKeywords.emplace(name,
                                     SupportedKeywordInfo( name,
                                                           initProcessor,
@@ -580,6 +869,7 @@ namespace Opm {
                                            const std::string& dimString,
                                            const bool defaultInitializable )
     {
+        addHandle( name );
         m_supportedKeywords.emplace(name,
                                     SupportedKeywordInfo( name,
                                                           defaultValue,
@@ -589,7 +879,8 @@ namespace Opm {
     }
 
     /*
-      This is const because of the auto-generation of keywords on get().
+      This is const because of the auto-generation of keywords on get();
+      the callers hold the lock.
     */
     template< typename T >
     bool GridProperties<T>::addAutoGeneratedKeyword_(const std::string& keywordName) const {
@@ -616,6 +907,7 @@ namespace Opm {
 
     template< typename T >
     bool GridProperties<T>::isDefaultInitializable(const std::string& keyword) const {
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lock );
         const std::string kw = normalize(keyword);
         if (m_supportedKeywords.count( kw ) == 0) return false;
 
@@ -17,12 +17,17 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+#include <opm/common/utility/FirstTouch.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
@@ -35,7 +40,7 @@ namespace Opm {
 
     template< typename T >
     static std::function< std::vector< T >( size_t ) > constant( T val ) {
-        return [=]( size_t size ) { return std::vector< T >( size, val ); };
+        return [=]( size_t size ) { return FirstTouch::make< T >( size, val ); };
     }
 
     template< typename T >
@@ -43,6 +48,65 @@ namespace Opm {
         return []( std::vector< T >& ) { return; };
     }
 
+    /*
+      The bulk operations on the property data are written as a kernel
+      op( begin, end ) working on a contiguous range of global cell
+      indices, i.e. a plain loop the compiler can vectorize. Large ranges
+      are split in blocks which are processed in parallel when OpenMP is
+      enabled. The blocks start at multiples of the block size so that
+      kernels writing to a std::vector<bool> never share a word between
+      threads.
+    */
+    static const size_t parallel_block_size = 1 << 16;
+
+    template< typename F >
+    static void for_each_block( size_t size, F op ) {
+        if (size < 2 * parallel_block_size) {
+            op( 0, size );
+            return;
+        }
+
+        const long num_blocks = (size + parallel_block_size - 1) / parallel_block_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long block = 0; block < num_blocks; ++block) {
+            const size_t begin = block * parallel_block_size;
+            op( begin, std::min( size, begin + parallel_block_size ) );
+        }
+    }
+
+    /*
+      A BOX is visited as its ranges of consecutive global indices, see
+      Box, instead of cell by cell. A box which is a single range, e.g. the
+      global box, is split in blocks like the whole property.
+    */
+    template< typename F >
+    static void for_each_range( const Box& inputBox, size_t size, F op ) {
+        if (inputBox.isGlobal()) {
+            for_each_block( size, op );
+            return;
+        }
+
+        const size_t range_size = inputBox.rangeSize();
+        const long num_ranges = inputBox.numRanges();
+        if (num_ranges == 1) {
+            const size_t offset = inputBox.rangeBegin( 0 );
+            for_each_block( range_size, [&]( size_t begin, size_t end ) {
+                op( offset + begin, offset + end );
+            });
+            return;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (inputBox.size() >= 2 * parallel_block_size)
+#endif
+        for (long range = 0; range < num_ranges; ++range) {
+            const size_t begin = inputBox.rangeBegin( range );
+            op( begin, begin + range_size );
+        }
+    }
+
     template< typename T >
     GridPropertySupportedKeywordInfo< T >::GridPropertySupportedKeywordInfo(
             const std::string& name,
@@ -80,7 +144,8 @@ namespace Opm {
         m_initializer( constant( defaultValue ) ),
         m_postProcessor( noop< T >() ),
         m_dimensionString( dimString ),
-        m_defaultInitializable ( defaultInitializable )
+        m_defaultInitializable ( defaultInitializable ),
+        m_constantDefault( true )
     {}
 
     template< typename T >
@@ -122,19 +187,109 @@ namespace Opm {
         return m_defaultInitializable;
     }
 
+    template<typename T>
+    bool GridPropertySupportedKeywordInfo< T >::hasConstantDefault() const {
+        return m_constantDefault;
+    }
+
     template< typename T >
     GridProperty< T >::GridProperty( size_t nx, size_t ny, size_t nz, const SupportedKeywordInfo& kwInfo ) :
         m_nx( nx ),
         m_ny( ny ),
         m_nz( nz ),
         m_kwInfo( kwInfo ),
-        m_data( kwInfo.initializer()( nx * ny * nz ) ),
         m_hasRunPostProcessor( false )
     {}
 
+    /*
+      The values of a compacted property, either one value for every
+      layer of layer_size cells - a constant property has one layer
+      covering all the cells - or the offsets from the smallest value in
+      8 bits if the range allows, otherwise in 16 bits.
+    */
+    template< typename T >
+    struct GridProperty< T >::CompactData {
+        size_t cells = 0;
+        size_t layer_size = 0;
+        std::vector< T > layers;
+
+        T base = T();
+        std::vector< std::uint8_t > narrow;
+        std::vector< std::uint16_t > wide;
+
+        size_t size() const {
+            return this->cells;
+        }
+
+        T at( size_t index ) const {
+            if( !this->layers.empty() )
+                return this->layers[ index / this->layer_size ];
+
+            return this->narrow.empty() ? this->base + this->wide[index] : this->base + this->narrow[index];
+        }
+
+        std::vector< T > expand() const {
+            std::vector< T > values = FirstTouch::make< T >( this->size() );
+            T* data = values.data();
+            for_each_block( values.size(), [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++)
+                    data[g] = this->at( g );
+            });
+            return values;
+        }
+    };
+
+    /*
+      The full array is created from a const method, possibly by many
+      threads at once: the first one builds it under the lock, and it is
+      published with atomic_store() so that the unlocked atomic_load()
+      of the other readers sees either nothing or the complete array.
+      Compact data is kept, it still describes the same values.
+    */
+    template< typename T >
+    const std::vector< T >& GridProperty< T >::data() const {
+        if( const auto data = std::atomic_load( &this->m_data ) )
+            return *data;
+
+        std::lock_guard< std::mutex > lock( this->m_buildLock.mutex );
+        if( !this->m_data ) {
+            auto data = this->m_compact
+                ? std::make_shared< std::vector< T > >( this->m_compact->expand() )
+                : std::make_shared< std::vector< T > >( this->m_kwInfo.initializer()( this->getCartesianSize() ) );
+            std::atomic_store( &this->m_data, std::move( data ) );
+        }
+        return *this->m_data;
+    }
+
+    template< typename T >
+    std::vector< T >& GridProperty< T >::writableData() {
+        this->data();
+        this->m_compact.reset();
+        this->m_regionIndex.reset();
+        this->m_fingerprint.reset();
+        if( this->m_data.use_count() > 1 )
+            this->m_data = std::make_shared< std::vector< T > >( *this->m_data );
+
+        return *this->m_data;
+    }
+
+    template< typename T >
+    bool GridProperty< T >::sharesData( const GridProperty< T >& other ) const {
+        if( this->m_compact )
+            return this->m_compact == other.m_compact;
+
+        const auto data = std::atomic_load( &this->m_data );
+        return data && data == std::atomic_load( &other.m_data );
+    }
+
+    template< typename T >
+    bool GridProperty< T >::materialized() const {
+        return static_cast< bool >( std::atomic_load( &this->m_data ) );
+    }
+
     template< typename T >
     size_t GridProperty< T >::getCartesianSize() const {
-        return m_data.size();
+        return m_nx * m_ny * m_nz;
     }
 
     template< typename T >
@@ -157,9 +312,161 @@ namespace Opm {
         return this->assigned;
     }
 
+    template< typename T >
+    bool GridProperty< T >::compacted() const {
+        return static_cast< bool >( this->m_compact );
+    }
+
+    template< typename T >
+    size_t GridProperty< T >::memory_usage() const {
+        size_t bytes = 0;
+        if( const auto data = std::atomic_load( &this->m_data ) )
+            bytes += sizeof( *data ) + MemoryUsage::heap( *data );
+
+        if( this->m_compact )
+            bytes += sizeof( CompactData )
+                   + MemoryUsage::heap( this->m_compact->layers )
+                   + MemoryUsage::heap( this->m_compact->narrow )
+                   + MemoryUsage::heap( this->m_compact->wide );
+
+        if( const auto index = std::atomic_load( &this->m_regionIndex ) )
+            bytes += sizeof( *index ) + index->memory_usage();
+
+        return bytes;
+    }
+
+    template< typename T >
+    bool GridProperty< T >::isConstant() const {
+        if( this->m_compact )
+            return this->m_compact->layers.size() == 1;
+
+        const auto& data = this->data();
+        return std::all_of( data.begin(), data.end(), [&data]( T value ) { return value == data[0]; } );
+    }
+
+    template< typename T >
+    Fingerprint GridProperty< T >::fingerprint() const {
+        if( const auto fingerprint = std::atomic_load( &this->m_fingerprint ) )
+            return *fingerprint;
+
+        // data() takes the lock itself.
+        const std::vector< T >* data = this->m_compact ? nullptr : &this->data();
+        std::lock_guard< std::mutex > lock( this->m_buildLock.mutex );
+        if( !this->m_fingerprint ) {
+            auto fingerprint = std::make_shared< Fingerprint >();
+            fingerprint->add( this->m_kwInfo.getKeywordName() )
+                .add( this->m_nx ).add( this->m_ny ).add( this->m_nz );
+
+            const size_t size = this->getCartesianSize();
+            fingerprint->add( size );
+            for( size_t index = 0; index < size; index++ )
+                fingerprint->add( data ? (*data)[ index ] : this->m_compact->at( index ) );
+
+            std::atomic_store( &this->m_fingerprint, std::shared_ptr< const Fingerprint >( std::move( fingerprint ) ) );
+        }
+
+        return *this->m_fingerprint;
+    }
+
+    /*
+      The layered form of the data, or nullptr if some layer is not
+      constant; the layers are checked in parallel, and a layer stops
+      at its first differing cell.
+    */
+    template< typename T >
+    std::shared_ptr< const typename GridProperty< T >::CompactData > GridProperty< T >::compactLayers() const {
+        const auto& data = *this->m_data;
+        const size_t layer_size = m_nx * m_ny;
+        if( data.empty() || layer_size == 0 || data.size() != layer_size * m_nz )
+            return nullptr;
+
+        const long num_layers = m_nz;
+        bool layered = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(&&:layered)
+#endif
+        for( long k = 0; k < num_layers; k++ ) {
+            const T* layer = data.data() + k * layer_size;
+            layered = layered && std::all_of( layer, layer + layer_size, [layer]( T value ) { return value == layer[0]; } );
+        }
+
+        if( !layered )
+            return nullptr;
+
+        auto compact = std::make_shared< CompactData >();
+        compact->cells = data.size();
+        for( size_t k = 0; k < m_nz; k++ )
+            compact->layers.push_back( data[ k * layer_size ] );
+
+        if( std::all_of( compact->layers.begin(), compact->layers.end(),
+                         [&compact]( T value ) { return value == compact->layers[0]; } ) )
+            compact->layers.resize( 1 );
+        compact->layer_size = compact->cells / compact->layers.size();
+        return compact;
+    }
+
+    /*
+      Applies op( value ) to the layers covered by the box if the
+      property is stored by layer and the box covers whole layers, and
+      returns true; returns false and does nothing otherwise.
+    */
+    template< typename T >
+    template< typename F >
+    bool GridProperty< T >::updateLayers( const Box& inputBox, F op ) {
+        if( !this->m_compact || this->m_compact->layers.empty() )
+            return false;
+
+        const size_t layer_size = m_nx * m_ny;
+        size_t first_layer = 0;
+        size_t last_layer = m_nz;
+        if( !inputBox.isGlobal() ) {
+            if( inputBox.numRanges() != 1 )
+                return false;
+
+            const size_t begin = inputBox.rangeBegin( 0 );
+            const size_t size = inputBox.rangeSize();
+            if( begin % layer_size != 0 || size % layer_size != 0 )
+                return false;
+
+            first_layer = begin / layer_size;
+            last_layer = first_layer + size / layer_size;
+        }
+
+        auto compact = std::make_shared< CompactData >( *this->m_compact );
+        auto& layers = compact->layers;
+        if( layers.size() == 1 && !inputBox.isGlobal() ) {
+            layers.assign( m_nz, layers[0] );
+            compact->layer_size = layer_size;
+        }
+
+        if( layers.size() == 1 )
+            op( layers[0] );
+        else {
+            for( size_t k = first_layer; k < last_layer; k++ )
+                op( layers[k] );
+
+            if( std::all_of( layers.begin(), layers.end(), [&layers]( T value ) { return value == layers[0]; } ) ) {
+                layers.resize( 1 );
+                compact->layer_size = compact->cells;
+            }
+        }
+
+        this->m_compact = std::move( compact );
+        this->m_data.reset();
+        this->m_regionIndex.reset();
+        this->m_fingerprint.reset();
+        return true;
+    }
+
     template< typename T >
     T GridProperty< T >::iget( size_t index ) const {
-        return this->m_data.at( index );
+        if( this->m_compact ) {
+            if( index >= this->m_compact->size() )
+                throw std::out_of_range( "Index out of range in GridProperty::iget()" );
+            return this->m_compact->at( index );
+        }
+
+        return this->data().at( index );
     }
 
     template< typename T >
@@ -170,7 +477,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::iset(size_t index, T value) {
-        this->m_data.at( index ) = value;
+        this->writableData().at( index ) = value;
     }
 
     template< typename T >
@@ -181,74 +488,166 @@ namespace Opm {
 
     template< typename T >
     const std::vector< T >& GridProperty< T >::getData() const {
-        return m_data;
+        return this->data();
     }
 
 
     template< typename T >
     std::vector< T >& GridProperty< T >::getData() {
-        return m_data;
+        return this->writableData();
     }
 
     template< typename T >
     void GridProperty< T >::multiplyWith( const GridProperty< T >& other ) {
         if ((m_nx == other.m_nx) && (m_ny == other.m_ny) && (m_nz == other.m_nz)) {
-            for (size_t g=0; g < m_data.size(); g++)
-                m_data[g] *= other.m_data[g];
+            auto& data = this->writableData();
+            const auto& other_data = other.data();
+            for (size_t g=0; g < data.size(); g++)
+                data[g] *= other_data[g];
         } else
             throw std::invalid_argument("Size mismatch between properties in mulitplyWith.");
     }
 
     template< typename T >
     void GridProperty< T >::multiplyValueAtIndex(size_t index, T factor) {
-        m_data[index] *= factor;
+        this->writableData()[index] *= factor;
     }
 
 
 
     template< typename T >
     void GridProperty< T >::maskedSet( T value, const std::vector< bool >& mask ) {
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] = value;
-        }
+        T* data = this->writableData().data();
+        for_each_block( getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                if (mask[g])
+                    data[g] = value;
+            }
+        });
         this->assigned = true;
     }
 
     template< typename T >
     void GridProperty< T >::maskedMultiply( T value, const std::vector<bool>& mask ) {
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] *= value;
-        }
+        T* data = this->writableData().data();
+        for_each_block( getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                if (mask[g])
+                    data[g] *= value;
+            }
+        });
     }
 
 
     template< typename T >
     void GridProperty< T >::maskedAdd( T value, const std::vector<bool>& mask ) {
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] += value;
-        }
+        T* data = this->writableData().data();
+        for_each_block( getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                if (mask[g])
+                    data[g] += value;
+            }
+        });
     }
 
     template< typename T >
     void GridProperty< T >::maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask) {
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] = other.m_data[g];
-        }
+        T* data = this->writableData().data();
+        const T* src = other.data().data();
+        for_each_block( getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                if (mask[g])
+                    data[g] = src[g];
+            }
+        });
+        this->assigned = other.deckAssigned();
+    }
+
+    /*
+      The cells of a region are distinct, so the region operations are
+      split in blocks of cells like the operations on the whole grid.
+    */
+    template< typename T >
+    void GridProperty< T >::maskedSet( T value, const RegionIndex::Cells& cells ) {
+        T* data = this->writableData().data();
+        for_each_block( cells.size(), [&]( size_t begin, size_t end ) {
+            for (size_t index = begin; index < end; index++)
+                data[cells[index]] = value;
+        });
+        this->assigned = true;
+    }
+
+    template< typename T >
+    void GridProperty< T >::maskedMultiply( T value, const RegionIndex::Cells& cells ) {
+        T* data = this->writableData().data();
+        for_each_block( cells.size(), [&]( size_t begin, size_t end ) {
+            for (size_t index = begin; index < end; index++)
+                data[cells[index]] *= value;
+        });
+    }
+
+    template< typename T >
+    void GridProperty< T >::maskedAdd( T value, const RegionIndex::Cells& cells ) {
+        T* data = this->writableData().data();
+        for_each_block( cells.size(), [&]( size_t begin, size_t end ) {
+            for (size_t index = begin; index < end; index++)
+                data[cells[index]] += value;
+        });
+    }
+
+    template< typename T >
+    void GridProperty< T >::maskedCopy( const GridProperty< T >& other, const RegionIndex::Cells& cells ) {
+        T* data = this->writableData().data();
+        const T* src = other.data().data();
+        for_each_block( cells.size(), [&]( size_t begin, size_t end ) {
+            for (size_t index = begin; index < end; index++)
+                data[cells[index]] = src[cells[index]];
+        });
         this->assigned = other.deckAssigned();
     }
 
     template< typename T >
     void GridProperty< T >::initMask( T value, std::vector< bool >& mask ) const {
         mask.resize(getCartesianSize());
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (m_data[g] == value)
-                mask[g] = true;
-            else
-                mask[g] = false;
+        const T* data = this->data().data();
+        for_each_block( getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++)
+                mask[g] = (data[g] == value);
+        });
+    }
+
+    template< typename T >
+    bool GridProperty< T >::coversAllCells( const DeckItem& deckItem ) const {
+        const auto size = deckItem.size();
+
+        /*
+          A keyword which specifies every cell overwrites the initial
+          values completely, so there is no point in evaluating the -
+          possibly expensive - initializer first.
+        */
+        if ((this->m_data && !this->m_compact) || size != this->getCartesianSize())
+            return false;
+
+        for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
+            if (deckItem.defaultApplied(dataPointIdx))
+                return false;
+        }
+
+        return true;
+    }
+
+    template< typename T >
+    void GridProperty< T >::deckDataAssigned() {
+        this->m_compact.reset();
+        this->m_regionIndex.reset();
+        this->m_fingerprint.reset();
+        this->assigned = true;
+
+        // Constant and layer by layer input is common, e.g. NTG or
+        // the permeabilities; it is kept in the layered form.
+        if (auto layers = this->compactLayers()) {
+            this->m_compact = std::move( layers );
+            this->m_data.reset();
         }
     }
 
@@ -256,6 +655,14 @@ namespace Opm {
     void GridProperty< T >::loadFromDeckKeyword( const DeckKeyword& deckKeyword ) {
         const auto& deckItem = getDeckItem(deckKeyword);
         const auto size = deckItem.size();
+
+        if (this->coversAllCells( deckItem )) {
+            this->assignDeckData( deckItem );
+            this->deckDataAssigned();
+            return;
+        }
+
+        this->writableData();
         for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
             if (!deckItem.defaultApplied(dataPointIdx))
                 setDataPoint(dataPointIdx, dataPointIdx, deckItem);
@@ -270,106 +677,140 @@ namespace Opm {
             loadFromDeckKeyword( deckKeyword );
         else {
             const auto& deckItem = getDeckItem(deckKeyword);
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            if (indexList.size() == deckItem.size()) {
-                for (size_t sourceIdx = 0; sourceIdx < indexList.size(); sourceIdx++) {
-                    size_t targetIdx = indexList[sourceIdx];
-                    if (sourceIdx < deckItem.size()
-                        && !deckItem.defaultApplied(sourceIdx))
-                        {
-                            setDataPoint(sourceIdx, targetIdx, deckItem);
-                        }
-                }
-            } else {
-                std::string boxSize = std::to_string(static_cast<long long>(indexList.size()));
+            if (inputBox.size() != deckItem.size()) {
+                std::string boxSize = std::to_string(static_cast<long long>(inputBox.size()));
                 std::string keywordSize = std::to_string(static_cast<long long>(deckItem.size()));
 
                 throw std::invalid_argument("Size mismatch: Box:" + boxSize + "  DeckKeyword:" + keywordSize);
             }
+
+            this->writableData();
+            const size_t range_size = inputBox.rangeSize();
+            for (size_t range = 0; range < inputBox.numRanges(); range++) {
+                const size_t sourceBegin = range * range_size;
+                const size_t targetBegin = inputBox.rangeBegin( range );
+                for (size_t offset = 0; offset < range_size; offset++) {
+                    if (!deckItem.defaultApplied(sourceBegin + offset))
+                        setDataPoint(sourceBegin + offset, targetBegin + offset, deckItem);
+                }
+            }
+        }
+    }
+
+    template< typename T >
+    void GridProperty< T >::consumeDeckKeyword( const Box& inputBox, DeckKeyword& deckKeyword ) {
+        if (inputBox.isGlobal() && this->coversAllCells( getDeckItem( deckKeyword ) )) {
+            this->releaseDeckData( deckKeyword.getRecord(0).getItem(0) );
+            this->deckDataAssigned();
+            return;
         }
+
+        loadFromDeckKeyword( inputBox, deckKeyword );
     }
 
     template< typename T >
     void GridProperty< T >::copyFrom( const GridProperty< T >& src, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < src.getCartesianSize(); ++i)
-                m_data[i] = src.m_data[i];
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = src.m_data[targetIndex];
+        /* A copy of the whole property shares the data until either is modified. */
+        if (inputBox.isGlobal() && src.getCartesianSize() == this->getCartesianSize()) {
+            if (src.m_compact) {
+                this->m_compact = src.m_compact;
+                this->m_data.reset();
+            } else {
+                src.data();
+                this->m_data = std::atomic_load( &src.m_data );
+                this->m_compact.reset();
             }
+            this->m_regionIndex.reset();
+            this->m_fingerprint.reset();
+            this->assigned = src.deckAssigned();
+            return;
         }
+
+        if (src.m_compact && !src.m_compact->layers.empty()) {
+            const auto& src_compact = *src.m_compact;
+            size_t k = inputBox.numRanges() == 1 ? inputBox.rangeBegin( 0 ) / (m_nx * m_ny) : 0;
+            const bool copied = this->updateLayers( inputBox, [&]( T& value ) {
+                value = src_compact.at( k * m_nx * m_ny );
+                k++;
+            });
+            if (copied) {
+                this->assigned = src.deckAssigned();
+                return;
+            }
+        }
+
+        T* data = this->writableData().data();
+        const T* src_data = src.data().data();
+        for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+            std::copy( src_data + begin, src_data + end, data + begin );
+        });
         this->assigned = src.deckAssigned();
     }
 
     template< typename T >
     void GridProperty< T >::maxvalue( T value, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] = std::min(value,m_data[i]);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = std::min(value,m_data[targetIndex]);
-            }
-        }
+        if (this->updateLayers( inputBox, [value]( T& layer ) { layer = std::min( value, layer ); } ))
+            return;
+
+        T* data = this->writableData().data();
+        for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t i = begin; i < end; ++i)
+                data[i] = std::min(value, data[i]);
+        });
     }
 
     template< typename T >
     void GridProperty< T >::minvalue( T value, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] = std::max(value,m_data[i]);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = std::max(value,m_data[targetIndex]);
-            }
-        }
+        if (this->updateLayers( inputBox, [value]( T& layer ) { layer = std::max( value, layer ); } ))
+            return;
+
+        T* data = this->writableData().data();
+        for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t i = begin; i < end; ++i)
+                data[i] = std::max(value, data[i]);
+        });
     }
 
     template< typename T >
     void GridProperty< T >::scale( T scaleFactor, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] *= scaleFactor;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] *= scaleFactor;
-            }
-        }
+        if (this->updateLayers( inputBox, [scaleFactor]( T& layer ) { layer *= scaleFactor; } ))
+            return;
+
+        T* data = this->writableData().data();
+        for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t i = begin; i < end; ++i)
+                data[i] *= scaleFactor;
+        });
     }
 
     template< typename T >
     void GridProperty< T >::add( T shiftValue, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] += shiftValue;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] += shiftValue;
-            }
-        }
+        if (this->updateLayers( inputBox, [shiftValue]( T& layer ) { layer += shiftValue; } ))
+            return;
+
+        T* data = this->writableData().data();
+        for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+            for (size_t i = begin; i < end; ++i)
+                data[i] += shiftValue;
+        });
     }
 
     template< typename T >
     void GridProperty< T >::setScalar( T value, const Box& inputBox ) {
         if (inputBox.isGlobal()) {
-            std::fill(m_data.begin(), m_data.end(), value);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = value;
-            }
+            auto compact = std::make_shared< CompactData >();
+            compact->cells = this->getCartesianSize();
+            compact->layer_size = compact->cells;
+            compact->layers.assign( 1, value );
+            m_compact = std::move( compact );
+            m_data.reset();
+            m_regionIndex.reset();
+            m_fingerprint.reset();
+        } else if (!this->updateLayers( inputBox, [value]( T& layer ) { layer = value; } )) {
+            T* data = this->writableData().data();
+            for_each_range( inputBox, getCartesianSize(), [&]( size_t begin, size_t end ) {
+                std::fill( data + begin, data + end, value );
+            });
         }
         this->assigned = true;
     }
@@ -389,13 +830,19 @@ namespace Opm {
     void GridProperty< T >::runPostProcessor() {
         if( this->m_hasRunPostProcessor ) return;
         this->m_hasRunPostProcessor = true;
-        this->m_kwInfo.postProcessor()( m_data );
+        this->m_kwInfo.postProcessor()( this->writableData() );
+    }
+
+    template< typename T >
+    bool GridProperty< T >::hasRunPostProcessor() const {
+        return this->m_hasRunPostProcessor;
     }
 
     template< typename T >
     void GridProperty< T >::checkLimits( T min, T max ) const {
-        for (size_t g=0; g < m_data.size(); g++) {
-            T value = m_data[g];
+        const auto& data = this->data();
+        for (size_t g=0; g < data.size(); g++) {
+            T value = data[g];
             if ((value < min) || (value > max))
                 throw std::invalid_argument("Property element " + std::to_string( value) + " in " + getKeywordName() + " outside valid limits: [" + std::to_string(min) + ", " + std::to_string(max) + "]");
         }
@@ -414,22 +861,68 @@ namespace Opm {
 
         const auto& deckItem = deckKeyword.getRecord(0).getItem(0);
 
-        if (deckItem.size() > m_data.size())
+        if (deckItem.size() > getCartesianSize())
             throw std::invalid_argument("Size mismatch when setting data for:" + getKeywordName()
                                         + " keyword size: " + std::to_string( deckItem.size() )
-                                        + " input size: " + std::to_string( m_data.size()) );
+                                        + " input size: " + std::to_string( getCartesianSize()) );
 
         return deckItem;
     }
 
 template<>
 void GridProperty<int>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.get< int >(sourceIdx);
+    (*m_data)[targetIdx] = deckItem.get< int >(sourceIdx);
 }
 
 template<>
 void GridProperty<double>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.getSIDouble(sourceIdx);
+    (*m_data)[targetIdx] = deckItem.getSIDouble(sourceIdx);
+}
+
+namespace {
+
+    /*
+      Items with long N*value runs in the input are filled run by run,
+      without expanding the values in the deck first.
+    */
+    template< typename T >
+    std::shared_ptr< std::vector< T > > fillRuns( const DeckItem& deckItem,
+                                                  const std::vector< T >& runValues ) {
+        const auto& runs = deckItem.getRunLengths();
+        auto data = std::make_shared< std::vector< T > >( FirstTouch::make< T >( deckItem.size() ) );
+        auto out = data->begin();
+        for (size_t run = 0; run < runs.size(); run++)
+            out = std::fill_n( out, runs[run], runValues[run] );
+
+        return data;
+    }
+
+}
+
+template<>
+void GridProperty<int>::assignDeckData(const DeckItem& deckItem) {
+    if (!deckItem.getRunLengths().empty())
+        m_data = fillRuns( deckItem, deckItem.getRunValues< int >() );
+    else
+        m_data = std::make_shared< std::vector< int > >( deckItem.getData< int >() );
+}
+
+template<>
+void GridProperty<double>::assignDeckData(const DeckItem& deckItem) {
+    if (!deckItem.getRunLengths().empty())
+        m_data = fillRuns( deckItem, deckItem.getSIRunValues() );
+    else
+        m_data = std::make_shared< std::vector< double > >( deckItem.getSIDoubleData() );
+}
+
+template<>
+void GridProperty<int>::releaseDeckData(DeckItem& deckItem) {
+    m_data = std::make_shared< std::vector< int > >( deckItem.releaseData< int >() );
+}
+
+template<>
+void GridProperty<double>::releaseDeckData(DeckItem& deckItem) {
+    m_data = std::make_shared< std::vector< double > >( deckItem.releaseSIDoubleData() );
 }
 
 template<>
@@ -439,11 +932,12 @@ bool GridProperty<int>::containsNaN( ) const {
 
 template<>
 bool GridProperty<double>::containsNaN( ) const {
+    const auto& data = this->data();
     bool return_value = false;
-    size_t size = m_data.size();
+    size_t size = data.size();
     size_t index = 0;
     while (true) {
-        if (std::isnan(m_data[index])) {
+        if (std::isnan(data[index])) {
             return_value = true;
             break;
         }
@@ -455,6 +949,94 @@ bool GridProperty<double>::containsNaN( ) const {
     return return_value;
 }
 
+template<>
+std::shared_ptr< const RegionIndex > GridProperty<int>::regionIndex() const {
+    auto index = std::atomic_load( &this->m_regionIndex );
+    if (index)
+        return index;
+
+    // data() takes the lock itself.
+    const std::vector<int>* data = this->m_compact ? nullptr : &this->data();
+    std::lock_guard< std::mutex > lock( this->m_buildLock.mutex );
+    index = this->m_regionIndex;
+    if (!index) {
+        if (data)
+            index = std::make_shared< const RegionIndex >( *data );
+        else
+            index = std::make_shared< const RegionIndex >( this->m_compact->expand() );
+        std::atomic_store( &this->m_regionIndex, index );
+    }
+
+    return index;
+}
+
+template<>
+bool GridProperty<int>::compact() const {
+    if (this->m_compact)
+        return true;
+
+    if (!this->m_data || this->m_data->empty())
+        return false;
+
+    if (auto layers = this->compactLayers()) {
+        this->m_compact = std::move( layers );
+        this->m_data.reset();
+        return true;
+    }
+
+    const auto& data = *this->m_data;
+    const auto minmax = std::minmax_element( data.begin(), data.end() );
+    const long range = static_cast< long >( *minmax.second ) - *minmax.first;
+    if (range > std::numeric_limits< std::uint16_t >::max())
+        return false;
+
+    auto compact = std::make_shared< CompactData >();
+    const int base = *minmax.first;
+    compact->cells = data.size();
+    compact->base = base;
+    if (range <= std::numeric_limits< std::uint8_t >::max()) {
+        compact->narrow.resize( data.size() );
+        auto* narrow = compact->narrow.data();
+        for_each_block( data.size(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++)
+                narrow[g] = static_cast< std::uint8_t >( data[g] - base );
+        });
+    } else {
+        compact->wide.resize( data.size() );
+        auto* wide = compact->wide.data();
+        for_each_block( data.size(), [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++)
+                wide[g] = static_cast< std::uint16_t >( data[g] - base );
+        });
+    }
+
+    this->m_compact = std::move( compact );
+    this->m_data.reset();
+    return true;
+}
+
+template<>
+bool GridProperty<double>::compact() const {
+    if (this->m_compact)
+        return true;
+
+    if (!this->m_data)
+        return false;
+
+    auto layers = this->compactLayers();
+    if (!layers)
+        return false;
+
+    this->m_compact = std::move( layers );
+    this->m_data.reset();
+    return true;
+}
+
+template<>
+std::shared_ptr< const RegionIndex > GridProperty<double>::regionIndex() const {
+    throw std::logic_error("Only <int> grid properties have regions");
+}
+
 template<>
 const std::string& GridProperty<int>::getDimensionString() const {
     throw std::logic_error("Only <double> grid properties have dimension");
@@ -468,10 +1050,22 @@ const std::string& GridProperty<double>::getDimensionString() const {
 
 template<typename T>
 std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
+    if (this->m_compact) {
+        if (grid.allActive())
+            return this->m_compact->expand();
+
+        const auto& activeMap = grid.getActiveMap();
+        std::vector<T> compressed( activeMap.size() );
+        for (size_t active_index = 0; active_index < activeMap.size(); active_index++)
+            compressed[active_index] = this->m_compact->at( activeMap[active_index] );
+        return compressed;
+    }
+
+    const auto& data = this->data();
     if (grid.allActive())
-        return m_data;
+        return data;
     else {
-        return grid.compressedVector( m_data );
+        return grid.compressedVector( data );
     }
 }
 
@@ -479,21 +1073,33 @@ std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
 
 template<typename T>
 std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>& activeMap) const {
+    const auto& data = this->data();
+    const size_t num_blocks = (activeMap.size() + parallel_block_size - 1) / parallel_block_size;
+    std::vector< std::vector<size_t> > block_cells( num_blocks );
+
+    /* Each block collects its own cells, and the blocks are joined in order. */
+    for_each_block( activeMap.size(), [&]( size_t begin, size_t end ) {
+        auto& cells = block_cells[ begin / parallel_block_size ];
+        for (size_t active_index = begin; active_index < end; active_index++) {
+            size_t global_index = activeMap[ active_index ];
+            if (data[global_index] == value)
+                cells.push_back( active_index );
+        }
+    });
+
     std::vector<size_t> cells;
-    for (size_t active_index = 0; active_index < activeMap.size(); active_index++) {
-        size_t global_index = activeMap[ active_index ];
-        if (m_data[global_index] == value)
-            cells.push_back( active_index );
-    }
+    for (const auto& block : block_cells)
+        cells.insert( cells.end(), block.begin(), block.end() );
     return cells;
 }
 
 
 template<typename T>
 std::vector<size_t> GridProperty<T>::indexEqual(T value) const {
+    const auto& data = this->data();
     std::vector<size_t> index_list;
-    for (size_t index = 0; index < m_data.size(); index++) {
-        if (m_data[index] == value)
+    for (size_t index = 0; index < data.size(); index++) {
+        if (data[index] == value)
             index_list.push_back( index );
     }
     return index_list;
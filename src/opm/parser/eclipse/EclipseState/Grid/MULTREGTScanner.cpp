@@ -16,6 +16,8 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 #include <map>
 #include <set>
@@ -121,18 +123,62 @@ namespace Opm {
                                 + " which is not in the deck");
         }
 
+        std::map<std::string , MULTREGTSearchMap> searchMap;
         for (auto iter = searchPairs.begin(); iter != searchPairs.end(); ++iter) {
             const MULTREGTRecord * record = (*iter).second;
             std::pair<int,int> pair = (*iter).first;
             const std::string& keyword = record->region_name;
-            if (m_searchMap.count(keyword) == 0)
-                m_searchMap[keyword] = MULTREGTSearchMap();
+            searchMap[keyword][pair] = record;
+        }
+
+        for (const auto& keyword_map : searchMap) {
+            RegionTable table;
+            table.region_name = keyword_map.first;
+
+            int max_region = 0;
+            for (const auto& pair : keyword_map.second)
+                max_region = std::max( max_region, std::max( pair.first.first, pair.first.second ) );
+
+            table.index.assign( max_region + 1, -1 );
+            for (const auto& pair : keyword_map.second) {
+                for (int region_id : { pair.first.first, pair.first.second }) {
+                    if (region_id >= 0 && table.index[region_id] < 0)
+                        table.index[region_id] = table.size++;
+                }
+            }
 
-            m_searchMap[keyword][pair] = record;
+            table.records.assign( table.size * table.size, -1 );
+            for (const auto& pair : keyword_map.second) {
+                if (pair.first.first < 0 || pair.first.second < 0)
+                    continue;
+
+                const std::size_t row = table.index[pair.first.first];
+                const std::size_t col = table.index[pair.first.second];
+                table.records[row * table.size + col] = pair.second - m_records.data();
+            }
+
+            m_tables.push_back( std::move( table ) );
         }
     }
 
 
+    int MULTREGTScanner::RegionTable::record(int regionId1, int regionId2) const {
+        if (regionId1 < 0 || regionId2 < 0)
+            return -1;
+
+        if (static_cast<std::size_t>(regionId1) >= this->index.size() ||
+            static_cast<std::size_t>(regionId2) >= this->index.size())
+            return -1;
+
+        const int row = this->index[regionId1];
+        const int col = this->index[regionId2];
+        if (row < 0 || col < 0)
+            return -1;
+
+        return this->records[row * this->size + col];
+    }
+
+
     void MULTREGTScanner::assertKeywordSupported( const DeckKeyword& deckKeyword, const std::string& /* defaultRegion */) {
         for (const auto& deckRecord : deckKeyword) {
             const auto& srcItem = deckRecord.getItem("SRC_REGION");
@@ -214,44 +260,83 @@ namespace Opm {
          -----------
 
     */
+    const MULTREGTRecord* MULTREGTScanner::findRecord(const RegionTable& table, int regionId1, int regionId2, FaceDir::DirEnum faceDir) const {
+        int index = table.record( regionId1, regionId2 );
+        if (index < 0 || !(m_records[index].directions & faceDir)) {
+            index = table.record( regionId2, regionId1 );
+            if (index < 0 || !(m_records[index].directions & faceDir))
+                return nullptr;
+        }
+
+        return &m_records[index];
+    }
+
+
+namespace {
+
+    bool applyMultiplier(const MULTREGTRecord& record, size_t globalIndex1, size_t globalIndex2, size_t nx, size_t ny) {
+        int i1 = globalIndex1 % nx;
+        int i2 = globalIndex2 % nx;
+        int j1 = globalIndex1 / nx % ny;
+        int j2 = globalIndex2 / nx % ny;
+        bool neighbours = (std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0);
+
+        if (record.nnc_behaviour == MULTREGT::NNC)
+            return !neighbours;
+
+        if (record.nnc_behaviour == MULTREGT::NONNC)
+            return neighbours;
+
+        return true;
+    }
+
+}
+
+
     double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
 
-        for (auto iter = m_searchMap.begin(); iter != m_searchMap.end(); iter++) {
-            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( (*iter).first );
-            const MULTREGTSearchMap& map = (*iter).second;
+        for (const auto& table : m_tables) {
+            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( table.region_name );
 
             int regionId1 = region.iget(globalIndex1);
             int regionId2 = region.iget(globalIndex2);
 
-            std::pair<int,int> pair{ regionId1, regionId2 };
-            if (map.count(pair) != 1 || !(map.at(pair)->directions & faceDir)) {
-                pair = std::pair<int,int>{regionId2 , regionId1};
-                if (map.count(pair) != 1 || !(map.at(pair)->directions & faceDir))
-                    continue;
-            }
-            const MULTREGTRecord* record = map.at(pair);
-
-            bool applyMultiplier = true;
-            int i1 = globalIndex1 % region.getNX();
-            int i2 = globalIndex2 % region.getNX();
-            int j1 = globalIndex1 / region.getNX() % region.getNY();
-            int j2 = globalIndex2 / region.getNX() % region.getNY();
-
-            if (record->nnc_behaviour == MULTREGT::NNC){
-                applyMultiplier = true;
-                if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
-                    applyMultiplier = false;
-            }
-            else if (record->nnc_behaviour == MULTREGT::NONNC){
-                applyMultiplier = false;
-                if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
-                    applyMultiplier = true;
-            }
-
-            if (applyMultiplier)
+            const MULTREGTRecord* record = this->findRecord( table, regionId1, regionId2, faceDir );
+            if (record && applyMultiplier( *record, globalIndex1, globalIndex2, region.getNX(), region.getNY() ))
                 return record->trans_mult;
-
         }
         return 1;
     }
+
+
+    std::vector<double> MULTREGTScanner::getRegionMultipliers(const std::vector<size_t>& globalIndex1,
+                                                              const std::vector<size_t>& globalIndex2,
+                                                              const std::vector<FaceDir::DirEnum>& faceDir) const {
+        if (globalIndex1.size() != globalIndex2.size() || globalIndex1.size() != faceDir.size())
+            throw std::invalid_argument("The cell and face direction lists must have the same size");
+
+        std::vector<double> multipliers( globalIndex1.size(), 1 );
+        std::vector<bool> assigned( globalIndex1.size(), false );
+
+        for (const auto& table : m_tables) {
+            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( table.region_name );
+            const size_t nx = region.getNX();
+            const size_t ny = region.getNY();
+
+            for (size_t face = 0; face < multipliers.size(); face++) {
+                if (assigned[face])
+                    continue;
+
+                const size_t cell1 = globalIndex1[face];
+                const size_t cell2 = globalIndex2[face];
+                const MULTREGTRecord* record = this->findRecord( table, region.iget(cell1), region.iget(cell2), faceDir[face] );
+                if (record && applyMultiplier( *record, cell1, cell2, nx, ny )) {
+                    multipliers[face] = record->trans_mult;
+                    assigned[face] = true;
+                }
+            }
+        }
+
+        return multipliers;
+    }
 }
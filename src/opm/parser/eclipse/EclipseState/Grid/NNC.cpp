@@ -16,12 +16,17 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
 #include <array>
+#include <stdexcept>
+#include <utility>
 
+#include <opm/common/utility/ParallelChunks.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/Edit/EDITNNC.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
@@ -30,11 +35,51 @@
 
 namespace Opm
 {
+namespace {
+
+    bool lessDirected(const NNCdata& a, const NNCdata& b) {
+        return (a.cell1 < b.cell1) || (a.cell1 == b.cell1 && a.cell2 < b.cell2);
+    }
+
+    /*
+      The pair of cells of a connection independent of its direction.
+    */
+    std::pair<size_t, size_t> cellPair(const NNCdata& nnc) {
+        return std::minmax(nnc.cell1, nnc.cell2);
+    }
+
+    /*
+      Stable sort of the connections by (cell1, cell2). Long lists are
+      sorted in chunks on the hardware threads and the chunks merged
+      pairwise.
+    */
+    void sortConnections(std::vector<NNCdata>& nnc) {
+        const auto ranges = chunkRanges(nnc.size(), 1 << 16);
+        forEachChunk(ranges, [&nnc](size_t, size_t first, size_t last) {
+            std::stable_sort(nnc.begin() + first, nnc.begin() + last, lessDirected);
+        });
+
+        std::vector<size_t> bounds;
+        for (const auto& range : ranges)
+            bounds.push_back(range.first);
+        bounds.push_back(nnc.size());
+
+        for (size_t width = 1; width + 1 < bounds.size(); width *= 2) {
+            for (size_t chunk = 0; chunk + width + 1 < bounds.size(); chunk += 2 * width) {
+                const size_t last = std::min(chunk + 2 * width, bounds.size() - 1);
+                std::inplace_merge(nnc.begin() + bounds[chunk],
+                                   nnc.begin() + bounds[chunk + width],
+                                   nnc.begin() + bounds[last],
+                                   lessDirected);
+            }
+        }
+    }
+
+}
+
     NNC::NNC(const Deck& deck) {
         GridDims gridDims(deck);
-        const auto& nncs = deck.getKeywordList<ParserKeywords::NNC>();
-        for (size_t idx_nnc = 0; idx_nnc<nncs.size(); ++idx_nnc) {
-            const auto& nnc = *nncs[idx_nnc];
+        for (const auto& nnc : deck.getKeywordRange<ParserKeywords::NNC>()) {
             for (size_t i = 0; i < nnc.size(); ++i) {
                 std::array<size_t, 3> ijk1;
                 ijk1[0] = static_cast<size_t>(nnc.getRecord(i).getItem(0).get< int >(0)-1);
@@ -70,5 +115,125 @@ namespace Opm
         return m_nnc.size()>0;
     }
 
+    void NNC::sortUnique() {
+        sortConnections(m_nnc);
+
+        size_t last = 0;
+        for (size_t index = 1; index < m_nnc.size(); ++index) {
+            if (m_nnc[index].cell1 == m_nnc[last].cell1 && m_nnc[index].cell2 == m_nnc[last].cell2)
+                m_nnc[last].trans += m_nnc[index].trans;
+            else
+                m_nnc[++last] = m_nnc[index];
+        }
+
+        if (!m_nnc.empty())
+            m_nnc.resize(last + 1);
+    }
+
+    NNC NNC::merge(const std::vector<NNC>& parts) {
+        size_t size = 0;
+        for (const auto& part : parts)
+            size += part.numNNC();
+
+        NNC nnc;
+        nnc.m_nnc.reserve(size);
+        for (const auto& part : parts)
+            nnc.m_nnc.insert(nnc.m_nnc.end(), part.m_nnc.begin(), part.m_nnc.end());
+
+        nnc.sortUnique();
+        return nnc;
+    }
+
+    std::vector<NNCdata> NNC::applyEditNNC(const EDITNNC& editnnc) {
+        /*
+          The multipliers are keyed on the undirected pair of cells and
+          sorted, with the multipliers of repeated pairs combined; each
+          connection then looks up its pair with a binary search.
+        */
+        struct Edit {
+            std::pair<size_t, size_t> cells;
+            double mult;
+            bool used;
+        };
+
+        const auto& data = editnnc.data();
+        std::vector<Edit> edits;
+        edits.reserve(data.size());
+        for (const auto& entry : data)
+            edits.push_back({ cellPair(entry), entry.trans, false });
+
+        std::stable_sort(edits.begin(), edits.end(), [](const Edit& a, const Edit& b) {
+            return a.cells < b.cells;
+        });
+
+        size_t last = 0;
+        for (size_t index = 1; index < edits.size(); ++index) {
+            if (edits[index].cells == edits[last].cells)
+                edits[last].mult *= edits[index].mult;
+            else
+                edits[++last] = edits[index];
+        }
+        if (!edits.empty())
+            edits.resize(last + 1);
+
+        for (auto& nnc : m_nnc) {
+            const auto cells = cellPair(nnc);
+            auto edit = std::lower_bound(edits.begin(), edits.end(), cells, [](const Edit& e, const std::pair<size_t, size_t>& c) {
+                return e.cells < c;
+            });
+            if (edit != edits.end() && edit->cells == cells) {
+                nnc.trans *= edit->mult;
+                edit->used = true;
+            }
+        }
+
+        std::vector<NNCdata> unused;
+        for (const auto& edit : edits) {
+            if (!edit.used)
+                unused.emplace_back(edit.cells.first, edit.cells.second, edit.mult);
+        }
+        return unused;
+    }
+
+
+    NNCIndex::NNCIndex(const NNC& nnc, size_t numCells) :
+        m_offsets(numCells + 1, 0)
+    {
+        const auto& data = nnc.nncdata();
+        for (const auto& n : data) {
+            if (n.cell1 >= numCells || n.cell2 >= numCells)
+                throw std::invalid_argument("NNC between cells " + std::to_string(n.cell1) + " and "
+                                            + std::to_string(n.cell2) + " is outside the grid");
+            m_offsets[n.cell1 + 1]++;
+            m_offsets[n.cell2 + 1]++;
+        }
+
+        for (size_t cell = 0; cell < numCells; ++cell)
+            m_offsets[cell + 1] += m_offsets[cell];
+
+        std::vector<size_t> fill(m_offsets.begin(), m_offsets.end() - 1);
+        m_neighbours.resize(m_offsets.back());
+        for (size_t index = 0; index < data.size(); ++index) {
+            m_neighbours[fill[data[index].cell1]++] = { data[index].cell2, index };
+            m_neighbours[fill[data[index].cell2]++] = { data[index].cell1, index };
+        }
+
+        for (size_t cell = 0; cell < numCells; ++cell)
+            std::stable_sort(m_neighbours.begin() + m_offsets[cell], m_neighbours.begin() + m_offsets[cell + 1],
+                             [](const Neighbour& a, const Neighbour& b) { return a.cell < b.cell; });
+    }
+
+    const NNCIndex::Neighbour* NNCIndex::begin(size_t cell) const {
+        return m_neighbours.data() + m_offsets.at(cell);
+    }
+
+    const NNCIndex::Neighbour* NNCIndex::end(size_t cell) const {
+        return m_neighbours.data() + m_offsets.at(cell + 1);
+    }
+
+    size_t NNCIndex::numNeighbours(size_t cell) const {
+        return m_offsets.at(cell + 1) - m_offsets.at(cell);
+    }
+
 } // namespace Opm
 
@@ -0,0 +1,160 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
+
+namespace Opm {
+
+    RegionIndex::Cells::Cells(const size_t* begin, const size_t* end) :
+        m_begin(begin),
+        m_end(end)
+    {}
+
+    const size_t* RegionIndex::Cells::begin() const {
+        return m_begin;
+    }
+
+    const size_t* RegionIndex::Cells::end() const {
+        return m_end;
+    }
+
+    size_t RegionIndex::Cells::size() const {
+        return m_end - m_begin;
+    }
+
+    bool RegionIndex::Cells::empty() const {
+        return m_begin == m_end;
+    }
+
+    size_t RegionIndex::Cells::operator[](size_t index) const {
+        return m_begin[index];
+    }
+
+
+    /*
+      The region values are usually a small range of integers, and the
+      cells are then bucketed with a counting sort in two passes over
+      the array. Large arrays are split in blocks which are counted and
+      bucketed in parallel, each block with its own histogram; the
+      blocks are placed in order, so the cells stay in increasing global
+      index within each region. Arrays with widely spread values are
+      sorted instead.
+    */
+    RegionIndex::RegionIndex(const std::vector<int>& regions) {
+        const size_t size = regions.size();
+        m_offsets.push_back(0);
+        if (size == 0)
+            return;
+
+        const auto minmax = std::minmax_element(regions.begin(), regions.end());
+        const long min_value = *minmax.first;
+        const long range = static_cast<long>(*minmax.second) - min_value + 1;
+
+        const size_t num_blocks = (size + block_size - 1) / block_size;
+        if (num_blocks > 1 && static_cast<size_t>(range) * num_blocks <= size) {
+            std::vector<size_t> count(num_blocks * range, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (long block = 0; block < static_cast<long>(num_blocks); block++) {
+                size_t* block_count = count.data() + block * range;
+                const size_t end = std::min(size, (block + 1) * block_size);
+                for (size_t g = block * block_size; g < end; g++)
+                    block_count[regions[g] - min_value]++;
+            }
+
+            size_t offset = 0;
+            for (long value = 0; value < range; value++) {
+                for (size_t block = 0; block < num_blocks; block++) {
+                    const size_t block_cells = count[block * range + value];
+                    count[block * range + value] = offset;
+                    offset += block_cells;
+                }
+
+                if (offset > m_offsets.back()) {
+                    m_regions.push_back(static_cast<int>(value + min_value));
+                    m_offsets.push_back(offset);
+                }
+            }
+
+            m_cells.resize(size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (long block = 0; block < static_cast<long>(num_blocks); block++) {
+                size_t* block_offset = count.data() + block * range;
+                const size_t end = std::min(size, (block + 1) * block_size);
+                for (size_t g = block * block_size; g < end; g++)
+                    m_cells[block_offset[regions[g] - min_value]++] = g;
+            }
+        } else if (static_cast<size_t>(range) <= 2 * size) {
+            std::vector<size_t> count(range + 1, 0);
+            for (int value : regions)
+                count[value - min_value + 1]++;
+
+            for (long value = 0; value < range; value++) {
+                if (count[value + 1] > 0) {
+                    m_regions.push_back(static_cast<int>(value + min_value));
+                    m_offsets.push_back(m_offsets.back() + count[value + 1]);
+                }
+                count[value + 1] += count[value];
+            }
+
+            m_cells.resize(size);
+            for (size_t g = 0; g < size; g++)
+                m_cells[count[regions[g] - min_value]++] = g;
+        } else {
+            std::vector<std::pair<int, size_t>> cells(size);
+            for (size_t g = 0; g < size; g++)
+                cells[g] = std::make_pair(regions[g], g);
+            std::sort(cells.begin(), cells.end());
+
+            m_cells.reserve(size);
+            for (size_t index = 0; index < size; index++) {
+                if (index > 0 && cells[index].first != cells[index - 1].first)
+                    m_offsets.push_back(index);
+                if (index == 0 || cells[index].first != cells[index - 1].first)
+                    m_regions.push_back(cells[index].first);
+                m_cells.push_back(cells[index].second);
+            }
+            m_offsets.push_back(size);
+        }
+    }
+
+    const std::vector<int>& RegionIndex::regions() const {
+        return m_regions;
+    }
+
+    RegionIndex::Cells RegionIndex::cells(int region) const {
+        const auto iter = std::lower_bound(m_regions.begin(), m_regions.end(), region);
+        if (iter == m_regions.end() || *iter != region)
+            return Cells();
+
+        const size_t index = iter - m_regions.begin();
+        return Cells(m_cells.data() + m_offsets[index], m_cells.data() + m_offsets[index + 1]);
+    }
+
+    size_t RegionIndex::memory_usage() const {
+        return MemoryUsage::heap(m_regions) + MemoryUsage::heap(m_offsets) + MemoryUsage::heap(m_cells);
+    }
+}
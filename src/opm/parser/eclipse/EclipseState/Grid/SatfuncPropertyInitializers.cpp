@@ -16,6 +16,7 @@
 
 
 #include <array>
+#include <exception>
 
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -30,6 +31,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/SwofTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/Tabdims.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableEvaluator.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Utility/Functional.hpp>
 
@@ -654,28 +656,124 @@ namespace Opm {
         }
     }
 
-    static double selectValue( const TableContainer& depthTables,
-                               int tableIdx,
-                               const std::string& columnName,
-                               double cellDepth,
-                               double fallbackValue,
-                               bool useOneMinusTableValue) {
+    /*
+      One column of the depth tables (ENPTVD/IMPTVD) of all the ENDNUM
+      regions, prepared once for the evaluation in every cell. Columns
+      without defaulted values are evaluated with a TableEvaluator; a
+      column with defaults, or without ordered depths, is evaluated by
+      the table itself, which gives a NaN for a fully defaulted column.
+    */
+    class DepthColumn {
+    public:
+        DepthColumn( const TableContainer& tables, const std::string& column ) :
+            depthTables( tables ),
+            columnName( column )
+        {
+            for( size_t tableIdx = 0; tableIdx < tables.size(); tableIdx++ ) {
+                const auto& table = tables.getTable( tableIdx );
+                this->evaluators.emplace_back();
+                this->useEvaluator.push_back( false );
+                if( table.getColumn( column ).hasDefault() )
+                    continue;
+
+                try {
+                    this->evaluators.back() = TableEvaluator( table, column );
+                    this->useEvaluator.back() = true;
+                } catch( const std::invalid_argument& ) {
+                    // Not a strictly tabulated function of depth; left to the table.
+                }
+            }
+        }
+
+        double operator()( int tableIdx, double cellDepth, std::size_t& hint ) const {
+            if( tableIdx >= int( this->evaluators.size() ) )
+                throw std::invalid_argument("Not enough tables!");
+
+            if( this->useEvaluator[ tableIdx ] )
+                return this->evaluators[ tableIdx ]( cellDepth, hint );
+
+            return this->depthTables.getTable( tableIdx ).evaluate( this->columnName, cellDepth );
+        }
+
+    private:
+        const TableContainer& depthTables;
+        std::string columnName;
+        std::vector< TableEvaluator > evaluators;
+        std::vector< bool > useEvaluator;
+    };
 
-        if( tableIdx < 0 ) return fallbackValue;
+    /*
+      Assign the end point of the saturation region of every cell, or the
+      value of the depth table of the ENDNUM region when the depth tables
+      are in use. The cells are independent and assigned in parallel,
+      with the cell depths of the grid geometry, which are computed once
+      for all the end points; the first error of any cell is rethrown.
+    */
+    static std::vector< double > regionApply( size_t size,
+                                              const std::string& columnName,
+                                              const std::vector< double >& fallbackValues,
+                                              const std::vector< int >& regions,
+                                              const std::vector< int >& endnum,
+                                              bool useDepthTables,
+                                              const TableContainer& depthTables,
+                                              const EclipseGrid* eclipseGrid,
+                                              bool useOneMinusTableValue ) {
 
-        const auto& table = depthTables.getTable( tableIdx );
+        std::vector< double > values( size, 0 );
+        const long gridsize = static_cast< long >( eclipseGrid->getCartesianSize() );
 
-        if( tableIdx >= int( depthTables.size() ) )
-            throw std::invalid_argument("Not enough tables!");
+        if( !useDepthTables ) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for( long cellIdx = 0; cellIdx < gridsize; cellIdx++ )
+                values[cellIdx] = fallbackValues[ regions[cellIdx] - 1 ];
 
-        // evaluate the table at the cell depth
-        const double value = table.evaluate( columnName, cellDepth );
+            return values;
+        }
 
-        // a column can be fully defaulted. In this case, eval() returns a NaN
-        // and we have to use the data from saturation tables
-        if( !std::isfinite( value ) ) return fallbackValue;
-        if( useOneMinusTableValue ) return 1 - value;
-        return value;
+        const DepthColumn depthColumn( depthTables, columnName );
+        const auto& depths = eclipseGrid->getCellDepths();
+        std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::size_t hint = 0;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for( long cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
+                const double fallbackValue = fallbackValues[ regions[cellIdx] - 1 ];
+                const int endNum = endnum[cellIdx] - 1;
+                if( endNum < 0 ) {
+                    values[cellIdx] = fallbackValue;
+                    continue;
+                }
+
+                try {
+                    // a column can be fully defaulted. In this case, eval() returns a NaN
+                    // and we have to use the data from saturation tables
+                    const double value = depthColumn( endNum, depths[cellIdx], hint );
+                    if( !std::isfinite( value ) )
+                        values[cellIdx] = fallbackValue;
+                    else
+                        values[cellIdx] = useOneMinusTableValue ? 1 - value : value;
+                } catch( ... ) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    if( !error )
+                        error = std::current_exception();
+                }
+            }
+        }
+
+        if( error )
+            std::rethrow_exception( error );
+
+        return values;
     }
 
     static std::vector< double > satnumApply( size_t size,
@@ -686,8 +784,6 @@ namespace Opm {
                                               const GridProperties<int>* intGridProperties,
                                               bool useOneMinusTableValue ) {
 
-
-        std::vector< double > values( size, 0 );
         auto tabdims = tableManager->getTabdims();
 
         const auto& satnum = intGridProperties->getKeyword("SATNUM");
@@ -696,30 +792,10 @@ namespace Opm {
 
         satnum.checkLimits( 1 , numSatTables );
 
-        // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
-        // this currently cannot be done because we would need the Z-coordinate of the
-        // cell and we would need to know how the simulator wants to interpolate between
-        // sampling points. Both of these are outside the scope of opm-parser, so we just
-        // assign a NaN in this case...
-        const bool useEnptvd = tableManager->useEnptvd();
-        const auto& enptvdTables = tableManager->getEnptvdTables();
-
-        const auto gridsize = eclipseGrid->getCartesianSize();
-        for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int satTableIdx = satnum.iget( cellIdx ) - 1;
-            int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-
-            values[cellIdx] = selectValue(enptvdTables,
-                                        (useEnptvd && endNum >= 0) ? endNum : -1,
-                                        columnName,
-                                        cellDepth,
-                                        fallbackValues[ satTableIdx ],
-                                        useOneMinusTableValue);
-        }
-
-        return values;
+        return regionApply( size, columnName, fallbackValues,
+                            satnum.getData(), endnum.getData(),
+                            tableManager->useEnptvd(), tableManager->getEnptvdTables(),
+                            eclipseGrid, useOneMinusTableValue );
     }
 
     static std::vector< double > imbnumApply( size_t size,
@@ -730,8 +806,6 @@ namespace Opm {
                                               const GridProperties<int>* intGridProperties,
                                               bool useOneMinusTableValue ) {
 
-        std::vector< double > values( size, 0 );
-
         const auto& imbnum = intGridProperties->getKeyword("IMBNUM");
         const auto& endnum = intGridProperties->getKeyword("ENDNUM");
 
@@ -739,28 +813,11 @@ namespace Opm {
         const int numSatTables = tabdims.getNumSatTables();
 
         imbnum.checkLimits( 1 , numSatTables );
-        // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
-        // this currently cannot be done because we would need the Z-coordinate of the
-        // cell and we would need to know how the simulator wants to interpolate between
-        // sampling points. Both of these are outside the scope of opm-parser, so we just
-        // assign a NaN in this case...
-        const bool useImptvd = tableManager->useImptvd();
-        const TableContainer& imptvdTables = tableManager->getImptvdTables();
-        const auto gridsize = eclipseGrid->getCartesianSize();
-        for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int imbTableIdx = imbnum.iget( cellIdx ) - 1;
-            int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-            values[cellIdx] = selectValue(imptvdTables,
-                                                (useImptvd && endNum >= 0) ? endNum : -1,
-                                                columnName,
-                                                cellDepth,
-                                                fallBackValues[imbTableIdx],
-                                                useOneMinusTableValue);
-        }
 
-        return values;
+        return regionApply( size, columnName, fallBackValues,
+                            imbnum.getData(), endnum.getData(),
+                            tableManager->useImptvd(), tableManager->getImptvdTables(),
+                            eclipseGrid, useOneMinusTableValue );
     }
 
     std::vector< double > SGLEndpoint( size_t size,
@@ -17,9 +17,11 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
@@ -84,6 +86,105 @@ namespace Opm {
         return m_multregtScanner.getRegionMultiplier(globalCellIndex1, globalCellIndex2, faceDir);
     }
 
+    std::vector<double> TransMult::getRegionMultipliers(const std::vector<size_t>& globalCellIndex1,
+                                                        const std::vector<size_t>& globalCellIndex2,
+                                                        const std::vector<FaceDir::DirEnum>& faceDir) const {
+        return m_multregtScanner.getRegionMultipliers(globalCellIndex1, globalCellIndex2, faceDir);
+    }
+
+    const std::vector<double>* TransMult::getDirectionData(FaceDir::DirEnum faceDir) const {
+        if (!hasDirectionProperty( faceDir ))
+            return nullptr;
+
+        return &m_trans.at( faceDir ).getData();
+    }
+
+    std::vector<double> TransMult::getFaceMultipliers(FaceDir::DirEnum faceDir) const {
+        size_t stride;
+        size_t dim;
+        FaceDir::DirEnum opposite;
+
+        switch (faceDir) {
+        case FaceDir::XPlus:
+            stride = 1;
+            dim = 0;
+            opposite = FaceDir::XMinus;
+            break;
+        case FaceDir::YPlus:
+            stride = m_nx;
+            dim = 1;
+            opposite = FaceDir::YMinus;
+            break;
+        case FaceDir::ZPlus:
+            stride = m_nx * m_ny;
+            dim = 2;
+            opposite = FaceDir::ZMinus;
+            break;
+        default:
+            throw std::invalid_argument("Face multipliers are only defined for the X+, Y+ and Z+ directions");
+        }
+
+        const size_t size = m_nx * m_ny * m_nz;
+        const auto hasNeighbour = [this, dim](size_t globalIndex) {
+            if (dim == 0)
+                return globalIndex % m_nx + 1 < m_nx;
+            if (dim == 1)
+                return globalIndex / m_nx % m_ny + 1 < m_ny;
+            return globalIndex / (m_nx * m_ny) + 1 < m_nz;
+        };
+
+        /* A direction property which is constant 1.0 is skipped without expanding it. */
+        const auto directionData = [this](FaceDir::DirEnum dir) -> const std::vector<double>* {
+            if (hasDirectionProperty( dir )) {
+                const auto& property = m_trans.at( dir );
+                if (property.isConstant() && property.iget( 0 ) == 1.0)
+                    return nullptr;
+            }
+            return getDirectionData( dir );
+        };
+
+        std::vector<double> multipliers( size, 1.0 );
+        const auto* plus = directionData( faceDir );
+        const auto* minus = directionData( opposite );
+        if (plus || minus) {
+            for (size_t globalIndex = 0; globalIndex < size; ++globalIndex) {
+                if (!hasNeighbour( globalIndex ))
+                    continue;
+
+                if (plus)
+                    multipliers[globalIndex] *= (*plus)[globalIndex];
+                if (minus)
+                    multipliers[globalIndex] *= (*minus)[globalIndex + stride];
+            }
+        }
+
+        /*
+          The region multipliers are resolved in chunks of faces, to
+          bound the size of the index lists passed to the scanner.
+        */
+        const size_t chunkSize = 65536;
+        std::vector<size_t> cells1;
+        std::vector<size_t> cells2;
+        std::vector<FaceDir::DirEnum> dirs;
+        for (size_t first = 0; first < size; first += chunkSize) {
+            cells1.clear();
+            cells2.clear();
+            for (size_t globalIndex = first; globalIndex < std::min(size, first + chunkSize); ++globalIndex) {
+                if (hasNeighbour( globalIndex )) {
+                    cells1.push_back( globalIndex );
+                    cells2.push_back( globalIndex + stride );
+                }
+            }
+
+            dirs.assign( cells1.size(), faceDir );
+            const auto regionMultipliers = m_multregtScanner.getRegionMultipliers( cells1, cells2, dirs );
+            for (size_t face = 0; face < cells1.size(); ++face)
+                multipliers[cells1[face]] *= regionMultipliers[face];
+        }
+
+        return multipliers;
+    }
+
     bool TransMult::hasDirectionProperty(FaceDir::DirEnum faceDir) const {
         return m_trans.count(faceDir) == 1;
     }
@@ -106,6 +207,14 @@ namespace Opm {
     {
         auto& dstProp = getDirectionProperty(faceDir);
 
+        if (srcProp.isConstant()) {
+            const double value = srcProp.getCartesianSize() > 0 ? srcProp.iget( 0 ) : 1.0;
+            if (!dstProp.compacted() && !dstProp.materialized())
+                dstProp.setScalar( 1.0, Box( m_nx, m_ny, m_nz ));
+            dstProp.scale( value, Box( m_nx, m_ny, m_nz ));
+            return;
+        }
+
         const std::vector<double> &srcData = srcProp.getData();
         for (size_t i = 0; i < srcData.size(); ++i)
             dstProp.multiplyValueAtIndex(i, srcData[i]);
@@ -119,10 +228,7 @@ namespace Opm {
             FaceDir::DirEnum faceDir = face.getDir();
             auto& multProperty = getDirectionProperty(faceDir);
 
-
-            for( auto globalIndex : face ) {
-                multProperty.multiplyValueAtIndex( globalIndex , transMult);
-            }
+            multProperty.scale( transMult , face.getBox() );
         }
     }
 
@@ -0,0 +1,141 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <opm/parser/eclipse/EclipseState/GridPartition.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellConnections.hpp>
+
+namespace Opm {
+
+    GridPartition::GridPartition(const GridDims& dims, std::vector<std::size_t> globalCells) :
+        m_cartesianSize( dims.getCartesianSize() ),
+        m_nx( dims.getNX() ),
+        m_nxny( dims.getNX() * dims.getNY() ),
+        m_globalCells( std::move( globalCells ) )
+    {
+        std::vector<std::size_t> order( m_globalCells.size() );
+        std::iota( order.begin(), order.end(), 0 );
+        std::sort( order.begin(), order.end(),
+                   [this](std::size_t a, std::size_t b) { return m_globalCells[a] < m_globalCells[b]; });
+
+        m_sorted.reserve( order.size() );
+        m_sortedLocal.reserve( order.size() );
+        for (const auto local : order) {
+            const auto global = m_globalCells[local];
+            if (global >= m_cartesianSize)
+                throw std::invalid_argument("Cell " + std::to_string( global ) + " is outside the grid");
+
+            if (!m_sorted.empty() && m_sorted.back() == global)
+                throw std::invalid_argument("Cell " + std::to_string( global ) + " is repeated in the partition");
+
+            m_sorted.push_back( global );
+            m_sortedLocal.push_back( local );
+        }
+    }
+
+
+    const std::vector<std::size_t>& GridPartition::globalCells() const {
+        return m_globalCells;
+    }
+
+
+    std::size_t GridPartition::size() const {
+        return m_globalCells.size();
+    }
+
+
+    bool GridPartition::contains(std::size_t globalIndex) const {
+        return std::binary_search( m_sorted.begin(), m_sorted.end(), globalIndex );
+    }
+
+
+    std::size_t GridPartition::localIndex(std::size_t globalIndex) const {
+        const auto iter = std::lower_bound( m_sorted.begin(), m_sorted.end(), globalIndex );
+        if (iter == m_sorted.end() || *iter != globalIndex)
+            throw std::invalid_argument("Cell " + std::to_string( globalIndex ) + " is not in the partition");
+
+        return m_sortedLocal[iter - m_sorted.begin()];
+    }
+
+
+    template< typename T >
+    std::vector<T> GridPartition::slice(const GridProperty<T>& property) const {
+        if (property.getCartesianSize() != m_cartesianSize)
+            throw std::invalid_argument("Property " + property.getKeywordName() + " does not match the grid of the partition");
+
+        const auto& data = property.getData();
+        std::vector<T> values;
+        values.reserve( m_globalCells.size() );
+        for (const auto global : m_globalCells)
+            values.push_back( data[global] );
+
+        return values;
+    }
+
+
+    std::vector<double> GridPartition::slice(const TransMult& transMult, FaceDir::DirEnum faceDir) const {
+        std::vector<double> values;
+        values.reserve( m_globalCells.size() );
+        for (const auto global : m_globalCells)
+            values.push_back( transMult.getMultiplier( global, faceDir ) );
+
+        return values;
+    }
+
+
+    NNC GridPartition::slice(const NNC& nnc) const {
+        NNC local;
+        for (const auto& data : nnc.nncdata()) {
+            if (this->contains( data.cell1 ) || this->contains( data.cell2 ))
+                local.addNNC( data.cell1, data.cell2, data.trans );
+        }
+        return local;
+    }
+
+
+    std::vector<const Well*> GridPartition::wells(const Schedule& schedule, std::size_t timeStep) const {
+        std::vector<const Well*> local;
+        for (const auto* well : schedule.getWells( timeStep )) {
+            const auto& connections = well->getConnections( timeStep );
+            const bool touches = std::any_of( connections.begin(), connections.end(),
+                                              [this](const Connection& connection) {
+                                                  const std::size_t global = connection.getI()
+                                                      + m_nx * connection.getJ()
+                                                      + m_nxny * connection.getK();
+                                                  return this->contains( global );
+                                              });
+            if (touches)
+                local.push_back( well );
+        }
+        return local;
+    }
+
+
+    template std::vector<int> GridPartition::slice(const GridProperty<int>&) const;
+    template std::vector<double> GridPartition::slice(const GridProperty<double>&) const;
+}
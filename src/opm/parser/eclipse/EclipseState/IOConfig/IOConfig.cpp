@@ -157,6 +157,52 @@ namespace Opm {
     }
 
 
+    bool IOConfig::getDeduplicateRST() const {
+        return this->dedup_rst;
+    }
+
+
+    void IOConfig::setDeduplicateRST(bool dedup_rst) {
+        this->dedup_rst = dedup_rst;
+    }
+
+
+    std::size_t IOConfig::getColumnarSummary() const {
+        return this->columnar_summary;
+    }
+
+
+    void IOConfig::setColumnarSummary(std::size_t chunk_steps) {
+        this->columnar_summary = chunk_steps;
+    }
+
+
+    void IOConfig::setSummaryRecording(std::size_t every_nth, double min_interval) {
+        this->summary_every_nth = every_nth;
+        this->summary_min_interval = min_interval;
+    }
+
+
+    std::size_t IOConfig::getSummaryRecordingSteps() const {
+        return this->summary_every_nth;
+    }
+
+
+    double IOConfig::getSummaryRecordingInterval() const {
+        return this->summary_min_interval;
+    }
+
+
+    void IOConfig::setSummaryCadence(char var_class, std::size_t every_nth) {
+        this->summary_cadence[var_class] = every_nth;
+    }
+
+
+    const std::map<char, std::size_t>& IOConfig::getSummaryCadence() const {
+        return this->summary_cadence;
+    }
+
+
     void IOConfig::overrideNOSIM(bool nosim) {
         m_nosim = nosim;
     }
@@ -531,6 +531,7 @@ void RestartConfig::handleScheduleSection(const SCHEDULESection& schedule, const
         handleSolutionSection( solution, parseContext );
         handleScheduleSection( schedule, parseContext );
 
+        compileOutputPlan( );
         initFirstOutput( );
     }
 
@@ -544,21 +545,51 @@ void RestartConfig::handleScheduleSection(const SCHEDULESection& schedule, const
         if (0 == timestep)
             return m_write_initial_RST_file;
 
-        if (save_keywords[timestep]) {
-            if ( log ) {
-                std::string logstring = "Fast restart using SAVE is not supported. Standard restart file is written instead";
-                Opm::OpmLog::warning("Unhandled output keyword", logstring);
-            }
-            return true;
+        if (log && save_keywords.at(timestep)) {
+            std::string logstring = "Fast restart using SAVE is not supported. Standard restart file is written instead";
+            Opm::OpmLog::warning("Unhandled output keyword", logstring);
         }
 
-        {
-            RestartSchedule ts_restart_config = getNode( timestep );
-            return ts_restart_config.writeRestartFile( timestep , m_timemap );
+        return write_restart.at( timestep );
+    }
+
+
+    void RestartConfig::compileOutputPlan( ) {
+        const size_t num_steps = m_timemap.size();
+        write_restart.assign( num_steps, false );
+        for (size_t step = 1; step < num_steps; step++)
+            write_restart[step] = save_keywords[step]
+                || getNode( step ).writeRestartFile( step , m_timemap );
+
+        /*
+          The report steps between two RPTRST/RPTSCHED keywords share
+          the same map in the DynamicState, so a new list is only
+          compiled when the address of the map changes.
+        */
+        selected_index.assign( num_steps, 0 );
+        selected_keywords.clear();
+        const std::map< std::string, int >* previous = nullptr;
+        for (size_t step = 0; step < num_steps; step++) {
+            const auto& keywords = restart_keywords.at( step );
+            if (&keywords != previous) {
+                std::vector< std::string > selected;
+                for (const auto& pair : keywords)
+                    if (pair.second != 0)
+                        selected.push_back( pair.first );
+
+                selected_keywords.push_back( std::move( selected ) );
+                previous = &keywords;
+            }
+            selected_index[step] = selected_keywords.size() - 1;
         }
     }
 
 
+    const std::vector< std::string >& RestartConfig::getSelectedKeywords( size_t timestep ) const {
+        return selected_keywords.at( selected_index.at( timestep ) );
+    }
+
+
     const std::map< std::string, int >& RestartConfig::getRestartKeywords( size_t timestep ) const {
         return restart_keywords.at( timestep );
     }
@@ -634,6 +665,7 @@ void RestartConfig::handleScheduleSection(const SCHEDULESection& schedule, const
         restart_schedule.globalReset( rs );
 
         setWriteInitialRestartFile( interval > 0 );
+        compileOutputPlan( );
     }
 
 
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstring>
 #include <cstdlib>
+#include <stdexcept>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionAST.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionContext.hpp>
@@ -113,68 +114,6 @@ void ASTNode::add_child(const ASTNode& child) {
     this->children.push_back(child);
 }
 
-double ASTNode::value(const ActionContext& context) const {
-    if (this->children.size() != 0)
-        throw std::invalid_argument("value() method should only reach leafnodes");
-
-    if (this->type == TokenType::number)
-        return this->number;
-
-    if (this->arg_list.size() == 0)
-        return context.get(this->func);
-    else {
-        std::string arg_key = this->arg_list[0];
-        for (size_t index = 1; index < this->arg_list.size(); index++)
-            arg_key += ":" + this->arg_list[index];
-        return context.get(this->func, arg_key);
-    }
-}
-
-
-bool ASTNode::eval(const ActionContext& context) const {
-    if (this->children.size() == 0)
-        throw std::invalid_argument("bool eval should not reach leafnodes");
-
-    if (this->type == TokenType::op_or || this->type == TokenType::op_and) {
-        bool value = (this->type == TokenType::op_and);
-        for (const auto& child : this->children) {
-            if (this->type == TokenType::op_or)
-                value = value || child.eval(context);
-            else
-                value = value && child.eval(context);
-        }
-        return value;
-    }
-
-    double v1 = this->children[0].value(context);
-    double v2 = this->children[1].value(context);
-
-    switch (this->type) {
-
-    case TokenType::op_eq:
-        return v1 == v2;
-
-    case TokenType::op_ge:
-        return v1 >= v2;
-
-    case TokenType::op_le:
-        return v1 <= v2;
-
-    case TokenType::op_ne:
-        return v1 != v2;
-
-    case TokenType::op_gt:
-        return v1 > v2;
-
-    case TokenType::op_lt:
-        return v1 < v2;
-
-    default:
-        throw std::invalid_argument("Incorrect operator type - expected comparison");
-    }
-}
-
-
 size_t ASTNode::size() const {
     return this->children.size();
 }
@@ -320,19 +259,217 @@ ASTNode ActionAST::parse_or(ActionParser& parser) {
 ActionAST::ActionAST(const std::vector<std::string>& tokens) {
     ActionParser parser(tokens);
     parser.next();
-    this->tree = this->parse_or(parser);
+    auto tree = this->parse_or(parser);
     auto current = parser.current();
     if (current.type != TokenType::end) {
         size_t index = parser.pos();
         throw std::invalid_argument("Extra unhandled data starting with token[" + std::to_string(index) + "] = " + current.value);
     }
 
-    if (this->tree.type == TokenType::error)
+    if (tree.type == TokenType::error)
         throw std::invalid_argument("Failed to parse");
+
+    this->compile(tree);
 }
 
+
+/*
+  AND and OR nodes are compiled to their children separated by conditional
+  jumps to the end of the node; the jumps are emitted with a placeholder
+  target which is patched when the end of the node is known.
+*/
+void ActionAST::compile(const ASTNode& node) {
+    if (node.type == TokenType::op_and || node.type == TokenType::op_or) {
+        const OpCode jump = (node.type == TokenType::op_and) ? OpCode::jump_if_false : OpCode::jump_if_true;
+        std::vector<std::size_t> jumps;
+
+        for (std::size_t index = 0; index < node.children.size(); index++) {
+            this->compile(node.children[index]);
+            if (index + 1 < node.children.size()) {
+                jumps.push_back(this->program.size());
+                this->program.push_back({jump, 0});
+            }
+        }
+
+        for (const auto& pos : jumps)
+            this->program[pos].arg = this->program.size();
+
+        return;
+    }
+
+    if (node.children.size() != 2)
+        throw std::invalid_argument("Incorrect operator type - expected comparison");
+
+    switch (node.type) {
+    case TokenType::op_eq:
+    case TokenType::op_ge:
+    case TokenType::op_le:
+    case TokenType::op_ne:
+    case TokenType::op_gt:
+    case TokenType::op_lt:
+        break;
+
+    default:
+        throw std::invalid_argument("Incorrect operator type - expected comparison");
+    }
+
+    Comparison cmp;
+    cmp.op = node.type;
+    cmp.lhs = this->compile_operand(node.children[0]);
+    cmp.rhs = this->compile_operand(node.children[1]);
+
+    this->program.push_back({OpCode::compare, this->comparisons.size()});
+    this->comparisons.push_back(cmp);
+}
+
+
+ActionAST::Operand ActionAST::compile_operand(const ASTNode& node) {
+    if (node.children.size() != 0)
+        throw std::invalid_argument("Comparison operands should be leafnodes");
+
+    if (node.type == TokenType::number)
+        return {true, node.number, 0};
+
+    std::string arg_key;
+    if (node.arg_list.size() > 0) {
+        arg_key = node.arg_list[0];
+        for (size_t index = 1; index < node.arg_list.size(); index++)
+            arg_key += ":" + node.arg_list[index];
+    }
+
+    const std::string name = arg_key.empty() ? node.func : node.func + ":" + arg_key;
+    for (std::size_t index = 0; index < this->keys.size(); index++) {
+        if (this->keys[index].name == name)
+            return {false, 0.0, index};
+    }
+
+    const bool wildcard = (arg_key.find_first_of("*?") != std::string::npos);
+    this->keys.push_back({name, node.func, arg_key, wildcard});
+    return {false, 0.0, this->keys.size() - 1};
+}
+
+
+void ActionAST::resolve(const ActionContext& context) const {
+    this->slots.clear();
+    this->slot_offset.assign(1, 0);
+
+    for (const auto& key : this->keys) {
+        if (key.wildcard)
+            context.resolve(key.func, key.arg, this->slots);
+        else {
+            ActionContext::Slot slot;
+            if (context.resolve(key.name, slot))
+                this->slots.push_back(slot);
+        }
+        this->slot_offset.push_back(this->slots.size());
+    }
+
+    this->resolved_layout = context.layout();
+}
+
+
+namespace {
+
+bool compare_values(TokenType op, double v1, double v2) {
+    switch (op) {
+
+    case TokenType::op_eq:
+        return v1 == v2;
+
+    case TokenType::op_ge:
+        return v1 >= v2;
+
+    case TokenType::op_le:
+        return v1 <= v2;
+
+    case TokenType::op_ne:
+        return v1 != v2;
+
+    case TokenType::op_gt:
+        return v1 > v2;
+
+    case TokenType::op_lt:
+        return v1 < v2;
+
+    default:
+        throw std::invalid_argument("Incorrect operator type - expected comparison");
+    }
+}
+
+}
+
+
+/*
+  A key which is not a wildcard must resolve to exactly one slot with a
+  value, otherwise the lookup fails with the same std::out_of_range as a
+  direct lookup in the context. A wildcard operand is the set of the
+  matching keys which have a value, and the comparison holds if it holds
+  for any of them.
+*/
+bool ActionAST::compare(const Comparison& cmp, const ActionContext& context) const {
+    std::size_t lhs_begin = 0, lhs_end = 1;
+    std::size_t rhs_begin = 0, rhs_end = 1;
+
+    if (!cmp.lhs.constant) {
+        lhs_begin = this->slot_offset[cmp.lhs.key];
+        lhs_end = this->slot_offset[cmp.lhs.key + 1];
+        if (!this->keys[cmp.lhs.key].wildcard && (lhs_begin == lhs_end || !context.has(this->slots[lhs_begin])))
+            throw std::out_of_range("No such key: " + this->keys[cmp.lhs.key].name);
+    }
+
+    if (!cmp.rhs.constant) {
+        rhs_begin = this->slot_offset[cmp.rhs.key];
+        rhs_end = this->slot_offset[cmp.rhs.key + 1];
+        if (!this->keys[cmp.rhs.key].wildcard && (rhs_begin == rhs_end || !context.has(this->slots[rhs_begin])))
+            throw std::out_of_range("No such key: " + this->keys[cmp.rhs.key].name);
+    }
+
+    for (std::size_t l = lhs_begin; l < lhs_end; l++) {
+        if (!cmp.lhs.constant && !context.has(this->slots[l]))
+            continue;
+
+        const double v1 = cmp.lhs.constant ? cmp.lhs.value : context.get(this->slots[l]);
+        for (std::size_t r = rhs_begin; r < rhs_end; r++) {
+            if (!cmp.rhs.constant && !context.has(this->slots[r]))
+                continue;
+
+            const double v2 = cmp.rhs.constant ? cmp.rhs.value : context.get(this->slots[r]);
+            if (compare_values(cmp.op, v1, v2))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
 bool ActionAST::eval(const ActionContext& context) const {
-    return this->tree.eval(context);
+    if (this->program.empty())
+        throw std::invalid_argument("bool eval should not reach leafnodes");
+
+    if (this->slot_offset.empty() || this->resolved_layout != context.layout())
+        this->resolve(context);
+
+    bool value = false;
+    std::size_t pc = 0;
+    while (pc < this->program.size()) {
+        const auto& inst = this->program[pc];
+        switch (inst.code) {
+        case OpCode::compare:
+            value = this->compare(this->comparisons[inst.arg], context);
+            pc++;
+            break;
+
+        case OpCode::jump_if_true:
+            pc = value ? inst.arg : pc + 1;
+            break;
+
+        case OpCode::jump_if_false:
+            pc = value ? pc + 1 : inst.arg;
+            break;
+        }
+    }
+    return value;
 }
 
 }
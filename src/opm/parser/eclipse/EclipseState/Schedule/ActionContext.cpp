@@ -17,25 +17,61 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <ert/util/util.h>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionContext.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
 namespace Opm {
 
+namespace {
+
+    void match_keys(const SummaryState& st, const SummaryState* shadow, const std::string& prefix, const std::string& pattern, std::vector<ActionContext::Slot>& slots) {
+        const bool local = (shadow == nullptr);
+        for (std::size_t index = 0; index < st.size(); index++) {
+            const auto& key = st.key(index);
+            if (key.compare(0, prefix.size(), prefix) != 0)
+                continue;
+
+            std::size_t shadow_index;
+            if (shadow && shadow->find(key, shadow_index))
+                continue;
+
+            if (util_fnmatch(pattern.c_str(), key.c_str() + prefix.size()) == 0)
+                slots.push_back({local, index});
+        }
+    }
+
+
+    /*
+      The month values every context starts with; the contexts are
+      copies of the same state, and share its layout.
+    */
+    const SummaryState& month_values() {
+        static const SummaryState values = []() {
+            SummaryState st;
+            for (const auto& pair : TimeMap::eclipseMonthIndices())
+                st.add(pair.first, pair.second);
+            return st;
+        }();
+        return values;
+    }
+
+}
+
     void ActionContext::add(const std::string& func, const std::string& arg, double value) {
-        this->values[func + ":" + arg] = value;
+        this->values.add(func + ":" + arg, value);
     }
 
     ActionContext::ActionContext(const SummaryState& summary_state_arg) :
-        summary_state(summary_state_arg)
+        summary_state(summary_state_arg),
+        values(month_values())
     {
-        for (const auto& pair : TimeMap::eclipseMonthIndices())
-            this->add(pair.first, pair.second);
     }
 
     void ActionContext::add(const std::string& func, double value) {
-        this->values[func] = value;
+        this->values.add(func, value);
     }
 
 
@@ -44,10 +80,35 @@ namespace Opm {
     }
 
     double ActionContext::get(const std::string& key) const {
-        const auto& iter = this->values.find(key);
-        if (iter != this->values.end())
-            return iter->second;
+        if (this->values.has(key))
+            return this->values.get(key);
 
         return this->summary_state.get(key);
     }
+
+
+    bool ActionContext::resolve(const std::string& key, Slot& slot) const {
+        std::size_t index;
+        if (this->values.find(key, index)) {
+            slot = {true, index};
+            return true;
+        }
+
+        if (this->summary_state.find(key, index)) {
+            slot = {false, index};
+            return true;
+        }
+
+        return false;
+    }
+
+    void ActionContext::resolve(const std::string& func, const std::string& pattern, std::vector<Slot>& slots) const {
+        const std::string prefix = func + ":";
+        match_keys(this->values, nullptr, prefix, pattern, slots);
+        match_keys(this->summary_state, &this->values, prefix, pattern, slots);
+    }
+
+    std::pair<std::size_t, std::size_t> ActionContext::layout() const {
+        return {this->summary_state.layout(), this->values.layout()};
+    }
 }
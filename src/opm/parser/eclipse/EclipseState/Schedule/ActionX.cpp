@@ -17,6 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
 
@@ -92,4 +96,16 @@ bool ActionX::ready(std::time_t sim_time) const {
 }
 
 
+std::time_t ActionX::next_time() const {
+    if (this->run_count >= this->max_run())
+        return std::numeric_limits<std::time_t>::max();
+
+    if (this->run_count == 0 || this->min_wait() <= 0)
+        return this->start_time();
+
+    std::time_t wait_end = this->last_run + static_cast<std::time_t>(std::floor(this->min_wait())) + 1;
+    return std::max(this->start_time(), wait_end);
+}
+
+
 }
@@ -17,6 +17,9 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <limits>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/Actions.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
 
@@ -38,31 +41,77 @@ void Actions::add(const ActionX& action) {
         this->actions.erase(iter);
 
     this->actions.insert(std::pair<std::string,ActionX>(action.name(), action));
+    this->touched.erase(action.name());
+    this->schedule(action.name());
 }
 
 ActionX& Actions::at(const std::string& name) {
-    return this->actions.at(name);
+    auto& action = this->actions.at(name);
+    this->touched.insert(name);
+    return action;
 }
 
 
 bool Actions::ready(std::time_t sim_time) const {
-    for (const auto& pair : this->actions) {
-        if (pair.second.ready(sim_time))
-            return true;
+    this->requeue();
+    while (!this->queue.empty()) {
+        const auto& top = this->queue.top();
+        if (this->queued.at(top.name) == top.seq)
+            return top.time <= sim_time && this->actions.at(top.name).ready(sim_time);
+
+        this->queue.pop();
     }
     return false;
 }
 
 
+/*
+  The due actions are returned in name order, like the order of the
+  actions map.
+*/
 std::vector<ActionX *> Actions::pending(std::time_t sim_time) {
     std::vector<ActionX *> action_vector;
-    for (auto& pair : this->actions) {
-        auto& action = pair.second;
+    this->requeue();
+    while (!this->queue.empty() && this->queue.top().time <= sim_time) {
+        const auto name = this->queue.top().name;
+        const auto entry_seq = this->queue.top().seq;
+        this->queue.pop();
+        if (this->queued.at(name) != entry_seq)
+            continue;
+
+        auto& action = this->actions.at(name);
+        this->touched.insert(name);
         if (action.ready(sim_time))
             action_vector.push_back( &action );
     }
+
+    std::sort(action_vector.begin(), action_vector.end(),
+              [](const ActionX* a, const ActionX* b) { return a->name() < b->name(); });
     return action_vector;
 }
 
 
+bool Actions::Entry::operator>(const Entry& other) const {
+    if (this->time != other.time)
+        return this->time > other.time;
+    return this->seq > other.seq;
+}
+
+
+void Actions::schedule(const std::string& name) const {
+    const auto time = this->actions.at(name).next_time();
+    this->seq += 1;
+    this->queued[name] = this->seq;
+    if (time != std::numeric_limits<std::time_t>::max())
+        this->queue.push( Entry{ time, this->seq, name } );
+}
+
+
+void Actions::requeue() const {
+    for (const auto& name : this->touched)
+        this->schedule(name);
+    this->touched.clear();
+}
+
+
 }
@@ -16,6 +16,7 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
 #include <cstddef>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
@@ -37,7 +38,56 @@ namespace Opm {
 
 
     void Events::addEvent(ScheduleEvents::Events event, size_t reportStep) {
-        m_events[reportStep] |= event;
+        const uint64_t mask = event;
+        if ((m_events[reportStep] & mask) == mask)
+            return;
+
+        m_events[reportStep] |= mask;
+        for (size_t bit = 0; bit < 64; bit++) {
+            if (!(mask & (uint64_t(1) << bit)))
+                continue;
+
+            if (m_eventSteps.size() <= bit)
+                m_eventSteps.resize(bit + 1);
+
+            auto& steps = m_eventSteps[bit];
+            auto pos = std::lower_bound(steps.begin(), steps.end(), reportStep);
+            if (pos == steps.end() || *pos != reportStep)
+                steps.insert(pos, reportStep);
+        }
+    }
+
+
+    int Events::nextEvent(uint64_t eventMask, size_t fromStep) const {
+        int next = -1;
+        for (size_t bit = 0; bit < m_eventSteps.size(); bit++) {
+            if (!(eventMask & (uint64_t(1) << bit)))
+                continue;
+
+            const auto& steps = m_eventSteps[bit];
+            auto pos = std::lower_bound(steps.begin(), steps.end(), fromStep);
+            if (pos == steps.end())
+                continue;
+
+            if (next < 0 || static_cast<size_t>(next) > *pos)
+                next = static_cast<int>(*pos);
+        }
+        return next;
+    }
+
+
+    bool Events::anyEvent(uint64_t eventMask, size_t firstStep, size_t lastStep) const {
+        int next = this->nextEvent(eventMask, firstStep);
+        return next >= 0 && static_cast<size_t>(next) <= lastStep;
+    }
+
+
+    size_t Events::memory_usage() const {
+        size_t bytes = this->m_events.memory_usage() + MemoryUsage::heap( this->m_eventSteps );
+        for (const auto& steps : this->m_eventSteps)
+            bytes += MemoryUsage::heap( steps );
+
+        return bytes;
     }
 
 }
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
 
@@ -52,6 +53,8 @@ void GroupTree::update( const std::string& name, const std::string& other_parent
     if( other_parent.empty() )
         throw std::invalid_argument( "Parent group must have a name." );
 
+    this->index_cache.reset();
+
     auto root = this->find( other_parent );
     if( root == this->groups.end() || root->name != other_parent ) 
         this->groups.insert( root, 1, group { other_parent, "FIELD" } );
@@ -96,9 +99,9 @@ bool GroupTree::exists( const std::string& name ) const {
 }
 
 const std::string& GroupTree::parent( const std::string& name ) const {
-    auto node = std::find( this->groups.begin(), this->groups.end(), name );
+    auto node = std::lower_bound( this->groups.begin(), this->groups.end(), name );
 
-    if( node == this->groups.end() )
+    if( node == this->groups.end() || node->name != name )
         throw std::out_of_range( "No such parent '" + name + "'." );
 
     return node->parent;
@@ -108,18 +111,119 @@ std::vector< std::string > GroupTree::children( const std::string& other_parent
     if( !this->exists( other_parent ) )
         throw std::out_of_range( "Node '" + other_parent + "' does not exist." );
 
+    const auto& idx = this->index();
+    const auto node = idx.find( other_parent );
+
     std::vector< std::string > kids;
-    /*    for( const auto& node : this->groups ) {
-        if( node.parent != other_parent ) continue;
-        kids.push_back( node.name );
+    for( auto i = idx.child_offsets[ node ]; i < idx.child_offsets[ node + 1 ]; i++ )
+        kids.push_back( idx.names[ idx.child_list[ i ] ] );
+
+    return kids;
+}
+
+const GroupTree::Index& GroupTree::index() const {
+    if( this->index_cache.built )
+        return this->index_cache.index;
+
+    std::lock_guard< std::mutex > lock( this->index_cache.build_mutex );
+    if( this->index_cache.built )
+        return this->index_cache.index;
+
+    const auto npos = Index::npos;
+    const auto size = this->groups.size();
+    auto& idx = this->index_cache.index;
+
+    idx = Index{};
+    idx.parent.assign( size, npos );
+    idx.level.assign( size, 0 );
+    for( const auto& node : this->groups )
+        idx.names.push_back( node.name );
+
+    /* Counting sort of the nodes on their parent; the children of a node end up in name order. */
+    idx.child_offsets.assign( size + 1, 0 );
+    for( size_t node = 0; node < size; node++ ) {
+        const auto& parent_name = this->groups[ node ].parent;
+        if( parent_name.empty() ) {
+            idx.root = node;
+            continue;
+        }
+
+        idx.parent[ node ] = idx.find( parent_name );
+        idx.child_offsets[ idx.parent[ node ] + 1 ]++;
+    }
+
+    for( size_t node = 0; node < size; node++ )
+        idx.child_offsets[ node + 1 ] += idx.child_offsets[ node ];
+
+    idx.child_list.resize( idx.child_offsets.back() );
+    auto insert_pos = idx.child_offsets;
+    for( size_t node = 0; node < size; node++ ) {
+        if( idx.parent[ node ] != npos )
+            idx.child_list[ insert_pos[ idx.parent[ node ] ]++ ] = node;
     }
-*/ 
-    for( auto it = this->groups.begin(); it != this->groups.end(); it++ ) {
-        if( (*it).parent != other_parent ) continue;
-        kids.push_back( (*it).name );
+
+    if( idx.root != npos ) {
+        /* Iterative depth first traversal; the stack holds a node and its next child. */
+        std::vector< std::pair< size_t, size_t > > stack = { { idx.root, idx.child_offsets[ idx.root ] } };
+        idx.preorder.push_back( idx.root );
+        while( !stack.empty() ) {
+            auto& top = stack.back();
+            const auto node = top.first;
+            if( top.second == idx.child_offsets[ node + 1 ] ) {
+                idx.postorder.push_back( node );
+                stack.pop_back();
+                continue;
+            }
+
+            const auto child = idx.child_list[ top.second++ ];
+            idx.level[ child ] = idx.level[ node ] + 1;
+            idx.preorder.push_back( child );
+            stack.emplace_back( child, idx.child_offsets[ child ] );
+        }
     }
 
-    return kids;
+    this->index_cache.built = true;
+    return idx;
+}
+
+const std::size_t GroupTree::Index::npos;
+
+std::size_t GroupTree::Index::size() const {
+    return this->names.size();
+}
+
+std::size_t GroupTree::Index::find( const std::string& name ) const {
+    auto iter = std::lower_bound( this->names.begin(), this->names.end(), name );
+    if( iter == this->names.end() || *iter != name )
+        throw std::out_of_range( "Node '" + name + "' does not exist." );
+
+    return iter - this->names.begin();
+}
+
+std::size_t GroupTree::Index::numChildren( std::size_t node ) const {
+    return this->child_offsets[ node + 1 ] - this->child_offsets[ node ];
+}
+
+void GroupTree::Index::accumulate( std::vector< double >& values ) const {
+    if( values.size() != this->size() )
+        throw std::invalid_argument( "Must have one value for every node of the group tree." );
+
+    for( const auto node : this->postorder ) {
+        if( this->parent[ node ] != npos )
+            values[ this->parent[ node ] ] += values[ node ];
+    }
+}
+
+GroupTree::IndexCache& GroupTree::IndexCache::operator=(const IndexCache&) {
+    std::lock_guard< std::mutex > lock( this->build_mutex );
+    this->index = Index{};
+    this->built = false;
+    return *this;
+}
+
+void GroupTree::IndexCache::reset() {
+    this->index = Index{};
+    this->built = false;
 }
 
 bool GroupTree::operator==( const GroupTree& rhs ) const {
@@ -17,8 +17,12 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
 
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
@@ -32,6 +36,71 @@
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The total lengths of the segments of every branch, paired with the
+      position of the segment in the WellSegments set, in increasing
+      order.
+    */
+    using BranchLengths = std::unordered_map< int, std::vector< std::pair< double, int > > >;
+
+    BranchLengths branchLengths(const WellSegments& segment_set) {
+        BranchLengths branches;
+        for (int i_segment = 0; i_segment < segment_set.size(); ++i_segment) {
+            const Segment& segment = segment_set[i_segment];
+            branches[segment.branchNumber()].emplace_back(segment.totalLength(), i_segment);
+        }
+
+        for (auto& branch : branches)
+            std::sort(branch.second.begin(), branch.second.end());
+
+        return branches;
+    }
+
+    /*
+      The position of the segment whose total length is closest to
+      distance, the first one in the WellSegments set on ties, or -1 if
+      the branch has no segments.
+    */
+    int closestSegment(const BranchLengths& branches, int branch_number, double distance) {
+        const auto branch = branches.find(branch_number);
+        if (branch == branches.end())
+            return -1;
+
+        // Only the lengths nearest to distance from above and below can
+        // be closest; within a run of equal lengths the first one has
+        // the lowest position.
+        const auto& lengths = branch->second;
+        const auto above = std::lower_bound(lengths.begin(), lengths.end(),
+                                            std::make_pair(distance, std::numeric_limits< int >::min()));
+
+        int closest = -1;
+        double min_distance_difference = 1.e100; // begin with a big value
+        auto consider = [&](std::vector< std::pair< double, int > >::const_iterator candidate) {
+            const double distance_difference = std::abs(distance - candidate->first);
+            if (distance_difference < min_distance_difference ||
+                (distance_difference == min_distance_difference && candidate->second < closest)) {
+                min_distance_difference = distance_difference;
+                closest = candidate->second;
+            }
+        };
+
+        if (above != lengths.end())
+            consider(above);
+
+        if (above != lengths.begin()) {
+            auto below = std::prev(above);
+            while (below != lengths.begin() && std::prev(below)->first == below->first)
+                below = std::prev(below);
+            consider(below);
+        }
+
+        return closest;
+    }
+
+} // anonymous namespace
+
 
     Compsegs::Compsegs(int i_in, int j_in, int k_in, int branch_number_in, double distance_start_in, double distance_end_in,
                        WellCompletion::DirectionEnum dir_in, double center_depth_in, int segment_number_in, size_t seqIndex_in)
@@ -146,6 +215,8 @@ namespace Opm {
     void Compsegs::processCOMPSEGS(std::vector< Compsegs >& compsegs, const WellSegments& segment_set) {
         // for the current cases we have at the moment, the distance information is specified explicitly,
         // while the depth information is defaulted though, which need to be obtained from the related segment
+        BranchLengths branches;
+        bool has_branches = false;
         for( auto& compseg : compsegs ) {
 
             // need to determine the related segment number first
@@ -155,19 +226,15 @@ namespace Opm {
             const int branch_number = compseg.m_branch_number;
 
             int segment_number = 0;
-            double min_distance_difference = 1.e100; // begin with a big value
-            for (int i_segment = 0; i_segment < segment_set.size(); ++i_segment) {
-                const Segment& current_segment = segment_set[i_segment];
-                if( branch_number != current_segment.branchNumber() ) continue;
-
-                const double distance = current_segment.totalLength();
-                const double distance_difference = std::abs(center_distance - distance);
-                if (distance_difference < min_distance_difference) {
-                    min_distance_difference = distance_difference;
-                    segment_number = current_segment.segmentNumber();
-                }
+            if (!has_branches) {
+                branches = branchLengths(segment_set);
+                has_branches = true;
             }
 
+            const int closest = closestSegment(branches, branch_number, center_distance);
+            if (closest >= 0)
+                segment_number = segment_set[closest].segmentNumber();
+
             if (segment_number == 0) {
                 throw std::runtime_error("The perforation failed in finding a related segment \n");
             }
@@ -242,12 +309,23 @@ namespace Opm {
 						const EclipseGrid& grid,
                                                 WellConnections& connection_set) {
 
+        // The position of the first connection in every cell.
+        std::unordered_map< size_t, size_t > connection_index;
+        for (size_t ic = 0; ic < connection_set.size(); ++ic) {
+            const auto& connection = connection_set.get(ic);
+            connection_index.emplace(grid.getGlobalIndex(connection.getI(), connection.getJ(), connection.getK()), ic);
+        }
+
         for( const auto& compseg : compsegs ) {
             const int i = compseg.m_i;
             const int j = compseg.m_j;
             const int k = compseg.m_k;
 	    if (grid.cellActive(i, j, k)) {
-		Connection& connection = connection_set.getFromIJK( i, j, k );
+		const auto index = connection_index.find(grid.getGlobalIndex(i, j, k));
+		if (index == connection_index.end())
+		    throw std::runtime_error(" the connection is not found! \n ");
+
+		Connection& connection = connection_set.get( index->second );
 		connection.updateSegment(compseg.segment_number, compseg.center_depth,compseg.m_seqIndex);
 
 		//keep connection sequence number from input sequence
@@ -19,13 +19,16 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
-#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES
 #include <math.h>
 #endif
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
@@ -35,6 +38,20 @@
 
 namespace Opm {
 
+namespace {
+
+    void setSegmentIndex(std::vector<int>& segment_number_to_index, const int segment_number, const int index) {
+        if (segment_number < 0) {
+            throw std::logic_error("illegal segment number " + std::to_string(segment_number) + "\n");
+        }
+        if (static_cast<size_t>(segment_number) >= segment_number_to_index.size()) {
+            segment_number_to_index.resize(segment_number + 1, -1);
+        }
+        segment_number_to_index[segment_number] = index;
+    }
+
+}
+
     std::string WellSegments::wellName() const {
         return m_well_name;
     }
@@ -76,12 +93,10 @@ namespace Opm {
     }
 
     int WellSegments::segmentNumberToIndex(const int segment_number) const {
-        const auto it = segment_number_to_index.find(segment_number);
-        if (it != segment_number_to_index.end()) {
-            return it->second;
-        } else {
+        if (segment_number < 0 || static_cast<size_t>(segment_number) >= segment_number_to_index.size()) {
             return -1;
         }
+        return segment_number_to_index[segment_number];
     }
 
     void WellSegments::addSegment( Segment new_segment ) {
@@ -91,7 +106,7 @@ namespace Opm {
        const int segment_index = segmentNumberToIndex(segment_number);
 
        if (segment_index < 0) { // it is a new segment
-           segment_number_to_index[segment_number] = size();
+           setSegmentIndex(segment_number_to_index, segment_number, size());
            m_segments.push_back(new_segment);
        } else { // the segment already exists
            m_segments[segment_index] = new_segment;
@@ -106,6 +121,7 @@ namespace Opm {
         m_well_name = record1.getItem("WELL").getTrimmedString(0);
 
         m_segments.clear();
+        segment_number_to_index.clear();
 
         const double invalid_value = Segment::invalidValue(); // meaningless value to indicate unspecified values
 
@@ -203,7 +219,7 @@ namespace Opm {
             if (index >= 0) { // found in the existing m_segments already
                 throw std::logic_error("Segments with same segment number are found!\n");
             }
-            segment_number_to_index[segment_number] = i_segment;
+            setSegmentIndex(segment_number_to_index, segment_number, i_segment);
         }
 
         for (size_t i_segment = 0; i_segment < m_segments.size(); ++i_segment) {
@@ -212,7 +228,11 @@ namespace Opm {
             if (outlet_segment <= 0) { // no outlet segment
                 continue;
             }
-            const int outlet_segment_index = segment_number_to_index[outlet_segment];
+            const int outlet_segment_index = segmentNumberToIndex(outlet_segment);
+            if (outlet_segment_index < 0) {
+                throw std::logic_error("The outlet segment " + std::to_string(outlet_segment)
+                                       + " of segment " + std::to_string(segment_number) + " does not exist in WELSEGS!\n");
+            }
             m_segments[outlet_segment_index].addInletSegment(segment_number);
         }
 
@@ -350,9 +370,9 @@ namespace Opm {
         int current_index= 1;
 
         // clear the mapping from segment number to store index
-        segment_number_to_index.clear();
+        segment_number_to_index.assign(segment_number_to_index.size(), -1);
         // for the top segment
-        segment_number_to_index[1] = 0;
+        setSegmentIndex(segment_number_to_index, 1, 0);
 
         while (current_index< size()) {
             // the branch number of the last segment that is done re-ordering
@@ -390,7 +410,7 @@ namespace Opm {
                 std::swap(m_segments[current_index], m_segments[target_segment_index]);
             }
             const int segment_number = m_segments[current_index].segmentNumber();
-            segment_number_to_index[segment_number] = current_index;
+            setSegmentIndex(segment_number_to_index, segment_number, current_index);
             current_index++;
         }
     }
@@ -405,16 +425,24 @@ namespace Opm {
             && this->m_comp_pressure_drop == rhs.m_comp_pressure_drop
             && this->m_multiphase_model == rhs.m_multiphase_model
             && this->m_segments.size() == rhs.m_segments.size()
-            && this->segment_number_to_index.size() == rhs.segment_number_to_index.size()
             && std::equal( this->m_segments.begin(),
                            this->m_segments.end(),
                            rhs.m_segments.begin() )
-            && std::equal( this->segment_number_to_index.begin(),
-                           this->segment_number_to_index.end(),
-                           rhs.segment_number_to_index.begin() );
+            && this->segment_number_to_index == rhs.segment_number_to_index;
     }
 
     bool WellSegments::operator!=( const WellSegments& rhs ) const {
         return !( *this == rhs );
     }
+
+    size_t WellSegments::memory_usage() const {
+        size_t bytes = MemoryUsage::heap( m_well_name )
+                     + MemoryUsage::heap( m_segments )
+                     + MemoryUsage::heap( segment_number_to_index );
+
+        for (const auto& segment : m_segments)
+            bytes += MemoryUsage::heap( segment.inletSegments() );
+
+        return bytes;
+    }
 }
@@ -17,7 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <exception>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -27,12 +30,14 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/V.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/W.hpp>
@@ -63,6 +68,37 @@
 
 namespace Opm {
 
+namespace {
+
+    /*
+      Brings the matches of a pattern ending in '*' up to date with the
+      items added since the previous lookup. A pattern without other
+      special characters is a plain prefix and is compared directly,
+      everything else goes through the fnmatch() based predicate.
+    */
+    template< typename T, typename Matches, typename Predicate >
+    const std::vector< std::size_t >& updateMatches( Matches& matches,
+                                                     const OrderedMap< T >& items,
+                                                     const std::string& pattern,
+                                                     Predicate inPattern ) {
+        const bool prefix = pattern.find_first_of( "?[\\" ) == std::string::npos;
+        const std::size_t prefix_size = pattern.size() - 1;
+
+        for (; matches.checked < items.size(); matches.checked++) {
+            const auto& name = items.get( matches.checked ).name();
+            const bool match = prefix
+                ? name.compare( 0, prefix_size, pattern, 0, prefix_size ) == 0
+                : inPattern( name, pattern );
+
+            if (match)
+                matches.index.push_back( matches.checked );
+        }
+
+        return matches.index;
+    }
+
+}
+
     static std::set<std::string> actionx_whitelist = {"WELSPECS","WELOPEN"};
 
 
@@ -70,7 +106,8 @@ namespace Opm {
                         const EclipseGrid& grid,
                         const Eclipse3DProperties& eclipseProperties,
                         const Runspec &runspec,
-                        const ParseContext& parseContext) :
+                        const ParseContext& parseContext,
+                        size_t restartStep) :
         m_timeMap( deck ),
         m_rootGroupTree( this->m_timeMap, GroupTree{} ),
         m_oilvaporizationproperties( this->m_timeMap, OilVaporizationProperties(runspec.tabdims().getNumPVTTables()) ),
@@ -79,8 +116,10 @@ namespace Opm {
         m_tuning( this->m_timeMap ),
         m_messageLimits( this->m_timeMap ),
         m_runspec( runspec ),
-        wtest_config(this->m_timeMap, std::make_shared<WellTestConfig>() )
+        wtest_config(this->m_timeMap, std::make_shared<WellTestConfig>() ),
+        m_restartStep( std::min( restartStep, this->m_timeMap.size() - 1 ) )
     {
+        PhaseTimer::Scope phase("Schedule");
         m_controlModeWHISTCTL = WellProducer::CMODE_UNDEFINED;
         addGroup( "FIELD", 0 );
 
@@ -98,17 +137,30 @@ namespace Opm {
                 handleMESSAGES(keyword, 0);
         }
 
-        if (Section::hasSCHEDULE(deck))
-            iterateScheduleSection( parseContext, SCHEDULESection( deck ), grid, eclipseProperties );
+        if (Section::hasSCHEDULE(deck)) {
+            const SCHEDULESection section( deck );
+            iterateScheduleSection( parseContext, section, grid, eclipseProperties );
+
+            for (const auto& keyword : section)
+                this->m_inputFingerprint.add( keyword.fingerprint() );
+        }
+
+        for (auto& well : this->m_wells)
+            well.updateFingerprints();
+        this->updateFingerprints();
+
+        if (MemoryUsage::enabled())
+            MemoryUsage::log( this->memory_usage() );
     }
 
 
-    Schedule::Schedule(const Deck& deck, const EclipseState& es, const ParseContext& parse_context) :
+    Schedule::Schedule(const Deck& deck, const EclipseState& es, const ParseContext& parse_context, size_t restartStep) :
         Schedule(deck,
                  es.getInputGrid(),
                  es.get3DProperties(),
                  es.runspec(),
-                 parse_context)
+                 parse_context,
+                 restartStep)
     {}
 
 
@@ -119,6 +171,10 @@ namespace Opm {
         return this->posixStartTime( );
     }
 
+    size_t Schedule::restartStep() const {
+        return this->m_restartStep;
+    }
+
     time_t Schedule::posixStartTime() const {
         return m_timeMap.getStartTime( 0 );
     }
@@ -334,15 +390,24 @@ namespace Opm {
                         action.addKeyword(action_keyword);
                 }
                 this->actions.add(action);
-            } else
-                this->handleKeyword(currentStep, section, keywordIdx, keyword, parseContext, grid, eclipseProperties, unit_system, rftProperties);
+            } else {
+                /*
+                  Before the restart step the keywords are applied at step
+                  zero; DATES and TSTEP still advance the report step.
+                */
+                ParseProfile::Consume consume(keyword.name());
+                size_t step = (currentStep < this->m_restartStep) ? 0 : currentStep;
+                const size_t appliedStep = step;
+                this->handleKeyword(step, section, keywordIdx, keyword, parseContext, grid, eclipseProperties, unit_system, rftProperties);
+                currentStep += step - appliedStep;
+            }
 
             keywordIdx++;
             if (keywordIdx == section.size())
                 break;
         }
 
-        checkIfAllConnectionsIsShut(currentStep);
+        checkIfAllConnectionsIsShut((currentStep < this->m_restartStep) ? 0 : currentStep);
 
         for (auto rftPair = rftProperties.begin(); rftPair != rftProperties.end(); ++rftPair) {
             const DeckKeyword& keyword = *rftPair->first;
@@ -440,9 +505,6 @@ namespace Opm {
     void Schedule::handleWELSPECS( const SCHEDULESection& section,
                                    size_t index,
                                    size_t currentStep ) {
-        bool needNewTree = false;
-        auto newTree = m_rootGroupTree.get(currentStep);
-
         const auto COMPORD_in_timestep = [&]() -> const DeckKeyword* {
             auto itr = section.begin() + index;
             for( ; itr != section.end(); ++itr ) {
@@ -454,7 +516,15 @@ namespace Opm {
             return nullptr;
         };
 
-        const auto& keyword = section.getKeyword( index );
+        handleWELSPECS( section.getKeyword( index ), currentStep, COMPORD_in_timestep() );
+    }
+
+
+    void Schedule::handleWELSPECS( const DeckKeyword& keyword,
+                                   size_t currentStep,
+                                   const DeckKeyword* compordp ) {
+        bool needNewTree = false;
+        auto newTree = m_rootGroupTree.get(currentStep);
 
         for (size_t recordNr = 0; recordNr < keyword.size(); recordNr++) {
             const auto& record = keyword.getRecord(recordNr);
@@ -468,7 +538,7 @@ namespace Opm {
             if (!hasWell(wellName)) {
                 WellCompletion::CompletionOrderEnum wellConnectionOrder = WellCompletion::TRACK;
 
-                if( const auto* compordp = COMPORD_in_timestep() ) {
+                if( compordp ) {
                      const auto& compord = *compordp;
 
                     for (size_t compordRecordNr = 0; compordRecordNr < compord.size(); compordRecordNr++) {
@@ -489,9 +559,13 @@ namespace Opm {
 
             const auto headI = record.getItem( "HEAD_I" ).get< int >( 0 ) - 1;
             const auto headJ = record.getItem( "HEAD_J" ).get< int >( 0 ) - 1;
-            if (!new_well)
+            if (!new_well) {
                 currentWell.addEvent( ScheduleEvents::WELL_WELSPECS_UPDATE , currentStep );
 
+                if (currentWell.getGroupName( currentStep ) != groupName)
+                    m_events.addEvent( ScheduleEvents::WELL_GROUP_CHANGE , currentStep );
+            }
+
             if( currentWell.getHeadI() != headI ) {
                 std::string msg = "HEAD_I changed for well " + currentWell.name();
                 OpmLog::info(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
@@ -616,7 +690,7 @@ namespace Opm {
                 }
 
                 updateWellStatus( *well , currentStep , status );
-                if (well->setProductionProperties(currentStep, properties))
+                if (well->setProductionProperties(currentStep, this->m_wellProperties.intern(properties)))
                     m_events.addEvent( ScheduleEvents::PRODUCTION_UPDATE , currentStep);
 
                 if ( !well->getAllowCrossFlow() && !isPredictionMode && (properties.OilRate + properties.WaterRate + properties.GasRate) == 0 ) {
@@ -722,7 +796,7 @@ namespace Opm {
                     }
                 }
 
-                if (well->setInjectionProperties(currentStep, properties))
+                if (well->setInjectionProperties(currentStep, this->m_wellProperties.intern(properties)))
                     m_events.addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
 
                 // if the well has zero surface rate limit or reservior rate limit, while does not allow crossflow,
@@ -765,7 +839,7 @@ namespace Opm {
                 if (!group_salt_item.defaultApplied(0)) {
                     throw std::logic_error("Sorry explicit setting of \'GROUP_SALT_CONCENTRATION\' is not supported!");
                 }
-                well->setPolymerProperties(currentStep, properties);
+                well->setPolymerProperties(currentStep, this->m_wellProperties.intern(properties));
             }
         }
     }
@@ -788,7 +862,7 @@ namespace Opm {
                 }
                 WellPolymerProperties properties(well->getPolymerProperties(currentStep));
                 properties.m_plymwinjtable = record.getItem("TABLE_NUMBER").get<int>(0);
-                well->setPolymerProperties(currentStep, properties);
+                well->setPolymerProperties(currentStep, this->m_wellProperties.intern(properties));
             }
         }
     }
@@ -812,7 +886,7 @@ namespace Opm {
                 WellPolymerProperties properties(well->getPolymerProperties(currentStep));
                 properties.m_skprwattable = record.getItem("TABLE_NUMBER_WATER").get<int>(0);
                 properties.m_skprpolytable = record.getItem("TABLE_NUMBER_POLYMER").get<int>(0);
-                well->setPolymerProperties(currentStep, properties);
+                well->setPolymerProperties(currentStep, this->m_wellProperties.intern(properties));
             }
         }
     }
@@ -828,7 +902,7 @@ namespace Opm {
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
 
             for( auto* well : wells ) {
-                well->setEconProductionLimits(currentStep, econ_production_limits);
+                well->setEconProductionLimits(currentStep, this->m_wellProperties.intern(econ_production_limits));
             }
         }
     }
@@ -846,6 +920,8 @@ namespace Opm {
                 well->setEfficiencyFactor(currentStep, efficiencyFactor);
             }
         }
+
+        m_events.addEvent( ScheduleEvents::EFFICIENCY_UPDATE, currentStep );
     }
 
 
@@ -932,7 +1008,7 @@ namespace Opm {
                 if (well->isInjector(currentStep)) {
                     WellInjectionProperties injectionProperties = well->getInjectionProperties(currentStep);
                     injectionProperties.temperature = record.getItem("TEMP").getSIDouble(0);
-                    well->setInjectionProperties(currentStep, injectionProperties);
+                    well->setInjectionProperties(currentStep, this->m_wellProperties.intern(injectionProperties));
                 }
             }
         }
@@ -958,7 +1034,7 @@ namespace Opm {
                 if (well->isInjector(currentStep)) {
                     WellInjectionProperties injectionProperties = well->getInjectionProperties(currentStep);
                     injectionProperties.temperature = record.getItem("TEMPERATURE").getSIDouble(0);
-                    well->setInjectionProperties(currentStep, injectionProperties);
+                    well->setInjectionProperties(currentStep, this->m_wellProperties.intern(injectionProperties));
                 }
             }
         }
@@ -1005,7 +1081,7 @@ namespace Opm {
                     properties.VFPTableNumber = VFPTableNumber;
                 }
 
-                if (well->setInjectionProperties(currentStep, properties))
+                if (well->setInjectionProperties(currentStep, this->m_wellProperties.intern(properties)))
                     m_events.addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
 
                 if ( ! well->getAllowCrossFlow() && (injectionRate == 0) ) {
@@ -1153,7 +1229,7 @@ namespace Opm {
                         throw std::invalid_argument("Invalid keyword (MODE) supplied");
                     }
 
-                    well->setProductionProperties(currentStep, prop);
+                    well->setProductionProperties(currentStep, this->m_wellProperties.intern(prop));
                 }else{
                     WellInjectionProperties prop = well->getInjectionPropertiesCopy(currentStep);
                     if (cMode == "BHP"){
@@ -1203,7 +1279,7 @@ namespace Opm {
                         throw std::invalid_argument("Invalid keyword (MODE) supplied");
                     }
 
-                    well->setInjectionProperties(currentStep, prop);
+                    well->setInjectionProperties(currentStep, this->m_wellProperties.intern(prop));
                 }
 
 
@@ -1291,6 +1367,8 @@ namespace Opm {
                 group->setTransferGroupEfficiencyFactor(currentStep, transfer);
             }
         }
+
+        m_events.addEvent( ScheduleEvents::EFFICIENCY_UPDATE, currentStep );
     }
 
 
@@ -1451,25 +1529,76 @@ namespace Opm {
         }
     }
 
+    /*
+      The connection factors of different wells are independent of each
+      other; the records are therefore first collected per well, the
+      wells are then processed in parallel and finally the resulting
+      well status changes are applied serially, in keyword order.
+    */
     void Schedule::handleCOMPDAT( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, const ParseContext& parseContext) {
+        std::vector< Well* > wells;
+        std::vector< std::vector< const DeckRecord* > > well_records;
+        std::vector< std::pair< size_t, size_t > > record_order;
+        std::unordered_map< const Well*, size_t > well_index;
+
         for (const auto& record : keyword) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells(wellNamePattern);
-            if (wells.empty())
+            auto matching_wells = getWells(wellNamePattern);
+            if (matching_wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
 
-            for (auto* well : wells) {
-                well->handleCOMPDAT(currentStep, record, grid, eclipseProperties);
+            WellConnections::prepareCOMPDAT(record, eclipseProperties);
+            for (auto* well : matching_wells) {
+                auto iter = well_index.find( well );
+                if (iter == well_index.end()) {
+                    iter = well_index.emplace( well, wells.size() ).first;
+                    wells.push_back( well );
+                    well_records.emplace_back( );
+                }
 
-                if (well->getConnections( currentStep ).allConnectionsShut()) {
-                    std::string msg =
-                        "All completions in well " + well->name() + " is shut at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days. \n" +
-                        "The well is therefore also shut.";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT);
+                auto& records = well_records[ iter->second ];
+                record_order.emplace_back( iter->second, records.size() );
+                records.push_back( &record );
+            }
+        }
+
+        /* The cell dimensions are built lazily; do it before the threads start. */
+        if (!wells.empty())
+            grid.getCellDimensions();
+
+        const long num_wells = wells.size();
+        std::vector< std::vector< char > > all_shut( num_wells );
+        std::vector< std::exception_ptr > errors( num_wells );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (num_wells > 1)
+#endif
+        for (long w = 0; w < num_wells; ++w) {
+            try {
+                for (const auto* record : well_records[w]) {
+                    wells[w]->handleCOMPDAT(currentStep, *record, grid, eclipseProperties);
+                    all_shut[w].push_back( wells[w]->getConnections( currentStep ).allConnectionsShut() );
                 }
+            } catch (...) {
+                errors[w] = std::current_exception();
             }
         }
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception( error );
+
+        for (const auto& pos : record_order) {
+            if (!all_shut[pos.first][pos.second])
+                continue;
+
+            auto& well = *wells[pos.first];
+            std::string msg =
+                "All completions in well " + well.name() + " is shut at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days. \n" +
+                "The well is therefore also shut.";
+            OpmLog::note(msg);
+            updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT);
+        }
         m_events.addEvent(ScheduleEvents::COMPLETION_CHANGE, currentStep);
     }
 
@@ -1574,6 +1703,9 @@ namespace Opm {
     }
 
     void Schedule::invalidNamePattern( const std::string& namePattern,  const ParseContext& parseContext, const DeckKeyword& keyword ) const {
+        if (parseContext.isIgnored( ParseContext::SCHEDULE_INVALID_NAME ))
+            return;
+
         std::string msg = "Error when handling " + keyword.name() +". No names match " +
                           namePattern;
         parseContext.handleError( ParseContext::SCHEDULE_INVALID_NAME, msg );
@@ -1683,23 +1815,11 @@ namespace Opm {
         }
     }
 
-    std::vector< const Group* > Schedule::getChildGroups(const std::string& group_name, size_t timeStep) const {
+    const std::vector< const Group* >& Schedule::getChildGroups(const std::string& group_name, size_t timeStep) const {
         if (!hasGroup(group_name))
             throw std::invalid_argument("No such group: " + group_name);
-        {
-            const auto& group = getGroup( group_name );
-	    std::vector<const Group*> child_groups;
 
-            if (group.hasBeenDefined( timeStep )) {
-                const GroupTree& group_tree = getGroupTree( timeStep );
-                const auto& ch_grps = group_tree.children( group_name );
-		//for (const std::string& group_name : ch_grps) {
-		for ( auto it = ch_grps.begin() ; it != ch_grps.end(); it++) {
-                        child_groups.push_back( &getGroup(*it));
-                    }
-	    }
-	    return child_groups;
-	}
+        return this->stepIndex().child_groups.at( group_name ).at( timeStep );
     }
 
         std::vector< const Well* > Schedule::getChildWells(const std::string& group_name, size_t timeStep) const {
@@ -1728,28 +1848,34 @@ namespace Opm {
     
     
     
-    std::vector< const Well* > Schedule::getWells(size_t timeStep) const {
+    const std::vector< const Well* >& Schedule::getWells(size_t timeStep) const {
         if (timeStep >= m_timeMap.size()) {
             throw std::invalid_argument("Timestep to large");
         }
 
-        auto defined = [=]( const Well& w ) {
-            return w.hasBeenDefined( timeStep );
-        };
-
-        std::vector< const Well* > wells;
-        for( const auto& well : m_wells ) {
-            if( !defined( well ) ) continue;
-            wells.push_back( std::addressof( well ) );
-        }
-
-        return wells;
+        return this->stepIndex().wells.at( timeStep );
     }
 
     const Well* Schedule::getWell(const std::string& wellName) const {
         return std::addressof( m_wells.get( wellName ) );
     }
 
+    size_t Schedule::wellIndex(const std::string& wellName) const {
+        return m_wells.get( wellName ).seqIndex();
+    }
+
+    const Well* Schedule::getWell(size_t wellIndex) const {
+        return std::addressof( m_wells.get( wellIndex ) );
+    }
+
+    std::vector< std::string > Schedule::wellNames() const {
+        std::vector< std::string > names;
+        for (const auto& well : m_wells)
+            names.push_back( well.name() );
+
+        return names;
+    }
+
 
     /*
       Observe that this method only returns wells which have state ==
@@ -1757,18 +1883,20 @@ namespace Opm {
       been opened by the simulator.
     */
 
-    std::vector< const Well* > Schedule::getOpenWells(size_t timeStep) const {
+    const std::vector< const Well* >& Schedule::getOpenWells(size_t timeStep) const {
+        return this->stepIndex().open_wells.at( timeStep );
+    }
 
-        auto open = [=]( const Well& w ) {
-            return w.getStatus( timeStep ) == WellCommon::OPEN;
-        };
+    const std::vector< const Well* >& Schedule::getChangedWells(size_t timeStep) const {
+        return this->stepIndex().changed_wells.at( timeStep );
+    }
 
+    std::vector< const Well* > Schedule::getChangedWells(uint64_t eventMask, size_t firstStep, size_t lastStep) const {
         std::vector< const Well* > wells;
-        for( const auto& well : m_wells ) {
-            if( !open( well ) ) continue;
-            wells.push_back( std::addressof( well ) );
+        for (const auto& well : this->m_wells) {
+            if (well.getEvents().anyEvent( eventMask, firstStep, lastStep ))
+                wells.push_back( std::addressof( well ) );
         }
-
         return wells;
     }
 
@@ -1785,12 +1913,14 @@ namespace Opm {
             return { std::addressof( m_wells.get( wellNamePattern ) ) };
         }
 
+        std::lock_guard< std::mutex > lock( this->pattern_index.mutex );
+        const auto& index = updateMatches( this->pattern_index.wells[ wellNamePattern ],
+                                           this->m_wells, wellNamePattern,
+                                           &Well::wellNameInWellNamePattern );
+
         std::vector< Well* > wells;
-        for( auto& well : this->m_wells ) {
-            if( Well::wellNameInWellNamePattern( well.name(), wellNamePattern ) ) {
-                wells.push_back( std::addressof( well ) );
-            }
-        }
+        for( auto well_index : index )
+            wells.push_back( std::addressof( this->m_wells.get( well_index ) ) );
 
         return wells;
     }
@@ -1820,6 +1950,22 @@ namespace Opm {
             throw std::invalid_argument("Group: " + groupName + " does not exist");
     }
 
+    size_t Schedule::groupIndex(const std::string& groupName) const {
+        return getGroup( groupName ).seqIndex();
+    }
+
+    const Group& Schedule::getGroup(size_t groupIndex) const {
+        return m_groups.get( groupIndex );
+    }
+
+    std::vector< std::string > Schedule::groupNames() const {
+        std::vector< std::string > names;
+        for (const auto& group : m_groups)
+            names.push_back( group.name() );
+
+        return names;
+    }
+
     std::vector< const Group* > Schedule::getGroups() const {
         std::vector< const Group* > groups;
 
@@ -1837,33 +1983,24 @@ namespace Opm {
             return { std::addressof( m_groups.get( groupNamePattern ) ) };
         }
 
+        std::lock_guard< std::mutex > lock( this->pattern_index.mutex );
+        const auto& index = updateMatches( this->pattern_index.groups[ groupNamePattern ],
+                                           this->m_groups, groupNamePattern,
+                                           &Group::groupNameInGroupNamePattern );
+
         std::vector< Group* > groups;
-        for( auto& group : this->m_groups ) {
-            if( Group::groupNameInGroupNamePattern( group.name(), groupNamePattern ) ) {
-                groups.push_back( std::addressof( group ) );
-            }
-        }
+        for( auto group_index : index )
+            groups.push_back( std::addressof( this->m_groups.get( group_index ) ) );
 
         return groups;
     }
 
-    std::vector< const Group* > Schedule::getGroups(size_t timeStep) const {
-      
+    const std::vector< const Group* >& Schedule::getGroups(size_t timeStep) const {
 	if (timeStep >= m_timeMap.size()) {
             throw std::invalid_argument("Timestep to large");
         }
-        
-        auto defined = [=]( const Group& g ) {
-            return g.hasBeenDefined( timeStep );
-        };
-	
-        std::vector< const Group* > groups;
 
-        for( const auto& group : m_groups ) {
-	    if( !defined( group ) ) continue;
-	    groups.push_back( &group );
-	}
-        return groups;
+        return this->stepIndex().groups.at( timeStep );
     }
 	
     void Schedule::addWellToGroup( Group& newGroup, Well& well , size_t timeStep) {
@@ -1976,8 +2113,12 @@ namespace Opm {
 
 
     void Schedule::filterConnections(const EclipseGrid& grid) {
-        for (auto& well : this->m_wells)
+        for (auto& well : this->m_wells) {
             well.filterConnections(grid);
+            well.updateFingerprints();
+        }
+
+        this->updateFingerprints();
     }
 
     const VFPProdTable& Schedule::getVFPProdTable(int table_id, size_t timeStep) const {
@@ -2004,24 +2145,12 @@ namespace Opm {
         return *table_ptr;
     }
 
-    std::map<int, std::shared_ptr<const VFPInjTable> > Schedule::getVFPInjTables(size_t timeStep) const {
-        std::map<int, std::shared_ptr<const VFPInjTable> > tables;
-        for (const auto& pair : this->vfpinj_tables) {
-            if (pair.second.get(timeStep)) {
-                tables.insert(std::make_pair(pair.first, pair.second.get(timeStep)) );
-            }
-        }
-        return tables;
+    const std::map<int, std::shared_ptr<const VFPInjTable> >& Schedule::getVFPInjTables(size_t timeStep) const {
+        return this->stepIndex().vfpinj_tables.at( timeStep );
     }
 
-    std::map<int, std::shared_ptr<const VFPProdTable> > Schedule::getVFPProdTables(size_t timeStep) const {
-        std::map<int, std::shared_ptr<const VFPProdTable> > tables;
-        for (const auto& pair : this->vfpprod_tables) {
-            if (pair.second.get(timeStep)) {
-                tables.insert(std::make_pair(pair.first, pair.second.get(timeStep)) );
-            }
-        }
-        return tables;
+    const std::map<int, std::shared_ptr<const VFPProdTable> >& Schedule::getVFPProdTables(size_t timeStep) const {
+        return this->stepIndex().vfpprod_tables.at( timeStep );
     }
 
 
@@ -2037,6 +2166,74 @@ namespace Opm {
         return this->m_timeMap.size();
     }
 
+    namespace {
+        template< typename T >
+        size_t list_memory_usage( const std::vector< T >& list ) {
+            return MemoryUsage::heap( list );
+        }
+
+        template< typename K, typename V >
+        size_t list_memory_usage( const std::map< K, V >& list ) {
+            return list.size() * sizeof( typename std::map< K, V >::value_type );
+        }
+
+        template< typename Lists >
+        size_t step_lists_memory_usage( const Lists& lists ) {
+            size_t bytes = MemoryUsage::heap( lists.lists ) + MemoryUsage::heap( lists.step );
+            for (const auto& list : lists.lists)
+                bytes += list_memory_usage( list );
+
+            return bytes;
+        }
+    }
+
+    MemoryUsage Schedule::memory_usage() const {
+        MemoryUsage usage( "Schedule", sizeof( *this ) );
+
+        auto& wells = usage.add( "wells", 0 );
+        for (const auto& well : this->m_wells) {
+            const auto well_usage = well.memory_usage();
+            wells.bytes += well_usage.bytes;
+            for (const auto& part : well_usage.children)
+                wells.accumulate( part );
+        }
+
+        usage.add( "well properties", this->m_wellProperties.memory_usage() );
+        usage.add( "groups", this->m_groups.size() * sizeof( Group ) + this->m_rootGroupTree.memory_usage() );
+        usage.add( "events", this->m_events.memory_usage() );
+        usage.add( "modifier decks", this->m_modifierDeck.memory_usage( []( const Deck& deck ) {
+            return deck.memory_usage().total() - sizeof( deck );
+        }));
+
+        size_t vfp_bytes = 0;
+        for (const auto& pair : this->vfpprod_tables)
+            vfp_bytes += pair.second.memory_usage( []( const std::shared_ptr< VFPProdTable >& table ) {
+                return table ? sizeof( *table ) : 0;
+            });
+        for (const auto& pair : this->vfpinj_tables)
+            vfp_bytes += pair.second.memory_usage( []( const std::shared_ptr< VFPInjTable >& table ) {
+                return table ? sizeof( *table ) : 0;
+            });
+        usage.add( "VFP tables", vfp_bytes );
+
+        if (this->step_index.built) {
+            const auto& index = this->step_index;
+            size_t index_bytes = step_lists_memory_usage( index.wells )
+                               + step_lists_memory_usage( index.open_wells )
+                               + step_lists_memory_usage( index.changed_wells )
+                               + step_lists_memory_usage( index.groups )
+                               + step_lists_memory_usage( index.vfpprod_tables )
+                               + step_lists_memory_usage( index.vfpinj_tables );
+            for (const auto& pair : index.child_groups)
+                index_bytes += MemoryUsage::heap( pair.first ) + step_lists_memory_usage( pair.second );
+
+            usage.add( "step index", index_bytes );
+        }
+
+        usage.sort();
+        return usage;
+    }
+
 
     double  Schedule::seconds(size_t timeStep) const {
         return this->m_timeMap.seconds(timeStep);
@@ -2048,10 +2245,190 @@ namespace Opm {
     }
 
 
+    Schedule::StepIndex& Schedule::StepIndex::operator=(const StepIndex&) {
+        std::lock_guard< std::mutex > lock( this->build_mutex );
+
+        this->wells = {};
+        this->open_wells = {};
+        this->changed_wells = {};
+        this->groups = {};
+        this->child_groups.clear();
+        this->vfpprod_tables = {};
+        this->vfpinj_tables = {};
+        this->built = false;
+
+        return *this;
+    }
+
+    Schedule::PatternIndex& Schedule::PatternIndex::operator=(const PatternIndex&) {
+        std::lock_guard< std::mutex > lock( this->mutex );
+
+        this->wells.clear();
+        this->groups.clear();
+
+        return *this;
+    }
+
+    template< typename L >
+    void Schedule::StepIndex::Lists< L >::push_back(L list) {
+        if (this->lists.empty() || (this->lists.back() != list))
+            this->lists.push_back( std::move( list ) );
+
+        this->step.push_back( this->lists.size() - 1 );
+    }
+
+    template< typename L >
+    const L& Schedule::StepIndex::Lists< L >::at(size_t timeStep) const {
+        return this->lists[ this->step.at( timeStep ) ];
+    }
+
+    const Schedule::StepIndex& Schedule::stepIndex() const {
+        if (!this->step_index.built) {
+            std::lock_guard< std::mutex > lock( this->step_index.build_mutex );
+            if (!this->step_index.built) {
+                this->buildStepIndex( this->step_index );
+                this->step_index.built = true;
+            }
+        }
+
+        return this->step_index;
+    }
+
+    void Schedule::buildStepIndex(StepIndex& index) const {
+        const uint64_t any_event = ~uint64_t(0);
+
+        for (size_t timeStep = 0; timeStep < this->m_timeMap.size(); ++timeStep) {
+            std::vector< const Well* > wells, open_wells, changed_wells;
+            for (const auto& well : this->m_wells) {
+                if (!well.hasBeenDefined( timeStep ))
+                    continue;
+
+                wells.push_back( std::addressof( well ) );
+                if (well.getStatus( timeStep ) == WellCommon::OPEN)
+                    open_wells.push_back( std::addressof( well ) );
+
+                if (well.hasEvent( any_event, timeStep ))
+                    changed_wells.push_back( std::addressof( well ) );
+            }
+            index.wells.push_back( std::move( wells ) );
+            index.open_wells.push_back( std::move( open_wells ) );
+            index.changed_wells.push_back( std::move( changed_wells ) );
+
+            std::vector< const Group* > groups;
+            const auto& group_tree = this->getGroupTree( timeStep );
+            for (const auto& group : this->m_groups) {
+                std::vector< const Group* > child_groups;
+                if (group.hasBeenDefined( timeStep )) {
+                    groups.push_back( std::addressof( group ) );
+
+                    for (const auto& child : group_tree.children( group.name() ))
+                        child_groups.push_back( std::addressof( this->getGroup( child ) ));
+                }
+                index.child_groups[ group.name() ].push_back( std::move( child_groups ) );
+            }
+            index.groups.push_back( std::move( groups ) );
+
+            std::map< int, std::shared_ptr< const VFPProdTable > > vfpprod;
+            for (const auto& pair : this->vfpprod_tables) {
+                const auto& table = pair.second.get( timeStep );
+                if (table)
+                    vfpprod.emplace( pair.first, table );
+            }
+            index.vfpprod_tables.push_back( std::move( vfpprod ) );
+
+            std::map< int, std::shared_ptr< const VFPInjTable > > vfpinj;
+            for (const auto& pair : this->vfpinj_tables) {
+                const auto& table = pair.second.get( timeStep );
+                if (table)
+                    vfpinj.emplace( pair.first, table );
+            }
+            index.vfpinj_tables.push_back( std::move( vfpinj ) );
+        }
+    }
+
     void Schedule::evalAction(const SummaryState& /* st */, size_t /* timeStep */) {
         if (this->actions.empty())
             return;
     }
 
+    Schedule::ActionResult Schedule::applyAction(size_t reportStep, const ActionX& action, const ParseContext& parseContext) {
+        ActionResult result;
+        const auto add_name = []( std::vector< std::string >& names, const std::string& name ) {
+            if (std::find( names.begin(), names.end(), name ) == names.end())
+                names.push_back( name );
+        };
+
+        for (const auto& keyword : action) {
+            if (keyword.name() == "WELSPECS") {
+                this->handleWELSPECS( keyword, reportStep, nullptr );
+
+                for (const auto& record : keyword) {
+                    add_name( result.wells, record.getItem( "WELL" ).getTrimmedString( 0 ));
+                    add_name( result.groups, record.getItem( "GROUP" ).getTrimmedString( 0 ));
+                }
+            }
+
+            else if (keyword.name() == "WELOPEN") {
+                this->handleWELOPEN( keyword, reportStep, parseContext );
+
+                for (const auto& record : keyword) {
+                    for (auto* well : this->getWells( record.getItem( "WELL" ).getTrimmedString( 0 ))) {
+                        if (well->getConnections( reportStep ).allConnectionsShut())
+                            this->updateWellStatus( *well, reportStep, WellCommon::StatusEnum::SHUT );
+
+                        add_name( result.wells, well->name() );
+                    }
+                }
+            }
+
+            else
+                throw std::invalid_argument("The keyword " + keyword.name() + " is not supported in a ACTIONX block.");
+        }
+
+        /*
+          New wells and groups are picked up by the pattern index, but the
+          step lists refer to the wells and groups by address and must be
+          built again.
+        */
+        this->step_index = StepIndex();
+
+        for (const auto& well : result.wells)
+            this->m_wells.get( well ).updateFingerprints();
+
+        this->m_inputFingerprint.add( reportStep );
+        for (const auto& keyword : action)
+            this->m_inputFingerprint.add( keyword.fingerprint() );
+
+        this->updateFingerprints();
+        return result;
+    }
+
+
+    const Fingerprint& Schedule::fingerprint() const {
+        return this->m_fingerprint;
+    }
+
+
+    const Fingerprint& Schedule::fingerprint(size_t timeStep) const {
+        return this->m_stepFingerprints.at( timeStep );
+    }
+
+
+    void Schedule::updateFingerprints() {
+        this->m_stepFingerprints.clear();
+        this->m_fingerprint = this->m_inputFingerprint;
+        for (size_t step = 0; step < this->m_timeMap.size(); step++) {
+            Fingerprint fingerprint;
+            fingerprint.add( step ).add( static_cast< int64_t >( this->m_timeMap[ step ] ) );
+            for (const auto& well : this->m_wells) {
+                if (well.hasBeenDefined( step ))
+                    fingerprint.add( well.fingerprint( step ) );
+            }
+
+            this->m_fingerprint.add( fingerprint );
+            this->m_stepFingerprints.push_back( fingerprint );
+        }
+    }
+
 }
 
@@ -18,65 +18,281 @@
 */
 
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
 namespace Opm{
     void SummaryState::add(const ecl::smspec_node& node, double value) {
-        if (node.get_var_type() == ECL_SMSPEC_WELL_VAR)
-            this->add_well_var(node.get_wgname(),
-                               node.get_keyword(),
-                               value);
-        else
-            this->add(node.get_gen_key1(), value);
+        this->set(this->index(node), value);
     }
 
     void SummaryState::add(const std::string& key, double value) {
-        this->values[key] = value;
+        this->set(this->index(key), value);
     }
 
 
     bool SummaryState::has(const std::string& key) const {
-        return (this->values.find(key) != this->values.end());
+        const auto iter = this->key_index.find(key);
+        if (iter == this->key_index.end())
+            return false;
+
+        return this->has(iter->second);
     }
 
 
     double SummaryState::get(const std::string& key) const {
-        const auto iter = this->values.find(key);
-        if (iter == this->values.end())
+        const auto iter = this->key_index.find(key);
+        if (iter == this->key_index.end() || !this->has(iter->second))
             throw std::out_of_range("No such key: " + key);
 
-        return iter->second;
+        return this->values[iter->second];
     }
 
     void SummaryState::add_well_var(const std::string& well, const std::string& var, double value) {
-        this->add(var + ":" + well, value);
-        this->well_values[well][var] = value;
+        this->set(this->well_var_index(well, var), value);
     }
 
     bool SummaryState::has_well_var(const std::string& well, const std::string& var) const {
-        const auto& well_iter = this->well_values.find(well);
-        if (well_iter == this->well_values.end())
+        const auto& well_iter = this->well_index.find(well);
+        if (well_iter == this->well_index.end())
             return false;
 
         const auto& var_iter = well_iter->second.find(var);
         if (var_iter == well_iter->second.end())
             return false;
 
-        return true;
+        return this->has(var_iter->second);
     }
 
     double SummaryState::get_well_var(const std::string& well, const std::string& var) const {
-        return this->well_values.at(well).at(var);
+        const auto index = this->well_index.at(well).at(var);
+        if (!this->has(index))
+            throw std::out_of_range("No such well variable: " + var + ":" + well);
+
+        return this->values[index];
+    }
+
+
+    std::size_t SummaryState::index(const std::string& key) {
+        const auto iter = this->key_index.find(key);
+        if (iter != this->key_index.end())
+            return iter->second;
+
+        const std::size_t index = this->keys.size();
+        this->key_index.emplace(key, index);
+        this->keys.push_back(key);
+        this->values.push_back(0);
+        this->assigned.push_back(false);
+        this->layout_id = new_layout();
+        return index;
+    }
+
+    /*
+      Lookup of an already registered key; unlike index() this will not
+      register the key if it is not found.
+    */
+    bool SummaryState::find(const std::string& key, std::size_t& index) const {
+        const auto iter = this->key_index.find(key);
+        if (iter == this->key_index.end())
+            return false;
+
+        index = iter->second;
+        return true;
+    }
+
+    std::size_t SummaryState::index(const ecl::smspec_node& node) {
+        if (node.get_var_type() == ECL_SMSPEC_WELL_VAR)
+            return this->well_var_index(node.get_wgname(), node.get_keyword());
+
+        return this->index(node.get_gen_key1());
+    }
+
+    std::size_t SummaryState::well_var_index(const std::string& well, const std::string& var) {
+        auto& well_vars = this->well_index[well];
+        const auto iter = well_vars.find(var);
+        if (iter != well_vars.end())
+            return iter->second;
+
+        const auto index = this->index(var + ":" + well);
+        well_vars.emplace(var, index);
+        return index;
+    }
+
+    std::vector<std::size_t> SummaryState::well_var_index(const std::vector<std::string>& wells, const std::string& var) {
+        std::vector<std::size_t> indices;
+        indices.reserve(wells.size());
+        for (const auto& well : wells)
+            indices.push_back(this->well_var_index(well, var));
+
+        return indices;
+    }
+
+    std::size_t SummaryState::size() const {
+        return this->keys.size();
+    }
+
+    std::size_t SummaryState::layout() const {
+        return this->layout_id;
+    }
+
+    std::size_t SummaryState::new_layout() {
+        static std::atomic<std::size_t> next_layout(1);
+        return next_layout++;
+    }
+
+    const std::string& SummaryState::key(std::size_t index) const {
+        return this->keys.at(index);
+    }
+
+    bool SummaryState::has(std::size_t index) const {
+        return index < this->assigned.size() && this->assigned[index];
+    }
+
+    double SummaryState::get(std::size_t index) const {
+        if (!this->has(index))
+            throw std::out_of_range("No value for summary index: " + std::to_string(index));
+
+        return this->values[index];
+    }
+
+    void SummaryState::set(std::size_t index, double value) {
+        this->values.at(index) = value;
+        this->assigned[index] = true;
+    }
+
+    void SummaryState::clear() {
+        std::fill(this->assigned.begin(), this->assigned.end(), false);
+    }
+
+    const std::vector<double>& SummaryState::data() const {
+        return this->values;
+    }
+
+    void SummaryState::set_data(const std::vector<double>& values_arg) {
+        if (values_arg.size() != this->values.size())
+            throw std::invalid_argument("Expected " + std::to_string(this->values.size()) + " summary values, got " + std::to_string(values_arg.size()));
+
+        this->values = values_arg;
+        std::fill(this->assigned.begin(), this->assigned.end(), true);
+    }
+
+    void SummaryState::update(const SummaryState& other) {
+        const auto size = this->keys.size();
+        const bool prefix = size <= other.keys.size()
+            && (size == 0 || this->keys[size - 1] == other.keys[size - 1]);
+
+        if (!prefix) {
+            *this = other;
+            return;
+        }
+
+        for (std::size_t index = size; index < other.keys.size(); ++index)
+            this->key_index.emplace(other.keys[index], index);
+
+        if (size < other.keys.size()) {
+            this->keys.insert(this->keys.end(), other.keys.begin() + size, other.keys.end());
+            this->well_index = other.well_index;
+        }
+
+        this->values = other.values;
+        this->assigned = other.assigned;
+        this->layout_id = other.layout_id;
+    }
+
+    std::size_t SummaryState::memory_usage() const {
+        std::size_t bytes = MemoryUsage::heap(this->keys)
+                          + MemoryUsage::heap(this->values)
+                          + MemoryUsage::heap(this->assigned);
+
+        for (const auto& pair : this->key_index)
+            bytes += sizeof(pair) + MemoryUsage::heap(pair.first);
+
+        for (const auto& well : this->well_index) {
+            bytes += sizeof(well) + MemoryUsage::heap(well.first);
+            for (const auto& var : well.second)
+                bytes += sizeof(var) + MemoryUsage::heap(var.first);
+        }
+
+        return bytes;
     }
 
 
     SummaryState::const_iterator SummaryState::begin() const {
-        return this->values.begin();
+        return const_iterator(this, 0);
     }
 
 
     SummaryState::const_iterator SummaryState::end() const {
-        return this->values.end();
+        return const_iterator(this, this->keys.size());
+    }
+
+
+    SummaryState::const_iterator::const_iterator(const SummaryState* state_arg, std::size_t index) :
+        state(state_arg),
+        pos(index)
+    {
+        this->skip_unset();
+    }
+
+    SummaryState::const_iterator::value_type SummaryState::const_iterator::operator*() const {
+        return { this->state->keys[this->pos], this->state->values[this->pos] };
+    }
+
+    SummaryState::const_iterator& SummaryState::const_iterator::operator++() {
+        ++this->pos;
+        this->skip_unset();
+        return *this;
+    }
+
+    bool SummaryState::const_iterator::operator==(const const_iterator& other) const {
+        return this->state == other.state && this->pos == other.pos;
+    }
+
+    bool SummaryState::const_iterator::operator!=(const const_iterator& other) const {
+        return !(*this == other);
+    }
+
+    void SummaryState::const_iterator::skip_unset() {
+        while (this->pos < this->state->keys.size() && !this->state->assigned[this->pos])
+            ++this->pos;
+    }
+
+
+
+    SummaryStateBuffer::SummaryStateBuffer() :
+        back_state(std::make_shared<SummaryState>()),
+        front(std::make_shared<const SummaryState>())
+    {
+    }
+
+    SummaryState& SummaryStateBuffer::back() {
+        return *this->back_state;
+    }
+
+    /*
+      The state published before this one is only referenced from here
+      once no reader holds a snapshot of it; it is then reused as the
+      next back buffer.
+    */
+    void SummaryStateBuffer::publish() {
+        auto previous = std::move(this->published);
+        this->published = this->back_state;
+        std::atomic_store(&this->front, std::shared_ptr<const SummaryState>(this->published));
+
+        if (previous && previous.use_count() == 1)
+            this->back_state = std::move(previous);
+        else
+            this->back_state = std::make_shared<SummaryState>();
+
+        this->back_state->update(*this->published);
+    }
+
+    std::shared_ptr<const SummaryState> SummaryStateBuffer::snapshot() const {
+        return std::atomic_load(&this->front);
     }
 
 }
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <ctime>
 
 #include <ert/util/util.h>
@@ -51,6 +52,7 @@ namespace {
 
     TimeMap::TimeMap(std::time_t startTime) {
         m_timeList.push_back(startTime);
+        m_cumulative_seconds.push_back(0.0);
     }
 
     TimeMap::TimeMap( const Deck& deck) {
@@ -69,6 +71,7 @@ namespace {
             const std::time_t time = mkdate(1983, 1, 1);
             m_timeList.push_back(time);
         }
+        m_cumulative_seconds.push_back(0.0);
 
         // find all "TSTEP" and "DATES" keywords in the deck and deal
         // with them one after another
@@ -103,7 +106,10 @@ namespace {
 
 
     double TimeMap::seconds(size_t timeStep) const {
-        return std::difftime( this->operator[](timeStep), this->operator[](0));
+        if (timeStep < m_cumulative_seconds.size())
+            return m_cumulative_seconds[timeStep];
+        else
+            throw std::invalid_argument("Index out of range");
     }
 
     double TimeMap::getTotalTime() const
@@ -130,6 +136,7 @@ namespace {
                 m_first_timestep_years.push_back(step);
 
             m_timeList.push_back(newTime);
+            m_cumulative_seconds.push_back(std::difftime(newTime, m_timeList.front()));
         } else
             throw std::invalid_argument("Times added must be in strictly increasing order.");
     }
@@ -210,8 +217,30 @@ namespace {
     {
         assert(tLevelIdx < m_timeList.size());
 
-        return std::difftime(this->m_timeList[tLevelIdx],
-                             this->m_timeList.front());
+        return this->m_cumulative_seconds[tLevelIdx];
+    }
+
+
+    size_t TimeMap::step_of(std::time_t t) const {
+        if (t < m_timeList.front())
+            throw std::invalid_argument("Time before the start of the simulation");
+
+        const auto next = std::upper_bound(m_timeList.begin(), m_timeList.end(), t);
+        return std::distance(m_timeList.begin(), next) - 1;
+    }
+
+
+    size_t TimeMap::step_of_seconds(double seconds) const {
+        if (seconds < 0)
+            throw std::invalid_argument("Time before the start of the simulation");
+
+        const auto next = std::upper_bound(m_cumulative_seconds.begin(), m_cumulative_seconds.end(), seconds);
+        return std::distance(m_cumulative_seconds.begin(), next) - 1;
+    }
+
+
+    const std::vector<double>& TimeMap::cumulativeSeconds() const {
+        return m_cumulative_seconds;
     }
 
 
@@ -219,8 +248,7 @@ namespace {
         bool timestep_first_of_month_year = false;
         const std::vector<size_t>& timesteps = (years) ? getFirstTimestepYears() : getFirstTimestepMonths();
 
-        std::vector<size_t>::const_iterator ci_timestep = std::find(timesteps.begin(), timesteps.end(), timestep);
-        if (ci_timestep != timesteps.end()) {
+        if (std::binary_search(timesteps.begin(), timesteps.end(), timestep)) {
             if (1 >= frequency) {
                 timestep_first_of_month_year = true;
             } else { //Frequency given
@@ -234,28 +262,16 @@ namespace {
     // This method returns true for every n'th timestep in the vector of timesteps m_first_timestep_years or m_first_timestep_months,
     // starting from one before the position of start_timestep. If the given start_timestep is not a value in the month or year vector,
     // set the first timestep that are both within the vector and higher than the initial start_timestep as new start_timestep.
+    // The vectors are sorted, and both positions are found by binary search.
 
     bool TimeMap::isTimestepInFreqSequence (size_t timestep, size_t start_timestep, size_t frequency, bool years) const {
         bool timestep_right_frequency = false;
         const std::vector<size_t>& timesteps = (years) ? getFirstTimestepYears() : getFirstTimestepMonths();
 
-        std::vector<size_t>::const_iterator ci_timestep = std::find(timesteps.begin(), timesteps.end(), timestep);
-        std::vector<size_t>::const_iterator ci_start_timestep = std::find(timesteps.begin(), timesteps.end(), start_timestep);
+        std::vector<size_t>::const_iterator ci_timestep = std::lower_bound(timesteps.begin(), timesteps.end(), timestep);
+        std::vector<size_t>::const_iterator ci_start_timestep = std::lower_bound(timesteps.begin(), timesteps.end(), start_timestep);
 
-        //Find new start_timestep if the given one is not a value in the timesteps vector
-        bool start_ts_in_timesteps = false;
         if (ci_start_timestep != timesteps.end()) {
-            start_ts_in_timesteps = true;
-        } else if (ci_start_timestep == timesteps.end()) {
-            size_t new_start = closest(timesteps, start_timestep);
-            if (0 != new_start) {
-                ci_start_timestep = std::find(timesteps.begin(), timesteps.end(), new_start);
-                start_ts_in_timesteps = true;
-            }
-        }
-
-
-        if (start_ts_in_timesteps) {
             //Pick every n'th element, starting on start_timestep + (n-1), that is, every n'th element from ci_start_timestep - 1 for freq n > 1
             if (ci_timestep >= ci_start_timestep) {
                 int dist = std::distance( ci_start_timestep, ci_timestep ) + 1;
@@ -281,18 +297,6 @@ namespace {
         return m_first_timestep_years;
     }
 
-    // vec is assumed to be sorted
-    size_t TimeMap::closest(const std::vector<size_t> & vec, size_t value) const
-    {
-        std::vector<size_t>::const_iterator ci =
-            std::lower_bound(vec.begin(), vec.end(), value);
-        if (ci != vec.end()) {
-            return *ci;
-        }
-        return 0;
-    }
-
-
     std::time_t TimeMap::operator[] (size_t index) const {
         if (index < m_timeList.size()) {
             return m_timeList[index];
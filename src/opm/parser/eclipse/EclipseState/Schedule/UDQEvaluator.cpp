@@ -0,0 +1,709 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include <ert/util/util.h>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQEvaluator.hpp>
+
+
+namespace Opm {
+
+namespace {
+
+    const std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    bool is_number(const std::string& token, double& value) {
+        if (token.empty())
+            return false;
+
+        char * end_ptr;
+        value = std::strtod(token.c_str(), &end_ptr);
+        return std::strlen(end_ptr) == 0;
+    }
+
+
+    /*
+      Elementwise application of a binary operation. For the normal
+      operations the result is defined where both operands are defined, for
+      the union operations UADD, UMAX, ... it is defined where either of
+      them is defined.
+    */
+    template <typename S, typename F>
+    void apply_binary(S& lhs, const S& rhs, std::size_t n, bool lhs_scalar, bool rhs_scalar, bool union_op, F op) {
+        const double lhs0 = lhs_scalar ? lhs.values[0] : 0;
+        const char lhs_def0 = lhs_scalar ? lhs.defined[0] : 0;
+
+        lhs.values.resize(n);
+        lhs.defined.resize(n);
+        for (std::size_t i = 0; i < n; i++) {
+            const double a = lhs_scalar ? lhs0 : lhs.values[i];
+            const char a_def = lhs_scalar ? lhs_def0 : lhs.defined[i];
+            const double b = rhs_scalar ? rhs.values[0] : rhs.values[i];
+            const char b_def = rhs_scalar ? rhs.defined[0] : rhs.defined[i];
+
+            if (a_def && b_def)
+                lhs.defined[i] = op(a, b, lhs.values[i]);
+            else if (union_op && (a_def || b_def)) {
+                lhs.values[i] = a_def ? a : b;
+                lhs.defined[i] = true;
+            } else
+                lhs.defined[i] = false;
+        }
+    }
+
+
+    template <typename S, typename F>
+    void apply_unary(S& arg, F op) {
+        for (std::size_t i = 0; i < arg.values.size(); i++) {
+            if (arg.defined[i])
+                arg.defined[i] = op(arg.values[i], arg.values[i]);
+        }
+    }
+
+}
+
+/*****************************************************************/
+
+/*
+  Recursive descent compilation of the DEFINE tokens to a postfix program.
+  The precedence is, from lowest to highest: the union operators, the
+  comparisons, + and -, * and /, unary minus and ^.
+*/
+class UDQEvaluator::Compiler {
+public:
+    Compiler(UDQEvaluator& evaluator_arg, const std::vector<std::string>& tokens_arg) :
+        evaluator(evaluator_arg),
+        tokens(tokens_arg)
+    {}
+
+    VarType compile() {
+        const auto type = this->parse_union();
+        if (this->pos != this->tokens.size())
+            throw std::invalid_argument("Extra unhandled data in UDQ expression starting with: " + this->tokens[this->pos]);
+
+        return type;
+    }
+
+private:
+    const std::string& current() const {
+        static const std::string end_token;
+        return (this->pos < this->tokens.size()) ? this->tokens[this->pos] : end_token;
+    }
+
+    bool match(const std::map<std::string, OpCode>& ops, OpCode& code) const {
+        const auto iter = ops.find(this->current());
+        if (iter == ops.end())
+            return false;
+
+        code = iter->second;
+        return true;
+    }
+
+    void emit(OpCode code, std::size_t arg = 0) {
+        this->evaluator.program.push_back({code, arg});
+    }
+
+    static VarType combine(VarType lhs, VarType rhs) {
+        if (lhs == VarType::FIELD)
+            return rhs;
+
+        if (rhs != VarType::FIELD && rhs != lhs)
+            throw std::invalid_argument("Can not combine well and group quantities in UDQ expression");
+
+        return lhs;
+    }
+
+    VarType parse_binary(const std::map<std::string, OpCode>& ops, VarType (Compiler::*parse_next)()) {
+        auto type = (this->*parse_next)();
+        OpCode code;
+        while (this->match(ops, code)) {
+            this->pos++;
+            type = combine(type, (this->*parse_next)());
+            this->emit(code);
+        }
+        return type;
+    }
+
+    VarType parse_union() {
+        static const std::map<std::string, OpCode> ops = {{"UADD", OpCode::uadd}, {"UMAX", OpCode::umax},
+                                                          {"UMIN", OpCode::umin}, {"UMUL", OpCode::umul}};
+        return this->parse_binary(ops, &Compiler::parse_cmp);
+    }
+
+    VarType parse_cmp() {
+        static const std::map<std::string, OpCode> ops = {{"==", OpCode::eq}, {"!=", OpCode::ne},
+                                                          {">", OpCode::gt}, {">=", OpCode::ge},
+                                                          {"<", OpCode::lt}, {"<=", OpCode::le}};
+        auto type = this->parse_add();
+        OpCode code;
+        if (this->match(ops, code)) {
+            this->pos++;
+            type = combine(type, this->parse_add());
+            this->emit(code);
+        }
+        return type;
+    }
+
+    VarType parse_add() {
+        static const std::map<std::string, OpCode> ops = {{"+", OpCode::add}, {"-", OpCode::sub}};
+        return this->parse_binary(ops, &Compiler::parse_mul);
+    }
+
+    VarType parse_mul() {
+        static const std::map<std::string, OpCode> ops = {{"*", OpCode::mul}, {"/", OpCode::div}};
+        return this->parse_binary(ops, &Compiler::parse_unary);
+    }
+
+    VarType parse_unary() {
+        if (this->current() == "-") {
+            this->pos++;
+            const auto type = this->parse_unary();
+            this->emit(OpCode::neg);
+            return type;
+        }
+
+        auto type = this->parse_primary();
+        if (this->current() == "^") {
+            this->pos++;
+            type = combine(type, this->parse_unary());
+            this->emit(OpCode::pow);
+        }
+        return type;
+    }
+
+    VarType parse_primary() {
+        static const std::map<std::string, OpCode> reductions = {{"SUM", OpCode::sum}, {"AVEA", OpCode::avea},
+                                                                 {"AVEG", OpCode::aveg}, {"AVEH", OpCode::aveh},
+                                                                 {"MAX", OpCode::max}, {"MIN", OpCode::min},
+                                                                 {"NORM1", OpCode::norm1}, {"NORM2", OpCode::norm2},
+                                                                 {"NORMI", OpCode::normi}, {"PROD", OpCode::prod}};
+        static const std::map<std::string, OpCode> functions = {{"ABS", OpCode::abs}, {"EXP", OpCode::exp},
+                                                                {"LN", OpCode::ln}, {"LOG", OpCode::log},
+                                                                {"NINT", OpCode::nint}, {"SORTA", OpCode::sorta},
+                                                                {"SORTD", OpCode::sortd}};
+        const std::string token = this->current();
+        if (token.empty())
+            throw std::invalid_argument("Unexpected end of UDQ expression");
+
+        double value;
+        if (is_number(token, value)) {
+            this->pos++;
+            this->emit(OpCode::number, this->evaluator.numbers.size());
+            this->evaluator.numbers.push_back(value);
+            return VarType::FIELD;
+        }
+
+        if (token == "(") {
+            this->pos++;
+            const auto type = this->parse_union();
+            this->expect(")");
+            return type;
+        }
+
+        OpCode code;
+        if (this->match(reductions, code) || this->match(functions, code)) {
+            this->pos++;
+            this->expect("(");
+            auto type = this->parse_union();
+            this->expect(")");
+            this->emit(code);
+            if (reductions.count(token) > 0)
+                type = VarType::FIELD;
+            return type;
+        }
+
+        return this->parse_vector();
+    }
+
+    VarType parse_vector() {
+        const std::string var = this->current();
+        VarType type;
+        switch (var[0]) {
+        case 'F':
+            type = VarType::FIELD;
+            break;
+        case 'W':
+            type = VarType::WELL;
+            break;
+        case 'G':
+            type = VarType::GROUP;
+            break;
+        default:
+            throw std::invalid_argument("Only field, group and well quantities are supported in UDQ expressions - got: " + var);
+        }
+        this->pos++;
+
+        std::string pattern;
+        if (type != VarType::FIELD && this->is_selector(this->current())) {
+            pattern = this->current();
+            this->pos++;
+        }
+
+        /*
+          A UDQ which has been assigned or defined earlier is read from the
+          SummaryState, but with the undefined elements of that evaluation.
+        */
+        std::size_t definition = npos;
+        const auto& definitions = this->evaluator.definitions;
+        for (std::size_t d = 0; d < definitions.size(); d++) {
+            if (definitions[d].keyword == var)
+                definition = d;
+        }
+
+        this->emit(OpCode::vector, this->evaluator.vectors.size());
+        this->evaluator.vectors.push_back({type, var, pattern, definition});
+        return type;
+    }
+
+    bool is_selector(const std::string& token) const {
+        static const std::vector<std::string> operators = {"(", ")", "+", "-", "*", "/", "^", "==", "!=", ">", ">=", "<", "<=",
+                                                           "UADD", "UMAX", "UMIN", "UMUL"};
+        if (token.empty())
+            return false;
+
+        return std::find(operators.begin(), operators.end(), token) == operators.end();
+    }
+
+    void expect(const std::string& token) {
+        if (this->current() != token)
+            throw std::invalid_argument("Expected '" + token + "' in UDQ expression");
+
+        this->pos++;
+    }
+
+    UDQEvaluator& evaluator;
+    const std::vector<std::string>& tokens;
+    std::size_t pos = 0;
+};
+
+/*****************************************************************/
+
+UDQEvaluator::UDQEvaluator(const UDQConfig& config,
+                           const UDQ& udq,
+                           const std::vector<std::string>& wells_arg,
+                           const std::vector<std::string>& groups_arg) :
+    undefined_value(config.undefinedValue()),
+    cmp_eps(config.cmpEpsilon()),
+    wells(wells_arg),
+    groups(groups_arg)
+{
+    for (const auto& expr : udq.expressions()) {
+        if (expr.action() != UDQAction::ASSIGN && expr.action() != UDQAction::DEFINE)
+            continue;
+
+        const auto& keyword = expr.keyword();
+        Definition def;
+        def.action = expr.action();
+        def.keyword = keyword;
+        def.value = 0;
+        def.begin = def.end = this->program.size();
+
+        switch (keyword[0]) {
+        case 'F':
+            def.type = VarType::FIELD;
+            break;
+        case 'W':
+            def.type = VarType::WELL;
+            break;
+        case 'G':
+            def.type = VarType::GROUP;
+            break;
+        default:
+            continue;
+        }
+
+        const auto& tokens = expr.tokens();
+        if (def.action == UDQAction::ASSIGN) {
+            if (tokens.empty() || tokens.size() > 2 || !is_number(tokens.back(), def.value))
+                throw std::invalid_argument("Invalid ASSIGN statement for UDQ: " + keyword);
+
+            if (tokens.size() == 2)
+                def.pattern = tokens[0];
+        } else {
+            Compiler compiler(*this, tokens);
+            const auto type = compiler.compile();
+            if (def.type == VarType::FIELD && type != VarType::FIELD)
+                throw std::invalid_argument("Field UDQ: " + keyword + " must evaluate to a scalar");
+
+            if (type != VarType::FIELD && type != def.type)
+                throw std::invalid_argument("Can not combine well and group quantities in UDQ: " + keyword);
+
+            def.end = this->program.size();
+        }
+
+        this->definitions.push_back(def);
+    }
+}
+
+
+std::size_t UDQEvaluator::size(VarType type) const {
+    switch (type) {
+    case VarType::WELL:
+        return this->wells.size();
+    case VarType::GROUP:
+        return this->groups.size();
+    default:
+        return 1;
+    }
+}
+
+
+const std::string& UDQEvaluator::name(VarType type, std::size_t index) const {
+    return (type == VarType::WELL) ? this->wells[index] : this->groups[index];
+}
+
+
+std::size_t UDQEvaluator::key_index(SummaryState& st, VarType type, const std::string& var, std::size_t index) const {
+    switch (type) {
+    case VarType::WELL:
+        return st.well_var_index(this->wells[index], var);
+    case VarType::GROUP:
+        return st.index(var + ":" + this->groups[index]);
+    default:
+        return st.index(var);
+    }
+}
+
+
+void UDQEvaluator::resolve(SummaryState& st) const {
+    const auto resolve_keys = [this, &st](VarType type, const std::string& var, const std::string& pattern,
+                                          std::vector<std::size_t>& index, std::vector<std::size_t>& offset) {
+        offset.push_back(index.size());
+        for (std::size_t i = 0; i < this->size(type); i++) {
+            if (type == VarType::FIELD || pattern.empty() || util_fnmatch(pattern.c_str(), this->name(type, i).c_str()) == 0)
+                index.push_back(this->key_index(st, type, var, i));
+            else
+                index.push_back(npos);
+        }
+    };
+
+    this->vector_index.clear();
+    this->vector_offset.clear();
+    for (const auto& vector : this->vectors)
+        resolve_keys(vector.type, vector.var, vector.pattern, this->vector_index, this->vector_offset);
+
+    this->output_index.clear();
+    this->output_offset.clear();
+    for (const auto& def : this->definitions)
+        resolve_keys(def.type, def.keyword, def.pattern, this->output_index, this->output_offset);
+
+    this->output_defined.assign(this->output_index.size(), false);
+    this->resolved_layout = st.layout();
+}
+
+
+UDQEvaluator::Set& UDQEvaluator::push(std::size_t& sp, VarType type) const {
+    if (this->stack.size() <= sp)
+        this->stack.resize(sp + 1);
+
+    auto& set = this->stack[sp++];
+    set.type = type;
+    set.values.resize(this->size(type));
+    set.defined.resize(this->size(type));
+    return set;
+}
+
+
+void UDQEvaluator::binary(OpCode code, Set& lhs, const Set& rhs) const {
+    const bool lhs_scalar = (lhs.type == VarType::FIELD);
+    const bool rhs_scalar = (rhs.type == VarType::FIELD);
+    const VarType type = lhs_scalar ? rhs.type : lhs.type;
+    const std::size_t n = this->size(type);
+    const double eps = this->cmp_eps;
+    const auto equal = [eps](double a, double b) {
+        return std::fabs(a - b) <= eps * std::max(std::fabs(a), std::fabs(b));
+    };
+
+    lhs.type = type;
+    switch (code) {
+    case OpCode::add:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = a + b; return true; });
+        break;
+    case OpCode::sub:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = a - b; return true; });
+        break;
+    case OpCode::mul:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = a * b; return true; });
+        break;
+    case OpCode::div:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = a / b; return b != 0; });
+        break;
+    case OpCode::pow:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = std::pow(a, b); return std::isfinite(r); });
+        break;
+    case OpCode::eq:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [&equal](double a, double b, double& r) { r = equal(a, b); return true; });
+        break;
+    case OpCode::ne:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [&equal](double a, double b, double& r) { r = !equal(a, b); return true; });
+        break;
+    case OpCode::gt:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = (a > b); return true; });
+        break;
+    case OpCode::ge:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = (a >= b); return true; });
+        break;
+    case OpCode::lt:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = (a < b); return true; });
+        break;
+    case OpCode::le:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, false, [](double a, double b, double& r) { r = (a <= b); return true; });
+        break;
+    case OpCode::uadd:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, true, [](double a, double b, double& r) { r = a + b; return true; });
+        break;
+    case OpCode::umax:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, true, [](double a, double b, double& r) { r = std::max(a, b); return true; });
+        break;
+    case OpCode::umin:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, true, [](double a, double b, double& r) { r = std::min(a, b); return true; });
+        break;
+    case OpCode::umul:
+        apply_binary(lhs, rhs, n, lhs_scalar, rhs_scalar, true, [](double a, double b, double& r) { r = a * b; return true; });
+        break;
+    default:
+        throw std::logic_error("Invalid binary UDQ operation");
+    }
+}
+
+
+void UDQEvaluator::unary(OpCode code, Set& arg) const {
+    switch (code) {
+    case OpCode::neg:
+        apply_unary(arg, [](double a, double& r) { r = -a; return true; });
+        break;
+    case OpCode::abs:
+        apply_unary(arg, [](double a, double& r) { r = std::fabs(a); return true; });
+        break;
+    case OpCode::exp:
+        apply_unary(arg, [](double a, double& r) { r = std::exp(a); return std::isfinite(r); });
+        break;
+    case OpCode::ln:
+        apply_unary(arg, [](double a, double& r) { r = std::log(a); return a > 0; });
+        break;
+    case OpCode::log:
+        apply_unary(arg, [](double a, double& r) { r = std::log10(a); return a > 0; });
+        break;
+    case OpCode::nint:
+        apply_unary(arg, [](double a, double& r) { r = std::round(a); return true; });
+        break;
+    case OpCode::sorta:
+    case OpCode::sortd: {
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < arg.values.size(); i++) {
+            if (arg.defined[i])
+                order.push_back(i);
+        }
+
+        const auto& values = arg.values;
+        if (code == OpCode::sorta)
+            std::stable_sort(order.begin(), order.end(), [&values](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+        else
+            std::stable_sort(order.begin(), order.end(), [&values](std::size_t a, std::size_t b) { return values[a] > values[b]; });
+
+        for (std::size_t rank = 0; rank < order.size(); rank++)
+            arg.values[order[rank]] = rank + 1;
+        break;
+    }
+    default:
+        throw std::logic_error("Invalid unary UDQ operation");
+    }
+}
+
+
+void UDQEvaluator::reduce(OpCode code, Set& arg) const {
+    double result = 0;
+    std::size_t count = 0;
+    bool defined = true;
+
+    switch (code) {
+    case OpCode::max:
+        result = -std::numeric_limits<double>::max();
+        break;
+    case OpCode::min:
+        result = std::numeric_limits<double>::max();
+        break;
+    case OpCode::prod:
+        result = 1;
+        break;
+    default:
+        break;
+    }
+
+    for (std::size_t i = 0; i < arg.values.size(); i++) {
+        if (!arg.defined[i])
+            continue;
+
+        const double v = arg.values[i];
+        count++;
+        switch (code) {
+        case OpCode::sum:
+        case OpCode::avea:
+            result += v;
+            break;
+        case OpCode::aveg:
+            if (v > 0)
+                result += std::log(v);
+            else
+                defined = false;
+            break;
+        case OpCode::aveh:
+            if (v != 0)
+                result += 1.0 / v;
+            else
+                defined = false;
+            break;
+        case OpCode::max:
+            result = std::max(result, v);
+            break;
+        case OpCode::min:
+            result = std::min(result, v);
+            break;
+        case OpCode::norm1:
+            result += std::fabs(v);
+            break;
+        case OpCode::norm2:
+            result += v * v;
+            break;
+        case OpCode::normi:
+            result = std::max(result, std::fabs(v));
+            break;
+        case OpCode::prod:
+            result *= v;
+            break;
+        default:
+            throw std::logic_error("Invalid UDQ reduction");
+        }
+    }
+
+    switch (code) {
+    case OpCode::avea:
+        result /= count;
+        break;
+    case OpCode::aveg:
+        result = std::exp(result / count);
+        break;
+    case OpCode::aveh:
+        result = count / result;
+        break;
+    case OpCode::norm2:
+        result = std::sqrt(result);
+        break;
+    default:
+        break;
+    }
+
+    arg.type = VarType::FIELD;
+    arg.values.assign(1, result);
+    arg.defined.assign(1, defined && count > 0);
+}
+
+
+void UDQEvaluator::eval(SummaryState& st) const {
+    std::lock_guard<std::mutex> lock(this->eval_lock.mutex);
+    if (this->output_offset.size() != this->definitions.size() || this->resolved_layout != st.layout())
+        this->resolve(st);
+
+    for (std::size_t d = 0; d < this->definitions.size(); d++) {
+        const auto& def = this->definitions[d];
+        const std::size_t* output = this->output_index.data() + this->output_offset[d];
+        const std::size_t n = this->size(def.type);
+
+        char* defined = this->output_defined.data() + this->output_offset[d];
+
+        if (def.action == UDQAction::ASSIGN) {
+            for (std::size_t i = 0; i < n; i++) {
+                if (output[i] != npos) {
+                    st.set(output[i], def.value);
+                    defined[i] = true;
+                }
+            }
+            continue;
+        }
+
+        std::size_t sp = 0;
+        for (std::size_t pc = def.begin; pc < def.end; pc++) {
+            const auto& inst = this->program[pc];
+            switch (inst.code) {
+            case OpCode::number: {
+                auto& set = this->push(sp, VarType::FIELD);
+                set.values[0] = this->numbers[inst.arg];
+                set.defined[0] = true;
+                break;
+            }
+            case OpCode::vector: {
+                const auto& vector = this->vectors[inst.arg];
+                const std::size_t* index = this->vector_index.data() + this->vector_offset[inst.arg];
+                const char* udq_defined = (vector.definition == npos) ? nullptr : this->output_defined.data() + this->output_offset[vector.definition];
+                auto& set = this->push(sp, vector.type);
+                for (std::size_t i = 0; i < set.values.size(); i++) {
+                    set.defined[i] = (index[i] != npos) && st.has(index[i]) && (!udq_defined || udq_defined[i]);
+                    set.values[i] = set.defined[i] ? st.get(index[i]) : 0;
+                }
+                break;
+            }
+            case OpCode::neg:
+            case OpCode::abs:
+            case OpCode::exp:
+            case OpCode::ln:
+            case OpCode::log:
+            case OpCode::nint:
+            case OpCode::sorta:
+            case OpCode::sortd:
+                this->unary(inst.code, this->stack[sp - 1]);
+                break;
+            case OpCode::sum:
+            case OpCode::avea:
+            case OpCode::aveg:
+            case OpCode::aveh:
+            case OpCode::max:
+            case OpCode::min:
+            case OpCode::norm1:
+            case OpCode::norm2:
+            case OpCode::normi:
+            case OpCode::prod:
+                this->reduce(inst.code, this->stack[sp - 1]);
+                break;
+            default:
+                this->binary(inst.code, this->stack[sp - 2], this->stack[sp - 1]);
+                sp--;
+                break;
+            }
+        }
+
+        const auto& result = this->stack[0];
+        const bool scalar = (result.type == VarType::FIELD);
+        for (std::size_t i = 0; i < n; i++) {
+            const double value = scalar ? result.values[0] : result.values[i];
+            defined[i] = scalar ? result.defined[0] : result.defined[i];
+            st.set(output[i], defined[i] ? value : this->undefined_value);
+        }
+    }
+}
+
+}
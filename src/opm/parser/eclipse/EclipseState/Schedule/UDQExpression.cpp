@@ -76,8 +76,8 @@ namespace Opm {
     UDQExpression::UDQExpression(const std::string& action_in, const std::string& keyword_in, const std::vector<std::string>& input_data) {
         assertKeyword(keyword_in);
 
-        this->action = actionString2Enum(action_in);
-        this->keyword = keyword_in;
+        this->m_action = actionString2Enum(action_in);
+        this->m_keyword = keyword_in;
 
         for (const std::string& item : input_data) {
             if (RawConsts::is_quote()(item[0])) {
@@ -123,4 +123,12 @@ namespace Opm {
     const std::vector<std::string>& UDQExpression::tokens() const {
         return this->data;
     }
+
+    UDQAction UDQExpression::action() const {
+        return this->m_action;
+    }
+
+    const std::string& UDQExpression::keyword() const {
+        return this->m_keyword;
+    }
 }
@@ -0,0 +1,254 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const std::size_t max_dims = 5;
+
+    /*
+      Multilinear interpolation in the cell of the table with the lower
+      corner at data[0], one axis at a time from the outermost; the
+      innermost axis is the contiguous one. When deriv is not null the
+      derivatives with respect to the axes from 'axis' and inwards are
+      written to it.
+    */
+    double interpolate(std::size_t dims, std::size_t axis,
+                       const double* data, const std::size_t* step,
+                       const double* factor, const double* inv_width,
+                       double* deriv) {
+        if (axis == dims)
+            return *data;
+
+        const double lo = interpolate( dims, axis + 1, data, step, factor, inv_width, deriv );
+        if (step[axis] == 0) {
+            if (deriv)
+                deriv[axis] = 0;
+
+            return lo;
+        }
+
+        if (!deriv) {
+            const double hi = interpolate( dims, axis + 1, data + step[axis], step, factor, inv_width, nullptr );
+            return lo + factor[axis] * (hi - lo);
+        }
+
+        double hi_deriv[max_dims];
+        const double hi = interpolate( dims, axis + 1, data + step[axis], step, factor, inv_width, hi_deriv );
+        for (std::size_t inner = axis + 1; inner < dims; inner++)
+            deriv[inner] += factor[axis] * (hi_deriv[inner] - deriv[inner]);
+
+        deriv[axis] = (hi - lo) * inv_width[axis];
+        return lo + factor[axis] * (hi - lo);
+    }
+
+
+    double evalTable(std::size_t dims, const VFPAxis* axes, const std::size_t* step,
+                     const std::vector<double>& data,
+                     const double* x, std::size_t* hint, double* deriv) {
+        double factor[max_dims];
+        double inv_width[max_dims];
+        std::size_t offset = 0;
+
+        for (std::size_t axis = 0; axis < dims; axis++) {
+            axes[axis].locate( x[axis], hint[axis], factor[axis] );
+            inv_width[axis] = axes[axis].inverseWidth( hint[axis] );
+            offset += hint[axis] * step[axis];
+        }
+
+        return interpolate( dims, 0, data.data() + offset, step, factor, inv_width, deriv );
+    }
+
+
+    void setSteps(std::size_t dims, const VFPAxis* axes, std::size_t* step) {
+        std::size_t stride = 1;
+        for (std::size_t axis = dims; axis-- > 0;) {
+            step[axis] = axes[axis].size() > 1 ? stride : 0;
+            stride *= axes[axis].size();
+        }
+    }
+
+}
+
+
+    VFPAxis::VFPAxis(const std::vector<double>& values) :
+        m_values(values)
+    {
+        if (m_values.empty())
+            throw std::invalid_argument("A VFP table axis must have at least one value.");
+
+        for (std::size_t index = 0; index + 1 < m_values.size(); index++) {
+            const double width = m_values[index + 1] - m_values[index];
+            if (!(width > 0))
+                throw std::invalid_argument("The values of a VFP table axis must be strictly increasing.");
+
+            m_inv_width.push_back( 1 / width );
+        }
+    }
+
+
+    std::size_t VFPAxis::size() const {
+        return m_values.size();
+    }
+
+
+    double VFPAxis::inverseWidth(std::size_t index) const {
+        return m_inv_width.empty() ? 0 : m_inv_width[index];
+    }
+
+
+    void VFPAxis::locate(double x, std::size_t& index, double& factor) const {
+        if (m_values.size() < 2) {
+            index = 0;
+            factor = 0;
+            return;
+        }
+
+        const std::size_t last = m_values.size() - 2;
+        if (index > last || x < m_values[index] || x > m_values[index + 1]) {
+            const auto upper = std::upper_bound( m_values.begin(), m_values.end(), x );
+            const std::size_t pos = upper - m_values.begin();
+            index = std::min( last, pos == 0 ? 0 : pos - 1 );
+        }
+
+        factor = (x - m_values[index]) * m_inv_width[index];
+    }
+
+
+    VFPProdEvaluator::VFPProdEvaluator(const VFPProdTable& table) :
+        m_axes{ VFPAxis( table.getTHPAxis() ),
+                VFPAxis( table.getWFRAxis() ),
+                VFPAxis( table.getGFRAxis() ),
+                VFPAxis( table.getALQAxis() ),
+                VFPAxis( table.getFloAxis() ) },
+        m_data( table.getTable().data(), table.getTable().data() + table.getTable().num_elements() )
+    {
+        setSteps( dims, m_axes, m_step );
+    }
+
+
+    double VFPProdEvaluator::eval(const double* x, std::size_t* hint, double* deriv) const {
+        return evalTable( dims, m_axes, m_step, m_data, x, hint, deriv );
+    }
+
+
+    double VFPProdEvaluator::operator()(double thp, double wfr, double gfr, double alq, double flo) const {
+        const double x[dims] = { thp, wfr, gfr, alq, flo };
+        std::size_t hint[dims] = {};
+        return this->eval( x, hint, nullptr );
+    }
+
+
+    VFPEvaluation VFPProdEvaluator::evaluate(double thp, double wfr, double gfr, double alq, double flo) const {
+        VFPEvaluation result;
+        this->evaluate( 1, &thp, &wfr, &gfr, &alq, &flo, &result );
+        return result;
+    }
+
+
+    void VFPProdEvaluator::evaluate(std::size_t size,
+                                    const double* thp, const double* wfr, const double* gfr,
+                                    const double* alq, const double* flo,
+                                    double* bhp) const {
+        std::size_t hint[dims] = {};
+        for (std::size_t index = 0; index < size; index++) {
+            const double x[dims] = { thp[index], wfr[index], gfr[index], alq[index], flo[index] };
+            bhp[index] = this->eval( x, hint, nullptr );
+        }
+    }
+
+
+    void VFPProdEvaluator::evaluate(std::size_t size,
+                                    const double* thp, const double* wfr, const double* gfr,
+                                    const double* alq, const double* flo,
+                                    VFPEvaluation* result) const {
+        std::size_t hint[dims] = {};
+        for (std::size_t index = 0; index < size; index++) {
+            const double x[dims] = { thp[index], wfr[index], gfr[index], alq[index], flo[index] };
+            double deriv[dims];
+            auto& res = result[index];
+
+            res.value = this->eval( x, hint, deriv );
+            res.dthp = deriv[0];
+            res.dwfr = deriv[1];
+            res.dgfr = deriv[2];
+            res.dalq = deriv[3];
+            res.dflo = deriv[4];
+        }
+    }
+
+
+    VFPInjEvaluator::VFPInjEvaluator(const VFPInjTable& table) :
+        m_axes{ VFPAxis( table.getTHPAxis() ),
+                VFPAxis( table.getFloAxis() ) },
+        m_data( table.getTable().data(), table.getTable().data() + table.getTable().num_elements() )
+    {
+        setSteps( dims, m_axes, m_step );
+    }
+
+
+    double VFPInjEvaluator::eval(const double* x, std::size_t* hint, double* deriv) const {
+        return evalTable( dims, m_axes, m_step, m_data, x, hint, deriv );
+    }
+
+
+    double VFPInjEvaluator::operator()(double thp, double flo) const {
+        const double x[dims] = { thp, flo };
+        std::size_t hint[dims] = {};
+        return this->eval( x, hint, nullptr );
+    }
+
+
+    VFPEvaluation VFPInjEvaluator::evaluate(double thp, double flo) const {
+        VFPEvaluation result;
+        this->evaluate( 1, &thp, &flo, &result );
+        return result;
+    }
+
+
+    void VFPInjEvaluator::evaluate(std::size_t size, const double* thp, const double* flo, double* bhp) const {
+        std::size_t hint[dims] = {};
+        for (std::size_t index = 0; index < size; index++) {
+            const double x[dims] = { thp[index], flo[index] };
+            bhp[index] = this->eval( x, hint, nullptr );
+        }
+    }
+
+
+    void VFPInjEvaluator::evaluate(std::size_t size, const double* thp, const double* flo, VFPEvaluation* result) const {
+        std::size_t hint[dims] = {};
+        for (std::size_t index = 0; index < size; index++) {
+            const double x[dims] = { thp[index], flo[index] };
+            double deriv[dims];
+            auto& res = result[index];
+
+            res.value = this->eval( x, hint, deriv );
+            res.dthp = deriv[0];
+            res.dflo = deriv[1];
+        }
+    }
+}
@@ -33,6 +33,127 @@
 
 namespace Opm {
 
+namespace {
+
+    /* The default properties are shared by all the wells. */
+    template< typename T >
+    std::shared_ptr< const T > default_value() {
+        static const auto value = std::make_shared< const T >();
+        return value;
+    }
+
+    /*
+      Values from the WellPropertyPool are equal exactly when they are the
+      same object, which is checked first. The comparison of the values
+      is for values which are not interned, and keeps a value which only
+      differs in fields its operator== ignores from counting as a change,
+      as when the values were stored directly.
+    */
+    template< typename T >
+    bool update_shared( DynamicState< std::shared_ptr< const T > >& state, size_t timeStep, std::shared_ptr< const T > value ) {
+        const auto& current = state.at( timeStep );
+        if (current == value || *current == *value)
+            return false;
+
+        return state.update( timeStep, std::move( value ) );
+    }
+
+
+    Fingerprint value_fingerprint( const WellProductionProperties& p ) {
+        Fingerprint fingerprint;
+        fingerprint.add( p.OilRate ).add( p.WaterRate ).add( p.GasRate )
+            .add( p.LiquidRate ).add( p.ResVRate )
+            .add( p.BHPLimit ).add( p.THPLimit ).add( p.BHPH ).add( p.THPH )
+            .add( p.VFPTableNumber ).add( p.ALQValue )
+            .add( p.predictionMode ).add( p.controlMode );
+
+        for (int mode = WellProducer::ORAT; mode <= WellProducer::GRUP; mode *= 2)
+            fingerprint.add( p.hasProductionControl( static_cast< WellProducer::ControlModeEnum >( mode ) ) );
+
+        return fingerprint;
+    }
+
+    Fingerprint value_fingerprint( const WellInjectionProperties& p ) {
+        Fingerprint fingerprint;
+        fingerprint.add( p.surfaceInjectionRate ).add( p.reservoirInjectionRate )
+            .add( p.temperature )
+            .add( p.BHPLimit ).add( p.THPLimit ).add( p.BHPH ).add( p.THPH )
+            .add( p.VFPTableNumber ).add( p.predictionMode )
+            .add( p.injectionControls ).add( p.injectorType ).add( p.controlMode );
+        return fingerprint;
+    }
+
+    Fingerprint value_fingerprint( const WellPolymerProperties& p ) {
+        Fingerprint fingerprint;
+        fingerprint.add( p.m_polymerConcentration ).add( p.m_saltConcentration )
+            .add( p.m_plymwinjtable ).add( p.m_skprwattable ).add( p.m_skprpolytable );
+        return fingerprint;
+    }
+
+    Fingerprint value_fingerprint( const WellEconProductionLimits& l ) {
+        Fingerprint fingerprint;
+        fingerprint.add( l.minOilRate() ).add( l.minGasRate() ).add( l.maxWaterCut() )
+            .add( l.maxGasOilRatio() ).add( l.maxWaterGasRatio() )
+            .add( l.workover() ).add( l.endRun() ).add( l.followonWell() )
+            .add( l.quantityLimit() ).add( l.maxSecondaryMaxWaterCut() )
+            .add( l.workoverSecondary() ).add( l.maxGasLiquidRatio() )
+            .add( l.minLiquidRate() ).add( l.maxTemperature() )
+            .add( l.minReservoirFluidRate() );
+        return fingerprint;
+    }
+
+    Fingerprint value_fingerprint( const WellConnections& connections ) {
+        Fingerprint fingerprint;
+        fingerprint.add( connections.size() );
+        for (size_t index = 0; index < connections.size(); index++) {
+            const auto& c = connections[index];
+            fingerprint.add( c.getI() ).add( c.getJ() ).add( c.getK() )
+                .add( c.state() ).add( c.dir() ).add( c.depth() )
+                .add( c.satTableId() ).add( c.getDefaultSatTabId() )
+                .add( c.complnum() ).add( c.segment() )
+                .add( c.CF() ).add( c.Kh() ).add( c.rw() ).add( c.r0() )
+                .add( c.skinFactor() ).add( c.wellPi() )
+                .add( c.getSeqIndex() ).add( c.getCompSegSeqIndex() )
+                .add( c.getSegDistStart() ).add( c.getSegDistEnd() );
+        }
+        return fingerprint;
+    }
+
+    Fingerprint value_fingerprint( const WellSegments& segments ) {
+        Fingerprint fingerprint;
+        fingerprint.add( segments.size() );
+        if (segments.size() == 0)
+            return fingerprint;
+
+        fingerprint.add( segments.wellName() ).add( segments.numberBranch() )
+            .add( segments.depthTopSegment() ).add( segments.lengthTopSegment() )
+            .add( segments.volumeTopSegment() )
+            .add( segments.lengthDepthType() ).add( segments.compPressureDrop() )
+            .add( segments.multiPhaseModel() );
+
+        for (int index = 0; index < segments.size(); index++) {
+            const auto& s = segments[index];
+            fingerprint.add( s.segmentNumber() ).add( s.branchNumber() )
+                .add( s.outletSegment() ).add( s.totalLength() ).add( s.depth() )
+                .add( s.internalDiameter() ).add( s.roughness() )
+                .add( s.crossArea() ).add( s.volume() ).add( s.dataReady() )
+                .add( s.inletSegments() );
+        }
+        return fingerprint;
+    }
+
+    /* The fingerprint of a value shared between report steps, by address. */
+    template< typename T >
+    const Fingerprint& shared_fingerprint( std::map< const void*, Fingerprint >& fingerprints, const T& value ) {
+        auto iter = fingerprints.find( &value );
+        if (iter == fingerprints.end())
+            iter = fingerprints.emplace( &value, value_fingerprint( value ) ).first;
+
+        return iter->second;
+    }
+
+}
+
     Well::Well(const std::string& name_, const size_t& seqIndex_, int headI,
                int headJ, double refDepth , double drainageRadius, Phase preferredPhase,
                const TimeMap& timeMap, size_t creationTimeStep,
@@ -49,10 +170,10 @@ namespace Opm {
           m_efficiencyFactors (timeMap, 1.0 ),
           m_isProducer( timeMap, true ) ,
           m_completions( timeMap, std::make_shared<WellConnections>(headI, headJ) ),
-          m_productionProperties( timeMap, WellProductionProperties() ),
-          m_injectionProperties( timeMap, WellInjectionProperties() ),
-          m_polymerProperties( timeMap, WellPolymerProperties() ),
-          m_econproductionlimits( timeMap, WellEconProductionLimits() ),
+          m_productionProperties( timeMap, default_value< WellProductionProperties >() ),
+          m_injectionProperties( timeMap, default_value< WellInjectionProperties >() ),
+          m_polymerProperties( timeMap, default_value< WellPolymerProperties >() ),
+          m_econproductionlimits( timeMap, default_value< WellEconProductionLimits >() ),
           m_solventFraction( timeMap, 0.0 ),
           m_tracerProperties( timeMap, WellTracerProperties() ),
           m_groupName( timeMap, "" ),
@@ -68,7 +189,8 @@ namespace Opm {
           m_automaticShutIn(automaticShutIn),
           m_segmentset( timeMap, WellSegments{} ),
           timesteps( timeMap.numTimesteps() ),
-          events( timeMap )
+          events( timeMap ),
+          m_fingerprints( timeMap, Fingerprint() )
     {
         addEvent( ScheduleEvents::NEW_WELL , creationTimeStep );
     }
@@ -111,6 +233,43 @@ namespace Opm {
         return !(*this == other);
     }
 
+    MemoryUsage Well::memory_usage() const {
+        MemoryUsage usage( this->m_name, sizeof( *this ) + MemoryUsage::heap( this->m_name ) );
+
+        usage.add( "connections", this->m_completions.memory_usage( []( const std::shared_ptr< WellConnections >& connections ) {
+            return sizeof( *connections ) + connections->memory_usage();
+        }));
+        usage.add( "segments", this->m_segmentset.memory_usage( []( const WellSegments& segments ) {
+            return segments.memory_usage();
+        }));
+        usage.add( "events", this->events.memory_usage() );
+
+        const auto string_bytes = []( const std::string& value ) { return MemoryUsage::heap( value ); };
+        usage.add( "dynamic state", this->m_status.memory_usage()
+                                  + this->m_isAvailableForGroupControl.memory_usage()
+                                  + this->m_guideRate.memory_usage()
+                                  + this->m_guideRatePhase.memory_usage()
+                                  + this->m_guideRateScalingFactor.memory_usage()
+                                  + this->m_efficiencyFactors.memory_usage()
+                                  + this->m_isProducer.memory_usage()
+                                  + this->m_productionProperties.memory_usage()
+                                  + this->m_injectionProperties.memory_usage()
+                                  + this->m_polymerProperties.memory_usage()
+                                  + this->m_econproductionlimits.memory_usage()
+                                  + this->m_solventFraction.memory_usage()
+                                  + this->m_tracerProperties.memory_usage()
+                                  + this->m_groupName.memory_usage( string_bytes )
+                                  + this->m_rft.memory_usage()
+                                  + this->m_plt.memory_usage()
+                                  + this->m_headI.memory_usage()
+                                  + this->m_headJ.memory_usage()
+                                  + this->m_refDepth.memory_usage()
+                                  + this->m_drainageRadius.memory_usage()
+                                  + this->m_fingerprints.memory_usage() );
+
+        return usage;
+    }
+
     double Well::production_rate( Phase phase, size_t timestep ) const {
         if( !this->isProducer( timestep ) ) return 0.0;
 
@@ -148,11 +307,15 @@ namespace Opm {
     }
 
     bool Well::setProductionProperties(size_t timeStep , const WellProductionProperties& newProperties) {
+        return this->setProductionProperties( timeStep, std::make_shared< const WellProductionProperties >( newProperties ) );
+    }
+
+    bool Well::setProductionProperties(size_t timeStep , std::shared_ptr<const WellProductionProperties> newProperties) {
         if (isInjector(timeStep))
             switchToProducer( timeStep );
 
         m_isProducer.update(timeStep , true);
-        bool update = m_productionProperties.update(timeStep, newProperties);
+        bool update = update_shared( m_productionProperties, timeStep, std::move( newProperties ) );
         if (update)
             addEvent( ScheduleEvents::PRODUCTION_UPDATE, timeStep );
 
@@ -160,19 +323,23 @@ namespace Opm {
     }
 
     WellProductionProperties Well::getProductionPropertiesCopy(size_t timeStep) const {
-        return m_productionProperties.get(timeStep);
+        return *m_productionProperties.get(timeStep);
     }
 
     const WellProductionProperties& Well::getProductionProperties(size_t timeStep) const {
-        return m_productionProperties.at(timeStep);
+        return *m_productionProperties.at(timeStep);
     }
 
     bool Well::setInjectionProperties(size_t timeStep , const WellInjectionProperties& newProperties) {
+        return this->setInjectionProperties( timeStep, std::make_shared< const WellInjectionProperties >( newProperties ) );
+    }
+
+    bool Well::setInjectionProperties(size_t timeStep , std::shared_ptr<const WellInjectionProperties> newProperties) {
         if (isProducer(timeStep))
             switchToInjector( timeStep );
 
         m_isProducer.update(timeStep , false);
-        bool update = m_injectionProperties.update(timeStep, newProperties);
+        bool update = update_shared( m_injectionProperties, timeStep, std::move( newProperties ) );
         if (update)
             addEvent( ScheduleEvents::INJECTION_UPDATE, timeStep );
 
@@ -180,16 +347,20 @@ namespace Opm {
     }
 
     WellInjectionProperties Well::getInjectionPropertiesCopy(size_t timeStep) const {
-        return m_injectionProperties.get(timeStep);
+        return *m_injectionProperties.get(timeStep);
     }
 
     const WellInjectionProperties& Well::getInjectionProperties(size_t timeStep) const {
-        return m_injectionProperties.at(timeStep);
+        return *m_injectionProperties.at(timeStep);
     }
 
     bool Well::setPolymerProperties(size_t timeStep , const WellPolymerProperties& newProperties) {
+        return this->setPolymerProperties( timeStep, std::make_shared< const WellPolymerProperties >( newProperties ) );
+    }
+
+    bool Well::setPolymerProperties(size_t timeStep , std::shared_ptr<const WellPolymerProperties> newProperties) {
         m_isProducer.update(timeStep , false);
-        bool update = m_polymerProperties.update(timeStep, newProperties);
+        bool update = update_shared( m_polymerProperties, timeStep, std::move( newProperties ) );
         if (update)
             addEvent( ScheduleEvents::WELL_POLYMER_UPDATE, timeStep );
 
@@ -197,11 +368,11 @@ namespace Opm {
     }
 
     WellPolymerProperties Well::getPolymerPropertiesCopy(size_t timeStep) const {
-        return m_polymerProperties.get(timeStep);
+        return *m_polymerProperties.get(timeStep);
     }
 
     const WellPolymerProperties& Well::getPolymerProperties(size_t timeStep) const {
-        return m_polymerProperties.at(timeStep);
+        return *m_polymerProperties.at(timeStep);
     }
 
     bool Well::setSolventFraction(size_t timeStep , const double fraction) {
@@ -217,13 +388,17 @@ namespace Opm {
     }
 
     bool Well::setEconProductionLimits(const size_t timeStep, const WellEconProductionLimits& productionlimits) {
+        return this->setEconProductionLimits( timeStep, std::make_shared< const WellEconProductionLimits >( productionlimits ) );
+    }
+
+    bool Well::setEconProductionLimits(const size_t timeStep, std::shared_ptr<const WellEconProductionLimits> productionlimits) {
         // not sure if this keyword turning a well to be producer.
         // not sure what will happen if we use this keyword to a injector.
-        return m_econproductionlimits.update(timeStep, productionlimits);
+        return update_shared( m_econproductionlimits, timeStep, std::move( productionlimits ) );
     }
 
     const WellEconProductionLimits& Well::getEconProductionLimits(const size_t timeStep) const {
-        return m_econproductionlimits.at(timeStep);
+        return *m_econproductionlimits.at(timeStep);
     }
 
     const double& Well::getSolventFraction(size_t timeStep) const {
@@ -376,23 +551,82 @@ namespace Opm {
     }
 
 
-    std::map<int, std::vector<Connection>> Well::getCompletions(size_t time_step) const {
-        std::map<int, std::vector<Connection>> completions;
-
+    const std::map<int, std::vector<Connection>>& Well::getCompletions(size_t time_step) const {
         const auto& connections = this->getConnections(time_step);
-        for (const auto& conn : connections) {
-            auto pair = completions.find( conn.complnum() );
-            if (pair == completions.end())
-                completions[conn.complnum()] = {};
 
-            pair = completions.find(conn.complnum());
-            pair->second.push_back(conn);
-        }
+        std::lock_guard< std::mutex > lock( this->completions_cache.mutex );
+        auto iter = this->completions_cache.completions.find( &connections );
+        if (iter != this->completions_cache.completions.end())
+            return iter->second;
+
+        auto& completions = this->completions_cache.completions[ &connections ];
+        for (const auto& conn : connections)
+            completions[conn.complnum()].push_back(conn);
 
         return completions;
     }
 
 
+    Well::CompletionsCache& Well::CompletionsCache::operator=(const CompletionsCache&) {
+        this->clear();
+        return *this;
+    }
+
+
+    const Fingerprint& Well::fingerprint(size_t timeStep) const {
+        return this->m_fingerprints.at( timeStep );
+    }
+
+    void Well::updateFingerprints() {
+        Fingerprint well;
+        well.add( this->m_name ).add( this->m_creationTimeStep )
+            .add( this->m_preferredPhase ).add( this->m_comporder )
+            .add( this->m_allowCrossFlow ).add( this->m_automaticShutIn );
+
+        std::map< const void*, Fingerprint > shared;
+        this->m_fingerprints.globalReset( Fingerprint() );
+        for (size_t step = 0; step <= this->timesteps; step++) {
+            uint64_t step_events = 0;
+            for (uint64_t event = ScheduleEvents::NEW_WELL; event <= ScheduleEvents::EFFICIENCY_UPDATE; event *= 2) {
+                if (this->events.hasEvent( event, step ))
+                    step_events |= event;
+            }
+
+            Fingerprint fingerprint = well;
+            fingerprint.add( this->m_status.at( step ) )
+                .add( this->m_groupName.at( step ) )
+                .add( this->m_isAvailableForGroupControl.at( step ) )
+                .add( this->m_guideRate.at( step ) )
+                .add( this->m_guideRatePhase.at( step ) )
+                .add( this->m_guideRateScalingFactor.at( step ) )
+                .add( this->m_efficiencyFactors.at( step ) )
+                .add( this->m_isProducer.at( step ) )
+                .add( shared_fingerprint( shared, *this->m_completions.at( step ) ) )
+                .add( shared_fingerprint( shared, *this->m_productionProperties.at( step ) ) )
+                .add( shared_fingerprint( shared, *this->m_injectionProperties.at( step ) ) )
+                .add( shared_fingerprint( shared, *this->m_polymerProperties.at( step ) ) )
+                .add( shared_fingerprint( shared, *this->m_econproductionlimits.at( step ) ) )
+                .add( this->m_solventFraction.at( step ) )
+                .add( this->m_tracerProperties.at( step ).fingerprint() )
+                .add( this->m_rft.at( step ) )
+                .add( this->m_plt.at( step ) )
+                .add( this->m_headI.at( step ) )
+                .add( this->m_headJ.at( step ) )
+                .add( this->m_refDepth.at( step ) )
+                .add( this->m_drainageRadius.at( step ) )
+                .add( shared_fingerprint( shared, this->m_segmentset.at( step ) ) )
+                .add( step_events );
+
+            this->m_fingerprints.update( step, fingerprint );
+        }
+    }
+
+    void Well::CompletionsCache::clear() {
+        std::lock_guard< std::mutex > lock( this->mutex );
+        this->completions.clear();
+    }
+
+
     WellConnections Well::getActiveConnections(size_t timeStep, const EclipseGrid& grid) const {
         return WellConnections(this->getConnections(timeStep), grid);
     }
@@ -583,6 +817,10 @@ namespace Opm {
         return new WellConnections( this->m_headI[time_step], this->m_headJ[time_step]);
     }
 
+    WellConnections * Well::copyWellConnections(size_t time_step) {
+        return new WellConnections( this->m_headI[time_step], this->m_headJ[time_step], this->getConnections(time_step) );
+    }
+
     void Well::updateWellConnections(size_t time_step, WellConnections * new_set ){
         if( getWellConnectionOrdering() == WellCompletion::TRACK) {
             const auto headI = this->m_headI[ time_step ];
@@ -591,6 +829,7 @@ namespace Opm {
         }
 
         m_completions.update( time_step, std::shared_ptr<WellConnections>( new_set ));
+        this->completions_cache.clear();
         addEvent( ScheduleEvents::COMPLETION_CHANGE , time_step );
     }
 
@@ -612,6 +851,8 @@ namespace Opm {
         */
         for (auto& completions : m_completions)
             completions->filter(grid);
+
+        this->completions_cache.clear();
     }
 
     namespace {
@@ -667,16 +908,14 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
         const int complnum = record.getItem("N").get<int>(0);
         if (complnum <= 0)
             throw std::invalid_argument("Completion number must be >= 1. COMPLNUM=" + std::to_string(complnum) + "is invalid");
 
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.setComplnum( complnum );
-
-            new_connections->add(c);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
+        for (size_t c = 0; c < new_connections->size(); c++) {
+            if (match((*new_connections)[c]))
+                new_connections->get(c).setComplnum( complnum );
         }
         this->updateWellConnections(time_step, new_connections);
     }
@@ -693,13 +932,10 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
-
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.setState( status );
-
-            new_connections->add(c);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
+        for (size_t c = 0; c < new_connections->size(); c++) {
+            if (match((*new_connections)[c]))
+                new_connections->get(c).setState( status );
         }
 
         this->updateWellConnections(time_step, new_connections);
@@ -742,14 +978,12 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
         double wellPi = record.getItem("WELLPI").get< double >(0);
 
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.scaleWellPi( wellPi );
-
-            new_connections->add(c);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
+        for (size_t c = 0; c < new_connections->size(); c++) {
+            if (match((*new_connections)[c]))
+                new_connections->get(c).scaleWellPi( wellPi );
         }
 
         this->updateWellConnections(time_step, new_connections);
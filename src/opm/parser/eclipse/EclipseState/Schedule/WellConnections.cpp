@@ -17,11 +17,20 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <iostream>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
@@ -56,42 +65,6 @@ namespace {
 
     }
 
-    // Permute (diagonal) permeability components according to
-    // completion's direction.
-    inline std::array<double,3>
-    permComponents(const Opm::WellCompletion::DirectionEnum direction,
-                   const std::array<double,3>& perm)
-    {
-        const auto p = directionIndices(direction);
-
-        return {{ perm[ p[0] ],
-                  perm[ p[1] ],
-                  perm[ p[2] ] }};
-    }
-
-    // Permute cell's geometric extent according to completion's
-    // direction.  Honour net-to-gross ratio.
-    //
-    // Note: 'extent' is intentionally accepted by modifiable value
-    // rather than reference-to-const to support NTG manipulation.
-    inline std::array<double,3>
-    effectiveExtent(const Opm::WellCompletion::DirectionEnum direction,
-                    const double                                  ntg,
-                    std::array<double,3>                          extent)
-    {
-        // Vertical extent affected by net-to-gross ratio.
-        extent[2] *= ntg;
-
-        const auto p = directionIndices(direction);
-
-        std::array<double,3>
-            D = {{ extent[ p[0] ] ,
-                   extent[ p[1] ] ,
-                   extent[ p[2] ] }};
-
-        return D;
-    }
-
     // Compute Peaceman's effective radius of single completion.
     inline double
     effectiveRadius(const std::array<double,3>& K,
@@ -113,6 +86,122 @@ namespace {
     }
 
 
+    /*
+      The connections which have not yet been placed by
+      orderConnections(), bucketed on (i,j) and sorted on depth within
+      each bucket. The connections are identified by their position in
+      the input order, and where[id] is the current position of
+      connection id.
+    */
+    class ConnectionBuckets {
+    public:
+        using Bucket = std::set< std::pair< double, size_t > >;
+
+        explicit ConnectionBuckets(const std::vector< std::shared_ptr< Connection > >& connections) :
+            where( connections.size() ),
+            remaining( connections.size() )
+        {
+            std::iota( this->where.begin(), this->where.end(), 0 );
+            for (size_t id = 0; id < connections.size(); ++id) {
+                const auto& connection = *connections[id];
+                this->buckets[ key( connection.getI(), connection.getJ() ) ].emplace( connection.depth(), id );
+            }
+        }
+
+        void erase(size_t id, const Connection& connection) {
+            auto iter = this->buckets.find( key( connection.getI(), connection.getJ() ) );
+            iter->second.erase( std::make_pair( connection.depth(), id ) );
+            if (iter->second.empty())
+                this->buckets.erase( iter );
+
+            --this->remaining;
+        }
+
+        /*
+          The position of the connection closest to (oi, oj, oz), with
+          the tie breaking of WellConnections::findClosestConnection().
+          The (i,j) cells are searched in square rings of increasing
+          size around (oi, oj); if the search would visit more cells
+          than there are connections left the function gives up and
+          returns npos.
+        */
+        size_t closest(int oi, int oj, double oz) const {
+            size_t closest = npos;
+            int min_ijdist2 = std::numeric_limits<int>::max();
+            double min_zdiff = std::numeric_limits<double>::max();
+            size_t visited = 0;
+
+            auto search = [&](int ci, int cj) {
+                ++visited;
+                const int ijdist2 = (ci - oi) * (ci - oi) + (cj - oj) * (cj - oj);
+                if (ijdist2 > min_ijdist2)
+                    return;
+
+                const auto iter = this->buckets.find( key( ci, cj ) );
+                if (iter == this->buckets.end())
+                    return;
+
+                // Only the depths nearest to oz from above and below can
+                // have the smallest depth difference.
+                const auto& bucket = iter->second;
+                const auto above = bucket.lower_bound( std::make_pair( oz, size_t( 0 ) ) );
+                auto first = above;
+                if (first != bucket.begin())
+                    first = std::prev( first );
+                while (first != bucket.begin() && std::prev( first )->first == first->first)
+                    first = std::prev( first );
+
+                auto last = above;
+                while (last != bucket.end() && last->first == above->first)
+                    ++last;
+
+                for (auto candidate = first; candidate != last; ++candidate) {
+                    const double zdiff = std::abs( candidate->first - oz );
+                    const size_t pos = this->where[ candidate->second ];
+                    if (ijdist2 < min_ijdist2 || zdiff < min_zdiff || (zdiff == min_zdiff && pos < closest)) {
+                        min_ijdist2 = ijdist2;
+                        min_zdiff = zdiff;
+                        closest = pos;
+                    }
+                }
+            };
+
+            for (int64_t r = 0; r * r <= min_ijdist2; ++r) {
+                if (visited > this->remaining)
+                    return npos;
+
+                const int ir = static_cast<int>( r );
+                if (ir == 0) {
+                    search( oi, oj );
+                    continue;
+                }
+
+                for (int d = -ir; d <= ir; ++d) {
+                    search( oi + d, oj - ir );
+                    search( oi + d, oj + ir );
+                }
+                for (int d = -ir + 1; d < ir; ++d) {
+                    search( oi - ir, oj + d );
+                    search( oi + ir, oj + d );
+                }
+            }
+            return closest;
+        }
+
+        static const size_t npos = std::numeric_limits< size_t >::max();
+
+        std::vector< size_t > where;
+
+    private:
+        static int64_t key(int i, int j) {
+            return (static_cast< int64_t >( i ) << 32) | static_cast< uint32_t >( j );
+        }
+
+        std::unordered_map< int64_t, Bucket > buckets;
+        size_t remaining;
+    };
+
+
 } // anonymous namespace
 
     WellConnections::WellConnections(int headIArg, int headJArg) :
@@ -123,13 +212,25 @@ namespace {
 
 
 
+    WellConnections::WellConnections(int headIArg, int headJArg, const WellConnections& src) :
+        headI(headIArg),
+        headJ(headJArg),
+        m_connections(src.m_connections),
+        m_factors(src.m_factors),
+        m_columns(src.m_columns)
+    {
+    }
+
+
+
     WellConnections::WellConnections(const WellConnections& src, const EclipseGrid& grid) :
         headI(src.headI),
-        headJ(src.headJ)
+        headJ(src.headJ),
+        m_factors(src.m_factors)
     {
-        for (const auto& c : src) {
-            if (grid.cellActive(c.getI(), c.getJ(), c.getK()))
-                this->add(c);
+        for (const auto& c : src.m_connections) {
+            if (grid.cellActive(c->getI(), c->getJ(), c->getK()))
+                this->m_connections.push_back(c);
         }
     }
 
@@ -192,7 +293,20 @@ namespace {
 			    defaultSatTabId);
     }
 
+    void WellConnections::prepareCOMPDAT(const DeckRecord& record, const Eclipse3DProperties& eclipseProperties) {
+        for (const auto& kw : {"PERMX", "PERMY", "PERMZ", "NTG"})
+            eclipseProperties.getDoubleGridProperty(kw).getData();
+        eclipseProperties.getIntGridProperty("SATNUM").getData();
+
+        for (const auto& name : {"CONNECTION_TRANSMISSIBILITY_FACTOR", "DIAMETER", "Kh", "SKIN", "PR"}) {
+            const auto& item = record.getItem(name);
+            if (item.hasValue(0))
+                item.getSIDoubleData();
+        }
+    }
+
     void WellConnections::loadCOMPDAT(const DeckRecord& record, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, std::size_t& totNC) {
+        this->invalidateColumns();
         const auto& permx = eclipseProperties.getDoubleGridProperty("PERMX").getData();
         const auto& permy = eclipseProperties.getDoubleGridProperty("PERMY").getData();
         const auto& permz = eclipseProperties.getDoubleGridProperty("PERMZ").getData();
@@ -221,7 +335,6 @@ namespace {
         const WellCompletion::DirectionEnum direction = WellCompletion::DirectionEnumFromString(record.getItem("DIR").getTrimmedString(0));
         double skin_factor = record.getItem("SKIN").getSIDouble(0);
         double rw;
-        double r0;
 
 
         if (satTableIdItem.hasValue(0) && satTableIdItem.get < int > (0) > 0)
@@ -238,59 +351,116 @@ namespace {
             // value of one foot. The same default value is used by Eclipse300.
             rw = 0.5*unit::feet;
 
-        for (int k = K1; k <= K2; k++) {
-            double CF = -1;
-            double Kh = -1;
+        double CF_input = -1;
+        double Kh_input = -1;
+        if (KhItem.hasValue(0) && KhItem.getSIDouble(0) > 0.0)
+            Kh_input = KhItem.getSIDouble(0);
+
+        if (CFItem.hasValue(0) && CFItem.getSIDouble(0) > 0.0)
+            CF_input = CFItem.getSIDouble(0);
+
+        const bool Kh_from_CF = (CF_input > 0) && (Kh_input < 0)
+            && (KhItem.defaultApplied(0) || KhItem.getSIDouble(0) < 0);
+
+        /*
+          The connection factors of a cell are first looked up in the
+          factors shared with the earlier sets of the well, keyed on the
+          cell and the record input they depend on. The permeability and
+          (NTG scaled) extent of the remaining cells are then gathered into
+          contiguous arrays, permuted according to the completion's
+          direction, and their connection factors computed in one loop.
+        */
+        const std::size_t num_conn = (K2 >= K1) ? K2 - K1 + 1 : 0;
+        std::vector< std::array< int, 3 > > ijk( num_conn );
+        for (std::size_t c = 0; c < num_conn; c++)
+            ijk[c] = { { I, J, static_cast< int >( K1 + c ) } };
+
+        const auto global_index = grid.getGlobalIndices( ijk );
+
+        const bool has_r0 = r0Item.hasValue(0);
+        const double r0_input = has_r0 ? r0Item.getSIDouble(0) : 0.0;
+        if (!this->m_factors)
+            this->m_factors = std::make_shared< FactorCache >();
+
+        std::vector< double > CF( num_conn ), Kh( num_conn ), r0( num_conn );
+        std::vector< FactorKey > keys( num_conn );
+        std::vector< std::size_t > missing;
+
+        for (std::size_t c = 0; c < num_conn; c++) {
+            keys[c] = { global_index[c], static_cast< int >( direction ), rw, skin_factor,
+                        CF_input, Kh_input, has_r0 ? r0_input : -1.0, Kh_from_CF };
+
+            const auto cached = this->m_factors->find( keys[c] );
+            if (cached == this->m_factors->end()) {
+                missing.push_back( c );
+                continue;
+            }
 
-            if (defaultSatTable)
-                satTableId = satnum.iget(grid.getGlobalIndex(I,J,k));
+            CF[c] = cached->second.CF;
+            Kh[c] = cached->second.Kh;
+            r0[c] = cached->second.r0;
+        }
 
-            auto same_ijk = [&]( const Connection& c ) {
-                return c.sameCoordinate( I,J,k );
-            };
+        const auto& cell_dims = grid.getCellDimensions();
+        const std::array< const std::vector<double>*, 3 > perm = {{ &permx, &permy, &permz }};
+        const auto p = directionIndices(direction);
+        const std::size_t num_missing = missing.size();
+        std::vector< double > K0( num_missing ), K1_perm( num_missing ), D0( num_missing ), D1( num_missing ), D2( num_missing );
+
+        for (std::size_t m = 0; m < num_missing; m++) {
+            const std::size_t g = global_index[ missing[m] ];
+            const double dz = cell_dims[2][g] * ntg[g];
+            const std::array<double,3> cell_size = {{ cell_dims[0][g], cell_dims[1][g], dz }};
+
+            K0[m] = (*perm[ p[0] ])[g];
+            K1_perm[m] = (*perm[ p[1] ])[g];
+            D0[m] = cell_size[ p[0] ];
+            D1[m] = cell_size[ p[1] ];
+            D2[m] = cell_size[ p[2] ];
+        }
 
-            if (KhItem.hasValue(0) && KhItem.getSIDouble(0) > 0.0)
-                Kh = KhItem.getSIDouble(0);
-
-            if (CFItem.hasValue(0) && CFItem.getSIDouble(0) > 0.0)
-                CF = CFItem.getSIDouble(0);
-
-            /* We start with the absolute happy path; both CF and Kh are explicitly given in the deck. */
-            if (CF > 0 && Kh > 0)
-                goto CF_done;
-
-            /* We must calculate CF and Kh from the items in the COMPDAT record and cell properties. */
-            {
-                // Angle of completion exposed to flow.  We assume centre
-                // placement so there's complete exposure (= 2\pi).
-                const double angle = 6.2831853071795864769252867665590057683943387987502116419498;
-                size_t global_index = grid.getGlobalIndex(I,J,k);
-                std::array<double,3> cell_perm = {{ permx[global_index], permy[global_index], permz[global_index]}};
-                std::array<double,3> cell_size = grid.getCellDims(global_index);
-                const auto& K = permComponents(direction, cell_perm);
-                const auto& D = effectiveExtent(direction, ntg[global_index], cell_size);
-
-                if (r0Item.hasValue(0))
-                    r0 = r0Item.getSIDouble(0);
+        // Angle of completion exposed to flow.  We assume centre
+        // placement so there's complete exposure (= 2\pi).
+        const double angle = 6.2831853071795864769252867665590057683943387987502116419498;
+
+        for (std::size_t m = 0; m < num_missing; m++) {
+            const std::array<double,3> K = {{ K0[m], K1_perm[m], 0.0 }};
+            const std::array<double,3> D = {{ D0[m], D1[m], D2[m] }};
+            const double r0_c = has_r0 ? r0_input : effectiveRadius(K, D);
+            const double Kh_cell = std::sqrt(K[0] * K[1]) * D[2];
+            const double log_term = std::log(r0_c / std::min(rw, r0_c)) + skin_factor;
+
+            double CF_c = CF_input;
+            double Kh_c = Kh_input;
+            if (CF_c < 0 || Kh_c < 0) {
+                /* We must calculate CF and/or Kh from the items in the COMPDAT record and cell properties. */
+                if (CF_c < 0) {
+                    if (Kh_c < 0)
+                        Kh_c = Kh_cell;
+                    CF_c = angle * Kh_c / log_term;
+                } else if (Kh_from_CF)
+                    Kh_c = CF_c * log_term / angle;
                 else
-                    r0 = effectiveRadius(K,D);
-
-                if (CF < 0) {
-                    if (Kh < 0)
-                        Kh = std::sqrt(K[0] * K[1]) * D[2];
-                    CF = angle * Kh / (std::log(r0 / std::min(rw, r0)) + skin_factor);
-                } else {
-                    if (KhItem.defaultApplied(0) || KhItem.getSIDouble(0) < 0) {
-                        Kh = CF * (std::log(r0 / std::min(r0, rw)) + skin_factor) / angle;
-                    } else {
-                        if (Kh < 0)
-                            Kh = std::sqrt(K[0] * K[1]) * D[2];
-                    }
-                }
+                    Kh_c = Kh_cell;
             }
 
+            const std::size_t c = missing[m];
+            CF[c] = CF_c;
+            Kh[c] = Kh_c;
+            r0[c] = r0_c;
+            this->m_factors->emplace( keys[c], Factors{ CF_c, Kh_c, r0_c } );
+        }
+
+        for (std::size_t c = 0; c < num_conn; c++) {
+            const int k = K1 + c;
+
+            if (defaultSatTable)
+                satTableId = satnum.iget(global_index[c]);
+
+            auto same_ijk = [&]( const std::shared_ptr< Connection >& conn ) {
+                return conn->sameCoordinate( I,J,k );
+            };
 
-        CF_done:
             auto prev = std::find_if( this->m_connections.begin(),
                                       this->m_connections.end(),
                                       same_ijk );
@@ -302,40 +472,50 @@ namespace {
 		    this->addConnection(I,J,k,
                                     grid.getCellDepth( I,J,k ),
                                     state,
-                                    CF,
-                                    Kh,
+                                    CF[c],
+                                    Kh[c],
                                     rw,
-                                    r0,
+                                    r0[c],
                                     skin_factor,
                                     satTableId,
                                     direction,
 				    noConn, 0., 0., defaultSatTable);
 		} 
 		else {
-		    std::size_t noConn = prev->getSeqIndex();
+		    const Connection& old = **prev;
+		    std::size_t noConn = old.getSeqIndex();
 		    // The complnum value carries over; the rest of the state is fully specified by
 		    // the current COMPDAT keyword.
-		    int complnum = prev->complnum();
-		    std::size_t css_ind = prev->getCompSegSeqIndex();
-		    int conSegNo = prev->segment(); 
-		    std::size_t con_SIndex = prev->getSeqIndex();
-		    double conCDepth = prev->depth();
-		    double conSDStart = prev->getSegDistStart();
-		    double conSDEnd = prev->getSegDistEnd();
-		    *prev = Connection(I,J,k,
+		    int complnum = old.complnum();
+		    std::size_t css_ind = old.getCompSegSeqIndex();
+		    int conSegNo = old.segment(); 
+		    std::size_t con_SIndex = old.getSeqIndex();
+		    double conCDepth = old.depth();
+		    double conSDStart = old.getSegDistStart();
+		    double conSDEnd = old.getSegDistEnd();
+		    Connection updated(I,J,k,
                                    complnum,
                                    grid.getCellDepth(I,J,k),
                                    state,
-                                   CF,
-                                   Kh,
+                                   CF[c],
+                                   Kh[c],
                                    rw,
-                                   r0,
+                                   r0[c],
                                    skin_factor,
                                    satTableId,
                                    direction,
 				   noConn, conSDStart, conSDEnd, defaultSatTable);
-		      prev->setCompSegSeqIndex(css_ind);
-		      prev->updateSegment(conSegNo, conCDepth, con_SIndex);
+		    updated.setCompSegSeqIndex(css_ind);
+		    updated.updateSegment(conSegNo, conCDepth, con_SIndex);
+
+		    // A connection specified again with the same input stays shared.
+		    const bool same = updated == old
+		        && updated.getDefaultSatTabId() == old.getDefaultSatTabId()
+		        && updated.getCompSegSeqIndex() == old.getCompSegSeqIndex()
+		        && updated.getSegDistStart() == old.getSegDistStart()
+		        && updated.getSegDistEnd() == old.getSegDistEnd();
+		    if (!same)
+		        *prev = std::make_shared< Connection >( updated );
 		}
 	    }
 	}
@@ -351,8 +531,25 @@ namespace {
         return (*this)[index];
     }
 
+    Connection& WellConnections::get(size_t index) {
+        return this->unshare(index);
+    }
+
     const Connection& WellConnections::operator[](size_t index) const {
-        return this->m_connections.at(index);
+        return *this->m_connections.at(index);
+    }
+
+    /*
+      The connection at index, copied first if it is shared with
+      another set.
+    */
+    Connection& WellConnections::unshare(size_t index) {
+        this->invalidateColumns();
+        auto& connection = this->m_connections.at(index);
+        if (connection.use_count() > 1)
+            connection = std::make_shared< Connection >( *connection );
+
+        return *connection;
     }
 
 
@@ -368,8 +565,8 @@ namespace {
 
     Connection& WellConnections::getFromIJK(const int i, const int j, const int k) {
       for (size_t ic = 0; ic < size(); ++ic) {
-        if (get(ic).sameCoordinate(i, j, k)) {
-          return this->m_connections[ic];
+        if ((*this)[ic].sameCoordinate(i, j, k)) {
+          return this->unshare(ic);
         }
       }
       throw std::runtime_error(" the connection is not found! \n ");
@@ -377,7 +574,8 @@ namespace {
 
 
     void WellConnections::add( Connection connection ) {
-        m_connections.emplace_back( connection );
+        this->invalidateColumns();
+        m_connections.push_back( std::make_shared< Connection >( std::move( connection ) ) );
     }
 
     bool WellConnections::allConnectionsShut( ) const {
@@ -385,9 +583,7 @@ namespace {
             return c.state() == WellCompletion::StateEnum::SHUT;
         };
 
-        return std::all_of( this->m_connections.begin(),
-                            this->m_connections.end(),
-                            shut );
+        return std::all_of( this->begin(), this->end(), shut );
     }
 
 
@@ -398,24 +594,38 @@ namespace {
             return;
         }
 
+        this->invalidateColumns();
+
+        // The connections are placed one at a time, each one swapped into
+        // the position after the previously placed connection. The
+        // closest connection is looked up in the (i,j) buckets of the
+        // connections not yet placed, and only when that would search
+        // more cells than there are connections left by a scan of all
+        // of them with findClosestConnection().
+        ConnectionBuckets buckets( m_connections );
+        std::vector< size_t > ids( m_connections.size() );
+        std::iota( ids.begin(), ids.end(), 0 );
+
+        auto place = [&](int oi, int oj, double oz, size_t pos) {
+            size_t next_index = buckets.closest( oi, oj, oz );
+            if (next_index == ConnectionBuckets::npos)
+                next_index = findClosestConnection( oi, oj, oz, pos );
+
+            buckets.erase( ids[next_index], *m_connections[next_index] );
+            std::swap(m_connections[next_index], m_connections[pos]);
+            std::swap(ids[next_index], ids[pos]);
+            buckets.where[ ids[next_index] ] = next_index;
+            buckets.where[ ids[pos] ] = pos;
+        };
+
         // Find the first connection and swap it into the 0-position.
         const double surface_z = 0.0;
-        size_t first_index = findClosestConnection(well_i, well_j, surface_z, 0);
-        std::swap(m_connections[first_index], m_connections[0]);
+        place( well_i, well_j, surface_z, 0 );
 
         // Repeat for remaining connections.
-        //
-        // Note that since findClosestConnection() is O(n), this is an
-        // O(n^2) algorithm. However, it should be acceptable since
-        // the expected number of connections is fairly low (< 100).
-
-        if( this->m_connections.empty() ) return;
-
         for (size_t pos = 1; pos < m_connections.size() - 1; ++pos) {
-            const auto& prev = m_connections[pos - 1];
-            const double prevz = prev.depth();
-            size_t next_index = findClosestConnection(prev.getI(), prev.getJ(), prevz, pos);
-            std::swap(m_connections[next_index], m_connections[pos]);
+            const auto& prev = *m_connections[pos - 1];
+            place( prev.getI(), prev.getJ(), prev.depth(), pos );
         }
     }
 
@@ -427,7 +637,7 @@ namespace {
         int min_ijdist2 = std::numeric_limits<int>::max();
         double min_zdiff = std::numeric_limits<double>::max();
         for (size_t pos = start_pos; pos < m_connections.size(); ++pos) {
-            const auto& connection = m_connections[ pos ];
+            const auto& connection = *m_connections[ pos ];
 
             const double depth = connection.depth();
             const int ci = connection.getI();
@@ -459,11 +669,109 @@ namespace {
         return !( *this == rhs );
     }
 
+    bool WellConnections::FactorKey::operator==( const FactorKey& rhs ) const {
+        return this->global_index == rhs.global_index
+            && this->direction == rhs.direction
+            && this->rw == rhs.rw
+            && this->skin_factor == rhs.skin_factor
+            && this->CF == rhs.CF
+            && this->Kh == rhs.Kh
+            && this->r0 == rhs.r0
+            && this->Kh_from_CF == rhs.Kh_from_CF;
+    }
+
+    std::size_t WellConnections::FactorHash::operator()( const FactorKey& key ) const {
+        std::size_t seed = std::hash< std::size_t >()( key.global_index );
+        const auto combine = [&seed]( std::size_t value ) {
+            seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        };
+
+        combine( std::hash< int >()( key.direction ) );
+        for (const double value : { key.rw, key.skin_factor, key.CF, key.Kh, key.r0 })
+            combine( std::hash< double >()( value ) );
+        combine( key.Kh_from_CF );
+        return seed;
+    }
+
+    WellConnections::ColumnCache::ColumnCache( const ColumnCache& other ) :
+        columns( std::atomic_load( &other.columns ) )
+    {}
+
+    WellConnections::ColumnCache& WellConnections::ColumnCache::operator=( const ColumnCache& other ) {
+        std::atomic_store( &this->columns, std::atomic_load( &other.columns ) );
+        return *this;
+    }
+
+    void WellConnections::invalidateColumns() {
+        std::atomic_store( &this->m_columns.columns, std::shared_ptr< const Columns >() );
+    }
+
+    /*
+      Threads racing on the first call may each assemble the columns;
+      they are equal, and the one stored last is kept.
+    */
+    const WellConnections::Columns& WellConnections::columns() const {
+        auto columns = std::atomic_load( &this->m_columns.columns );
+        if (columns)
+            return *columns;
+
+        const size_t n = this->m_connections.size();
+        auto assembled = std::make_shared< Columns >();
+        auto& c = *assembled;
+        for (auto* column : { &c.i, &c.j, &c.k, &c.complnum, &c.segment, &c.satTableId })
+            column->reserve( n );
+        for (auto* column : { &c.depth, &c.CF, &c.Kh, &c.rw, &c.r0, &c.skinFactor })
+            column->reserve( n );
+        c.state.reserve( n );
+        c.direction.reserve( n );
+
+        for (const auto& connection : *this) {
+            c.i.push_back( connection.getI() );
+            c.j.push_back( connection.getJ() );
+            c.k.push_back( connection.getK() );
+            c.complnum.push_back( connection.complnum() );
+            c.segment.push_back( connection.segment() );
+            c.satTableId.push_back( connection.satTableId() );
+            c.state.push_back( connection.state() );
+            c.direction.push_back( connection.dir() );
+            c.depth.push_back( connection.depth() );
+            c.CF.push_back( connection.CF() );
+            c.Kh.push_back( connection.Kh() );
+            c.rw.push_back( connection.rw() );
+            c.r0.push_back( connection.r0() );
+            c.skinFactor.push_back( connection.skinFactor() );
+        }
+
+        columns = assembled;
+        std::atomic_store( &this->m_columns.columns, columns );
+        return *columns;
+    }
+
+    size_t WellConnections::Columns::memory_usage() const {
+        return MemoryUsage::heap( this->i ) + MemoryUsage::heap( this->j ) + MemoryUsage::heap( this->k )
+            + MemoryUsage::heap( this->complnum ) + MemoryUsage::heap( this->segment )
+            + MemoryUsage::heap( this->satTableId ) + MemoryUsage::heap( this->state )
+            + MemoryUsage::heap( this->direction ) + MemoryUsage::heap( this->depth )
+            + MemoryUsage::heap( this->CF ) + MemoryUsage::heap( this->Kh ) + MemoryUsage::heap( this->rw )
+            + MemoryUsage::heap( this->r0 ) + MemoryUsage::heap( this->skinFactor );
+    }
+
+    size_t WellConnections::memory_usage() const {
+        const auto columns = std::atomic_load( &this->m_columns.columns );
+        size_t connections = 0;
+        for (const auto& connection : this->m_connections)
+            connections += sizeof( Connection ) / connection.use_count();
+
+        return MemoryUsage::heap( this->m_connections ) + connections
+            + (columns ? sizeof( Columns ) + columns->memory_usage() : 0);
+    }
+
 
     void WellConnections::filter(const EclipseGrid& grid) {
+        this->invalidateColumns();
         auto new_end = std::remove_if(m_connections.begin(),
                                       m_connections.end(),
-                                      [&grid](const Connection& c) { return !grid.cellActive(c.getI(), c.getJ(), c.getK()); });
+                                      [&grid](const std::shared_ptr< Connection >& c) { return !grid.cellActive(c->getI(), c->getJ(), c->getK()); });
         m_connections.erase(new_end, m_connections.end());
     }
 }
@@ -0,0 +1,136 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellEconEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellEconProductionLimits.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellTestState.hpp>
+
+namespace Opm {
+
+    WellEconEvaluator::WellEconEvaluator(const std::vector<const Well*>& wells, std::size_t timeStep) {
+        const std::size_t num_wells = wells.size();
+        m_names.reserve(num_wells);
+        m_min_oil_rate.assign(num_wells, 0.0);
+        m_min_gas_rate.assign(num_wells, 0.0);
+        m_min_liquid_rate.assign(num_wells, 0.0);
+        m_min_reservoir_rate.assign(num_wells, 0.0);
+        m_max_water_cut.assign(num_wells, 0.0);
+        m_max_gas_oil_ratio.assign(num_wells, 0.0);
+        m_max_water_gas_ratio.assign(num_wells, 0.0);
+        m_max_gas_liquid_ratio.assign(num_wells, 0.0);
+        m_potentials.assign(num_wells, 0);
+        m_end_run.assign(num_wells, 0);
+        m_workover.assign(num_wells, WellEcon::NONE);
+
+        for (std::size_t w = 0; w < num_wells; w++) {
+            const auto& well = *wells[w];
+            m_names.push_back(well.name());
+            if (!well.isProducer(timeStep))
+                continue;
+
+            const auto& limits = well.getEconProductionLimits(timeStep);
+            m_min_oil_rate[w]         = limits.minOilRate();
+            m_min_gas_rate[w]         = limits.minGasRate();
+            m_min_liquid_rate[w]      = limits.minLiquidRate();
+            m_min_reservoir_rate[w]   = limits.minReservoirFluidRate();
+            m_max_water_cut[w]        = limits.maxWaterCut();
+            m_max_gas_oil_ratio[w]    = limits.maxGasOilRatio();
+            m_max_water_gas_ratio[w]  = limits.maxWaterGasRatio();
+            m_max_gas_liquid_ratio[w] = limits.maxGasLiquidRatio();
+            m_potentials[w]           = limits.quantityLimit() == WellEcon::POTN;
+            m_end_run[w]              = limits.endRun();
+            m_workover[w]             = limits.workover();
+        }
+    }
+
+
+    std::size_t WellEconEvaluator::size() const {
+        return m_names.size();
+    }
+
+
+    const std::string& WellEconEvaluator::name(std::size_t well) const {
+        return m_names.at(well);
+    }
+
+
+    /*
+      The limits are tested in one branch free loop over the wells, which
+      sets a bit in the flags of a well for every violated limit; a limit
+      of zero can not be violated since the rates and ratios are non
+      negative, and a ratio with a zero denominator is taken as zero.
+      Only the wells with a flag set are then turned into violations.
+    */
+    std::vector<WellEconEvaluator::Violation>
+    WellEconEvaluator::evaluate(const Rates& rates, const Rates* potentials) const {
+        const std::size_t num_wells = this->size();
+        const Rates& pot = potentials ? *potentials : rates;
+        std::vector<int> flags(num_wells);
+
+        for (std::size_t w = 0; w < num_wells; w++) {
+            const double oil = rates.oil[w];
+            const double gas = rates.gas[w];
+            const double water = rates.water[w];
+            const double liquid = oil + water;
+
+            const bool use_pot = m_potentials[w] != 0;
+            const double q_oil = use_pot ? pot.oil[w] : oil;
+            const double q_gas = use_pot ? pot.gas[w] : gas;
+            const double q_liquid = use_pot ? pot.oil[w] + pot.water[w] : liquid;
+            const double* resv = use_pot ? pot.reservoir : rates.reservoir;
+
+            const double water_cut = liquid > 0 ? water / liquid : 0.0;
+            const double gas_oil = oil > 0 ? gas / oil : 0.0;
+            const double water_gas = gas > 0 ? water / gas : 0.0;
+            const double gas_liquid = liquid > 0 ? gas / liquid : 0.0;
+
+            const int violated =
+                  (MIN_OIL_RATE         * (q_oil < m_min_oil_rate[w]))
+                | (MIN_GAS_RATE         * (q_gas < m_min_gas_rate[w]))
+                | (MIN_LIQUID_RATE      * (q_liquid < m_min_liquid_rate[w]))
+                | (MIN_RESERVOIR_RATE   * (resv && resv[w] < m_min_reservoir_rate[w]))
+                | (MAX_WATER_CUT        * (m_max_water_cut[w] > 0 && water_cut > m_max_water_cut[w]))
+                | (MAX_GAS_OIL_RATIO    * (m_max_gas_oil_ratio[w] > 0 && gas_oil > m_max_gas_oil_ratio[w]))
+                | (MAX_WATER_GAS_RATIO  * (m_max_water_gas_ratio[w] > 0 && water_gas > m_max_water_gas_ratio[w]))
+                | (MAX_GAS_LIQUID_RATIO * (m_max_gas_liquid_ratio[w] > 0 && gas_liquid > m_max_gas_liquid_ratio[w]));
+
+            flags[w] = (liquid + gas > 0) ? violated : 0;
+        }
+
+        std::vector<Violation> violations;
+        for (std::size_t w = 0; w < num_wells; w++) {
+            if (flags[w] == 0)
+                continue;
+
+            const auto workover = (flags[w] & RateLimits) ? WellEcon::WELL : m_workover[w];
+            violations.push_back({ w, flags[w], workover, m_end_run[w] != 0 });
+        }
+        return violations;
+    }
+
+
+    void WellEconEvaluator::close(const std::vector<Violation>& violations, WellTestState& state, double sim_time) const {
+        for (const auto& violation : violations) {
+            if (violation.workover == WellEcon::WELL || violation.workover == WellEcon::PLUG)
+                state.addClosedWell(m_names[violation.well], WellTestConfig::Reason::ECONOMIC, sim_time);
+        }
+    }
+
+}
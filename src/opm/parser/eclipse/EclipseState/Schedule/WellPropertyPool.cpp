@@ -0,0 +1,163 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <functional>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WellPropertyPool.hpp>
+
+namespace Opm {
+
+namespace {
+
+    template <typename T>
+    void hash_combine(std::size_t& seed, const T& value) {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+
+    std::size_t hash_value(const WellProductionProperties& p) {
+        std::size_t seed = 0;
+        hash_combine(seed, p.OilRate);
+        hash_combine(seed, p.WaterRate);
+        hash_combine(seed, p.GasRate);
+        hash_combine(seed, p.LiquidRate);
+        hash_combine(seed, p.ResVRate);
+        hash_combine(seed, p.BHPLimit);
+        hash_combine(seed, p.THPLimit);
+        hash_combine(seed, p.VFPTableNumber);
+        hash_combine(seed, p.ALQValue);
+        hash_combine(seed, static_cast<int>(p.controlMode));
+        return seed;
+    }
+
+    bool identical(const WellProductionProperties& p1, const WellProductionProperties& p2) {
+        return p1 == p2 && p1.ALQValue == p2.ALQValue;
+    }
+
+
+    std::size_t hash_value(const WellInjectionProperties& p) {
+        std::size_t seed = 0;
+        hash_combine(seed, p.surfaceInjectionRate);
+        hash_combine(seed, p.reservoirInjectionRate);
+        hash_combine(seed, p.BHPLimit);
+        hash_combine(seed, p.THPLimit);
+        hash_combine(seed, p.VFPTableNumber);
+        hash_combine(seed, p.injectionControls);
+        hash_combine(seed, static_cast<int>(p.injectorType));
+        hash_combine(seed, static_cast<int>(p.controlMode));
+        return seed;
+    }
+
+    bool identical(const WellInjectionProperties& p1, const WellInjectionProperties& p2) {
+        return p1 == p2;
+    }
+
+
+    std::size_t hash_value(const WellPolymerProperties& p) {
+        std::size_t seed = 0;
+        hash_combine(seed, p.m_polymerConcentration);
+        hash_combine(seed, p.m_saltConcentration);
+        hash_combine(seed, p.m_plymwinjtable);
+        return seed;
+    }
+
+    bool identical(const WellPolymerProperties& p1, const WellPolymerProperties& p2) {
+        return p1 == p2;
+    }
+
+
+    std::size_t hash_value(const WellEconProductionLimits& l) {
+        std::size_t seed = 0;
+        hash_combine(seed, l.minOilRate());
+        hash_combine(seed, l.minGasRate());
+        hash_combine(seed, l.maxWaterCut());
+        hash_combine(seed, l.maxGasOilRatio());
+        hash_combine(seed, l.maxWaterGasRatio());
+        hash_combine(seed, static_cast<int>(l.workover()));
+        hash_combine(seed, l.followonWell());
+        return seed;
+    }
+
+    bool identical(const WellEconProductionLimits& l1, const WellEconProductionLimits& l2) {
+        return l1 == l2 && l1.endRun() == l2.endRun();
+    }
+
+
+    template <typename T, typename Pool>
+    std::shared_ptr<const T> intern_value(Pool& pool, const T& value) {
+        const auto hash = hash_value(value);
+        const auto range = pool.equal_range(hash);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (identical(*iter->second, value))
+                return iter->second;
+        }
+
+        auto shared = std::make_shared<const T>(value);
+        pool.emplace(hash, shared);
+        return shared;
+    }
+
+
+    /* The values, the nodes with their next pointer and the buckets. */
+    template <typename T>
+    std::size_t pool_bytes(const std::unordered_multimap<std::size_t, std::shared_ptr<const T>>& pool) {
+        using value_type = typename std::unordered_multimap<std::size_t, std::shared_ptr<const T>>::value_type;
+        return pool.size() * (sizeof(T) + sizeof(value_type) + sizeof(void*))
+             + pool.bucket_count() * sizeof(void*);
+    }
+
+}
+
+
+    std::shared_ptr<const WellProductionProperties> WellPropertyPool::intern(const WellProductionProperties& properties) {
+        return intern_value(this->production, properties);
+    }
+
+
+    std::shared_ptr<const WellInjectionProperties> WellPropertyPool::intern(const WellInjectionProperties& properties) {
+        return intern_value(this->injection, properties);
+    }
+
+
+    std::shared_ptr<const WellPolymerProperties> WellPropertyPool::intern(const WellPolymerProperties& properties) {
+        return intern_value(this->polymer, properties);
+    }
+
+
+    std::shared_ptr<const WellEconProductionLimits> WellPropertyPool::intern(const WellEconProductionLimits& limits) {
+        return intern_value(this->econ_limits, limits);
+    }
+
+
+    std::size_t WellPropertyPool::size() const {
+        return this->production.size()
+             + this->injection.size()
+             + this->polymer.size()
+             + this->econ_limits.size();
+    }
+
+
+    std::size_t WellPropertyPool::memory_usage() const {
+        return pool_bytes(this->production)
+             + pool_bytes(this->injection)
+             + pool_bytes(this->polymer)
+             + pool_bytes(this->econ_limits);
+    }
+
+}
@@ -29,6 +29,7 @@ WellTestConfig::WellTestConfig() {
 }
 
 void WellTestConfig::add_well(const std::string& well, Reason shut_reason, double test_interval, int num_retries, double startup_time) {
+    index[well].push_back(wells.size());
     wells.push_back({well, shut_reason, test_interval, num_retries, startup_time});
 }
 
@@ -62,42 +63,50 @@ void WellTestConfig::add_well(const std::string& well, const std::string& reason
 
 
 void WellTestConfig::drop_well(const std::string& well) {
+    if (index.erase(well) == 0)
+        return;
+
     wells.erase(std::remove_if(wells.begin(),
                                wells.end(),
                                [&well](const WTESTWell& wtest_well) { return (wtest_well.name == well); }),
                 wells.end());
+
+    for (auto& entry : index)
+        entry.second.clear();
+
+    for (size_t pos = 0; pos < wells.size(); pos++)
+        index[wells[pos].name].push_back(pos);
 }
 
 bool WellTestConfig::has(const std::string& well) const {
-    const auto well_iter = std::find_if(wells.begin(),
-                                        wells.end(),
-                                        [&well](const WTESTWell& wtest_well) { return (wtest_well.name == well); });
-    return (well_iter != wells.end());
+    return (index.find(well) != index.end());
+}
+
+
+const WellTestConfig::WTESTWell* WellTestConfig::find(const std::string& well, Reason reason) const {
+    const auto iter = index.find(well);
+    if (iter == index.end())
+        return nullptr;
+
+    for (size_t pos : iter->second) {
+        if (wells[pos].shut_reason == reason)
+            return &wells[pos];
+    }
+    return nullptr;
 }
 
 
 bool WellTestConfig::has(const std::string& well, Reason reason) const {
-    const auto well_iter = std::find_if(wells.begin(),
-                                        wells.end(),
-                                        [&well, &reason](const WTESTWell& wtest_well)
-                                        {
-                                            return (reason == wtest_well.shut_reason && wtest_well.name == well);
-                                        });
-    return (well_iter != wells.end());
+    return (this->find(well, reason) != nullptr);
 }
 
 
 const WellTestConfig::WTESTWell& WellTestConfig::get(const std::string& well, Reason reason) const {
-    const auto well_iter = std::find_if(wells.begin(),
-                                        wells.end(),
-                                        [&well, &reason](const WTESTWell& wtest_well)
-                                        {
-                                            return (reason == wtest_well.shut_reason && wtest_well.name == well);
-                                        });
-    if (well_iter == wells.end())
+    const auto* wtest_well = this->find(well, reason);
+    if (!wtest_well)
         throw std::invalid_argument("No such WTEST object");
 
-    return *well_iter;
+    return *wtest_well;
 }
 
 
@@ -29,10 +29,14 @@ namespace Opm {
             return;
 
         this->wells.push_back({well_name, reason, sim_time, 0});
+        this->well_reasons[well_name] |= reason;
     }
 
 
     void WellTestState::openWell(const std::string& well_name) {
+        if (this->well_reasons.erase(well_name) == 0)
+            return;
+
         wells.erase(std::remove_if(wells.begin(),
                                    wells.end(),
                                    [&well_name](const ClosedWell& well) { return (well.name == well_name); }),
@@ -41,6 +45,14 @@ namespace Opm {
 
 
     void WellTestState::dropWell(const std::string& well_name, WellTestConfig::Reason reason) {
+        if (!this->hasWell(well_name, reason))
+            return;
+
+        int& reasons = this->well_reasons[well_name];
+        reasons &= ~reason;
+        if (reasons == 0)
+            this->well_reasons.erase(well_name);
+
         wells.erase(std::remove_if(wells.begin(),
                                    wells.end(),
                                    [&well_name, reason](const ClosedWell& well) { return (well.name == well_name && well.reason == reason); }),
@@ -49,13 +61,8 @@ namespace Opm {
 
 
     bool WellTestState::hasWell(const std::string& well_name, WellTestConfig::Reason reason) const {
-        const auto well_iter = std::find_if(wells.begin(),
-                                            wells.end(),
-                                            [&well_name, &reason](const ClosedWell& well)
-                                             {
-                                                return (reason == well.reason && well.name == well_name);
-                                            });
-        return (well_iter != wells.end());
+        const auto iter = this->well_reasons.find(well_name);
+        return (iter != this->well_reasons.end() && (iter->second & reason));
     }
 
     size_t WellTestState::sizeWells() const {
@@ -90,10 +97,19 @@ namespace Opm {
             return;
 
         this->completions.push_back( {well_name, complnum, sim_time, 0} );
+        this->well_completions[well_name].push_back(complnum);
     }
 
 
     void WellTestState::dropCompletion(const std::string& well_name, int complnum) {
+        if (!this->hasCompletion(well_name, complnum))
+            return;
+
+        auto& complnums = this->well_completions[well_name];
+        complnums.erase(std::find(complnums.begin(), complnums.end(), complnum));
+        if (complnums.empty())
+            this->well_completions.erase(well_name);
+
         completions.erase(std::remove_if(completions.begin(),
                                          completions.end(),
                                          [&well_name, complnum](const ClosedCompletion& completion) { return (completion.wellName == well_name && completion.complnum == complnum); }),
@@ -102,13 +118,12 @@ namespace Opm {
 
 
     bool WellTestState::hasCompletion(const std::string& well_name, const int complnum) const {
-        const auto completion_iter = std::find_if(completions.begin(),
-                                                  completions.end(),
-                                                  [&well_name, &complnum](const ClosedCompletion& completion)
-                                                  {
-                                                    return (complnum == completion.complnum && completion.wellName == well_name);
-                                                  });
-        return (completion_iter != completions.end());
+        const auto iter = this->well_completions.find(well_name);
+        if (iter == this->well_completions.end())
+            return false;
+
+        const auto& complnums = iter->second;
+        return (std::find(complnums.begin(), complnums.end(), complnum) != complnums.end());
     }
 
     size_t WellTestState::sizeCompletions() const {
@@ -134,6 +149,9 @@ namespace Opm {
     }
 
     double WellTestState::lastTestTime(const std::string& well_name) const {
+        if (this->well_reasons.find(well_name) == this->well_reasons.end())
+            throw std::runtime_error("No well named " + well_name + " found in WellTestState.");
+
         const auto well_iter = std::find_if(wells.begin(),
                                             wells.end(),
                                             [&well_name](const ClosedWell& well)
@@ -49,4 +49,13 @@ namespace Opm {
     bool WellTracerProperties::operator!=(const WellTracerProperties& other) const {
         return !(*this == other);
     }
+
+    Fingerprint WellTracerProperties::fingerprint() const {
+        Fingerprint fingerprint;
+        fingerprint.add( m_tracerConcentrations.size() );
+        for (const auto& tracer : m_tracerConcentrations)
+            fingerprint.add( tracer.first ).add( tracer.second );
+
+        return fingerprint;
+    }
 }
@@ -17,6 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
@@ -98,6 +102,10 @@ namespace Opm {
                 throw std::runtime_error("Error in EQLNUM data: all values are 0");
             }
 
+            m_numRegions = maxEqlnum;
+            m_regionBarrier.assign( static_cast<size_t>(maxEqlnum) * maxEqlnum , false );
+            m_thresholdPressureTable.assign( m_regionBarrier.size() , std::make_pair(false , 0.0) );
+
 
             // Fill threshold pressure table.
             const auto& thpres = solutionSection.getKeyword<ParserKeywords::THPRES>( );
@@ -115,6 +123,9 @@ namespace Opm {
                 if (r1 > maxEqlnum || r2 > maxEqlnum) {
                     throw std::runtime_error("Too high region numbers in THPRES keyword");
                 }
+                if (r1 < 1 || r2 < 1) {
+                    throw std::runtime_error("Invalid region numbers in THPRES keyword");
+                }
 
                 if (thpressItem.hasValue(0)) {
                     addBarrier( r1 , r2 , thpressItem.getSIDouble( 0 ) );
@@ -125,47 +136,59 @@ namespace Opm {
     }
 
     bool ThresholdPressure::hasRegionBarrier(int r1 , int r2) const {
-        std::pair<int,int> indexPair = makeIndex(r1,r2);
-        if (m_pressureTable.find( indexPair ) == m_pressureTable.end())
-            return false;
-        else
-            return true;
+        size_t pos = index(r1,r2);
+        return pos != npos && m_regionBarrier[pos];
     }
 
 
     double ThresholdPressure::getThresholdPressure(int r1 , int r2) const {
-        std::pair<int,int> indexPair = makeIndex(r1,r2);
-        auto iter = m_pressureTable.find( indexPair );
-        if (iter == m_pressureTable.end())
-            return 0.0;
-        else {
-            auto pair_pair = *iter;
-            auto value_pair = pair_pair.second;
-            bool   valid = value_pair.first;
-            double value = value_pair.second;
-            if (valid)
-                return value;
-            else {
-                std::string msg = "The THPRES value for regions " + std::to_string(r1) + " and " + std::to_string(r2) + " has not been initialized. Using 0.0";
-                throw std::invalid_argument(msg);
-                return 0;
-            }
-        }
+        return lookup(r1,r2);
+    }
+
+
+    std::vector<double> ThresholdPressure::getThresholdPressures(const std::vector<int>& region1 , const std::vector<int>& region2) const {
+        if (region1.size() != region2.size())
+            throw std::invalid_argument("The region lists must have the same length");
 
+        std::vector<double> pressures( region1.size() );
+        for (size_t i = 0; i < region1.size(); i++)
+            pressures[i] = lookup(region1[i] , region2[i]);
 
+        return pressures;
     }
 
 
-    std::pair<int,int> ThresholdPressure::makeIndex(int r1 , int r2) {
-        if (r1 < r2)
-            return std::make_pair(r1,r2);
-        else
-            return std::make_pair(r2,r1);
+    size_t ThresholdPressure::index(int r1 , int r2) const {
+        if (r1 < 1 || r2 < 1 || r1 > m_numRegions || r2 > m_numRegions)
+            return npos;
+
+        return static_cast<size_t>(r1 - 1) * m_numRegions + (r2 - 1);
     }
 
+
+    double ThresholdPressure::lookup(int r1 , int r2) const {
+        size_t pos = index(r1,r2);
+        if (pos == npos || !m_regionBarrier[pos])
+            return 0.0;
+
+        const auto& value_pair = m_thresholdPressureTable[pos];
+        if (!value_pair.first) {
+            std::string msg = "The THPRES value for regions " + std::to_string(r1) + " and " + std::to_string(r2) + " has not been initialized. Using 0.0";
+            throw std::invalid_argument(msg);
+        }
+
+        return value_pair.second;
+    }
+
+
     void ThresholdPressure::addPair(int r1 , int r2 , const std::pair<bool , double>& valuePair) {
-        std::pair<int,int> indexPair = makeIndex(r1,r2);
-        m_pressureTable[indexPair] = valuePair;
+        if (!m_regionBarrier[index(r1,r2)])
+            m_size++;
+
+        for (size_t pos : { index(r1,r2) , index(r2,r1) }) {
+            m_regionBarrier[pos] = true;
+            m_thresholdPressureTable[pos] = valuePair;
+        }
     }
 
     void ThresholdPressure::addBarrier(int r1 , int r2 , double p) {
@@ -179,7 +202,7 @@ namespace Opm {
     }
 
     size_t ThresholdPressure::size() const {
-        return m_pressureTable.size();
+        return m_size;
     }
 
     bool ThresholdPressure::active() const {
@@ -191,15 +214,8 @@ namespace Opm {
     }
 
     bool ThresholdPressure::hasThresholdPressure(int r1 , int r2) const {
-        std::pair<int,int> indexPair = makeIndex(r1,r2);
-        auto iter = m_pressureTable.find( indexPair );
-        if (iter == m_pressureTable.end())
-            return false;
-        else {
-            auto pair_pair = *iter;
-            auto value_pair = pair_pair.second;
-            return value_pair.first;
-        }
+        size_t pos = index(r1,r2);
+        return pos != npos && m_regionBarrier[pos] && m_thresholdPressureTable[pos].first;
     }
 
 
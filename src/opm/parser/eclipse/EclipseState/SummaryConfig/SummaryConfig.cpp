@@ -18,6 +18,7 @@
 */
 
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
@@ -41,6 +42,11 @@
 #include <iostream>
 #include <algorithm>
 #include <array>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 namespace Opm {
 
@@ -124,6 +130,9 @@ namespace {
 
 
 void handleMissingWell( const ParseContext& parseContext , const std::string& keyword, const std::string& well) {
+    if (parseContext.isIgnored( ParseContext::SUMMARY_UNKNOWN_WELL ))
+        return;
+
     std::string msg = std::string("Error in keyword:") + keyword + std::string(" No such well: ") + well;
     if (parseContext.get( ParseContext::SUMMARY_UNKNOWN_WELL) == InputError::WARN)
         std::cerr << "ERROR: " << msg << std::endl;
@@ -133,6 +142,9 @@ void handleMissingWell( const ParseContext& parseContext , const std::string& ke
 
 
 void handleMissingGroup( const ParseContext& parseContext , const std::string& keyword, const std::string& group) {
+    if (parseContext.isIgnored( ParseContext::SUMMARY_UNKNOWN_GROUP ))
+        return;
+
     std::string msg = std::string("Error in keyword:") + keyword + std::string(" No such group: ") + group;
     if (parseContext.get( ParseContext::SUMMARY_UNKNOWN_GROUP) == InputError::WARN)
         std::cerr << "ERROR: " << msg << std::endl;
@@ -140,8 +152,45 @@ void handleMissingGroup( const ParseContext& parseContext , const std::string& k
     parseContext.handleError( ParseContext::SUMMARY_UNKNOWN_GROUP , msg );
 }
 
+
+/*
+  The ParseContext errors found while expanding one SUMMARY keyword.
+  The keywords are expanded concurrently, and the errors are handed to
+  the ParseContext afterwards in keyword order, so the messages and the
+  exception thrown are the same as when the keywords are expanded one
+  by one.
+*/
+class DeferredErrors {
+public:
+    void missingWell( const std::string& keyword, const std::string& well ) {
+        this->errors.emplace_back( [keyword, well]( const ParseContext& parseContext ) {
+            handleMissingWell( parseContext, keyword, well );
+        });
+    }
+
+    void missingGroup( const std::string& keyword, const std::string& group ) {
+        this->errors.emplace_back( [keyword, group]( const ParseContext& parseContext ) {
+            handleMissingGroup( parseContext, keyword, group );
+        });
+    }
+
+    void unhandledKeyword( const std::string& msg ) {
+        this->errors.emplace_back( [msg]( const ParseContext& parseContext ) {
+            parseContext.handleError( ParseContext::SUMMARY_UNHANDLED_KEYWORD, msg );
+        });
+    }
+
+    void report( const ParseContext& parseContext ) const {
+        for( const auto& error : this->errors )
+            error( parseContext );
+    }
+
+private:
+    std::vector< std::function< void( const ParseContext& ) > > errors;
+};
+
   inline void keywordW( SummaryConfig::keyword_list& list,
-                      const ParseContext& parseContext,
+                      DeferredErrors& errors,
                       const DeckKeyword& keyword,
                       const Schedule& schedule ) {
 
@@ -154,19 +203,23 @@ void handleMissingGroup( const ParseContext& parseContext , const std::string& k
             auto wells = schedule.getWellsMatching( pattern );
 
             if( wells.empty() )
-                handleMissingWell( parseContext, keyword.name(), pattern );
+                errors.missingWell( keyword.name(), pattern );
 
+            list.reserve( list.size() + wells.size() );
             for( const auto* well : wells )
                 list.push_back( SummaryConfig::keyword_type( keyword.name(), well->name() ));
         }
-    } else
-        for (const auto* well : schedule.getWells())
+    } else {
+        const auto wells = schedule.getWells();
+        list.reserve( list.size() + wells.size() );
+        for (const auto* well : wells)
             list.push_back( SummaryConfig::keyword_type( keyword.name(),  well->name()));
+    }
   }
 
 
 inline void keywordG( SummaryConfig::keyword_list& list,
-                      const ParseContext& parseContext,
+                      DeferredErrors& errors,
                       const DeckKeyword& keyword,
                       const Schedule& schedule ) {
 
@@ -188,7 +241,7 @@ inline void keywordG( SummaryConfig::keyword_list& list,
         if( schedule.hasGroup( group ) )
             list.push_back( SummaryConfig::keyword_type(keyword.name(), group ));
         else
-            handleMissingGroup( parseContext, keyword.name(), group );
+            errors.missingGroup( keyword.name(), group );
     }
 }
 
@@ -223,11 +276,11 @@ inline void keywordB( SummaryConfig::keyword_list& list,
 }
 
 inline void keywordR2R( SummaryConfig::keyword_list& list,
-                        const ParseContext& parseContext,
+                        DeferredErrors& errors,
                         const DeckKeyword& keyword)
 {
     std::string msg = "OPM/flow does not support region to region summary keywords - " + keyword.name() + " is ignored.";
-    parseContext.handleError(ParseContext::SUMMARY_UNHANDLED_KEYWORD, msg);
+    errors.unhandledKeyword(msg);
 }
 
 
@@ -271,7 +324,7 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
 
 
   inline void keywordC( SummaryConfig::keyword_list& list,
-                        const ParseContext& parseContext,
+                        DeferredErrors& errors,
                         const DeckKeyword& keyword,
                         const Schedule& schedule,
                         const GridDims& dims) {
@@ -288,7 +341,7 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
                          : schedule.getWellsMatching( wellitem.getTrimmedString( 0 ) );
 
         if( wells.empty() )
-            handleMissingWell( parseContext, keyword.name(), wellitem.getTrimmedString( 0 ) );
+            errors.missingWell( keyword.name(), wellitem.getTrimmedString( 0 ) );
 
         for( const auto* well : wells ) {
             const auto& name = well->name();
@@ -435,7 +488,7 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
     }
 
     void keywordSWithRecords(const std::size_t            last_timestep,
-                             const ParseContext&          parseContext,
+                             DeferredErrors&              errors,
                              const DeckKeyword&           keyword,
                              const Schedule&              schedule,
                              SummaryConfig::keyword_list& list)
@@ -463,8 +516,8 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
                 : schedule.getWellsMatching(wellitem.getTrimmedString(0));
 
             if (wells.empty()) {
-                handleMissingWell(parseContext, keyword.name(),
-                                  wellitem.getTrimmedString(0));
+                errors.missingWell(keyword.name(),
+                                   wellitem.getTrimmedString(0));
             }
 
             // Negative 1 (< 0) if segment ID defaulted.  Defaulted
@@ -477,7 +530,7 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
     }
 
     inline void keywordS(SummaryConfig::keyword_list& list,
-                         const ParseContext&          parseContext,
+                         DeferredErrors&              errors,
                          const DeckKeyword&           keyword,
                          const Schedule&              schedule)
     {
@@ -507,7 +560,7 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
         if (keyword.size() > 0) {
             // Keyword with explicit records.
             // Handle as alternatives SOFR and SPR above
-            keywordSWithRecords(last_timestep, parseContext,
+            keywordSWithRecords(last_timestep, errors,
                                 keyword, schedule, list);
         }
         else {
@@ -521,24 +574,24 @@ inline void keywordMISC( SummaryConfig::keyword_list& list,
                         const DeckKeyword& keyword,
                         const Schedule& schedule,
                         const TableManager& tables,
-                        const ParseContext& parseContext,
+                        DeferredErrors& errors,
                         const GridDims& dims) {
     const auto var_type = ecl_smspec_identify_var_type( keyword.name().c_str() );
 
     switch( var_type ) {
-        case ECL_SMSPEC_WELL_VAR: return keywordW( list, parseContext, keyword, schedule );
-        case ECL_SMSPEC_GROUP_VAR: return keywordG( list, parseContext, keyword, schedule );
+        case ECL_SMSPEC_WELL_VAR: return keywordW( list, errors, keyword, schedule );
+        case ECL_SMSPEC_GROUP_VAR: return keywordG( list, errors, keyword, schedule );
         case ECL_SMSPEC_FIELD_VAR: return keywordF( list, keyword );
         case ECL_SMSPEC_BLOCK_VAR: return keywordB( list, keyword, dims );
         case ECL_SMSPEC_REGION_VAR: return keywordR( list, keyword, tables );
-        case ECL_SMSPEC_REGION_2_REGION_VAR: return keywordR2R(list, parseContext, keyword);
-        case ECL_SMSPEC_COMPLETION_VAR: return keywordC( list, parseContext, keyword, schedule, dims);
-        case ECL_SMSPEC_SEGMENT_VAR: return keywordS( list, parseContext, keyword, schedule );
+        case ECL_SMSPEC_REGION_2_REGION_VAR: return keywordR2R(list, errors, keyword);
+        case ECL_SMSPEC_COMPLETION_VAR: return keywordC( list, errors, keyword, schedule, dims);
+        case ECL_SMSPEC_SEGMENT_VAR: return keywordS( list, errors, keyword, schedule );
         case ECL_SMSPEC_MISC_VAR: return keywordMISC( list, keyword );
 
         default:
             std::string msg = "Summary keywords of type: " + std::string(ecl_smspec_get_var_type_name( var_type )) + " is not supported. Keyword: " + keyword.name() + " is ignored";
-            parseContext.handleError(ParseContext::SUMMARY_UNHANDLED_KEYWORD, msg);
+            errors.unhandledKeyword(msg);
             return;
     }
 }
@@ -566,20 +619,58 @@ SummaryConfig::SummaryConfig( const Deck& deck,
                               const ParseContext& parseContext,
                               const GridDims& dims) {
     SUMMARYSection section( deck );
-    for( auto& x : section )
-        handleKW( this->keywords, x, schedule, tables, parseContext, dims);
 
-    if( section.hasKeyword( "ALL" ) )
-        this->merge( { ALL_keywords, schedule, tables, parseContext, dims} );
+    // The keywords of the SUMMARY section, followed by the keywords of
+    // the meta keywords in the section.
+    std::vector< const DeckKeyword* > summary_keywords;
+    for( const auto& x : section )
+        summary_keywords.push_back( &x );
+
+    const std::vector< std::pair< std::string, const Deck* > > meta_decks = {
+        { "ALL", &ALL_keywords },
+        { "GMWSET", &GMWSET_keywords },
+        { "FMWSET", &FMWSET_keywords },
+        { "PERFORMA", &PERFORMA_keywords }
+    };
 
-    if( section.hasKeyword( "GMWSET" ) )
-        this->merge( { GMWSET_keywords, schedule, tables, parseContext, dims} );
+    for( const auto& meta : meta_decks ) {
+        if( !section.hasKeyword( meta.first ) )
+            continue;
 
-    if( section.hasKeyword( "FMWSET" ) )
-        this->merge( { FMWSET_keywords, schedule, tables, parseContext, dims} );
+        for( const auto& x : SUMMARYSection( *meta.second ) )
+            summary_keywords.push_back( &x );
+    }
 
-    if (section.hasKeyword( "PERFORMA" ) )
-        this->merge( { PERFORMA_keywords, schedule, tables, parseContext, dims} );
+    const long num_keywords = summary_keywords.size();
+    std::vector< keyword_list > lists( num_keywords );
+    std::vector< DeferredErrors > errors( num_keywords );
+    std::vector< std::exception_ptr > exceptions( num_keywords );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (num_keywords > 1)
+#endif
+    for (long k = 0; k < num_keywords; ++k) {
+        try {
+            handleKW( lists[k], *summary_keywords[k], schedule, tables, errors[k], dims );
+        } catch (...) {
+            exceptions[k] = std::current_exception();
+        }
+    }
+
+    size_t num_nodes = 0;
+    for (long k = 0; k < num_keywords; ++k) {
+        errors[k].report( parseContext );
+        if (exceptions[k])
+            std::rethrow_exception( exceptions[k] );
+
+        num_nodes += lists[k].size();
+    }
+
+    this->keywords.reserve( num_nodes );
+    for (auto& list : lists)
+        this->keywords.insert( this->keywords.end(),
+                               std::make_move_iterator( list.begin() ),
+                               std::make_move_iterator( list.end() ) );
 
     uniq( this->keywords );
     for (const auto& kw: this->keywords) {
@@ -587,6 +678,8 @@ SummaryConfig::SummaryConfig( const Deck& deck,
         this->summary_keywords.insert( kw.gen_key() );
     }
 
+    if (MemoryUsage::enabled())
+        MemoryUsage::log( this->memory_usage() );
 }
 
 SummaryConfig::SummaryConfig( const Deck& deck,
@@ -661,6 +754,14 @@ bool SummaryConfig::require3DField( const std::string& keyword ) const {
 }
 
 
+MemoryUsage SummaryConfig::memory_usage() const {
+    MemoryUsage usage( "SummaryConfig", sizeof( *this ) );
+    usage.add( "keywords", MemoryUsage::heap( this->keywords ) );
+    usage.add( "keyword sets", MemoryUsage::heap( this->short_keywords )
+                             + MemoryUsage::heap( this->summary_keywords ) );
+    return usage;
+}
+
 bool SummaryConfig::requireFIPNUM( ) const {
     return this->hasKeyword("ROIP")  ||
            this->hasKeyword("ROIPL") ||
@@ -25,7 +25,7 @@ namespace Opm {
 
     JFunc::JFunc(const Deck& deck)
     {
-        const auto& kw = *deck.getKeywordList<ParserKeywords::JFUNC>()[0];
+        const auto& kw = deck.getKeyword<ParserKeywords::JFUNC>(0);
         const auto& rec = kw.getRecord(0);
         const auto& kw_flag = rec.getItem("FLAG").get<std::string>(0);
         if (kw_flag == "BOTH")
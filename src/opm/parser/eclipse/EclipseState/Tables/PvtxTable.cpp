@@ -149,5 +149,17 @@ namespace Opm {
             throw std::invalid_argument("Invalid index");
     }
 
+
+    size_t PvtxTable::memory_usage() const {
+        size_t bytes = m_outerColumn.memory_usage()
+                     + m_saturatedTable.memory_usage()
+                     + m_underSaturatedTables.capacity() * sizeof( SimpleTable );
+
+        for (const auto& table : m_underSaturatedTables)
+            bytes += table.memory_usage();
+
+        return bytes;
+    }
+
 }
 
@@ -157,4 +157,12 @@ namespace Opm {
         else
             std::cerr << "Developer warning: Raw values from JFUNC column is read, but JFUNC not provided in deck." << std::endl;
     }
+
+    size_t SimpleTable::memory_usage() const {
+        size_t bytes = 0;
+        for (const auto& column : m_columns)
+            bytes += sizeof( column ) + column.memory_usage();
+
+        return bytes;
+    }
 }
@@ -19,6 +19,7 @@
 #include <stdexcept>
 #include <algorithm>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/ColumnSchema.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
 
@@ -320,6 +321,13 @@ namespace Opm {
         return std::vector<double>( begin() , end());
     }
 
+
+    size_t TableColumn::memory_usage() const {
+        return MemoryUsage::heap( m_name )
+             + MemoryUsage::heap( m_values )
+             + MemoryUsage::heap( m_default );
+    }
+
 }
 
 
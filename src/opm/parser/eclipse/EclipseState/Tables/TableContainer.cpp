@@ -19,32 +19,36 @@
 
 #include <string>
 #include <iostream>
+#include <stdexcept>
 
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
 
 namespace Opm {
 
     TableContainer::TableContainer(size_t maxTables) :
-        m_maxTables(maxTables)
+        m_maxTables(maxTables),
+        m_tables(maxTables),
+        m_lookup(maxTables, nullptr)
     {
     }
 
 
     bool TableContainer::empty() const {
-        return m_tables.empty();
+        return m_size == 0;
     }
 
 
     size_t TableContainer::size() const {
-        return m_tables.size();
+        return m_size;
     }
 
 
     size_t TableContainer::hasTable(size_t tableNumber) const {
-        if (m_tables.find( tableNumber ) == m_tables.end())
+        if (tableNumber >= m_maxTables)
             return false;
-        else
-            return true;
+
+        return m_tables[tableNumber] != nullptr;
     }
 
 
@@ -52,15 +56,11 @@ namespace Opm {
         if (tableNumber >= m_maxTables)
             throw std::invalid_argument("TableContainer - invalid tableNumber");
 
-        if (hasTable(tableNumber)) {
-            auto pair = m_tables.find( tableNumber );
-            return *(pair->second.get());
-        } else {
-            if (tableNumber > 0)
-                return getTable(tableNumber -1);
-            else
-                throw std::invalid_argument("TableContainer does not have any table in the range 0..." + std::to_string( tableNumber ));
-        }
+        const auto* table = m_lookup[tableNumber];
+        if (!table)
+            throw std::invalid_argument("TableContainer does not have any table in the range 0..." + std::to_string( tableNumber ));
+
+        return *table;
     }
 
 
@@ -68,13 +68,30 @@ namespace Opm {
         return getTable(tableNumber);
     }
 
+    /*
+      The new table is used for its own number and the numbers after it
+      up to the next added table.
+    */
     void TableContainer::addTable(size_t tableNumber , std::shared_ptr<const SimpleTable> table) {
         if (tableNumber >= m_maxTables)
             throw std::invalid_argument("TableContainer has max: " + std::to_string( m_maxTables ) + " tables. Table number: " + std::to_string( tableNumber ) + " illegal.");
 
+        if (!m_tables[tableNumber])
+            m_size++;
+
         m_tables[tableNumber] = table;
+        m_lookup[tableNumber] = table.get();
+        for (size_t index = tableNumber + 1; index < m_maxTables && !m_tables[index]; index++)
+            m_lookup[index] = table.get();
     }
-}
-
 
+    size_t TableContainer::memory_usage() const {
+        size_t bytes = m_tables.capacity() * sizeof( m_tables[0] )
+                     + m_lookup.capacity() * sizeof( m_lookup[0] );
+        for (const auto& table : m_tables)
+            if (table)
+                bytes += sizeof( *table ) + table->memory_usage();
 
+        return bytes;
+    }
+}
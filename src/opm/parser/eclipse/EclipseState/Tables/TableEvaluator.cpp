@@ -0,0 +1,302 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <opm/parser/eclipse/EclipseState/Tables/PvtxTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableEvaluator.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      The index i of the segment [xs[i], xs[i+1]] containing x, for x
+      strictly inside the range of the ascending xs; the hint and its
+      neighbours are tried before the binary search.
+    */
+    std::size_t find_segment(const std::vector<double>& xs, double x, std::size_t hint) {
+        const std::size_t last = xs.size() - 2;
+        if (hint <= last) {
+            if (xs[hint] <= x) {
+                if (x <= xs[hint + 1])
+                    return hint;
+
+                if (hint < last && x <= xs[hint + 2])
+                    return hint + 1;
+            } else if (hint > 0 && xs[hint - 1] <= x)
+                return hint - 1;
+        }
+
+        const auto upper = std::upper_bound(xs.begin(), xs.end(), x);
+        const std::size_t index = upper - xs.begin();
+        return std::min(last, index == 0 ? 0 : index - 1);
+    }
+
+}
+
+
+    TableEvaluator::TableEvaluator(const SimpleTable& table, const std::string& column) {
+        const auto& argColumn = table.getColumn( 0 );
+        const auto& valueColumn = table.getColumn( column );
+
+        if (argColumn.hasDefault() || valueColumn.hasDefault())
+            throw std::invalid_argument("Can not evaluate a table column with defaulted values.");
+
+        *this = TableEvaluator( argColumn.vectorCopy(), valueColumn.vectorCopy() );
+    }
+
+
+    TableEvaluator::TableEvaluator(std::vector<double> xs, std::vector<double> ys) :
+        m_xs(std::move(xs)),
+        m_ys(std::move(ys))
+    {
+        if (m_xs.empty())
+            throw std::invalid_argument("Must have at least one element in a table for evaluation.");
+
+        if (m_xs.size() != m_ys.size())
+            throw std::invalid_argument("The argument and value columns must have the same size.");
+
+        if (m_xs.front() > m_xs.back()) {
+            std::reverse( m_xs.begin(), m_xs.end() );
+            std::reverse( m_ys.begin(), m_ys.end() );
+        }
+
+        if (!std::is_sorted( m_xs.begin(), m_xs.end() ))
+            throw std::invalid_argument("Must have an ordered column to perform table argument lookup.");
+    }
+
+
+    std::size_t TableEvaluator::size() const {
+        return m_xs.size();
+    }
+
+
+    const std::vector<double>& TableEvaluator::xs() const {
+        return m_xs;
+    }
+
+
+    const std::vector<double>& TableEvaluator::ys() const {
+        return m_ys;
+    }
+
+
+    bool TableEvaluator::uniform() const {
+        return !m_uniform.empty();
+    }
+
+
+    double TableEvaluator::interpolate(std::size_t seg, double x) const {
+        const double x0 = m_xs[seg];
+        const double x1 = m_xs[seg + 1];
+        const double weight1 = 1 - (x - x0) / (x1 - x0);
+        return weight1 * m_ys[seg] + (1 - weight1) * m_ys[seg + 1];
+    }
+
+
+    double TableEvaluator::operator()(double x, std::size_t& hint) const {
+        if (!m_uniform.empty()) {
+            const double t = (x - m_xmin) * m_inv_dx;
+            if (t <= 0)
+                return m_uniform.front();
+
+            const double last = static_cast<double>(m_uniform.size() - 1);
+            if (t >= last)
+                return m_uniform.back();
+
+            const std::size_t index = static_cast<std::size_t>(t);
+            const double f = t - index;
+            return m_uniform[index] + f * (m_uniform[index + 1] - m_uniform[index]);
+        }
+
+        if (x <= m_xs.front())
+            return m_ys.front();
+
+        if (x >= m_xs.back())
+            return m_ys.back();
+
+        hint = find_segment( m_xs, x, hint );
+        return this->interpolate( hint, x );
+    }
+
+
+    double TableEvaluator::operator()(double x) const {
+        std::size_t hint = (m_xs.size() - 1) / 2;
+        return (*this)( x, hint );
+    }
+
+
+    void TableEvaluator::evaluate(const double* x, double* y, std::size_t size) const {
+        std::size_t hint = (m_xs.size() - 1) / 2;
+        for (std::size_t index = 0; index < size; index++)
+            y[index] = (*this)( x[index], hint );
+    }
+
+
+    void TableEvaluator::evaluate(const std::vector<double>& x, std::vector<double>& y) const {
+        y.resize( x.size() );
+        this->evaluate( x.data(), y.data(), x.size() );
+    }
+
+
+    void TableEvaluator::resample(std::size_t samples) {
+        if (samples < 2)
+            throw std::invalid_argument("Must have at least two samples in a uniform table.");
+
+        if (m_xs.size() < 2 || m_xs.front() == m_xs.back())
+            return;
+
+        std::vector<double> uniform(samples);
+        const double xmin = m_xs.front();
+        const double xmax = m_xs.back();
+        std::size_t hint = 0;
+        for (std::size_t index = 0; index < samples; index++) {
+            const double w = double(index) / double(samples - 1);
+            uniform[index] = (*this)( (1 - w) * xmin + w * xmax, hint );
+        }
+
+        m_xmin = xmin;
+        m_inv_dx = (samples - 1) / (xmax - xmin);
+        m_uniform = std::move(uniform);
+    }
+
+
+    PvtxEvaluator::PvtxEvaluator(const PvtxTable& table, const std::string& column) {
+        for (std::size_t index = 0; index < table.size(); index++) {
+            m_outer.push_back( table.getArgValue( index ) );
+            m_inner.emplace_back( table.getUnderSaturatedTable( index ), column );
+        }
+
+        if (m_outer.empty())
+            throw std::invalid_argument("Must have at least one element in a table for evaluation.");
+
+        if (!std::is_sorted( m_outer.begin(), m_outer.end() ))
+            throw std::invalid_argument("Must have an ordered column to perform table argument lookup.");
+    }
+
+
+    /*
+      The two undersaturated tables around the outer argument share the
+      inner hint, they usually cover the same pressure range.
+    */
+    double PvtxEvaluator::eval(double outerArg, double innerArg, std::size_t& outer_hint, std::size_t& inner_hint) const {
+        if (outerArg <= m_outer.front())
+            return m_inner.front()( innerArg, inner_hint );
+
+        if (outerArg >= m_outer.back())
+            return m_inner.back()( innerArg, inner_hint );
+
+        outer_hint = find_segment( m_outer, outerArg, outer_hint );
+        const double x0 = m_outer[outer_hint];
+        const double x1 = m_outer[outer_hint + 1];
+        const double weight1 = 1 - (outerArg - x0) / (x1 - x0);
+
+        double value = weight1 * m_inner[outer_hint]( innerArg, inner_hint );
+        if (weight1 < 1)
+            value += (1 - weight1) * m_inner[outer_hint + 1]( innerArg, inner_hint );
+
+        return value;
+    }
+
+
+    double PvtxEvaluator::operator()(double outerArg, double innerArg) const {
+        std::size_t outer_hint = (m_outer.size() - 1) / 2;
+        std::size_t inner_hint = 0;
+        return this->eval( outerArg, innerArg, outer_hint, inner_hint );
+    }
+
+
+    void PvtxEvaluator::evaluate(const double* outerArg, const double* innerArg, double* y, std::size_t size) const {
+        std::size_t outer_hint = (m_outer.size() - 1) / 2;
+        std::size_t inner_hint = 0;
+        for (std::size_t index = 0; index < size; index++)
+            y[index] = this->eval( outerArg[index], innerArg[index], outer_hint, inner_hint );
+    }
+
+
+    void PvtxEvaluator::evaluate(const std::vector<double>& outerArg,
+                                 const std::vector<double>& innerArg,
+                                 std::vector<double>& y) const {
+        if (outerArg.size() != innerArg.size())
+            throw std::invalid_argument("The outer and inner arguments must have the same size.");
+
+        y.resize( outerArg.size() );
+        this->evaluate( outerArg.data(), innerArg.data(), y.data(), outerArg.size() );
+    }
+
+
+    void PvtxEvaluator::resample(std::size_t samples) {
+        for (auto& inner : m_inner)
+            inner.resample( samples );
+    }
+
+
+    DepthTableEvaluator::DepthTableEvaluator(const TableContainer& tables, const std::string& column, std::size_t numRegions) {
+        for (std::size_t region = 0; region < numRegions; region++)
+            m_tables.emplace_back( tables.getTable( region ), column );
+    }
+
+
+    std::size_t DepthTableEvaluator::numRegions() const {
+        return m_tables.size();
+    }
+
+
+    const TableEvaluator& DepthTableEvaluator::table(int region) const {
+        if (region < 1 || static_cast<std::size_t>(region) > m_tables.size())
+            throw std::invalid_argument("Equilibration region " + std::to_string(region) + " out of range.");
+
+        return m_tables[region - 1];
+    }
+
+
+    double DepthTableEvaluator::operator()(int region, double depth) const {
+        return this->table( region )( depth );
+    }
+
+
+    void DepthTableEvaluator::evaluate(int region, const double* depth, double* values, std::size_t size) const {
+        this->table( region ).evaluate( depth, values, size );
+    }
+
+
+    void DepthTableEvaluator::evaluate(const std::vector<int>& eqlnum,
+                                       const std::vector<double>& depth,
+                                       std::vector<double>& values) const {
+        if (eqlnum.size() != depth.size())
+            throw std::invalid_argument("The EQLNUM and depth arrays must have the same size.");
+
+        std::vector<std::size_t> hints;
+        for (const auto& table : m_tables)
+            hints.push_back( (table.size() - 1) / 2 );
+
+        values.resize( depth.size() );
+        for (std::size_t cell = 0; cell < depth.size(); cell++) {
+            const int region = eqlnum[cell];
+            values[cell] = this->table( region )( depth[cell], hints[region - 1] );
+        }
+    }
+}
@@ -18,7 +18,11 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
 
 #include <opm/common/OpmLog/LogUtil.hpp>
 
@@ -91,6 +95,57 @@ namespace Opm {
 
 
 
+    /*
+      In lazy mode the table collections are registered with the builder
+      which fills them; the builder runs once, on the first access to
+      the collection.
+    */
+    struct TableManager::LazyTables {
+        struct Tables {
+            Tables( size_t numTables, TableBuilder tableBuilder ) :
+                tables( numTables ),
+                maxTables( numTables ),
+                builder( std::move( tableBuilder ) )
+            {}
+
+            TableContainer tables;
+            size_t maxTables;
+            TableBuilder builder;
+            std::once_flag built;
+            std::atomic< bool > ready{ false };
+        };
+
+        explicit LazyTables( std::shared_ptr< const Deck > tableDeck ) :
+            deck( std::move( tableDeck ) )
+        {}
+
+        /*
+          The container is only assigned when the builder has completed,
+          a builder which throws is run again on the next access.
+        */
+        const TableContainer& get( Tables& entry ) const {
+            std::call_once( entry.built, [this, &entry]() {
+                TableContainer tables( entry.maxTables );
+                if (entry.builder)
+                    entry.builder( *this->deck, tables );
+                entry.tables = std::move( tables );
+                entry.ready.store( true, std::memory_order_release );
+            });
+            return entry.tables;
+        }
+
+        std::shared_ptr< const Deck > deck;
+        std::map< std::string, Tables > tables;
+
+        std::once_flag pvtgBuilt;
+        std::once_flag pvtoBuilt;
+        std::atomic< bool > pvtgReady{ false };
+        std::atomic< bool > pvtoReady{ false };
+        std::vector< PvtgTable > pvtgTables;
+        std::vector< PvtoTable > pvtoTables;
+    };
+
+
     TableManager::TableManager( const Deck& deck )
         :
         m_tabdims( Tabdims(deck)),
@@ -99,6 +154,22 @@ namespace Opm {
         hasEnptvd (deck.hasKeyword("ENPTVD")),
         hasEqlnum (deck.hasKeyword("EQLNUM"))
     {
+        this->init( deck );
+    }
+
+    TableManager::TableManager( std::shared_ptr< const Deck > deck )
+        :
+        m_tabdims( Tabdims(*deck)),
+        m_aqudims( Aqudims(*deck)),
+        hasImptvd (deck->hasKeyword("IMPTVD")),
+        hasEnptvd (deck->hasKeyword("ENPTVD")),
+        hasEqlnum (deck->hasKeyword("EQLNUM")),
+        m_lazyTables( std::make_shared< LazyTables >( deck ) )
+    {
+        this->init( *deck );
+    }
+
+    void TableManager::init( const Deck& deck ) {
         if (deck.hasKeyword("JFUNC"))
             jfunc.reset( new JFunc(deck) );
 
@@ -108,8 +179,11 @@ namespace Opm {
 
         initDims( deck );
         initSimpleTables( deck );
-        initFullTables(deck, "PVTG", m_pvtgTables);
-        initFullTables(deck, "PVTO", m_pvtoTables);
+        if (!m_lazyTables) {
+            initFullTables(deck, "PVTG", m_pvtgTables);
+            initFullTables(deck, "PVTO", m_pvtoTables);
+        }
+
         if( deck.hasKeyword( "PVTW" ) )
             this->m_pvtwTable = PvtwTable( deck.getKeyword( "PVTW" ) );
 
@@ -164,12 +238,29 @@ namespace Opm {
     }
 
 
-    void TableManager::addTables( const std::string& tableName , size_t numTables) {
-        m_simpleTables.emplace(std::make_pair(tableName , TableContainer( numTables )));
+    void TableManager::addTables( const Deck& deck, const std::string& tableName , size_t numTables, TableBuilder builder) {
+        if (m_lazyTables) {
+            m_lazyTables->tables.emplace( std::piecewise_construct,
+                                          std::forward_as_tuple( tableName ),
+                                          std::forward_as_tuple( numTables, std::move( builder ) ));
+            return;
+        }
+
+        auto& container = m_simpleTables.emplace(std::make_pair(tableName , TableContainer( numTables ))).first->second;
+        if (builder)
+            builder( deck, container );
     }
 
 
     bool TableManager::hasTables( const std::string& tableName ) const {
+        if (m_lazyTables) {
+            auto pair = m_lazyTables->tables.find( tableName );
+            if (pair == m_lazyTables->tables.end())
+                return false;
+
+            return !m_lazyTables->get( pair->second ).empty();
+        }
+
         auto pair = m_simpleTables.find( tableName );
         if (pair == m_simpleTables.end())
             return false;
@@ -181,6 +272,14 @@ namespace Opm {
 
 
     const TableContainer& TableManager::getTables( const std::string& tableName ) const {
+        if (m_lazyTables) {
+            auto pair = m_lazyTables->tables.find( tableName );
+            if (pair == m_lazyTables->tables.end())
+                throw std::invalid_argument("No such table collection: " + tableName);
+
+            return m_lazyTables->get( pair->second );
+        }
+
         auto pair = m_simpleTables.find( tableName );
         if (pair == m_simpleTables.end())
             throw std::invalid_argument("No such table collection: " + tableName);
@@ -188,55 +287,46 @@ namespace Opm {
             return pair->second;
     }
 
-    TableContainer& TableManager::forceGetTables( const std::string& tableName , size_t numTables )  {
-        auto pair = m_simpleTables.find( tableName );
-        if (pair == m_simpleTables.end()) {
-            addTables( tableName , numTables );
-            pair = m_simpleTables.find( tableName );
-        }
-        return pair->second;
-    }
-
 
     const TableContainer& TableManager::operator[](const std::string& tableName) const {
         return getTables(tableName);
     }
 
     void TableManager::initSimpleTables(const Deck& deck) {
-        addTables( "SWOF" , m_tabdims.getNumSatTables() );
-        addTables( "SGWFN", m_tabdims.getNumSatTables() );
-        addTables( "SGOF",  m_tabdims.getNumSatTables() );
-        addTables( "SLGOF", m_tabdims.getNumSatTables() );
-        addTables( "SOF2",  m_tabdims.getNumSatTables() );
-        addTables( "SOF3",  m_tabdims.getNumSatTables() );
-        addTables( "SWFN",  m_tabdims.getNumSatTables() );
-        addTables( "SGFN",  m_tabdims.getNumSatTables() );
-        addTables( "SSFN",  m_tabdims.getNumSatTables() );
-        addTables( "MSFN",  m_tabdims.getNumSatTables() );
-
-        addTables( "PLYADS", m_tabdims.getNumSatTables() );
-        addTables( "PLYROCK", m_tabdims.getNumSatTables());
-        addTables( "PLYVISC", m_tabdims.getNumPVTTables());
-        addTables( "PLYDHFLF", m_tabdims.getNumPVTTables());
-
-        addTables( "PVDG", m_tabdims.getNumPVTTables());
-        addTables( "PVDO", m_tabdims.getNumPVTTables());
-        addTables( "PVDS", m_tabdims.getNumPVTTables());
-
-        addTables( "SPECHEAT", m_tabdims.getNumPVTTables());
-        addTables( "SPECROCK", m_tabdims.getNumSatTables());
-
-        addTables( "OILVISCT", m_tabdims.getNumPVTTables());
-        addTables( "WATVISCT", m_tabdims.getNumPVTTables());
-        addTables( "GASVISCT", m_tabdims.getNumPVTTables());
-
-        addTables( "PLYMAX", m_regdims->getNPLMIX());
-        addTables( "RSVD", m_eqldims->getNumEquilRegions());
-        addTables( "RVVD", m_eqldims->getNumEquilRegions());
-        addTables( "PBVD", m_eqldims->getNumEquilRegions());
-        addTables( "PDVD", m_eqldims->getNumEquilRegions());
-
-        addTables( "AQUTAB", m_aqudims.getNumInfluenceTablesCT());
+        addSimpleTablesWithJFunc<SwofTable>(deck, "SWOF", m_tabdims.getNumSatTables());
+        addSimpleTables<SgwfnTable>(deck, "SGWFN", m_tabdims.getNumSatTables());
+        addSimpleTablesWithJFunc<SgofTable>(deck, "SGOF", m_tabdims.getNumSatTables());
+        addSimpleTablesWithJFunc<SlgofTable>(deck, "SLGOF", m_tabdims.getNumSatTables());
+        addSimpleTables<Sof2Table>(deck, "SOF2", m_tabdims.getNumSatTables());
+        addSimpleTables<Sof3Table>(deck, "SOF3", m_tabdims.getNumSatTables());
+        addSimpleTablesWithJFunc<SwfnTable>(deck, "SWFN", m_tabdims.getNumSatTables());
+        addSimpleTablesWithJFunc<SgfnTable>(deck, "SGFN", m_tabdims.getNumSatTables());
+        addSimpleTables<SsfnTable>(deck, "SSFN", m_tabdims.getNumSatTables());
+        addSimpleTables<MsfnTable>(deck, "MSFN", m_tabdims.getNumSatTables());
+
+        addSimpleTables<PlyadsTable>(deck, "PLYADS", m_tabdims.getNumSatTables());
+        addTables(deck, "PLYROCK", m_tabdims.getNumSatTables(), &TableManager::initPlyrockTables);
+        addSimpleTables<PlyviscTable>(deck, "PLYVISC", m_tabdims.getNumPVTTables());
+        addSimpleTables<PlydhflfTable>(deck, "PLYDHFLF", m_tabdims.getNumPVTTables());
+
+        addSimpleTables<PvdgTable>(deck, "PVDG", m_tabdims.getNumPVTTables());
+        addSimpleTables<PvdoTable>(deck, "PVDO", m_tabdims.getNumPVTTables());
+        addSimpleTables<PvdsTable>(deck, "PVDS", m_tabdims.getNumPVTTables());
+
+        addSimpleTables<SpecheatTable>(deck, "SPECHEAT", m_tabdims.getNumPVTTables());
+        addSimpleTables<SpecrockTable>(deck, "SPECROCK", m_tabdims.getNumSatTables());
+
+        addSimpleTables<OilvisctTable>(deck, "OILVISCT", m_tabdims.getNumPVTTables());
+        addSimpleTables<WatvisctTable>(deck, "WATVISCT", m_tabdims.getNumPVTTables());
+        addTables(deck, "GASVISCT", m_tabdims.getNumPVTTables(), &TableManager::initGasvisctTables);
+
+        addTables(deck, "PLYMAX", m_regdims->getNPLMIX(), &TableManager::initPlymaxTables);
+        addSimpleTables<RsvdTable>(deck, "RSVD", m_eqldims->getNumEquilRegions());
+        addSimpleTables<RvvdTable>(deck, "RVVD", m_eqldims->getNumEquilRegions());
+        addSimpleTables<PbvdTable>(deck, "PBVD", m_eqldims->getNumEquilRegions());
+        addSimpleTables<PdvdTable>(deck, "PDVD", m_eqldims->getNumEquilRegions());
+
+        addSimpleTables<AqutabTable>(deck, "AQUTAB", m_aqudims.getNumInfluenceTablesCT());
         {
             size_t numMiscibleTables = ParserKeywords::MISCIBLE::NTMISC::defaultValue;
             if (deck.hasKeyword<ParserKeywords::MISCIBLE>()) {
@@ -244,11 +334,11 @@ namespace Opm {
                 const auto& record = keyword.getRecord(0);
                 numMiscibleTables =  static_cast<size_t>(record.getItem<ParserKeywords::MISCIBLE::NTMISC>().get< int >(0));
             }
-            addTables( "SORWMIS", numMiscibleTables);
-            addTables( "SGCWMIS", numMiscibleTables);
-            addTables( "MISC",    numMiscibleTables);
-            addTables( "PMISC",   numMiscibleTables);
-            addTables( "TLPMIXPA",numMiscibleTables);
+            addSimpleTables<SorwmisTable>(deck, "SORWMIS", numMiscibleTables);
+            addSimpleTables<SgcwmisTable>(deck, "SGCWMIS", numMiscibleTables);
+            addSimpleTables<MiscTable>(deck, "MISC", numMiscibleTables);
+            addSimpleTables<PmiscTable>(deck, "PMISC", numMiscibleTables);
+            addSimpleTables<TlpmixpaTable>(deck, "TLPMIXPA", numMiscibleTables);
         }
 
         {
@@ -260,10 +350,10 @@ namespace Opm {
                 numEndScaleTables = static_cast<size_t>(record.getItem<ParserKeywords::ENDSCALE::NUM_TABLES>().get< int >(0));
             }
 
-            addTables( "ENKRVD", numEndScaleTables);
-            addTables( "ENPTVD", numEndScaleTables);
-            addTables( "IMKRVD", numEndScaleTables);
-            addTables( "IMPTVD", numEndScaleTables);
+            addSimpleTables<EnkrvdTable>(deck, "ENKRVD", numEndScaleTables);
+            addSimpleTables<EnptvdTable>(deck, "ENPTVD", numEndScaleTables);
+            addSimpleTables<ImkrvdTable>(deck, "IMKRVD", numEndScaleTables);
+            addSimpleTables<ImptvdTable>(deck, "IMPTVD", numEndScaleTables);
         }
         {
             size_t numRocktabTables = ParserKeywords::ROCKCOMP::NTROCC::defaultValue;
@@ -273,76 +363,15 @@ namespace Opm {
                 const auto& record = keyword.getRecord(0);
                 numRocktabTables = static_cast<size_t>(record.getItem<ParserKeywords::ROCKCOMP::NTROCC>().get< int >(0));
             }
-            addTables( "ROCKTAB", numRocktabTables);
+            addTables(deck, "ROCKTAB", numRocktabTables, &TableManager::initRocktabTables);
         }
 
+        initRTempTables(deck);
 
-        initSimpleTableContainer<SgwfnTable>(deck, "SGWFN", m_tabdims.getNumSatTables());
-        initSimpleTableContainer<Sof2Table>(deck, "SOF2" , m_tabdims.getNumSatTables());
-        initSimpleTableContainer<Sof3Table>(deck, "SOF3" , m_tabdims.getNumSatTables());
-        {
-            initSimpleTableContainerWithJFunc<SwofTable>(deck, "SWOF", m_tabdims.getNumSatTables());
-            initSimpleTableContainerWithJFunc<SgofTable>(deck, "SGOF", m_tabdims.getNumSatTables());
-            initSimpleTableContainerWithJFunc<SwfnTable>(deck, "SWFN", m_tabdims.getNumSatTables());
-            initSimpleTableContainerWithJFunc<SgfnTable>(deck, "SGFN", m_tabdims.getNumSatTables());
-            initSimpleTableContainerWithJFunc<SlgofTable>(deck, "SLGOF", m_tabdims.getNumSatTables());
-
-        }
-        initSimpleTableContainer<SsfnTable>(deck, "SSFN" , m_tabdims.getNumSatTables());
-        initSimpleTableContainer<MsfnTable>(deck, "MSFN" , m_tabdims.getNumSatTables());
-
-        initSimpleTableContainer<RsvdTable>(deck, "RSVD" , m_eqldims->getNumEquilRegions());
-        initSimpleTableContainer<RvvdTable>(deck, "RVVD" , m_eqldims->getNumEquilRegions());
-        initSimpleTableContainer<PbvdTable>(deck, "PBVD" , m_eqldims->getNumEquilRegions());
-        initSimpleTableContainer<PdvdTable>(deck, "PDVD" , m_eqldims->getNumEquilRegions());
-        initSimpleTableContainer<AqutabTable>(deck, "AQUTAB" , m_aqudims.getNumInfluenceTablesCT());
-        {
-            size_t numEndScaleTables = ParserKeywords::ENDSCALE::NUM_TABLES::defaultValue;
-
-            if (deck.hasKeyword<ParserKeywords::ENDSCALE>()) {
-                const auto& keyword = deck.getKeyword<ParserKeywords::ENDSCALE>();
-                const auto& record = keyword.getRecord(0);
-                numEndScaleTables = static_cast<size_t>(record.getItem<ParserKeywords::ENDSCALE::NUM_TABLES>().get< int >(0));
-            }
-
-            initSimpleTableContainer<EnkrvdTable>( deck , "ENKRVD", numEndScaleTables);
-            initSimpleTableContainer<EnptvdTable>( deck , "ENPTVD", numEndScaleTables);
-            initSimpleTableContainer<ImkrvdTable>( deck , "IMKRVD", numEndScaleTables);
-            initSimpleTableContainer<ImptvdTable>( deck , "IMPTVD", numEndScaleTables);
-        }
+        // PLYSHLOG is only present if the deck has the keyword
+        if (deck.hasKeyword("PLYSHLOG"))
+            addTables(deck, "PLYSHLOG", m_tabdims.getNumPVTTables(), &TableManager::initPlyshlogTables);
 
-        {
-            size_t numMiscibleTables = ParserKeywords::MISCIBLE::NTMISC::defaultValue;
-            if (deck.hasKeyword<ParserKeywords::MISCIBLE>()) {
-                const auto& keyword = deck.getKeyword<ParserKeywords::MISCIBLE>();
-                const auto& record = keyword.getRecord(0);
-                numMiscibleTables =  static_cast<size_t>(record.getItem<ParserKeywords::MISCIBLE::NTMISC>().get< int >(0));
-            }
-            initSimpleTableContainer<SorwmisTable>(deck, "SORWMIS", numMiscibleTables);
-            initSimpleTableContainer<SgcwmisTable>(deck, "SGCWMIS", numMiscibleTables);
-            initSimpleTableContainer<MiscTable>(deck, "MISC", numMiscibleTables);
-            initSimpleTableContainer<PmiscTable>(deck, "PMISC", numMiscibleTables);
-            initSimpleTableContainer<TlpmixpaTable>(deck, "TLPMIXPA", numMiscibleTables);
-
-        }
-
-        initSimpleTableContainer<PvdgTable>(deck, "PVDG", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<PvdoTable>(deck, "PVDO", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<PvdsTable>(deck, "PVDS", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<SpecheatTable>(deck, "SPECHEAT", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<SpecrockTable>(deck, "SPECROCK", m_tabdims.getNumSatTables());
-        initSimpleTableContainer<OilvisctTable>(deck, "OILVISCT", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<WatvisctTable>(deck, "WATVISCT", m_tabdims.getNumPVTTables());
-
-        initSimpleTableContainer<PlyadsTable>(deck, "PLYADS", m_tabdims.getNumSatTables());
-        initSimpleTableContainer<PlyviscTable>(deck, "PLYVISC", m_tabdims.getNumPVTTables());
-        initSimpleTableContainer<PlydhflfTable>(deck, "PLYDHFLF", m_tabdims.getNumPVTTables());
-        initPlyrockTables(deck);
-        initPlymaxTables(deck);
-        initGasvisctTables(deck);
-        initRTempTables(deck);
-        initRocktabTables(deck);
-        initPlyshlogTables(deck);
         initPlymwinjTables(deck);
         initSkprpolyTables(deck);
         initSkprwatTables(deck);
@@ -357,28 +386,26 @@ namespace Opm {
         if (deck.hasKeyword("TEMPVD") && deck.hasKeyword("RTEMPVD"))
             throw std::invalid_argument("The TEMPVD and RTEMPVD tables are mutually exclusive!");
         else if (deck.hasKeyword("TEMPVD"))
-            initSimpleTableContainer<RtempvdTable>(deck, "TEMPVD", "RTEMPVD", m_eqldims->getNumEquilRegions());
+            addSimpleTables<RtempvdTable>(deck, "TEMPVD", "RTEMPVD", m_eqldims->getNumEquilRegions());
         else if (deck.hasKeyword("RTEMPVD"))
-            initSimpleTableContainer<RtempvdTable>(deck, "RTEMPVD", "RTEMPVD" , m_eqldims->getNumEquilRegions());
+            addSimpleTables<RtempvdTable>(deck, "RTEMPVD", "RTEMPVD" , m_eqldims->getNumEquilRegions());
     }
 
 
-    void TableManager::initGasvisctTables(const Deck& deck) {
+    void TableManager::initGasvisctTables(const Deck& deck, TableContainer& container) {
 
         const std::string keywordName = "GASVISCT";
-        size_t numTables = m_tabdims.getNumPVTTables();
 
-        if (!deck.hasKeyword(keywordName))
+        const auto keywords = deck.getKeywordRange(keywordName);
+        if (keywords.empty())
             return; // the table is not featured by the deck...
 
-        auto& container = forceGetTables(keywordName , numTables);
-
-        if (deck.count(keywordName) > 1) {
+        if (keywords.size() > 1) {
             complainAboutAmbiguousKeyword(deck, keywordName);
             return;
         }
 
-        const auto& tableKeyword = deck.getKeyword(keywordName);
+        const auto& tableKeyword = keywords.front();
         for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
             const auto& tableRecord = tableKeyword.getRecord( tableIdx );
             const auto& dataItem = tableRecord.getItem( 0 );
@@ -390,7 +417,7 @@ namespace Opm {
     }
 
 
-    void TableManager::initPlyshlogTables(const Deck& deck) {
+    void TableManager::initPlyshlogTables(const Deck& deck, TableContainer& container) {
         const std::string keywordName = "PLYSHLOG";
 
         if (!deck.hasKeyword(keywordName)) {
@@ -401,8 +428,6 @@ namespace Opm {
             complainAboutAmbiguousKeyword(deck, keywordName);
             return;
         }
-        size_t numTables = m_tabdims.getNumPVTTables();
-        auto& container = forceGetTables(keywordName , numTables);
         const auto& tableKeyword = deck.getKeyword(keywordName);
 
         if (tableKeyword.size() > 2) {
@@ -426,11 +451,7 @@ namespace Opm {
             return;
         }
 
-        const size_t num_tables = deck.count("PLYMWINJ");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::PLYMWINJ>();
-        for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
-
+        for (const auto& keyword : deck.getKeywordRange<ParserKeywords::PLYMWINJ>()) {
             // not const for std::move
             PlymwinjTable table(keyword);
 
@@ -452,11 +473,7 @@ namespace Opm {
             return;
         }
 
-        const size_t num_tables = deck.count("SKPRWAT");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::SKPRWAT>();
-        for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
-
+        for (const auto& keyword : deck.getKeywordRange<ParserKeywords::SKPRWAT>()) {
             // not const for std::move
             SkprwatTable table(keyword);
 
@@ -478,11 +495,7 @@ namespace Opm {
             return;
         }
 
-        const size_t num_tables = deck.count("SKPRPOLY");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::SKPRPOLY>();
-        for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
-
+        for (const auto& keyword : deck.getKeywordRange<ParserKeywords::SKPRPOLY>()) {
             // not const for std::move
             SkprpolyTable table(keyword);
 
@@ -499,8 +512,7 @@ namespace Opm {
         }
     }
 
-    void TableManager::initPlyrockTables(const Deck& deck) {
-        size_t numTables = m_tabdims.getNumSatTables();
+    void TableManager::initPlyrockTables(const Deck& deck, TableContainer& container) {
         const std::string keywordName = "PLYROCK";
         if (!deck.hasKeyword(keywordName)) {
             return;
@@ -512,7 +524,6 @@ namespace Opm {
         }
 
         const auto& keyword = deck.getKeyword<ParserKeywords::PLYROCK>();
-        auto& container = forceGetTables(keywordName , numTables);
         for (size_t tableIdx = 0; tableIdx < keyword.size(); ++tableIdx) {
             const auto& tableRecord = keyword.getRecord( tableIdx );
             std::shared_ptr<PlyrockTable> table = std::make_shared<PlyrockTable>(tableRecord);
@@ -521,8 +532,7 @@ namespace Opm {
     }
 
 
-    void TableManager::initPlymaxTables(const Deck& deck) {
-        size_t numTables = m_regdims->getNPLMIX();
+    void TableManager::initPlymaxTables(const Deck& deck, TableContainer& container) {
         const std::string keywordName = "PLYMAX";
         if (!deck.hasKeyword(keywordName)) {
             return;
@@ -534,7 +544,6 @@ namespace Opm {
         }
 
         const auto& keyword = deck.getKeyword<ParserKeywords::PLYMAX>();
-        auto& container = forceGetTables(keywordName , numTables);
         for (size_t tableIdx = 0; tableIdx < keyword.size(); ++tableIdx) {
             const auto& tableRecord = keyword.getRecord( tableIdx );
             std::shared_ptr<PlymaxTable> table = std::make_shared<PlymaxTable>( tableRecord );
@@ -544,7 +553,7 @@ namespace Opm {
 
 
 
-    void TableManager::initRocktabTables(const Deck& deck) {
+    void TableManager::initRocktabTables(const Deck& deck, TableContainer& container) {
         if (!deck.hasKeyword("ROCKTAB"))
             return; // ROCKTAB is not featured by the deck...
 
@@ -552,11 +561,10 @@ namespace Opm {
             complainAboutAmbiguousKeyword(deck, "ROCKTAB");
             return;
         }
-        const auto& rockcompKeyword = deck.getKeyword<ParserKeywords::ROCKCOMP>();
-        const auto& record = rockcompKeyword.getRecord( 0 );
-        size_t numTables = record.getItem<ParserKeywords::ROCKCOMP::NTROCC>().get< int >(0);
-        auto& container = forceGetTables("ROCKTAB" , numTables);
-        const auto rocktabKeyword = deck.getKeyword("ROCKTAB");
+        if (!deck.hasKeyword<ParserKeywords::ROCKCOMP>())
+            throw std::invalid_argument("The ROCKTAB keyword requires the ROCKCOMP keyword");
+
+        const auto& rocktabKeyword = deck.getKeyword("ROCKTAB");
 
         bool isDirectional = deck.hasKeyword<ParserKeywords::RKTRMDIR>();
         bool useStressOption = false;
@@ -749,13 +757,69 @@ namespace Opm {
     }
 
     const std::vector<PvtgTable>& TableManager::getPvtgTables() const {
+        if (m_lazyTables) {
+            auto& lazy = *m_lazyTables;
+            std::call_once( lazy.pvtgBuilt, [&lazy]() {
+                initFullTables( *lazy.deck, "PVTG", lazy.pvtgTables );
+                lazy.pvtgReady.store( true, std::memory_order_release );
+            });
+            return lazy.pvtgTables;
+        }
+
         return m_pvtgTables;
     }
 
     const std::vector<PvtoTable>& TableManager::getPvtoTables() const {
+        if (m_lazyTables) {
+            auto& lazy = *m_lazyTables;
+            std::call_once( lazy.pvtoBuilt, [&lazy]() {
+                initFullTables( *lazy.deck, "PVTO", lazy.pvtoTables );
+                lazy.pvtoReady.store( true, std::memory_order_release );
+            });
+            return lazy.pvtoTables;
+        }
+
         return m_pvtoTables;
     }
 
+    namespace {
+        template< typename TableType >
+        size_t pvtx_memory_usage( const std::vector< TableType >& tables ) {
+            size_t bytes = MemoryUsage::heap( tables );
+            for (const auto& table : tables)
+                bytes += table.memory_usage();
+
+            return bytes;
+        }
+    }
+
+    MemoryUsage TableManager::memory_usage() const {
+        MemoryUsage usage( "TableManager", sizeof( *this ) );
+
+        if (m_lazyTables) {
+            const auto& lazy = *m_lazyTables;
+            for (const auto& pair : lazy.tables) {
+                if (pair.second.ready.load( std::memory_order_acquire ))
+                    usage.add( pair.first, pair.second.tables.memory_usage() );
+            }
+
+            if (lazy.pvtgReady.load( std::memory_order_acquire ))
+                usage.add( "PVTG", pvtx_memory_usage( lazy.pvtgTables ) );
+
+            if (lazy.pvtoReady.load( std::memory_order_acquire ))
+                usage.add( "PVTO", pvtx_memory_usage( lazy.pvtoTables ) );
+        } else {
+            for (const auto& pair : m_simpleTables)
+                usage.add( pair.first, pair.second.memory_usage() );
+
+            usage.add( "PVTG", pvtx_memory_usage( m_pvtgTables ) );
+            usage.add( "PVTO", pvtx_memory_usage( m_pvtoTables ) );
+        }
+
+        usage.sort();
+        return usage;
+    }
+
     const PvtwTable& TableManager::getPvtwTable() const {
         return this->m_pvtwTable;
     }
@@ -840,10 +904,9 @@ namespace Opm {
 
     void TableManager::complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName) {
         OpmLog::error("The " + keywordName + " keyword must be unique in the deck. Ignoring all!");
-        const auto& keywords = deck.getKeywordList(keywordName);
-        for (size_t i = 0; i < keywords.size(); ++i) {
+        for (const auto& keyword : deck.getKeywordRange(keywordName)) {
             std::string msg = "Ambiguous keyword "+keywordName+" defined here";
-            OpmLog::error(Log::fileMessage(keywords[i]->getFileName(), keywords[i]->getLineNumber(), msg));
+            OpmLog::error(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
         }
     }
 
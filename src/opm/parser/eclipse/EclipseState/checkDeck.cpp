@@ -25,20 +25,28 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 
+#include "../Deck/KeywordRanges.hpp"
+
 namespace Opm {
 bool checkDeck( Deck& deck, const Parser& parser, size_t enabledChecks) {
     bool deckValid = true;
 
-    // make sure that the deck does not contain unknown keywords
+    // make sure that the deck does not contain unknown keywords; the
+    // keywords are looked up as a parallel reduction over ranges of the deck
     if (enabledChecks & UnknownKeywords) {
-        size_t keywordIdx = 0;
-        for (; keywordIdx < deck.size(); keywordIdx++) {
-            const auto& keyword = deck.getKeyword(keywordIdx);
-            if (!parser.isRecognizedKeyword( keyword.name() ) ) {
-                std::string msg("Keyword '" + keyword.name() + "' is unknown.");
-                OpmLog::warning( Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg) );
-                deckValid = false;
+        const Deck& constDeck = deck;
+        const auto check = [&constDeck, &parser]( size_t first, size_t last, KeywordMessages& messages ) {
+            for (size_t keywordIdx = first; keywordIdx < last; keywordIdx++) {
+                const auto& keyword = constDeck.getKeyword(keywordIdx);
+                if (!parser.isRecognizedKeyword( keyword.name() ) )
+                    messages.emplace_back( keywordIdx, "Keyword '" + keyword.name() + "' is unknown." );
             }
+        };
+
+        for (const auto& message : checkKeywordRanges( deck.size(), check )) {
+            const auto& keyword = deck.getKeyword(message.first);
+            OpmLog::warning( Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), message.second) );
+            deckValid = false;
         }
     }
 
@@ -0,0 +1,223 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <thread>
+
+#include <sys/stat.h>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Parser/DeckServer.hpp>
+
+namespace Opm {
+
+namespace {
+
+    std::string canonical_path(const std::string& dataFile) {
+        boost::system::error_code ec;
+        const auto path = boost::filesystem::canonical(dataFile, ec);
+        return ec ? dataFile : path.string();
+    }
+
+}
+
+
+    DeckServer::DeckServer(std::size_t memoryBudget, const ParseContext& parseContext) :
+        m_parseContext(parseContext),
+        m_budget(memoryBudget)
+    {
+        this->m_parser.setDeckCache(true);
+        this->m_parser.setIncludeCache(true);
+        this->m_parser.setIncludeThreads(std::thread::hardware_concurrency());
+    }
+
+
+    const Parser& DeckServer::parser() const {
+        return this->m_parser;
+    }
+
+
+    /*
+      The modification time is taken with nanoseconds where available,
+      so that an edit which keeps the size is detected.
+    */
+    bool DeckServer::signature(const std::string& path, Signature& sig) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0)
+            return false;
+
+        sig.path = path;
+        sig.size = static_cast< std::uint64_t >(st.st_size);
+#ifdef __linux__
+        sig.mtime = static_cast< std::int64_t >(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+        sig.mtime = static_cast< std::int64_t >(st.st_mtime);
+#endif
+        return true;
+    }
+
+
+    bool DeckServer::current(const std::vector< Signature >& inputs) {
+        for (const auto& input : inputs) {
+            Signature sig;
+            if (!signature(input.path, sig) || sig.size != input.size || sig.mtime != input.mtime)
+                return false;
+        }
+
+        return true;
+    }
+
+
+    std::shared_ptr< const Deck > DeckServer::lookup(const std::string& dataFile,
+                                                     std::shared_ptr< const EclipseState >* state) {
+        std::lock_guard< std::mutex > lock(this->m_mutex);
+        auto pos = this->m_index.find(dataFile);
+        if (pos == this->m_index.end()) {
+            this->m_statistics.misses += 1;
+            return {};
+        }
+
+        auto entry = pos->second;
+        if (!current(entry->inputs)) {
+            this->m_statistics.misses += 1;
+            this->m_statistics.bytes -= entry->bytes;
+            this->m_statistics.decks -= 1;
+            this->m_index.erase(pos);
+            this->m_entries.erase(entry);
+            return {};
+        }
+
+        this->m_statistics.hits += 1;
+        this->m_entries.splice(this->m_entries.begin(), this->m_entries, entry);
+        if (state)
+            *state = entry->state;
+
+        return entry->deck;
+    }
+
+
+    void DeckServer::insert(Entry&& entry) {
+        std::lock_guard< std::mutex > lock(this->m_mutex);
+
+        /* Another thread may have parsed the same deck meanwhile. */
+        auto pos = this->m_index.find(entry.dataFile);
+        if (pos != this->m_index.end()) {
+            this->m_statistics.bytes -= pos->second->bytes;
+            this->m_statistics.decks -= 1;
+            this->m_entries.erase(pos->second);
+            this->m_index.erase(pos);
+        }
+
+        this->m_statistics.bytes += entry.bytes;
+        this->m_statistics.decks += 1;
+        this->m_entries.push_front(std::move(entry));
+        this->m_index[this->m_entries.front().dataFile] = this->m_entries.begin();
+        this->evict();
+    }
+
+
+    /* Called with the mutex held. */
+    void DeckServer::evict() {
+        while (this->m_statistics.bytes > this->m_budget && !this->m_entries.empty()) {
+            const auto& last = this->m_entries.back();
+            this->m_statistics.bytes -= last.bytes;
+            this->m_statistics.decks -= 1;
+            this->m_statistics.evictions += 1;
+            this->m_index.erase(last.dataFile);
+            this->m_entries.pop_back();
+        }
+    }
+
+
+    std::shared_ptr< const Deck > DeckServer::deck(const std::string& dataFile) {
+        const auto key = canonical_path(dataFile);
+        auto cached = this->lookup(key, nullptr);
+        if (cached)
+            return cached;
+
+        return this->parse(key, dataFile);
+    }
+
+
+    std::shared_ptr< const Deck > DeckServer::parse(const std::string& key, const std::string& dataFile) {
+        auto parsed = std::make_shared< const Deck >(this->m_parser.parseFile(dataFile, this->m_parseContext));
+
+        Entry entry;
+        entry.dataFile = key;
+        entry.deck = parsed;
+        for (const auto& file : parsed->getInputFiles()) {
+            Signature sig;
+            if (!signature(file, sig))
+                return parsed;
+
+            entry.inputs.push_back(std::move(sig));
+        }
+
+        if (entry.inputs.empty())
+            return parsed;
+
+        entry.bytes = parsed->memory_usage().total();
+        this->insert(std::move(entry));
+        return parsed;
+    }
+
+
+    std::shared_ptr< const EclipseState > DeckServer::eclipseState(const std::string& dataFile) {
+        const auto key = canonical_path(dataFile);
+        std::shared_ptr< const EclipseState > state;
+        auto deck = this->lookup(key, &state);
+        if (state)
+            return state;
+
+        if (!deck)
+            deck = this->parse(key, dataFile);
+
+        state = std::make_shared< const EclipseState >(*deck, this->m_parseContext);
+        const auto bytes = state->memory_usage().total();
+
+        std::lock_guard< std::mutex > lock(this->m_mutex);
+        auto pos = this->m_index.find(key);
+        if (pos != this->m_index.end() && pos->second->deck == deck && !pos->second->state) {
+            pos->second->state = state;
+            pos->second->bytes += bytes;
+            this->m_statistics.bytes += bytes;
+            this->evict();
+        }
+
+        return state;
+    }
+
+
+    DeckServer::Statistics DeckServer::statistics() const {
+        std::lock_guard< std::mutex > lock(this->m_mutex);
+        return this->m_statistics;
+    }
+
+
+    void DeckServer::clear() {
+        std::lock_guard< std::mutex > lock(this->m_mutex);
+        this->m_entries.clear();
+        this->m_index.clear();
+        this->m_statistics.decks = 0;
+        this->m_statistics.bytes = 0;
+    }
+
+} // namespace Opm
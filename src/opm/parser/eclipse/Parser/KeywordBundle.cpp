@@ -0,0 +1,391 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <opm/json/JsonObject.hpp>
+#include <opm/parser/eclipse/Parser/KeywordBundle.hpp>
+#include <opm/parser/eclipse/Parser/ParserItem.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+
+namespace Opm {
+
+/*
+ * Bump the version whenever the layout below, or the members of
+ * ParserKeyword, ParserRecord or ParserItem, change.
+ */
+const std::uint32_t KeywordBundle::version = 1;
+
+namespace {
+
+const char magic[ 8 ] = { 'O', 'P', 'M', 'K', 'W', 'B', 'N', 'D' };
+
+/* thrown on truncated or otherwise unexpected bundle contents */
+struct corrupt_bundle {};
+
+class writer {
+    public:
+        template< typename T >
+        void pod( T x ) {
+            this->buffer.append( reinterpret_cast< const char* >( &x ), sizeof( x ) );
+        }
+
+        void str( const std::string& s ) {
+            this->pod< std::uint64_t >( s.size() );
+            this->buffer.append( s );
+        }
+
+        template< typename Container >
+        void strings( const Container& c ) {
+            this->pod< std::uint64_t >( c.size() );
+            for( const auto& s : c ) this->str( s );
+        }
+
+        std::string buffer;
+};
+
+class reader {
+    public:
+        reader( const char* first, const char* last ) : cursor( first ), end( last ) {}
+
+        template< typename T >
+        T pod() {
+            T x;
+            std::memcpy( &x, this->take( sizeof( x ) ), sizeof( x ) );
+            return x;
+        }
+
+        std::string str() {
+            const auto n = this->pod< std::uint64_t >();
+            return std::string( this->take( n ), n );
+        }
+
+        std::uint64_t count() {
+            const auto n = this->pod< std::uint64_t >();
+            if( n > std::uint64_t( this->end - this->cursor ) )
+                throw corrupt_bundle();
+
+            return n;
+        }
+
+        bool done() const {
+            return this->cursor == this->end;
+        }
+
+    private:
+        const char* take( std::uint64_t n ) {
+            if( n > std::uint64_t( this->end - this->cursor ) )
+                throw corrupt_bundle();
+
+            const char* p = this->cursor;
+            this->cursor += n;
+            return p;
+        }
+
+        const char* cursor;
+        const char* end;
+};
+
+/*
+ * The contents of a bundle file; mapped read-only where possible, read into
+ * memory otherwise.
+ */
+class bundle_file {
+    public:
+        explicit bundle_file( const std::string& filename ) {
+#if !defined(_WIN32)
+            const int fd = ::open( filename.c_str(), O_RDONLY );
+            if( fd >= 0 ) {
+                struct stat st;
+                if( ::fstat( fd, &st ) == 0 && st.st_size > 0 ) {
+                    void* ptr = ::mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+                    if( ptr != MAP_FAILED ) {
+                        this->addr = ptr;
+                        this->length = st.st_size;
+                    }
+                }
+                ::close( fd );
+            }
+
+            if( this->addr ) return;
+#endif
+            std::ifstream stream( filename, std::ios::binary );
+            if( !stream )
+                throw std::invalid_argument( "Unable to open keyword bundle: " + filename );
+
+            this->content.assign( std::istreambuf_iterator< char >( stream ),
+                                  std::istreambuf_iterator< char >() );
+        }
+
+        bundle_file( const bundle_file& ) = delete;
+
+        ~bundle_file() {
+#if !defined(_WIN32)
+            if( this->addr ) ::munmap( this->addr, this->length );
+#endif
+        }
+
+        const char* begin() const {
+            return this->addr ? static_cast< const char* >( this->addr )
+                              : this->content.data();
+        }
+
+        const char* end() const {
+            return this->begin() + ( this->addr ? this->length : this->content.size() );
+        }
+
+    private:
+        void* addr = nullptr;
+        std::size_t length = 0;
+        std::string content;
+};
+
+void keyword_files( const boost::filesystem::path& directory,
+                    bool recursive,
+                    std::vector< boost::filesystem::path >& files ) {
+    boost::filesystem::directory_iterator end;
+    for( boost::filesystem::directory_iterator iter( directory ); iter != end; ++iter ) {
+        if( boost::filesystem::is_directory( *iter ) ) {
+            if( recursive )
+                keyword_files( *iter, recursive, files );
+        } else if( ParserKeyword::validInternalName( iter->path().filename().string() ) ) {
+            files.push_back( iter->path() );
+        }
+    }
+}
+
+}
+
+/*
+ * The parser classes are (de)serialized here rather than through member
+ * functions, which keeps the binary layout in one place. ParserKeyword,
+ * ParserRecord and ParserItem befriend KeywordBundleIO for this.
+ */
+struct KeywordBundleIO {
+    static void write( writer& out, const ParserItem& item ) {
+        out.str( item.m_name.str() );
+        out.pod< std::uint8_t >( static_cast< std::uint8_t >( item.m_sizeType ) );
+        out.str( item.m_description );
+        out.pod< std::uint8_t >( static_cast< std::uint8_t >( item.type ) );
+        out.pod< std::uint8_t >( item.raw_string );
+        out.pod< std::uint8_t >( item.m_defaultSet );
+
+        if( item.m_defaultSet ) {
+            switch( item.type ) {
+                case type_tag::integer: out.pod< std::int32_t >( item.ival ); break;
+                case type_tag::fdouble: out.pod< double >( item.dval ); break;
+                case type_tag::string:  out.str( item.sval ); break;
+                default: break;
+            }
+        }
+
+        out.strings( item.dimensions );
+    }
+
+    static ParserItem read_item( reader& in ) {
+        const auto name = in.str();
+        const auto size_type = in.pod< std::uint8_t >();
+        if( size_type > static_cast< std::uint8_t >( ParserItem::item_size::SINGLE ) )
+            throw corrupt_bundle();
+
+        ParserItem item( name, static_cast< ParserItem::item_size >( size_type ) );
+        item.m_description = in.str();
+
+        const auto type = in.pod< std::uint8_t >();
+        if( type > static_cast< std::uint8_t >( type_tag::fdouble ) )
+            throw corrupt_bundle();
+
+        item.type = static_cast< type_tag >( type );
+        item.raw_string = in.pod< std::uint8_t >() != 0;
+        item.m_defaultSet = in.pod< std::uint8_t >() != 0;
+
+        if( item.m_defaultSet ) {
+            switch( item.type ) {
+                case type_tag::integer: item.ival = in.pod< std::int32_t >(); break;
+                case type_tag::fdouble: item.dval = in.pod< double >(); break;
+                case type_tag::string:  item.sval = in.str(); break;
+                default: break;
+            }
+        }
+
+        const auto num_dims = in.count();
+        for( std::uint64_t i = 0; i < num_dims; ++i )
+            item.dimensions.push_back( in.str() );
+
+        return item;
+    }
+
+    static void write( writer& out, const ParserKeyword& keyword ) {
+        out.str( keyword.m_name );
+        out.strings( keyword.m_deckNames );
+        out.strings( keyword.m_validSectionNames );
+        out.str( keyword.m_matchRegexString );
+        out.pod< std::int32_t >( keyword.m_keywordSizeType );
+        out.pod< std::uint64_t >( keyword.m_fixedSize );
+        out.str( keyword.keyword_size.keyword );
+        out.str( keyword.keyword_size.item );
+        out.pod< std::int32_t >( keyword.keyword_size.shift );
+        out.pod< std::uint8_t >( keyword.m_isTableCollection );
+        out.str( keyword.m_Description );
+
+        out.pod< std::uint64_t >( keyword.m_records.size() );
+        for( const auto& record : keyword.m_records ) {
+            out.pod< std::uint8_t >( record.m_dataRecord );
+            out.pod< std::uint64_t >( record.m_items.size() );
+            for( const auto& item : record.m_items )
+                write( out, item );
+        }
+    }
+
+    static std::unique_ptr< ParserKeyword > read_keyword( reader& in ) {
+        std::unique_ptr< ParserKeyword > keyword( new ParserKeyword( in.str() ) );
+
+        keyword->m_deckNames.clear();
+        const auto num_deck_names = in.count();
+        for( std::uint64_t i = 0; i < num_deck_names; ++i )
+            keyword->m_deckNames.insert( in.str() );
+
+        const auto num_sections = in.count();
+        for( std::uint64_t i = 0; i < num_sections; ++i )
+            keyword->m_validSectionNames.insert( in.str() );
+
+        const auto regex = in.str();
+        if( !regex.empty() )
+            keyword->setMatchRegex( regex );
+
+        const auto size_type = in.pod< std::int32_t >();
+        if( size_type < SLASH_TERMINATED || size_type > UNKNOWN )
+            throw corrupt_bundle();
+
+        keyword->m_keywordSizeType = static_cast< ParserKeywordSizeEnum >( size_type );
+        keyword->m_fixedSize = in.pod< std::uint64_t >();
+        keyword->keyword_size.keyword = in.str();
+        keyword->keyword_size.item = in.str();
+        keyword->keyword_size.shift = in.pod< std::int32_t >();
+        keyword->m_isTableCollection = in.pod< std::uint8_t >() != 0;
+        keyword->m_Description = in.str();
+
+        const auto num_records = in.count();
+        for( std::uint64_t i = 0; i < num_records; ++i ) {
+            ParserRecord record;
+            record.m_dataRecord = in.pod< std::uint8_t >() != 0;
+
+            const auto num_items = in.count();
+            for( std::uint64_t j = 0; j < num_items; ++j )
+                record.m_items.push_back( read_item( in ) );
+
+            keyword->m_records.push_back( std::move( record ) );
+        }
+
+        return keyword;
+    }
+};
+
+void KeywordBundle::save( const std::string& bundleFile,
+                          const std::vector< const ParserKeyword* >& keywords ) {
+    writer out;
+    for( char c : magic ) out.pod( c );
+    out.pod( version );
+
+    out.pod< std::uint64_t >( keywords.size() );
+    for( const auto* keyword : keywords )
+        KeywordBundleIO::write( out, *keyword );
+
+    std::ofstream stream( bundleFile, std::ios::binary );
+    stream.write( out.buffer.data(), out.buffer.size() );
+    stream.close();
+
+    if( !stream )
+        throw std::runtime_error( "Unable to write keyword bundle: " + bundleFile );
+}
+
+void KeywordBundle::compile( const std::string& directory,
+                             const std::string& bundleFile,
+                             bool recursive ) {
+    if( !boost::filesystem::is_directory( directory ) )
+        throw std::invalid_argument( "Directory: " + directory + " does not exist." );
+
+    /* sorted, so the same directory always gives the same bundle */
+    std::vector< boost::filesystem::path > files;
+    keyword_files( directory, recursive, files );
+    std::sort( files.begin(), files.end() );
+
+    std::vector< std::unique_ptr< ParserKeyword > > keywords;
+    for( const auto& file : files ) {
+        try {
+            keywords.emplace_back( new ParserKeyword( Json::JsonObject( file ) ) );
+        } catch( const std::exception& e ) {
+            throw std::invalid_argument( "Failed to load keyword from file: "
+                                         + file.string() + ": " + e.what() );
+        }
+    }
+
+    std::vector< const ParserKeyword* > pointers;
+    for( const auto& keyword : keywords )
+        pointers.push_back( keyword.get() );
+
+    save( bundleFile, pointers );
+}
+
+std::vector< std::unique_ptr< ParserKeyword > >
+KeywordBundle::load( const std::string& bundleFile ) {
+    const bundle_file file( bundleFile );
+    std::vector< std::unique_ptr< ParserKeyword > > keywords;
+
+    try {
+        reader in( file.begin(), file.end() );
+
+        char file_magic[ sizeof( magic ) ];
+        for( auto& c : file_magic ) c = in.pod< char >();
+        if( std::memcmp( file_magic, magic, sizeof( magic ) ) != 0 )
+            throw std::invalid_argument( "Not a keyword bundle: " + bundleFile );
+
+        const auto file_version = in.pod< std::uint32_t >();
+        if( file_version != version )
+            throw std::invalid_argument( "Keyword bundle " + bundleFile
+                                         + " has version " + std::to_string( file_version )
+                                         + ", expected " + std::to_string( version ) );
+
+        const auto num_keywords = in.count();
+        keywords.reserve( num_keywords );
+        for( std::uint64_t i = 0; i < num_keywords; ++i )
+            keywords.push_back( KeywordBundleIO::read_keyword( in ) );
+
+        if( !in.done() ) throw corrupt_bundle();
+    } catch( const corrupt_bundle& ) {
+        throw std::invalid_argument( "Corrupt keyword bundle: " + bundleFile );
+    }
+
+    return keywords;
+}
+
+}
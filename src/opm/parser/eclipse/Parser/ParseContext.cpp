@@ -28,6 +28,62 @@
 
 namespace Opm {
 
+namespace {
+
+    struct DefaultKey {
+        const std::string* key;
+        InputError::Action action;
+    };
+
+    const DefaultKey default_keys[] = {
+        { &ParseContext::PARSE_EXTRA_RECORDS, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_UNKNOWN_KEYWORD, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_RANDOM_TEXT, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_RANDOM_SLASH, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_MISSING_DIMS_KEYWORD, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_EXTRA_DATA, InputError::THROW_EXCEPTION },
+        { &ParseContext::PARSE_MISSING_INCLUDE, InputError::EXIT1 },
+
+        { &ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER, InputError::THROW_EXCEPTION },
+        { &ParseContext::UNSUPPORTED_COMPORD_TYPE, InputError::THROW_EXCEPTION },
+        { &ParseContext::UNSUPPORTED_INITIAL_THPRES, InputError::THROW_EXCEPTION },
+        { &ParseContext::UNSUPPORTED_TERMINATE_IF_BHP, InputError::THROW_EXCEPTION },
+
+        { &ParseContext::INTERNAL_ERROR_UNINITIALIZED_THPRES, InputError::THROW_EXCEPTION },
+
+        { &ParseContext::SUMMARY_UNKNOWN_WELL, InputError::THROW_EXCEPTION },
+        { &ParseContext::SUMMARY_UNKNOWN_GROUP, InputError::THROW_EXCEPTION },
+        { &ParseContext::SUMMARY_UNHANDLED_KEYWORD, InputError::WARN },
+        { &ParseContext::SCHEDULE_INVALID_NAME, InputError::THROW_EXCEPTION },
+
+        { &ParseContext::ACTIONX_ILLEGAL_KEYWORD, InputError::THROW_EXCEPTION },
+
+        { &ParseContext::RPT_MIXED_STYLE, InputError::WARN },
+        { &ParseContext::RPT_UNKNOWN_MNEMONIC, InputError::WARN }
+    };
+
+    const std::size_t num_default_keys = sizeof default_keys / sizeof default_keys[0];
+
+    /*
+      The position of @key in default_keys, or num_default_keys if it is
+      not one of them. The keys are first compared by address, which
+      catches the common case of a static key of ParseContext, and then
+      by value.
+    */
+    std::size_t defaultKeyIndex(const std::string& key) {
+        for (std::size_t index = 0; index < num_default_keys; index++)
+            if (default_keys[index].key == &key)
+                return index;
+
+        for (std::size_t index = 0; index < num_default_keys; index++)
+            if (*default_keys[index].key == key)
+                return index;
+
+        return num_default_keys;
+    }
+
+}
+
 
     /*
       A set of predefined error modes are added, with the default
@@ -69,30 +125,11 @@ namespace Opm {
     }
 
     void ParseContext::initDefault() {
-        addKey(PARSE_EXTRA_RECORDS, InputError::THROW_EXCEPTION);
-        addKey(PARSE_UNKNOWN_KEYWORD, InputError::THROW_EXCEPTION);
-        addKey(PARSE_RANDOM_TEXT, InputError::THROW_EXCEPTION);
-        addKey(PARSE_RANDOM_SLASH, InputError::THROW_EXCEPTION);
-        addKey(PARSE_MISSING_DIMS_KEYWORD, InputError::THROW_EXCEPTION);
-        addKey(PARSE_EXTRA_DATA, InputError::THROW_EXCEPTION);
-        addKey(PARSE_MISSING_INCLUDE, InputError::EXIT1);
-
-        addKey(UNSUPPORTED_SCHEDULE_GEO_MODIFIER, InputError::THROW_EXCEPTION);
-        addKey(UNSUPPORTED_COMPORD_TYPE, InputError::THROW_EXCEPTION);
-        addKey(UNSUPPORTED_INITIAL_THPRES, InputError::THROW_EXCEPTION);
-        addKey(UNSUPPORTED_TERMINATE_IF_BHP, InputError::THROW_EXCEPTION);
-
-        addKey(INTERNAL_ERROR_UNINITIALIZED_THPRES, InputError::THROW_EXCEPTION);
-
-        addKey(SUMMARY_UNKNOWN_WELL, InputError::THROW_EXCEPTION);
-        addKey(SUMMARY_UNKNOWN_GROUP, InputError::THROW_EXCEPTION);
-        addKey(SUMMARY_UNHANDLED_KEYWORD, InputError::WARN);
-        addKey(SCHEDULE_INVALID_NAME, InputError::THROW_EXCEPTION);
-
-        addKey(ACTIONX_ILLEGAL_KEYWORD, InputError::THROW_EXCEPTION);
-
-        addKey(RPT_MIXED_STYLE, InputError::WARN);
-        addKey(RPT_UNKNOWN_MNEMONIC, InputError::WARN);
+        this->m_defaultActions.clear();
+        for (const auto& default_key : default_keys) {
+            addKey(*default_key.key, default_key.action);
+            this->m_defaultActions.push_back(default_key.action);
+        }
     }
 
     void ParseContext::initEnv() {
@@ -113,7 +150,10 @@ namespace Opm {
             const std::string& errorKey,
             const std::string& msg ) const {
 
-        InputError::Action action = get( errorKey );
+        InputError::Action action = this->action( errorKey );
+
+        if (action == InputError::IGNORE)
+            return;
 
         if (action == InputError::WARN) {
             OpmLog::warning(msg);
@@ -133,6 +173,10 @@ namespace Opm {
         }
     }
 
+    bool ParseContext::isIgnored(const std::string& errorKey) const {
+        return this->action( errorKey ) == InputError::IGNORE;
+    }
+
     void ParseContext::handleUnknownKeyword(const std::string& keyword) const {
         if (this->ignore_keywords.find(keyword) == this->ignore_keywords.end()) {
             std::string msg = "Unknown keyword: " + keyword;
@@ -184,6 +228,15 @@ namespace Opm {
             throw std::invalid_argument("The errormode key: " + key + " has not been registered");
     }
 
+
+    InputError::Action ParseContext::action(const std::string& key) const {
+        const std::size_t index = defaultKeyIndex( key );
+        if (index < this->m_defaultActions.size())
+            return this->m_defaultActions[index];
+
+        return get( key );
+    }
+
     /*****************************************************************/
 
     /*
@@ -199,9 +252,13 @@ namespace Opm {
     */
 
     void ParseContext::updateKey(const std::string& key , InputError::Action action) {
-        if (hasKey(key))
+        if (hasKey(key)) {
             m_errorContexts[key] = action;
-        else
+
+            const std::size_t index = defaultKeyIndex( key );
+            if (index < this->m_defaultActions.size())
+                this->m_defaultActions[index] = action;
+        } else
             throw std::invalid_argument("The errormode key: " + key + " has not been registered");
     }
 
@@ -0,0 +1,241 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
+
+namespace Opm {
+
+namespace {
+
+    struct Registry {
+        std::atomic<bool> enabled{false};
+        std::mutex mutex;
+        std::map<std::string, ParseProfile::Entry> keywords;
+        std::map<std::string, ParseProfile::Entry> files;
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+
+    ParseProfile::Entry& entry(std::map<std::string, ParseProfile::Entry>& entries, const std::string& name) {
+        auto& e = entries[name];
+        if (e.name.empty())
+            e.name = name;
+        return e;
+    }
+
+
+    std::vector<ParseProfile::Entry> sorted(const std::map<std::string, ParseProfile::Entry>& entries) {
+        std::vector<ParseProfile::Entry> result;
+        for (const auto& pair : entries)
+            result.push_back(pair.second);
+
+        std::stable_sort(result.begin(), result.end(),
+                         [](const ParseProfile::Entry& lhs, const ParseProfile::Entry& rhs) {
+                             return lhs.total() > rhs.total();
+                         });
+        return result;
+    }
+
+
+    std::string json_string(const std::string& s) {
+        std::string quoted = "\"";
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+
+    void write_table(std::ostream& os, const std::string& heading,
+                     const std::vector<ParseProfile::Entry>& entries, std::size_t max_rows) {
+        const auto rows = (max_rows == 0) ? entries.size() : std::min(max_rows, entries.size());
+
+        os << std::left << std::setw(24) << heading
+           << std::right << std::setw(9) << "count"
+           << std::setw(13) << "bytes"
+           << std::setw(10) << "records"
+           << std::setw(12) << "items"
+           << std::setw(13) << "tokenize [s]"
+           << std::setw(12) << "parse [s]"
+           << std::setw(14) << "consume [s]" << std::endl;
+
+        for (std::size_t index = 0; index < rows; index++) {
+            const auto& e = entries[index];
+            os << std::left << std::setw(24) << e.name
+               << std::right << std::setw(9) << e.count
+               << std::setw(13) << e.bytes
+               << std::setw(10) << e.records
+               << std::setw(12) << e.items
+               << std::fixed << std::setprecision(6)
+               << std::setw(13) << e.tokenize
+               << std::setw(12) << e.parse
+               << std::setw(14) << e.consume << std::endl;
+        }
+
+        if (rows < entries.size())
+            os << "... " << entries.size() - rows << " more" << std::endl;
+    }
+
+
+    void write_json(std::ostream& os, const std::vector<ParseProfile::Entry>& entries) {
+        os << "[";
+        for (std::size_t index = 0; index < entries.size(); index++) {
+            const auto& e = entries[index];
+            os << (index == 0 ? "" : ", ")
+               << "{\"name\": " << json_string(e.name)
+               << ", \"count\": " << e.count
+               << ", \"bytes\": " << e.bytes
+               << ", \"records\": " << e.records
+               << ", \"items\": " << e.items
+               << ", \"tokenize\": " << e.tokenize
+               << ", \"parse\": " << e.parse
+               << ", \"consume\": " << e.consume << "}";
+        }
+        os << "]";
+    }
+
+}
+
+
+    double ParseProfile::Entry::total() const {
+        return this->tokenize + this->parse + this->consume;
+    }
+
+
+    ParseProfile::Consume::Consume(const std::string& keyword_arg) :
+        keyword(registry().enabled.load(std::memory_order_relaxed) ? &keyword_arg : nullptr)
+    {
+        if (this->keyword)
+            this->start = std::chrono::steady_clock::now();
+    }
+
+
+    ParseProfile::Consume::~Consume() {
+        if (!this->keyword)
+            return;
+
+        const auto end = std::chrono::steady_clock::now();
+        addConsume(*this->keyword, std::chrono::duration<double>(end - this->start).count());
+    }
+
+
+    void ParseProfile::enable(bool on) {
+        registry().enabled = on;
+    }
+
+
+    bool ParseProfile::enabled() {
+        return registry().enabled.load(std::memory_order_relaxed);
+    }
+
+
+    void ParseProfile::reset() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.keywords.clear();
+        reg.files.clear();
+    }
+
+
+    void ParseProfile::addKeyword(const std::string& keyword,
+                                  const std::string& file,
+                                  std::size_t bytes,
+                                  std::size_t records,
+                                  std::size_t items,
+                                  double tokenize,
+                                  double parse) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto& kw = entry(reg.keywords, keyword);
+        auto& input = entry(reg.files, file);
+
+        /* The bytes of a file are the size of the file, see addFile(). */
+        kw.bytes += bytes;
+        for (auto* e : { &kw, &input }) {
+            e->count += 1;
+            e->records += records;
+            e->items += items;
+            e->tokenize += tokenize;
+            e->parse += parse;
+        }
+    }
+
+
+    void ParseProfile::addFile(const std::string& file, std::size_t bytes) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        entry(reg.files, file).bytes += bytes;
+    }
+
+
+    void ParseProfile::addConsume(const std::string& keyword, double seconds) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        entry(reg.keywords, keyword).consume += seconds;
+    }
+
+
+    ParseProfile::Report ParseProfile::report() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        return { sorted(reg.keywords), sorted(reg.files) };
+    }
+
+
+    void ParseProfile::writeTable(std::ostream& os, std::size_t max_rows) {
+        const auto r = report();
+        write_table(os, "keyword", r.keywords, max_rows);
+        os << std::endl;
+        write_table(os, "file", r.files, max_rows);
+    }
+
+
+    void ParseProfile::writeJSON(std::ostream& os) {
+        const auto r = report();
+        os.unsetf(std::ios_base::floatfield);
+        os << std::setprecision(9) << "{\"keywords\": ";
+        write_json(os, r.keywords);
+        os << ", \"files\": ";
+        write_json(os, r.files);
+        os << "}" << std::endl;
+    }
+
+
+    void ParseProfile::log(std::size_t max_rows) {
+        std::ostringstream table;
+        table << "Input processing per keyword and file" << std::endl;
+        writeTable(table, max_rows);
+        OpmLog::note(table.str());
+    }
+
+} // namespace Opm
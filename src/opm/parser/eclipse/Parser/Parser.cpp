@@ -17,37 +17,75 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
+#include <opm/common/OpmLog/MemoryUsage.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 
 #include <opm/json/JsonObject.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckCache.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Parser/DeckVisitor.hpp>
+#include <opm/parser/eclipse/Parser/KeywordBundle.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/Parser/SectionIndex.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Utility/String.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
+#include "../Deck/KeywordRanges.hpp"
+
 namespace Opm {
 
 namespace {
@@ -88,21 +126,6 @@ inline Itr find_terminator( Itr begin, Itr end, Term terminator ) {
     return find_terminator( qend + 1, end, terminator );
 }
 
-/**
-    This function will return a copy of the input string where all
-    characters following '--' are removed. The copy is a view and relies on
-    the source string to remain alive. The function handles quoting with
-    single quotes and double quotes:
-
-    ABC --Comment                =>  ABC
-    ABC '--Comment1' --Comment2  =>  ABC '--Comment1'
-    ABC "-- Not balanced quote?  =>  ABC "-- Not balanced quote?
-*/
-static inline string_view strip_comments( string_view str ) {
-    return { str.begin(),
-             find_terminator( str.begin(), str.end(), find_comment() ) };
-}
-
 template< typename Itr >
 inline Itr trim_left( Itr begin, Itr end ) {
     return std::find_if_not( begin, end, RawConsts::is_separator() );
@@ -117,71 +140,373 @@ inline Itr trim_right( Itr begin, Itr end ) {
     return std::find_if_not( rbegin, rend, RawConsts::is_separator() ).base();
 }
 
-inline string_view trim( string_view str ) {
-    auto fst = trim_left( str.begin(), str.end() );
-    auto lst = trim_right( fst, str.end() );
-    return { fst, lst };
+inline const char* find_newline( const char* begin, const char* end ) {
+    const auto* nl = static_cast< const char* >(
+            std::memchr( begin, '\n', end - begin ) );
+    return nl ? nl : end;
 }
 
-inline string_view strip_slash( string_view view ) {
-    using itr = string_view::const_iterator;
-    const auto term = []( itr begin, itr end ) {
-        return std::find( begin, end, '/' );
-    };
-
-    auto begin = view.begin();
-    auto end = view.end();
-    auto slash = find_terminator( begin, end, term );
+inline bool is_structural( char c ) {
+    return c == '\n' || c == '-' || c == '/' || c == '\'' || c == '"';
+}
 
-    /* we want to preserve terminating slashes */
-    if( slash != end ) ++slash;
+/*
+ * Find the next character which can change the meaning of the input: a
+ * newline, a '-' which may start a comment, a terminating slash or a quote.
+ * Numbers and keywords, which make up the bulk of the input, are skipped 16
+ * bytes at a time where SSE2 is available: the block is compared to each of
+ * the structural characters, and the combined comparison is reduced to a
+ * bitmask whose lowest set bit is the position of the first hit.
+ */
+inline const char* find_structural( const char* begin, const char* end ) {
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8( '\n' );
+    const __m128i dash    = _mm_set1_epi8( '-' );
+    const __m128i slash   = _mm_set1_epi8( '/' );
+    const __m128i squote  = _mm_set1_epi8( '\'' );
+    const __m128i dquote  = _mm_set1_epi8( '"' );
+
+    for( ; end - begin >= 16; begin += 16 ) {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i* >( begin ) );
+        const __m128i hits = _mm_or_si128(
+                _mm_or_si128( _mm_cmpeq_epi8( block, newline ),
+                              _mm_cmpeq_epi8( block, dash ) ),
+                _mm_or_si128( _mm_cmpeq_epi8( block, slash ),
+                              _mm_or_si128( _mm_cmpeq_epi8( block, squote ),
+                                            _mm_cmpeq_epi8( block, dquote ) ) ) );
+
+        const int mask = _mm_movemask_epi8( hits );
+        if( mask != 0 ) return begin + __builtin_ctz( mask );
+    }
+#endif
 
-    return { begin, slash };
+    return std::find_if( begin, end, is_structural );
 }
 
 inline bool getline( string_view& input, string_view& line ) {
     if( input.empty() ) return false;
 
-    auto end = std::find( input.begin(), input.end(), '\n' );
+    auto end = find_newline( input.begin(), input.end() );
 
     line = string_view( input.begin(), end );
-    input = string_view( end + 1, input.end() );
-    return true;
 
-    /* we know that we always append a newline onto the input string, so we can
-     * safely assume that end+1 will either be end-of-input (i.e. empty range)
-     * or the start of the next line
+    /*
+     * Memory mapped files are not guaranteed to end with a newline, so the
+     * last line can run all the way to the end of input.
      */
+    if( end == input.end() )
+        input = string_view( end, end );
+    else
+        input = string_view( end + 1, input.end() );
+
+    return true;
 }
 
 /*
- * Read the input file and remove everything that isn't interesting data,
- * including stripping comments, removing leading/trailing whitespaces and
- * everything after (terminating) slashes. Manually copying into the string for
+ * Read the input and remove everything that isn't interesting data, including
+ * stripping comments, removing leading/trailing whitespaces and everything
+ * after (terminating) slashes. Manually copying into the destination for
  * performance.
+ *
+ * The input is scanned once, jumping from one structural character to the
+ * next. A line is cut at the first '--' or after the first '/' which is not
+ * inside quotes; a quote which is not closed on the same line keeps the rest
+ * of the line as is:
+ *
+ *    ABC --Comment                =>  ABC
+ *    ABC '--Comment1' --Comment2  =>  ABC '--Comment1'
+ *    ABC "-- Not balanced quote?  =>  ABC "-- Not balanced quote?
+ *    1 2 3 / 4 5                  =>  1 2 3 /
+ *
+ * A cleaned line is never longer than its source line, and a newline is only
+ * written where the source had one, so dst is allowed to alias src and the
+ * cleaning can be done in-place. Returns the number of bytes written to dst.
  */
+inline size_t clean( string_view src, char* dst ) {
+    const char* cursor = src.begin();
+    const char* end = src.end();
+    auto dsti = dst;
+
+    while( cursor != end ) {
+        const char* line_begin = cursor;
+        const char* cut = nullptr;
+        const char* line_end = nullptr;
+
+        while( !cut && !line_end ) {
+            cursor = find_structural( cursor, end );
+
+            if( cursor == end || *cursor == '\n' ) {
+                line_end = cursor;
+            } else if( *cursor == '-' ) {
+                if( cursor + 1 != end && cursor[ 1 ] == '-' ) cut = cursor;
+                else ++cursor;
+            } else if( *cursor == '/' ) {
+                /* we want to preserve terminating slashes */
+                cut = cursor + 1;
+            } else {
+                const char quote = *cursor;
+                const auto close = std::find_if( cursor + 1, end, [quote]( char c ) {
+                    return c == quote || c == '\n';
+                } );
+
+                if( close == end || *close == '\n' ) line_end = close;
+                else cursor = close + 1;
+            }
+        }
+
+        if( !line_end ) line_end = find_newline( cut, end );
+
+        const char* first = trim_left( line_begin, cut ? cut : line_end );
+        const char* last = trim_right( first, cut ? cut : line_end );
+        const size_t size = last - first;
+
+        if( dsti != first )
+            std::memmove( dsti, first, size );
+        dsti += size;
+
+        if( line_end == end ) break;
+
+        *dsti++ = '\n';
+        cursor = line_end + 1;
+    }
+
+    return dsti - dst;
+}
+
 inline std::string clean( const std::string& str ) {
     std::string dst;
     dst.resize( str.size() );
+    dst.resize( clean( str, &dst[ 0 ] ) );
+    return dst;
+}
 
-    string_view input( str ), line;
-    auto dsti = dst.begin();
-    while( getline( input, line ) ) {
-        line = trim( strip_slash( strip_comments( line ) ) );
+#if !defined(_WIN32)
 
-        std::copy( line.begin(), line.end(), dsti );
-        dsti += std::distance( line.begin(), line.end() );
-        *dsti++ = '\n';
+/*
+ * A private, writable mapping of an input file. The file is cleaned in-place
+ * in the mapping, which means that the pages are copied-on-write by the
+ * kernel, but the explicit read into a heap buffer (and the cleaned copy on
+ * top of it) is avoided. For very large include files (COORD, ZCORN, PERMX
+ * etc.) this halves the peak memory consumption of loading the file, and the
+ * string_view tokens point straight into the mapped pages.
+ */
+class mapped_file {
+    public:
+        mapped_file() = default;
+        mapped_file( const mapped_file& ) = delete;
+        mapped_file( mapped_file&& other ) noexcept :
+            addr( other.addr ), length( other.length ), used( other.used )
+        {
+            other.addr = nullptr;
+            other.length = 0;
+            other.used = 0;
+        }
+        ~mapped_file() {
+            if( this->addr ) munmap( this->addr, this->length );
+        }
+
+        /*
+         * Map and clean the file; returns false if the file could not be
+         * mapped, in which case the caller should fall back to reading it.
+         */
+        bool load( const std::string& filename );
+
+        bool valid() const {
+            return this->addr != nullptr;
+        }
+
+        string_view view() const {
+            return { static_cast< const char* >( this->addr ), this->used };
+        }
+
+    private:
+        void* addr = nullptr;
+        size_t length = 0;
+        size_t used = 0;
+};
+
+bool mapped_file::load( const std::string& filename ) {
+    const int fd = ::open( filename.c_str(), O_RDONLY );
+    if( fd < 0 ) return false;
+
+    struct stat st;
+    if( ::fstat( fd, &st ) != 0 || st.st_size <= 0 ) {
+        ::close( fd );
+        return false;
     }
 
-    dst.resize( std::distance( dst.begin(), dsti ) );
-    return dst;
+    const auto size = static_cast< size_t >( st.st_size );
+    void* ptr = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+
+    if( ptr == MAP_FAILED ) return false;
+
+#if defined(MADV_SEQUENTIAL)
+    ::madvise( ptr, size, MADV_SEQUENTIAL );
+#endif
+
+    this->addr = ptr;
+    this->length = size;
+
+    auto* data = static_cast< char* >( ptr );
+    this->used = clean( string_view( data, size ), data );
+
+    /*
+     * Everything after the cleaned data is dead weight, so release those
+     * pages right away. Comment-heavy files can shrink considerably.
+     */
+    const auto pagesize = static_cast< size_t >( ::sysconf( _SC_PAGESIZE ) );
+    const auto keep = ((this->used + pagesize - 1) / pagesize) * pagesize;
+    if( keep > 0 && keep < this->length ) {
+        ::munmap( data + keep, this->length - keep );
+        this->length = keep;
+    }
+
+    return true;
+}
+
+#endif
+
+/*
+ * True if the file starts with the gzip magic number. Compressed files are
+ * recognised by their contents rather than by their extension, so an
+ * INCLUDE of e.g. 'GRID.GRDECL.gz' and 'GRID.GRDECL' are handled alike.
+ */
+bool is_gzip( const std::string& filename ) {
+    std::ifstream stream( filename, std::ios::binary );
+    unsigned char magic[ 2 ] = { 0, 0 };
+    stream.read( reinterpret_cast< char* >( magic ), sizeof( magic ) );
+    return stream && magic[ 0 ] == 0x1f && magic[ 1 ] == 0x8b;
+}
+
+/*
+ * The cleaned contents of one input source, either an in-memory string, a
+ * memory mapped file or a decompressed gzip file.
+ */
+class input_buffer {
+    public:
+        input_buffer() = default;
+        explicit input_buffer( std::string&& str ) :
+            buffer( std::move( str ) )
+        {}
+
+        /*
+         * Load and clean the file filename. Returns false if the file could
+         * not be opened, and throws if reading it fails. The cleaned size
+         * is counted as "input bytes".
+         */
+        bool load( const std::string& filename );
+
+        string_view view() const {
+#if !defined(_WIN32)
+            if( this->mapped.valid() ) return this->mapped.view();
+#endif
+            return this->buffer;
+        }
+
+    private:
+        bool load_file( const std::string& filename );
+        bool load_gzip( const std::string& filename );
+
+        std::string buffer;
+#if !defined(_WIN32)
+        mapped_file mapped;
+#endif
+};
+
+bool input_buffer::load( const std::string& filename ) {
+    if( !this->load_file( filename ) ) return false;
+
+    PhaseTimer::count( "input bytes", this->view().size() );
+    return true;
+}
+
+bool input_buffer::load_file( const std::string& filename ) {
+    if( is_gzip( filename ) ) return this->load_gzip( filename );
+
+#if !defined(_WIN32)
+    if( this->mapped.load( filename ) ) return true;
+#endif
+
+    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
+    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
+            std::fopen( filename.c_str(), "rb" ),
+            closer
+            );
+
+    if( !ufp ) return false;
+
+    /*
+     * read the input file C-style. This is done for performance
+     * reasons, as streams are slow. This is the fallback for when the file
+     * cannot be memory mapped.
+     */
+
+    auto* fp = ufp.get();
+    std::fseek( fp, 0, SEEK_END );
+    this->buffer.resize( std::ftell( fp ) + 1 );
+    std::rewind( fp );
+    const auto readc = std::fread( &this->buffer[ 0 ], 1, this->buffer.size() - 1, fp );
+    this->buffer.back() = '\n';
+
+    if( std::ferror( fp ) || readc != this->buffer.size() - 1 )
+        throw std::runtime_error( "Error when reading input file '"
+                                + filename + "'" );
+
+    this->buffer.resize( clean( this->buffer, &this->buffer[ 0 ] ) );
+    return true;
+}
+
+/*
+ * The file is decompressed in chunks straight into the buffer, so there is
+ * never an uncompressed copy on disk. When the include files are prefetched
+ * (Parser::setIncludeThreads) this runs on the worker threads, overlapped
+ * with the parsing of the keywords before the INCLUDE.
+ */
+bool input_buffer::load_gzip( const std::string& filename ) {
+#if HAVE_ZLIB
+    const auto closer = []( gzFile f ) { gzclose( f ); };
+    std::unique_ptr< gzFile_s, decltype( closer ) > ugz(
+            gzopen( filename.c_str(), "rb" ),
+            closer
+            );
+
+    if( !ugz ) return false;
+
+    auto* gz = ugz.get();
+    const unsigned chunk = 1U << 20;
+    gzbuffer( gz, 1U << 17 );
+
+    size_t used = 0;
+    while( true ) {
+        this->buffer.resize( used + chunk );
+        const auto readc = gzread( gz, &this->buffer[ used ], chunk );
+        if( readc < 0 ) {
+            int errnum;
+            throw std::runtime_error( "Error when decompressing input file '"
+                                    + filename + "': "
+                                    + gzerror( gz, &errnum ) );
+        }
+
+        if( readc == 0 ) break;
+        used += readc;
+    }
+
+    this->buffer.resize( used + 1 );
+    this->buffer.back() = '\n';
+    this->buffer.resize( clean( this->buffer, &this->buffer[ 0 ] ) );
+    this->buffer.shrink_to_fit();
+    return true;
+#else
+    throw std::runtime_error( "Input file '" + filename + "' is gzip compressed, "
+                              "but opm-common has been built without zlib" );
+#endif
 }
 
 const std::string emptystr = "";
 
 struct file {
-    file( boost::filesystem::path p, const std::string& in ) :
+    file( boost::filesystem::path p, string_view in ) :
         input( in ), path( p )
     {}
 
@@ -193,17 +518,96 @@ struct file {
 class InputStack : public std::stack< file, std::vector< file > > {
     public:
         void push( std::string&& input, boost::filesystem::path p = "" );
+        void push( input_buffer&& input, boost::filesystem::path p );
+
+        /*
+         * Keep the buffer alive for as long as the stack, without pushing it.
+         * Used for pre-tokenized input, where the raw keywords are views into
+         * the buffer.
+         */
+        void retain( input_buffer&& input );
 
     private:
-        std::list< std::string > string_storage;
+        std::list< input_buffer > storage;
         using base = std::stack< file, std::vector< file > >;
 };
 
 void InputStack::push( std::string&& input, boost::filesystem::path p ) {
-    this->string_storage.push_back( std::move( input ) );
-    this->emplace( p, this->string_storage.back() );
+    this->push( input_buffer( std::move( input ) ), p );
 }
 
+void InputStack::push( input_buffer&& input, boost::filesystem::path p ) {
+    this->retain( std::move( input ) );
+    this->emplace( p, this->storage.back().view() );
+}
+
+void InputStack::retain( input_buffer&& input ) {
+    this->storage.push_back( std::move( input ) );
+}
+
+/*
+ * An INCLUDE target from the root file which is loaded and tokenized on a
+ * worker thread ahead of the main parse. Only files which can be tokenized
+ * without any context from the deck (i.e. no nested INCLUDE or PATHS, no
+ * keywords which get their size from another keyword and no unknown keywords
+ * or random text) get their raw keywords prepared; anything else is left for
+ * the main parse, which will report errors as usual.
+ */
+struct include_job {
+    boost::filesystem::path path;
+    size_t index = 0;
+    size_t bytes = 0;
+    bool released = false;
+    input_buffer buffer;
+    std::vector< std::shared_ptr< RawKeyword > > keywords;
+    bool loaded = false;
+    bool tokenized = false;
+
+    std::promise< void > promise;
+    std::shared_future< void > done = promise.get_future().share();
+};
+
+class include_prefetcher {
+    public:
+        include_prefetcher() = default;
+        include_prefetcher( const include_prefetcher& ) = delete;
+        ~include_prefetcher();
+
+        void start( std::deque< include_job >&& jobs,
+                    size_t num_threads,
+                    size_t read_ahead,
+                    const Parser& parser,
+                    const ParseContext& context );
+
+        /*
+         * Take the next prepared job for the canonical path p, waiting for
+         * it to complete. Returns nullptr if the file was not prefetched.
+         */
+        include_job* take( const boost::filesystem::path& p );
+
+    private:
+        void work( const Parser& parser, const ParseContext& context );
+        void reserve( include_job& job );
+
+        std::deque< include_job > jobs;
+        std::map< std::string, std::deque< include_job* > > pending;
+        std::atomic< size_t > next{ 0 };
+        std::atomic< bool > cancelled{ false };
+        std::vector< std::thread > workers;
+
+        /*
+         * The bytes of the files which are loaded, or being loaded, and not
+         * yet taken by the main parse, bounded by read_ahead unless it is
+         * zero. The job the main parse waits for is never held back.
+         */
+        size_t read_ahead = 0;
+        size_t in_flight = 0;
+        size_t wanted = 0;
+        size_t released = 0;
+        std::mutex budget_mutex;
+        std::condition_variable budget_cv;
+};
+
 class ParserState {
     public:
         ParserState( const ParseContext& );
@@ -211,8 +615,13 @@ class ParserState {
 
         void loadString( const std::string& );
         void loadFile( const boost::filesystem::path& );
+        void loadView( string_view, const boost::filesystem::path& );
         void openRootFile( const boost::filesystem::path& );
 
+        void prefetchIncludes( const Parser&, size_t num_threads, size_t read_ahead );
+        bool loadPrefetched( const boost::filesystem::path&, const Parser& );
+        bool loadCachedInclude( const boost::filesystem::path&, const Parser& );
+
         void handleRandomText(const string_view& ) const;
         boost::filesystem::path getIncludeFilePath( std::string ) const;
         void addPathAlias( const std::string& alias, const std::string& path );
@@ -223,12 +632,14 @@ class ParserState {
         bool done() const;
         string_view getline();
         void closeFile();
+        void skipSection();
 
     private:
         InputStack input_stack;
 
         std::map< std::string, std::string > pathMap;
         boost::filesystem::path rootPath;
+        include_prefetcher prefetcher;
 
     public:
         std::shared_ptr< RawKeyword > rawKeyword;
@@ -239,8 +650,51 @@ class ParserState {
         Deck deck;
         const ParseContext& parseContext;
         bool unknown_keyword = false;
+
+        /*
+         * Set when tokenizing ahead on a worker thread. Anything which would
+         * need the deck or report an error aborts the tokenizing instead.
+         */
+        bool pretokenize = false;
+
+        /*
+         * The canonical paths of all files which went into the deck, for the
+         * deck cache. A missing include which was ignored by the ParseContext
+         * clears input_complete; such a deck is not cached.
+         */
+        std::vector< std::string > input_files;
+        bool input_complete = true;
+
+        /*
+         * The directory of the include cache, empty if it is not used, and
+         * the key of the cached keywords, see DeckCache::loadKeywords().
+         */
+        std::string include_cache;
+        std::uint64_t cache_key = 0;
+
+        /*
+         * Set by Parser::visitFile(). Only the keywords other keywords are
+         * sized by are added to the deck then, for the sizes and the unit
+         * system.
+         */
+        DeckVisitor* visitor = nullptr;
+        std::set< std::string > size_keywords;
+        std::string section;
+        int unit_rank = 0;
+
+        /*
+         * Set by Parser::parseSections(). The input of the sections which are
+         * not selected is skipped up to the next line with one of the
+         * skip_stops keywords.
+         */
+        const std::set< std::string >* sections = nullptr;
+        const SectionIndex* section_index = nullptr;
+        std::set< std::string > skip_stops;
+        bool skipping = false;
 };
 
+struct pretokenize_abort {};
+
 
 const boost::filesystem::path& ParserState::current_path() const {
     return this->input_stack.top().path;
@@ -272,6 +726,29 @@ void ParserState::closeFile() {
     this->input_stack.pop();
 }
 
+/*
+ * The input is cleaned, so a keyword is alone on its line; everything else
+ * is passed over at the speed of finding the newlines.
+ */
+void ParserState::skipSection() {
+    std::string name;
+    while( !this->done() ) {
+        auto& top = this->input_stack.top();
+        auto rest = top.input;
+        string_view line;
+        Opm::getline( rest, line );
+
+        if( !line.empty() && line.size() <= RawConsts::maxKeywordLength && std::isalpha( static_cast< unsigned char >( line[ 0 ] ) ) ) {
+            name = uppercase( line.string() );
+            if( this->skip_stops.count( name ) > 0 )
+                return;
+        }
+
+        top.input = rest;
+        top.lineNR++;
+    }
+}
+
 ParserState::ParserState(const ParseContext& __parseContext) :
     parseContext( __parseContext )
 {}
@@ -295,41 +772,30 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         inputFileCanonical = boost::filesystem::canonical(inputFile);
     } catch (boost::filesystem::filesystem_error fs_error) {
         std::string msg = "Could not open file: " + inputFile.string();
+        this->input_complete = false;
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg);
         return;
     }
 
-    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
-    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
-            std::fopen( inputFileCanonical.string().c_str(), "rb" ),
-            closer
-            );
+    input_buffer buffer;
 
     // make sure the file we'd like to parse is readable
-    if( !ufp ) {
+    if( !buffer.load( inputFileCanonical.string() ) ) {
         std::string msg = "Could not read from file: " + inputFile.string();
+        this->input_complete = false;
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg);
         return;
     }
 
-    /*
-     * read the input file C-style. This is done for performance
-     * reasons, as streams are slow
-     */
-
-    auto* fp = ufp.get();
-    std::string buffer;
-    std::fseek( fp, 0, SEEK_END );
-    buffer.resize( std::ftell( fp ) + 1 );
-    std::rewind( fp );
-    const auto readc = std::fread( &buffer[ 0 ], 1, buffer.size() - 1, fp );
-    buffer.back() = '\n';
+    if( ParseProfile::enabled() )
+        ParseProfile::addFile( inputFileCanonical.string(), buffer.view().size() );
 
-    if( std::ferror( fp ) || readc != buffer.size() - 1 )
-        throw std::runtime_error( "Error when reading input file '"
-                                + inputFileCanonical.string() + "'" );
+    this->input_files.push_back( inputFileCanonical.string() );
+    this->input_stack.push( std::move( buffer ), inputFileCanonical );
+}
 
-    this->input_stack.push( clean( buffer ), inputFileCanonical );
+void ParserState::loadView( string_view input, const boost::filesystem::path& p ) {
+    this->input_stack.emplace( p, input );
 }
 
 /*
@@ -339,6 +805,8 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
  */
 
 void ParserState::handleRandomText(const string_view& keywordString ) const {
+    if( this->pretokenize ) throw pretokenize_abort();
+
     std::string errorKey;
     std::stringstream msg;
     std::string trimmedCopy = keywordString.string();
@@ -415,6 +883,8 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
     auto keywordString = ParserKeyword::getDeckName( kw );
 
     if( !parser.isRecognizedKeyword( keywordString ) ) {
+        if( parserState.pretokenize ) throw pretokenize_abort();
+
         if( ParserKeyword::validDeckName( keywordString ) ) {
             std::string msg = "Keyword " + keywordString + " not recognized.";
             parserState.parseContext.handleUnknownKeyword( keywordString.string() );
@@ -451,6 +921,9 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                                 parserKeyword->isTableCollection() );
     }
 
+    /* The size must be looked up in the deck, which is not available yet. */
+    if( parserState.pretokenize ) throw pretokenize_abort();
+
     const auto& keyword_size = parserKeyword->getKeywordSize();
     const auto& deck = parserState.deck;
 
@@ -541,16 +1014,140 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     return false;
 }
 
+DeckKeyword parseRawKeyword( ParserState& parserState, const Parser& parser ) {
+    if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
+        const auto& kwname = parserState.rawKeyword->getKeywordName();
+        const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
+        try {
+            return parserKeyword->parse( parserState.parseContext, parserState.rawKeyword );
+        } catch (const std::exception& exc) {
+            /*
+              This catch-all of parsing errors is to be able to write a good
+              error message; the parser is quite confused at this state and
+              we should not be tempted to continue the parsing.
+            */
+            const auto& rawKeyword = *parserState.rawKeyword;
+            std::string msg = "\nFailed to parse keyword: " + rawKeyword.getKeywordName() + "\n" +
+                              "Starting at location: " + rawKeyword.getFilename() + "(" +  std::to_string(rawKeyword.getLineNR()) + ")\n\n" +
+                              "Inner exception: " + exc.what() + "\n";
+
+            throw std::invalid_argument(msg);
+        }
+    } else {
+        DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
+        const std::string msg = "The keyword " + parserState.rawKeyword->getKeywordName() + " is not recognized";
+        deckKeyword.setLocation( parserState.rawKeyword->getFilename(),
+                parserState.rawKeyword->getLineNR());
+        OpmLog::warning(Log::fileMessage(parserState.current_path().string(), parserState.line(), msg));
+        return deckKeyword;
+    }
+}
+
+using profile_clock = std::chrono::steady_clock;
+
+double seconds_since( profile_clock::time_point start ) {
+    return std::chrono::duration< double >( profile_clock::now() - start ).count();
+}
+
+/*
+ * With the ParseProfile enabled the keyword is profiled: the records are
+ * split into tokens up front, which the parsing would otherwise do lazily,
+ * so the splitting adds to the tokenize time measured by the caller, and
+ * the tokens are counted before the parsing consumes them.
+ */
+void addRawKeyword( ParserState& parserState, const Parser& parser, double tokenize = 0 ) {
+    if( !ParseProfile::enabled() ) {
+        parserState.deck.addKeyword( parseRawKeyword( parserState, parser ) );
+        return;
+    }
+
+    const auto& rawKeyword = *parserState.rawKeyword;
+    const auto split_start = profile_clock::now();
+    std::size_t bytes = 0;
+    std::size_t items = 0;
+    for( const auto& record : rawKeyword ) {
+        bytes += record.getRecordView().size();
+        items += record.size();
+    }
+    tokenize += seconds_since( split_start );
+
+    const auto parse_start = profile_clock::now();
+    auto keyword = parseRawKeyword( parserState, parser );
+    const auto parse = seconds_since( parse_start );
+
+    ParseProfile::addKeyword( rawKeyword.getKeywordName(), rawKeyword.getFilename(),
+                              bytes, rawKeyword.size(), items, tokenize, parse );
+    parserState.deck.addKeyword( std::move( keyword ) );
+}
+
+/*
+ * Hand the current raw keyword to the visitor of a visitFile(). The keyword
+ * is only parsed if it is selected, or is needed for the size of another
+ * keyword. The unit system keywords are applied as they are found, with the
+ * same precedence as Parser::applyUnitsToDeck(). Returns false when the
+ * visitor asks to stop.
+ */
+bool visitRawKeyword( ParserState& parserState, const Parser& parser ) {
+    const auto& name = parserState.rawKeyword->getKeywordName();
+    if( Section::isSectionName( name ) )
+        parserState.section = name;
+
+    int unit_rank = 0;
+    if( name == "LAB" ) unit_rank = 1;
+    if( name == "FIELD" ) unit_rank = 2;
+    if( name == "METRIC" ) unit_rank = 3;
+
+    if( unit_rank > parserState.unit_rank ) {
+        auto& units = parserState.deck.getActiveUnitSystem();
+        if( unit_rank == 1 ) units = UnitSystem::newLAB();
+        if( unit_rank == 2 ) units = UnitSystem::newFIELD();
+        if( unit_rank == 3 ) units = UnitSystem::newMETRIC();
+        parserState.unit_rank = unit_rank;
+    }
+
+    const auto action = parserState.visitor->select( name, parserState.section );
+    if( action == DeckVisitor::Action::Stop )
+        return false;
+
+    const bool size_keyword = parserState.size_keywords.count( name ) > 0;
+    if( action == DeckVisitor::Action::Skip && !size_keyword )
+        return true;
+
+    auto keyword = parseRawKeyword( parserState, parser );
+    bool proceed = true;
+    if( action == DeckVisitor::Action::Parse ) {
+        if( parser.isRecognizedKeyword( name ) ) {
+            const auto* parserKeyword = parser.getParserKeywordFromDeckName( name );
+            if( parserKeyword->hasDimension() )
+                parserKeyword->applyUnitsToDeck( parserState.deck, keyword );
+        }
+
+        proceed = parserState.visitor->visit( keyword, parserState.section );
+    }
+
+    if( size_keyword )
+        parserState.deck.addKeyword( std::move( keyword ) );
+
+    return proceed;
+}
+
 bool parseState( ParserState& parserState, const Parser& parser ) {
+    const bool profile = ParseProfile::enabled();
 
     while( !parserState.done() ) {
 
         parserState.rawKeyword.reset();
 
+        if( parserState.skipping && parserState.nextKeyword.length() == 0 )
+            parserState.skipSection();
+
+        const auto tokenize_start = profile ? profile_clock::now() : profile_clock::time_point();
         const bool streamOK = tryParseKeyword( parserState, parser );
         if( !parserState.rawKeyword && !streamOK )
             continue;
 
+        const double tokenize = profile ? seconds_since( tokenize_start ) : 0;
+
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::end)
             return true;
 
@@ -574,38 +1171,332 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             std::string includeFileAsString = readValueToken<std::string>(firstRecord.getItem(0));
             boost::filesystem::path includeFile = parserState.getIncludeFilePath( includeFileAsString );
 
-            parserState.loadFile( includeFile );
+            if( parserState.skipping ) {
+                boost::system::error_code ec;
+                const auto canonical = boost::filesystem::canonical( includeFile, ec );
+                if( !ec && !parserState.section_index->contains( canonical.string(), parserState.skip_stops ) )
+                    continue;
+            }
+
+            PhaseTimer::Scope phase( "Parser::include" );
+            PhaseTimer::count( "files" );
+            if( !parserState.loadCachedInclude( includeFile, parser ) &&
+                !parserState.loadPrefetched( includeFile, parser ) )
+                parserState.loadFile( includeFile );
             continue;
         }
 
-        if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
-            const auto& kwname = parserState.rawKeyword->getKeywordName();
-            const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
-            try {
-                parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.rawKeyword ) );
-            } catch (const std::exception& exc) {
-                /*
-                  This catch-all of parsing errors is to be able to write a good
-                  error message; the parser is quite confused at this state and
-                  we should not be tempted to continue the parsing.
-                */
-                const auto& rawKeyword = *parserState.rawKeyword;
-                std::string msg = "\nFailed to parse keyword: " + rawKeyword.getKeywordName() + "\n" +
-                                  "Starting at location: " + rawKeyword.getFilename() + "(" +  std::to_string(rawKeyword.getLineNR()) + ")\n\n" +
-                                  "Inner exception: " + exc.what() + "\n";
-
-                throw std::invalid_argument(msg);
+        if( parserState.sections && Section::isSectionName( parserState.rawKeyword->getKeywordName() ) )
+            parserState.skipping = parserState.sections->count( parserState.rawKeyword->getKeywordName() ) == 0;
+
+        if( parserState.visitor ) {
+            if( !visitRawKeyword( parserState, parser ) )
+                return true;
+
+            continue;
+        }
+
+        addRawKeyword( parserState, parser, tokenize );
+    }
+
+    return true;
+}
+
+/*
+ * Tokenize a complete include file into raw keywords, without a deck. Returns
+ * false, leaving keywords in an unspecified state, if the file needs anything
+ * from the deck or contains something which must be reported.
+ */
+bool pretokenizeFile( string_view input,
+                      const boost::filesystem::path& path,
+                      const Parser& parser,
+                      const ParseContext& context,
+                      std::vector< std::shared_ptr< RawKeyword > >& keywords ) {
+    ParserState state( context );
+    state.pretokenize = true;
+    state.loadView( input, path );
+
+    try {
+        while( !state.done() ) {
+            state.rawKeyword.reset();
+
+            const bool streamOK = tryParseKeyword( state, parser );
+            if( !state.rawKeyword && !streamOK )
+                continue;
+
+            const auto& name = state.rawKeyword->getKeywordName();
+            if( name == RawConsts::end || name == RawConsts::endinclude ||
+                name == RawConsts::paths || name == RawConsts::include )
+                return false;
+
+            /*
+             * A keyword which is not completed by the end of the file would
+             * continue into the including file.
+             */
+            if( !state.rawKeyword->isFinished() ) return false;
+            if( !streamOK && state.rawKeyword->getSizeType() == Raw::UNKNOWN )
+                return false;
+
+            keywords.push_back( state.rawKeyword );
+        }
+    } catch( const pretokenize_abort& ) {
+        return false;
+    } catch( const std::exception& ) {
+        return false;
+    }
+
+    return true;
+}
+
+include_prefetcher::~include_prefetcher() {
+    {
+        std::lock_guard< std::mutex > lock( this->budget_mutex );
+        this->cancelled = true;
+    }
+    this->budget_cv.notify_all();
+    for( auto& worker : this->workers )
+        worker.join();
+}
+
+void include_prefetcher::start( std::deque< include_job >&& new_jobs,
+                                size_t num_threads,
+                                size_t read_ahead_bytes,
+                                const Parser& parser,
+                                const ParseContext& context ) {
+    this->jobs = std::move( new_jobs );
+    this->read_ahead = read_ahead_bytes;
+    for( size_t i = 0; i < this->jobs.size(); ++i ) {
+        auto& job = this->jobs[ i ];
+        job.index = i;
+        this->pending[ job.path.string() ].push_back( &job );
+    }
+
+    num_threads = std::min( num_threads, this->jobs.size() );
+    for( size_t i = 0; i < num_threads; ++i )
+        this->workers.emplace_back( &include_prefetcher::work, this,
+                                    std::cref( parser ), std::cref( context ) );
+}
+
+void include_prefetcher::work( const Parser& parser, const ParseContext& context ) {
+    size_t index;
+    while( (index = this->next++) < this->jobs.size() ) {
+        auto& job = this->jobs[ index ];
+        this->reserve( job );
+
+        try {
+            if( !this->cancelled && job.buffer.load( job.path.string() ) ) {
+                job.loaded = true;
+                job.tokenized = pretokenizeFile( job.buffer.view(), job.path,
+                                                 parser, context, job.keywords );
+            }
+        } catch( const std::exception& ) {
+            /* leave it to the main parse to load the file and report */
+            job.loaded = false;
+        }
+
+        if( !job.tokenized ) job.keywords.clear();
+        job.promise.set_value();
+    }
+}
+
+/*
+ * Wait until the file of the job fits in the read ahead budget. A file which
+ * is larger than the whole budget is loaded once nothing else is in flight.
+ */
+void include_prefetcher::reserve( include_job& job ) {
+    if( this->read_ahead == 0 ) return;
+
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size( job.path, ec );
+    const size_t bytes = ec ? 0 : size;
+
+    std::unique_lock< std::mutex > lock( this->budget_mutex );
+    this->budget_cv.wait( lock, [&]() {
+        return this->cancelled
+            || job.index <= this->wanted
+            || this->in_flight == 0
+            || this->in_flight + bytes <= this->read_ahead;
+    } );
+
+    if( job.released ) return;
+    job.bytes = bytes;
+    this->in_flight += bytes;
+}
+
+/*
+ * Taking a job releases its bytes from the read ahead budget, along with the
+ * bytes of any earlier job the main parse did not take, e.g. an INCLUDE in
+ * a skipped section.
+ */
+include_job* include_prefetcher::take( const boost::filesystem::path& p ) {
+    auto iter = this->pending.find( p.string() );
+    if( iter == this->pending.end() || iter->second.empty() )
+        return nullptr;
+
+    auto* job = iter->second.front();
+    iter->second.pop_front();
+
+    if( this->read_ahead > 0 ) {
+        {
+            std::lock_guard< std::mutex > lock( this->budget_mutex );
+            this->wanted = std::max( this->wanted, job->index );
+            for( ; this->released < this->jobs.size() && this->released <= this->wanted; ++this->released ) {
+                auto& earlier = this->jobs[ this->released ];
+                earlier.released = true;
+                this->in_flight -= earlier.bytes;
             }
-        } else {
-            DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
-            const std::string msg = "The keyword " + parserState.rawKeyword->getKeywordName() + " is not recognized";
-            deckKeyword.setLocation( parserState.rawKeyword->getFilename(),
-                    parserState.rawKeyword->getLineNR());
-            parserState.deck.addKeyword( std::move( deckKeyword ) );
-            OpmLog::warning(Log::fileMessage(parserState.current_path().string(), parserState.line(), msg));
         }
+        this->budget_cv.notify_all();
+    }
+
+    job->done.wait();
+    return job;
+}
+
+/*
+ * Scan the root file for INCLUDE keywords, and start loading and tokenizing
+ * the included files on num_threads worker threads. Includes which use path
+ * aliases from PATHS are left to the main parse, since the aliases are not
+ * known until the PATHS keyword has been parsed.
+ */
+void ParserState::prefetchIncludes( const Parser& parser, size_t num_threads, size_t read_ahead ) {
+    if( num_threads == 0 || this->input_stack.empty() ) return;
+
+    std::deque< include_job > jobs;
+    string_view input = this->input_stack.top().input, line;
+    std::string keyword;
+
+    while( Opm::getline( input, line ) ) {
+        if( !RawKeyword::isKeywordPrefix( line, keyword ) ) continue;
+        if( keyword != RawConsts::include ) continue;
+
+        string_view record;
+        while( Opm::getline( input, record ) && record.empty() ) {}
+        if( record.empty() ) break;
+
+        try {
+            if( RawRecord::isTerminatedRecordString( record ) )
+                record = string_view( record.begin(), record.end() - 1 );
+
+            RawRecord raw( record );
+            if( raw.size() == 0 ) continue;
+
+            const auto target = readValueToken< std::string >( raw.getItem( 0 ) );
+            if( target.find_first_of( "$\\" ) != std::string::npos ) continue;
+
+            include_job job;
+            job.path = boost::filesystem::canonical( this->getIncludeFilePath( target ) );
+            jobs.push_back( std::move( job ) );
+        } catch( const std::exception& ) {
+            /* the main parse will find and report whatever is wrong */
+            continue;
+        }
+    }
+
+    if( !jobs.empty() )
+        this->prefetcher.start( std::move( jobs ), num_threads, read_ahead, parser, this->parseContext );
+}
+
+/*
+ * Use the prefetched result for includeFile, if there is one. Pre-tokenized
+ * keywords are added to the deck right away, otherwise the already loaded
+ * buffer is pushed on the input stack. Returns false if the file must be
+ * loaded the normal way.
+ */
+bool ParserState::loadPrefetched( const boost::filesystem::path& includeFile,
+                                  const Parser& parser ) {
+    boost::filesystem::path canonical;
+    try {
+        canonical = boost::filesystem::canonical( includeFile );
+    } catch( const boost::filesystem::filesystem_error& ) {
+        return false;
+    }
+
+    auto* job = this->prefetcher.take( canonical );
+    if( !job || !job->loaded ) return false;
+
+    this->input_files.push_back( canonical.string() );
+    if( ParseProfile::enabled() )
+        ParseProfile::addFile( canonical.string(), job->buffer.view().size() );
+
+    if( !job->tokenized ) {
+        this->input_stack.push( std::move( job->buffer ), canonical );
+        return true;
     }
 
+    for( auto& keyword : job->keywords ) {
+        this->rawKeyword = std::move( keyword );
+        addRawKeyword( *this, parser );
+    }
+
+    this->rawKeyword.reset();
+    this->input_stack.retain( std::move( job->buffer ) );
+    return true;
+}
+
+/*
+ * Splice the keywords of includeFile from the include cache. On a miss the
+ * file is tokenized up front, like on the prefetch threads, and if that
+ * works out the keywords are parsed into the deck and cached; a file which
+ * needs context from the deck is pushed on the input stack as usual and
+ * never cached. Returns false if the file must be loaded the normal way.
+ */
+bool ParserState::loadCachedInclude( const boost::filesystem::path& includeFile,
+                                     const Parser& parser ) {
+    if( this->include_cache.empty() || this->visitor ) return false;
+
+    boost::filesystem::path canonical;
+    try {
+        canonical = boost::filesystem::canonical( includeFile );
+    } catch( const boost::filesystem::filesystem_error& ) {
+        return false;
+    }
+
+    const auto cacheFile = DeckCache::includeCacheFile( this->include_cache, canonical.string() );
+    std::vector< DeckKeyword > cached;
+    if( DeckCache::loadKeywords( cacheFile, this->cache_key, canonical.string(), cached ) ) {
+        PhaseTimer::count( "cached files" );
+        this->input_files.push_back( canonical.string() );
+        for( auto& keyword : cached )
+            this->deck.addKeyword( std::move( keyword ) );
+
+        return true;
+    }
+
+    input_buffer loaded;
+    input_buffer* buffer = &loaded;
+    std::vector< std::shared_ptr< RawKeyword > > keywords;
+    bool tokenized;
+
+    auto* job = this->prefetcher.take( canonical );
+    if( job && job->loaded ) {
+        buffer = &job->buffer;
+        keywords = std::move( job->keywords );
+        tokenized = job->tokenized;
+    } else {
+        if( !loaded.load( canonical.string() ) ) return false;
+        tokenized = pretokenizeFile( loaded.view(), canonical, parser, this->parseContext, keywords );
+    }
+
+    this->input_files.push_back( canonical.string() );
+    if( ParseProfile::enabled() )
+        ParseProfile::addFile( canonical.string(), buffer->view().size() );
+
+    if( !tokenized ) {
+        this->input_stack.push( std::move( *buffer ), canonical );
+        return true;
+    }
+
+    const auto first = this->deck.size();
+    for( auto& keyword : keywords ) {
+        this->rawKeyword = std::move( keyword );
+        addRawKeyword( *this, parser );
+    }
+
+    this->rawKeyword.reset();
+    this->input_stack.retain( std::move( *buffer ) );
+    DeckCache::saveKeywords( cacheFile, this->cache_key, canonical.string(),
+                             this->deck, first, this->deck.size() );
     return true;
 }
 
@@ -621,8 +1512,30 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     Parser::Parser(bool addDefault) {
-        if (addDefault)
-            addDefaultKeywords();
+        if (!addDefault)
+            return;
+
+        this->m_defaultKeywords = Parser::defaultKeywords();
+        this->m_deckParserKeywords = this->m_defaultKeywords->m_deckParserKeywords;
+        this->m_wildCardKeywords = this->m_defaultKeywords->m_wildCardKeywords;
+    }
+
+    /*
+      The default keywords are only built once per process, by the first
+      parser constructed with them; the keywords are immutable once added,
+      so every later parser shares them and only copies the name lookup
+      tables. Keywords added with addParserKeyword() are owned by the
+      parser they are added to and replace the default keyword of the same
+      name in that parser only.
+    */
+    std::shared_ptr< const Parser > Parser::defaultKeywords() {
+        static const std::shared_ptr< const Parser > defaults = [] {
+            std::shared_ptr< Parser > parser( new Parser( false ) );
+            parser->addDefaultKeywords();
+            return parser;
+        }();
+
+        return defaults;
     }
 
 
@@ -678,10 +1591,88 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return parse(deck, context).getInputGrid();
     }
 
+    /*
+     * The deck cache key covers what, besides the input files, decides the
+     * parsed deck: the recognized keywords, their definitions and the
+     * ParseContext actions. A definition is hashed as the code the keyword
+     * generator would write for it, which captures the sizes, records,
+     * items, defaults and dimensions.
+     */
+    std::uint64_t Parser::deckCacheKey( const ParseContext& context ) const {
+        auto names = this->getAllDeckNames();
+        std::sort( names.begin(), names.end() );
+
+        auto key = DeckCache::hash( nullptr, 0 );
+        for( const auto& name : names )
+            key = DeckCache::hash( name + '\0', key );
+
+        std::set< const ParserKeyword* > keywords;
+        for( const auto& pair : this->m_deckParserKeywords )
+            keywords.insert( pair.second );
+        for( const auto& pair : this->m_wildCardKeywords )
+            keywords.insert( pair.second );
+
+        std::vector< std::string > definitions;
+        definitions.reserve( keywords.size() );
+        for( const auto* keyword : keywords )
+            definitions.push_back( keyword->createCode() );
+
+        std::sort( definitions.begin(), definitions.end() );
+        for( const auto& definition : definitions )
+            key = DeckCache::hash( definition + '\0', key );
+
+        for( const auto& action : context ) {
+            key = DeckCache::hash( action.first + '\0', key );
+            key = DeckCache::hash( std::to_string( static_cast< int >( action.second ) ) + '\0', key );
+        }
+
+        return key;
+    }
+
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext) const {
+        PhaseTimer::Scope phase( "Parser::parseFile" );
+        std::uint64_t cacheKey = 0;
+        const auto cacheFile = DeckCache::cacheFile( dataFileName );
+
+        if( this->m_deckCache || this->m_includeCache )
+            cacheKey = this->deckCacheKey( parseContext );
+
+        if( this->m_deckCache ) {
+
+            Deck deck;
+            if( DeckCache::load( cacheFile, cacheKey, deck ) ) {
+                deck.setDataFile( dataFileName );
+                if( this->m_siConversionSize > 0 )
+                    deck.convertToSI( this->m_siConversionSize );
+                if( MemoryUsage::enabled() )
+                    MemoryUsage::log( deck.memory_usage() );
+                return deck;
+            }
+        }
+
         ParserState parserState( parseContext, dataFileName );
+        if( this->m_includeCache ) {
+            parserState.include_cache = DeckCache::includeCacheDir( dataFileName );
+            parserState.cache_key = cacheKey;
+        }
+        parserState.prefetchIncludes( *this, this->m_includeThreads, this->m_includeReadAhead );
         parseState( parserState, *this );
         applyUnitsToDeck( parserState.deck );
+        PhaseTimer::count( "keywords", parserState.deck.size() );
+
+        if( parserState.input_complete )
+            parserState.deck.setInputFiles( parserState.input_files );
+
+        if( this->m_deckCache && parserState.input_complete )
+            DeckCache::save( cacheFile, cacheKey, parserState.input_files, parserState.deck );
+
+        if( this->m_siConversionSize > 0 ) {
+            PhaseTimer::Scope convert( "Deck::convertToSI" );
+            parserState.deck.convertToSI( this->m_siConversionSize );
+        }
+
+        if( MemoryUsage::enabled() )
+            MemoryUsage::log( parserState.deck.memory_usage() );
 
         return std::move( parserState.deck );
     }
@@ -696,6 +1687,83 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return std::move( parserState.deck );
     }
 
+    Deck Parser::parseSections(const std::string& dataFileName,
+                               const std::set< std::string >& sections,
+                               const ParseContext& parseContext) const {
+        PhaseTimer::Scope phase( "Parser::parseSections" );
+        for( const auto& section : sections ) {
+            if( !Section::isSectionName( section ) )
+                throw std::invalid_argument( "Not a section: " + section );
+        }
+
+        const SectionIndex index( dataFileName );
+        ParserState parserState( parseContext, dataFileName );
+        parserState.sections = &sections;
+        parserState.section_index = &index;
+        parserState.skip_stops = this->sizeKeywords();
+        for( const auto* keyword : { "RUNSPEC", "GRID", "EDIT", "PROPS", "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE",
+                                     "FIELD", "METRIC", "LAB", "PVT-M", "INCLUDE", "PATHS", "ENDINC", "END" } )
+            parserState.skip_stops.insert( keyword );
+
+        parseState( parserState, *this );
+        applyUnitsToDeck( parserState.deck );
+        PhaseTimer::count( "keywords", parserState.deck.size() );
+
+        return std::move( parserState.deck );
+    }
+
+    void Parser::visitFile(const std::string& dataFileName, DeckVisitor& visitor, const ParseContext& parseContext) const {
+        PhaseTimer::Scope phase( "Parser::visitFile" );
+        ParserState parserState( parseContext, dataFileName );
+        parserState.visitor = &visitor;
+        parserState.size_keywords = this->sizeKeywords();
+        parseState( parserState, *this );
+    }
+
+    void Parser::visitString(const std::string& data, DeckVisitor& visitor, const ParseContext& parseContext) const {
+        ParserState parserState( parseContext );
+        parserState.loadString( data );
+        parserState.visitor = &visitor;
+        parserState.size_keywords = this->sizeKeywords();
+        parseState( parserState, *this );
+    }
+
+    std::set< std::string > Parser::sizeKeywords() const {
+        std::set< std::string > keywords;
+        const auto add = [&keywords]( const ParserKeyword* keyword ) {
+            if( keyword->getSizeType() == OTHER_KEYWORD_IN_DECK )
+                keywords.insert( keyword->getKeywordSize().keyword );
+        };
+
+        for( const auto& pair : this->m_deckParserKeywords )
+            add( pair.second );
+
+        for( const auto& pair : this->m_wildCardKeywords )
+            add( pair.second );
+
+        return keywords;
+    }
+
+    void Parser::setIncludeThreads(size_t numThreads) {
+        this->m_includeThreads = numThreads;
+    }
+
+    void Parser::setIncludeReadAhead(size_t bytes) {
+        this->m_includeReadAhead = bytes;
+    }
+
+    void Parser::setDeckCache(bool enable) {
+        this->m_deckCache = enable;
+    }
+
+    void Parser::setIncludeCache(bool enable) {
+        this->m_includeCache = enable;
+    }
+
+    void Parser::setSIConversion(size_t minSize) {
+        this->m_siConversionSize = minSize;
+    }
+
     size_t Parser::size() const {
         return m_deckParserKeywords.size();
     }
@@ -840,6 +1908,12 @@ std::vector<std::string> Parser::getAllDeckNames () const {
     }
 
 
+    void Parser::loadKeywordBundle(const boost::filesystem::path& bundleFile) {
+        for (auto& keyword : KeywordBundle::load(bundleFile.string()))
+            addParserKeyword( std::unique_ptr< const ParserKeyword >( std::move( keyword ) ) );
+    }
+
+
     void Parser::applyUnitsToDeck(Deck& deck) const {
         /*
          * If multiple unit systems are requested, metric is preferred over
@@ -864,15 +1938,6 @@ std::vector<std::string> Parser::getAllDeckNames () const {
         }
     }
 
-    static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
-    }
-
     bool Section::checkSectionTopology(const Deck& deck,
                                        const Parser& parser,
                                        bool ensureKeywordSectionAffiliation)
@@ -883,44 +1948,40 @@ std::vector<std::string> Parser::getAllDeckNames () const {
             return false;
         }
 
-        bool deckValid = true;
+        KeywordMessages messages;
 
         if( deck.getKeyword(0).name() != "RUNSPEC" ) {
             std::string msg = "The first keyword of a valid deck must be RUNSPEC\n";
-            auto curKeyword = deck.getKeyword(0);
-            OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-            deckValid = false;
+            messages.emplace_back( 0, msg );
         }
 
+        /*
+          The order of the sections is checked from the section keywords
+          alone, found in the keyword index of the deck. The first keyword
+          starts a section whatever it is, and a section keyword in the
+          wrong place does not change the current section.
+        */
+        std::vector< size_t > sectionStarts = { 0 };
+        for( size_t offset : Section::sectionOffsets( deck ) )
+            if( offset > 0 ) sectionStarts.push_back( offset );
+
+        std::vector< std::string > sectionNames;
+
+        KeywordMessages topology;
         std::string curSectionName = deck.getKeyword(0).name();
-        size_t curKwIdx = 1;
-        for (; curKwIdx < deck.size(); ++curKwIdx) {
-            const auto& curKeyword = deck.getKeyword(curKwIdx);
-            const std::string& curKeywordName = curKeyword.name();
-
-            if (!isSectionDelimiter( curKeyword )) {
-                if( !parser.isRecognizedKeyword( curKeywordName ) )
-                    // ignore unknown keywords for now (i.e. they can appear in any section)
-                    continue;
-
-                const auto& parserKeyword = parser.getParserKeywordFromDeckName( curKeywordName );
-                if (ensureKeywordSectionAffiliation && !parserKeyword->isValidSection(curSectionName)) {
-                    std::string msg =
-                        "The keyword '"+curKeywordName+"' is located in the '"+curSectionName
-                        +"' section where it is invalid";
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
-                }
-
-                continue;
-            }
+        sectionNames.push_back( curSectionName );
+        for (size_t sectionIdx = 1; sectionIdx < sectionStarts.size(); ++sectionIdx) {
+            const size_t curKwIdx = sectionStarts[sectionIdx];
+            const std::string& curKeywordName = deck.getKeyword(curKwIdx).name();
+            const auto warning = [&topology, curKwIdx]( const std::string& msg ) {
+                topology.emplace_back( curKwIdx, msg );
+            };
 
             if (curSectionName == "RUNSPEC") {
                 if (curKeywordName != "GRID") {
                     std::string msg =
                         "The RUNSPEC section must be followed by GRID instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -929,8 +1990,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "EDIT" && curKeywordName != "PROPS") {
                     std::string msg =
                         "The GRID section must be followed by EDIT or PROPS instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -939,8 +1999,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "PROPS") {
                     std::string msg =
                         "The EDIT section must be followed by PROPS instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -949,8 +2008,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "REGIONS" && curKeywordName != "SOLUTION") {
                     std::string msg =
                         "The PROPS section must be followed by REGIONS or SOLUTION instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -959,8 +2017,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "SOLUTION") {
                     std::string msg =
                         "The REGIONS section must be followed by SOLUTION instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -969,8 +2026,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "SUMMARY" && curKeywordName != "SCHEDULE") {
                     std::string msg =
                         "The SOLUTION section must be followed by SUMMARY or SCHEDULE instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -979,8 +2035,7 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 if (curKeywordName != "SCHEDULE") {
                     std::string msg =
                         "The SUMMARY section must be followed by SCHEDULE instead of "+curKeywordName;
-                    OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                    deckValid = false;
+                    warning(msg);
                 }
 
                 curSectionName = curKeywordName;
@@ -990,21 +2045,74 @@ std::vector<std::string> Parser::getAllDeckNames () const {
                 std::string msg =
                     "The SCHEDULE section must be the last one ("
                     +curKeywordName+" specified after SCHEDULE)";
-                OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-                deckValid = false;
+                warning(msg);
             }
+
+            sectionNames.push_back( curSectionName );
+        }
+
+        /*
+          The keywords are checked against their section as a parallel
+          reduction over ranges of the deck.
+        */
+        if (ensureKeywordSectionAffiliation) {
+            const auto check = [&deck, &parser, &sectionStarts, &sectionNames]( size_t first, size_t last, KeywordMessages& range_messages ) {
+                size_t sectionIdx = std::upper_bound( sectionStarts.begin(), sectionStarts.end(), first ) - sectionStarts.begin() - 1;
+                for( size_t curKwIdx = first; curKwIdx < last; ++curKwIdx ) {
+                    if( sectionIdx + 1 < sectionStarts.size() && sectionStarts[sectionIdx + 1] == curKwIdx )
+                        ++sectionIdx;
+
+                    if( sectionStarts[sectionIdx] == curKwIdx )
+                        continue;
+
+                    const auto& curKeyword = deck.getKeyword(curKwIdx);
+                    const std::string& curKeywordName = curKeyword.name();
+                    if( !parser.isRecognizedKeyword( curKeywordName ) )
+                        // ignore unknown keywords for now (i.e. they can appear in any section)
+                        continue;
+
+                    const std::string& curSectionName = sectionNames[sectionIdx];
+                    const auto& parserKeyword = parser.getParserKeywordFromDeckName( curKeywordName );
+                    if (!parserKeyword->isValidSection(curSectionName)) {
+                        std::string msg =
+                            "The keyword '"+curKeywordName+"' is located in the '"+curSectionName
+                            +"' section where it is invalid";
+                        range_messages.emplace_back( curKwIdx, msg );
+                    }
+                }
+            };
+
+            const auto affiliation = checkKeywordRanges( deck.size(), check );
+            KeywordMessages merged;
+            std::merge( messages.begin(), messages.end(), affiliation.begin(), affiliation.end(),
+                        std::back_inserter( merged ),
+                        []( const KeywordMessages::value_type& a, const KeywordMessages::value_type& b ) {
+                            return a.first < b.first;
+                        });
+            messages.swap( merged );
         }
 
+        // the messages are reported in deck order
+        KeywordMessages ordered;
+        std::merge( messages.begin(), messages.end(), topology.begin(), topology.end(),
+                    std::back_inserter( ordered ),
+                    []( const KeywordMessages::value_type& a, const KeywordMessages::value_type& b ) {
+                        return a.first < b.first;
+                    });
+
         // SCHEDULE is the last section and it is mandatory, so make sure it is there
         if (curSectionName != "SCHEDULE") {
-            const auto& curKeyword = deck.getKeyword(deck.size() - 1);
             std::string msg =
                 "The last section of a valid deck must be SCHEDULE (is "+curSectionName+")";
-            OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), msg) );
-            deckValid = false;
+            ordered.emplace_back( deck.size() - 1, msg );
+        }
+
+        for( const auto& message : ordered ) {
+            const auto& curKeyword = deck.getKeyword( message.first );
+            OpmLog::warning(Log::fileMessage(curKeyword.getFileName(), curKeyword.getLineNumber(), message.second) );
         }
 
-        return deckValid;
+        return ordered.empty();
     }
 
 } // namespace Opm
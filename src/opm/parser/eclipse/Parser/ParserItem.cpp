@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <ostream>
 #include <sstream>
 
@@ -26,6 +28,7 @@
 
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserEnums.hpp>
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
 
@@ -266,11 +269,15 @@ void ParserItem::push_backDimension( const std::string& dim ) {
 }
 
     const std::string& ParserItem::name() const {
+        return m_name.str();
+    }
+
+    Symbol ParserItem::symbol() const {
         return m_name;
     }
 
     const std::string ParserItem::className() const {
-        return m_name;
+        return m_name.str();
     }
 
 
@@ -368,11 +375,193 @@ std::string ParserItem::createCode() const {
 
 namespace {
 
+/*
+ * Fast number parsing for the bulk data tokens. Only the plain forms are
+ * handled here; anything else (very long mantissas, large exponents, nan/inf,
+ * malformed input) returns false and the token is handed to readValueToken(),
+ * which is the authoritative parser and also produces the error messages.
+ */
+bool fast_value( const char* first, const char* last, int& value ) {
+    bool negative = false;
+    if( first != last && ( *first == '-' || *first == '+' ) )
+        negative = *first++ == '-';
+
+    /* nine digits can never overflow an int */
+    if( first == last || last - first > 9 ) return false;
+
+    int n = 0;
+    for( ; first != last; ++first ) {
+        const unsigned digit = *first - '0';
+        if( digit > 9 ) return false;
+        n = 10 * n + int( digit );
+    }
+
+    value = negative ? -n : n;
+    return true;
+}
+
+bool fast_value( const char* first, const char* last, double& value ) {
+    /*
+     * The mantissa is accumulated as an integer and scaled by an exact power
+     * of ten. As long as the mantissa fits in 53 bits and the power is at
+     * most 22 this is a single correctly rounded operation, which gives the
+     * same result as scaling in the full parser.
+     */
+    static const double pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    bool negative = false;
+    if( first != last && ( *first == '-' || *first == '+' ) )
+        negative = *first++ == '-';
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+
+    for( ; first != last && unsigned( *first - '0' ) <= 9; ++first, ++digits )
+        mantissa = 10 * mantissa + unsigned( *first - '0' );
+
+    if( first != last && *first == '.' ) {
+        ++first;
+        for( ; first != last && unsigned( *first - '0' ) <= 9; ++first, ++digits ) {
+            mantissa = 10 * mantissa + unsigned( *first - '0' );
+            --exponent;
+        }
+    }
+
+    if( digits == 0 || digits > 15 ) return false;
+
+    if( first != last ) {
+        const char e = *first++;
+        if( e != 'e' && e != 'E' && e != 'd' && e != 'D' ) return false;
+
+        bool negative_exp = false;
+        if( first != last && ( *first == '-' || *first == '+' ) )
+            negative_exp = *first++ == '-';
+
+        if( first == last || last - first > 3 ) return false;
+
+        int exp = 0;
+        for( ; first != last; ++first ) {
+            const unsigned digit = *first - '0';
+            if( digit > 9 ) return false;
+            exp = 10 * exp + int( digit );
+        }
+
+        exponent += negative_exp ? -exp : exp;
+    }
+
+    if( exponent < -22 || exponent > 22 ) return false;
+
+    const double m = double( mantissa );
+    const double x = exponent < 0 ? m / pow10[ -exponent ] : m * pow10[ exponent ];
+    value = negative ? -x : x;
+    return true;
+}
+
+template< typename T >
+T read_value( const char* first, const char* last ) {
+    T value;
+    if( fast_value( first, last, value ) ) return value;
+    return readValueToken< T >( string_view( first, last ) );
+}
+
+/*
+ * Single pass scanner for items that swallow the remaining record with
+ * numbers, i.e. the bulk data keywords like PERMX and ZCORN. The record
+ * string is scanned directly instead of being split into a token deque, and
+ * the values are written straight into the DeckItem. Returns false, without
+ * having touched the record, if the record holds quoted strings or the item
+ * is a string item; those are left to the general scanner.
+ */
+template< typename T >
+bool scan_bulk( const ParserItem& p, RawRecord& record, DeckItem& item ) {
+    const auto view = record.getRecordView();
+    if( std::find( view.begin(), view.end(), RawConsts::quote ) != view.end() )
+        return false;
+
+    const RawConsts::is_separator sep;
+
+    /*
+     * Count the tokens up front. This is cheap compared to the parsing, and
+     * sizes the value buffer exactly for all but the N*value tokens, instead
+     * of leaving the large arrays with the slack of geometric growth.
+     */
+    std::size_t num_tokens = 0;
+    bool in_token = false;
+    for( char c : view ) {
+        const bool is_sep = sep( c );
+        num_tokens += !is_sep && !in_token;
+        in_token = !is_sep;
+    }
+
+    item = DeckItem( p.symbol(), T(), num_tokens );
+    const char* cursor = view.begin();
+    const char* end = view.end();
+
+    while( true ) {
+        while( cursor != end && sep( *cursor ) ) ++cursor;
+        if( cursor == end ) break;
+
+        const char* token_begin = cursor;
+        const char* star = nullptr;
+        while( cursor != end && !sep( *cursor ) ) {
+            if( *cursor == '*' && !star ) star = cursor;
+            ++cursor;
+        }
+
+        if( !star ) {
+            item.push_back( read_value< T >( token_begin, cursor ) );
+            continue;
+        }
+
+        const string_view token( token_begin, cursor );
+        std::string countString;
+        std::string valueString;
+        if( !isStarToken( token, countString, valueString ) ) {
+            item.push_back( readValueToken< T >( token ) );
+            continue;
+        }
+
+        StarToken st( token, countString, valueString );
+        if( st.hasValue() ) {
+            item.push_back( read_value< T >( star + 1, cursor ), st.count() );
+            continue;
+        }
+
+        const auto value = p.getDefault< T >();
+        for( size_t i = 0; i < st.count(); i++ )
+            item.push_backDefault( value );
+    }
+
+    record.clear();
+    return true;
+}
+
+template<>
+bool scan_bulk< std::string >( const ParserItem&, RawRecord&, DeckItem& ) {
+    return false;
+}
+
 template< typename T >
 DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
-    DeckItem item( p.name(), T(), record.size() );
     bool parse_raw = p.parseRaw();
 
+    if( p.sizeType() == ParserItem::item_size::ALL && !parse_raw && record.untouched() ) {
+        DeckItem item( p.symbol() );
+        if( scan_bulk< T >( p, record, item ) ) return item;
+    }
+
+    /*
+      A SINGLE item holds one value; reserving the rest of the record
+      for it would cost e.g. a COMPDAT record a dozen values per item.
+    */
+    const auto size_hint = p.sizeType() == ParserItem::item_size::ALL ? record.size() : 1;
+    DeckItem item( p.symbol(), T(), size_hint );
+
     if( p.sizeType() == ParserItem::item_size::ALL ) {
         if (parse_raw) {
             while (record.size()) {
@@ -543,6 +543,22 @@ void set_dimensions( ParserItem& item,
         try {
             m_matchRegex = boost::regex(deckNameRegexp);
             m_matchRegexString = deckNameRegexp;
+
+            /*
+             * Find the first characters which can possibly match by partial
+             * matching each of them against the expression. matches() is
+             * called on every wildcard keyword for every deck name which is
+             * not an exact match, and this rejects nearly all of them without
+             * running the regex.
+             */
+            m_matchRegexStart.reset();
+            for (size_t c = 1; c < m_matchRegexStart.size(); ++c) {
+                const char first[] = { char( c ) };
+                boost::cmatch match;
+                if (boost::regex_search( first, first + 1, match, m_matchRegex,
+                                         boost::match_partial | boost::match_continuous ))
+                    m_matchRegexStart.set( c );
+            }
         }
         catch (const std::exception &e) {
             std::cerr << "Warning: Malformed regular expression for keyword '" << getName() << "':\n"
@@ -561,6 +577,10 @@ void set_dimensions( ParserItem& item,
             return true;
 
         else if (hasMatchRegex()) {
+            const auto first = static_cast< unsigned char >( name[ 0 ] );
+            if (first >= m_matchRegexStart.size() || !m_matchRegexStart.test( first ))
+                return false;
+
             return boost::regex_match( name.begin(), name.end(), m_matchRegex);
         }
 
@@ -692,11 +712,21 @@ void set_dimensions( ParserItem& item,
     }
 
 
+    /*
+      The records after the last ParserRecord share it, so the units are
+      resolved a few times per keyword rather than once per record.
+    */
     void ParserKeyword::applyUnitsToDeck( Deck& deck, DeckKeyword& deckKeyword) const {
+        const ParserRecord* resolved = nullptr;
+        std::vector< ParserRecord::ItemUnits > units;
         for (size_t index = 0; index < deckKeyword.size(); index++) {
             const auto& parserRecord = this->getRecord( index );
-            auto& deckRecord = deckKeyword.getRecord( index );
-            parserRecord.applyUnitsToDeck( deck, deckRecord );
+            if (&parserRecord != resolved) {
+                units = parserRecord.resolveUnits( deck );
+                resolved = &parserRecord;
+            }
+
+            parserRecord.applyUnits( units, deckKeyword.getRecord( index ) );
         }
     }
 
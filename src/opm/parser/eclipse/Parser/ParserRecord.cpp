@@ -88,16 +88,36 @@ namespace {
 
 
     void ParserRecord::applyUnitsToDeck( Deck& deck, DeckRecord& deckRecord ) const {
-        for( const auto& item : *this ) {
-            if( !item.hasDimension() ) continue;
+        this->applyUnits( this->resolveUnits( deck ), deckRecord );
+    }
 
-            auto& deckItem = deckRecord.getItem( item.name() );
 
-            for (size_t idim = 0; idim < item.numDimensions(); idim++) {
-                auto activeDimension  = deck.getActiveUnitSystem().getNewDimension( item.getDimension(idim) );
-                auto defaultDimension = deck.getDefaultUnitSystem().getNewDimension( item.getDimension(idim) );
-                deckItem.push_backDimension( activeDimension , defaultDimension );
-            }
+    std::vector< ParserRecord::ItemUnits > ParserRecord::resolveUnits( Deck& deck ) const {
+        std::vector< ItemUnits > units;
+        for (size_t index = 0; index < this->m_items.size(); index++) {
+            const auto& item = this->m_items[ index ];
+            for (size_t idim = 0; idim < item.numDimensions(); idim++)
+                units.push_back( { index,
+                                   deck.getActiveUnitSystem().getNewDimension( item.getDimension(idim) ),
+                                   deck.getDefaultUnitSystem().getNewDimension( item.getDimension(idim) ) } );
+        }
+
+        return units;
+    }
+
+
+    /*
+      The items of a parsed record are in the order of the parser items,
+      other records are searched by name.
+    */
+    void ParserRecord::applyUnits( const std::vector< ItemUnits >& units, DeckRecord& deckRecord ) const {
+        for( const auto& unit : units ) {
+            const auto& name = this->m_items[ unit.item ].name();
+            auto& deckItem = ( unit.item < deckRecord.size() && deckRecord.getItem( unit.item ).name() == name )
+                ? deckRecord.getItem( unit.item )
+                : deckRecord.getItem( name );
+
+            deckItem.push_backDimension( unit.active , unit.fallback );
         }
     }
 
@@ -129,7 +149,7 @@ namespace {
         for( const auto& parserItem : *this )
             items.emplace_back( parserItem.scan( rawRecord ) );
 
-        if (rawRecord.size() > 0) {
+        if (rawRecord.size() > 0 && !parseContext.isIgnored( ParseContext::PARSE_EXTRA_DATA )) {
             std::string msg = "The RawRecord for keyword \""  + rawRecord.getKeywordName() + "\" in file\"" + rawRecord.getFileName() + "\" contained " +
                 std::to_string(rawRecord.size()) +
                 " too many items according to the spec. RawRecord was: " + rawRecord.getRecordString();
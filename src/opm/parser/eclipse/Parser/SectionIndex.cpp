@@ -0,0 +1,239 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Section.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/SectionIndex.hpp>
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* The line without the comment and the surrounding whitespace. */
+    std::string strip( const char* begin, const char* end ) {
+        bool quoted = false;
+        char quote = 0;
+        const char* pos = begin;
+        for( ; pos != end; ++pos ) {
+            if( quoted ) {
+                if( *pos == quote ) quoted = false;
+            } else if( *pos == '\'' || *pos == '"' ) {
+                quoted = true;
+                quote = *pos;
+            } else if( *pos == '-' && pos + 1 != end && *(pos + 1) == '-' )
+                break;
+        }
+
+        return boost::algorithm::trim_copy( std::string( begin, pos ) );
+    }
+
+
+    /* The whitespace separated tokens of a record, without quotes and '/'. */
+    std::vector< std::string > tokens( const std::string& line ) {
+        std::vector< std::string > result;
+        auto pos = line.begin();
+        while( pos != line.end() ) {
+            pos = std::find_if_not( pos, line.end(), []( char c ) { return std::isspace( c ); } );
+            if( pos == line.end() || *pos == '/' )
+                break;
+
+            if( *pos == '\'' || *pos == '"' ) {
+                const auto close = std::find( pos + 1, line.end(), *pos );
+                result.emplace_back( pos + 1, close );
+                pos = close == line.end() ? close : close + 1;
+            } else {
+                const auto stop = std::find_if( pos, line.end(), []( char c ) { return std::isspace( c ) || c == '/'; } );
+                result.emplace_back( pos, stop );
+                pos = stop;
+            }
+        }
+
+        return result;
+    }
+
+
+    bool is_gzip( const std::string& content ) {
+        return content.size() >= 2
+            && static_cast< unsigned char >( content[ 0 ] ) == 0x1f
+            && static_cast< unsigned char >( content[ 1 ] ) == 0x8b;
+    }
+
+}
+
+
+    SectionIndex::SectionIndex(const std::string& dataFile) {
+        boost::system::error_code ec;
+        const auto root = boost::filesystem::canonical( dataFile, ec );
+        if( ec )
+            throw std::invalid_argument( "Could not open file: " + dataFile );
+
+        this->m_rootPath = root.parent_path().string();
+        std::set< std::string > active;
+        this->scan( root.string(), active );
+    }
+
+
+    /*
+      The INCLUDE and PATHS records are read as in the Parser: include
+      paths are relative to the directory of the DATA file, and a $ALIAS
+      is replaced with its PATHS value.
+    */
+    void SectionIndex::scan(const std::string& file, std::set< std::string >& active) {
+        if( this->m_end || active.count( file ) > 0 )
+            return;
+
+        std::ifstream stream( file, std::ios::binary );
+        if( !stream )
+            return;
+
+        const std::string content( ( std::istreambuf_iterator< char >( stream ) ),
+                                   std::istreambuf_iterator< char >() );
+        if( is_gzip( content ) )
+            return;
+
+        active.insert( file );
+        this->m_files.push_back( file );
+        auto& keywords = this->m_keywords[ file ];
+
+        enum class State { Keyword, Include, Paths };
+        auto state = State::Keyword;
+
+        const char* begin = content.data();
+        const char* end = begin + content.size();
+        std::size_t line_nr = 0;
+        for( const char* pos = begin; pos < end && !this->m_end; ) {
+            const char* eol = static_cast< const char* >( std::memchr( pos, '\n', end - pos ) );
+            if( !eol )
+                eol = end;
+
+            const std::size_t offset = pos - begin;
+            const auto line = strip( pos, eol );
+            pos = eol + 1;
+            line_nr++;
+
+            if( line.empty() )
+                continue;
+
+            if( state == State::Include ) {
+                state = State::Keyword;
+                const auto record = tokens( line );
+                if( record.empty() )
+                    continue;
+
+                auto path = record[ 0 ];
+                const auto dollar = path.find( '$' );
+                if( dollar != std::string::npos ) {
+                    const auto stop = path.find_first_not_of( "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", dollar + 1 );
+                    const auto alias = path.substr( dollar + 1, stop == std::string::npos ? std::string::npos : stop - dollar - 1 );
+                    const auto value = this->m_pathMap.find( alias );
+                    if( value != this->m_pathMap.end() )
+                        boost::replace_all( path, "$" + alias, value->second );
+                }
+                std::replace( path.begin(), path.end(), '\\', '/' );
+
+                boost::filesystem::path include( path );
+                if( include.is_relative() )
+                    include = boost::filesystem::path( this->m_rootPath ) / include;
+
+                boost::system::error_code ec;
+                const auto canonical = boost::filesystem::canonical( include, ec );
+                if( ec )
+                    continue;
+
+                this->scan( canonical.string(), active );
+                const auto nested = this->m_keywords.find( canonical.string() );
+                if( nested != this->m_keywords.end() )
+                    keywords.insert( nested->second.begin(), nested->second.end() );
+
+                continue;
+            }
+
+            if( state == State::Paths ) {
+                const auto record = tokens( line );
+                if( record.empty() )
+                    state = State::Keyword;
+                else if( record.size() >= 2 )
+                    this->m_pathMap.emplace( record[ 0 ], record[ 1 ] );
+
+                continue;
+            }
+
+            if( line.size() > RawConsts::maxKeywordLength )
+                continue;
+
+            const auto name = boost::algorithm::to_upper_copy( line );
+            if( !ParserKeyword::validDeckName( name ) )
+                continue;
+
+            keywords.insert( name );
+            if( Section::isSectionName( name ) )
+                this->m_entries.push_back( { name, file, offset, line_nr } );
+            else if( name == RawConsts::include )
+                state = State::Include;
+            else if( name == RawConsts::paths )
+                state = State::Paths;
+            else if( name == RawConsts::endinclude )
+                break;
+            else if( name == RawConsts::end )
+                this->m_end = true;
+        }
+
+        active.erase( file );
+    }
+
+
+    const std::vector< SectionIndex::Entry >& SectionIndex::entries() const {
+        return this->m_entries;
+    }
+
+
+    std::vector< SectionIndex::Entry > SectionIndex::find(const std::string& section) const {
+        std::vector< Entry > result;
+        std::copy_if( this->m_entries.begin(), this->m_entries.end(), std::back_inserter( result ),
+                      [&section]( const Entry& entry ) { return entry.section == section; } );
+        return result;
+    }
+
+
+    const std::vector< std::string >& SectionIndex::files() const {
+        return this->m_files;
+    }
+
+
+    bool SectionIndex::contains(const std::string& file, const std::set< std::string >& keywords) const {
+        const auto pos = this->m_keywords.find( file );
+        if( pos == this->m_keywords.end() )
+            return true;
+
+        return std::any_of( keywords.begin(), keywords.end(),
+                            [&pos]( const std::string& keyword ) { return pos->second.count( keyword ) > 0; } );
+    }
+
+} // namespace Opm
@@ -47,6 +47,7 @@ namespace Opm {
         } else {
             m_sizeType = Raw::FIXED;
             m_fixedSize = inputSize;
+            m_records.reserve( m_fixedSize );
             if (m_fixedSize == 0)
                 m_isFinished = true;
             else
@@ -21,7 +21,6 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
-#include <deque>
 
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
@@ -35,13 +34,12 @@ namespace Opm {
 
 namespace {
 
-std::deque< string_view > splitSingleRecordString( const string_view& record ) {
+void splitSingleRecordString( const string_view& record, std::vector< string_view >& dst ) {
     auto first_nonspace = []( string_view::const_iterator begin,
                               string_view::const_iterator end ) {
         return std::find_if_not( begin, end, RawConsts::is_separator() );
     };
 
-    std::deque< string_view > dst;
     auto current = record.begin();
     while( (current = first_nonspace( current, record.end() )) != record.end() )
     {
@@ -55,8 +53,6 @@ std::deque< string_view > splitSingleRecordString( const string_view& record ) {
             current = token_end;
         }
     }
-
-    return dst;
 }
 
 /*
@@ -76,13 +72,18 @@ inline bool even_quotes( const T& str ) {
 
 }
 
+    static const std::string emptystr = "";
+
+    RawRecord::RawRecord(const string_view& singleRecordString) :
+        RawRecord(singleRecordString, emptystr, emptystr)
+    {}
+
     RawRecord::RawRecord(const string_view& singleRecordString,
                          const std::string& fileName,
                          const std::string& keywordName) :
         m_sanitizedRecordString( singleRecordString ),
-        m_recordItems( splitSingleRecordString( m_sanitizedRecordString ) ),
-        m_fileName(fileName),
-        m_keywordName(keywordName)
+        m_fileName(&fileName),
+        m_keywordName(&keywordName)
     {
 
         if( !even_quotes( singleRecordString ) )
@@ -93,22 +94,43 @@ inline bool even_quotes( const T& str ) {
     }
 
     const std::string& RawRecord::getFileName() const {
-        return m_fileName;
+        return *m_fileName;
     }
 
     const std::string& RawRecord::getKeywordName() const {
-        return m_keywordName;
+        return *m_keywordName;
+    }
+
+    void RawRecord::splitRecordString() const {
+        splitSingleRecordString( this->m_sanitizedRecordString, this->m_recordItems );
+        this->m_tokenized = true;
+    }
+
+    void RawRecord::clear() {
+        this->m_recordItems.clear();
+        this->m_front = 0;
+        this->m_tokenized = true;
     }
 
     void RawRecord::prepend( size_t count, string_view tok ) {
-        this->m_recordItems.insert( this->m_recordItems.begin(), count, tok );
+        this->tokenize();
+        /*
+         * The repeated value usually replaces the token just consumed, and
+         * the slots of the consumed tokens are reused before inserting.
+         */
+        if( count <= this->m_front ) {
+            this->m_front -= count;
+            std::fill_n( this->m_recordItems.begin() + this->m_front, count, tok );
+        } else
+            this->m_recordItems.insert( this->m_recordItems.begin() + this->m_front, count, tok );
     }
 
     void RawRecord::dump() const {
+        this->tokenize();
         std::cout << "RecordDump: ";
-        for (size_t i = 0; i < m_recordItems.size(); i++) {
+        for (size_t i = 0; i < this->size(); i++) {
             std::cout
-                << this->m_recordItems[i] << "/"
+                << this->m_recordItems[this->m_front + i] << "/"
                 << getItem( i ) << " ";
         }
         std::cout << std::endl;
@@ -19,19 +19,47 @@
 
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <cmath>
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The arrays of the large grid keywords are converted in blocks,
+      in parallel when OpenMP is enabled.
+    */
+    const std::size_t parallel_block_size = 1 << 16;
+
+    template< typename F >
+    void for_each_block( std::size_t size, F op ) {
+        if (size < 2 * parallel_block_size) {
+            op( 0, size );
+            return;
+        }
+
+        const long num_blocks = (size + parallel_block_size - 1) / parallel_block_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long block = 0; block < num_blocks; ++block) {
+            const std::size_t begin = block * parallel_block_size;
+            op( begin, std::min( size, begin + parallel_block_size ) );
+        }
+    }
+
+}
+
     Dimension::Dimension(const std::string& name, double SIfactor, double SIoffset)
     {
         for (auto iter = name.begin(); iter != name.end(); ++iter) {
             if (!isalpha(*iter) && (*iter) != '1')
                 throw std::invalid_argument("Invalid dimension name");
         }
-        m_name = name;
+        m_name = Symbol( name );
         m_SIfactor = SIfactor;
         m_SIoffset = SIoffset;
     }
@@ -63,17 +91,49 @@ namespace Opm {
         return (siValue - m_SIoffset)/m_SIfactor;
     }
 
+    void Dimension::convertRawToSi(const double* rawValues, double* siValues, std::size_t size) const {
+        if (!std::isfinite(m_SIfactor))
+            throw std::logic_error("The DeckItem contains a field with a context dependent unit. "
+                                   "Use getData< double >() and convert the returned value manually!");
+
+        const double factor = m_SIfactor;
+        const double offset = m_SIoffset;
+        for_each_block( size, [=]( std::size_t begin, std::size_t end ) {
+            for (std::size_t index = begin; index < end; index++)
+                siValues[index] = rawValues[index]*factor + offset;
+        });
+    }
+
+    void Dimension::convertSiToRaw(const double* siValues, double* rawValues, std::size_t size) const {
+        if (!std::isfinite(m_SIfactor))
+            throw std::logic_error("The DeckItem contains a field with a context dependent unit. "
+                                   "Use getData< double >() and convert the returned value manually!");
+
+        const double factor = m_SIfactor;
+        const double offset = m_SIoffset;
+        for_each_block( size, [=]( std::size_t begin, std::size_t end ) {
+            for (std::size_t index = begin; index < end; index++)
+                rawValues[index] = (siValues[index] - offset)/factor;
+        });
+    }
+
     const std::string& Dimension::getName() const {
-        return m_name;
+        return m_name.str();
     }
 
     // only dimensions with zero offset are compositable...
     bool Dimension::isCompositable() const
     { return m_SIoffset == 0.0; }
 
+    bool Dimension::isIdentity() const
+    { return m_SIfactor == 1.0 && m_SIoffset == 0.0; }
+
+    bool Dimension::isConvertible() const
+    { return std::isfinite(m_SIfactor); }
+
     Dimension Dimension::newComposite(const std::string& dim , double SIfactor, double SIoffset) {
         Dimension dimension;
-        dimension.m_name = dim;
+        dimension.m_name = Symbol( dim );
         dimension.m_SIfactor = SIfactor;
         dimension.m_SIoffset = SIoffset;
         return dimension;
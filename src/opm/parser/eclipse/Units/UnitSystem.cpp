@@ -943,19 +943,41 @@ namespace {
             + this->measure_table_to_si_offset[ static_cast< int >( m ) ];
     }
 
+    double UnitSystem::from_si_factor( measure m ) const {
+        return this->measure_table_from_si[ static_cast< int >( m ) ];
+    }
+
+    double UnitSystem::to_si_offset( measure m ) const {
+        return this->measure_table_to_si_offset[ static_cast< int >( m ) ];
+    }
+
     void UnitSystem::from_si( measure m, std::vector<double>& data ) const {
-        double factor = this->measure_table_from_si[ static_cast< int >( m ) ];
-        double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return (x - offset) * factor; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->from_si( m, data.data(), data.data(), data.size() );
     }
 
 
     void UnitSystem::to_si( measure m, std::vector<double>& data) const {
-        double factor = this->measure_table_to_si[ static_cast< int >( m ) ];
-        double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return x * factor + offset; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->to_si( m, data.data(), data.data(), data.size() );
+    }
+
+
+    /*
+      Plain loops over raw arrays, with the conversion factors in locals,
+      so the compiler can vectorize them.
+    */
+    void UnitSystem::from_si( measure m, const double* input, double* output, std::size_t size ) const {
+        const double factor = this->measure_table_from_si[ static_cast< int >( m ) ];
+        const double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
+        for( std::size_t index = 0; index < size; index++ )
+            output[ index ] = factor * (input[ index ] - offset);
+    }
+
+
+    void UnitSystem::to_si( measure m, const double* input, double* output, std::size_t size ) const {
+        const double factor = this->measure_table_to_si[ static_cast< int >( m ) ];
+        const double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
+        for( std::size_t index = 0; index < size; index++ )
+            output[ index ] = factor * input[ index ] + offset;
     }
 
 
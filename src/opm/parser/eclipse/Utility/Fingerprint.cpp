@@ -0,0 +1,157 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <tuple>
+
+#include <opm/parser/eclipse/Utility/Fingerprint.hpp>
+
+namespace Opm {
+
+namespace {
+
+    std::uint64_t rotl( std::uint64_t x, int r ) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    std::uint64_t fmix( std::uint64_t k ) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    const std::uint64_t c1 = 0x87c37b91114253d5ULL;
+    const std::uint64_t c2 = 0x4cf5ad432745937fULL;
+
+}
+
+    /*
+      Every word is mixed as a MurmurHash3 block of the word and its
+      position, so the value depends on the order of the words.
+    */
+    void Fingerprint::mix( std::uint64_t k1 ) {
+        std::uint64_t k2 = ++this->m_words;
+
+        k1 *= c1; k1 = rotl( k1, 31 ); k1 *= c2; this->m_h1 ^= k1;
+        this->m_h1 = rotl( this->m_h1, 27 ); this->m_h1 += this->m_h2;
+        this->m_h1 = this->m_h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl( k2, 33 ); k2 *= c1; this->m_h2 ^= k2;
+        this->m_h2 = rotl( this->m_h2, 31 ); this->m_h2 += this->m_h1;
+        this->m_h2 = this->m_h2 * 5 + 0x38495ab5;
+    }
+
+    void Fingerprint::finish( std::uint64_t& h1, std::uint64_t& h2 ) const {
+        h1 = this->m_h1 ^ this->m_words;
+        h2 = this->m_h2 ^ this->m_words;
+
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix( h1 );
+        h2 = fmix( h2 );
+        h1 += h2;
+        h2 += h1;
+    }
+
+    Fingerprint& Fingerprint::add( double value ) {
+        if( value == 0 )
+            value = 0;
+        else if( std::isnan( value ) )
+            value = std::numeric_limits< double >::quiet_NaN();
+
+        std::uint64_t word;
+        std::memcpy( &word, &value, sizeof word );
+        this->mix( word );
+        return *this;
+    }
+
+    Fingerprint& Fingerprint::add( const char* data, std::size_t size ) {
+        this->mix( size );
+        for( std::size_t offset = 0; offset < size; offset += 8 ) {
+            std::uint64_t word = 0;
+            const std::size_t count = std::min< std::size_t >( 8, size - offset );
+            for( std::size_t i = 0; i < count; i++ )
+                word |= std::uint64_t( static_cast< unsigned char >( data[ offset + i ] ) ) << (8 * i);
+
+            this->mix( word );
+        }
+        return *this;
+    }
+
+    Fingerprint& Fingerprint::add( const std::string& value ) {
+        return this->add( value.data(), value.size() );
+    }
+
+    Fingerprint& Fingerprint::add( const Fingerprint& other ) {
+        std::uint64_t h1, h2;
+        other.finish( h1, h2 );
+        this->mix( h1 );
+        this->mix( h2 );
+        return *this;
+    }
+
+    std::uint64_t Fingerprint::high() const {
+        std::uint64_t h1, h2;
+        this->finish( h1, h2 );
+        return h1;
+    }
+
+    std::uint64_t Fingerprint::low() const {
+        std::uint64_t h1, h2;
+        this->finish( h1, h2 );
+        return h2;
+    }
+
+    std::string Fingerprint::hex() const {
+        static const char digits[] = "0123456789abcdef";
+
+        std::uint64_t h1, h2;
+        this->finish( h1, h2 );
+
+        std::string result( 32, '0' );
+        for( int i = 0; i < 16; i++ ) {
+            result[ 15 - i ] = digits[ (h1 >> (4 * i)) & 0xf ];
+            result[ 31 - i ] = digits[ (h2 >> (4 * i)) & 0xf ];
+        }
+        return result;
+    }
+
+    bool Fingerprint::operator==( const Fingerprint& rhs ) const {
+        return this->m_h1 == rhs.m_h1
+            && this->m_h2 == rhs.m_h2
+            && this->m_words == rhs.m_words;
+    }
+
+    bool Fingerprint::operator!=( const Fingerprint& rhs ) const {
+        return !( *this == rhs );
+    }
+
+    bool Fingerprint::operator<( const Fingerprint& rhs ) const {
+        std::uint64_t h1, h2, rhs_h1, rhs_h2;
+        this->finish( h1, h2 );
+        rhs.finish( rhs_h1, rhs_h2 );
+        return std::tie( h1, h2 ) < std::tie( rhs_h1, rhs_h2 );
+    }
+}
@@ -0,0 +1,51 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <mutex>
+#include <unordered_set>
+
+#include <opm/parser/eclipse/Utility/Symbol.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      The table is deliberately leaked, so that decks held in static
+      objects can still use their symbols during static destruction.
+    */
+    const std::string* intern( const std::string& str ) {
+        static std::mutex* lock = new std::mutex();
+        static std::unordered_set< std::string >* table = new std::unordered_set< std::string >();
+
+        std::lock_guard< std::mutex > guard( *lock );
+        return &*table->insert( str ).first;
+    }
+
+}
+
+    Symbol::Symbol() {
+        static const std::string* empty = intern( "" );
+        this->m_str = empty;
+    }
+
+    Symbol::Symbol( const std::string& str ) :
+        m_str( intern( str ) )
+    {}
+}
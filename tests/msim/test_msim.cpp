@@ -102,3 +102,32 @@ BOOST_AUTO_TEST_CASE(RUN) {
         test_work_area_free( work_area );
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(RUN_BATCHED) {
+    msim msim("SPE1CASE1.DATA");
+    msim.well_rate(std::vector<std::string>{"PROD"}, data::Rates::opt::oil,
+                   [](const EclipseState& es, const Schedule&, const data::Solution&, size_t, double seconds_elapsed, double* rates) {
+                       rates[0] = -es.getUnits().to_si(UnitSystem::measure::rate, seconds_elapsed);
+                   });
+    msim.solution("PRESSURE", UnitSystem::measure::pressure,
+                  [](const EclipseState& es, const Schedule&, size_t, double seconds_elapsed, std::vector<double>& values) {
+                      std::fill(values.begin(), values.end(), es.getUnits().to_si(UnitSystem::measure::pressure, seconds_elapsed));
+                  });
+    {
+        test_work_area_type * work_area = test_work_area_alloc("test_msim_batched");
+        msim.run();
+
+        ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case("SPE1CASE1", ":");
+        int param_index = ecl_sum_get_general_var_params_index(ecl_sum, "WOPR:PROD");
+        BOOST_CHECK( ecl_sum_get_data_length(ecl_sum) > 0 );
+        for (int time_index=0; time_index < ecl_sum_get_data_length(ecl_sum); time_index++) {
+            double seconds_elapsed = ecl_sum_iget_sim_days(ecl_sum, time_index) * 86400;
+            double opr = ecl_sum_iget(ecl_sum, time_index, param_index);
+            BOOST_CHECK_CLOSE(seconds_elapsed, opr, 1e-3);
+        }
+        ecl_sum_free( ecl_sum );
+
+        test_work_area_free( work_area );
+    }
+}
@@ -194,6 +194,59 @@ BOOST_AUTO_TEST_CASE(TestActions) {
 
 
 
+BOOST_AUTO_TEST_CASE(TestActionsQueue) {
+    Opm::SummaryState st;
+    Opm::ActionContext context(st);
+    Opm::Actions config;
+    const auto day = 86400;
+    const auto start = util_make_date_utc(1, 1, 2000);
+
+    config.add(Opm::ActionX("LATE", 2, 0, start + 10 * day));
+    config.add(Opm::ActionX("EARLY", 1, 0, start));
+    config.add(Opm::ActionX("WAIT", 10, 2 * day, start + day));
+
+    BOOST_CHECK(config.ready(start));
+    BOOST_CHECK(!config.ready(start - day));
+    BOOST_CHECK(config.pending(start - day).empty());
+
+    {
+        auto pending = config.pending(start + day);
+        BOOST_CHECK_EQUAL(pending.size(), 2);
+        BOOST_CHECK_EQUAL(pending[0]->name(), "EARLY");
+        BOOST_CHECK_EQUAL(pending[1]->name(), "WAIT");
+        for (auto& ptr : pending)
+            BOOST_CHECK(ptr->eval(start + day, context));
+    }
+
+    // EARLY is exhausted and WAIT must wait two days.
+    BOOST_CHECK_EQUAL(config.pending(start + 2 * day).size(), 0);
+    BOOST_CHECK(!config.ready(start + 3 * day));
+    BOOST_CHECK(config.ready(start + 3 * day + 1));
+    {
+        auto pending = config.pending(start + 3 * day + 1);
+        BOOST_CHECK_EQUAL(pending.size(), 1);
+        BOOST_CHECK_EQUAL(pending[0]->name(), "WAIT");
+    }
+
+    // Not evaluated - still pending.
+    BOOST_CHECK_EQUAL(config.pending(start + 10 * day).size(), 2);
+
+    // An action evaluated through at() is moved in the queue.
+    BOOST_CHECK(config.at("LATE").eval(start + 10 * day, context));
+    BOOST_CHECK(config.at("LATE").eval(start + 10 * day, context));
+    {
+        auto pending = config.pending(start + 20 * day);
+        BOOST_CHECK_EQUAL(pending.size(), 1);
+        BOOST_CHECK_EQUAL(pending[0]->name(), "WAIT");
+    }
+
+    // Adding an action again replaces it.
+    config.add(Opm::ActionX("EARLY", 1, 0, start));
+    BOOST_CHECK_EQUAL(config.pending(start).size(), 1);
+}
+
+
+
 BOOST_AUTO_TEST_CASE(TestContext) {
     Opm::SummaryState st;
     Opm::ActionContext context(st);
@@ -475,3 +528,144 @@ BOOST_AUTO_TEST_CASE(ActionContextTest) {
     BOOST_CHECK_EQUAL(context.get("WWCT", "OP1"), 200);
     BOOST_REQUIRE_THROW(context.get("WGOR", "B37"), std::out_of_range);
 }
+
+
+BOOST_AUTO_TEST_CASE(WELL_PATTERN) {
+    ActionAST ast({"WWCT", "OP*", ">", "0.50", "AND", "WWCT", "OP*", "<", "0.90"});
+    SummaryState st;
+    st.add_well_var("OP1", "WWCT", 0.25);
+    st.add_well_var("OP2", "WWCT", 0.75);
+    st.add_well_var("WI1", "WWCT", 0.95);
+    ActionContext context(st);
+
+    BOOST_CHECK(ast.eval(context));
+
+    context.add("WWCT", "OP2", 0.10);
+    BOOST_CHECK(!ast.eval(context));
+
+    context.add("WWCT", "OP3", 0.60);
+    BOOST_CHECK(ast.eval(context));
+
+    ActionAST no_match({"WWCT", "XX*", ">", "0.0"});
+    BOOST_CHECK(!no_match.eval(context));
+}
+
+
+BOOST_AUTO_TEST_CASE(KEY_ASSIGNED_LATER) {
+    ActionAST ast({"WWCT", "OPX", ">", "0.50"});
+    ActionAST pattern({"WWCT", "OP*", ">", "0.50"});
+    SummaryState st;
+    st.add_well_var("OPY", "WWCT", 0.25);
+    st.index("WWCT:OPX");
+
+    {
+        ActionContext context(st);
+        BOOST_CHECK_THROW(ast.eval(context), std::out_of_range);
+        BOOST_CHECK(!pattern.eval(context));
+
+        /* Contexts of the same summary state share the resolved keys. */
+        BOOST_CHECK(ActionContext(st).layout() == context.layout());
+        BOOST_CHECK(ActionContext(SummaryState(st)).layout() == context.layout());
+    }
+
+    st.add("WWCT:OPX", 0.75);
+    {
+        ActionContext context(st);
+        BOOST_CHECK(ast.eval(context));
+        BOOST_CHECK(pattern.eval(context));
+    }
+
+    st.clear();
+    st.add("WWCT:OPY", 0.75);
+    {
+        ActionContext context(st);
+        BOOST_CHECK_THROW(ast.eval(context), std::out_of_range);
+        BOOST_CHECK(pattern.eval(context));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ApplyAction) {
+    const auto deck_string = std::string{ R"(
+SCHEDULE
+
+WELSPECS
+  'W2'  'OP'  1 1 3.33  'OIL' 7*/
+/
+
+TSTEP
+   10 10 10 /
+)"};
+
+    const auto action_string = std::string{ R"(
+WELSPECS
+  'W1'  'OP2'  2 2 3.33  'OIL' 7*/
+/
+
+WELOPEN
+  'W*'  'SHUT' /
+/
+)"};
+    Opm::Parser parser;
+    auto deck = parser.parseString(deck_string, Opm::ParseContext());
+    auto action_deck = parser.parseString(action_string, Opm::ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule sched(deck, grid, eclipseProperties, runspec, ParseContext());
+
+    ActionX action("ACTION", 1, 0, 0);
+    for (const auto& keyword : action_deck)
+        action.addKeyword(keyword);
+
+    BOOST_CHECK_EQUAL(sched.getWells(2).size(), 1);
+    const auto status1 = sched.getWell("W2")->getStatus(1);
+
+    const auto result = sched.applyAction(2, action);
+    BOOST_CHECK(result.wells == std::vector<std::string>({"W1", "W2"}));
+    BOOST_CHECK(result.groups == std::vector<std::string>({"OP2"}));
+
+    BOOST_CHECK(sched.hasWell("W1"));
+    BOOST_CHECK(sched.hasGroup("OP2"));
+    BOOST_CHECK_EQUAL(sched.getWells(1).size(), 1);
+    BOOST_CHECK_EQUAL(sched.getWells(2).size(), 2);
+    BOOST_CHECK_EQUAL(sched.getWells(3).size(), 2);
+    BOOST_CHECK_EQUAL(sched.getWell("W1")->getHeadI(), 1);
+
+    const auto* w2 = sched.getWell("W2");
+    BOOST_CHECK(w2->getStatus(1) == status1);
+    BOOST_CHECK(w2->getStatus(2) == WellCommon::SHUT);
+    BOOST_CHECK(w2->getStatus(3) == WellCommon::SHUT);
+}
+
+
+BOOST_AUTO_TEST_CASE(SummaryStateBufferSnapshots) {
+    SummaryStateBuffer buffer;
+    BOOST_CHECK_EQUAL(buffer.snapshot()->size(), 0);
+
+    buffer.back().add_well_var("OP1", "WOPR", 100);
+    buffer.publish();
+    auto st1 = buffer.snapshot();
+    BOOST_CHECK_EQUAL(st1->get_well_var("OP1", "WOPR"), 100);
+    BOOST_CHECK_EQUAL(buffer.back().get_well_var("OP1", "WOPR"), 100);
+
+    buffer.back().add_well_var("OP1", "WOPR", 200);
+    buffer.back().add("FOPR", 5);
+    buffer.publish();
+    BOOST_CHECK_EQUAL(st1->get_well_var("OP1", "WOPR"), 100);
+    BOOST_CHECK(!st1->has("FOPR"));
+    BOOST_CHECK(&buffer.back() != st1.get());
+
+    auto st2 = buffer.snapshot();
+    BOOST_CHECK_EQUAL(st2->get_well_var("OP1", "WOPR"), 200);
+    BOOST_CHECK_EQUAL(st2->get("FOPR"), 5);
+
+    st1.reset();
+    buffer.back().add("FOPR", 6);
+    buffer.publish();
+    BOOST_CHECK_EQUAL(st2->get("FOPR"), 5);
+    BOOST_CHECK_EQUAL(buffer.snapshot()->get("FOPR"), 6);
+    BOOST_CHECK_EQUAL(buffer.back().get("FOPR"), 6);
+    BOOST_CHECK_EQUAL(buffer.back().get_well_var("OP1", "WOPR"), 200);
+}
@@ -22,6 +22,7 @@ along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 #include <boost/test/unit_test.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/EclipseState/Aquancon.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 
 using namespace Opm;
 
@@ -95,3 +96,24 @@ BOOST_AUTO_TEST_CASE(AquanconTest){
                                    expected_output.at(i).record_index.begin(), expected_output.at(i).record_index.end() );
     }
 }    
+
+BOOST_AUTO_TEST_CASE(AquanconDuplicateCells){
+    const auto aquifers = init_aquancon();
+    BOOST_CHECK_EQUAL(aquifers.size(), 1U);
+
+    const auto& aquifer = aquifers[0];
+    const std::vector<size_t> expected_index = { 0, 4, 5, 7, 8, 18, 19, 20, 21, 22, 23, 24, 25, 26 };
+    const std::vector<int> expected_record = { 0, 4, 4, 4, 4, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( aquifer.global_index.begin(), aquifer.global_index.end(),
+                                   expected_index.begin(), expected_index.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( aquifer.record_index.begin(), aquifer.record_index.end(),
+                                   expected_record.begin(), expected_record.end() );
+
+    // The cells of the top layer are in three records, and the influx
+    // coefficients are added.
+    BOOST_CHECK_CLOSE( *aquifer.influx_coeff[0], 1.0, 1e-12 );
+    BOOST_CHECK_CLOSE( *aquifer.influx_coeff[1], 2.75, 1e-12 );
+    BOOST_CHECK_CLOSE( *aquifer.influx_coeff[5], 4.0, 1e-12 );
+    BOOST_CHECK( aquifer.influx_coeff[5] != aquifer.influx_coeff[6] );
+    BOOST_CHECK_EQUAL( aquifer.reservoir_face_dir[5], FaceDir::XPlus );
+}
@@ -101,6 +101,48 @@ BOOST_AUTO_TEST_CASE(CreateSubBox) {
 }
 
 
+BOOST_AUTO_TEST_CASE(BoxRanges) {
+    Opm::Box globalBox( 10,10,10 );
+    BOOST_CHECK_EQUAL( 1U , globalBox.numRanges() );
+    BOOST_CHECK_EQUAL( 1000U , globalBox.rangeSize() );
+    BOOST_CHECK_EQUAL( 0U , globalBox.rangeBegin(0) );
+
+    Opm::Box rowBox( globalBox , 1,3,1,4,1,5);
+    BOOST_CHECK_EQUAL( 20U , rowBox.numRanges() );
+    BOOST_CHECK_EQUAL( 3U , rowBox.rangeSize() );
+    BOOST_CHECK_EQUAL( 111U , rowBox.rangeBegin(0) );
+    BOOST_CHECK_EQUAL( 121U , rowBox.rangeBegin(1) );
+    BOOST_CHECK_EQUAL( 211U , rowBox.rangeBegin(4) );
+
+    Opm::Box layerBox( globalBox , 0,9,2,4,1,5);
+    BOOST_CHECK_EQUAL( 5U , layerBox.numRanges() );
+    BOOST_CHECK_EQUAL( 30U , layerBox.rangeSize() );
+    BOOST_CHECK_EQUAL( 120U , layerBox.rangeBegin(0) );
+    BOOST_CHECK_EQUAL( 220U , layerBox.rangeBegin(1) );
+
+    Opm::Box slabBox( globalBox , 0,9,0,9,3,4);
+    BOOST_CHECK_EQUAL( 1U , slabBox.numRanges() );
+    BOOST_CHECK_EQUAL( 200U , slabBox.rangeSize() );
+    BOOST_CHECK_EQUAL( 300U , slabBox.rangeBegin(0) );
+
+    for (const auto& box : { rowBox , layerBox , slabBox }) {
+        std::vector<size_t> cells;
+        for (size_t range = 0; range < box.numRanges(); range++)
+            for (size_t offset = 0; offset < box.rangeSize(); offset++)
+                cells.push_back( box.rangeBegin(range) + offset );
+
+        const auto indexList = box.getIndexList();
+        BOOST_CHECK_EQUAL( box.size() , indexList.size() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( cells.begin() , cells.end() , indexList.begin() , indexList.end() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( cells.begin() , cells.end() , box.begin() , box.end() );
+    }
+
+    Opm::Box emptyBox;
+    BOOST_CHECK_EQUAL( 0U , emptyBox.numRanges() );
+    BOOST_CHECK( emptyBox.begin() == emptyBox.end() );
+}
+
+
 BOOST_AUTO_TEST_CASE(BoxEqual) {
     Opm::Box globalBox1( 10,10,10 );
     Opm::Box globalBox2( 10,10,10 );
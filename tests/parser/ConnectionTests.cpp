@@ -121,6 +121,33 @@ BOOST_AUTO_TEST_CASE(AddCompletionCopy) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ConnectionColumns) {
+    Opm::WellConnections connections;
+    Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::Z;
+
+    connections.add( Opm::Connection( 1,2,3, 1, 1000.0, Opm::WellCompletion::OPEN , 10.0, 100.0, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+    connections.add( Opm::Connection( 1,2,4, 2, 1010.0, Opm::WellCompletion::SHUT , 20.0, 200.0, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+
+    const auto& columns = connections.columns();
+    BOOST_CHECK_EQUAL( columns.k.size(), 2U );
+    BOOST_CHECK_EQUAL( columns.i[1], 1 );
+    BOOST_CHECK_EQUAL( columns.k[1], 4 );
+    BOOST_CHECK_EQUAL( columns.complnum[1], 2 );
+    BOOST_CHECK_EQUAL( columns.CF[0], 10.0 );
+    BOOST_CHECK_EQUAL( columns.Kh[1], 200.0 );
+    BOOST_CHECK_EQUAL( columns.depth[1], 1010.0 );
+    BOOST_CHECK( columns.state[1] == Opm::WellCompletion::SHUT );
+    BOOST_CHECK( &connections.columns() == &columns );
+
+    auto copy = connections;
+    BOOST_CHECK( &copy.columns() == &columns );
+
+    copy.get(0).setState( Opm::WellCompletion::SHUT );
+    BOOST_CHECK( copy.columns().state[0] == Opm::WellCompletion::SHUT );
+    BOOST_CHECK( connections.columns().state[0] == Opm::WellCompletion::OPEN );
+}
+
+
 BOOST_AUTO_TEST_CASE(ActiveCompletions) {
     Opm::EclipseGrid grid(10,20,20);
     Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::Z;
@@ -143,6 +170,31 @@ BOOST_AUTO_TEST_CASE(ActiveCompletions) {
     BOOST_CHECK_EQUAL( completion3, active_completions.get(1));
 }
 
+BOOST_AUTO_TEST_CASE(OrderLongLateral) {
+    Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::X;
+    Opm::WellConnections connections(0, 0);
+
+    // A vertical section down to k = 9 in (0,0) followed by a lateral
+    // along i, added in scrambled order.
+    const int lateral = 5000;
+    for (int n = 0; n < lateral; n++) {
+        int i = 1 + (n * 7919) % lateral;
+        connections.add( Opm::Connection( i,0,9, 1, 1009.0, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+    }
+    for (int k = 9; k >= 0; k--)
+        connections.add( Opm::Connection( 0,0,k, 1, 1000.0 + k, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+
+    connections.orderConnections(0, 0);
+    BOOST_CHECK_EQUAL( connections.size() , lateral + 10U );
+    for (int k = 0; k < 10; k++) {
+        BOOST_CHECK_EQUAL( connections.get(k).getI() , 0 );
+        BOOST_CHECK_EQUAL( connections.get(k).getK() , k );
+    }
+    for (int n = 0; n < lateral; n++)
+        BOOST_CHECK_EQUAL( connections.get(10 + n).getI() , n + 1 );
+}
+
+
 Opm::WellConnections loadCOMPDAT(const std::string& compdat_keyword) {
     Opm::EclipseGrid grid(10,10,10);
     Opm::TableManager tables;
@@ -158,6 +210,52 @@ Opm::WellConnections loadCOMPDAT(const std::string& compdat_keyword) {
     return connections;
 }
 
+BOOST_AUTO_TEST_CASE(CopyOnWrite) {
+    Opm::WellConnections connections;
+    Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::Z;
+    connections.add( Opm::Connection( 1,1,1, 1, 0.0, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+    connections.add( Opm::Connection( 1,1,2, 2, 0.0, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+
+    Opm::WellConnections copy( 5, 5, connections );
+    BOOST_CHECK( &copy[0] == &connections[0] );
+
+    copy.get(1).setState( Opm::WellCompletion::SHUT );
+    BOOST_CHECK( &copy[0] == &connections[0] );
+    BOOST_CHECK( &copy[1] != &connections[1] );
+    BOOST_CHECK( copy[1].state() == Opm::WellCompletion::SHUT );
+    BOOST_CHECK( connections[1].state() == Opm::WellCompletion::OPEN );
+}
+
+
+BOOST_AUTO_TEST_CASE(RespecifiedConnectionsAreShared) {
+    const std::string input = R"(COMPDAT
+    'WELL'  1  1   1   2 'OPEN' 1*    1.168   0.311   107.872 1*     1*  'Z'  21.925 /
+/
+COMPDAT
+    'WELL'  1  1   2   2 'OPEN' 1*    1.168   0.311   107.872 1*     1*  'Z'  21.925 /
+    'WELL'  1  1   1   1 'SHUT' 1*    1.168   0.311   107.872 1*     1*  'Z'  21.925 /
+/)";
+    Opm::EclipseGrid grid(10,10,10);
+    Opm::TableManager tables;
+    const auto deck = Opm::Parser().parseString(input, Opm::ParseContext());
+    Opm::Eclipse3DProperties props(deck, tables, grid );
+    std::size_t totnc = 0;
+
+    Opm::WellConnections connections;
+    connections.loadCOMPDAT(deck.getKeyword("COMPDAT", 0).getRecord(0), grid, props, totnc);
+
+    Opm::WellConnections updated( connections );
+    for (const auto& rec : deck.getKeyword("COMPDAT", 1))
+        updated.loadCOMPDAT(rec, grid, props, totnc);
+
+    BOOST_CHECK_EQUAL( updated.size(), 2U );
+    BOOST_CHECK( &updated[1] == &connections[1] );
+    BOOST_CHECK( &updated[0] != &connections[0] );
+    BOOST_CHECK( updated[0].state() == Opm::WellCompletion::SHUT );
+    BOOST_CHECK_EQUAL( updated[0].CF(), connections[0].CF() );
+}
+
+
 BOOST_AUTO_TEST_CASE(loadCOMPDATTEST) {
     Opm::UnitSystem units(Opm::UnitSystem::UnitType::UNIT_TYPE_METRIC); // Unit system used in deck FIRST_SIM.DATA.
     {
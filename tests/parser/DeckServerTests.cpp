@@ -0,0 +1,89 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE DeckServerTests
+
+#include <fstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/DeckServer.hpp>
+
+#include <ert/util/test_work_area.h>
+
+using namespace Opm;
+
+namespace {
+
+/* Writes a file in the current test work area. */
+std::string write( const std::string& name, const std::string& content ) {
+    std::ofstream of( name );
+    of << content;
+    return name;
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(RepeatedRequestIsServedFromMemory) {
+    test_work_area_type * work_area = test_work_area_alloc("deck_server_hits");
+    const auto datafile = write( "CASE.DATA", "INCLUDE\n  'poro.inc' /\n" );
+    write( "poro.inc", "PORO\n 4*0.25 /\n" );
+
+    DeckServer server( 1UL << 30 );
+    const auto first = server.deck( datafile );
+    BOOST_CHECK_EQUAL( first->getInputFiles().size(), 2U );
+    BOOST_CHECK( server.deck( datafile ) == first );
+
+    const auto stats = server.statistics();
+    BOOST_CHECK_EQUAL( stats.hits, 1U );
+    BOOST_CHECK_EQUAL( stats.misses, 1U );
+    BOOST_CHECK_EQUAL( stats.decks, 1U );
+    BOOST_CHECK( stats.bytes > 0 );
+
+    /* An edited include file is parsed again. */
+    write( "poro.inc", "PORO\n 4*0.300 /\n" );
+    const auto edited = server.deck( datafile );
+    BOOST_CHECK( edited != first );
+    BOOST_CHECK_CLOSE( edited->getKeyword( "PORO" ).getRawDoubleData()[ 0 ], 0.30, 1e-12 );
+    BOOST_CHECK_EQUAL( server.statistics().decks, 1U );
+
+    test_work_area_free( work_area );
+}
+
+
+BOOST_AUTO_TEST_CASE(DecksAreEvictedOverBudget) {
+    test_work_area_type * work_area = test_work_area_alloc("deck_server_evictions");
+    const auto case1 = write( "CASE1.DATA", "PORO\n 4*0.25 /\n" );
+    const auto case2 = write( "CASE2.DATA", "PORO\n 4*0.25 /\n" );
+
+    DeckServer server( 1 );
+    const auto deck = server.deck( case1 );
+    server.deck( case2 );
+
+    const auto stats = server.statistics();
+    BOOST_CHECK_EQUAL( stats.decks, 0U );
+    BOOST_CHECK_EQUAL( stats.evictions, 2U );
+
+    /* The caller's pointer keeps an evicted deck alive. */
+    BOOST_CHECK( deck->hasKeyword( "PORO" ) );
+
+    test_work_area_free( work_area );
+}
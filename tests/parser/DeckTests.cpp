@@ -18,6 +18,7 @@
  */
 
 
+#include <limits>
 #include <stdexcept>
 #include <sstream>
 
@@ -163,6 +164,29 @@ BOOST_AUTO_TEST_CASE(keywordList_getbyindex_correctkeywordreturned) {
     BOOST_CHECK_EQUAL("TRULSX", deck.getKeyword(2).name());
 }
 
+BOOST_AUTO_TEST_CASE(keywordRange_matches_keywordList) {
+    Deck deck;
+    deck.addKeyword( DeckKeyword( "TRULS" ) );
+    deck.addKeyword( DeckKeyword( "TRULSX" ) );
+    deck.addKeyword( DeckKeyword( "TRULS" ) );
+
+    BOOST_CHECK( deck.getKeywordRange( "TRULSY" ).empty() );
+    BOOST_CHECK( deck.getKeywordRange( "TRULSY" ).begin() == deck.getKeywordRange( "TRULSY" ).end() );
+
+    const auto range = deck.getKeywordRange( "TRULS" );
+    const auto list = deck.getKeywordList( "TRULS" );
+    BOOST_CHECK_EQUAL( 2U, range.size() );
+    BOOST_CHECK_EQUAL( 2, std::distance( range.begin(), range.end() ) );
+    BOOST_CHECK_EQUAL( list[ 0 ], &range.front() );
+    BOOST_CHECK_EQUAL( list[ 1 ], &range.back() );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 2 ), &range[ 1 ] );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( "TRULS" ), &range.back() );
+
+    size_t index = 0;
+    for( const auto& keyword : range )
+        BOOST_CHECK_EQUAL( list[ index++ ], &keyword );
+}
+
 BOOST_AUTO_TEST_CASE(set_and_get_data_file) {
     Deck deck;
     BOOST_CHECK_EQUAL("", deck.getDataFile());
@@ -369,6 +393,155 @@ BOOST_AUTO_TEST_CASE(GetSIMultipleDim) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(ConvertToSILargeItem) {
+    // Large enough to be converted in several blocks.
+    const size_t size = 300000;
+    DeckItem item( "PRESSURE", double() );
+    Dimension dim{ "Pressure" , 3 , 1 };
+
+    for (size_t i = 0; i < size; i++)
+        item.push_back( double( i ) );
+    item.push_backDimension( dim , dim );
+
+    item.convertToSI();
+    const auto& si = item.getSIDoubleData();
+    BOOST_REQUIRE_EQUAL( size , si.size() );
+    for (size_t i = 0; i < size; i += 997)
+        BOOST_CHECK_EQUAL( 3.0 * i + 1 , si[i] );
+    BOOST_CHECK_EQUAL( 3.0 * (size - 1) + 1 , si.back() );
+
+    DeckItem contextItem( "CONTEXT", double() );
+    Dimension contextDim{ "ContextDependent" , std::numeric_limits< double >::quiet_NaN() };
+    contextItem.push_back( 1.0 );
+    contextItem.push_backDimension( contextDim , contextDim );
+
+    BOOST_CHECK_NO_THROW( contextItem.convertToSI() );
+    BOOST_CHECK_THROW( contextItem.getSIDoubleData() , std::logic_error );
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseData) {
+    DeckItem intItem( "INT", int() );
+    intItem.push_back( 7, 10 );
+    const auto ints = intItem.releaseData< int >();
+    BOOST_CHECK_EQUAL( 10U , ints.size() );
+    BOOST_CHECK_EQUAL( 7 , ints[9] );
+    BOOST_CHECK_EQUAL( 0U , intItem.size() );
+
+    DeckItem item( "HEI", double() );
+    Dimension dim1{ "Length" , 2 };
+    Dimension dim2{ "Length" , 4 };
+    Dimension defaultDim{ "Length" , 100 };
+
+    item.push_back( 1.0, 4 );
+    item.push_backDimension( dim1 , defaultDim );
+    item.push_backDimension( dim2 , defaultDim );
+
+    const std::vector< double > expected = { 2, 4, 2, 4 };
+    auto si = item.releaseSIDoubleData();
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), si.begin(), si.end() );
+    BOOST_CHECK_EQUAL( 0U , item.size() );
+
+    // The converted values are taken over when they are already there.
+    item.push_back( 1.0, 4 );
+    item.getSIDoubleData();
+    si = item.releaseSIDoubleData();
+    BOOST_CHECK_EQUAL( 4U , si.size() );
+    BOOST_CHECK_EQUAL( 4 , si[3] );
+    BOOST_CHECK_EQUAL( 0U , item.size() );
+
+    DeckItem noDim( "HEI", double() );
+    noDim.push_back( 1.0 );
+    BOOST_CHECK_THROW( noDim.releaseSIDoubleData() , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(RunLengthStorage) {
+    DeckItem item( "PORO", double() );
+    DeckItem dense( "PORO", double() );
+    Dimension dim{ "Length" , 2.0 };
+
+    item.push_back( 0.25, 400 );
+    item.push_back( 0.5 );
+    item.push_back( 0.5 );
+    item.push_backDefault( 0.5 );
+    item.push_back( -0.0, 100 );
+    item.push_backDimension( dim , dim );
+
+    for (size_t i = 0; i < 400; i++) dense.push_back( 0.25 );
+    for (size_t i = 0; i < 2; i++) dense.push_back( 0.5 );
+    dense.push_backDefault( 0.5 );
+    for (size_t i = 0; i < 100; i++) dense.push_back( -0.0 );
+    dense.push_backDimension( dim , dim );
+
+    const std::vector< size_t > runs = { 400, 3, 100 };
+    BOOST_CHECK( item.getRunLengths() == runs );
+    BOOST_CHECK( dense.getRunLengths().empty() );
+    BOOST_CHECK_EQUAL( 503U, item.size() );
+    BOOST_CHECK( item.defaultApplied( 402 ) );
+    BOOST_CHECK( !item.defaultApplied( 401 ) );
+
+    const auto si_runs = item.getSIRunValues();
+    BOOST_CHECK_EQUAL( 3U, si_runs.size() );
+    BOOST_CHECK_EQUAL( 1.0, si_runs[ 1 ] );
+
+    // The dense values are expanded on demand.
+    BOOST_CHECK_EQUAL( 0.5, item.get< double >( 400 ) );
+    BOOST_CHECK( item.getData< double >() == dense.getData< double >() );
+    BOOST_CHECK( item.getSIDoubleData() == dense.getSIDoubleData() );
+    BOOST_CHECK( item == dense );
+
+    std::stringstream ss1, ss2;
+    ss1 << item;
+    ss2 << dense;
+    BOOST_CHECK_EQUAL( ss1.str(), ss2.str() );
+
+    // Short runs are stored value by value.
+    DeckItem shortRuns( "SATNUM", int() );
+    shortRuns.push_back( 2, 4 );
+    BOOST_CHECK( shortRuns.getRunLengths().empty() );
+
+    // Items which stop being runs go back to storing the values one by one.
+    DeckItem mixed( "ACTNUM", int() );
+    mixed.push_back( 1, 1000 );
+    BOOST_CHECK_EQUAL( 1U, mixed.getRunLengths().size() );
+    for (int i = 0; i < 1000; i++)
+        mixed.push_back( i % 2 );
+    BOOST_CHECK( mixed.getRunLengths().empty() );
+    BOOST_CHECK_EQUAL( 2000U, mixed.size() );
+    BOOST_CHECK_EQUAL( 1, mixed.get< int >( 999 ) );
+    BOOST_CHECK_EQUAL( 1, mixed.get< int >( 1001 ) );
+
+    DeckItem actnum( "ACTNUM", int() );
+    actnum.push_back( 1, 1000000 );
+    BOOST_CHECK_EQUAL( 1U, actnum.getRunValues< int >().size() );
+    BOOST_CHECK( actnum.memory_usage() < 1000000 / 8 + 1000 );
+    const auto values = actnum.releaseData< int >();
+    BOOST_CHECK_EQUAL( 1000000U, values.size() );
+    BOOST_CHECK_EQUAL( 0U, actnum.size() );
+}
+
+BOOST_AUTO_TEST_CASE(GetSIIdentityDimensionShared) {
+    DeckItem item( "PORO", double() );
+    Dimension dim{ "1" , 1.0 };
+
+    item.push_back( 0.25, 16 );
+    item.push_backDimension( dim , dim );
+
+    const auto& raw = item.getData< double >();
+    const auto& si = item.getSIDoubleData();
+    BOOST_CHECK_EQUAL( raw.data(), si.data() );
+    BOOST_CHECK_EQUAL( 0.25, item.getSIDouble( 15 ) );
+
+    DeckItem mixed( "HEI", double() );
+    Dimension length{ "Length" , 2.0 };
+    mixed.push_back( 1.0, 4 );
+    mixed.push_backDimension( dim , dim );
+    mixed.push_backDimension( length , length );
+
+    BOOST_CHECK( mixed.getData< double >().data() != mixed.getSIDoubleData().data() );
+    BOOST_CHECK_EQUAL( 1.0, mixed.getSIDouble( 2 ) );
+    BOOST_CHECK_EQUAL( 2.0, mixed.getSIDouble( 3 ) );
+}
+
 BOOST_AUTO_TEST_CASE(HasValue) {
     DeckItem deckIntItem( "TEST", int() );
     BOOST_CHECK_EQUAL( false , deckIntItem.hasValue(0) );
@@ -655,6 +828,33 @@ BOOST_AUTO_TEST_CASE(DeckItemWriteDefault) {
 }
 
 
+BOOST_AUTO_TEST_CASE(DeckItemWriteRepeated) {
+    DeckItem item("TEST", double());
+    item.push_back(1.5);
+    item.push_back(1.5);
+    item.push_backDefault(0.0);
+    item.push_back(0.25);
+    item.push_back(0.25);
+    item.push_back(0.25);
+    item.push_back(-3.0);
+
+    {
+        std::stringstream s;
+        DeckOutput w(s);
+        item.write( w );
+        BOOST_CHECK_EQUAL( s.str() , "1.5 1.5 1* 0.25 0.25 0.25 -3");
+    }
+
+    {
+        std::stringstream s;
+        DeckOutput w(s);
+        w.compress_repeats = true;
+        item.write( w );
+        BOOST_CHECK_EQUAL( s.str() , "2*1.5 1* 3*0.25 -3");
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(DeckItemWriteString) {
     DeckItem item("TEST", std::string());
     item.push_back("NO");
@@ -720,3 +920,100 @@ BOOST_AUTO_TEST_CASE(DeckItemEqual) {
     BOOST_CHECK( item3.equal( item5 , false, true ));
     BOOST_CHECK( !item3.equal( item5 , false, false ));
 }
+
+BOOST_AUTO_TEST_CASE(NamesAreShared) {
+    const std::string name( "WELL" );
+    const std::string file( "/path/to/schedule.inc" );
+
+    DeckItem item1( name, int() );
+    DeckItem item2( "WELL", double() );
+    DeckItem item3( "WEL", double() );
+    BOOST_CHECK_EQUAL( item1.name(), "WELL" );
+    BOOST_CHECK( &item1.name() == &item2.name() );
+    BOOST_CHECK( &item1.name() != &item3.name() );
+
+    ParserItem parserItem( "WELL", ParserItem::item_size::SINGLE );
+    parserItem.setType( int() );
+    BOOST_CHECK( &parserItem.name() == &item1.name() );
+
+    DeckKeyword kw1( "WCONHIST" );
+    DeckKeyword kw2( "WCONHIST" );
+    kw1.setLocation( file, 10 );
+    kw2.setLocation( "/path/to/schedule.inc", 20 );
+    BOOST_CHECK( &kw1.name() == &kw2.name() );
+    BOOST_CHECK( &kw1.getFileName() == &kw2.getFileName() );
+    BOOST_CHECK_EQUAL( kw2.getFileName(), file );
+
+    DeckItem empty;
+    BOOST_CHECK_EQUAL( empty.name(), "" );
+}
+
+BOOST_AUTO_TEST_CASE(DeckMemoryUsage) {
+    Deck deck;
+    for (const auto& name : { "PORO", "PERMX", "PORO" }) {
+        DeckItem item( "DATA", double() );
+        for (int i = 0; i < 1000; i++)
+            item.push_back( 0.25 );
+
+        std::vector< DeckItem > items;
+        items.push_back( std::move( item ) );
+        DeckKeyword kw( name );
+        kw.addRecord( DeckRecord( std::move( items ) ) );
+        deck.addKeyword( std::move( kw ) );
+    }
+
+    const auto usage = deck.memory_usage();
+    BOOST_CHECK_EQUAL( usage.name, "Deck" );
+    BOOST_CHECK( usage.total() > 3000 * sizeof( double ) );
+
+    const auto* keywords = usage.child( "keywords" );
+    BOOST_REQUIRE( keywords != nullptr );
+    BOOST_REQUIRE_EQUAL( keywords->children.size(), 2U );
+    BOOST_CHECK_EQUAL( keywords->children[0].name, "PORO" );
+    BOOST_CHECK( keywords->children[0].bytes > keywords->children[1].bytes );
+    BOOST_CHECK( keywords->child( "PERMX" )->bytes > 1000 * sizeof( double ) );
+}
+
+BOOST_AUTO_TEST_CASE(DeckFingerprint) {
+    const auto keyword = []( const std::string& name, double value, bool runs, const std::string& file ) {
+        DeckItem item( "DATA", double() );
+        if (runs)
+            item.push_back( value, 1000 );
+        else {
+            for (int i = 0; i < 1000; i++)
+                item.push_back( value );
+        }
+
+        std::vector< DeckItem > items;
+        items.push_back( std::move( item ) );
+        DeckKeyword kw( name );
+        kw.setLocation( file, 1 );
+        kw.addRecord( DeckRecord( std::move( items ) ) );
+        return kw;
+    };
+
+    /* Runs and values stored one by one give the same fingerprint. */
+    BOOST_CHECK( keyword( "PORO", 0.25, true, "A.DATA" ).fingerprint() == keyword( "PORO", 0.25, false, "B.INC" ).fingerprint() );
+    BOOST_CHECK( keyword( "PORO", 0.25, true, "A.DATA" ).fingerprint() != keyword( "PORO", 0.20, true, "A.DATA" ).fingerprint() );
+    BOOST_CHECK( keyword( "PORO", 0.25, true, "A.DATA" ).fingerprint() != keyword( "NTG", 0.25, true, "A.DATA" ).fingerprint() );
+
+    Deck deck1;
+    deck1.addKeyword( keyword( "PORO", 0.25, true, "A.DATA" ) );
+    deck1.addKeyword( keyword( "NTG", 1.0, false, "B.INC" ) );
+
+    Deck deck2;
+    deck2.addKeyword( keyword( "PORO", 0.25, false, "A.DATA" ) );
+    deck2.addKeyword( keyword( "NTG", 0.5, false, "B.INC" ) );
+
+    BOOST_CHECK( deck1.fingerprint() != deck2.fingerprint() );
+    BOOST_CHECK( deck1.fingerprint( "A.DATA" ) == deck2.fingerprint( "A.DATA" ) );
+    BOOST_CHECK( deck1.fingerprint( "B.INC" ) != deck2.fingerprint( "B.INC" ) );
+    BOOST_CHECK( deck1.fingerprint( "C.INC" ) == Fingerprint() );
+    BOOST_CHECK( Deck( deck1 ).fingerprint() == deck1.fingerprint() );
+
+    Deck deck3;
+    deck3.addKeyword( keyword( "NTG", 1.0, false, "B.INC" ) );
+    deck3.addKeyword( keyword( "PORO", 0.25, true, "A.DATA" ) );
+    BOOST_CHECK( deck1.fingerprint() != deck3.fingerprint() );
+    BOOST_CHECK_EQUAL( deck1.fingerprint().hex().size(), 32U );
+}
@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 
@@ -304,3 +305,72 @@ BOOST_AUTO_TEST_CASE( update_equal ) {
     BOOST_CHECK_EQUAL(state[9] , 200);
     BOOST_CHECK_EQUAL(state[10], 200);
 }
+
+BOOST_AUTO_TEST_CASE( change_points ) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 1000; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    Opm::DynamicState<int> state(timeMap , 0);
+    state.update( 10, 1 );
+    state.update( 500, 2 );
+    state.update( 20, 3 );
+    state.update( 20, 3 );
+
+    BOOST_CHECK_EQUAL( state[9], 0 );
+    BOOST_CHECK_EQUAL( state[10], 1 );
+    BOOST_CHECK_EQUAL( state[19], 1 );
+    BOOST_CHECK_EQUAL( state[20], 3 );
+    BOOST_CHECK_EQUAL( state[1000], 3 );
+    BOOST_CHECK_EQUAL( state.back(), 3 );
+    BOOST_CHECK_THROW( state[1001], std::out_of_range );
+
+    /* One element per change, not per timestep. */
+    BOOST_CHECK_EQUAL( std::distance( state.begin(), state.end() ), 3 );
+}
+
+
+struct MessageBuffer {
+    std::stringstream str;
+
+    template <class T>
+    void read( T& value ) {
+        str.read( (char *) &value, sizeof(value) );
+    }
+
+    template <class T>
+    void write( const T& value ) {
+        str.write( (const char *) &value, sizeof(value) );
+    }
+};
+
+BOOST_AUTO_TEST_CASE( read_write ) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 1000; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    Opm::DynamicState<int> state(timeMap , 0);
+    state.update( 10, 1 );
+    state.update( 500, 2 );
+
+    MessageBuffer buffer;
+    state.write( buffer );
+
+    /* Only the three runs are packed. */
+    BOOST_CHECK_EQUAL( buffer.str.str().size(), 3 * sizeof(size_t) + 3 * (sizeof(size_t) + sizeof(int)) );
+
+    Opm::TimeMap shortMap{ startDate };
+    Opm::DynamicState<int> copy(shortMap , 77);
+    copy.read( buffer );
+    for (size_t step = 0; step <= 1000; step++)
+        BOOST_CHECK_EQUAL( copy[step], state[step] );
+
+    BOOST_CHECK_THROW( copy[1001], std::out_of_range );
+
+    /* The initial range is packed too. */
+    copy.updateInitial( 5 );
+    BOOST_CHECK_EQUAL( copy[9], 5 );
+    BOOST_CHECK_EQUAL( copy[10], 1 );
+}
@@ -790,3 +790,70 @@ BOOST_AUTO_TEST_CASE(DefaultedBoxFailMultiply) {
     // PORO has not been defined
     BOOST_CHECK_THROW( const Setup s(createMultiplyPorvFailDeck()), std::logic_error);
 }
+
+
+static Opm::Deck createBoxOperationsDeck() {
+    const auto* input = R"(
+RUNSPEC
+
+DIMENS
+  50 50 30 /
+
+GRID
+
+DX
+  75000*1 /
+
+DY
+  75000*1 /
+
+DZ
+  75000*1 /
+
+TOPS
+  2500*1000 /
+
+EQUALS
+   PERMX 100 /
+   PERMY 200 /
+   PORO 0.25 /
+/
+
+MULTIPLY
+   PERMX 2 /
+   PORO 2 /
+/
+
+COPY
+   PERMX PERMZ /
+/
+
+ADD
+   PERMX 1 /
+   PERMY 1 1 10 1 10 1 1 /
+/
+
+)";
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(BoxOperationsInDeckOrder) {
+    // The records on different properties are applied together, the
+    // COPY and the ADD of PERMX must see the records before them.
+    const Setup s(createBoxOperationsDeck());
+    const auto& permx = s.props.getDoubleGridProperty("PERMX").getData();
+    const auto& permy = s.props.getDoubleGridProperty("PERMY").getData();
+    const auto& permz = s.props.getDoubleGridProperty("PERMZ").getData();
+    const auto& poro = s.props.getDoubleGridProperty("PORO").getData();
+
+    for (size_t g = 0; g < s.grid.getCartesianSize(); g++) {
+        const auto ijk = s.grid.getIJK(g);
+        const bool inBox = ijk[0] < 10 && ijk[1] < 10 && ijk[2] == 0;
+
+        BOOST_CHECK_CLOSE(permx[g] / permz[g], 201.0 / 200.0, 1e-8);
+        BOOST_CHECK_CLOSE(permy[g], inBox ? permx[g] : permz[g], 1e-8);
+        BOOST_CHECK_CLOSE(poro[g], 0.5, 1e-8);
+    }
+}
@@ -167,6 +167,54 @@ BOOST_AUTO_TEST_CASE(CheckGridIndex) {
     BOOST_CHECK_EQUAL(17 * 19 * 41, grid.getCartesianSize());
 }
 
+BOOST_AUTO_TEST_CASE(CheckGridIndexBatch) {
+    Opm::EclipseGrid grid(17, 19, 41);
+
+    std::vector<size_t> globalIndices;
+    for (size_t g = 0; g < grid.getCartesianSize(); g += 7)
+        globalIndices.push_back(g);
+    globalIndices.push_back(grid.getCartesianSize() - 1);
+
+    const auto ijk = grid.getIJK(globalIndices);
+    BOOST_CHECK_EQUAL(ijk.size(), globalIndices.size());
+    for (size_t index = 0; index < globalIndices.size(); index++) {
+        const auto expected = grid.getIJK(globalIndices[index]);
+        BOOST_CHECK(ijk[index] == expected);
+    }
+
+    const auto roundtrip = grid.getGlobalIndices(ijk);
+    BOOST_CHECK_EQUAL_COLLECTIONS(roundtrip.begin(), roundtrip.end(),
+                                  globalIndices.begin(), globalIndices.end());
+
+    BOOST_CHECK_THROW(grid.getIJK(std::vector<size_t>{ grid.getCartesianSize() }), std::invalid_argument);
+    BOOST_CHECK_THROW(grid.getGlobalIndices({ { { 17, 0, 0 } } }), std::invalid_argument);
+    BOOST_CHECK_THROW(grid.getGlobalIndices({ { { 0, -1, 0 } } }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(CheckActiveIndexBatch) {
+    Opm::EclipseGrid grid(3, 2, 2);
+    std::vector<int> actnum = { 1, 0, 1, 1, 1, 1,
+                                0, 1, 1, 1, 1, 0 };
+    grid.resetACTNUM(actnum.data());
+
+    std::vector<size_t> activeIndices(grid.getNumActive());
+    for (size_t a = 0; a < activeIndices.size(); a++)
+        activeIndices[a] = activeIndices.size() - 1 - a;
+
+    const auto ijk = grid.getActiveIJK(activeIndices);
+    for (size_t index = 0; index < activeIndices.size(); index++) {
+        const auto expected = grid.getIJK(grid.getGlobalIndex(activeIndices[index]));
+        BOOST_CHECK(ijk[index] == expected);
+    }
+
+    const auto roundtrip = grid.activeIndex(ijk);
+    BOOST_CHECK_EQUAL_COLLECTIONS(roundtrip.begin(), roundtrip.end(),
+                                  activeIndices.begin(), activeIndices.end());
+
+    BOOST_CHECK_THROW(grid.activeIndex({ { { 1, 0, 0 } } }), std::invalid_argument);
+    BOOST_CHECK_THROW(grid.getActiveIJK({ grid.getNumActive() }), std::invalid_argument);
+}
+
 static Opm::Deck createCPDeck() {
     const char* deckData =
         "RUNSPEC\n"
@@ -403,6 +451,42 @@ BOOST_AUTO_TEST_CASE(DEPTHZ_EQUAL_TOPS) {
 
 
 
+BOOST_AUTO_TEST_CASE(BulkCellGeometry) {
+    Opm::EclipseGrid grid( createCARTDeck() );
+    std::vector< double > volumes;
+    std::vector< double > depths;
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        volumes.push_back( grid.getCellVolume( g ));
+        depths.push_back( grid.getCellDepth( g ));
+    }
+
+    const auto& bulk_volumes = grid.getCellVolumes();
+    const auto& centers = grid.getCellCenters();
+    const auto& dims = grid.getCellDimensions();
+    BOOST_CHECK_EQUAL( bulk_volumes.size(), grid.getCartesianSize() );
+    BOOST_CHECK_EQUAL( centers[0].size(), grid.getCartesianSize() );
+    BOOST_CHECK_EQUAL( dims[2].size(), grid.getCartesianSize() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( volumes.begin(), volumes.end(),
+                                   bulk_volumes.begin(), bulk_volumes.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( depths.begin(), depths.end(),
+                                   grid.getCellDepths().begin(), grid.getCellDepths().end() );
+
+    for (size_t k= 0; k < 10; k++)
+        for (size_t j= 0; j < 10; j++)
+            for (size_t i= 0; i < 10; i++) {
+                const size_t g = grid.getGlobalIndex( i, j, k );
+                const auto pos = grid.getCellCenter( g );
+                const auto cell_dims = grid.getCellDims( i, j, k );
+
+                BOOST_CHECK_CLOSE( centers[0][g] , i*0.25 + 0.125, 0.001);
+                BOOST_CHECK_CLOSE( centers[1][g] , j*0.25 + 0.125, 0.001);
+                BOOST_CHECK_CLOSE( centers[2][g] , k*0.25 + 0.125 + 0.25, 0.001);
+                BOOST_CHECK_EQUAL( centers[2][g] , std::get<2>(pos) );
+                for (size_t d = 0; d < 3; d++)
+                    BOOST_CHECK_EQUAL( dims[d][g], cell_dims[d] );
+            }
+}
+
 BOOST_AUTO_TEST_CASE(HasCPKeywords) {
     Opm::Deck deck = createCPDeck();
     BOOST_CHECK(  Opm::EclipseGrid::hasCornerPointKeywords( deck ));
@@ -711,6 +795,51 @@ BOOST_AUTO_TEST_CASE(ResetACTNUM) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ActiveIndexMatchesERT) {
+    Opm::EclipseGrid grid(4,3,2);
+    std::vector<int> actnum(grid.getCartesianSize(), 1);
+    actnum[1] = 0;
+    actnum[7] = 0;
+    actnum[23] = 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+        const ecl_grid_type * ert_grid = grid.c_ptr();
+        BOOST_CHECK_EQUAL( grid.getNumActive() , size_t(ecl_grid_get_nactive( ert_grid )));
+        BOOST_CHECK_EQUAL( grid.allActive() , pass == 0 );
+
+        for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+            const int active_index = ecl_grid_get_active_index1( ert_grid , g );
+            BOOST_CHECK_EQUAL( grid.cellActive( g ) , bool(ecl_grid_cell_active1( ert_grid , g )));
+            if (active_index < 0)
+                BOOST_CHECK_THROW( grid.activeIndex( g ) , std::invalid_argument );
+            else {
+                BOOST_CHECK_EQUAL( grid.activeIndex( g ) , size_t(active_index));
+                BOOST_CHECK_EQUAL( grid.getGlobalIndex( active_index ) , g );
+            }
+        }
+        grid.resetACTNUM( actnum.data() );
+    }
+    BOOST_CHECK_EQUAL( grid.getNumActive() , 21U );
+    BOOST_CHECK_THROW( grid.cellActive( 24 ) , std::invalid_argument );
+
+    const auto& global_to_active = grid.getGlobalToActiveMap();
+    BOOST_CHECK_EQUAL( global_to_active.size() , grid.getCartesianSize() );
+    BOOST_CHECK_EQUAL( global_to_active[1] , -1 );
+    BOOST_CHECK_EQUAL( global_to_active[2] , 1 );
+
+    std::vector<int> global(grid.getCartesianSize());
+    std::iota(global.begin(), global.end(), 0);
+    const auto compressed = grid.compressedVector( global );
+    BOOST_CHECK( compressed == std::vector<int>( grid.getActiveMap().begin(), grid.getActiveMap().end() ));
+
+    const auto expanded = grid.expandedVector( compressed , -1 );
+    for (size_t g = 0; g < grid.getCartesianSize(); g++)
+        BOOST_CHECK_EQUAL( expanded[g] , actnum[g] ? int(g) : -1 );
+    BOOST_CHECK( grid.expandedVector( global ) == global );
+    BOOST_CHECK_THROW( grid.expandedVector( std::vector<int>(5) ) , std::invalid_argument );
+}
+
+
 BOOST_AUTO_TEST_CASE(ACTNUM_BEST_EFFORT) {
     const char* deckData1 =
         "RUNSPEC\n"
@@ -1116,6 +1245,16 @@ BOOST_AUTO_TEST_CASE(ZcornMapper) {
     points_adjusted = zmp.fixupZCORN( zcorn );
     BOOST_CHECK_EQUAL( points_adjusted , 2 );
     BOOST_CHECK( zmp.validZCORN( zcorn ));
+
+    /* Damage in many columns; a fixup propagates down the pillar */
+    for (int j=0; j < ny; j++)
+        for (int i=0; i < nx; i++)
+            zcorn[ zmp.index(i,j,0,7) ] = zcorn[ zmp.index(i,j,nz - 1,7) ] + 1;
+    BOOST_CHECK( !zmp.validZCORN( zcorn ));
+    points_adjusted = zmp.fixupZCORN( zcorn );
+    BOOST_CHECK_EQUAL( points_adjusted , static_cast< size_t >( 2*nx*ny*(nz - 1) ));
+    BOOST_CHECK( zmp.validZCORN( zcorn ));
+    BOOST_CHECK_EQUAL( zmp.fixupZCORN( zcorn ) , 0U );
 }
 
 
@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cmath>
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
@@ -112,6 +113,42 @@ BOOST_AUTO_TEST_CASE(GetPOROTOPBased) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(JFuncScaling) {
+    const char *deckData =
+"RUNSPEC\n"
+"DIMENS\n"
+" 2 1 1 /\n"
+"GRID\n"
+"DX\n"
+"2*1 /\n"
+"DY\n"
+"2*1 /\n"
+"DZ\n"
+"2*1 /\n"
+"TOPS\n"
+"2*1000 /\n"
+"PORO\n"
+"0.25 0.16 /\n"
+"PERMX\n"
+"100 200 /\n"
+"PERMY\n"
+"300 0 /\n"
+"PROPS\n"
+"JFUNC\n"
+"  WATER 22.0 /\n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deckData, ParseContext() );
+    EclipseState state( deck, ParseContext() );
+    const auto& scaling = state.getJFuncScaling();
+
+    BOOST_CHECK_EQUAL( scaling.size(), 2U );
+    BOOST_CHECK_CLOSE( scaling[0], std::sqrt( 0.25 / (200 * Metric::Permeability) ), 1e-10 );
+    BOOST_CHECK_CLOSE( scaling[1], std::sqrt( 0.16 / (100 * Metric::Permeability) ), 1e-10 );
+
+    BOOST_CHECK( EclipseState( createDeckTOP(), ParseContext() ).getJFuncScaling().empty() );
+}
+
 static Deck createDeck() {
 const char *deckData =
 "RUNSPEC\n"
@@ -288,6 +325,94 @@ BOOST_AUTO_TEST_CASE(GetProperty) {
     BOOST_CHECK_THROW( satNUM.iget(100000) , std::out_of_range );
 }
 
+BOOST_AUTO_TEST_CASE(ConsumeDeck) {
+    auto deck = createDeck();
+    EclipseState state( deck, ParseContext() );
+
+    auto consumedDeck = createDeck();
+    EclipseState consumed( std::move( consumedDeck ), ParseContext() );
+
+    BOOST_CHECK( state.get3DProperties().getIntGridProperty( "SATNUM" ).getData() ==
+                 consumed.get3DProperties().getIntGridProperty( "SATNUM" ).getData() );
+
+    for (const auto& name : { "SWAT", "DX", "PORV" })
+        BOOST_CHECK( state.get3DProperties().getDoubleGridProperty( name ).getData() ==
+                     consumed.get3DProperties().getDoubleGridProperty( name ).getData() );
+
+    BOOST_CHECK_EQUAL( state.getTitle(), consumed.getTitle() );
+    BOOST_CHECK( consumed.get3DProperties().hasDeckIntGridProperty( "SATNUM" ) );
+
+    // The property arrays have been taken out of the deck, the rest is intact.
+    BOOST_CHECK_EQUAL( 0U, consumedDeck.getKeyword( "SATNUM" ).getDataSize() );
+    BOOST_CHECK_EQUAL( 0U, consumedDeck.getKeyword( "SWAT" ).getDataSize() );
+    BOOST_CHECK_EQUAL( 1000U, deck.getKeyword( "SATNUM" ).getDataSize() );
+    BOOST_CHECK_EQUAL( 2U, consumedDeck.getKeyword( "FAULTS" ).size() );
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalRebuild) {
+    auto deck = createDeck();
+    EclipseState state( deck, ParseContext() );
+
+    std::string deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 10 10 10 /\n"
+        "GRID\n"
+        "DX\n"
+        "1000*0.25 /\n"
+        "DY\n"
+        "1000*0.25 /\n"
+        "DZ\n"
+        "1000*0.25 /\n"
+        "TOPS\n"
+        "100*0.25 /\n"
+        "FAULTS \n"
+        "  'F1'  1  1  1  4   1  4  'X' / \n"
+        "  'F2'  5  5  1  4   1  4  'X-' / \n"
+        "/\n"
+        "MULTFLT \n"
+        "  'F1' 0.10 / \n"
+        "  'F2' 0.50 / \n"
+        "/\n"
+        "EDIT\n"
+        "MULTFLT /\n"
+        "  'F2' 0.25 / \n"
+        "/\n"
+        "OIL\n"
+        "\n"
+        "GAS\n"
+        "\n"
+        "TITLE\n"
+        "The title\n"
+        "\n"
+        "START\n"
+        "8 MAR 1998 /\n"
+        "\n"
+        "PROPS\n"
+        "REGIONS\n"
+        "SWAT\n"
+        "1000*1 /\n"
+        "SATNUM\n"
+        "1000*3 /\n";
+
+    Parser parser;
+    auto edited = parser.parseString( deckData, ParseContext() );
+    EclipseState incremental( state, edited, { "SATNUM", "MULTFLT" } );
+    EclipseState full( edited, ParseContext() );
+
+    BOOST_CHECK_EQUAL( 3, incremental.get3DProperties().getIntGridProperty( "SATNUM" ).iget( 0 ) );
+    BOOST_CHECK_EQUAL( 2, state.get3DProperties().getIntGridProperty( "SATNUM" ).iget( 0 ) );
+    BOOST_CHECK_EQUAL( 0.10, incremental.getFaults().getFault( "F1" ).getTransMult() );
+    BOOST_CHECK_EQUAL( full.getTransMult().getMultiplier( 0, 0, 0, FaceDir::XPlus ),
+                       incremental.getTransMult().getMultiplier( 0, 0, 0, FaceDir::XPlus ) );
+    BOOST_CHECK_EQUAL( full.getInputGrid().getCellVolume( 0 ), incremental.getInputGrid().getCellVolume( 0 ) );
+
+    deckData.replace( deckData.find( "DZ\n1000*0.25" ), 12, "DZ\n1000*0.50" );
+    auto thicker = parser.parseString( deckData, ParseContext() );
+    EclipseState rebuilt( incremental, thicker, { "DZ" } );
+    BOOST_CHECK_CLOSE( 0.25 * 0.25 * 0.50, rebuilt.getInputGrid().getCellVolume( 0 ), 1e-8 );
+}
+
 BOOST_AUTO_TEST_CASE(GetTransMult) {
     auto deck = createDeck();
     EclipseState state( deck, ParseContext() );
@@ -72,3 +72,37 @@ BOOST_AUTO_TEST_CASE(TestMultiple) {
     events.addEvent( Opm::ScheduleEvents::NEW_WELL , 0 );
     BOOST_CHECK( events.hasEvent( Opm::ScheduleEvents::NEW_WELL | Opm::ScheduleEvents::NEW_GROUP , 0 ));
 }
+
+
+BOOST_AUTO_TEST_CASE(TestRanges) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 20; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    Opm::Events events( timeMap );
+    BOOST_CHECK_EQUAL( -1 , events.nextEvent( ~uint64_t(0) , 0 ));
+    BOOST_CHECK( !events.anyEvent( ~uint64_t(0) , 0 , 20 ));
+
+    events.addEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 12 );
+    events.addEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE ,  4 );
+    events.addEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE ,  4 );
+    events.addEvent( Opm::ScheduleEvents::NEW_WELL , 7 );
+
+    BOOST_CHECK_EQUAL( 4  , events.nextEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 0 ));
+    BOOST_CHECK_EQUAL( 4  , events.nextEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 4 ));
+    BOOST_CHECK_EQUAL( 12 , events.nextEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 5 ));
+    BOOST_CHECK_EQUAL( -1 , events.nextEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 13 ));
+    BOOST_CHECK_EQUAL( 7  , events.nextEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE | Opm::ScheduleEvents::NEW_WELL , 5 ));
+    BOOST_CHECK_EQUAL( -1 , events.nextEvent( Opm::ScheduleEvents::NEW_GROUP , 0 ));
+
+    BOOST_CHECK(  events.anyEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 0 , 4 ));
+    BOOST_CHECK( !events.anyEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 5 , 11 ));
+    BOOST_CHECK(  events.anyEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE | Opm::ScheduleEvents::NEW_WELL , 5 , 11 ));
+    BOOST_CHECK(  events.anyEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , 12 , 12 ));
+
+    for (size_t step = 0; step <= 20; step++) {
+        BOOST_CHECK_EQUAL( events.hasEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , step ),
+                           events.anyEvent( Opm::ScheduleEvents::WELL_STATUS_CHANGE , step , step ));
+    }
+}
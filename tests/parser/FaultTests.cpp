@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
 
 #define BOOST_TEST_MODULE FaultTests
 
@@ -77,6 +78,25 @@ BOOST_AUTO_TEST_CASE(CreateFace) {
 }
 
 
+BOOST_AUTO_TEST_CASE(FaceBox) {
+    Opm::FaultFace face1(10,10,10, 4 , 4 , 0 , 9 , 2 , 5 , Opm::FaceDir::XPlus);
+    Opm::FaultFace face2(10,10,10, 4 , 4 , 0 , 9 , 2 , 5 , Opm::FaceDir::XPlus);
+    Opm::FaultFace face3(10,10,10, 4 , 4 , 0 , 9 , 2 , 5 , Opm::FaceDir::XMinus);
+    Opm::FaultFace face4(10,10,10, 4 , 4 , 0 , 8 , 2 , 5 , Opm::FaceDir::XPlus);
+
+    const auto& box = face1.getBox();
+    BOOST_CHECK_EQUAL( box.size() , 40U );
+    BOOST_CHECK_EQUAL( box.numRanges() , 40U );
+    BOOST_CHECK_EQUAL( box.rangeSize() , 1U );
+    BOOST_CHECK_EQUAL( box.rangeBegin(0) , 204U );
+    BOOST_CHECK_EQUAL( std::distance( face1.begin() , face1.end() ) , 40 );
+
+    BOOST_CHECK( face1 == face2 );
+    BOOST_CHECK( face1 != face3 );
+    BOOST_CHECK( face1 != face4 );
+}
+
+
 BOOST_AUTO_TEST_CASE(CreateFault) {
     Opm::Fault fault("FAULT1");
     BOOST_CHECK_EQUAL( "FAULT1" , fault.getName());
@@ -0,0 +1,125 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE GridPartitionTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/GridPartition.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+static Deck createDeck() {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 4 4 2 /\n"
+        "OIL\n"
+        "WATER\n"
+        "START\n"
+        " 1 JAN 2000 /\n"
+        "GRID\n"
+        "DX\n"
+        "32*1 /\n"
+        "DY\n"
+        "32*1 /\n"
+        "DZ\n"
+        "32*1 /\n"
+        "TOPS\n"
+        "16*0 /\n"
+        "PORO\n"
+        "16*0.25 16*0.30 /\n"
+        "PERMX\n"
+        "32*100 /\n"
+        "PERMY\n"
+        "32*100 /\n"
+        "PERMZ\n"
+        "32*10 /\n"
+        "MULTX\n"
+        "31*1 0.5 /\n"
+        "NNC\n"
+        " 1 1 1 4 4 2 10 /\n"
+        "/\n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        " 'W1' 'G' 1 1 1* 'OIL' /\n"
+        " 'W2' 'G' 4 4 1* 'WATER' /\n"
+        "/\n"
+        "COMPDAT\n"
+        " 'W1' 1 1 1 1 'OPEN' /\n"
+        " 'W2' 4 4 2 2 'OPEN' /\n"
+        "/\n"
+        "TSTEP\n"
+        " 1 /\n";
+
+    Parser parser;
+    return parser.parseString( deckData, ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(LocalIndex) {
+    const GridDims dims( 4, 4, 2 );
+    const GridPartition partition( dims, { 31, 0, 5 } );
+
+    BOOST_CHECK_EQUAL( 3U, partition.size() );
+    BOOST_CHECK( partition.contains( 5 ) );
+    BOOST_CHECK( !partition.contains( 6 ) );
+    BOOST_CHECK_EQUAL( 0U, partition.localIndex( 31 ) );
+    BOOST_CHECK_EQUAL( 2U, partition.localIndex( 5 ) );
+    BOOST_CHECK_THROW( partition.localIndex( 6 ), std::invalid_argument );
+
+    BOOST_CHECK_THROW( GridPartition( dims, { 1, 32 } ), std::invalid_argument );
+    BOOST_CHECK_THROW( GridPartition( dims, { 1, 2, 1 } ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(Slices) {
+    const auto deck = createDeck();
+    const EclipseState state( deck, ParseContext() );
+    const Schedule schedule( deck, state );
+    const auto& grid = state.getInputGrid();
+
+    const GridPartition partition( grid, { 31, 0, 5 } );
+
+    const auto poro = partition.slice( state.get3DProperties().getDoubleGridProperty( "PORO" ) );
+    BOOST_CHECK_EQUAL( 3U, poro.size() );
+    BOOST_CHECK_CLOSE( 0.30, poro[0], 1e-10 );
+    BOOST_CHECK_CLOSE( 0.25, poro[1], 1e-10 );
+
+    const auto multx = partition.slice( state.getTransMult(), FaceDir::XPlus );
+    BOOST_CHECK_EQUAL( 0.5, multx[0] );
+    BOOST_CHECK_EQUAL( 1.0, multx[2] );
+
+    BOOST_CHECK_EQUAL( 1U, partition.slice( state.getInputNNC() ).numNNC() );
+
+    const auto wells = partition.wells( schedule, 0 );
+    BOOST_CHECK_EQUAL( 2U, wells.size() );
+
+    const GridPartition other( grid, { 5, 6 } );
+    BOOST_CHECK_EQUAL( 0U, other.slice( state.getInputNNC() ).numNNC() );
+    BOOST_CHECK( other.wells( schedule, 0 ).empty() );
+}
@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <future>
 #include <stdexcept>
 #include <iostream>
 #include <memory>
@@ -152,6 +154,229 @@ BOOST_AUTO_TEST_CASE(SetFromDeckKeyword) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(LazyInitializer) {
+    const auto& satnumKw = createSATNUMKeyword();
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    size_t calls = 0;
+    auto init = [&calls]( size_t size ) {
+        calls++;
+        return std::vector< int >( size, 5 );
+    };
+    SupportedKeywordInfo keywordInfo("SATNUM" , init, "1");
+
+    Opm::GridProperty<int> lazy( 4 , 4 , 2 , keywordInfo);
+    BOOST_CHECK( !lazy.materialized() );
+    BOOST_CHECK_EQUAL( 32U , lazy.getCartesianSize() );
+    BOOST_CHECK_EQUAL( 0U , calls );
+    BOOST_CHECK_EQUAL( 5 , lazy.iget( 7 ));
+    BOOST_CHECK( lazy.materialized() );
+    BOOST_CHECK_EQUAL( 1U , calls );
+    BOOST_CHECK_EQUAL( 5 , lazy.getData()[ 31 ] );
+    BOOST_CHECK_EQUAL( 1U , calls );
+
+    /* A keyword covering every cell should never call the initializer. */
+    Opm::GridProperty<int> fromDeck( 4 , 4 , 2 , keywordInfo);
+    fromDeck.loadFromDeckKeyword( satnumKw );
+    BOOST_CHECK_EQUAL( 1U , calls );
+    BOOST_CHECK( fromDeck.deckAssigned() );
+    for (size_t g = 0; g < 32; g++)
+        BOOST_CHECK_EQUAL( g , fromDeck.iget( g ));
+
+    Opm::GridProperty<int> scalar( 4 , 4 , 2 , keywordInfo);
+    scalar.setScalar( 3 , Opm::Box( 4 , 4 , 2 ));
+    BOOST_CHECK_EQUAL( 1U , calls );
+    BOOST_CHECK_EQUAL( 3 , scalar.iget( 0 ));
+}
+
+BOOST_AUTO_TEST_CASE(CopyOnWrite) {
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo( "PORO", 0.25, "1" );
+    Opm::GridProperty<double> base( 4 , 4 , 2 , keywordInfo );
+    base.iset( 0 , 0.10 );
+
+    Opm::GridProperty<double> realization( base );
+    BOOST_CHECK( realization.sharesData( base ));
+    BOOST_CHECK_EQUAL( realization.getData().size() , 32U );
+
+    /* The non const getData() above gave realization a private copy. */
+    BOOST_CHECK( !realization.sharesData( base ));
+
+    Opm::GridProperty<double> other( base );
+    const auto& const_other = other;
+    BOOST_CHECK_EQUAL( const_other.getData()[0] , 0.10 );
+    BOOST_CHECK( other.sharesData( base ));
+
+    other.scale( 2.0 , Opm::Box( 4 , 4 , 2 ));
+    BOOST_CHECK( !other.sharesData( base ));
+    BOOST_CHECK_EQUAL( other.iget( 0 ) , 0.20 );
+    BOOST_CHECK_EQUAL( other.iget( 31 ) , 0.50 );
+    BOOST_CHECK_EQUAL( base.iget( 0 ) , 0.10 );
+    BOOST_CHECK_EQUAL( base.iget( 31 ) , 0.25 );
+
+    Opm::GridProperty<double> lazy( 4 , 4 , 2 , keywordInfo );
+    Opm::GridProperty<double> lazy_copy( lazy );
+    BOOST_CHECK( !lazy_copy.sharesData( lazy ));
+}
+
+BOOST_AUTO_TEST_CASE(CompactIntStorage) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo( "FIPNUM", 1, "1" );
+    Opm::GridProperty<int> fipnum( 4 , 4 , 2 , keywordInfo );
+
+    /* Nothing to compact before the data is created. */
+    BOOST_CHECK( !fipnum.compact() );
+
+    for (size_t g = 0; g < 32; g += 3)
+        fipnum.iset( g , 300 );
+    fipnum.iset( 1 , -5 );
+    const Opm::GridProperty<int> copy( fipnum );
+
+    BOOST_CHECK( fipnum.compact() );
+    BOOST_CHECK( fipnum.compacted() );
+    BOOST_CHECK( !fipnum.materialized() );
+    BOOST_CHECK( !fipnum.sharesData( copy ));
+    BOOST_CHECK_EQUAL( fipnum.iget( 0 ) , 300 );
+    BOOST_CHECK_EQUAL( fipnum.iget( 1 ) , -5 );
+    BOOST_CHECK_EQUAL( fipnum.iget( 2 ) , 1 );
+    BOOST_CHECK_THROW( fipnum.iget( 32 ) , std::out_of_range );
+    BOOST_CHECK( fipnum.regionIndex()->regions() == std::vector<int>({ -5, 1, 300 }) );
+    BOOST_CHECK( fipnum.compacted() );
+
+    /* getData() creates the full array, a write drops the compact data. */
+    const auto& const_fipnum = fipnum;
+    BOOST_CHECK( const_fipnum.getData() == copy.getData() );
+    BOOST_CHECK( fipnum.materialized() );
+    BOOST_CHECK( fipnum.compacted() );
+
+    fipnum.iset( 2 , 7 );
+    BOOST_CHECK( !fipnum.compacted() );
+    BOOST_CHECK_EQUAL( fipnum.iget( 2 ) , 7 );
+    BOOST_CHECK_EQUAL( fipnum.iget( 3 ) , 300 );
+
+    /* Values which do not fit in 16 bits keep the full width. */
+    fipnum.iset( 4 , 100000 );
+    BOOST_CHECK( !fipnum.compact() );
+
+    Opm::GridProperty<double> poro( 4 , 4 , 2 , Opm::GridProperty<double>::SupportedKeywordInfo( "PORO" , 0.25 , "1" ));
+    poro.iset( 0 , 0.1 );
+    BOOST_CHECK( !poro.compact() );
+}
+
+BOOST_AUTO_TEST_CASE(LayeredStorage) {
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo( "PERMX", 1.0, "1" );
+    const Opm::Box global( 4 , 3 , 3 );
+
+    /* setScalar() on the global box gives a constant property. */
+    Opm::GridProperty<double> permx( 4 , 3 , 3 , keywordInfo );
+    permx.setScalar( 100 , global );
+    BOOST_CHECK( permx.compacted() );
+    BOOST_CHECK( permx.isConstant() );
+    BOOST_CHECK_EQUAL( permx.iget( 35 ) , 100 );
+
+    /* Boxes of whole layers keep it compact. */
+    permx.scale( 2 , Opm::Box( global , 0 , 3 , 0 , 2 , 1 , 1 ));
+    permx.add( 5 , Opm::Box( global , 0 , 3 , 0 , 2 , 2 , 2 ));
+    permx.maxvalue( 150 , global );
+    BOOST_CHECK( permx.compacted() );
+    BOOST_CHECK( !permx.isConstant() );
+    BOOST_CHECK_EQUAL( permx.iget( 0 ) , 100 );
+    BOOST_CHECK_EQUAL( permx.iget( 12 ) , 150 );
+    BOOST_CHECK_EQUAL( permx.iget( 35 ) , 105 );
+
+    Opm::GridProperty<double> permz( 4 , 3 , 3 , keywordInfo );
+    permz.copyFrom( permx , Opm::Box( global , 0 , 3 , 0 , 2 , 0 , 1 ));
+    permz.scale( 0.1 , global );
+    BOOST_CHECK( !permz.compacted() );
+    BOOST_CHECK_CLOSE( permz.iget( 13 ) , 15 , 1e-10 );
+    BOOST_CHECK_CLOSE( permz.iget( 30 ) , 0.1 , 1e-10 );
+
+    Opm::GridProperty<double> permy( 4 , 3 , 3 , keywordInfo );
+    permy.copyFrom( permx , global );
+    BOOST_CHECK( permy.sharesData( permx ));
+
+    /* A write to one cell expands the data. */
+    permx.iset( 5 , 1 );
+    BOOST_CHECK( !permx.compacted() );
+    BOOST_CHECK_EQUAL( permx.iget( 5 ) , 1 );
+    BOOST_CHECK_EQUAL( permx.iget( 12 ) , 150 );
+    BOOST_CHECK_EQUAL( permy.iget( 5 ) , 100 );
+    BOOST_CHECK( !permx.compact() );
+
+    /* Full data which is constant by layer is compacted again. */
+    Opm::GridProperty<double> ntg( 4 , 3 , 3 , keywordInfo );
+    for (size_t g = 0; g < 36; g++)
+        ntg.iset( g , g < 12 ? 0.5 : 0.75 );
+    BOOST_CHECK( ntg.compact() );
+    BOOST_CHECK_EQUAL( ntg.iget( 11 ) , 0.5 );
+    BOOST_CHECK_EQUAL( ntg.iget( 12 ) , 0.75 );
+    BOOST_CHECK_EQUAL( ntg.getData()[20] , 0.75 );
+    BOOST_CHECK( !ntg.compacted() );
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentConstAccess) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    Opm::GridProperty<int> fipnum( 40 , 30 , 20 , SupportedKeywordInfo( "FIPNUM" , 1, "1" ));
+    for (size_t g = 0; g < fipnum.getCartesianSize(); g++)
+        fipnum.iset( g , 1 + g % 7 );
+    BOOST_CHECK( fipnum.compact() );
+
+    /* The data and the region index are built once for all the readers. */
+    const auto& shared = fipnum;
+    std::vector< std::future< std::pair< const std::vector<int>*, const Opm::RegionIndex* > > > readers;
+    for (int thread = 0; thread < 8; thread++) {
+        readers.push_back( std::async( std::launch::async, [&shared]() {
+            const auto index = shared.regionIndex();
+            return std::make_pair( &shared.getData(), index.get() );
+        }));
+    }
+
+    const auto first = readers[0].get();
+    for (size_t thread = 1; thread < readers.size(); thread++)
+        BOOST_CHECK( readers[thread].get() == first );
+
+    BOOST_CHECK_EQUAL( first.first->size() , fipnum.getCartesianSize() );
+    BOOST_CHECK_EQUAL( (*first.first)[ 13 ] , 7 );
+    BOOST_CHECK_EQUAL( first.second->cells( 7 ).size() , fipnum.getCartesianSize() / 7 );
+}
+
+BOOST_AUTO_TEST_CASE(LargeBoxAndMaskedOperations) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo( "P1", 1, "1" );
+    const size_t nx = 100, ny = 60, nz = 50;
+    Opm::GridProperty<int> prop( nx, ny, nz, keywordInfo );
+    Opm::Box box( nx, ny, nz, 10, 19, 5, 54, 2, 47 );
+
+    prop.add( 2, box );
+    prop.scale( 3, box );
+    prop.maxvalue( 8, box );
+
+    std::vector< bool > mask;
+    prop.initMask( 8, mask );
+    BOOST_CHECK_EQUAL( box.size(), prop.indexEqual( 8 ).size() );
+
+    prop.maskedAdd( 1, mask );
+    prop.maskedMultiply( 2, mask );
+    for (size_t k = 0; k < nz; k++) {
+        for (size_t j = 0; j < ny; j++) {
+            for (size_t i = 0; i < nx; i++) {
+                const bool inside = i >= 10 && i <= 19 && j >= 5 && j <= 54 && k >= 2 && k <= 47;
+                if (inside != mask[ i + j*nx + k*nx*ny ])
+                    BOOST_FAIL( "Mask mismatch" );
+                if (prop.iget( i, j, k ) != (inside ? 18 : 1))
+                    BOOST_FAIL( "Value mismatch" );
+            }
+        }
+    }
+
+    Opm::GridProperty<int> target( nx, ny, nz, SupportedKeywordInfo( "P2", 0, "1" ));
+    target.maskedCopy( prop, mask );
+    BOOST_CHECK_EQUAL( box.size(), target.indexEqual( 18 ).size() );
+    target.maskedSet( 7, mask );
+    BOOST_CHECK_EQUAL( box.size(), target.indexEqual( 7 ).size() );
+    BOOST_CHECK_EQUAL( nx*ny*nz - box.size(), target.indexEqual( 0 ).size() );
+}
+
 BOOST_AUTO_TEST_CASE(copy) {
     typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
     SupportedKeywordInfo keywordInfo1("P1", 0, "1");
@@ -488,6 +713,76 @@ BOOST_AUTO_TEST_CASE(mask_test) {
         BOOST_CHECK_EQUAL( p1.iget(g) , p2.iget(g));
 }
 
+BOOST_AUTO_TEST_CASE(RegionIndex) {
+    const std::vector<int> regions = { 3, 1, 3, -2, 1, 3, 7 };
+    const Opm::RegionIndex index( regions );
+
+    BOOST_CHECK( index.regions() == std::vector<int>({ -2, 1, 3, 7 }) );
+    BOOST_CHECK( index.cells( 2 ).empty() );
+    BOOST_CHECK( index.cells( 8 ).empty() );
+
+    const auto cells = index.cells( 3 );
+    BOOST_CHECK( std::vector<size_t>( cells.begin(), cells.end() ) == std::vector<size_t>({ 0, 2, 5 }) );
+    BOOST_CHECK_EQUAL( 3U, index.cells( -2 )[0] );
+    BOOST_CHECK_EQUAL( 1U, index.cells( 7 ).size() );
+
+    // widely spread values are sorted instead of counted
+    const std::vector<int> spread = { 1000000, -1000000, 1000000, 5 };
+    const Opm::RegionIndex spreadIndex( spread );
+    BOOST_CHECK( spreadIndex.regions() == std::vector<int>({ -1000000, 5, 1000000 }) );
+    const auto far = spreadIndex.cells( 1000000 );
+    BOOST_CHECK( std::vector<size_t>( far.begin(), far.end() ) == std::vector<size_t>({ 0, 2 }) );
+
+    BOOST_CHECK( Opm::RegionIndex( std::vector<int>() ).regions().empty() );
+
+    // large arrays are counted in blocks
+    std::vector<int> large( 300000 );
+    for (size_t g = 0; g < large.size(); g++)
+        large[g] = (g * 7) % 5 + 1 - (g % 3 == 0 ? 0 : 1);
+    const Opm::RegionIndex largeIndex( large );
+    BOOST_CHECK( largeIndex.regions() == std::vector<int>({ 0, 1, 2, 3, 4, 5 }) );
+    size_t total = 0;
+    for (int region : largeIndex.regions()) {
+        const auto region_cells = largeIndex.cells( region );
+        BOOST_CHECK( std::is_sorted( region_cells.begin(), region_cells.end() ));
+        BOOST_CHECK( std::all_of( region_cells.begin(), region_cells.end(),
+                                  [&]( size_t g ) { return large[g] == region; } ));
+        total += region_cells.size();
+    }
+    BOOST_CHECK_EQUAL( total, large.size() );
+}
+
+BOOST_AUTO_TEST_CASE(RegionIndexOperations) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    Opm::GridProperty<int> region( 5 , 5 , 4 , SupportedKeywordInfo( "R" , 1 , "1" ));
+    Opm::GridProperty<int> target( 5 , 5 , 4 , SupportedKeywordInfo( "P" , 10 , "1" ));
+    for (size_t g = 0; g < region.getCartesianSize(); g += 3)
+        region.iset( g , 2 );
+
+    auto index = region.regionIndex();
+    BOOST_CHECK( index == region.regionIndex() );
+    target.maskedAdd( 1 , index->cells( 2 ));
+    target.maskedMultiply( 2 , index->cells( 2 ));
+
+    std::vector<bool> mask;
+    region.initMask( 2 , mask );
+    for (size_t g = 0; g < target.getCartesianSize(); g++)
+        BOOST_CHECK_EQUAL( target.iget(g) , mask[g] ? 22 : 10 );
+
+    // the index is rebuilt after the region array is modified, also
+    // when it is modified through its own index
+    region.maskedSet( 3 , index->cells( 2 ));
+    BOOST_CHECK( index != region.regionIndex() );
+    BOOST_CHECK( region.regionIndex()->cells( 2 ).empty() );
+    BOOST_CHECK_EQUAL( index->cells( 2 ).size() , region.regionIndex()->cells( 3 ).size() );
+
+    region.iset( 0 , 5 );
+    BOOST_CHECK_EQUAL( 1U , region.regionIndex()->cells( 5 ).size() );
+
+    Opm::GridProperty<double> doubles( 5 , 5 , 4 , Opm::GridProperty<double>::SupportedKeywordInfo( "D" , 0.0 , "1" ));
+    BOOST_CHECK_THROW( doubles.regionIndex() , std::logic_error );
+}
+
 BOOST_AUTO_TEST_CASE(CheckLimits) {
     typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
     SupportedKeywordInfo keywordInfo1("P" , 1 , "1");
@@ -555,3 +850,67 @@ BOOST_AUTO_TEST_CASE(hasKeyword_assertKeyword) {
 
     BOOST_CHECK_THROW( gridProperties.getKeyword( "NOT-SUPPORTED" ), std::invalid_argument );
 }
+
+
+BOOST_AUTO_TEST_CASE(KeywordHandles) {
+    typedef Opm::GridProperties<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    std::vector<SupportedKeywordInfo> supportedKeywords = {
+        SupportedKeywordInfo("SATNUM" , 0, "1", true),
+        SupportedKeywordInfo("PVTNUM" , 2, "1", false)
+    };
+    const Opm::EclipseGrid grid(10, 7, 9);
+    Opm::GridProperties<int> gridProperties( grid, std::move( supportedKeywords ) );
+    const auto& properties = gridProperties;
+
+    const auto satnum = gridProperties.keywordHandle("SATNUM");
+    const auto pvtnum = gridProperties.keywordHandle("pvtnum ");
+    BOOST_CHECK_EQUAL( satnum, 0U );
+    BOOST_CHECK_EQUAL( pvtnum, 1U );
+    BOOST_CHECK_THROW( gridProperties.keywordHandle("NOT-SUPPORTED"), std::invalid_argument );
+
+    BOOST_CHECK( !gridProperties.hasKeyword( satnum ) );
+    BOOST_CHECK_THROW( properties.getKeyword( pvtnum ), std::invalid_argument );
+
+    const auto& property = properties.getKeyword( satnum );
+    BOOST_CHECK( gridProperties.hasKeyword( satnum ) );
+    BOOST_CHECK_EQUAL( &property, &properties.getKeyword("SATNUM") );
+
+    gridProperties.addKeyword("PVTNUM");
+    BOOST_CHECK( gridProperties.hasKeyword( pvtnum ) );
+    BOOST_CHECK_EQUAL( properties.getKeyword( pvtnum ).iget(0), 2 );
+
+    // FIPxxx keywords get a handle when they are first looked up.
+    const auto fipreg = gridProperties.keywordHandle("FIPREG");
+    BOOST_CHECK_EQUAL( fipreg, 2U );
+    BOOST_CHECK( !gridProperties.hasKeyword("FIPREG") );
+
+    // The handles are valid in a copy, and refer to its own properties.
+    const auto copy = gridProperties;
+    BOOST_CHECK( copy.hasKeyword( satnum ) );
+    BOOST_CHECK( &copy.getKeyword( satnum ) != &property );
+    BOOST_CHECK_EQUAL( &copy.getKeyword( satnum ), &copy.getKeyword("SATNUM") );
+}
+
+BOOST_AUTO_TEST_CASE(PropertyFingerprint) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    Opm::GridProperty<int> fipnum( 4 , 4 , 2 , SupportedKeywordInfo( "FIPNUM", 1, "1" ));
+    Opm::GridProperty<int> satnum( 4 , 4 , 2 , SupportedKeywordInfo( "SATNUM", 1, "1" ));
+    BOOST_CHECK( fipnum.fingerprint() != satnum.fingerprint() );
+
+    for (size_t g = 0; g < 32; g += 3)
+        fipnum.iset( g , 300 );
+    const Opm::GridProperty<int> copy( fipnum );
+    const auto fingerprint = fipnum.fingerprint();
+    BOOST_CHECK( copy.fingerprint() == fingerprint );
+
+    /* The storage does not change the fingerprint, the values do. */
+    BOOST_CHECK( fipnum.compact() );
+    BOOST_CHECK( fipnum.fingerprint() == fingerprint );
+
+    fipnum.iset( 2 , 7 );
+    BOOST_CHECK( fipnum.fingerprint() != fingerprint );
+    BOOST_CHECK( copy.fingerprint() == fingerprint );
+
+    fipnum.iset( 2 , 1 );
+    BOOST_CHECK( fipnum.fingerprint() == fingerprint );
+}
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
@@ -33,6 +34,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Group.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 
 using namespace Opm;
@@ -398,6 +400,58 @@ BOOST_AUTO_TEST_CASE(UpdateTree_AddFieldNode_Throws) {
     BOOST_CHECK_THROW(tree.update("FIELD"), std::invalid_argument );
 }
 
+BOOST_AUTO_TEST_CASE(GroupTreeIndex) {
+    GroupTree tree;
+    tree.update("PLAT-A", "FIELD");
+    tree.update("PLAT-B", "FIELD");
+    tree.update("M5S", "PLAT-A");
+    tree.update("M5N", "PLAT-A");
+    tree.update("B1", "PLAT-B");
+
+    const auto& index = tree.index();
+    BOOST_CHECK_EQUAL( index.size(), 6U );
+
+    const auto field = index.find( "FIELD" );
+    const auto plat_a = index.find( "PLAT-A" );
+    const auto m5n = index.find( "M5N" );
+    BOOST_CHECK_EQUAL( index.root, field );
+    BOOST_CHECK_EQUAL( index.parent[ field ], GroupTree::Index::npos );
+    BOOST_CHECK_EQUAL( index.parent[ m5n ], plat_a );
+    BOOST_CHECK_EQUAL( index.level[ m5n ], 2U );
+    BOOST_CHECK_EQUAL( index.numChildren( plat_a ), 2U );
+    BOOST_CHECK_EQUAL( index.numChildren( m5n ), 0U );
+    BOOST_CHECK_THROW( index.find( "NO-SUCH-GROUP" ), std::out_of_range );
+
+    BOOST_CHECK_EQUAL( index.preorder.size(), 6U );
+    BOOST_CHECK_EQUAL( index.preorder.front(), field );
+    BOOST_CHECK_EQUAL( index.postorder.size(), 6U );
+    BOOST_CHECK_EQUAL( index.postorder.back(), field );
+    for (size_t pos = 0; pos < index.postorder.size(); pos++) {
+        const auto node = index.postorder[ pos ];
+        if (node != field) {
+            const auto parent = std::find( index.postorder.begin(), index.postorder.end(), index.parent[ node ] );
+            BOOST_CHECK( parent - index.postorder.begin() > static_cast< std::ptrdiff_t >( pos ) );
+        }
+    }
+
+    const std::vector< std::string > kids = { "M5N", "M5S" };
+    BOOST_CHECK( tree.children( "PLAT-A" ) == kids );
+
+    std::vector< double > rates( index.size(), 0.0 );
+    rates[ index.find( "M5S" ) ] = 1;
+    rates[ m5n ] = 2;
+    rates[ index.find( "B1" ) ] = 4;
+    index.accumulate( rates );
+    BOOST_CHECK_EQUAL( rates[ plat_a ], 3 );
+    BOOST_CHECK_EQUAL( rates[ index.find( "PLAT-B" ) ], 4 );
+    BOOST_CHECK_EQUAL( rates[ field ], 7 );
+
+    /* Updating the tree rebuilds the index. */
+    tree.update("B1", "PLAT-A");
+    BOOST_CHECK_EQUAL( tree.index().numChildren( tree.index().find( "PLAT-A" ) ), 3U );
+    BOOST_CHECK_EQUAL( tree.index().level[ tree.index().find( "B1" ) ], 2U );
+}
+
 BOOST_AUTO_TEST_CASE(createDeckWithGRUPNET) {
         Opm::Parser parser;
         std::string input =
@@ -254,6 +254,20 @@ BOOST_AUTO_TEST_CASE(DefaultedRegions) {
   Opm::MULTREGTScanner scanner1( props, keywords1 );
   BOOST_CHECK_EQUAL( scanner1.getRegionMultiplier(grid.getGlobalIndex(2,0,0), grid.getGlobalIndex(1,0,0), Opm::FaceDir::XMinus ), 0.75);
   BOOST_CHECK_EQUAL( scanner1.getRegionMultiplier(grid.getGlobalIndex(2,0,0), grid.getGlobalIndex(2,0,1), Opm::FaceDir::ZPlus), 0.75);
+
+  {
+      std::vector<size_t> cells1 = { grid.getGlobalIndex(0,0,1), grid.getGlobalIndex(1,0,0), grid.getGlobalIndex(2,0,1), grid.getGlobalIndex(0,0,0) };
+      std::vector<size_t> cells2 = { grid.getGlobalIndex(1,0,1), grid.getGlobalIndex(2,0,0), grid.getGlobalIndex(2,0,0), grid.getGlobalIndex(0,0,0) };
+      std::vector<Opm::FaceDir::DirEnum> dirs = { Opm::FaceDir::XPlus, Opm::FaceDir::XPlus, Opm::FaceDir::ZMinus, Opm::FaceDir::XPlus };
+      const auto multipliers = scanner0.getRegionMultipliers( cells1, cells2, dirs );
+
+      BOOST_CHECK_EQUAL( multipliers.size(), 4U );
+      for (size_t face = 0; face < multipliers.size(); face++)
+          BOOST_CHECK_EQUAL( multipliers[face], scanner0.getRegionMultiplier( cells1[face], cells2[face], dirs[face] ));
+
+      dirs.pop_back();
+      BOOST_CHECK_THROW( scanner0.getRegionMultipliers( cells1, cells2, dirs ), std::invalid_argument );
+  }
 }
 
 
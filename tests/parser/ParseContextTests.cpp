@@ -470,6 +470,32 @@ BOOST_AUTO_TEST_CASE( test_constructor_with_values) {
 
 
 
+BOOST_AUTO_TEST_CASE( test_isIgnored ) {
+    ParseContext parseContext;
+    const std::string random_slash = ParseContext::PARSE_RANDOM_SLASH;
+
+    BOOST_CHECK( !parseContext.isIgnored( ParseContext::PARSE_RANDOM_SLASH ));
+    BOOST_CHECK( !parseContext.isIgnored( random_slash ));
+    BOOST_CHECK_THROW( parseContext.handleError( random_slash , "Slash" ) , std::invalid_argument );
+
+    parseContext.update( "PARSE_RANDOM_*" , InputError::IGNORE );
+    BOOST_CHECK( parseContext.isIgnored( ParseContext::PARSE_RANDOM_SLASH ));
+    BOOST_CHECK( parseContext.isIgnored( random_slash ));
+    BOOST_CHECK( parseContext.isIgnored( ParseContext::PARSE_RANDOM_TEXT ));
+    BOOST_CHECK( !parseContext.isIgnored( ParseContext::PARSE_EXTRA_DATA ));
+    BOOST_CHECK_NO_THROW( parseContext.handleError( ParseContext::PARSE_RANDOM_SLASH , "Slash" ));
+
+    ParseContext copy( parseContext );
+    copy.updateKey( ParseContext::PARSE_RANDOM_SLASH , InputError::THROW_EXCEPTION );
+    BOOST_CHECK( !copy.isIgnored( ParseContext::PARSE_RANDOM_SLASH ));
+    BOOST_CHECK( parseContext.isIgnored( ParseContext::PARSE_RANDOM_SLASH ));
+
+    parseContext.addKey( "NEW_KEY" , InputError::IGNORE );
+    BOOST_CHECK( parseContext.isIgnored( "NEW_KEY" ));
+    BOOST_CHECK_THROW( parseContext.isIgnored( "NO_SUCH_KEY" ) , std::invalid_argument );
+}
+
+
 BOOST_AUTO_TEST_CASE( test_too_much_data ) {
     const char * deckString =
         "RUNSPEC\n"
@@ -19,18 +19,69 @@
 
 
 #define BOOST_TEST_MODULE ParserTests
-#include <boost/filesystem/path.hpp>
+#include <config.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <opm/json/JsonObject.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckCache.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseProfile.hpp>
 
 inline std::string prefix() {
     return boost::unit_test::framework::master_test_suite().argv[1];
 }
 
+namespace fs = boost::filesystem;
+
+namespace {
+
+struct TestCase {
+    fs::path root;
+
+    TestCase() :
+        root( fs::canonical( fs::temp_directory_path() ) / fs::unique_path( "%%%%-%%%%" ) )
+    {
+        fs::create_directories( root );
+    }
+
+    ~TestCase() {
+        boost::system::error_code ec;
+        fs::remove_all( root, ec );
+    }
+
+    std::string write( const std::string& name, const std::string& content ) const {
+        std::ofstream of( path( name ) );
+        of << content;
+        return path( name );
+    }
+
+    std::string path( const std::string& name ) const {
+        return ( root / name ).string();
+    }
+};
+
+std::string str( const Opm::Deck& deck ) {
+    std::stringstream ss;
+    ss << deck;
+    return ss.str();
+}
+
+}
+
 
 BOOST_AUTO_TEST_CASE(ParserKeyword_includeInvalid) {
     boost::filesystem::path inputFilePath(prefix() + "includeInvalid.data");
@@ -133,3 +184,344 @@ BOOST_AUTO_TEST_CASE(ParserKeyword_includeWrongCase) {
 #endif
 }
 
+
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeWithoutTrailingNewline) {
+    TestCase test;
+
+    test.write("case.data",
+               "-- Leading comment\n"
+               "OIL\n"
+               "INCLUDE\n"
+               "  'permx.inc' /\n"
+               "INCLUDE\n"
+               "  'empty.inc' /\n"
+               "WATER");
+    test.write("permx.inc",
+               "PERMX  -- comment after keyword\n"
+               "   1.0 2*2.0  -- and one after the data\n"
+               "   3.0 4.0 /");
+    test.write("empty.inc", "");
+
+    Opm::Parser parser;
+    const auto deck = parser.parseFile(test.path("case.data"), Opm::ParseContext());
+
+    BOOST_CHECK(deck.hasKeyword("OIL"));
+    BOOST_CHECK(deck.hasKeyword("WATER"));
+    BOOST_CHECK(deck.hasKeyword("PERMX"));
+
+    const auto& permx = deck.getKeyword("PERMX").getRawDoubleData();
+    const std::vector< double > expected = { 1.0, 2.0, 2.0, 3.0, 4.0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(permx.begin(), permx.end(),
+                                  expected.begin(), expected.end());
+}
+
+
+#if HAVE_ZLIB
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeGzip) {
+    TestCase test;
+
+    const auto write_gz = [&test](const std::string& name, const std::string& content) {
+        gzFile gz = gzopen(test.path(name).c_str(), "wb");
+        BOOST_REQUIRE(gz != nullptr);
+        gzwrite(gz, content.data(), content.size());
+        gzclose(gz);
+    };
+
+    std::string permx = "PERMX -- compressed\n";
+    for (int i = 0; i < 10000; ++i)
+        permx += "1.0 2.0 3.0 4.0 5.0 6.0 7.0 8.0 9.0 10.0\n";
+    permx += "/\n";
+
+    test.write("case.data",
+               "OIL\n"
+               "INCLUDE\n"
+               "  'permx.inc.gz' /\n"
+               "INCLUDE\n"
+               "  'poro.inc' /\n"
+               "WATER\n");
+    write_gz("permx.inc.gz", permx);
+    write_gz("poro.inc", "PORO\n 4*0.25 /\n");
+
+    Opm::ParseContext parseContext;
+    Opm::Parser parser;
+    const auto datafile = test.path("case.data");
+    const auto deck = parser.parseFile(datafile, parseContext);
+
+    BOOST_CHECK(deck.hasKeyword("OIL"));
+    BOOST_CHECK(deck.hasKeyword("WATER"));
+
+    const auto& data = deck.getKeyword("PERMX").getRawDoubleData();
+    BOOST_CHECK_EQUAL(data.size(), 100000U);
+    BOOST_CHECK_EQUAL(data[0], 1.0);
+    BOOST_CHECK_EQUAL(data[99999], 10.0);
+    BOOST_CHECK_EQUAL(deck.getKeyword("PORO").getDataSize(), 4U);
+
+    Opm::Parser threaded;
+    threaded.setIncludeThreads(2);
+    BOOST_CHECK_EQUAL(str(deck), str(threaded.parseFile(datafile, parseContext)));
+}
+#endif
+
+
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeThreads) {
+    TestCase test;
+
+    test.write("case.data",
+               "EQLDIMS\n"
+               "  1 /\n"
+               "INCLUDE\n"
+               "  'permx.inc' /\n"
+               "INCLUDE\n"
+               "  'equil.inc' /\n"
+               "INCLUDE\n"
+               "  'nested.inc' /\n"
+               "INCLUDE\n"
+               "  'unknown.inc' /\n"
+               "INCLUDE\n"
+               "  'permx.inc' /\n"
+               "OIL\n");
+    test.write("permx.inc", "PERMX\n 1.0 2*2.0 3.0 /\nPERMY\n 4*1.0 /\n");
+    test.write("equil.inc", "EQUIL\n 2469 382 1705 0 500 0 1 1 20 /\n");
+    test.write("nested.inc", "PORO\n 4*0.25 /\nINCLUDE\n 'permz.inc' /\nWATER\n");
+    test.write("permz.inc", "PERMZ\n 4*0.1 /\n");
+    test.write("unknown.inc", "GAS\nFOOBAR\n 1 2 3 /\n");
+
+    Opm::ParseContext parseContext;
+    parseContext.update(Opm::ParseContext::PARSE_UNKNOWN_KEYWORD, Opm::InputError::IGNORE);
+
+    const auto datafile = test.path("case.data");
+    Opm::Parser sequential;
+    const auto expected = sequential.parseFile(datafile, parseContext);
+
+    Opm::Parser threaded;
+    threaded.setIncludeThreads(4);
+    const auto deck = threaded.parseFile(datafile, parseContext);
+
+    BOOST_CHECK_EQUAL(deck.size(), expected.size());
+    BOOST_CHECK_EQUAL(deck.count("PERMX"), 2U);
+    BOOST_CHECK(deck.hasKeyword("PERMZ"));
+    BOOST_CHECK(deck.hasKeyword("GAS"));
+
+    BOOST_CHECK_EQUAL(str(expected), str(deck));
+
+    for (size_t i = 0; i < deck.size(); ++i) {
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).name(), expected.getKeyword(i).name());
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getFileName(), expected.getKeyword(i).getFileName());
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getLineNumber(), expected.getKeyword(i).getLineNumber());
+    }
+
+    /* Every file is larger than the budget, so they are read one at a time. */
+    Opm::Parser bounded;
+    bounded.setIncludeThreads(4);
+    bounded.setIncludeReadAhead(1);
+    BOOST_CHECK_EQUAL(str(expected), str(bounded.parseFile(datafile, parseContext)));
+
+    fs::remove(test.root / "permz.inc");
+    parseContext.update(Opm::ParseContext::PARSE_MISSING_INCLUDE, Opm::InputError::THROW_EXCEPTION);
+    BOOST_CHECK_THROW(threaded.parseFile(datafile, parseContext), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ParserKeyword_deckCache) {
+    TestCase test;
+
+    test.write("CASE.DATA",
+               "FIELD\n"
+               "EQLDIMS\n"
+               "  1 /\n"
+               "EQUIL\n"
+               "  2469 382 1705 0 500 0 1 1 20 /\n"
+               "PERMX\n"
+               "  1.0 2*2.0 1* /\n"
+               "INCLUDE\n"
+               "  'poro.inc' /\n");
+    test.write("poro.inc", "PORO\n 4*0.25 /\n");
+
+    const auto datafile = test.path("CASE.DATA");
+    const auto cachefile = Opm::DeckCache::cacheFile(datafile);
+    BOOST_CHECK_EQUAL(cachefile, test.path("CASE.DECKCACHE"));
+
+    Opm::ParseContext parseContext;
+    Opm::Parser parser;
+    const auto expected = parser.parseFile(datafile, parseContext);
+    BOOST_CHECK(!fs::exists(cachefile));
+
+    parser.setDeckCache(true);
+    parser.parseFile(datafile, parseContext);
+    BOOST_CHECK(fs::exists(cachefile));
+
+    const auto deck = parser.parseFile(datafile, parseContext);
+    BOOST_CHECK_EQUAL(deck.size(), expected.size());
+    BOOST_CHECK_EQUAL(deck.getDataFile(), datafile);
+    BOOST_CHECK_EQUAL(deck.getInputPath(), expected.getInputPath());
+    BOOST_CHECK(deck.getActiveUnitSystem().getType() == Opm::UnitSystem::UnitType::UNIT_TYPE_FIELD);
+
+    BOOST_CHECK_EQUAL(str(expected), str(deck));
+
+    for (size_t i = 0; i < deck.size(); ++i) {
+        BOOST_CHECK(deck.getKeyword(i) == expected.getKeyword(i));
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getFileName(), expected.getKeyword(i).getFileName());
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getLineNumber(), expected.getKeyword(i).getLineNumber());
+    }
+
+    const auto& permx = deck.getKeyword("PERMX").getDataRecord().getDataItem();
+    BOOST_CHECK(!permx.defaultApplied(2));
+    BOOST_CHECK(permx.defaultApplied(3));
+    const auto& si = deck.getKeyword("PERMX").getSIDoubleData();
+    const auto& expected_si = expected.getKeyword("PERMX").getSIDoubleData();
+    BOOST_CHECK_EQUAL_COLLECTIONS(si.begin(), si.begin() + 3, expected_si.begin(), expected_si.begin() + 3);
+
+    /* an edited include invalidates the cache */
+    test.write("poro.inc", "PORO\n 4*0.30 /\n");
+    const auto edited = parser.parseFile(datafile, parseContext);
+    BOOST_CHECK_CLOSE(edited.getKeyword("PORO").getRawDoubleData()[ 0 ], 0.30, 1e-12);
+
+    /* a parser with another definition of a keyword does not use the cache */
+    {
+        Opm::Parser redefined;
+        redefined.addParserKeyword(Json::JsonObject(std::string(
+            "{\"name\" : \"PORO\", \"sections\" : [\"GRID\"], "
+            "\"data\" : {\"value_type\" : \"DOUBLE\", \"dimension\" : \"Length\"}}")));
+        redefined.setDeckCache(true);
+        const auto poro = redefined.parseFile(datafile, parseContext).getKeyword("PORO").getSIDoubleData();
+        BOOST_CHECK_CLOSE(poro[ 0 ], 0.30 * 0.3048, 1e-12);
+    }
+
+    /* the cache is keyed by the caller */
+    {
+        const std::vector< std::string > inputs = {
+            fs::canonical(datafile).string(),
+            fs::canonical(test.root / "poro.inc").string(),
+        };
+        const auto keyed = test.path("keyed.cache");
+        BOOST_CHECK(Opm::DeckCache::save(keyed, 17, inputs, expected));
+
+        Opm::Deck loaded;
+        BOOST_CHECK(!Opm::DeckCache::load(keyed, 18, loaded));
+        BOOST_CHECK_EQUAL(loaded.size(), 0U);
+        BOOST_CHECK(Opm::DeckCache::load(keyed, 17, loaded));
+        BOOST_CHECK_EQUAL(loaded.size(), expected.size());
+
+        /* a truncated cache is rejected */
+        fs::resize_file(keyed, fs::file_size(keyed) - 1);
+        Opm::Deck truncated;
+        BOOST_CHECK(!Opm::DeckCache::load(keyed, 17, truncated));
+        BOOST_CHECK_EQUAL(truncated.size(), 0U);
+    }
+
+    /* not even a corrupt cache stops the parser */
+    test.write("CASE.DECKCACHE", "OPMDECK");
+    BOOST_CHECK_EQUAL(parser.parseFile(datafile, parseContext).size(), expected.size());
+}
+
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeCache) {
+    TestCase test;
+
+    test.write("CASE.DATA",
+               "FIELD\n"
+               "EQLDIMS\n"
+               "  1 /\n"
+               "INCLUDE\n"
+               "  'equil.inc' /\n"
+               "INCLUDE\n"
+               "  'perm.inc' /\n"
+               "INCLUDE\n"
+               "  'poro.inc' /\n");
+    test.write("equil.inc", "EQUIL\n  2469 382 1705 0 500 0 1 1 20 /\n");
+    test.write("perm.inc", "PERMX\n  1.0 2*2.0 1* /\n");
+    test.write("poro.inc", "PORO\n 4*0.25 /\n");
+
+    const auto datafile = test.path("CASE.DATA");
+    const auto cachedir = Opm::DeckCache::includeCacheDir(datafile);
+    BOOST_CHECK_EQUAL(cachedir, test.path("CASE.INCLUDECACHE"));
+
+    const auto entry = [&test, &cachedir](const std::string& name) {
+        return Opm::DeckCache::includeCacheFile(cachedir, fs::canonical(test.root / name).string());
+    };
+
+    Opm::ParseContext parseContext;
+    Opm::Parser parser;
+    const auto expected = parser.parseFile(datafile, parseContext);
+
+    parser.setIncludeCache(true);
+    parser.parseFile(datafile, parseContext);
+    BOOST_CHECK(fs::exists(entry("perm.inc")));
+    BOOST_CHECK(fs::exists(entry("poro.inc")));
+
+    /* EQUIL is sized by EQLDIMS */
+    BOOST_CHECK(!fs::exists(entry("equil.inc")));
+
+    const auto deck = parser.parseFile(datafile, parseContext);
+    BOOST_REQUIRE_EQUAL(deck.size(), expected.size());
+    for (size_t i = 0; i < deck.size(); ++i) {
+        BOOST_CHECK(deck.getKeyword(i) == expected.getKeyword(i));
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getFileName(), expected.getKeyword(i).getFileName());
+        BOOST_CHECK_EQUAL(deck.getKeyword(i).getLineNumber(), expected.getKeyword(i).getLineNumber());
+    }
+
+    const auto& si = deck.getKeyword("PERMX").getSIDoubleData();
+    const auto& expected_si = expected.getKeyword("PERMX").getSIDoubleData();
+    BOOST_CHECK_EQUAL_COLLECTIONS(si.begin(), si.begin() + 3, expected_si.begin(), expected_si.begin() + 3);
+
+    /* only the edited include is parsed again */
+    test.write("poro.inc", "PORO\n 4*0.30 /\n");
+    const auto edited = parser.parseFile(datafile, parseContext);
+    BOOST_CHECK_CLOSE(edited.getKeyword("PORO").getRawDoubleData()[ 0 ], 0.30, 1e-12);
+    BOOST_CHECK(edited.getKeyword("PERMX") == expected.getKeyword("PERMX"));
+
+    /* a corrupt entry is parsed again and replaced */
+    {
+        std::ofstream of(entry("perm.inc"));
+        of << "OPMINCL";
+    }
+    BOOST_CHECK(parser.parseFile(datafile, parseContext).getKeyword("PERMX") == expected.getKeyword("PERMX"));
+    BOOST_CHECK(fs::file_size(entry("perm.inc")) > 7);
+}
+
+BOOST_AUTO_TEST_CASE(ParserKeyword_parseProfile) {
+    TestCase test;
+
+    test.write("case.data",
+               "EQLDIMS\n"
+               "  1 /\n"
+               "INCLUDE\n"
+               "  'permx.inc' /\n"
+               "INCLUDE\n"
+               "  'permx.inc' /\n"
+               "OIL\n");
+    test.write("permx.inc", "PERMX\n 1.0 2*2.0 3.0 /\n");
+
+    Opm::ParseProfile::reset();
+    Opm::ParseProfile::enable();
+    Opm::Parser().parseFile(test.path("case.data"), Opm::ParseContext());
+    Opm::ParseProfile::enable(false);
+
+    const auto report = Opm::ParseProfile::report();
+    const auto find = [](const std::vector<Opm::ParseProfile::Entry>& entries, const std::string& name) {
+        return std::find_if(entries.begin(), entries.end(),
+                            [&name](const Opm::ParseProfile::Entry& e) { return e.name == name; });
+    };
+
+    const auto kw = find(report.keywords, "PERMX");
+    BOOST_REQUIRE(kw != report.keywords.end());
+    BOOST_CHECK_EQUAL(kw->count, 2U);
+    BOOST_CHECK_EQUAL(kw->records, 2U);
+    BOOST_CHECK_EQUAL(kw->items, 6U);
+    BOOST_CHECK(kw->parse >= 0);
+    BOOST_CHECK(find(report.keywords, "INCLUDE") == report.keywords.end());
+
+    const auto inc = find(report.files, test.path("permx.inc"));
+    BOOST_REQUIRE(inc != report.files.end());
+    BOOST_CHECK_EQUAL(inc->count, 2U);
+    BOOST_CHECK(inc->bytes > 0);
+
+    const auto data = find(report.files, test.path("case.data"));
+    BOOST_REQUIRE(data != report.files.end());
+    BOOST_CHECK_EQUAL(data->count, 2U);
+
+    std::stringstream json;
+    Opm::ParseProfile::writeJSON(json);
+    BOOST_CHECK(json.str().find("\"name\": \"PERMX\"") != std::string::npos);
+
+    Opm::ParseProfile::reset();
+    BOOST_CHECK(Opm::ParseProfile::report().keywords.empty());
+}
@@ -20,17 +20,24 @@
 #define BOOST_TEST_MODULE ParserTests
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 #include <opm/json/JsonObject.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/DeckVisitor.hpp>
+#include <opm/parser/eclipse/Parser/KeywordBundle.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
+#include <opm/parser/eclipse/RawDeck/StarToken.hpp>
 
 using namespace Opm;
 
@@ -261,6 +268,49 @@ BOOST_AUTO_TEST_CASE(loadConfigFromDirectory_default) {
         BOOST_CHECK_EQUAL(true , parser.isRecognizedKeyword("DIMENS"));
 }
 
+BOOST_AUTO_TEST_CASE(KeywordBundle_compileAndLoad) {
+    const auto bundle = boost::filesystem::temp_directory_path()
+                      / boost::filesystem::unique_path( "%%%%-%%%%.kwbundle" );
+    KeywordBundle::compile( prefix() + "config/directory1", bundle.string() );
+
+    Parser parser( false );
+    parser.loadKeywordBundle( bundle );
+    BOOST_CHECK(parser.isRecognizedKeyword("WWCT"));
+    BOOST_CHECK(parser.isRecognizedKeyword("BPR"));
+    BOOST_CHECK(parser.isRecognizedKeyword("DIMENS"));
+
+    Parser json( false );
+    json.loadKeywordsFromDirectory( prefix() + "config/directory1" );
+    for (const auto& name : { "WWCT", "BPR", "DIMENS" })
+        BOOST_CHECK( *parser.getKeyword( name ) == *json.getKeyword( name ) );
+
+    boost::filesystem::remove( bundle );
+    BOOST_CHECK_THROW( KeywordBundle::compile( "path/does/not/exist", bundle.string() ), std::invalid_argument );
+    BOOST_CHECK_THROW( parser.loadKeywordBundle( prefix() + "config/directory1/WWCT" ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(KeywordBundle_builtinKeywords) {
+    Parser builtin;
+    std::set< const ParserKeyword* > unique;
+    for (const auto& name : builtin.getAllDeckNames())
+        unique.insert( builtin.getKeyword( name ) );
+
+    const std::vector< const ParserKeyword* > keywords( unique.begin(), unique.end() );
+    const auto bundle = boost::filesystem::temp_directory_path()
+                      / boost::filesystem::unique_path( "%%%%-%%%%.kwbundle" );
+    KeywordBundle::save( bundle.string(), keywords );
+
+    const auto loaded = KeywordBundle::load( bundle.string() );
+    boost::filesystem::remove( bundle );
+
+    BOOST_REQUIRE_EQUAL( loaded.size(), keywords.size() );
+    for (std::size_t index = 0; index < keywords.size(); ++index) {
+        BOOST_CHECK( *loaded[ index ] == *keywords[ index ] );
+        BOOST_CHECK_EQUAL( loaded[ index ]->getDescription(), keywords[ index ]->getDescription() );
+        BOOST_CHECK_EQUAL( loaded[ index ]->hasMatchRegex(), keywords[ index ]->hasMatchRegex() );
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ReplaceKeyword) {
     Parser parser;
     const auto* eqldims = parser.getParserKeywordFromDeckName("EQLDIMS");
@@ -273,6 +323,94 @@ BOOST_AUTO_TEST_CASE(ReplaceKeyword) {
 }
 
 
+BOOST_AUTO_TEST_CASE(DefaultKeywordsShared) {
+    Parser parser1;
+    Parser parser2;
+    const auto* eqldims = parser1.getParserKeywordFromDeckName("EQLDIMS");
+    BOOST_CHECK_EQUAL( eqldims, parser2.getParserKeywordFromDeckName("EQLDIMS") );
+    BOOST_CHECK_EQUAL( parser1.size(), parser2.size() );
+
+    BOOST_CHECK( parser1.loadKeywordFromFile( prefix() + "parser/EQLDIMS2" ) );
+    BOOST_CHECK( parser1.getParserKeywordFromDeckName("EQLDIMS")->getRecord(0).hasItem("NEW") );
+    BOOST_CHECK_EQUAL( eqldims, parser2.getParserKeywordFromDeckName("EQLDIMS") );
+    BOOST_CHECK_EQUAL( eqldims, Parser().getParserKeywordFromDeckName("EQLDIMS") );
+    BOOST_CHECK_EQUAL( parser1.size(), parser2.size() );
+
+    parser1.addParserKeyword( createDynamicSized( "FJAS" ) );
+    BOOST_CHECK( parser1.isRecognizedKeyword( "FJAS" ) );
+    BOOST_CHECK( !parser2.isRecognizedKeyword( "FJAS" ) );
+}
+
+
+namespace {
+
+struct KeywordCollector : public DeckVisitor {
+    std::set< std::string > parse;
+    std::string stop;
+    std::vector< std::pair< std::string, std::string > > selected;
+    std::vector< DeckKeyword > visited;
+
+    Action select( const std::string& keyword, const std::string& section ) override {
+        selected.emplace_back( keyword, section );
+        if( keyword == stop ) return Action::Stop;
+        return parse.count( keyword ) ? Action::Parse : Action::Skip;
+    }
+
+    bool visit( const DeckKeyword& keyword, const std::string& ) override {
+        visited.push_back( keyword );
+        return true;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(VisitKeywords) {
+    const std::string input = R"(
+RUNSPEC
+FIELD
+DIMENS
+ 10 10 10 /
+TABDIMS
+ 2 /
+GRID
+PORO
+ 1000*0.25 /
+PROPS
+SWOF
+ 0.1 0.0 1.0 0.0
+ 1.0 1.0 0.0 0.0 /
+ 0.2 0.0 1.0 0.0
+ 1.0 1.0 0.0 0.0 /
+SCHEDULE
+TSTEP
+ 10 /
+)";
+
+    Parser parser;
+    KeywordCollector collector;
+    collector.parse = { "DIMENS", "SWOF" };
+    collector.stop = "TSTEP";
+    parser.visitString( input, collector );
+
+    const std::vector< std::pair< std::string, std::string > > expected = {
+        { "RUNSPEC", "RUNSPEC" }, { "FIELD", "RUNSPEC" }, { "DIMENS", "RUNSPEC" },
+        { "TABDIMS", "RUNSPEC" }, { "GRID", "GRID" }, { "PORO", "GRID" },
+        { "PROPS", "PROPS" }, { "SWOF", "PROPS" }, { "SCHEDULE", "SCHEDULE" },
+        { "TSTEP", "SCHEDULE" }
+    };
+    BOOST_CHECK( collector.selected == expected );
+
+    BOOST_CHECK_EQUAL( collector.visited.size(), 2U );
+    BOOST_CHECK_EQUAL( collector.visited[0].name(), "DIMENS" );
+    BOOST_CHECK_EQUAL( collector.visited[0].getRecord(0).getItem(0).get< int >(0), 10 );
+
+    const auto& swof = collector.visited[1];
+    BOOST_CHECK_EQUAL( swof.name(), "SWOF" );
+    BOOST_CHECK_EQUAL( swof.size(), 2U );
+    BOOST_CHECK_CLOSE( swof.getRecord(1).getItem(0).getSIDouble(0), 0.2, 1e-12 );
+}
+
+
 BOOST_AUTO_TEST_CASE(WildCardTest) {
     Parser parser;
     BOOST_CHECK(!parser.isRecognizedKeyword("TVDP*"));
@@ -305,6 +443,25 @@ BOOST_AUTO_TEST_CASE( quoted_comments ) {
     BOOST_CHECK_EQUAL( Parser::stripComments("ABC'--'DEF'--GHI") , "ABC'--'DEF'--GHI");
 }
 
+BOOST_AUTO_TEST_CASE( comments_and_slashes_in_long_lines ) {
+    const auto* input_deck = "RUNSPEC\n"
+                             "-- a comment which is long enough to span several blocks / 'x\n"
+                             "DIMENS\n"
+                             "  10        10        10          / 1 2 3 -- after the slash\r\n"
+                             "GRID\n"
+                             "PORO\n"
+                             "  100*0.25   100*0.30  -- a comment after the data\n"
+                             "  800*0.20 /";
+
+    Parser parser;
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_RANDOM_TEXT , Opm::InputError::THROW_EXCEPTION );
+    const auto deck = parser.parseString( input_deck, parseContext );
+
+    BOOST_CHECK_EQUAL( 10, deck.getKeyword( "DIMENS" ).getRecord( 0 ).getItem( 2 ).get< int >( 0 ) );
+    BOOST_CHECK_EQUAL( 1000U, deck.getKeyword( "PORO" ).getDataSize() );
+}
+
 BOOST_AUTO_TEST_CASE( PATHS_has_global_scope ) {
     Parser parser;
     ParseContext parseContext;
@@ -434,6 +591,20 @@ BOOST_AUTO_TEST_CASE(scan_PreMatureTerminator_defaultUsed) {
     BOOST_CHECK_EQUAL(defaulted.get< int >(0), 123);
 }
 
+BOOST_AUTO_TEST_CASE(scan_SingleItem_reservesOneValue) {
+    ParserItem itemString("ITEM1", std::string("A"));
+    ParserItem itemDouble("ITEM2", 1.0);
+
+    RawRecord rawRecord( "'W1' 2.5 3 4 5 6 7 8 9 10 11 12" );
+    const auto name = itemString.scan(rawRecord);
+    const auto value = itemDouble.scan(rawRecord);
+
+    BOOST_CHECK_EQUAL(name.get< std::string >(0), "W1");
+    BOOST_CHECK_EQUAL(value.get< double >(0), 2.5);
+    BOOST_CHECK(name.memory_usage() < 2 * sizeof(std::string) + sizeof(std::vector< bool >::size_type));
+    BOOST_CHECK(value.memory_usage() < 2 * sizeof(double) + sizeof(std::vector< bool >::size_type));
+}
+
 BOOST_AUTO_TEST_CASE(InitializeIntItem_setDescription_canReadBack) {
     ParserItem itemInt("ITEM1");
     std::string description("This is the description");
@@ -660,6 +831,67 @@ BOOST_AUTO_TEST_CASE(Scan_All_WithDefaults) {
     BOOST_CHECK_EQUAL(25, deckIntItem.get< int >(21));
 }
 
+BOOST_AUTO_TEST_CASE(Scan_All_BulkDoubles) {
+    ParserItem itemDouble("ITEM", ParserItem::item_size::ALL);
+    itemDouble.setType( double() );
+
+    const std::vector< std::string > tokens = {
+        "1", "-2.5", "+.25", "3.", "1e3", "1.5D-2", "-7.25E+01", "0.1",
+        "123456789012345678", "1e300", "0.000000000000000000000000125",
+    };
+
+    std::string record_string;
+    for( const auto& token : tokens )
+        record_string += token + "\n\t ";
+    record_string += "3*0.5 2* ";
+
+    RawRecord rawRecord( record_string );
+    const auto item = itemDouble.scan( rawRecord );
+    BOOST_CHECK_EQUAL( 0U, rawRecord.size() );
+    BOOST_CHECK_EQUAL( tokens.size() + 5, item.size() );
+
+    for( size_t i = 0; i < tokens.size(); ++i ) {
+        BOOST_CHECK( !item.defaultApplied( i ) );
+        BOOST_CHECK_EQUAL( readValueToken< double >( tokens[ i ] ), item.get< double >( i ) );
+    }
+
+    BOOST_CHECK_EQUAL( 0.5, item.get< double >( tokens.size() + 2 ) );
+    BOOST_CHECK( !item.defaultApplied( tokens.size() + 2 ) );
+    BOOST_CHECK( item.defaultApplied( tokens.size() + 3 ) );
+    BOOST_CHECK( item.defaultApplied( tokens.size() + 4 ) );
+
+    RawRecord malformed( "1.0 2.0 1.0Q 4.0" );
+    BOOST_CHECK_THROW( itemDouble.scan( malformed ), std::invalid_argument );
+
+    RawRecord noCount( "1.0 *2.0" );
+    BOOST_CHECK_THROW( itemDouble.scan( noCount ), std::invalid_argument );
+
+    RawRecord quoted( "1.0 'abc def'" );
+    BOOST_CHECK_THROW( itemDouble.scan( quoted ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(Scan_All_BulkInts) {
+    ParserItem itemInt("ITEM", ParserItem::item_size::ALL);
+    itemInt.setType( int() );
+
+    RawRecord rawRecord( "-5 +7 2147483647 123456789 4*3\n 0 1*" );
+    const auto item = itemInt.scan( rawRecord );
+    BOOST_CHECK_EQUAL( 10U, item.size() );
+    BOOST_CHECK_EQUAL( -5, item.get< int >( 0 ) );
+    BOOST_CHECK_EQUAL( 7, item.get< int >( 1 ) );
+    BOOST_CHECK_EQUAL( 2147483647, item.get< int >( 2 ) );
+    BOOST_CHECK_EQUAL( 123456789, item.get< int >( 3 ) );
+    BOOST_CHECK_EQUAL( 3, item.get< int >( 7 ) );
+    BOOST_CHECK_EQUAL( 0, item.get< int >( 8 ) );
+    BOOST_CHECK( item.defaultApplied( 9 ) );
+
+    RawRecord overflow( "1 2147483648" );
+    BOOST_CHECK_THROW( itemInt.scan( overflow ), std::invalid_argument );
+
+    RawRecord fraction( "1 2.5" );
+    BOOST_CHECK_THROW( itemInt.scan( fraction ), std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_CASE(Scan_SINGLE_CorrectIntSetInDeckItem) {
     ParserItem itemInt(std::string("ITEM2"), 0);
 
@@ -1365,6 +1597,31 @@ BOOST_AUTO_TEST_CASE(ParserKeywordMatches) {
     BOOST_CHECK_EQUAL( false , parserKeyword->matches("WORLDIAMTOOLONG"));
 }
 
+BOOST_AUTO_TEST_CASE(ParserKeywordMatchesAlternativesAndClasses) {
+    const auto& parserKeyword = createFixedSized("HELLO", (size_t) 1);
+    parserKeyword->clearDeckNames();
+    parserKeyword->setMatchRegex("[AB]FOO.*|(ZAP|ZIP)[1-9]");
+    BOOST_CHECK( parserKeyword->matches("AFOO"));
+    BOOST_CHECK( parserKeyword->matches("BFOOBAR"));
+    BOOST_CHECK( parserKeyword->matches("ZIP3"));
+    BOOST_CHECK(!parserKeyword->matches("CFOO"));
+    BOOST_CHECK(!parserKeyword->matches("ZOP3"));
+    BOOST_CHECK(!parserKeyword->matches("FOO"));
+
+    /* replacing the expression also replaces the first character filter */
+    parserKeyword->setMatchRegex("CFOO.*");
+    BOOST_CHECK( parserKeyword->matches("CFOO"));
+    BOOST_CHECK(!parserKeyword->matches("AFOO"));
+
+    Parser parser;
+    BOOST_CHECK( parser.isRecognizedKeyword("TBLKFA1"));
+    BOOST_CHECK(!parser.isRecognizedKeyword("TBLKXA1"));
+    BOOST_CHECK( parser.isRecognizedKeyword("WUFOO"));
+    BOOST_CHECK( parser.isRecognizedKeyword("WOFWC12"));
+    BOOST_CHECK_EQUAL( parser.getParserKeywordFromDeckName("RPR__ABC")->getName(),
+                       parser.getParserKeywordFromDeckName("RUFOO")->getName() );
+}
+
 BOOST_AUTO_TEST_CASE(AddDataKeyword_correctlyConfigured) {
     const auto& parserKeyword = createFixedSized("PORO", (size_t) 1);
     ParserItem item( "ACTNUM" , ParserItem::item_size::ALL, 0 );
@@ -2052,3 +2309,44 @@ DENSITY
         BOOST_CHECK_CLOSE( pbub.getSIDouble( 0 ), 6.515545642044100e+06, 1.0e-10 );
     }
 }
+
+BOOST_AUTO_TEST_CASE(ParseConcurrentlyWithSharedParser) {
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+  10 10 10 /
+GRID
+PORO
+  1000*0.25 /
+SUMMARY
+GUOPR
+  'G1' 'G2' /
+)";
+
+    const Parser parser;
+    ParseContext parseContext;
+    parseContext.update(ParseContext::PARSE_MISSING_SECTIONS, InputError::IGNORE);
+    const auto reference = parser.parseString(input, parseContext);
+    BOOST_REQUIRE( reference.hasKeyword("GUOPR") );
+
+    const auto same = [&reference](const Deck& deck) {
+        return deck.size() == reference.size()
+            && deck.hasKeyword("GUOPR")
+            && deck.getKeyword("GUOPR").getRecord(0).getItem(0).getData< std::string >()
+               == reference.getKeyword("GUOPR").getRecord(0).getItem(0).getData< std::string >()
+            && deck.getKeyword("PORO").getSIDoubleData() == reference.getKeyword("PORO").getSIDoubleData();
+    };
+
+    const size_t numThreads = std::max(size_t{ 4 }, size_t{ std::thread::hardware_concurrency() });
+    std::vector< std::future< bool > > parses;
+    for (size_t t = 0; t < numThreads; ++t)
+        parses.push_back( std::async( std::launch::async, [&]() {
+            bool ok = true;
+            for (int i = 0; i < 16; ++i)
+                ok = same( parser.parseString(input, parseContext) ) && ok;
+            return ok;
+        }));
+
+    for (auto& parse : parses)
+        BOOST_CHECK( parse.get() );
+}
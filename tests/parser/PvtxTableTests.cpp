@@ -31,6 +31,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/PvtxTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableEvaluator.hpp>
 
 // keyword specific table classes
 //#include <opm/parser/eclipse/EclipseState/Tables/PvtoTable.hpp>
@@ -166,6 +167,40 @@ BOOST_AUTO_TEST_CASE( PVTOSaturatedTable ) {
 }
 
 
+BOOST_AUTO_TEST_CASE( PVTOEvaluator ) {
+    Parser parser;
+    boost::filesystem::path deckFile(prefix() + "TABLES/PVTX1.DATA");
+    ParseContext parseContext;
+    auto deck =  parser.parseFile(deckFile.string(), parseContext);
+    Opm::TableManager tables(deck);
+    const auto& pvtoTable = tables.getPvtoTables( )[0];
+    UnitSystem units( UnitSystem::UnitType::UNIT_TYPE_METRIC );
+
+    PvtxEvaluator bo( pvtoTable , "BO" );
+    BOOST_CHECK_THROW( PvtxEvaluator( pvtoTable , "XX" ), std::invalid_argument );
+
+    std::vector<double> rs;
+    std::vector<double> p;
+    for (double rs_value : {10.0 , 20.59 , 24.0 , 28.19 , 40.0}) {
+        for (double p_value : {40.0 , 50.0 , 80.0 , 125.0 , 160.0 , 200.0}) {
+            rs.push_back( rs_value );
+            p.push_back( units.to_si( UnitSystem::measure::pressure , p_value ) );
+        }
+    }
+
+    std::vector<double> values;
+    bo.evaluate( rs , p , values );
+    for (size_t i = 0; i < rs.size(); i++) {
+        BOOST_CHECK_CLOSE( bo( rs[i] , p[i] ) , pvtoTable.evaluate( "BO" , rs[i] , p[i] ) , 1e-10 );
+        BOOST_CHECK_CLOSE( values[i] , pvtoTable.evaluate( "BO" , rs[i] , p[i] ) , 1e-10 );
+    }
+
+    bo.resample( 1001 );
+    for (size_t i = 0; i < rs.size(); i++)
+        BOOST_CHECK_CLOSE( bo( rs[i] , p[i] ) , pvtoTable.evaluate( "BO" , rs[i] , p[i] ) , 1e-2 );
+}
+
+
 BOOST_AUTO_TEST_CASE( PVTGSaturatedTable ) {
     Parser parser;
     boost::filesystem::path deckFile(prefix() + "TABLES/PVTX1.DATA");
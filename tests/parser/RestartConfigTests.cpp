@@ -1095,3 +1095,53 @@ BOOST_AUTO_TEST_CASE(RESTART_SAVE) {
 
 }
 
+
+
+BOOST_AUTO_TEST_CASE(SELECTED_KEYWORDS) {
+    const char* data =
+                          "RUNSPEC\n"
+                          "DIMENS\n"
+                          " 10 10 10 /\n"
+                          "GRID\n"
+                          "START             -- 0 \n"
+                          "19 JUN 2007 / \n"
+                          "SCHEDULE\n"
+                          "DATES             -- 1\n"
+                          " 10  OKT 2008 / \n"
+                          "/\n"
+                          "RPTRST\n"
+                          "BASIC=3 FREQ=2 FLOWS\n"
+                          "/\n"
+                          "DATES             -- 2\n"
+                          " 20  JAN 2010 / \n"
+                          "/\n"
+                          "DATES             -- 3\n"
+                          " 20  JAN 2011 / \n"
+                          "/\n";
+
+    ParseContext ctx;
+    auto deck = Parser().parseString( data, ctx );
+    RestartConfig rstConfig( deck, ctx );
+
+    BOOST_CHECK( rstConfig.getSelectedKeywords( 0 ).empty() );
+
+    const std::vector< std::string > expected = { "BASIC", "FLOWS", "FREQ" };
+    for (size_t step : { 1, 2, 3 }) {
+        const auto& selected = rstConfig.getSelectedKeywords( step );
+        BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(),
+                                       selected.begin(), selected.end() );
+    }
+
+    /* Steps without a change of settings share the same list. */
+    BOOST_CHECK_EQUAL( &rstConfig.getSelectedKeywords( 1 ), &rstConfig.getSelectedKeywords( 3 ) );
+    BOOST_CHECK_THROW( rstConfig.getSelectedKeywords( 4 ), std::out_of_range );
+
+    /* The plan follows an override of the write interval. */
+    rstConfig.overrideRestartWriteInterval( 1 );
+    for (size_t step = 0; step < 4; step++)
+        BOOST_CHECK( rstConfig.getWriteRestartFile( step ) );
+
+    rstConfig.overrideRestartWriteInterval( 0 );
+    for (size_t step = 0; step < 4; step++)
+        BOOST_CHECK( !rstConfig.getWriteRestartFile( step ) );
+}
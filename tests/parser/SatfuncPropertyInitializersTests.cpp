@@ -152,3 +152,56 @@ BOOST_AUTO_TEST_CASE(SaturationFunctionFamilyTests) {
     Opm::Eclipse3DProperties propMix( deckMix, tmMix, gridMix );
     BOOST_CHECK_THROW(propMix.getDoubleGridProperty("SGCR") , std::invalid_argument);
 }
+
+BOOST_AUTO_TEST_CASE(EndpointVersusDepth) {
+    const char * deckData =
+            "RUNSPEC\n"
+            "OIL\n"
+            "WATER\n"
+            "DIMENS\n"
+            " 1 1 3 /\n"
+            "TABDIMS\n"
+            "1 /\n"
+            "ENDSCALE\n"
+            "2* 1 /\n"
+            "\n"
+            "GRID\n"
+            "DX\n"
+            "3*100 /\n"
+            "DY\n"
+            "3*100 /\n"
+            "DZ\n"
+            "3*1000 /\n"
+            "TOPS\n"
+            "1*2500 /\n"
+            "PORO \n"
+            "3*0.10 /\n"
+            "PERMX \n"
+            "3*10.25 /\n"
+            "PROPS\n"
+            "SWOF\n"
+            " .2  .0 1.0 .0\n"
+            " .3  .0  .8 .0\n"
+            " .5  .5  .5 .0\n"
+            " .8  .8  .0 .0\n"
+            " 1.0 1.0 .0 .0 /\n"
+            "ENPTVD\n"
+            "3000.0 0.20 0.20 1.0 0.0 0.04 1.0 0.18 0.22\n"
+            "9000.0 0.26 0.26 1.0 0.0 0.04 1.0 0.18 0.22 /\n";
+
+    Deck deck = Parser().parseString(deckData, ParseContext());
+    Opm::TableManager tm( deck );
+    Opm::EclipseGrid grid( deck );
+    Opm::Eclipse3DProperties props( deck, tm, grid );
+
+    /* The cell centres are at 3000, 4000 and 5000 metres. */
+    const auto& swl = props.getDoubleGridProperty("SWL").getData();
+    BOOST_CHECK_CLOSE( swl[0], 0.20, 1e-8 );
+    BOOST_CHECK_CLOSE( swl[1], 0.21, 1e-8 );
+    BOOST_CHECK_CLOSE( swl[2], 0.22, 1e-8 );
+
+    /* The imbibition end points do not use ENPTVD. */
+    const auto& iswl = props.getDoubleGridProperty("ISWL").getData();
+    for (const auto value : iswl)
+        BOOST_CHECK_CLOSE( value, 0.2, 1e-8 );
+}
@@ -547,6 +547,49 @@ BOOST_AUTO_TEST_CASE(WellsIteratorWithRegex_HasWells_WellsReturned) {
     BOOST_CHECK_EQUAL(1U, wells.size());
 }
 
+BOOST_AUTO_TEST_CASE(WellsPatternMatchesLaterWells) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "10 MAI 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "     \'W_1\'        \'OP\'   30   37  3.33       \'OIL\'  7* /   \n"
+            "     \'X_1\'        \'OP\'   30   37  3.33       \'OIL\'  7* /   \n"
+            "/ \n"
+            "WELOPEN\n"
+            " 'W_*' OPEN / \n"
+            "/\n"
+            "DATES             -- 1\n"
+            " 10  \'JUN\'  2007 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "     \'W_2\'        \'OP\'   30   37  3.33       \'OIL\'  7* /   \n"
+            "/\n"
+            "WELOPEN\n"
+            " 'W_*' SHUT / \n"
+            "/\n";
+
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid , eclipseProperties, runspec , ParseContext());
+
+    BOOST_CHECK_EQUAL(WellCommon::StatusEnum::OPEN, schedule.getWell("W_1")->getStatus(0));
+    BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, schedule.getWell("W_1")->getStatus(1));
+    BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, schedule.getWell("W_2")->getStatus(1));
+    BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, schedule.getWell("X_1")->getStatus(0));
+
+    BOOST_CHECK_EQUAL(2U, schedule.getWellsMatching("W_*").size());
+    BOOST_CHECK_EQUAL(2U, schedule.getWellsMatching("?_1*").size());
+    BOOST_CHECK_EQUAL(3U, schedule.getWellsMatching("*").size());
+
+    const Schedule copy( schedule );
+    BOOST_CHECK_EQUAL(2U, copy.getWellsMatching("W_*").size());
+}
+
 BOOST_AUTO_TEST_CASE(ReturnNumWellsTimestep) {
     EclipseGrid grid(10,10,10);
     auto deck = createDeckWithWells();
@@ -561,6 +604,33 @@ BOOST_AUTO_TEST_CASE(ReturnNumWellsTimestep) {
     BOOST_CHECK_EQUAL(schedule.numWells(3), 3);
 }
 
+BOOST_AUTO_TEST_CASE(StepIndexWellLists) {
+    EclipseGrid grid(10,10,10);
+    auto deck = createDeckWithWells();
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid , eclipseProperties, runspec , ParseContext());
+
+    // Report steps where nothing changed share the same list.
+    BOOST_CHECK( &schedule.getWells(0U) == &schedule.getWells(2U) );
+    BOOST_CHECK( &schedule.getWells(2U) != &schedule.getWells(3U) );
+
+    BOOST_CHECK_EQUAL( schedule.getChangedWells(1).size(), 0U );
+    BOOST_CHECK_EQUAL( schedule.getChangedWells(2).size(), 0U );
+
+    const auto& changed = schedule.getChangedWells(3);
+    BOOST_CHECK_EQUAL( changed.size(), 2U );
+    for (const auto* well : changed)
+        BOOST_CHECK( well->hasEvent( ScheduleEvents::NEW_WELL, 3 ));
+
+    // A copy indexes its own wells.
+    Schedule copy( schedule );
+    BOOST_CHECK_EQUAL( copy.getWells(3).size(), 3U );
+    BOOST_CHECK( copy.getWells(3)[0] == copy.getWell("W_1") );
+    BOOST_CHECK( schedule.getWells(3)[0] == schedule.getWell("W_1") );
+}
+
 BOOST_AUTO_TEST_CASE(ReturnMaxNumCompletionsForWellsInTimestep) {
     EclipseGrid grid(10,10,10);
     auto deck = createDeckWithWellsAndCompletionData();
@@ -1965,8 +2035,10 @@ BOOST_AUTO_TEST_CASE( complump ) {
     BOOST_CHECK_EQUAL( open, sc1.getFromIJK( 2, 2, 2 ).state() );
     BOOST_CHECK_EQUAL( shut, sc1.getFromIJK( 2, 2, 3 ).state() );
 
-    const auto completions = well.getCompletions(1);
+    const auto& completions = well.getCompletions(1);
     BOOST_CHECK_EQUAL(completions.size(), 4);
+    BOOST_CHECK( &completions == &well.getCompletions(1) );
+    BOOST_CHECK( &completions != &well.getCompletions(0) );
 
     const auto& c1 = completions.at(1);
     BOOST_CHECK_EQUAL(c1.size(), 3);
@@ -2532,6 +2604,54 @@ BOOST_AUTO_TEST_CASE(handleWEFAC) {
 
 }
 
+BOOST_AUTO_TEST_CASE(WellGroupEvents) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "DATES             -- 1\n"
+            " 10  OKT 2008 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "DATES             -- 2\n"
+            " 15  OKT 2008 / \n"
+            "/\n"
+            "GEFAC\n"
+            "   'OP' 0.5 / \n"
+            "/\n"
+            "DATES             -- 3\n"
+            " 18  OKT 2008 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "DATES             -- 4\n"
+            " 20  OKT 2008 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'P'       'G2'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            ;
+
+    ParseContext parseContext;
+    auto deck = parser.parseString(input, parseContext);
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid , eclipseProperties, runspec , parseContext);
+    const auto& events = schedule.getEvents();
+
+    BOOST_CHECK( !events.hasEvent( ScheduleEvents::EFFICIENCY_UPDATE, 1 ));
+    BOOST_CHECK(  events.hasEvent( ScheduleEvents::EFFICIENCY_UPDATE, 2 ));
+    BOOST_CHECK( !events.hasEvent( ScheduleEvents::WELL_GROUP_CHANGE, 1 ));
+    BOOST_CHECK( !events.hasEvent( ScheduleEvents::WELL_GROUP_CHANGE, 3 ));
+    BOOST_CHECK(  events.hasEvent( ScheduleEvents::WELL_GROUP_CHANGE, 4 ));
+}
+
 BOOST_AUTO_TEST_CASE(historic_BHP_and_THP) {
     Opm::Parser parser;
     std::string input =
@@ -2694,6 +2814,11 @@ VFPINJ \n                                       \
 
     const auto vfp_tables2 = schedule.getVFPInjTables(2);
     BOOST_CHECK_EQUAL( vfp_tables2.size(), 2);
+
+    // Report steps without VFP changes share the map.
+    BOOST_CHECK( &schedule.getVFPInjTables(0) == &schedule.getVFPInjTables(1) );
+    BOOST_CHECK( &schedule.getVFPInjTables(1) != &schedule.getVFPInjTables(2) );
+    BOOST_CHECK( schedule.getVFPProdTables(2).empty() );
     //Flo axis
     {
         const std::vector<double>& flo = vfpinjTable.getFloAxis();
@@ -2827,3 +2952,167 @@ BOOST_AUTO_TEST_CASE(WTEST_CONFIG) {
     BOOST_CHECK(wtest_config2.has("BAN", WellTestConfig::Reason::GROUP));
     BOOST_CHECK(!wtest_config2.has("BAN", WellTestConfig::Reason::PHYSICAL));
 }
+
+
+BOOST_AUTO_TEST_CASE(RESTART_STEP) {
+    Parser parser;
+    std::string input =
+        "START             -- 0 \n"
+        "19 JUN 2007 / \n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        "     'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+        "/\n"
+        "COMPDAT\n"
+        " 'P'  9  9   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+        "/\n"
+        "WCONPROD\n"
+        " 'P' 'OPEN' 'ORAT' 100 / \n"
+        "/\n"
+        "DATES             -- 1\n"
+        " 10  JUL 2007 / \n"
+        "/\n"
+        "WCONPROD\n"
+        " 'P' 'OPEN' 'ORAT' 200 / \n"
+        "/\n"
+        "DATES             -- 2\n"
+        " 10  AUG 2007 / \n"
+        "/\n"
+        "WCONPROD\n"
+        " 'P' 'OPEN' 'ORAT' 300 / \n"
+        "/\n"
+        "DATES             -- 3\n"
+        " 10  SEP 2007 / \n"
+        "/\n"
+        "WCONPROD\n"
+        " 'P' 'OPEN' 'ORAT' 400 / \n"
+        "/\n"
+        "DATES             -- 4\n"
+        " 10  OCT 2007 / \n"
+        "/\n";
+
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule full(deck, grid, eclipseProperties, runspec, ParseContext());
+    Schedule restart(deck, grid, eclipseProperties, runspec, ParseContext(), 2);
+
+    BOOST_CHECK_EQUAL(restart.restartStep(), 2);
+    BOOST_CHECK_EQUAL(restart.getTimeMap().size(), full.getTimeMap().size());
+
+    const auto* full_well = full.getWell("P");
+    const auto* restart_well = restart.getWell("P");
+    for (size_t step = 2; step < full.getTimeMap().size(); step++)
+        BOOST_CHECK(full_well->getProductionProperties(step) == restart_well->getProductionProperties(step));
+
+    BOOST_CHECK_EQUAL(restart_well->getProductionProperties(0).OilRate, full_well->getProductionProperties(1).OilRate);
+    BOOST_CHECK_EQUAL(restart_well->getProductionProperties(1).OilRate, full_well->getProductionProperties(1).OilRate);
+    BOOST_CHECK(full_well->hasEvent(ScheduleEvents::PRODUCTION_UPDATE, 1));
+    BOOST_CHECK(!restart_well->hasEvent(ScheduleEvents::PRODUCTION_UPDATE, 1));
+    BOOST_CHECK(restart_well->hasEvent(ScheduleEvents::PRODUCTION_UPDATE, 2));
+}
+
+BOOST_AUTO_TEST_CASE(WELL_GROUP_INDEX) {
+    Parser parser;
+    std::string input =
+        "START             -- 0 \n"
+        "19 JUN 2007 / \n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        "     'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+        "     'I'       'IN'   1   1 1*     'WATER' 1*    1*  1*   1*  1*   1*  1*  / \n"
+        "/\n"
+        "DATES             -- 1\n"
+        " 10  JUL 2007 / \n"
+        "/\n"
+        "WELSPECS\n"
+        "     'Q'       'OP'   5   5 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+        "/\n";
+
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid, eclipseProperties, runspec, ParseContext());
+
+    const std::vector<std::string> wells = {"P", "I", "Q"};
+    BOOST_CHECK(schedule.wellNames() == wells);
+    for (size_t index = 0; index < wells.size(); index++) {
+        BOOST_CHECK_EQUAL(schedule.wellIndex(wells[index]), index);
+        BOOST_CHECK_EQUAL(schedule.getWell(index), schedule.getWell(wells[index]));
+    }
+    BOOST_CHECK_THROW(schedule.wellIndex("X"), std::invalid_argument);
+    BOOST_CHECK_THROW(schedule.getWell(size_t(3)), std::invalid_argument);
+
+    const auto groups = schedule.groupNames();
+    BOOST_CHECK_EQUAL(groups.size(), schedule.numGroups());
+    for (size_t index = 0; index < groups.size(); index++) {
+        BOOST_CHECK_EQUAL(schedule.groupIndex(groups[index]), index);
+        BOOST_CHECK_EQUAL(&schedule.getGroup(index), &schedule.getGroup(groups[index]));
+    }
+
+    SummaryState st;
+    const auto wopr = st.well_var_index(wells, "WOPR");
+    st.set(wopr[schedule.wellIndex("Q")], 10);
+    BOOST_CHECK_EQUAL(st.get_well_var("Q", "WOPR"), 10);
+    BOOST_CHECK_EQUAL(wopr[2], st.well_var_index("Q", "WOPR"));
+}
+
+BOOST_AUTO_TEST_CASE(SCHEDULE_FINGERPRINT) {
+    const auto input = [](const std::string& rate) {
+        return std::string(
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "     'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'P'  9  9   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+            "/\n"
+            "WCONPROD\n"
+            " 'P' 'OPEN' 'ORAT' 100 / \n"
+            "/\n"
+            "DATES             -- 1\n"
+            " 10  JUL 2007 / \n"
+            "/\n"
+            "WCONPROD\n"
+            " 'P' 'OPEN' 'ORAT' ") + rate + " / \n"
+            "/\n"
+            "DATES             -- 2\n"
+            " 10  AUG 2007 / \n"
+            "/\n";
+    };
+
+    Parser parser;
+    const auto schedule = [&parser](const std::string& data) {
+        auto deck = parser.parseString(data, ParseContext());
+        EclipseGrid grid(10,10,10);
+        TableManager table ( deck );
+        Eclipse3DProperties eclipseProperties ( deck , table, grid);
+        Runspec runspec (deck);
+        return Schedule(deck, grid, eclipseProperties, runspec, ParseContext());
+    };
+
+    const auto sched1 = schedule(input("200"));
+    const auto sched2 = schedule(input("200"));
+    const auto sched3 = schedule(input("250"));
+
+    BOOST_CHECK(sched1.fingerprint() == sched2.fingerprint());
+    BOOST_CHECK(sched1.fingerprint() != sched3.fingerprint());
+
+    const auto* well1 = sched1.getWell("P");
+    const auto* well3 = sched3.getWell("P");
+    BOOST_CHECK(well1->fingerprint(0) == well3->fingerprint(0));
+    BOOST_CHECK(well1->fingerprint(1) != well3->fingerprint(1));
+    BOOST_CHECK(well1->fingerprint(1) != well1->fingerprint(0));
+    BOOST_CHECK(well1->fingerprint(2) == well1->fingerprint(1));
+
+    BOOST_CHECK(sched1.fingerprint(0) == sched3.fingerprint(0));
+    BOOST_CHECK(sched1.fingerprint(1) != sched3.fingerprint(1));
+    BOOST_CHECK(sched1.fingerprint(2) != sched3.fingerprint(2));
+    BOOST_CHECK_THROW(sched1.fingerprint(3), std::out_of_range);
+}
@@ -0,0 +1,134 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE SectionIndexTests
+
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/SectionIndex.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+#include <ert/util/test_work_area.h>
+
+using namespace Opm;
+
+namespace {
+
+std::string write( const std::string& name, const std::string& content ) {
+    std::ofstream of( name );
+    of << content;
+    return name;
+}
+
+std::string path( const std::string& name ) {
+    return boost::filesystem::canonical( name ).string();
+}
+
+/* Writes the deck in the current test work area, and returns the name
+   of the data file. */
+std::string writeCase() {
+    /* Random text, which fails the parse if the file is read. */
+    write( "grid.inc", "PORO\n 4*0.25 /\nnot an ECLIPSE keyword\n" );
+    write( "schedule.inc", "SCHEDULE\nTSTEP\n 10 /\n" );
+
+    return write( "CASE.DATA",
+                  "RUNSPEC\n"
+                  "DIMENS\n"
+                  " 2 2 1 /\n"
+                  "FIELD\n"
+                  "EQLDIMS\n"
+                  "/\n"
+                  "GRID   -- the grid\n"
+                  "INCLUDE\n"
+                  " 'grid.inc' /\n"
+                  "PROPS\n"
+                  "SOLUTION\n"
+                  "EQUIL\n"
+                  " 2000 200 2100 0 0 /\n"
+                  "INCLUDE\n"
+                  " 'schedule.inc' /\n" );
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(IndexSectionsAcrossIncludes) {
+    test_work_area_type * work_area = test_work_area_alloc("section_index");
+    SectionIndex index( writeCase() );
+
+    const auto& entries = index.entries();
+    BOOST_REQUIRE_EQUAL( entries.size(), 5U );
+    BOOST_CHECK_EQUAL( entries[ 0 ].section, "RUNSPEC" );
+    BOOST_CHECK_EQUAL( entries[ 0 ].offset, 0U );
+    BOOST_CHECK_EQUAL( entries[ 1 ].section, "GRID" );
+    BOOST_CHECK_EQUAL( entries[ 1 ].line, 7U );
+    BOOST_CHECK_EQUAL( entries[ 1 ].offset, std::string( "RUNSPEC\nDIMENS\n 2 2 1 /\nFIELD\nEQLDIMS\n/\n" ).size() );
+    BOOST_CHECK_EQUAL( entries[ 1 ].file, path( "CASE.DATA" ) );
+
+    const auto schedule = index.find( "SCHEDULE" );
+    BOOST_REQUIRE_EQUAL( schedule.size(), 1U );
+    BOOST_CHECK_EQUAL( schedule[ 0 ].file, path( "schedule.inc" ) );
+    BOOST_CHECK_EQUAL( schedule[ 0 ].line, 1U );
+    BOOST_CHECK( index.find( "EDIT" ).empty() );
+
+    BOOST_CHECK_EQUAL( index.files().size(), 3U );
+    BOOST_CHECK( index.contains( path( "grid.inc" ), { "PORO" } ) );
+    BOOST_CHECK( !index.contains( path( "grid.inc" ), { "SCHEDULE", "EQLDIMS" } ) );
+    BOOST_CHECK( index.contains( path( "CASE.DATA" ), { "TSTEP" } ) );
+    BOOST_CHECK( index.contains( "not/scanned.inc", { "TSTEP" } ) );
+
+    BOOST_CHECK_THROW( SectionIndex( "MISSING.DATA" ), std::invalid_argument );
+
+    test_work_area_free( work_area );
+}
+
+
+BOOST_AUTO_TEST_CASE(ParseSelectedSections) {
+    test_work_area_type * work_area = test_work_area_alloc("section_index_parse");
+    const auto datafile = writeCase();
+    Parser parser;
+
+    BOOST_CHECK_THROW( parser.parseFile( datafile ), std::invalid_argument );
+
+    const auto deck = parser.parseSections( datafile, { "SOLUTION", "SCHEDULE" } );
+    for (const auto* section : { "RUNSPEC", "GRID", "PROPS", "SOLUTION", "SCHEDULE" })
+        BOOST_CHECK( deck.hasKeyword( section ) );
+
+    BOOST_CHECK( deck.hasKeyword( "EQUIL" ) );
+    BOOST_CHECK( deck.hasKeyword( "TSTEP" ) );
+    BOOST_CHECK( deck.hasKeyword( "EQLDIMS" ) );
+    BOOST_CHECK( !deck.hasKeyword( "DIMENS" ) );
+    BOOST_CHECK( !deck.hasKeyword( "PORO" ) );
+    BOOST_CHECK( deck.getActiveUnitSystem().getType() == UnitSystem::UnitType::UNIT_TYPE_FIELD );
+
+    const auto grid = parser.parseSections( datafile, { "RUNSPEC" } );
+    BOOST_CHECK( grid.hasKeyword( "DIMENS" ) );
+    BOOST_CHECK( !grid.hasKeyword( "EQUIL" ) );
+    BOOST_CHECK( !grid.hasKeyword( "TSTEP" ) );
+
+    BOOST_CHECK_THROW( parser.parseSections( datafile, { "WELLS" } ), std::invalid_argument );
+
+    test_work_area_free( work_area );
+}
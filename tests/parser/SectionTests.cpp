@@ -378,3 +378,62 @@ BOOST_AUTO_TEST_CASE(Section_InvalidDecks) {
 
     BOOST_CHECK(!Opm::Section::checkSectionTopology( parser.parseString( missing_SCHEDULE, mode ), parser));
 }
+
+BOOST_AUTO_TEST_CASE(Section_LargeDeck) {
+    Parser parser;
+    ParseContext mode { { { ParseContext::PARSE_UNKNOWN_KEYWORD, InputError::IGNORE } } };
+
+    // Long enough to be checked in parallel ranges.
+    std::string sections = "RUNSPEC\nOIL\nGRID\n";
+    for (int i = 0; i < 20000; i++)
+        sections += "ECHO\n";
+    sections += "PROPS\nSOLUTION\nSCHEDULE\n";
+
+    auto deck = parser.parseString( sections, mode );
+    BOOST_CHECK( Opm::Section::checkSectionTopology( deck, parser, true ) );
+
+    const auto offsets = Opm::Section::sectionOffsets( deck );
+    BOOST_CHECK_EQUAL( offsets.size(), 5U );
+    BOOST_CHECK_EQUAL( offsets[0], 0U );
+    BOOST_CHECK_EQUAL( offsets[1], 2U );
+    BOOST_CHECK_EQUAL( offsets[4], deck.size() - 1 );
+
+    GRIDSection grid( deck );
+    BOOST_CHECK_EQUAL( grid.size(), 20001U );
+    BOOST_CHECK_EQUAL( grid.count( "ECHO" ), 20000U );
+
+    // OIL is only valid in RUNSPEC
+    auto misplaced = parser.parseString( sections + "OIL\n", mode );
+    BOOST_CHECK( Opm::Section::checkSectionTopology( misplaced, parser ) );
+    BOOST_CHECK( !Opm::Section::checkSectionTopology( misplaced, parser, true ) );
+}
+
+BOOST_AUTO_TEST_CASE(Section_KeywordLookup) {
+    Deck deck;
+    for (const auto* name : {"RUNSPEC", "A", "B", "GRID", "A", "B", "A", "PROPS", "B", "SCHEDULE", "A"})
+        deck.addKeyword( DeckKeyword( name ) );
+
+    GRIDSection grid( deck );
+    BOOST_CHECK_EQUAL( grid.size(), 4U );
+    BOOST_CHECK_EQUAL( grid.count( "A" ), 2U );
+    BOOST_CHECK_EQUAL( grid.count( "B" ), 1U );
+    BOOST_CHECK( &grid.getKeyword( "A", 1 ) == &deck.getKeyword( 6 ) );
+    BOOST_CHECK( &grid.getKeyword( "A" ) == &deck.getKeyword( 6 ) );
+    BOOST_CHECK( grid.hasKeyword( deck.getKeyword( 4 ) ) );
+    BOOST_CHECK( !grid.hasKeyword( deck.getKeyword( 1 ) ) );
+    BOOST_CHECK_THROW( grid.getKeyword( "A", 2 ), std::out_of_range );
+
+    PROPSSection props( deck );
+    BOOST_CHECK_EQUAL( props.count( "A" ), 0U );
+    BOOST_CHECK( !props.hasKeyword( "A" ) );
+    BOOST_CHECK_EQUAL( props.getKeywordList( "B" ).size(), 1U );
+
+    SCHEDULESection sched( deck );
+    BOOST_CHECK_EQUAL( sched.count( "A" ), 1U );
+    BOOST_CHECK( !Section::hasEDIT( deck ) );
+    BOOST_CHECK_EQUAL( deck.count( "A" ), 4U );
+
+    Deck copy( deck );
+    GRIDSection grid2( copy );
+    BOOST_CHECK( &grid2.getKeyword( "A" ) == &copy.getKeyword( 6 ) );
+}
@@ -21,10 +21,14 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <memory>
+#include <sstream>
 
 #include <opm/parser/eclipse/EclipseState/Tables/ColumnSchema.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableEvaluator.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableSchema.hpp>
 
@@ -85,3 +89,163 @@ BOOST_AUTO_TEST_CASE( CreateTest ) {
     }
 }
 
+
+
+BOOST_AUTO_TEST_CASE( EvaluatorTest ) {
+    TableSchema schema;
+    schema.addColumn( ColumnSchema("X" , Table::STRICTLY_INCREASING , Table::DEFAULT_NONE) );
+    schema.addColumn( ColumnSchema("Y" , Table::RANDOM , Table::DEFAULT_NONE) );
+
+    SimpleTable table(schema);
+    table.addRow( {0 , 1} );
+    table.addRow( {1 , 3} );
+    table.addRow( {3 , 2} );
+    table.addRow( {4 , 6} );
+
+    TableEvaluator eval( table , "Y" );
+    BOOST_CHECK_THROW( TableEvaluator( table , "Z" ), std::invalid_argument );
+
+    const std::vector<double> xs = { -1 , 0 , 0.5 , 1 , 2 , 2.5 , 3.5 , 4 , 10 };
+    for (const auto x : xs)
+        BOOST_CHECK_CLOSE( eval( x ) , table.evaluate( "Y" , x ) , 1e-12 );
+
+    std::vector<double> ys;
+    eval.evaluate( xs , ys );
+    BOOST_CHECK_EQUAL( ys.size() , xs.size() );
+    for (size_t i = 0; i < xs.size(); i++)
+        BOOST_CHECK_CLOSE( ys[i] , table.evaluate( "Y" , xs[i] ) , 1e-12 );
+
+    {
+        std::size_t hint = 0;
+        BOOST_CHECK_CLOSE( eval( 3.5 , hint ) , 4.0 , 1e-12 );
+        BOOST_CHECK_EQUAL( hint , 2U );
+        BOOST_CHECK_CLOSE( eval( 0.5 , hint ) , 2.0 , 1e-12 );
+        BOOST_CHECK_EQUAL( hint , 0U );
+    }
+
+    /* The table points are on the uniform grid, the resampling is exact. */
+    eval.resample( 9 );
+    BOOST_CHECK( eval.uniform() );
+    for (const auto x : xs)
+        BOOST_CHECK_CLOSE( eval( x ) , table.evaluate( "Y" , x ) , 1e-12 );
+
+    BOOST_CHECK_THROW( eval.resample( 1 ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( EvaluatorDecreasingTest ) {
+    TableEvaluator eval( {4 , 2 , 0} , {0 , 1 , 4} );
+    BOOST_CHECK_CLOSE( eval( 5 ) , 0.0 , 1e-12 );
+    BOOST_CHECK_CLOSE( eval( 3 ) , 0.5 , 1e-12 );
+    BOOST_CHECK_CLOSE( eval( 1 ) , 2.5 , 1e-12 );
+    BOOST_CHECK_CLOSE( eval( -1 ) , 4.0 , 1e-12 );
+
+    BOOST_CHECK_THROW( TableEvaluator( {0 , 2 , 1} , {0 , 1 , 2} ), std::invalid_argument );
+    BOOST_CHECK_THROW( TableEvaluator( {0 , 1} , {0} ), std::invalid_argument );
+    BOOST_CHECK_THROW( TableEvaluator( std::vector<double>{} , std::vector<double>{} ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( DepthTableEvaluatorTest ) {
+    TableSchema schema;
+    schema.addColumn( ColumnSchema( "DEPTH" , Table::STRICTLY_INCREASING , Table::DEFAULT_NONE ));
+    schema.addColumn( ColumnSchema( "RS" , Table::RANDOM , Table::DEFAULT_NONE ));
+
+    auto table1 = std::make_shared< SimpleTable >( schema );
+    table1->addRow( {1000 , 100} );
+    table1->addRow( {2000 , 200} );
+    table1->addRow( {3000 , 250} );
+
+    auto table2 = std::make_shared< SimpleTable >( schema );
+    table2->addRow( {1000 , 50} );
+    table2->addRow( {3000 , 150} );
+
+    // Region 3 has no table of its own and uses the one of region 2.
+    TableContainer tables( 3 );
+    tables.addTable( 0 , table1 );
+    tables.addTable( 1 , table2 );
+
+    DepthTableEvaluator eval( tables , "RS" , 3 );
+    BOOST_CHECK_EQUAL( eval.numRegions() , 3U );
+    BOOST_CHECK_CLOSE( eval( 1 , 1500 ) , 150 , 1e-12 );
+    BOOST_CHECK_CLOSE( eval( 2 , 2000 ) , 100 , 1e-12 );
+    BOOST_CHECK_CLOSE( eval( 3 , 2000 ) , 100 , 1e-12 );
+    BOOST_CHECK_THROW( eval( 0 , 2000 ) , std::invalid_argument );
+    BOOST_CHECK_THROW( eval( 4 , 2000 ) , std::invalid_argument );
+
+    const std::vector< int > eqlnum = { 1 , 1 , 2 , 1 , 3 , 2 , 1 };
+    const std::vector< double > depth = { 500 , 1250 , 1500 , 2500 , 2500 , 3500 , 2750 };
+    std::vector< double > values;
+    eval.evaluate( eqlnum , depth , values );
+    BOOST_CHECK_EQUAL( values.size() , depth.size() );
+    for (size_t cell = 0; cell < depth.size(); cell++)
+        BOOST_CHECK_CLOSE( values[cell] , tables.getTable( eqlnum[cell] - 1 ).evaluate( "RS" , depth[cell] ) , 1e-12 );
+
+    std::vector< double > column( 2 );
+    eval.evaluate( 1 , depth.data() + 2 , column.data() , 2 );
+    BOOST_CHECK_CLOSE( column[0] , 150 , 1e-12 );
+    BOOST_CHECK_CLOSE( column[1] , 225 , 1e-12 );
+
+    BOOST_CHECK_THROW( eval.evaluate( eqlnum , std::vector< double >( 2 ) , values ) , std::invalid_argument );
+}
+
+
+namespace {
+    struct MessageBuffer {
+        std::stringstream str;
+
+        template <class T>
+        void read( T& value ) {
+            str.read( (char *) &value, sizeof(value) );
+        }
+
+        template <class T>
+        void write( const T& value ) {
+            str.write( (const char *) &value, sizeof(value) );
+        }
+
+        void write( const std::string& value ) {
+            write( value.size() );
+            str.write( value.data(), value.size() );
+        }
+
+        void read( std::string& value ) {
+            std::size_t size = 0;
+            read( size );
+            value.resize( size );
+            str.read( &value[0], size );
+        }
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE( ReadWriteTest ) {
+    TableSchema schema;
+    schema.addColumn( ColumnSchema( "X" , Table::STRICTLY_INCREASING , Table::DEFAULT_NONE ) );
+    schema.addColumn( ColumnSchema( "Y" , Table::RANDOM , Table::DEFAULT_LINEAR ) );
+    schema.addColumn( ColumnSchema( "Z" , Table::DECREASING , 7.5 ) );
+
+    SimpleTable table( schema );
+    table.addRow( {1 , 10 , 3} );
+    table.addRow( {2 , 20 , 2} );
+    table.getColumn( "Y" ).addDefault();
+    table.getColumn( "X" ).addValue( 3 );
+    table.getColumn( "Z" ).addValue( 1 );
+
+    MessageBuffer buffer;
+    table.write( buffer );
+
+    SimpleTable copy;
+    copy.read( buffer );
+
+    BOOST_CHECK_EQUAL( copy.numColumns() , 3U );
+    BOOST_CHECK_EQUAL( copy.numRows() , 3U );
+    BOOST_CHECK( copy.hasColumn( "Z" ) );
+    BOOST_CHECK( copy.getColumn( "X" ).hasDefault() == false );
+    BOOST_CHECK( copy.getColumn( "Y" ).defaultApplied( 2 ) );
+    BOOST_CHECK_EQUAL( copy.get( "Z" , 0 ) , 3.0 );
+    BOOST_CHECK_EQUAL( copy.get( 1 , 1 ) , 20.0 );
+
+    /* The column order is part of the packed schema. */
+    BOOST_CHECK_THROW( copy.getColumn( "X" ).addValue( 2 ) , std::invalid_argument );
+}
@@ -66,3 +66,27 @@ BOOST_AUTO_TEST_CASE( CreateContainer ) {
     BOOST_CHECK_THROW( container[10] , std::invalid_argument );
 }
 
+
+BOOST_AUTO_TEST_CASE( DefaultedTablesResolvedOnAdd ) {
+    auto deck = createSWOFDeck();
+    const auto& record = deck.getKeyword("SWOF");
+    std::shared_ptr<Opm::SimpleTable> table0 = std::make_shared<Opm::SwofTable>( record.getRecord(0).getItem(0), false );
+    std::shared_ptr<Opm::SimpleTable> table1 = std::make_shared<Opm::SwofTable>( record.getRecord(1).getItem(0), false );
+    Opm::TableContainer container(6);
+
+    container.addTable( 4 , table1 );
+    container.addTable( 0 , table0 );
+    BOOST_CHECK_EQUAL( 2 , container.size() );
+    BOOST_CHECK_EQUAL( table0.get() , &(container[3]));
+    BOOST_CHECK_EQUAL( table1.get() , &(container[5]));
+
+    container.addTable( 2 , table1 );
+    BOOST_CHECK_EQUAL( 3 , container.size() );
+    BOOST_CHECK_EQUAL( table0.get() , &(container[1]));
+    BOOST_CHECK_EQUAL( table1.get() , &(container[3]));
+
+    container.addTable( 2 , table0 );
+    BOOST_CHECK_EQUAL( 3 , container.size() );
+    BOOST_CHECK_EQUAL( table0.get() , &(container[3]));
+    BOOST_CHECK_EQUAL( table1.get() , &(container[4]));
+}
@@ -42,6 +42,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/PbvdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/PdvdTable.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
 
@@ -49,6 +50,8 @@
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
+#include <future>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 
@@ -1046,6 +1049,49 @@ BOOST_AUTO_TEST_CASE(TestTableContainer) {
     BOOST_CHECK_THROW( tables["STUPID"] , std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(LazyTableManager) {
+    auto deck = std::make_shared< const Opm::Deck >( createSingleRecordDeckWithJFunc() );
+    const Opm::TableManager eager( *deck );
+    const Opm::TableManager lazy( deck );
+
+    BOOST_CHECK( lazy.useJFunc() );
+    BOOST_CHECK( lazy.useImptvd() );
+    BOOST_CHECK_EQUAL( eager.getTabdims().getNumSatTables(), lazy.getTabdims().getNumSatTables() );
+
+    BOOST_CHECK_EQUAL( false , lazy.hasTables("SGOF") );
+    BOOST_CHECK_EQUAL( false , lazy.hasTables("STUPID") );
+    BOOST_CHECK_THROW( lazy.getTables("STUPID") , std::invalid_argument);
+    BOOST_CHECK( lazy.getPvtoTables().empty() );
+
+    // Different tables requested concurrently.
+    const std::vector< std::string > names = { "SWFN", "IMPTVD", "ENPTVD", "SGOF" };
+    std::vector< std::future< const Opm::TableContainer* > > futures;
+    for (const auto& name : names)
+        futures.push_back( std::async( std::launch::async, [&lazy, name]() { return &lazy.getTables( name ); }) );
+
+    for (size_t index = 0; index < names.size(); index++) {
+        const auto& lazyTables = *futures[index].get();
+        const auto& eagerTables = eager.getTables( names[index] );
+        BOOST_CHECK_EQUAL( eagerTables.size(), lazyTables.size() );
+        BOOST_CHECK( &lazyTables == &lazy.getTables( names[index] ) );
+
+        for (size_t tab = 0; tab < eagerTables.size(); tab++) {
+            const auto& eagerTable = eagerTables.getTable( tab );
+            const auto& lazyTable = lazyTables.getTable( tab );
+            BOOST_CHECK_EQUAL( eagerTable.numColumns(), lazyTable.numColumns() );
+            for (size_t c_idx = 0; c_idx < eagerTable.numColumns(); c_idx++) {
+                const auto& eagerCol = eagerTable.getColumn( c_idx );
+                const auto& lazyCol = lazyTable.getColumn( c_idx );
+                BOOST_CHECK_EQUAL( eagerCol.size(), lazyCol.size() );
+                for (size_t i = 0; i < eagerCol.size(); i++)
+                    BOOST_CHECK_EQUAL( eagerCol[i], lazyCol[i] );
+            }
+        }
+    }
+
+    BOOST_CHECK_CLOSE( lazy.getSwfnTables().getTable<Opm::SwfnTable>(0).getJFuncColumn()[0], 7.0, epsilon() );
+}
+
 /**
  * Spot checks that the VFPPROD table will fail nicely when given invalid data
  */
@@ -1189,6 +1235,89 @@ VFPINJ \n\
     }
 }
 
+namespace {
+
+    /* Multilinear in the axes, so the interpolation is exact everywhere. */
+    double vfp_bhp(double thp, double wfr, double gfr, double alq, double flo) {
+        return 1 + 2*thp + 3*wfr - gfr + 0.5*alq + 4*flo + thp*flo - wfr*gfr*alq;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(VFPProdEvaluator_Test) {
+    const std::vector<double> flo = { 1, 2, 4 };
+    const std::vector<double> thp = { 10, 20 };
+    const std::vector<double> wfr = { 0, 0.5, 1 };
+    const std::vector<double> gfr = { 100, 200 };
+    const std::vector<double> alq = { 0 };
+
+    Opm::VFPProdTable::array_type data(Opm::VFPProdTable::extents{{ 2, 3, 2, 1, 3 }});
+    for (size_t t = 0; t < thp.size(); t++)
+        for (size_t w = 0; w < wfr.size(); w++)
+            for (size_t g = 0; g < gfr.size(); g++)
+                for (size_t a = 0; a < alq.size(); a++)
+                    for (size_t f = 0; f < flo.size(); f++)
+                        data[t][w][g][a][f] = vfp_bhp(thp[t], wfr[w], gfr[g], alq[a], flo[f]);
+
+    Opm::VFPProdTable table(1, 1000, Opm::VFPProdTable::FLO_OIL, Opm::VFPProdTable::WFR_WCT,
+                            Opm::VFPProdTable::GFR_GOR, Opm::VFPProdTable::ALQ_UNDEF,
+                            flo, thp, wfr, gfr, alq, data);
+    Opm::VFPProdEvaluator eval(table);
+
+    BOOST_CHECK_CLOSE(eval(20, 0.5, 100, 0, 2), vfp_bhp(20, 0.5, 100, 0, 2), 1e-12);
+    BOOST_CHECK_CLOSE(eval(12.5, 0.3, 170, 0, 3.1), vfp_bhp(12.5, 0.3, 170, 0, 3.1), 1e-12);
+
+    // Linear extrapolation outside the axes, the single point alq axis is constant.
+    BOOST_CHECK_CLOSE(eval(25, 1.2, 90, 0, 5), vfp_bhp(25, 1.2, 90, 0, 5), 1e-12);
+    BOOST_CHECK_CLOSE(eval(5, -0.1, 250, 7, 0.5), vfp_bhp(5, -0.1, 250, 0, 0.5), 1e-12);
+
+    const auto res = eval.evaluate(12.5, 0.3, 170, 0, 3.1);
+    BOOST_CHECK_CLOSE(res.value, vfp_bhp(12.5, 0.3, 170, 0, 3.1), 1e-12);
+    BOOST_CHECK_CLOSE(res.dthp, 2 + 3.1, 1e-12);
+    BOOST_CHECK_CLOSE(res.dwfr, 3, 1e-12);
+    BOOST_CHECK_CLOSE(res.dgfr, -1, 1e-12);
+    BOOST_CHECK_EQUAL(res.dalq, 0);
+    BOOST_CHECK_CLOSE(res.dflo, 4 + 12.5, 1e-12);
+
+    const std::vector<double> xthp = { 10, 12.5, 25, 15 };
+    const std::vector<double> xwfr = { 0, 0.3, 1.2, 0.9 };
+    const std::vector<double> xgfr = { 100, 170, 90, 150 };
+    const std::vector<double> xalq = { 0, 0, 0, 0 };
+    const std::vector<double> xflo = { 1, 3.1, 5, 1.5 };
+    std::vector<double> bhp(xthp.size());
+    std::vector<Opm::VFPEvaluation> results(xthp.size());
+    eval.evaluate(xthp.size(), xthp.data(), xwfr.data(), xgfr.data(), xalq.data(), xflo.data(), bhp.data());
+    eval.evaluate(xthp.size(), xthp.data(), xwfr.data(), xgfr.data(), xalq.data(), xflo.data(), results.data());
+    for (size_t i = 0; i < xthp.size(); i++) {
+        const auto single = eval.evaluate(xthp[i], xwfr[i], xgfr[i], xalq[i], xflo[i]);
+        BOOST_CHECK_EQUAL(bhp[i], eval(xthp[i], xwfr[i], xgfr[i], xalq[i], xflo[i]));
+        BOOST_CHECK_EQUAL(results[i].value, single.value);
+        BOOST_CHECK_EQUAL(results[i].dthp, single.dthp);
+        BOOST_CHECK_EQUAL(results[i].dflo, single.dflo);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(VFPInjEvaluator_Test) {
+    const std::vector<double> flo = { 1, 3, 5 };
+    const std::vector<double> thp = { 7, 11 };
+
+    Opm::VFPInjTable::array_type data(Opm::VFPInjTable::extents{{ 2, 3 }});
+    for (size_t t = 0; t < thp.size(); t++)
+        for (size_t f = 0; f < flo.size(); f++)
+            data[t][f] = 2 * thp[t] + flo[f] * thp[t];
+
+    Opm::VFPInjTable table(1, 1000, Opm::VFPInjTable::FLO_WAT, flo, thp, data);
+    Opm::VFPInjEvaluator eval(table);
+
+    BOOST_CHECK_CLOSE(eval(8, 2), 2 * 8 + 2 * 8, 1e-12);
+    BOOST_CHECK_CLOSE(eval(12, 6), 2 * 12 + 6 * 12, 1e-12);
+
+    const auto res = eval.evaluate(8, 2);
+    BOOST_CHECK_CLOSE(res.dthp, 2 + 2, 1e-12);
+    BOOST_CHECK_CLOSE(res.dflo, 8, 1e-12);
+    BOOST_CHECK_EQUAL(res.dwfr, 0);
+}
+
 
 BOOST_AUTO_TEST_CASE( TestPLYMWINJ ) {
     const char *inputstring =
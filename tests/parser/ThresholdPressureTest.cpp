@@ -316,3 +316,19 @@ BOOST_AUTO_TEST_CASE(HasPair) {
     BOOST_CHECK(!s.threshPres.hasThresholdPressure(1, 7));
     BOOST_CHECK_EQUAL(1200000.0, s.threshPres.getThresholdPressure(1, 2));
 }
+
+
+BOOST_AUTO_TEST_CASE(RegionPairs) {
+    Setup s(inputStrWithEqlNum);
+    const auto pressures = s.threshPres.getThresholdPressures({1, 2, 3, 1, 1, 7}, {2, 1, 2, 1, 3, 1});
+    const std::vector<double> expected = {1200000.0, 1200000.0, 700000.0, 0.0, 500000.0, 0.0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(pressures.begin(), pressures.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(s.threshPres.size(), 3);
+
+    BOOST_CHECK_THROW(s.threshPres.getThresholdPressures({1, 2}, {2}), std::invalid_argument);
+
+    ParseContext pc;
+    pc.update(ParseContext::UNSUPPORTED_INITIAL_THPRES, InputError::IGNORE);
+    Setup s2(inputStrMissingPressure, pc);
+    BOOST_CHECK_THROW(s2.threshPres.getThresholdPressures({1, 3}, {1, 2}), std::invalid_argument);
+}
@@ -88,6 +88,36 @@ BOOST_AUTO_TEST_CASE(AddStepSizeCorrect) {
 }
 
 
+BOOST_AUTO_TEST_CASE(StepOfTime) {
+    Opm::TimeMap timeMap{startDateJan1st2010};
+    timeMap.addTStep(static_cast<time_t>(1 * 60 * 60));
+    timeMap.addTStep(static_cast<time_t>(23 * 60 * 60));
+    timeMap.addTime(Opm::TimeMap::mkdate(2010, 3, 1));
+
+    BOOST_CHECK_THROW(timeMap.step_of(Opm::TimeMap::mkdate(2009, 12, 31)), std::invalid_argument);
+    BOOST_CHECK_THROW(timeMap.step_of_seconds(-1), std::invalid_argument);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdate(2010, 1, 1)), 0U);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdatetime(2010, 1, 1, 0, 59, 59)), 0U);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdatetime(2010, 1, 1, 1, 0, 0)), 1U);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdate(2010, 2, 1)), 2U);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdate(2010, 3, 1)), 3U);
+    BOOST_CHECK_EQUAL(timeMap.step_of(Opm::TimeMap::mkdate(2011, 3, 1)), 3U);
+
+    BOOST_CHECK_EQUAL(timeMap.step_of_seconds(0), 0U);
+    BOOST_CHECK_EQUAL(timeMap.step_of_seconds(3600), 1U);
+    BOOST_CHECK_EQUAL(timeMap.step_of_seconds(86399), 1U);
+    BOOST_CHECK_EQUAL(timeMap.step_of_seconds(86400), 2U);
+
+    const auto& seconds = timeMap.cumulativeSeconds();
+    BOOST_REQUIRE_EQUAL(seconds.size(), timeMap.size());
+    for (size_t step = 0; step < timeMap.size(); step++) {
+        BOOST_CHECK_EQUAL(seconds[step], timeMap.seconds(step));
+        BOOST_CHECK_EQUAL(seconds[step], timeMap.getTimePassedUntil(step));
+    }
+    BOOST_CHECK_THROW(timeMap.seconds(timeMap.size()), std::invalid_argument);
+}
+
+
 BOOST_AUTO_TEST_CASE( dateFromEclipseThrowsInvalidRecord ) {
     Opm::DeckRecord startRecord;
     Opm::DeckItem dayItem("DAY", int() );
@@ -44,3 +44,35 @@ BOOST_AUTO_TEST_CASE(Empty) {
     BOOST_CHECK_EQUAL( transMult.getMultiplier(9,9,9, Opm::FaceDir::YMinus) , 1.0 );
     BOOST_CHECK_EQUAL( transMult.getMultiplier(100 , Opm::FaceDir::ZMinus) , 1.0 );
 }
+
+
+BOOST_AUTO_TEST_CASE(FaceMultipliers) {
+    Opm::Eclipse3DProperties props;
+    Opm::TransMult transMult(Opm::GridDims(3,2,2) ,{} , props);
+    Opm::GridPropertySupportedKeywordInfo<double> multxInfo("MULTX" , 1.0 , "1");
+    Opm::GridPropertySupportedKeywordInfo<double> multxmInfo("MULTX-" , 1.0 , "1");
+    Opm::GridProperty<double> multx( 3, 2, 2, multxInfo );
+    Opm::GridProperty<double> multxm( 3, 2, 2, multxmInfo );
+    for (size_t g = 0; g < 12; g++) {
+        multx.iset( g, 2.0 );
+        multxm.iset( g, 0.5 + g );
+    }
+    transMult.applyMULT( multx, Opm::FaceDir::XPlus );
+    transMult.applyMULT( multxm, Opm::FaceDir::XMinus );
+
+    const auto xplus = transMult.getFaceMultipliers( Opm::FaceDir::XPlus );
+    BOOST_CHECK_EQUAL( xplus.size(), 12U );
+    for (size_t g = 0; g < 12; g++) {
+        if (g % 3 == 2)
+            BOOST_CHECK_EQUAL( xplus[g], 1.0 );
+        else
+            BOOST_CHECK_EQUAL( xplus[g], transMult.getMultiplier( g, Opm::FaceDir::XPlus ) *
+                                         transMult.getMultiplier( g + 1, Opm::FaceDir::XMinus ) );
+    }
+
+    const auto zplus = transMult.getFaceMultipliers( Opm::FaceDir::ZPlus );
+    for (const auto value : zplus)
+        BOOST_CHECK_EQUAL( value, 1.0 );
+
+    BOOST_CHECK_THROW( transMult.getFaceMultipliers( Opm::FaceDir::XMinus ), std::invalid_argument );
+}
@@ -25,6 +25,8 @@
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/UDQ.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/UDQExpression.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
 using namespace Opm;
 
@@ -125,3 +127,70 @@ DEFINE WUMW1 WBHP 'P*1*' UMAX WBHP 'P*4*' /
 }
 
 
+
+
+BOOST_AUTO_TEST_CASE(UDQ_EVAL) {
+    const std::string input = R"(
+RUNSPEC
+
+UDQPARAM
+  2* -1 /
+
+SCHEDULE
+
+UDQ
+ASSIGN WUBHP 7 /
+DEFINE WUOPR WOPR 'P*' + 1 /
+DEFINE FUOPR SUM(WUOPR) /
+DEFINE GUOPR MAX(WOPR) - GOPR /
+DEFINE WUGT  WOPR > AVEA(WOPR) /
+/
+)";
+    Parser parser;
+    ParseContext parseContext;
+
+    auto deck = parser.parseString(input, parseContext);
+    auto udq_config = UDQConfig(deck);
+    auto udq = UDQ(udq_config, deck);
+    UDQEvaluator evaluator(udq_config, udq, {"P1", "P2", "I1"}, {"G1"});
+
+    SummaryState st;
+    st.add_well_var("P1", "WOPR", 10);
+    st.add_well_var("P2", "WOPR", 20);
+    st.add_well_var("I1", "WOPR", 30);
+    st.add("GOPR:G1", 25);
+    evaluator.eval(st);
+
+    BOOST_CHECK_EQUAL(st.get_well_var("P1", "WUBHP"), 7);
+    BOOST_CHECK_EQUAL(st.get_well_var("I1", "WUBHP"), 7);
+    BOOST_CHECK_EQUAL(st.get_well_var("P1", "WUOPR"), 11);
+    BOOST_CHECK_EQUAL(st.get_well_var("P2", "WUOPR"), 21);
+    BOOST_CHECK_EQUAL(st.get_well_var("I1", "WUOPR"), -1);
+    BOOST_CHECK_EQUAL(st.get("FUOPR"), 32);
+    BOOST_CHECK_EQUAL(st.get("GUOPR:G1"), 5);
+    BOOST_CHECK_EQUAL(st.get_well_var("P1", "WUGT"), 0);
+    BOOST_CHECK_EQUAL(st.get_well_var("I1", "WUGT"), 1);
+
+    st.add_well_var("P2", "WOPR", 40);
+    evaluator.eval(st);
+    BOOST_CHECK_EQUAL(st.get_well_var("P2", "WUOPR"), 41);
+    BOOST_CHECK_EQUAL(st.get("FUOPR"), 52);
+    BOOST_CHECK_EQUAL(st.get_well_var("P2", "WUGT"), 1);
+
+    // The same keys in another order, alternating with st.
+    SummaryState st2;
+    st2.add("GOPR:G1", 25);
+    st2.add_well_var("I1", "WOPR", 30);
+    st2.add_well_var("P2", "WOPR", 20);
+    st2.add_well_var("P1", "WOPR", 10);
+    evaluator.eval(st2);
+    BOOST_CHECK_EQUAL(st2.size(), st.size());
+
+    evaluator.eval(st);
+    st2.add_well_var("P1", "WOPR", 50);
+    evaluator.eval(st2);
+    BOOST_CHECK_EQUAL(st2.get_well_var("P1", "WUOPR"), 51);
+    BOOST_CHECK_EQUAL(st2.get_well_var("P2", "WUOPR"), 21);
+    BOOST_CHECK_EQUAL(st2.get("FUOPR"), 72);
+    BOOST_CHECK_EQUAL(st.get_well_var("P1", "WUOPR"), 11);
+}
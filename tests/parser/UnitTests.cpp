@@ -626,3 +626,38 @@ BOOST_AUTO_TEST_CASE(TemperatureConversions)
     BOOST_CHECK_CLOSE(field.to_si(Meas::temperature , 1.0), (459.67 + 1.0)*5.0/9.0, 1.0e-10);
     BOOST_CHECK_CLOSE(field.from_si(Meas::temperature , (459.67 + 1.0)*5.0/9.0), 1.0, 1.0e-10);
 }
+
+BOOST_AUTO_TEST_CASE(ArrayConversions)
+{
+    using Meas = UnitSystem::measure;
+
+    auto field = UnitSystem::newFIELD();
+    const std::vector<double> values = { -10.0, 0.0, 1.0, 32.5, 1000.0 };
+
+    for (const auto m : { Meas::pressure, Meas::temperature, Meas::liquid_surface_rate }) {
+        std::vector<double> si(values.size());
+        field.to_si(m, values.data(), si.data(), values.size());
+
+        std::vector<double> inplace = values;
+        field.to_si(m, inplace);
+        for (size_t i = 0; i < values.size(); i++) {
+            BOOST_CHECK_EQUAL(si[i], field.to_si(m, values[i]));
+            BOOST_CHECK_EQUAL(inplace[i], si[i]);
+        }
+
+        std::vector<double> raw(values.size());
+        field.from_si(m, si.data(), raw.data(), si.size());
+        for (size_t i = 0; i < values.size(); i++)
+            BOOST_CHECK_EQUAL(raw[i], field.from_si(m, si[i]));
+    }
+
+    Dimension dim("Pressure", 100.0, 5.0);
+    std::vector<double> si(values.size());
+    dim.convertRawToSi(values.data(), si.data(), values.size());
+    for (size_t i = 0; i < values.size(); i++)
+        BOOST_CHECK_EQUAL(si[i], dim.convertRawToSi(values[i]));
+
+    dim.convertSiToRaw(si.data(), si.data(), si.size());
+    for (size_t i = 0; i < values.size(); i++)
+        BOOST_CHECK_CLOSE(si[i], values[i], 1e-10);
+}
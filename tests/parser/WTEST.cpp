@@ -162,3 +162,42 @@ BOOST_AUTO_TEST_CASE(WTEST_STATE_COMPLETIONS) {
 
 
 
+
+
+BOOST_AUTO_TEST_CASE(WTEST_STATE_MANY_WELLS) {
+    WellTestConfig wc;
+    WellTestState st;
+    for (int w = 0; w < 1000; w++) {
+        const std::string name = "W" + std::to_string(w);
+        st.addClosedWell(name, WellTestConfig::Reason::ECONOMIC, 0);
+        if (w % 2 == 0) {
+            st.addClosedWell(name, WellTestConfig::Reason::PHYSICAL, 0);
+            wc.add_well(name, "P", 100, 0, 0);
+        }
+    }
+    BOOST_CHECK_EQUAL(st.sizeWells(), 1500);
+    BOOST_CHECK(st.hasWell("W2", WellTestConfig::Reason::PHYSICAL));
+    BOOST_CHECK(!st.hasWell("W3", WellTestConfig::Reason::PHYSICAL));
+    BOOST_CHECK(wc.has("W2", WellTestConfig::Reason::PHYSICAL));
+    BOOST_CHECK(!wc.has("W3"));
+
+    BOOST_CHECK_EQUAL(st.updateWell(wc, 50).size(), 0);
+    const auto due = st.updateWell(wc, 100);
+    BOOST_CHECK_EQUAL(due.size(), 500);
+    BOOST_CHECK_EQUAL(due.front().first, "W0");
+    BOOST_CHECK_EQUAL(due.back().first, "W998");
+
+    st.dropWell("W2", WellTestConfig::Reason::PHYSICAL);
+    BOOST_CHECK(!st.hasWell("W2", WellTestConfig::Reason::PHYSICAL));
+    BOOST_CHECK(st.hasWell("W2", WellTestConfig::Reason::ECONOMIC));
+    st.openWell("W2");
+    BOOST_CHECK(!st.hasWell("W2", WellTestConfig::Reason::ECONOMIC));
+    BOOST_CHECK_THROW(st.lastTestTime("W2"), std::runtime_error);
+    BOOST_CHECK_EQUAL(st.lastTestTime("W5"), 0);
+    BOOST_CHECK_EQUAL(st.sizeWells(), 1498);
+
+    wc.drop_well("W4");
+    BOOST_CHECK(!wc.has("W4"));
+    BOOST_CHECK_EQUAL(wc.get("W6", WellTestConfig::Reason::PHYSICAL).name, "W6");
+    BOOST_CHECK_EQUAL(st.updateWell(wc, 200).size(), 498);
+}
@@ -39,6 +39,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellPropertyPool.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 
@@ -1067,3 +1068,34 @@ BOOST_AUTO_TEST_CASE(CMODE_DEFAULT) {
     BOOST_CHECK_EQUAL( Pproperties.controlMode , Opm::WellProducer::CMODE_UNDEFINED );
     BOOST_CHECK_EQUAL( Iproperties.controlMode , Opm::WellInjector::CMODE_UNDEFINED );
 }
+
+
+BOOST_AUTO_TEST_CASE(WellPropertyPoolShared) {
+    Opm::WellPropertyPool pool;
+    Opm::WellProductionProperties p1;
+    p1.OilRate = 100;
+    p1.controlMode = Opm::WellProducer::ORAT;
+    Opm::WellProductionProperties p2 = p1;
+
+    const auto h1 = pool.intern(p1);
+    const auto h2 = pool.intern(p2);
+    BOOST_CHECK( h1 == h2 );
+    BOOST_CHECK_EQUAL( pool.size(), 1U );
+
+    // Compares equal, but is a different value.
+    p2.ALQValue = 10;
+    const auto h3 = pool.intern(p2);
+    BOOST_CHECK( h3 != h1 );
+    BOOST_CHECK_EQUAL( h3->ALQValue, 10 );
+    BOOST_CHECK_EQUAL( pool.size(), 2U );
+
+    auto timeMap = createXDaysTimeMap(10);
+    Opm::Well well1("WELL1" ,  1, 0, 0, 0.0, 0.0, Opm::Phase::OIL, timeMap , 0);
+    Opm::Well well2("WELL2" ,  2, 0, 0, 0.0, 0.0, Opm::Phase::OIL, timeMap , 0);
+    BOOST_CHECK( well1.setProductionProperties(2, h1) );
+    BOOST_CHECK( well2.setProductionProperties(2, h2) );
+    BOOST_CHECK( !well1.setProductionProperties(3, h1) );
+    BOOST_CHECK( !well1.setProductionProperties(4, p1) );
+    BOOST_CHECK_EQUAL( &well1.getProductionProperties(5), &well2.getProductionProperties(5) );
+    BOOST_CHECK_EQUAL( well1.getProductionProperties(1).OilRate, 0 );
+}
@@ -64,3 +64,29 @@ BOOST_AUTO_TEST_CASE(readDeck)
     BOOST_CHECK_EQUAL(data[2].trans, 0.1);
 
 }
+
+BOOST_AUTO_TEST_CASE(applyToNNC)
+{
+    auto eclipseState = Parser::parse(pathprefix() + "EDITNNC/EDITNNC.DATA");
+    const auto& editnnc = eclipseState.getInputEDITNNC();
+
+    NNC nnc;
+    nnc.addNNC(21, 1, 10.0);
+    nnc.addNNC(0, 2, 4.0);
+    nnc.addNNC(3, 4, 1.0);
+    BOOST_CHECK(nnc.applyEditNNC(editnnc).empty());
+
+    // Both multipliers for cells 1 and 21 apply, whatever the direction.
+    const auto& data = nnc.nncdata();
+    BOOST_CHECK_CLOSE(data[0].trans, 0.1, 1e-8);
+    BOOST_CHECK_CLOSE(data[1].trans, 0.4, 1e-8);
+    BOOST_CHECK_EQUAL(data[2].trans, 1.0);
+
+    NNC other;
+    other.addNNC(1, 21, 1.0);
+    const auto unused = other.applyEditNNC(editnnc);
+    BOOST_CHECK_EQUAL(unused.size(), 1);
+    BOOST_CHECK_EQUAL(unused[0].cell1, 0);
+    BOOST_CHECK_EQUAL(unused[0].cell2, 2);
+    BOOST_CHECK_CLOSE(unused[0].trans, 0.1, 1e-8);
+}
@@ -89,3 +89,38 @@ BOOST_AUTO_TEST_CASE(addNNC)
     BOOST_CHECK_EQUAL(nncdata[0].trans, 2.0);
 }
 
+
+
+BOOST_AUTO_TEST_CASE(mergeNNC)
+{
+    NNC part1;
+    part1.addNNC(5, 2, 1.0);
+    part1.addNNC(0, 7, 2.0);
+    NNC part2;
+    part2.addNNC(5, 2, 0.5);
+    part2.addNNC(0, 3, 4.0);
+
+    const auto nnc = NNC::merge({ part1, part2 });
+    const auto& nncdata = nnc.nncdata();
+    BOOST_CHECK_EQUAL(nnc.numNNC(), 3);
+    BOOST_CHECK_EQUAL(nncdata[0].cell1, 0);
+    BOOST_CHECK_EQUAL(nncdata[0].cell2, 3);
+    BOOST_CHECK_EQUAL(nncdata[1].cell1, 0);
+    BOOST_CHECK_EQUAL(nncdata[1].cell2, 7);
+    BOOST_CHECK_EQUAL(nncdata[2].cell1, 5);
+    BOOST_CHECK_EQUAL(nncdata[2].cell2, 2);
+    BOOST_CHECK_EQUAL(nncdata[2].trans, 1.5);
+
+    NNCIndex index(nnc, 8);
+    BOOST_CHECK_EQUAL(index.numNeighbours(0), 2);
+    BOOST_CHECK_EQUAL(index.begin(0)[0].cell, 3);
+    BOOST_CHECK_EQUAL(index.begin(0)[1].cell, 7);
+    BOOST_CHECK_EQUAL(index.begin(0)[1].nnc, 1);
+    BOOST_CHECK_EQUAL(index.numNeighbours(2), 1);
+    BOOST_CHECK_EQUAL(index.begin(2)->cell, 5);
+    BOOST_CHECK_EQUAL(index.begin(2)->nnc, 2);
+    BOOST_CHECK_EQUAL(index.numNeighbours(1), 0);
+    BOOST_CHECK(index.begin(1) == index.end(1));
+
+    BOOST_CHECK_THROW(NNCIndex(nnc, 6), std::invalid_argument);
+}
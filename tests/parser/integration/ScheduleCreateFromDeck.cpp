@@ -35,6 +35,8 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellConnections.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellEconEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellTestState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 
@@ -896,6 +898,77 @@ BOOST_AUTO_TEST_CASE(WellTestWECON) {
 }
 
 
+BOOST_AUTO_TEST_CASE(WellEconEvaluatorWECON) {
+    ParseContext parseContext;
+    Parser parser;
+    std::string scheduleFile(pathprefix() + "SCHEDULE/SCHEDULE_WECON");
+    auto deck =  parser.parseFile(scheduleFile, parseContext);
+    EclipseGrid grid(30,30,30);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule sched(deck,  grid , eclipseProperties, runspec , parseContext);
+
+    const double day = 86400.;
+    {
+        WellEconEvaluator econ(sched.getWells(0U), 0);
+        BOOST_CHECK_EQUAL(econ.size(), 3U);
+        std::vector<double> oil(3), gas(3), water(3);
+        for (std::size_t w = 0; w < econ.size(); w++) {
+            oil[w] = 100 / day;
+            water[w] = 5000 / day;
+            if (econ.name(w) == "PROD01")
+                oil[w] = 10 / day;
+        }
+
+        WellEconEvaluator::Rates rates;
+        rates.oil = oil.data();
+        rates.gas = gas.data();
+        rates.water = water.data();
+
+        const auto violations = econ.evaluate(rates);
+        BOOST_CHECK_EQUAL(violations.size(), 1U);
+        const auto& v = violations[0];
+        BOOST_CHECK_EQUAL(econ.name(v.well), "PROD01");
+        BOOST_CHECK_EQUAL(v.limits, WellEconEvaluator::MIN_OIL_RATE | WellEconEvaluator::MAX_WATER_CUT);
+        BOOST_CHECK_EQUAL(v.workover, WellEcon::WELL);
+        BOOST_CHECK(!v.end_run);
+
+        WellTestState st;
+        econ.close(violations, st, 100);
+        BOOST_CHECK(st.hasWell("PROD01", WellTestConfig::Reason::ECONOMIC));
+        BOOST_CHECK_EQUAL(st.sizeWells(), 1U);
+    }
+
+    {
+        WellEconEvaluator econ(sched.getWells(1U), 1);
+        std::vector<double> oil(3, 100 / day), gas(3, 2000 / day), water(3, 0.0);
+        for (std::size_t w = 0; w < econ.size(); w++) {
+            if (econ.name(w) == "PROD02")
+                water[w] = 5000 / day;
+            if (econ.name(w) == "INJE01")
+                oil[w] = gas[w] = 0;
+        }
+
+        WellEconEvaluator::Rates rates;
+        rates.oil = oil.data();
+        rates.gas = gas.data();
+        rates.water = water.data();
+
+        const auto violations = econ.evaluate(rates);
+        BOOST_CHECK_EQUAL(violations.size(), 1U);
+        const auto& v = violations[0];
+        BOOST_CHECK_EQUAL(econ.name(v.well), "PROD02");
+        BOOST_CHECK_EQUAL(v.limits, WellEconEvaluator::MAX_WATER_CUT);
+        BOOST_CHECK_EQUAL(v.workover, WellEcon::CON);
+
+        WellTestState st;
+        econ.close(violations, st, 100);
+        BOOST_CHECK_EQUAL(st.sizeWells(), 0U);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(TestEvents) {
     ParseContext parseContext;
     Parser parser;
@@ -0,0 +1,200 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE Array_Reader
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/ArrayReader.hpp>
+#include <opm/output/eclipse/ArrayWriter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+using Opm::RestartIO::Helpers::ArrayReader;
+using Opm::RestartIO::Helpers::ArrayWriter;
+
+namespace {
+
+    struct TempFile {
+        TempFile() :
+            path((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("test_ArrayReader-%%%%-%%%%.UNRST")).string())
+        {}
+
+        ~TempFile() {
+            boost::system::error_code ec;
+            boost::filesystem::remove(this->path, ec);
+        }
+
+        std::string path;
+    };
+
+    void put32(std::FILE* file, std::uint32_t value) {
+        unsigned char bytes[4];
+        for (int byte = 0; byte < 4; byte++)
+            bytes[byte] = static_cast<unsigned char>((value >> (24 - 8 * byte)) & 0xFF);
+        std::fwrite(bytes, 1, 4, file);
+    }
+
+    /* A CHAR array, which ArrayWriter does not write, in one record. */
+    void writeStrings(std::FILE* file, const std::string& keyword, const std::vector<std::string>& values) {
+        char header[16];
+        std::memset(header, ' ', sizeof header);
+        std::memcpy(header, keyword.data(), keyword.size());
+        std::memcpy(header + 12, "CHAR", 4);
+        put32(file, 16);
+        std::fwrite(header, 1, 8, file);
+        put32(file, static_cast<std::uint32_t>(values.size()));
+        std::fwrite(header + 12, 1, 4, file);
+        put32(file, 16);
+
+        put32(file, static_cast<std::uint32_t>(8 * values.size()));
+        for (const auto& value : values) {
+            std::string padded = value;
+            padded.resize(8, ' ');
+            std::fwrite(padded.data(), 1, 8, file);
+        }
+        put32(file, static_cast<std::uint32_t>(8 * values.size()));
+    }
+
+    std::vector<double> pressure(std::size_t size, double scale) {
+        std::vector<double> values(size);
+        for (std::size_t index = 0; index < size; index++)
+            values[index] = scale * index + 0.5;
+        return values;
+    }
+
+    void writeCase(const std::string& path, std::size_t steps) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        BOOST_REQUIRE(file != nullptr);
+        {
+            ArrayWriter writer(file, false);
+            for (std::size_t step = 0; step < steps; step++) {
+                writer.write("SEQNUM", std::vector<int>{ static_cast<int>(step) });
+                writer.write("PRESSURE", pressure(2500, step + 1.0), ArrayWriter::Type::Double);
+                writer.write("SWAT", pressure(2500, 0.25), ArrayWriter::Type::Float);
+                writer.flush();
+                writeStrings(file, "ZWEL", { "PROD", "INJ-1", "" });
+            }
+        }
+        std::fclose(file);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(ReadArrays)
+{
+    TempFile tmp;
+    writeCase(tmp.path, 3);
+
+    const ArrayReader reader(tmp.path);
+    BOOST_CHECK_EQUAL(reader.entries().size(), 12U);
+    BOOST_CHECK_EQUAL(reader.count("PRESSURE"), 3U);
+    BOOST_CHECK_EQUAL(reader.count("NOSUCH"), 0U);
+    BOOST_CHECK_THROW(reader.find("PRESSURE", 3), std::invalid_argument);
+
+    const auto& entry = reader.entries()[reader.find("PRESSURE", 1)];
+    BOOST_CHECK_EQUAL(entry.keyword, "PRESSURE");
+    BOOST_CHECK_EQUAL(entry.type, "DOUB");
+    BOOST_CHECK_EQUAL(entry.size, 2500U);
+
+    for (std::size_t step = 0; step < 3; step++) {
+        BOOST_CHECK_EQUAL(reader.getInt(reader.find("SEQNUM", step))->at(0), static_cast<int>(step));
+        BOOST_CHECK(*reader.getDouble(reader.find("PRESSURE", step)) == pressure(2500, step + 1.0));
+
+        const auto swat = reader.getDouble(reader.find("SWAT", step));
+        const auto expected = pressure(2500, 0.25);
+        BOOST_REQUIRE_EQUAL(swat->size(), expected.size());
+        for (std::size_t index = 0; index < expected.size(); index++)
+            BOOST_CHECK_EQUAL((*swat)[index], static_cast<float>(expected[index]));
+
+        const auto zwel = reader.getString(reader.find("ZWEL", step));
+        BOOST_CHECK(*zwel == (std::vector<std::string>{ "PROD", "INJ-1", "" }));
+    }
+
+    BOOST_CHECK_THROW(reader.getInt(reader.find("PRESSURE")), std::invalid_argument);
+    BOOST_CHECK_THROW(reader.getDouble(reader.find("ZWEL")), std::invalid_argument);
+    BOOST_CHECK_THROW(reader.getDouble(reader.entries().size()), std::out_of_range);
+}
+
+
+BOOST_AUTO_TEST_CASE(SharedIndexAndCache)
+{
+    TempFile tmp;
+    writeCase(tmp.path, 2);
+
+    const ArrayReader first(tmp.path);
+    const ArrayReader second(tmp.path);
+    BOOST_CHECK(&first.entries() == &second.entries());
+    BOOST_CHECK(first.getDouble(1) == second.getDouble(1));
+
+    // A changed file is indexed again.
+    writeCase(tmp.path, 3);
+    const ArrayReader third(tmp.path);
+    BOOST_CHECK_EQUAL(third.entries().size(), 12U);
+    BOOST_CHECK(third.getDouble(1) != first.getDouble(1));
+
+    // Evicted arrays stay valid, and are read again on demand.
+    const auto kept = first.getDouble(1);
+    ArrayReader::setCacheBudget(0);
+    BOOST_CHECK(*kept == pressure(2500, 1.0));
+    BOOST_CHECK(first.getDouble(1) != kept);
+    BOOST_CHECK(*first.getDouble(1) == *kept);
+    ArrayReader::setCacheBudget(ArrayReader::defaultCacheBudget);
+
+    BOOST_CHECK_THROW(ArrayReader("/no/such/file.UNRST"), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE(ConcurrentReaders)
+{
+    TempFile tmp;
+    writeCase(tmp.path, 8);
+    ArrayReader::setCacheBudget(16 * 2500 * sizeof(double) * 3);
+
+    std::vector<std::future<bool>> readers;
+    for (int thread = 0; thread < 8; thread++) {
+        readers.push_back(std::async(std::launch::async, [&tmp, thread]() {
+            bool equal = true;
+            for (int pass = 0; pass < 20; pass++) {
+                const ArrayReader reader(tmp.path);
+                for (std::size_t step = 0; step < 8; step++) {
+                    const std::size_t s = (step + thread) % 8;
+                    equal &= (*reader.getDouble(reader.find("PRESSURE", s)) == pressure(2500, s + 1.0));
+                    equal &= (reader.getInt(reader.find("SEQNUM", s))->at(0) == static_cast<int>(s));
+                }
+            }
+            return equal;
+        }));
+    }
+
+    for (auto& reader : readers)
+        BOOST_CHECK(reader.get());
+
+    ArrayReader::setCacheBudget(ArrayReader::defaultCacheBudget);
+}
@@ -0,0 +1,205 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE Array_Writer
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/ArrayWriter.hpp>
+#include <opm/output/eclipse/UnformattedArray.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ert/ecl/EclKW.hpp>
+#include <ert/ecl/FortIO.hpp>
+#include <ert/util/test_work_area.h>
+
+using Opm::RestartIO::Helpers::ArrayWriter;
+using Opm::RestartIO::Helpers::UnformattedArray;
+
+namespace {
+
+    std::string readAll(std::FILE* file) {
+        std::string bytes;
+        std::rewind(file);
+        char buffer[4096];
+        std::size_t count;
+        while ((count = std::fread(buffer, 1, sizeof buffer, file)) > 0)
+            bytes.append(buffer, count);
+
+        return bytes;
+    }
+
+    /* The bytes of the array as written through UnformattedArray. */
+    template <typename T>
+    std::string unformatted(const std::string& keyword, UnformattedArray::Type type, const std::vector<T>& values) {
+        const UnformattedArray array(keyword, type, values.size());
+        std::vector<std::size_t> all(values.size());
+        for (std::size_t index = 0; index < values.size(); index++)
+            all[index] = index;
+
+        std::stringstream stream(std::string(array.byteSize(), 'x'));
+        array.writeFrame(stream, 0);
+        array.writeValues(stream, 0, values, all);
+        return stream.str();
+    }
+
+    std::string readFile(const std::string& filename) {
+        std::FILE* file = std::fopen(filename.c_str(), "rb");
+        BOOST_REQUIRE(file != nullptr);
+
+        const auto bytes = readAll(file);
+        std::fclose(file);
+        return bytes;
+    }
+
+    std::vector<float> toFloat(const std::vector<double>& values) {
+        return std::vector<float>(values.begin(), values.end());
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(SameLayoutAsUnformattedArray)
+{
+    std::vector<int> ints(2500);
+    std::vector<double> doubles(3001);
+    for (std::size_t index = 0; index < ints.size(); index++)
+        ints[index] = static_cast<int>(index) - 7;
+    for (std::size_t index = 0; index < doubles.size(); index++)
+        doubles[index] = 0.25 * index - 100;
+
+    std::FILE* file = std::tmpfile();
+    BOOST_REQUIRE(file != nullptr);
+    {
+        // A small buffer, to write out several times per array.
+        ArrayWriter writer(file, false, 1);
+        BOOST_CHECK(!writer.formatted());
+        writer.write("SWAT", ints);
+        writer.write("PRESSURE", doubles, ArrayWriter::Type::Float);
+        writer.write("RS", doubles, ArrayWriter::Type::Double);
+        writer.write("EMPTY", std::vector<int>{});
+        writer.write("SCALED", doubles, ArrayWriter::Type::Double,
+                     [](const double* src, double* dst, std::size_t n) {
+                         for (std::size_t index = 0; index < n; index++)
+                             dst[index] = 2 * src[index];
+                     });
+        writer.flush();
+    }
+
+    std::vector<double> scaled(doubles);
+    for (auto& value : scaled)
+        value *= 2;
+
+    const auto bytes = readAll(file);
+    std::fclose(file);
+
+    const auto all = unformatted("SWAT", UnformattedArray::Type::Integer, ints)
+        + unformatted("PRESSURE", UnformattedArray::Type::Float, doubles)
+        + unformatted("RS", UnformattedArray::Type::Double, doubles)
+        + unformatted("EMPTY", UnformattedArray::Type::Integer, std::vector<int>{})
+        + unformatted("SCALED", UnformattedArray::Type::Double, scaled);
+
+    BOOST_CHECK_EQUAL(bytes.size(), all.size());
+    BOOST_CHECK(bytes == all);
+}
+
+
+BOOST_AUTO_TEST_CASE(SameTextAsERT)
+{
+    const std::vector<int> ints = { 0, -1, 7, 2147483647, -2147483647 - 1, 123456, -42 };
+
+    std::vector<double> doubles = { 0.0, -0.0, 1.0, -1.0, 10.0, 0.1, 0.01, 100.0, 1234.5678,
+                                    -0.000123456789, 1e-30, 6.02e23, -7.5e-120, 1e200, 123.0,
+                                    0.9999999999999999, 0.99999999996, 1.5e-310, 2.0 / 3.0 };
+    for (int index = 0; index < 500; index++)
+        doubles.push_back(std::sin(index) * std::pow(10.0, index % 41 - 20));
+
+    // Enough records to be encoded in parallel.
+    std::vector<double> large(40 * 1000 + 17);
+    for (std::size_t index = 0; index < large.size(); index++)
+        large[index] = std::cos(0.37 * index) * (1 + index);
+
+    std::FILE* file = std::tmpfile();
+    BOOST_REQUIRE(file != nullptr);
+    {
+        ArrayWriter writer(file, true, 1);
+        BOOST_CHECK(writer.formatted());
+        writer.write("ICON", ints);
+        writer.write("PRESSURE", doubles, ArrayWriter::Type::Float);
+        writer.write("RS", doubles, ArrayWriter::Type::Double);
+        writer.write("EMPTY", std::vector<double>{}, ArrayWriter::Type::Float);
+        writer.write("LARGE", large, ArrayWriter::Type::Float,
+                     [](const double* src, double* dst, std::size_t n) {
+                         for (std::size_t index = 0; index < n; index++)
+                             dst[index] = -src[index];
+                     });
+        writer.write("LARGED", large, ArrayWriter::Type::Double);
+        writer.flush();
+    }
+
+    std::vector<double> negated(large);
+    for (auto& value : negated)
+        value = -value;
+
+    const auto text = readAll(file);
+    std::fclose(file);
+
+    // The same arrays written by ERT's ecl_kw_fwrite().
+    test_work_area_type* work_area = test_work_area_alloc("array_writer_text");
+    {
+        ERT::FortIO fortio("ERT.FINIT", std::ios_base::out, true);
+        ERT::EclKW<int>("ICON", ints).fwrite(fortio);
+        ERT::EclKW<float>("PRESSURE", toFloat(doubles)).fwrite(fortio);
+        ERT::EclKW<double>("RS", doubles).fwrite(fortio);
+        ERT::EclKW<float>("EMPTY", std::vector<float>{}).fwrite(fortio);
+        ERT::EclKW<float>("LARGE", toFloat(negated)).fwrite(fortio);
+        ERT::EclKW<double>("LARGED", large).fwrite(fortio);
+    }
+    const auto expected = readFile("ERT.FINIT");
+    test_work_area_free(work_area);
+
+    BOOST_CHECK_EQUAL(text.size(), expected.size());
+    BOOST_CHECK(text == expected);
+    BOOST_CHECK_EQUAL(text.substr(0, 31), " 'ICON    '           7 'INTE'\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(InvalidArguments)
+{
+    BOOST_CHECK_THROW(ArrayWriter(nullptr, false), std::invalid_argument);
+
+    std::FILE* file = std::tmpfile();
+    BOOST_REQUIRE(file != nullptr);
+    {
+        ArrayWriter writer(file, false);
+        BOOST_CHECK_THROW(writer.write("TOOLONGKW", std::vector<int>{1}), std::invalid_argument);
+        BOOST_CHECK_THROW(writer.write("SWAT", std::vector<double>{1}, ArrayWriter::Type::Integer), std::invalid_argument);
+        writer.flush();
+    }
+
+    BOOST_CHECK(readAll(file).empty());
+    std::fclose(file);
+}
@@ -0,0 +1,129 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE Columnar_Summary
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/ColumnarSummary.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+using Opm::out::ColumnarSummary;
+using Opm::out::ColumnarSummaryFile;
+
+namespace {
+
+    struct TempFile {
+        TempFile() :
+            path((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("test_ColumnarSummary-%%%%-%%%%.CSMRY")).string())
+        {}
+
+        ~TempFile() {
+            boost::system::error_code ec;
+            boost::filesystem::remove(this->path, ec);
+        }
+
+        std::string path;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(WriteAndRead)
+{
+    TempFile tmp;
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    {
+        ColumnarSummary writer(tmp.path, { "TIME", "WOPR:OP_1", "FOPT" }, { "DAYS", "SM3/DAY", "SM3" }, 4);
+        BOOST_CHECK_THROW(writer.append({ 1.0 }), std::invalid_argument);
+
+        for (int step = 0; step < 10; step++)
+            writer.append({ 10.0 * step, (step == 5) ? nan : 100.0 - step, 1000.0 * step });
+
+        // Two full chunks are written, the last two rows when the writer
+        // goes away.
+        const ColumnarSummaryFile partial(tmp.path);
+        BOOST_CHECK_EQUAL(partial.numRows(), 8U);
+    }
+
+    const ColumnarSummaryFile file(tmp.path);
+    BOOST_CHECK(file.keys() == (std::vector<std::string>{ "TIME", "WOPR:OP_1", "FOPT" }));
+    BOOST_CHECK(file.units() == (std::vector<std::string>{ "DAYS", "SM3/DAY", "SM3" }));
+    BOOST_CHECK_EQUAL(file.numRows(), 10U);
+    BOOST_CHECK_THROW(file.get("FOPR"), std::invalid_argument);
+
+    const auto time = file.get("TIME");
+    const auto fopt = file.get("FOPT");
+    const auto wopr = file.get("WOPR:OP_1");
+    BOOST_REQUIRE_EQUAL(wopr.size(), 10U);
+    for (int step = 0; step < 10; step++) {
+        BOOST_CHECK_EQUAL(time[step], 10.0 * step);
+        BOOST_CHECK_EQUAL(fopt[step], 1000.0 * step);
+        if (step == 5)
+            BOOST_CHECK(std::isnan(wopr[step]));
+        else
+            BOOST_CHECK_EQUAL(wopr[step], 100.0 - step);
+    }
+
+    const auto stats = file.stats("WOPR:OP_1");
+    BOOST_REQUIRE_EQUAL(stats.size(), 3U);
+    BOOST_CHECK_EQUAL(stats[0].rows, 4U);
+    BOOST_CHECK_EQUAL(stats[0].min, 97.0);
+    BOOST_CHECK_EQUAL(stats[0].max, 100.0);
+
+    // The missing value is left out of the statistics.
+    BOOST_CHECK_EQUAL(stats[1].min, 93.0);
+    BOOST_CHECK_EQUAL(stats[1].max, 96.0);
+
+    BOOST_CHECK_EQUAL(stats[2].rows, 2U);
+    BOOST_CHECK_EQUAL(stats[2].min, 91.0);
+    BOOST_CHECK_EQUAL(stats[2].max, 92.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(InvalidFiles)
+{
+    BOOST_CHECK_THROW(ColumnarSummaryFile("/no/such/file.CSMRY"), std::runtime_error);
+
+    TempFile tmp;
+    {
+        std::ofstream stream(tmp.path, std::ios_base::binary);
+        stream << "NOT A COLUMNAR SUMMARY";
+    }
+    BOOST_CHECK_THROW(ColumnarSummaryFile(tmp.path), std::runtime_error);
+
+    {
+        ColumnarSummary writer(tmp.path, { "TIME" }, { "DAYS" }, 2);
+        writer.append({ 1.0 });
+        writer.append({ 2.0 });
+    }
+    {
+        std::ofstream stream(tmp.path, std::ios_base::binary | std::ios_base::app);
+        stream << "XX";
+    }
+    BOOST_CHECK_THROW(ColumnarSummaryFile(tmp.path), std::runtime_error);
+}
@@ -43,6 +43,32 @@ BOOST_AUTO_TEST_CASE(deviation) {
 
 
 
+BOOST_AUTO_TEST_CASE(deviationArrays) {
+    const std::vector<double> values1 = {1, 0, 0, 4, -1.0e-8};
+    const std::vector<double> values2 = {3, 3, 0, 4, 2};
+    const double tol = 1.0e-14;
+    std::vector<double> absDev, relDev;
+
+    BOOST_CHECK( ECLFilesComparator::calculateDeviations(values1.data(), values2.data(), values1.size(),
+                                                         10, 1, false, absDev, relDev) );
+    BOOST_CHECK_EQUAL(absDev.size(), 4U);
+    BOOST_CHECK_EQUAL(relDev.size(), 2U);
+    BOOST_CHECK_EQUAL(absDev[0], 2.0);
+    BOOST_CHECK_EQUAL(absDev[1], 3.0);
+    BOOST_CHECK_EQUAL(absDev[3], 2.0);
+    BOOST_CHECK_CLOSE(relDev[0], 2.0/3, tol);
+
+    absDev.clear();
+    relDev.clear();
+    BOOST_CHECK( !ECLFilesComparator::calculateDeviations(values1.data(), values2.data(), values1.size(),
+                                                          1, 0.5, true, absDev, relDev) );
+
+    BOOST_CHECK( !ECLFilesComparator::calculateDeviations(values1.data() + 4, values2.data() + 4, 1,
+                                                          1.0e-9, 1, false, absDev, relDev) );
+}
+
+
+
 BOOST_AUTO_TEST_CASE(median) {
     std::vector<double> vec = {1,3,4,5};
 
@@ -0,0 +1,137 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE EclipseGridInspector
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/EclipseGridInspector.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Opm;
+
+namespace {
+
+    const std::vector<double> xs = { 0.0, 100.0, 250.0, 300.0 };
+    const std::vector<double> ys = { 0.0, 50.0, 120.0 };
+
+    /* The depth of surface s at pillar (pi, pj); the layers vary in
+       thickness and dip in both directions. */
+    double depth(int s, int pi, int pj) {
+        return 1000.0 + 25.0*s + 2.0*pi + 3.0*pj + s*pi;
+    }
+
+    /* A 3x2x2 corner point grid with vertical pillars. */
+    std::string deck() {
+        const int nx = 3, ny = 2, nz = 2;
+        std::ostringstream deck;
+        deck << "RUNSPEC\n"
+             << "DIMENS\n " << nx << ' ' << ny << ' ' << nz << " /\n"
+             << "GRID\n"
+             << "SPECGRID\n " << nx << ' ' << ny << ' ' << nz << " 1 F /\n"
+             << "COORD\n";
+        for (int pj = 0; pj <= ny; pj++)
+            for (int pi = 0; pi <= nx; pi++)
+                deck << ' ' << xs[pi] << ' ' << ys[pj] << " 900 "
+                     << xs[pi] << ' ' << ys[pj] << " 1200\n";
+        deck << "/\nZCORN\n";
+        for (int k = 0; k < nz; k++)
+            for (int s = k; s <= k + 1; s++)
+                for (int j = 0; j < ny; j++)
+                    for (int pj = j; pj <= j + 1; pj++) {
+                        for (int i = 0; i < nx; i++)
+                            deck << ' ' << depth(s, i, pj) << ' ' << depth(s, i + 1, pj);
+                        deck << '\n';
+                    }
+        deck << "/\n";
+
+        return deck.str();
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(RangesMatchCellQueries) {
+    const EclipseGridInspector inspector(Parser().parseString(deck()));
+    const auto dims = inspector.gridSize();
+    const int num_cells = dims[0]*dims[1]*dims[2];
+    BOOST_REQUIRE_EQUAL(num_cells, 12);
+
+    const auto dips = inspector.cellDipsRange(0, num_cells);
+    const auto zvals = inspector.cellZvalsRange(0, num_cells);
+    const auto volumes = inspector.cellVolumesVerticalPillars(0, num_cells);
+    const auto areas = inspector.cellAreasVerticalPillars(0, num_cells);
+    BOOST_REQUIRE_EQUAL(dips.size(), 12U);
+    BOOST_REQUIRE_EQUAL(zvals.size(), 12U);
+    BOOST_REQUIRE_EQUAL(volumes.size(), 12U);
+    BOOST_REQUIRE_EQUAL(areas.size(), 12U);
+
+    for (int cell = 0; cell < num_cells; cell++) {
+        const auto ijk = inspector.cellIdxToLogicalCoords(cell);
+        const int i = ijk[0], j = ijk[1], k = ijk[2];
+
+        const auto cell_dips = inspector.cellDips(cell);
+        BOOST_CHECK_CLOSE(dips[cell].first, cell_dips.first, 1e-10);
+        BOOST_CHECK_CLOSE(dips[cell].second, cell_dips.second, 1e-10);
+
+        const auto cell_zvals = inspector.cellZvals(i, j, k);
+        BOOST_CHECK(zvals[cell] == cell_zvals);
+        BOOST_CHECK_EQUAL(cell_zvals[0], depth(k, i, j));
+        BOOST_CHECK_EQUAL(cell_zvals[7], depth(k + 1, i + 1, j + 1));
+
+        BOOST_CHECK_CLOSE(volumes[cell], inspector.cellVolumeVerticalPillars(cell), 1e-10);
+        BOOST_CHECK_CLOSE(volumes[cell], inspector.cellVolumeVerticalPillars(i, j, k), 1e-10);
+
+        /* The base area times the average height is the volume. */
+        double height = 0.0;
+        for (int corner = 0; corner < 4; corner++)
+            height += 0.25*(cell_zvals[corner + 4] - cell_zvals[corner]);
+
+        BOOST_CHECK_CLOSE(areas[cell], (xs[i + 1] - xs[i])*(ys[j + 1] - ys[j]), 1e-10);
+        BOOST_CHECK_CLOSE(areas[cell]*height, volumes[cell], 1e-10);
+    }
+
+    /* A range which starts inside the grid. */
+    const int begin = 4, end = 9;
+    const auto part_dips = inspector.cellDipsRange(begin, end);
+    const auto part_zvals = inspector.cellZvalsRange(begin, end);
+    const auto part_volumes = inspector.cellVolumesVerticalPillars(begin, end);
+    const auto part_areas = inspector.cellAreasVerticalPillars(begin, end);
+    BOOST_REQUIRE_EQUAL(part_volumes.size(), 5U);
+    for (int cell = begin; cell < end; cell++) {
+        BOOST_CHECK(part_dips[cell - begin] == dips[cell]);
+        BOOST_CHECK(part_zvals[cell - begin] == zvals[cell]);
+        BOOST_CHECK_EQUAL(part_volumes[cell - begin], volumes[cell]);
+        BOOST_CHECK_EQUAL(part_areas[cell - begin], areas[cell]);
+    }
+
+    BOOST_CHECK(inspector.cellVolumesVerticalPillars(3, 3).empty());
+    BOOST_CHECK_THROW(inspector.cellDipsRange(-1, 2), std::runtime_error);
+    BOOST_CHECK_THROW(inspector.cellZvalsRange(5, 4), std::runtime_error);
+    BOOST_CHECK_THROW(inspector.cellVolumesVerticalPillars(0, num_cells + 1), std::runtime_error);
+    BOOST_CHECK_THROW(inspector.cellAreasVerticalPillars(0, num_cells + 1), std::runtime_error);
+}
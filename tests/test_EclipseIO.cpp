@@ -21,6 +21,7 @@
 #define BOOST_TEST_MODULE EclipseIO
 #include <boost/test/unit_test.hpp>
 
+#include <opm/common/OpmLog/Metrics.hpp>
 #include <opm/output/eclipse/EclipseIO.hpp>
 #include <opm/output/data/Cells.hpp>
 
@@ -49,6 +50,8 @@
 
 #include <ert/ecl_well/well_info.h>
 
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <map>
 
@@ -400,3 +403,126 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
 
 BOOST_AUTO_TEST_CASE(OPM_XWEL) {
 }
+
+namespace {
+
+std::string readFile( const std::string& name ) {
+    std::ifstream file( name, std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( file ),
+                        std::istreambuf_iterator< char >() );
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(AsyncOutput) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "UNIFOUT\n"
+        "OIL\n"
+        "GAS\n"
+        "WATER\n"
+        "METRIC\n"
+        "DIMENS\n"
+        "3 3 3/\n"
+        "GRID\n"
+        "DXV\n"
+        "1.0 2.0 3.0 /\n"
+        "DYV\n"
+        "4.0 5.0 6.0 /\n"
+        "DZV\n"
+        "7.0 8.0 9.0 /\n"
+        "TOPS\n"
+        "9*100 /\n"
+        "PROPS\n"
+        "PORO\n"
+        "27*0.3 /\n"
+        "PERMX\n"
+        "27*1 /\n"
+        "SOLUTION\n"
+        "RPTRST\n"
+        "BASIC=2\n"
+        "/\n"
+        "SUMMARY\n"
+        "FOPR\n"
+        "FGPT\n"
+        "SCHEDULE\n"
+        "TSTEP\n"
+        "1.0 2.0 3.0 4.0 5.0 6.0 7.0 /\n";
+
+    ParseContext parse_context;
+    auto deck = Parser().parseString( deckString, parse_context );
+    auto es = Parser::parse( deck );
+    const auto& grid = es.getInputGrid();
+    Schedule schedule( deck, grid, es.get3DProperties(), es.runspec(), parse_context );
+    SummaryConfig summary_config( deck, schedule, es.getTableManager( ), parse_context );
+
+    using measure = UnitSystem::measure;
+    const auto step = []( int report_step ) {
+        return RestartValue( createBlackoilState( report_step, 3 * 3 * 3 ), data::Wells() );
+    };
+    const RestartValue bad( data::Solution {
+            { "PRESSURE", { measure::pressure, std::vector< double >( 3 ), data::TargetType::RESTART_SOLUTION } }
+        }, data::Wells() );
+
+    test_work_area_type * work_area = test_work_area_alloc("test_ecl_writer_async");
+    {
+        const auto write = [&]( const std::string& base, bool async ) {
+            es.getIOConfig().setBaseName( base );
+            EclipseIO eclWriter( es, grid, schedule, summary_config );
+            eclWriter.setAsyncOutput( async, 1 );
+            eclWriter.writeInitial();
+            for (int i = 1; i < 7; ++i)
+                eclWriter.writeTimeStep( i, false, schedule.seconds( i ), step( i ), {}, {}, {} );
+            eclWriter.flush();
+        };
+
+        /* The queued report steps are written exactly as the synchronous ones. */
+        write( "SYNC", false );
+        Metrics::reset();
+        Metrics::enable();
+        write( "ASYNC", true );
+        const auto gauges = Metrics::snapshot().gauges;
+        Metrics::enable( false );
+        Metrics::reset();
+
+        BOOST_CHECK( readFile( "SYNC.UNRST" ).size() > 0 );
+        BOOST_CHECK( readFile( "SYNC.UNRST" ) == readFile( "ASYNC.UNRST" ));
+        BOOST_CHECK( readFile( "SYNC.UNSMRY" ).size() > 0 );
+        BOOST_CHECK( readFile( "SYNC.UNSMRY" ) == readFile( "ASYNC.UNSMRY" ));
+
+        /* Never more than maxQueued report steps are waiting. */
+        const auto queue = gauges.find( "output queue" );
+        BOOST_REQUIRE( queue != gauges.end() );
+        BOOST_CHECK( queue->second.max <= 1 );
+    }
+
+    {
+        es.getIOConfig().setBaseName( "ERROR" );
+        EclipseIO eclWriter( es, grid, schedule, summary_config );
+        BOOST_CHECK_THROW( eclWriter.writeTimeStep( 1, false, schedule.seconds( 1 ), bad, {}, {}, {} ), std::runtime_error );
+    }
+
+    {
+        es.getIOConfig().setBaseName( "ASYNC_ERROR" );
+        EclipseIO eclWriter( es, grid, schedule, summary_config );
+        eclWriter.setAsyncOutput( true, 1 );
+        eclWriter.writeTimeStep( 1, false, schedule.seconds( 1 ), bad, {}, {}, {} );
+        BOOST_CHECK_THROW( eclWriter.flush(), std::runtime_error );
+        BOOST_CHECK_NO_THROW( eclWriter.flush() );
+
+        /*
+          The third step waits until the second one is taken off the
+          queue, the fourth until the third is, which is after the second
+          one has failed.
+        */
+        eclWriter.writeTimeStep( 2, false, schedule.seconds( 2 ), bad, {}, {}, {} );
+        eclWriter.writeTimeStep( 3, false, schedule.seconds( 3 ), step( 3 ), {}, {}, {} );
+        BOOST_CHECK_THROW( eclWriter.writeTimeStep( 4, false, schedule.seconds( 4 ), step( 4 ), {}, {}, {} ), std::runtime_error );
+        BOOST_CHECK_NO_THROW( eclWriter.flush() );
+
+        /* A failure is also reported when the asynchronous output is stopped. */
+        eclWriter.writeTimeStep( 5, false, schedule.seconds( 5 ), bad, {}, {}, {} );
+        BOOST_CHECK_THROW( eclWriter.setAsyncOutput( false ), std::runtime_error );
+    }
+    test_work_area_free( work_area );
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE FirstTouchTests
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/common/utility/FirstTouch.hpp>
+
+using Opm::FirstTouch;
+
+BOOST_AUTO_TEST_CASE(MakeFillsArray) {
+    const std::size_t size = 1 << 20;
+    const auto same = [](const std::vector<double>& data, double value) {
+        return std::all_of(data.begin(), data.end(), [value](double x) { return x == value; });
+    };
+
+    BOOST_CHECK(same(FirstTouch::make<double>(size, 2.5), 2.5));
+
+    FirstTouch::enable();
+    FirstTouch::enableHugePages();
+    BOOST_CHECK(same(FirstTouch::make<double>(size, 2.5), 2.5));
+    BOOST_CHECK(same(FirstTouch::make<double>(size), 0.0));
+
+    // Uneven parts, scaled for three values per cell.
+    FirstTouch::setPartition({ 0, 1000, 1000, size / 2 + 17, size });
+    BOOST_CHECK(same(FirstTouch::make<double>(3 * size, -1.0), -1.0));
+
+    const auto ints = FirstTouch::make<int>(size + 1, 7);
+    BOOST_CHECK_EQUAL(ints.size(), size + 1);
+    BOOST_CHECK(std::all_of(ints.begin(), ints.end(), [](int x) { return x == 7; }));
+
+    BOOST_CHECK_EQUAL(FirstTouch::make<int>(10, 3).size(), 10U);
+
+    FirstTouch::setPartition({});
+    FirstTouch::enable(false);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidPartition) {
+    BOOST_CHECK_THROW(FirstTouch::setPartition({ 1, 10 }), std::invalid_argument);
+    BOOST_CHECK_THROW(FirstTouch::setPartition({ 0, 10, 5 }), std::invalid_argument);
+}
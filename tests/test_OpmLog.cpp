@@ -25,15 +25,23 @@
 #include <boost/test/unit_test.hpp>
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <chrono>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/AsyncLog.hpp>
 #include <opm/common/OpmLog/LogBackend.hpp>
+#include <opm/common/OpmLog/MemoryUsage.hpp>
+#include <opm/common/OpmLog/Metrics.hpp>
 #include <opm/common/OpmLog/CounterLog.hpp>
 #include <opm/common/OpmLog/TimerLog.hpp>
+#include <opm/common/OpmLog/PhaseTimer.hpp>
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
 
@@ -201,6 +209,153 @@ BOOST_AUTO_TEST_CASE(TestTimerLog) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TestPhaseTimer) {
+    {
+        PhaseTimer::Scope phase("DISABLED");
+    }
+    BOOST_CHECK( PhaseTimer::report().child("DISABLED") == nullptr );
+
+    PhaseTimer::enable();
+    PhaseTimer::enableTrace();
+    {
+        PhaseTimer::Scope parse("PARSE");
+        PhaseTimer::count("keywords", 10);
+        for (int i = 0; i < 3; i++) {
+            PhaseTimer::Scope include("INCLUDE");
+            PhaseTimer::count("files");
+        }
+    }
+    std::thread worker([]() { PhaseTimer::Scope phase("PARSE"); });
+    worker.join();
+
+    {
+        const auto root = PhaseTimer::report();
+        const auto * parse = root.child("PARSE");
+        BOOST_REQUIRE( parse != nullptr );
+        BOOST_CHECK_EQUAL( parse->calls , 2U );
+        BOOST_CHECK_EQUAL( parse->counters.at("keywords") , 10 );
+
+        const auto * include = parse->child("INCLUDE");
+        BOOST_REQUIRE( include != nullptr );
+        BOOST_CHECK_EQUAL( include->calls , 3U );
+        BOOST_CHECK_EQUAL( include->counters.at("files") , 3 );
+        BOOST_CHECK( include->seconds <= parse->seconds );
+    }
+
+    {
+        std::ostringstream trace;
+        PhaseTimer::writeChromeTrace(trace);
+        BOOST_CHECK( trace.str().find("\"name\": \"INCLUDE\", \"ph\": \"X\"") != std::string::npos );
+    }
+
+    {
+        Logger logger;
+        std::ostringstream sstream;
+        logger.addMessageType( PhaseTimerLog::PhaseReport , "Phases");
+        logger.addBackend( "PHASES" , std::make_shared<PhaseTimerLog>(sstream) );
+        logger.addMessage( PhaseTimerLog::PhaseReport , "Startup");
+        BOOST_CHECK_EQUAL( sstream.str().find("Startup") , 0U );
+        BOOST_CHECK( sstream.str().find("  INCLUDE") != std::string::npos );
+    }
+
+    PhaseTimer::reset();
+    PhaseTimer::enable(false);
+    {
+        const auto root = PhaseTimer::report();
+        BOOST_CHECK_EQUAL( root.child("PARSE")->calls , 0U );
+        BOOST_CHECK( root.child("PARSE")->counters.empty() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestMetrics) {
+    Metrics::count("DISABLED");
+    BOOST_CHECK( Metrics::snapshot().counters.empty() );
+
+    Metrics::enable();
+    Metrics::count("files", 2);
+    std::thread worker([]() {
+        Metrics::count("files");
+        Metrics::observe("read seconds", 0.5);
+    });
+    worker.join();
+    Metrics::observe("read seconds", 3.0);
+    Metrics::gauge("queue", 4);
+    Metrics::gauge("queue", 1);
+    {
+        PhaseTimer::Scope phase("PARSE");
+    }
+
+    {
+        const auto snapshot = Metrics::snapshot();
+        BOOST_CHECK_EQUAL( snapshot.counters.at("files") , 3 );
+        BOOST_CHECK_EQUAL( snapshot.gauges.at("queue").value , 1 );
+        BOOST_CHECK_EQUAL( snapshot.gauges.at("queue").max , 4 );
+        BOOST_CHECK_EQUAL( snapshot.histograms.at("PARSE seconds").count , 1U );
+
+        const auto& histogram = snapshot.histograms.at("read seconds");
+        BOOST_CHECK_EQUAL( histogram.count , 2U );
+        BOOST_CHECK_EQUAL( histogram.sum , 3.5 );
+        BOOST_CHECK_EQUAL( histogram.counts.size() , histogram.bounds.size() + 1 );
+    }
+
+    {
+        Logger logger;
+        std::ostringstream sstream;
+        logger.addMessageType( MetricsLog::MetricsReport , "Metrics");
+        logger.addBackend( "METRICS" , std::make_shared<MetricsLog>(sstream) );
+        logger.addMessage( MetricsLog::MetricsReport , "");
+        BOOST_CHECK( sstream.str().find("opm_files_total 3") != std::string::npos );
+        BOOST_CHECK( sstream.str().find("opm_queue_max 4") != std::string::npos );
+        BOOST_CHECK( sstream.str().find("opm_read_seconds_bucket{le=\"1\"} 1") != std::string::npos );
+        BOOST_CHECK( sstream.str().find("opm_read_seconds_count 2") != std::string::npos );
+    }
+
+    Metrics::reset();
+    Metrics::enable(false);
+    BOOST_CHECK( Metrics::snapshot().counters.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestMemoryUsage) {
+    MemoryUsage usage("Schedule", 100);
+    auto& wells = usage.add("wells", 10);
+    wells.add("connections", 1000);
+
+    MemoryUsage well("OP_1", 5);
+    well.add("connections", 200);
+    well.add("segments", 2000);
+    for (const auto& part : well.children)
+        wells.accumulate(part);
+    usage.add("events", 50);
+
+    BOOST_CHECK_EQUAL( usage.total() , 3360U );
+    BOOST_REQUIRE( usage.child("wells") != nullptr );
+    BOOST_CHECK( usage.child("groups") == nullptr );
+    BOOST_CHECK_EQUAL( usage.child("wells")->child("connections")->bytes , 1200U );
+
+    usage.sort();
+    BOOST_CHECK_EQUAL( usage.children.front().name , "wells" );
+    BOOST_CHECK_EQUAL( usage.children.front().children.front().name , "segments" );
+
+    BOOST_CHECK_EQUAL( MemoryUsage::heap(std::vector<double>(10)) , 10 * sizeof(double) );
+    BOOST_CHECK_EQUAL( MemoryUsage::heap(std::string("A")) + MemoryUsage::heap(std::string()) , 0U );
+    BOOST_CHECK( MemoryUsage::heap(std::string(100, 'A')) > 100U );
+
+    std::ostringstream log_stream;
+    OpmLog::addBackend("MEMORY", std::make_shared<StreamLog>(log_stream, Log::MessageType::Note));
+    MemoryUsage::log(usage);
+    BOOST_CHECK( log_stream.str().empty() );
+
+    MemoryUsage::enable();
+    MemoryUsage::log(usage);
+    MemoryUsage::enable(false);
+    BOOST_CHECK( log_stream.str().find("Schedule") != std::string::npos );
+    BOOST_CHECK( log_stream.str().find("    segments") != std::string::npos );
+    OpmLog::removeBackend("MEMORY");
+}
+
+
 /*****************************************************************/
 void initLogger(std::ostringstream& log_stream);
 
@@ -368,6 +523,90 @@ BOOST_AUTO_TEST_CASE(TestOpmLogWithLimits)
 
 
 
+BOOST_AUTO_TEST_CASE(TestAsyncLog)
+{
+    std::ostringstream log_stream;
+    {
+        const int64_t mask = Log::MessageType::Warning | Log::MessageType::Error;
+        auto streamLog = std::make_shared<StreamLog>(log_stream, mask);
+        AsyncLog asyncLog(streamLog, 16);
+        asyncLog.setMessageLimiter(std::make_shared<MessageLimiter>(2));
+        BOOST_CHECK_EQUAL(asyncLog.getMask(), mask);
+
+        const std::string tag = "ExampleTag";
+        asyncLog.addTaggedMessage(Log::MessageType::Warning, tag, "Warning");
+        asyncLog.addMessage(Log::MessageType::Error, "Error");
+        asyncLog.addMessage(Log::MessageType::Info, "Masked");
+        asyncLog.addTaggedMessage(Log::MessageType::Warning, tag, "Warning");
+        asyncLog.addTaggedMessage(Log::MessageType::Warning, tag, "Warning");
+        asyncLog.addTaggedMessage(Log::MessageType::Warning, tag, "Warning");
+        asyncLog.flush();
+
+        BOOST_CHECK_EQUAL(log_stream.str(), "Warning\nError\nWarning\nMessage limit reached for message tag: " + tag + "\n");
+    }
+
+    log_stream.str("");
+    {
+        const int num_threads = 4;
+        const int num_messages = 1000;
+        auto streamLog = std::make_shared<StreamLog>(log_stream, Log::DefaultMessageTypes);
+        AsyncLog asyncLog(streamLog, 8);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++)
+            threads.emplace_back([&asyncLog, t, num_messages]() {
+                for (int m = 0; m < num_messages; m++)
+                    asyncLog.addMessage(Log::MessageType::Info, std::to_string(t) + " " + std::to_string(m));
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        asyncLog.flush();
+
+        // Every message arrives once, and the messages of each thread in order.
+        std::istringstream lines(log_stream.str());
+        std::vector<int> next(num_threads, 0);
+        int t, m, count = 0;
+        while (lines >> t >> m) {
+            BOOST_CHECK_EQUAL(m, next[t]);
+            next[t] = m + 1;
+            count++;
+        }
+        BOOST_CHECK_EQUAL(count, num_threads * num_messages);
+    }
+
+    log_stream.str("");
+    {
+        // The background thread sleeps while the queue is empty, and is
+        // woken by the next message; flush() waits for it from several
+        // threads at once.
+        auto streamLog = std::make_shared<StreamLog>(log_stream, Log::DefaultMessageTypes);
+        AsyncLog asyncLog(streamLog, 8);
+
+        std::string expected;
+        for (int round = 0; round < 5; round++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            asyncLog.addMessage(Log::MessageType::Info, std::to_string(round));
+            expected += std::to_string(round) + "\n";
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 3; t++)
+                threads.emplace_back([&asyncLog]() { asyncLog.flush(); });
+            asyncLog.flush();
+            for (auto& thread : threads)
+                thread.join();
+
+            BOOST_CHECK_EQUAL(log_stream.str(), expected);
+        }
+
+        // The destructor wakes the sleeping thread.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+
+
 BOOST_AUTO_TEST_CASE(TestsetupSimpleLog)
 {
     bool use_prefix = false;
@@ -0,0 +1,70 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE ParallelChunksTests
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/common/utility/ParallelChunks.hpp>
+
+BOOST_AUTO_TEST_CASE(RangesCoverAllPositions) {
+    BOOST_CHECK_EQUAL(Opm::chunkRanges(0, 16).size(), 1U);
+    BOOST_CHECK_EQUAL(Opm::chunkRanges(10, 16).size(), 1U);
+
+    for (std::size_t size : { 0, 1, 17, 1000, 100001 }) {
+        const auto ranges = Opm::chunkRanges(size, 16);
+        BOOST_CHECK_EQUAL(ranges.front().first, 0U);
+        BOOST_CHECK_EQUAL(ranges.back().second, size);
+        for (std::size_t chunk = 1; chunk < ranges.size(); ++chunk) {
+            BOOST_CHECK_EQUAL(ranges[chunk].first, ranges[chunk - 1].second);
+            BOOST_CHECK(ranges[chunk].second - ranges[chunk].first >= 1U);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(VisitEveryPositionOnce) {
+    std::vector<int> visits(100001, 0);
+    Opm::forEachPosition(visits.size(), 16, [&visits](std::size_t pos) { visits[pos]++; });
+    BOOST_CHECK(std::all_of(visits.begin(), visits.end(), [](int n) { return n == 1; }));
+
+    const auto ranges = Opm::chunkRanges(visits.size(), 16);
+    std::vector<std::size_t> firsts(ranges.size(), visits.size());
+    Opm::forEachChunk(ranges, [&firsts](std::size_t chunk, std::size_t first, std::size_t) {
+        firsts[chunk] = first;
+    });
+    for (std::size_t chunk = 0; chunk < ranges.size(); ++chunk)
+        BOOST_CHECK_EQUAL(firsts[chunk], ranges[chunk].first);
+}
+
+BOOST_AUTO_TEST_CASE(ExceptionsReachTheCaller) {
+    const std::size_t size = 100001;
+    for (std::size_t failing : { std::size_t{ 0 }, size - 1 }) {
+        std::vector<int> visits(size, 0);
+        BOOST_CHECK_THROW(Opm::forEachPosition(size, 16, [&visits, failing](std::size_t pos) {
+            if (pos == failing)
+                throw std::runtime_error("failed");
+            visits[pos]++;
+        }), std::runtime_error);
+    }
+}
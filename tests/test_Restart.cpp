@@ -17,6 +17,8 @@
 */
 #include "config.h"
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 
 #define BOOST_TEST_MODULE EclipseIO
@@ -50,6 +52,8 @@
 #include <ert/ecl_well/well_state.h>
 #include <ert/util/test_work_area.h>
 
+#include <sys/stat.h>
+
 using namespace Opm;
 
 inline std::string input( const std::string& rst_name = "FIRST_SIM" ) {
@@ -554,6 +558,59 @@ BOOST_AUTO_TEST_CASE(ECL_FORMATTED) {
 }
 
 
+BOOST_AUTO_TEST_CASE(OUTPUT_PRECISION) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart");
+    auto& io_config = setup.es.getIOConfig();
+    {
+        auto num_cells = setup.grid.getNumActive( );
+        auto cells = mkSolution( num_cells );
+        auto wells = mkWells();
+        auto sumState = sim_state();
+        RestartValue restart_value(cells, wells);
+
+        restart_value.setOutputPrecision("PRESSURE", true);
+        restart_value.setOutputPrecision("SGAS", false);
+        BOOST_CHECK( restart_value.writeDouble("PRESSURE", false));
+        BOOST_CHECK( !restart_value.writeDouble("SGAS", true));
+        BOOST_CHECK( restart_value.writeDouble("SWAT", true));
+
+        io_config.setEclCompatibleRST( false );
+        RestartIO::save("OPM_FILE.UNRST", 1 ,
+                        100,
+                        restart_value,
+                        setup.es,
+                        setup.grid,
+                        setup.schedule,
+                        sumState,
+                        false);
+        {
+            ecl_file_type * rst_file = ecl_file_open( "OPM_FILE.UNRST" , 0 );
+
+            BOOST_CHECK_EQUAL( ECL_DOUBLE_TYPE, ecl_kw_get_type(ecl_file_iget_named_kw(rst_file, "PRESSURE", 0)));
+            BOOST_CHECK_EQUAL( ECL_FLOAT_TYPE, ecl_kw_get_type(ecl_file_iget_named_kw(rst_file, "SWAT", 0)));
+            BOOST_CHECK_EQUAL( ECL_FLOAT_TYPE, ecl_kw_get_type(ecl_file_iget_named_kw(rst_file, "SGAS", 0)));
+            ecl_file_close(rst_file);
+        }
+
+        io_config.setEclCompatibleRST( true );
+        RestartIO::save("ECL_FILE.UNRST", 1 ,
+                        100,
+                        restart_value,
+                        setup.es,
+                        setup.grid,
+                        setup.schedule,
+                        sumState,
+                        false);
+        {
+            ecl_file_type * rst_file = ecl_file_open( "ECL_FILE.UNRST" , 0 );
+
+            BOOST_CHECK_EQUAL( ECL_FLOAT_TYPE, ecl_kw_get_type(ecl_file_iget_named_kw(rst_file, "PRESSURE", 0)));
+            ecl_file_close(rst_file);
+        }
+    }
+    test_work_area_free(test_area);
+}
 
 
 
@@ -598,6 +655,72 @@ BOOST_AUTO_TEST_CASE(EclipseReadWriteWellStateData_double) {
 }
 
 
+BOOST_AUTO_TEST_CASE(EclipseLoadIntoBuffers) {
+    std::vector<RestartKey> solution_keys {RestartKey("PRESSURE", UnitSystem::measure::pressure),
+                                           RestartKey("SWAT", UnitSystem::measure::identity),
+                                           RestartKey("SGAS", UnitSystem::measure::identity),
+                                           RestartKey("NO", UnitSystem::measure::identity, false)};
+
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart");
+    test_work_area_copy_file( test_area, "FIRST_SIM.DATA");
+    Setup setup("FIRST_SIM.DATA");
+    EclipseIO eclWriter( setup.es, setup.grid, setup.schedule, setup.summary_config);
+
+    first_sim( setup.es , eclWriter , false);
+    const auto expected = second_sim( eclWriter , solution_keys );
+
+    const auto num_cells = setup.grid.getNumActive( );
+    std::vector<double> pressure( num_cells ), swat( num_cells ), sgas( 3 ), no( 1, -1.0 );
+    std::vector<RestartBuffer> buffers {
+        RestartBuffer( solution_keys[0], pressure.data(), pressure.size() ),
+        RestartBuffer( solution_keys[1], swat.data(), swat.size() ),
+        /* A rank local subset of the cells, in its own order. */
+        RestartBuffer( solution_keys[2], sgas.data(), std::vector<std::size_t>{ 7, 0, std::size_t(num_cells - 1) } ),
+        RestartBuffer( solution_keys[3], no.data(), no.size() )
+    };
+
+    const auto loaded = eclWriter.loadRestartInto( buffers );
+    BOOST_CHECK( !loaded.solution.has("PRESSURE") );
+    BOOST_CHECK_EQUAL( loaded.wells, expected.wells );
+    BOOST_CHECK_EQUAL( no[0], -1.0 );
+
+    const auto& exp_pressure = expected.solution.data( "PRESSURE" );
+    const auto& exp_swat = expected.solution.data( "SWAT" );
+    const auto& exp_sgas = expected.solution.data( "SGAS" );
+    for (std::size_t i = 0; i < pressure.size(); i++) {
+        BOOST_CHECK_EQUAL( pressure[i], exp_pressure[i] );
+        BOOST_CHECK_EQUAL( swat[i], exp_swat[i] );
+    }
+    BOOST_CHECK_EQUAL( sgas[0], exp_sgas[7] );
+    BOOST_CHECK_EQUAL( sgas[1], exp_sgas[0] );
+    BOOST_CHECK_EQUAL( sgas[2], exp_sgas[num_cells - 1] );
+
+    /* Ranges of cells, the second one ending in the last record of the vector. */
+    std::vector<double> swat_ranges( 4 );
+    const std::vector<std::pair<std::size_t, std::size_t>> ranges { { 0, 2 }, { num_cells - 2, num_cells } };
+    std::vector<RestartBuffer> range_buffers {
+        RestartBuffer( solution_keys[1], swat_ranges.data(), ranges )
+    };
+    eclWriter.loadRestartInto( range_buffers );
+    BOOST_CHECK_EQUAL( swat_ranges[0], exp_swat[0] );
+    BOOST_CHECK_EQUAL( swat_ranges[1], exp_swat[1] );
+    BOOST_CHECK_EQUAL( swat_ranges[2], exp_swat[num_cells - 2] );
+    BOOST_CHECK_EQUAL( swat_ranges[3], exp_swat[num_cells - 1] );
+
+    std::vector<RestartBuffer> outside {
+        RestartBuffer( solution_keys[2], sgas.data(), std::vector<std::size_t>{ std::size_t(num_cells) } )
+    };
+    BOOST_CHECK_THROW( eclWriter.loadRestartInto( outside ), std::invalid_argument );
+
+    std::vector<RestartBuffer> missing {
+        RestartBuffer( RestartKey("NOT-THIS", UnitSystem::measure::identity), no.data(), no.size() )
+    };
+    BOOST_CHECK_THROW( eclWriter.loadRestartInto( missing ), std::runtime_error );
+
+    test_work_area_free( test_area );
+}
+
+
 BOOST_AUTO_TEST_CASE(WriteWrongSOlutionSize) {
     Setup setup("FIRST_SIM.DATA");
     test_work_area_type * test_area = test_work_area_alloc("test_Restart");
@@ -673,6 +796,17 @@ BOOST_AUTO_TEST_CASE(ExtraData_content) {
                     BOOST_CHECK_CLOSE( 10 , units.to_si( UnitSystem::measure::pressure, ecl_kw_iget_double( ex, 0 )), 0.00001);
                     BOOST_CHECK_CLOSE( units.from_si( UnitSystem::measure::pressure, 3), ecl_kw_iget_double( ex, 3 ), 0.00001);
                 }
+
+                // The summary values are written as one array.
+                BOOST_CHECK( ecl_file_has_kw( f , "OPM_SMRY"));
+                {
+                    ecl_kw_type * smry = ecl_file_iget_named_kw( f , "OPM_SMRY" , 0 );
+                    BOOST_CHECK_EQUAL( static_cast<std::size_t>(ecl_kw_get_size( smry )), sumState.size() );
+
+                    std::size_t index;
+                    BOOST_REQUIRE( sumState.find( "WOPT:OP_1", index ));
+                    BOOST_CHECK_EQUAL( ecl_kw_iget_double( smry, index ), 10.0 );
+                }
                 ecl_file_close( f );
             }
 
@@ -707,6 +841,293 @@ BOOST_AUTO_TEST_CASE(ExtraData_content) {
 }
 
 
+BOOST_AUTO_TEST_CASE(Deduplicate_unchanged_arrays) {
+    Setup setup("FIRST_SIM.DATA");
+    setup.es.getIOConfig().setDeduplicateRST(true);
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart_dedup");
+    {
+        const auto cells = mkSolution( setup.grid.getNumActive( ) );
+        const auto wells = mkWells();
+        const auto sumState = sim_state();
+        const RestartIO::Helpers::StaticHeaders headers(setup.es, setup.grid);
+        RestartIO::OutputBuffers buffers;
+
+        for (int report_step = 1; report_step <= 2; report_step++) {
+            RestartValue restart_value(cells, wells);
+            RestartIO::save("FILE.UNRST", report_step, 100 * report_step, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        }
+
+        {
+            ecl_file_type * f = ecl_file_open( "FILE.UNRST" , 0 );
+            BOOST_CHECK_EQUAL( ecl_file_get_num_named_kw( f , "SWAT" ), 1 );
+            BOOST_CHECK_EQUAL( ecl_file_get_num_named_kw( f , "OPM_REFK" ), 1 );
+            BOOST_CHECK_EQUAL( ecl_file_get_num_named_kw( f , "OPM_REFS" ), 1 );
+            BOOST_CHECK_EQUAL( ecl_file_get_num_named_kw( f , "OPM_XWEL" ), 1 );
+            ecl_file_close( f );
+        }
+
+        const auto first = RestartIO::load( "FILE.UNRST", 1, {{"SWAT", UnitSystem::measure::identity}},
+                                            setup.es, setup.grid, setup.schedule );
+        const auto second = RestartIO::load( "FILE.UNRST", 2, {{"SWAT", UnitSystem::measure::identity}},
+                                             setup.es, setup.grid, setup.schedule );
+        BOOST_CHECK( first.solution.data("SWAT") == second.solution.data("SWAT") );
+
+        // The well state of the second step is only in the first one.
+        BOOST_CHECK( !first.wells.empty() );
+        BOOST_CHECK_EQUAL( first.wells, second.wells );
+
+        std::vector<double> swat( setup.grid.getNumActive( ) );
+        const auto into = RestartIO::loadInto( "FILE.UNRST", 2,
+                                               {RestartBuffer( {"SWAT", UnitSystem::measure::identity}, swat.data(), swat.size() )},
+                                               setup.es, setup.grid, setup.schedule );
+        BOOST_CHECK( swat == second.solution.data("SWAT") );
+        BOOST_CHECK_EQUAL( into.wells, second.wells );
+
+        // ECLIPSE compatible files repeat all the arrays.
+        setup.es.getIOConfig().setEclCompatibleRST(true);
+        for (int report_step = 1; report_step <= 2; report_step++) {
+            RestartValue restart_value(cells, wells);
+            RestartIO::save("ECL_FILE.UNRST", report_step, 100 * report_step, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        }
+
+        {
+            ecl_file_type * f = ecl_file_open( "ECL_FILE.UNRST" , 0 );
+            BOOST_CHECK_EQUAL( ecl_file_get_num_named_kw( f , "SWAT" ), 2 );
+            BOOST_CHECK( !ecl_file_has_kw( f , "OPM_REFK" ));
+            ecl_file_close( f );
+        }
+    }
+    test_work_area_free(test_area);
+}
+
+
+int numReportSteps(const std::string& filename) {
+    ecl_file_type * f = ecl_file_open( filename.c_str() , 0 );
+    const int num_steps = ecl_file_get_num_named_kw( f , "SEQNUM" );
+    ecl_file_close( f );
+
+    return num_steps;
+}
+
+BOOST_AUTO_TEST_CASE(Unified_file_rewind) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart_rewind");
+    {
+        const auto cells = mkSolution( setup.grid.getNumActive( ) );
+        const auto wells = mkWells();
+        const auto sumState = sim_state();
+        const RestartIO::Helpers::StaticHeaders headers(setup.es, setup.grid);
+        auto save = [&](RestartIO::OutputBuffers& buffers, const int report_step) {
+            RestartValue restart_value(cells, wells);
+            RestartIO::save("FILE.UNRST", report_step, 100 * report_step, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        };
+
+        RestartIO::OutputBuffers buffers;
+        for (int report_step = 1; report_step <= 3; report_step++)
+            save(buffers, report_step);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 3 );
+
+        // Writing report step 2 again truncates the file after it.
+        save(buffers, 2);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 2 );
+        save(buffers, 3);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 3 );
+
+        // Another set of buffers opens the file for report step 2, and
+        // keeps report step 1 ...
+        RestartIO::OutputBuffers reopened;
+        save(reopened, 2);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 2 );
+
+        // ... which is only found by opening the file again.
+        save(reopened, 1);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 1 );
+        save(reopened, 2);
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 2 );
+
+        const auto rst_value = RestartIO::load( "FILE.UNRST", 2, {{"SWAT", UnitSystem::measure::identity}},
+                                                setup.es, setup.grid, setup.schedule );
+        BOOST_CHECK( rst_value.solution.data("SWAT") == cells.data("SWAT") );
+    }
+    test_work_area_free(test_area);
+}
+
+BOOST_AUTO_TEST_CASE(Unified_file_failed_step) {
+    Setup setup("FIRST_SIM.DATA");
+    setup.es.getIOConfig().setDeduplicateRST(true);
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart_failed_step");
+    {
+        const auto cells = mkSolution( setup.grid.getNumActive( ) );
+        const auto wells = mkWells();
+        const auto sumState = sim_state();
+        const RestartIO::Helpers::StaticHeaders headers(setup.es, setup.grid);
+        RestartIO::OutputBuffers buffers;
+
+        for (int report_step = 1; report_step <= 2; report_step++) {
+            RestartValue restart_value(cells, wells);
+            RestartIO::save("FILE.UNRST", report_step, 100 * report_step, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        }
+
+        // OP_1 has open connections in the schedule, but none in the
+        // well state; the step fails after its header is written.
+        {
+            auto bad_wells = wells;
+            bad_wells["OP_1"].connections.clear();
+
+            RestartValue restart_value(cells, bad_wells);
+            BOOST_CHECK_THROW( RestartIO::save("FILE.UNRST", 3, 300, restart_value,
+                                               setup.es, setup.grid, setup.schedule,
+                                               sumState, headers, buffers),
+                               std::invalid_argument );
+        }
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 2 );
+
+        {
+            RestartValue restart_value(cells, wells);
+            RestartIO::save("FILE.UNRST", 3, 300, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        }
+        BOOST_CHECK_EQUAL( numReportSteps("FILE.UNRST"), 3 );
+
+        // The references of the step written again do not point into
+        // the step which failed.
+        const auto second = RestartIO::load( "FILE.UNRST", 2, {{"SWAT", UnitSystem::measure::identity}},
+                                             setup.es, setup.grid, setup.schedule );
+        const auto third = RestartIO::load( "FILE.UNRST", 3, {{"SWAT", UnitSystem::measure::identity}},
+                                            setup.es, setup.grid, setup.schedule );
+        BOOST_CHECK( third.solution.data("SWAT") == second.solution.data("SWAT") );
+        BOOST_CHECK_EQUAL( third.wells, second.wells );
+    }
+    test_work_area_free(test_area);
+}
+
+
+BOOST_AUTO_TEST_CASE(Read_large_keyword) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart_large_keyword");
+    {
+        const auto cells = mkSolution( setup.grid.getNumActive( ) );
+        const auto wells = mkWells();
+        const auto sumState = sim_state();
+
+        // BIG holds more than the 1 MB read through mmap(), in records
+        // of which the last one is partial; SMALL is read with fread().
+        std::vector<double> big((std::size_t(1) << 17) + 3);
+        for (std::size_t i = 0; i < big.size(); i++)
+            big[i] = 0.25 * i - 1000;
+
+        const std::vector<double> small(big.begin(), big.begin() + 1000);
+
+        RestartValue restart_value(cells, wells);
+        restart_value.addExtra("BIG", UnitSystem::measure::identity, big);
+        restart_value.addExtra("SMALL", UnitSystem::measure::identity, small);
+        RestartIO::save("FILE.UNRST", 1, 100, restart_value,
+                        setup.es, setup.grid, setup.schedule, sumState);
+
+        const auto rst_value = RestartIO::load( "FILE.UNRST", 1, {{"SWAT", UnitSystem::measure::identity}},
+                                                setup.es, setup.grid, setup.schedule,
+                                                {{"BIG", UnitSystem::measure::identity, true},
+                                                 {"SMALL", UnitSystem::measure::identity, true}} );
+        BOOST_CHECK( rst_value.getExtra("BIG") == big );
+        BOOST_CHECK( rst_value.getExtra("SMALL") == small );
+        BOOST_CHECK( rst_value.solution.data("SWAT") == cells.data("SWAT") );
+
+        {
+            ecl_file_type * f = ecl_file_open( "FILE.UNRST" , 0 );
+            ecl_kw_type * kw = ecl_file_iget_named_kw( f , "BIG" , 0 );
+            BOOST_REQUIRE_EQUAL( static_cast<std::size_t>(ecl_kw_get_size( kw )), big.size() );
+
+            const auto& loaded = rst_value.getExtra("BIG");
+            for (std::size_t i = 0; i < big.size(); i++)
+                BOOST_CHECK_EQUAL( loaded[i], ecl_kw_iget_double( kw, i ) );
+
+            ecl_file_close( f );
+        }
+    }
+    test_work_area_free(test_area);
+}
+
+bool indexFileId(const std::string& filename, ino_t& inode) {
+    struct stat buffer;
+    if (stat( (filename + ".OPMIDX").c_str(), &buffer ) != 0)
+        return false;
+
+    inode = buffer.st_ino;
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(Keyword_index_side_file) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart_index");
+    {
+        const auto cells = mkSolution( setup.grid.getNumActive( ) );
+        const auto wells = mkWells();
+        const auto sumState = sim_state();
+        const RestartIO::Helpers::StaticHeaders headers(setup.es, setup.grid);
+        RestartIO::OutputBuffers buffers;
+
+        // The index is only kept for files of at least 64 MB.
+        auto save = [&](const int report_step) {
+            RestartValue restart_value(cells, wells);
+            restart_value.addExtra("BIG", UnitSystem::measure::identity,
+                                   std::vector<double>((std::size_t(64) << 17) + 1, report_step));
+            RestartIO::save("FILE.UNRST", report_step, 100 * report_step, restart_value,
+                            setup.es, setup.grid, setup.schedule, sumState, headers, buffers);
+        };
+        auto load = [&](const int report_step) {
+            return RestartIO::load( "FILE.UNRST", report_step, {{"SWAT", UnitSystem::measure::identity}},
+                                    setup.es, setup.grid, setup.schedule,
+                                    {{"BIG", UnitSystem::measure::identity, true}} );
+        };
+
+        save(1);
+        ino_t inode;
+        BOOST_CHECK( !indexFileId("FILE.UNRST", inode) );
+
+        // The first load scans the file and builds the index ...
+        const auto scanned = load(1);
+        BOOST_REQUIRE( indexFileId("FILE.UNRST", inode) );
+
+        // ... which the next one reuses rather than writing it again.
+        const auto indexed = load(1);
+        ino_t reused;
+        BOOST_REQUIRE( indexFileId("FILE.UNRST", reused) );
+        BOOST_CHECK_EQUAL( reused, inode );
+        BOOST_CHECK( indexed.solution.data("SWAT") == scanned.solution.data("SWAT") );
+        BOOST_CHECK( indexed.getExtra("BIG") == scanned.getExtra("BIG") );
+        BOOST_CHECK_EQUAL( indexed.wells, scanned.wells );
+
+        // Once the file grows the index is stale; it is replaced by a
+        // new one which also covers the new report step.
+        save(2);
+        const auto second = load(2);
+        BOOST_CHECK_EQUAL( second.getExtra("BIG").front(), 2.0 );
+
+        ino_t rebuilt;
+        BOOST_REQUIRE( indexFileId("FILE.UNRST", rebuilt) );
+        BOOST_CHECK( rebuilt != inode );
+
+        // A stale index which only claims more keywords than the file
+        // holds is not trusted either.
+        {
+            std::FILE * stream = std::fopen( "FILE.UNRST.OPMIDX", "r+b" );
+            BOOST_REQUIRE( stream != nullptr );
+            const std::int64_t count = 1 << 20;
+            std::fseek( stream, 8 + sizeof(std::int32_t) + 2 * sizeof(std::int64_t), SEEK_SET );
+            std::fwrite( &count, sizeof count, 1, stream );
+            std::fclose( stream );
+        }
+        BOOST_CHECK_EQUAL( load(2).getExtra("BIG").front(), 2.0 );
+        BOOST_CHECK_EQUAL( load(1).getExtra("BIG").front(), 1.0 );
+    }
+    test_work_area_free(test_area);
+}
+
+
 BOOST_AUTO_TEST_CASE(STORE_THPRES) {
     Setup setup("FIRST_SIM_THPRES.DATA");
     test_work_area_type * test_area = test_work_area_alloc("test_Restart_THPRES");
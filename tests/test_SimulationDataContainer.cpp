@@ -205,3 +205,30 @@ BOOST_AUTO_TEST_CASE(TestSetComponent) {
     BOOST_CHECK_EQUAL( data[3*2] , 40 );
 
 }
+
+
+BOOST_AUTO_TEST_CASE(TestComponentVectors) {
+    SimulationDataContainer container(4 , 10 , 2);
+    container.registerCellData("FIELDX" , 3 , 0 );
+
+    std::vector<double> values = {1,2,3,4};
+    BOOST_CHECK_THROW( container.setCellDataComponent( "FIELDY" , 0 , values ) , std::invalid_argument );
+    BOOST_CHECK_THROW( container.setCellDataComponent( "FIELDX" , 3 , values ) , std::invalid_argument );
+    BOOST_CHECK_THROW( container.setCellDataComponent( "FIELDX" , 0 , std::vector<double>{1,2,3} ) , std::invalid_argument );
+    BOOST_CHECK_THROW( container.getCellDataComponent( "FIELDX" , 3 ) , std::invalid_argument );
+
+    container.setCellDataComponent( "FIELDX" , 2 , values );
+    container.setCellDataComponent( "FIELDX" , 1 , std::vector<int>{ 0 , 3 } , std::vector<double>{ 10 , 40 } );
+    BOOST_CHECK_THROW( container.setCellDataComponent( "FIELDX" , 1 , std::vector<int>{ 1 , 4 } , std::vector<double>{ 20 , 50 } ) , std::invalid_argument );
+
+    const auto& data = container.getCellData( "FIELDX" );
+    BOOST_CHECK_EQUAL( data[1*3 + 1] , 0 );
+    BOOST_CHECK_EQUAL( data[3*3 + 1] , 40 );
+    BOOST_CHECK_EQUAL( data[2*3 + 2] , 3 );
+
+    const auto component1 = container.getCellDataComponent( "FIELDX" , 1 );
+    const auto component2 = container.getCellDataComponent( "FIELDX" , 2 );
+    const std::vector<double> expected1 = {10,0,0,40};
+    BOOST_CHECK_EQUAL_COLLECTIONS( component1.begin() , component1.end() , expected1.begin() , expected1.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( component2.begin() , component2.end() , values.begin() , values.end() );
+}
@@ -95,3 +95,22 @@ BOOST_AUTO_TEST_CASE(UNITS) {
     BOOST_CHECK_EQUAL( si0 , c.data("NAME")[0] );
 }
 
+
+
+BOOST_AUTO_TEST_CASE(UnitState)
+{
+    const auto units = UnitSystem::newMETRIC();
+    data::Solution c;
+    c.insert( "PRESSURE" , UnitSystem::measure::pressure, std::vector<double>( 10, 1.0e5 ) , data::TargetType::RESTART_SOLUTION );
+    BOOST_CHECK( c.isSI() );
+
+    c.convertFromSI( units );
+    BOOST_CHECK( !c.isSI() );
+    BOOST_CHECK_CLOSE( c.data("PRESSURE")[0] , 1.0 , 1e-10 );
+
+    c.convertToSI( units );
+    BOOST_CHECK( c.isSI() );
+    BOOST_CHECK_CLOSE( c.data("PRESSURE")[0] , 1.0e5 , 1e-10 );
+
+    BOOST_CHECK( !data::Solution( false ).isSI() );
+}
@@ -847,6 +847,87 @@ BOOST_AUTO_TEST_CASE(report_steps_time) {
     BOOST_CHECK_EQUAL( ecl_sum_get_sim_length( resp ), 10 );
 }
 
+BOOST_AUTO_TEST_CASE(incremental_write) {
+    setup cfg( "test_summary_incremental_write" );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    writer.add_timestep( 1, 2 *  day, cfg.es, cfg.schedule, cfg.wells ,  {});
+    writer.write();
+    writer.add_timestep( 1, 5 *  day, cfg.es, cfg.schedule, cfg.wells ,  {});
+    writer.write();
+    writer.write();
+    writer.add_timestep( 2, 10 * day, cfg.es, cfg.schedule, cfg.wells ,  {});
+    writer.add_timestep( 3, 15 * day, cfg.es, cfg.schedule, cfg.wells ,  {});
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    BOOST_CHECK_EQUAL( ecl_sum_get_data_length( resp ), 4 );
+    BOOST_CHECK( ecl_sum_has_report_step( resp, 1 ) );
+    BOOST_CHECK( ecl_sum_has_report_step( resp, 2 ) );
+    BOOST_CHECK( ecl_sum_has_report_step( resp, 3 ) );
+
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 0 ), 2 );
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 1 ), 5 );
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 2 ), 10 );
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 3 ), 15 );
+    BOOST_CHECK_CLOSE( 10.1, ecl_sum_get_well_var( resp, 3, "W_1", "WOPR" ), 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE(recording_policy) {
+    setup cfg( "test_summary_recording_policy" );
+    cfg.es.getIOConfig().setSummaryRecording( 2 );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    const std::vector< std::pair< double, bool > > steps = {
+        { 1, true }, { 2, true }, { 3, true }, { 4, false }, { 5, true }
+    };
+
+    for (const auto& step : steps) {
+        if (writer.record_timestep( step.first * day, step.second ))
+            writer.add_timestep( 1, step.first * day, cfg.es, cfg.schedule, cfg.wells, {});
+        else
+            writer.skip_timestep( 1, step.first * day, cfg.es, cfg.schedule, cfg.wells );
+    }
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    /* The second and the fourth day; the fifth is skipped. */
+    BOOST_CHECK_EQUAL( ecl_sum_get_data_length( resp ), 2 );
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 0 ), 2 );
+    BOOST_CHECK_EQUAL( ecl_sum_iget_sim_days( resp, 1 ), 4 );
+
+    /* The totals include the skipped timesteps. */
+    BOOST_CHECK_CLOSE( 2 * 10.1, ecl_sum_get_well_var( resp, 0, "W_1", "WOPT" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 4 * 10.1, ecl_sum_get_well_var( resp, 1, "W_1", "WOPT" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 10.1, ecl_sum_get_well_var( resp, 1, "W_1", "WOPR" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 5 * 10.1, writer.get_restart_vectors().get( "WOPT:W_1" ), 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE(report_steps_only) {
+    setup cfg( "test_summary_report_steps_only" );
+    cfg.es.getIOConfig().setSummaryRecording( 0 );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    BOOST_CHECK( !writer.record_timestep( 2 * day, true ) );
+    writer.skip_timestep( 1, 2 * day, cfg.es, cfg.schedule, cfg.wells );
+    BOOST_CHECK( !writer.record_timestep( 5 * day, true ) );
+    writer.skip_timestep( 1, 5 * day, cfg.es, cfg.schedule, cfg.wells );
+    BOOST_CHECK( writer.record_timestep( 10 * day, false ) );
+    writer.add_timestep( 1, 10 * day, cfg.es, cfg.schedule, cfg.wells, {});
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    BOOST_CHECK_EQUAL( ecl_sum_get_data_length( resp ), 1 );
+    BOOST_CHECK_CLOSE( 10 * 10.1, ecl_sum_get_well_var( resp, 0, "W_1", "WOPT" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 10 * 20.1, ecl_sum_get_well_var( resp, 0, "W_2", "WOPT" ), 1e-5 );
+}
+
 BOOST_AUTO_TEST_CASE(skip_unknown_var) {
     setup cfg( "test_summary_skip_unknown_var" );
 
@@ -1104,6 +1185,42 @@ BOOST_AUTO_TEST_CASE(BLOCK_VARIABLES) {
     BOOST_CHECK( !ecl_sum_has_general_var( resp , "BPR:2,1,10"));
 }
 
+BOOST_AUTO_TEST_CASE(BLOCK_VARIABLES_SLOTS) {
+    setup cfg( "block_slots" );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    BOOST_CHECK( writer.value_slot( "BPR", 1 ) >= 0 );
+    BOOST_CHECK_EQUAL( writer.value_slot( "BPR", 2*100 + 10 ), -1 );
+    BOOST_CHECK_EQUAL( writer.value_slot( "NOSUCH" ), -1 );
+
+    std::vector<double> slot_values( writer.num_value_slots(), 0.0 );
+    for (size_t r=1; r <= 10; r++) {
+        const auto slot = writer.value_slot( "BPR", (r-1)*100 + 1 );
+        BOOST_REQUIRE( slot >= 0 );
+        slot_values[slot] = r*1.0;
+    }
+    slot_values[writer.value_slot( "BSWAT", 1 )] = 8.0;
+    slot_values[writer.value_slot( "BSGAS", 1 )] = 9.0;
+
+    writer.add_timestep_slots( 0, 0 * day, cfg.es, cfg.schedule, cfg.wells, slot_values );
+    writer.add_timestep_slots( 1, 1 * day, cfg.es, cfg.schedule, cfg.wells, slot_values );
+    BOOST_CHECK_THROW( writer.add_timestep_slots( 2, 2 * day, cfg.es, cfg.schedule, cfg.wells, {} ),
+                       std::invalid_argument );
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    UnitSystem units( UnitSystem::UnitType::UNIT_TYPE_METRIC );
+    for (size_t r=1; r <= 10; r++) {
+        std::string bpr_key   = "BPR:1,1,"   + std::to_string( r );
+        BOOST_CHECK_CLOSE( r * 1.0 , units.to_si( UnitSystem::measure::pressure , ecl_sum_get_general_var( resp, 1, bpr_key.c_str())) , 1e-5);
+    }
+
+    BOOST_CHECK_CLOSE( 8.0 , ecl_sum_get_general_var( resp, 1, "BSWAT:1,1,1") , 1e-5);
+    BOOST_CHECK_CLOSE( 9.0 , ecl_sum_get_general_var( resp, 1, "BSGAS:1,1,1") , 1e-5);
+}
+
 
 
 /*
@@ -1335,6 +1452,47 @@ BOOST_AUTO_TEST_CASE(Test_SummaryState) {
     BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WWCT"), st.get("WWCT:OP1"));
 }
 
+BOOST_AUTO_TEST_CASE(Test_SummaryState_Index) {
+    Opm::SummaryState st;
+    const auto fopr = st.index("FOPR");
+    const auto wwct = st.index("WWCT:OP1");
+    BOOST_CHECK_EQUAL( st.size(), 2U );
+    BOOST_CHECK_EQUAL( st.index("FOPR"), fopr );
+    BOOST_CHECK_EQUAL( st.key(wwct), "WWCT:OP1" );
+
+    // Registered keys have no value until set.
+    BOOST_CHECK( !st.has("FOPR") );
+    BOOST_CHECK( !st.has(fopr) );
+    BOOST_CHECK_THROW( st.get(fopr), std::out_of_range );
+    BOOST_CHECK( st.begin() == st.end() );
+
+    st.set(fopr, 100);
+    st.add_well_var("OP1", "WWCT", 0.25);
+    BOOST_CHECK_EQUAL( st.size(), 2U );
+    BOOST_CHECK_EQUAL( st.get("FOPR"), 100 );
+    BOOST_CHECK_EQUAL( st.get(wwct), 0.25 );
+    BOOST_CHECK_EQUAL( std::distance(st.begin(), st.end()), 2 );
+
+    Opm::SummaryState prev = st;
+    st.clear();
+    BOOST_CHECK( !st.has(fopr) );
+    BOOST_CHECK( !st.has_well_var("OP1", "WWCT") );
+    BOOST_CHECK_EQUAL( st.size(), 2U );
+    st.set(fopr, prev.get(fopr) + 1);
+    std::swap(st, prev);
+    BOOST_CHECK_EQUAL( prev.get("FOPR"), 101 );
+    BOOST_CHECK( !prev.has("WWCT:OP1") );
+    BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WWCT"), 0.25 );
+
+    // All the values as one block.
+    BOOST_CHECK_EQUAL( st.data().size(), 2U );
+    BOOST_CHECK_EQUAL( st.data()[wwct], 0.25 );
+    prev.set_data( { 7, 8 } );
+    BOOST_CHECK_EQUAL( prev.get(fopr), 7 );
+    BOOST_CHECK_EQUAL( prev.get_well_var("OP1", "WWCT"), 8 );
+    BOOST_CHECK_THROW( prev.set_data( { 1 } ), std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ####################################################################
@@ -0,0 +1,111 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE Unformatted_Array
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/UnformattedArray.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Opm::RestartIO::Helpers::UnformattedArray;
+
+namespace {
+
+    int read32(const std::string& bytes, std::size_t offset) {
+        unsigned int value = 0;
+        for (std::size_t byte = 0; byte < 4; byte++)
+            value = (value << 8) | static_cast<unsigned char>(bytes[offset + byte]);
+        return static_cast<int>(value);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(Layout)
+{
+    const UnformattedArray array("PRESSURE", UnformattedArray::Type::Float, 2500);
+
+    BOOST_CHECK_EQUAL(array.size(), 2500U);
+    BOOST_CHECK_EQUAL(array.byteSize(), 24U + 3 * 8 + 2500 * 4);
+    BOOST_CHECK_EQUAL(array.elementOffset(0), 28U);
+    BOOST_CHECK_EQUAL(array.elementOffset(999), 28U + 999 * 4);
+    BOOST_CHECK_EQUAL(array.elementOffset(1000), 24U + 4008 + 4);
+
+    const UnformattedArray empty("SWAT", UnformattedArray::Type::Double, 0);
+    BOOST_CHECK_EQUAL(empty.byteSize(), 24U);
+
+    BOOST_CHECK_THROW(UnformattedArray("TOOLONGKW", UnformattedArray::Type::Integer, 1), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE(DistributedWrite)
+{
+    const std::size_t size = 2500;
+    const UnformattedArray array("SWAT", UnformattedArray::Type::Integer, size);
+    const std::size_t offset = 10;
+
+    std::vector<int> values(size);
+    std::vector<std::size_t> all(size);
+    for (std::size_t index = 0; index < size; index++) {
+        values[index] = static_cast<int>(index) - 7;
+        all[index] = index;
+    }
+
+    std::stringstream sequential(std::string(offset + array.byteSize(), 'x'));
+    array.writeFrame(sequential, offset);
+    array.writeValues(sequential, offset, values, all);
+
+    // Two ranks with interleaved and unordered cells.
+    std::vector<int> values1, values2;
+    std::vector<std::size_t> index1, index2;
+    for (std::size_t index = size; index-- > 0;) {
+        if ((index / 300) % 2 == 0) {
+            values1.push_back(values[index]);
+            index1.push_back(index);
+        } else {
+            values2.push_back(values[index]);
+            index2.push_back(index);
+        }
+    }
+
+    std::stringstream distributed(std::string(offset + array.byteSize(), 'x'));
+    array.writeValues(distributed, offset, values2, index2);
+    array.writeFrame(distributed, offset);
+    array.writeValues(distributed, offset, values1, index1);
+
+    const auto bytes = sequential.str();
+    BOOST_CHECK(bytes == distributed.str());
+    BOOST_CHECK_EQUAL(bytes.substr(0, offset), std::string(offset, 'x'));
+    BOOST_CHECK_EQUAL(read32(bytes, offset), 16);
+    BOOST_CHECK_EQUAL(bytes.substr(offset + 4, 8), "SWAT    ");
+    BOOST_CHECK_EQUAL(read32(bytes, offset + 12), 2500);
+    BOOST_CHECK_EQUAL(bytes.substr(offset + 16, 4), "INTE");
+    BOOST_CHECK_EQUAL(read32(bytes, offset + 24), 4000);
+    BOOST_CHECK_EQUAL(read32(bytes, offset + array.elementOffset(0)), -7);
+    BOOST_CHECK_EQUAL(read32(bytes, offset + array.elementOffset(2499)), 2492);
+    BOOST_CHECK_EQUAL(read32(bytes, offset + array.elementOffset(2000) - 4), 2000);
+    BOOST_CHECK_EQUAL(read32(bytes, offset + array.byteSize() - 4), 2000);
+
+    BOOST_CHECK_THROW(array.writeValues(distributed, offset, values1, index2), std::invalid_argument);
+    BOOST_CHECK_THROW(array.writeValues(distributed, offset, std::vector<int>{1}, std::vector<std::size_t>{size}), std::invalid_argument);
+}
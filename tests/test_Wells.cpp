@@ -22,7 +22,9 @@
 #define BOOST_TEST_MODULE Wells
 #include <boost/test/unit_test.hpp>
 
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 
 #include <opm/output/data/Wells.hpp>
 
@@ -123,3 +125,97 @@ BOOST_AUTO_TEST_CASE(get_completions) {
     BOOST_CHECK_EQUAL( 0.0, wellRates.get("OP_2" , 10000 , data::Rates::opt::wat) );
     BOOST_CHECK_EQUAL( 26.41 , wellRates.get( "OP_2" , 188 , data::Rates::opt::wat));
 }
+
+BOOST_AUTO_TEST_CASE(find_connection) {
+    data::Rates rc1, rc2, rc3;
+    rc1.set( rt::wat, 1.0 );
+    rc2.set( rt::wat, 2.0 );
+    rc3.set( rt::wat, 3.0 );
+
+    data::Well w;
+    w.connections.push_back( { 288, rc1, 0, 0, 0, 0, 0, 0 } );
+    w.connections.push_back( { 88,  rc2, 0, 0, 0, 0, 0, 0 } );
+    w.connections.push_back( { 188, rc3, 0, 0, 0, 0, 0, 0 } );
+
+    /* Without an index the connections are searched linearly. */
+    BOOST_CHECK( !w.indexed() );
+    BOOST_CHECK_EQUAL( 2.0, w.find_connection( 88 )->rates.get( rt::wat ) );
+    BOOST_CHECK( w.find_connection( 1 ) == nullptr );
+
+    w.index_connections();
+    BOOST_CHECK( w.indexed() );
+    BOOST_CHECK_EQUAL( 1.0, w.find_connection( 288 )->rates.get( rt::wat ) );
+    BOOST_CHECK_EQUAL( 2.0, w.find_connection( 88 )->rates.get( rt::wat ) );
+    BOOST_CHECK_EQUAL( 3.0, w.find_connection( 188 )->rates.get( rt::wat ) );
+    BOOST_CHECK( w.find_connection( 1 ) == nullptr );
+
+    /* A stale index is not used. */
+    w.connections.erase( w.connections.begin() );
+    BOOST_CHECK( !w.indexed() );
+    BOOST_CHECK( w.find_connection( 288 ) == nullptr );
+    BOOST_CHECK_EQUAL( 3.0, w.find_connection( 188 )->rates.get( rt::wat ) );
+
+    data::Wells wells;
+    wells["W"] = w;
+    wells.index_connections();
+    BOOST_CHECK( wells.at( "W" ).indexed() );
+    BOOST_CHECK_EQUAL( 2.0, wells.get( "W", 88, rt::wat ) );
+    BOOST_CHECK_EQUAL( 0.0, wells.get( "W", 288, rt::wat ) );
+}
+
+BOOST_AUTO_TEST_CASE(pack_and_view) {
+    data::Rates r1, rc1, rc2;
+    r1.set( rt::oil, 1.5 );
+    rc1.set( rt::wat, 2.5 );
+    rc2.set( rt::gas, 3.5 );
+
+    data::Well w1, w2;
+    w1.rates = r1;
+    w1.bhp = 100;
+    w1.thp = 50;
+    w1.temperature = 300;
+    w1.control = 3;
+    w1.connections.push_back( { 88,  rc1, 1, 2, 3, 4, 5, 6 } );
+    w1.connections.push_back( { 288, rc2, 7, 8, 9, 10, 11, 12 } );
+    w1.segments[ 2 ] = { rc2, 20, 2 };
+    w1.segments[ 1 ] = { rc1, 10, 1 };
+
+    w2.bhp = 200;
+    w2.thp = 0;
+    w2.temperature = 0;
+    w2.control = 1;
+
+    data::Wells wells;
+    wells["PROD"] = w1;
+    wells["INJ"] = w2;
+
+    const auto packed = wells.pack();
+    std::vector< double > aligned( packed.size() / sizeof( double ) + 1 );
+    std::memcpy( aligned.data(), packed.data(), packed.size() );
+    const char* buffer = reinterpret_cast< const char* >( aligned.data() );
+
+    const data::WellRatesView view( buffer, packed.size() );
+    BOOST_CHECK_EQUAL( view.size(), 2U );
+    BOOST_CHECK_EQUAL( std::string( view.name( 0 ) ), "INJ" );
+    BOOST_CHECK_EQUAL( view.find( "NO_SUCH_WELL" ), view.size() );
+
+    const auto prod = view.find( "PROD" );
+    BOOST_CHECK_EQUAL( prod, 1U );
+    BOOST_CHECK_EQUAL( view.head( prod ).bhp, 100 );
+    BOOST_CHECK_EQUAL( view.head( prod ).rates.get( rt::oil ), 1.5 );
+    BOOST_CHECK_EQUAL( view.connections_end( prod ) - view.connections_begin( prod ), 2 );
+    BOOST_CHECK_EQUAL( view.connections_begin( prod )[ 1 ].index, 288U );
+    BOOST_CHECK_EQUAL( view.segments_begin( prod )[ 0 ].segNumber, 1U );
+    BOOST_CHECK_EQUAL( view.segments_begin( prod )[ 1 ].pressure, 20 );
+    BOOST_CHECK( view.segments_begin( 0 ) == view.segments_end( 0 ) );
+
+    data::Wells unpacked;
+    unpacked.unpack( packed.data(), packed.size() );
+    BOOST_CHECK_EQUAL( unpacked.size(), 2U );
+    BOOST_CHECK_EQUAL( unpacked.at( "INJ" ).bhp, 200 );
+    BOOST_CHECK_EQUAL( unpacked.at( "PROD" ).segments.at( 2 ).pressure, 20 );
+    BOOST_CHECK_EQUAL( unpacked.get( "PROD", 288, rt::gas ), 3.5 );
+    BOOST_CHECK_EQUAL( unpacked.pack(), packed );
+
+    BOOST_CHECK_THROW( data::WellRatesView( buffer, packed.size() - 8 ), std::invalid_argument );
+}
@@ -142,4 +142,38 @@ BOOST_AUTO_TEST_CASE(Matrix)
     }
 }
 
+// ====================================================================
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+    using Wa = Opm::RestartIO::Helpers::WindowedArray<int>;
+    using Wm = Opm::RestartIO::Helpers::WindowedMatrix<int>;
+
+    auto wa = Wa{ Wa::NumWindows{ 5 }, Wa::WindowSize{ 7 } };
+    std::fill(std::begin(wa[2]), std::end(wa[2]), 17);
+
+    const auto* storage = wa.data().data();
+
+    wa.reset(Wa::NumWindows{ 3 }, Wa::WindowSize{ 4 });
+    BOOST_CHECK_EQUAL(wa.numWindows(), Wa::Idx{3});
+    BOOST_CHECK_EQUAL(wa.windowSize(), Wa::Idx{4});
+    BOOST_CHECK(wa.data() == std::vector<int>(12, 0));
+
+    // Smaller arrays reuse the existing storage.
+    BOOST_CHECK(wa.data().data() == storage);
+
+    wa.reset(Wa::NumWindows{ 6 }, Wa::WindowSize{ 7 });
+    BOOST_CHECK_EQUAL(wa.numWindows(), Wa::Idx{6});
+    BOOST_CHECK(wa.data() == std::vector<int>(42, 0));
+
+    auto wm = Wm{ Wm::NumRows{ 3 }, Wm::NumCols{ 2 }, Wm::WindowSize{ 4 } };
+    std::fill(std::begin(wm(1, 1)), std::end(wm(1, 1)), 11);
+
+    wm.reset(Wm::NumRows{ 2 }, Wm::NumCols{ 3 }, Wm::WindowSize{ 2 });
+    BOOST_CHECK_EQUAL(wm.numRows(), Wm::Idx{2});
+    BOOST_CHECK_EQUAL(wm.numCols(), Wm::Idx{3});
+    BOOST_CHECK_EQUAL(wm.windowSize(), Wm::Idx{2});
+    BOOST_CHECK(wm.data() == std::vector<int>(12, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -60,4 +60,39 @@ BOOST_AUTO_TEST_CASE (calc_cellvol)
     BOOST_REQUIRE_CLOSE (calculateCellVol(x4,y4,z4), 23391.4917234564, 1e-9);
 }
 
+BOOST_AUTO_TEST_CASE (calc_cellvol_batch)
+{
+    /* A unit cube, a collapsed cell and a 2 x 3 x 4 box, repeated past one batch. */
+    const std::vector<double> xc {0, 1, 0, 1, 0, 1, 0, 1};
+    const std::vector<double> yc {0, 0, 1, 1, 0, 0, 1, 1};
+    const std::vector<double> zc {0, 0, 0, 0, 1, 1, 1, 1};
+    const std::vector<double> zp {5, 5, 5, 5, 5, 5, 5, 5};
+
+    const std::size_t num_cells = 19;
+    std::vector<double> X(8 * num_cells), Y(8 * num_cells), Z(8 * num_cells);
+    std::vector<double> expected(num_cells);
+    for (std::size_t cell = 0; cell < num_cells; ++cell) {
+        for (std::size_t corner = 0; corner < 8; ++corner) {
+            const auto pos = corner * num_cells + cell;
+            switch (cell % 3) {
+            case 0: X[pos] = xc[corner];     Y[pos] = yc[corner];     Z[pos] = zc[corner];     break;
+            case 1: X[pos] = xc[corner];     Y[pos] = yc[corner];     Z[pos] = zp[corner];     break;
+            case 2: X[pos] = 2 * xc[corner]; Y[pos] = 3 * yc[corner]; Z[pos] = 4 * zc[corner]; break;
+            }
+        }
+        expected[cell] = (cell % 3 == 0) ? 1 : ((cell % 3 == 1) ? 0 : 24);
+    }
+
+    std::vector<double> volumes(num_cells, -1);
+    calculateCellVol(num_cells, X.data(), Y.data(), Z.data(), volumes.data());
+    for (std::size_t cell = 0; cell < num_cells; ++cell)
+        BOOST_CHECK_CLOSE (volumes[cell], expected[cell], 1e-9);
+
+    /* A batch of collapsed cells only. */
+    std::fill(Z.begin(), Z.end(), 3.0);
+    calculateCellVol(num_cells, X.data(), Y.data(), Z.data(), volumes.data());
+    for (std::size_t cell = 0; cell < num_cells; ++cell)
+        BOOST_CHECK_EQUAL (volumes[cell], 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
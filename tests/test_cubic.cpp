@@ -65,4 +65,23 @@ BOOST_AUTO_TEST_CASE (cubic)
     BOOST_REQUIRE_CLOSE (interp.evaluate(4.0), 2., 0.00001);
 }
 
+BOOST_AUTO_TEST_CASE (cubic_batch)
+{
+    const int num_v = 4;
+    double xv[num_v] = {0.0, 1.0, 2.0, 4.0};
+    double fv[num_v] = {10.0, 21.0, 2.0, 1.0};
+    std::vector<double> x(xv, xv + num_v);
+    std::vector<double> f(fv, fv + num_v);
+    MonotCubicInterpolator interp(x, f);
+
+    // Sorted, unsorted, repeated and extrapolated arguments.
+    std::vector<double> args = {-1.0, 0.0, 0.0001, 0.5, 1.0, 1.0, 1.5, 3.0, 4.0, 5.0,
+                                0.25, 3.5, 2.0, -2.0, 1.75};
+    std::vector<double> values = interp.evaluate(args);
+    BOOST_REQUIRE_EQUAL (values.size(), args.size());
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        BOOST_CHECK_EQUAL (values[i], interp.evaluate(args[i]));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
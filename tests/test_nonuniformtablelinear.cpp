@@ -86,3 +86,24 @@ BOOST_AUTO_TEST_CASE(table_operations)
     BOOST_CHECK_EQUAL(t1(0.0), 3.0);
     BOOST_CHECK(std::fabs(t1.derivative(0.0)  + 1.0/20.0) < 1e-11);
 }
+
+BOOST_AUTO_TEST_CASE(bulk_evaluation)
+{
+    double xva[] = { -1.0, 2.0, 2.2, 3.0, 5.0 };
+    const int numvals = sizeof(xva)/sizeof(xva[0]);
+    std::vector<double> xv(xva, xva + numvals);
+    double yva[numvals] = { 1.0, 2.0, 3.0, 4.0, 2.0 };
+    std::vector<double> yv(yva, yva + numvals);
+    Opm::NonuniformTableLinear<double> t1(xv, yv);
+
+    // Increasing, repeated, decreasing and extrapolated arguments.
+    std::vector<double> x = { -2.0, -1.0, 0.0, 2.0, 2.0, 2.1, 2.6, 4.0, 5.0, 6.0, 2.15, 0.5, -3.0, 3.0 };
+    std::vector<double> y(x.size());
+    std::vector<double> dy(x.size());
+    t1.evaluate(x.data(), y.data(), x.size());
+    t1.derivative(x.data(), dy.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_EQUAL(y[i], t1(x[i]));
+        BOOST_CHECK_EQUAL(dy[i], t1.derivative(x[i]));
+    }
+}
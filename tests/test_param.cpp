@@ -119,3 +119,31 @@ BOOST_AUTO_TEST_CASE(failing_strict_xml_syntax_init)
     const std::size_t argc = argv.size() - 1;
     BOOST_CHECK_THROW(ParameterGroup p(argc, argv.data()), std::runtime_error);
 }
+
+
+BOOST_AUTO_TEST_CASE(parameter_handles)
+{
+    typedef const char* cp;
+    std::vector<cp> argv = { "program_command",
+                             "/group/item=1",
+                             "/group/subgroup/ratio=0.5",
+                             0 };
+    const std::size_t argc = argv.size() - 1;
+    ParameterGroup p(argc, argv.data());
+    p.disableOutput();
+
+    const auto item = p.handle<int>("group/item");
+    const auto ratio = p.handle<double>("group/subgroup/ratio");
+    const auto missing = p.handle<int>("group/missing", 7);
+    BOOST_CHECK_EQUAL(item.value(), 1);
+    BOOST_CHECK_EQUAL(ratio.value(), 0.5);
+    BOOST_CHECK_EQUAL(missing.value(), 7);
+
+    p.insertParameter("/group/item", "2");
+    p.insertParameter("/group/missing", "3");
+    BOOST_CHECK_EQUAL(item.value(), 2);
+    BOOST_CHECK_EQUAL(missing.value(), 3);
+
+    const auto absent = p.handle<int>("nosuchitem");
+    BOOST_CHECK_THROW(absent.value(), ParameterGroup::NotFoundException);
+}
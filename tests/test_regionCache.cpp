@@ -62,3 +62,45 @@ BOOST_AUTO_TEST_CASE(create) {
         }
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(region_cells) {
+    ParseContext parseContext;
+    Parser parser;
+    Deck deck( parser.parseFile( path, parseContext ));
+    EclipseState es(deck , parseContext );
+    const EclipseGrid& grid = es.getInputGrid();
+    Schedule schedule( deck, grid, es.get3DProperties(), es.runspec(), ParseContext() );
+    out::RegionCache rc(es.get3DProperties() , grid, schedule);
+
+    BOOST_CHECK( rc.hasRegionSet( "FIPNUM" ));
+    BOOST_CHECK( !rc.hasRegionSet( "FIPXXX" ));
+    BOOST_CHECK_THROW( rc.regions( "FIPXXX" ), std::invalid_argument );
+
+    BOOST_CHECK_EQUAL( rc.regions( "FIPNUM" ).size() , 10 );
+    BOOST_CHECK_EQUAL( rc.maxRegion( "FIPNUM" ) , 10 );
+    BOOST_CHECK_EQUAL( rc.cells( "FIPNUM" , 1 ).size() , 100 );
+    BOOST_CHECK_EQUAL( rc.cells( "FIPNUM" , 11 ).size() , 0 );
+
+    /* Cell 2,1,10 is inactive. */
+    const auto& bottom_layer = rc.cells( "FIPNUM" , 10 );
+    BOOST_CHECK_EQUAL( bottom_layer.size() , 99 );
+    BOOST_CHECK_EQUAL( bottom_layer[0] , grid.activeIndex( 0,0,9 ));
+    BOOST_CHECK_EQUAL( bottom_layer[1] , grid.activeIndex( 2,0,9 ));
+
+    std::vector<double> values( grid.getNumActive() );
+    std::vector<double> weights( grid.getNumActive() , 1.0 );
+    for (size_t g = 0; g < grid.getNumActive(); g++)
+        values[g] = grid.getGlobalIndex( g ) / 100;
+
+    const auto sums = rc.reduce( weights , "FIPNUM" );
+    BOOST_CHECK_EQUAL( sums.size() , 10 );
+    BOOST_CHECK_EQUAL( sums[0] , 100 );
+    BOOST_CHECK_EQUAL( sums[9] , 99 );
+
+    const auto means = rc.average( values , weights , "FIPNUM" );
+    for (size_t r = 0; r < means.size(); r++)
+        BOOST_CHECK_CLOSE( means[r] , r , 1e-12 );
+
+    BOOST_CHECK_THROW( rc.reduce( std::vector<double>(10) , "FIPNUM" ), std::invalid_argument );
+}
@@ -0,0 +1,88 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE RootFindersTest
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <opm/common/utility/numeric/RootFinders.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    struct Cubic {
+        explicit Cubic(double c_arg) : c(c_arg) {}
+        double operator()(double x) const { return x*x*x - c; }
+        double c;
+    };
+
+    struct Cubics {
+        explicit Cubics(const std::vector<double>& c_arg) : c(c_arg) {}
+        void operator()(int n, const double* x, double* fx) const {
+            for (int i = 0; i < n; ++i)
+                fx[i] = x[i]*x[i]*x[i] - c[i];
+        }
+        std::vector<double> c;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(batch_matches_scalar)
+{
+    const std::vector<double> c = { 0.0, 1.0, 8.0, 0.5, 27.0, 64.0, 1000.0 };
+    const int n = c.size();
+    const std::vector<double> a(n, 0.0);
+    const std::vector<double> b(n, 10.0);
+    std::vector<double> x(n);
+
+    RegulaFalsi<>::BatchStatistics stats;
+    RegulaFalsi<>::solveBatch(Cubics(c), n, a.data(), b.data(), 100, 1e-12, x.data(), stats);
+    BOOST_CHECK_EQUAL(stats.lanes, n);
+    BOOST_CHECK_EQUAL(stats.bracketing_failures, 0);
+    BOOST_CHECK_EQUAL(stats.iteration_failures, 0);
+    BOOST_CHECK(stats.rounds >= stats.max_iterations);
+    BOOST_CHECK(stats.total_iterations <= long(n) * stats.max_iterations);
+
+    for (int i = 0; i < n; ++i) {
+        int iterations = 0;
+        const double scalar = RegulaFalsi<>::solve(Cubic(c[i]), a[i], b[i], 100, 1e-12, iterations);
+        BOOST_CHECK_EQUAL(x[i], scalar);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batch_error_policy)
+{
+    const std::vector<double> c = { 8.0, -1.0 };
+    const std::vector<double> a = { 0.0, 0.0 };
+    const std::vector<double> b = { 10.0, 10.0 };
+    std::vector<double> x(2);
+
+    RegulaFalsi<ContinueOnError>::BatchStatistics stats;
+    RegulaFalsi<ContinueOnError>::solveBatch(Cubics(c), 2, a.data(), b.data(), 100, 1e-12, x.data(), stats);
+    BOOST_CHECK_CLOSE(x[0], 2.0, 1e-8);
+    BOOST_CHECK_EQUAL(x[1], 0.0);
+    BOOST_CHECK_EQUAL(stats.bracketing_failures, 1);
+
+    RegulaFalsi<ThrowOnError>::BatchStatistics throw_stats;
+    BOOST_CHECK_THROW(RegulaFalsi<ThrowOnError>::solveBatch(Cubics(c), 2, a.data(), b.data(), 100, 1e-12, x.data(), throw_stats), std::runtime_error);
+}
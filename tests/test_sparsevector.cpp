@@ -104,3 +104,41 @@ BOOST_AUTO_TEST_CASE(construction_and_queries)
 #endif
 }
 
+
+
+BOOST_AUTO_TEST_CASE(unordered_construction_and_dense_operations)
+{
+    const int size = 10;
+    const int num_elem = 5;
+    const double elem[num_elem] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    const int indices[num_elem] = { 7, 2, 7, 0, 4 };
+    const SparseVector<double> sv = SparseVector<double>::fromUnordered(size, elem, elem + num_elem, indices, indices + num_elem);
+    BOOST_CHECK_EQUAL(sv.size(), size);
+    BOOST_CHECK_EQUAL(sv.nonzeroSize(), 4);
+    BOOST_CHECK_EQUAL(sv.nonzeroIndex(0), 0);
+    BOOST_CHECK_EQUAL(sv.nonzeroIndex(3), 7);
+    BOOST_CHECK_EQUAL(sv.element(7), 4.0);
+    BOOST_CHECK_EQUAL(sv.element(4), 5.0);
+
+    std::vector<double> dense(size, 1.0);
+    dense[7] = 2.0;
+    BOOST_CHECK_EQUAL(sv.dot(dense), 4.0 + 2.0 + 5.0 + 2*4.0);
+
+    sv.axpy(2.0, dense);
+    BOOST_CHECK_EQUAL(dense[0], 9.0);
+    BOOST_CHECK_EQUAL(dense[1], 1.0);
+    BOOST_CHECK_EQUAL(dense[7], 10.0);
+
+    std::vector<double> target(size, 0.0);
+    sv.scatter(target);
+    BOOST_CHECK_EQUAL(target[2], 2.0);
+    BOOST_CHECK_EQUAL(target[3], 0.0);
+
+    SparseVector<double> pattern = sv;
+    pattern.gather(dense);
+    BOOST_CHECK_EQUAL(pattern.nonzeroSize(), 4);
+    BOOST_CHECK_EQUAL(pattern.element(7), 10.0);
+    BOOST_CHECK_EQUAL(pattern.element(2), 5.0);
+
+    BOOST_CHECK_THROW(SparseVector<double>::fromUnordered(4, elem, elem + num_elem, indices, indices + num_elem), std::exception);
+}
@@ -68,3 +68,21 @@ BOOST_AUTO_TEST_CASE(table_operations)
     BOOST_CHECK_EQUAL(t1(-85.0), 0.0);
     BOOST_CHECK(std::fabs(t1.derivative(0.0)  + 2.0/30.0) < 1e-14);
 }
+
+BOOST_AUTO_TEST_CASE(bulk_evaluation)
+{
+    double yva[] = { 1.0, -1.0, 3.0, 4.0, 2.0 };
+    const int numvals = sizeof(yva)/sizeof(yva[0]);
+    std::vector<double> yv(yva, yva + numvals);
+    Opm::utils::UniformTableLinear<double> t1(1.0, 11.0, yv);
+
+    std::vector<double> x = { -1.0, 1.0, 2.25, 3.5, 6.0, 9.75, 11.0, 12.0, 4.0, 1.5 };
+    std::vector<double> y(x.size());
+    std::vector<double> dy(x.size());
+    t1.evaluate(x.data(), y.data(), x.size());
+    t1.derivative(x.data(), dy.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_EQUAL(y[i], t1(x[i]));
+        BOOST_CHECK_EQUAL(dy[i], t1.derivative(x[i]));
+    }
+}